@@ -162,6 +162,12 @@ pub fn build(b: *std.Build) void {
 
     const tree_sitter_cpp_lib = createTreeSitterCppLib(b, target, optimize);
     exe.linkLibrary(tree_sitter_cpp_lib);
+    exe.root_module.addCMacro("CESIUM_BUILTIN_TREE_SITTER_CPP", "1");
+
+    const strip_debug_logs = b.option(bool, "strip-debug-logs", "Compile out debug-level LOG_* messages") orelse false;
+    if (strip_debug_logs) {
+        exe.root_module.addCMacro("CESIUM_LOG_COMPILED_LEVEL", "20"); // LogLevel::stdout_level
+    }
 
     setupBuildSteps(b, exe);
 }
@@ -0,0 +1,90 @@
+/**
+@brief Bump-pointer arena and string interner for per-run extraction data
+*/
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/**
+@brief Bump-pointer allocator that frees everything at once
+
+Memory is handed out from large blocks and never freed individually; reset()
+or destruction releases all of it. Only trivially destructible data should
+be placed in an arena.
+*/
+class Arena {
+  public:
+    static constexpr size_t kDefaultBlockSize = 64 * 1024;  ///< Size of each block (larger requests get their own)
+
+    explicit Arena(size_t block_size = kDefaultBlockSize) : block_size_(block_size) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+    @brief Allocate uninitialized memory
+    @param size Number of bytes
+    @param alignment Required alignment (power of two)
+    @return Pointer valid until reset() or destruction
+    */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+    @brief Copy a string into the arena
+    @return View of the copy, valid until reset() or destruction
+    */
+    std::string_view copy(std::string_view text);
+
+    /**
+    @brief Release every allocation
+    */
+    void reset();
+
+    size_t bytesUsed() const { return bytes_used_; }  ///< Bytes handed out since the last reset
+
+  private:
+    std::vector<std::unique_ptr<char[]>> blocks_;  ///< Owned blocks, current one last
+    char* cursor_ = nullptr;                       ///< Next free byte in the current block
+    size_t remaining_ = 0;                         ///< Free bytes left in the current block
+    size_t block_size_;                            ///< Size of regular blocks
+    size_t bytes_used_ = 0;                        ///< Bytes handed out since the last reset
+};
+
+/**
+@brief Deduplicating string storage returning stable views
+
+Each distinct string is stored once in an arena, so the many constructs
+that share a filename, namespace path or type name share one copy.
+intern() may be called from several threads at once.
+*/
+class StringInterner {
+  public:
+    StringInterner() = default;
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    /**
+    @brief Get the stored copy of a string, storing it on first use
+    @param text String to intern
+    @return View valid until clear() or destruction (empty input returns an empty view)
+    */
+    std::string_view intern(std::string_view text);
+
+    /**
+    @brief Drop every stored string; views returned earlier become invalid
+    */
+    void clear();
+
+    size_t size() const;        ///< Number of distinct strings stored
+    size_t bytesStored() const; ///< Bytes of string data stored
+
+  private:
+    mutable std::mutex mutex_;                   ///< Guards the set and arena across workers
+    Arena arena_;                                ///< Storage for string data
+    std::unordered_set<std::string_view> strings_; ///< Views of stored strings
+};
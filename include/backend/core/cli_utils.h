@@ -60,6 +60,8 @@ namespace CLILogger {
   inline void configure(const LoggingConfig& config) { Logger::configure(config); }
   inline void configureFromJson(const std::string& json_str) { Logger::configureFromJson(json_str); }
   inline void configureFromFile(const std::string& config_file_path) { Logger::configureFromFile(config_file_path); }
+  inline void configureFromDoc(const JsonDoc& config) { Logger::configureFromDoc(config); }
+  inline void flush() { Logger::flush(); }
   inline std::string getCurrentTimestamp() { return Logger::getCurrentTimestamp(); }
   inline MessageType resolveLogLevel(const std::string& level_name) { return Logger::resolveLogLevel(level_name); }
   inline bool shouldLog(MessageType type, bool for_console = true) { return Logger::shouldLog(type, for_console); }
@@ -0,0 +1,104 @@
+/**
+@brief Recursive filesystem change notifications
+*/
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <backend/core/fs_scan.h>
+#include <backend/core/glob.h>
+
+#if defined(__linux__)
+  #include <unordered_map>
+#endif
+
+/**
+@brief Reports files created, modified, renamed or removed below a set of directories
+
+Linux uses inotify (one watch per directory, added as directories appear) and
+Windows uses ReadDirectoryChangesW on each root with subtree watching. Other
+platforms fall back to polling: each wait rescans the roots with FsScanner and
+compares sizes and modification times.
+
+Because one save in an editor often produces several events (write to a
+temporary file, rename, touch), wait() keeps collecting until no event has
+arrived for a short settle period and then reports each path once.
+*/
+class FileWatcher {
+  public:
+    /**
+    @brief Changes collected by one wait()
+    */
+    struct Changes {
+      std::vector<std::string> paths;  ///< Changed paths (files, or directories that appeared or vanished), each once
+      bool overflow = false;           ///< Events were lost; the caller should rescan everything
+    };
+
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+    @brief Paths matching these patterns are not reported (nor, on Linux, watched)
+    @param exclude Exclude patterns (must outlive the watcher; nullptr = report everything)
+    */
+    void setExcludes(const GlobMatcher* exclude) { exclude_ = exclude; }
+
+    /**
+    @brief Start watching a directory and everything below it
+    @param path Directory to watch
+    @return False if the directory could not be watched
+    */
+    bool addRoot(const std::string& path);
+
+    /**
+    @brief Wait for the next burst of changes
+    @param timeout Longest time to wait for the first change
+    @param settle Quiet period that ends a burst
+    @return Changes seen (no paths on timeout)
+    */
+    Changes wait(std::chrono::milliseconds timeout,
+                 std::chrono::milliseconds settle = std::chrono::milliseconds(30));
+
+    /**
+    @brief Name of the notification mechanism in use ("inotify", "ReadDirectoryChangesW" or "polling")
+    */
+    static const char* backendName();
+
+  private:
+    const GlobMatcher* exclude_ = nullptr;  ///< Paths not reported
+
+    /**
+    @brief Block for up to timeout and add any changes that arrive
+    @return True if at least one event arrived
+    */
+    bool collect(std::chrono::milliseconds timeout, Changes& changes);
+
+    /**
+    @brief Record a changed path unless it is excluded
+    */
+    void report(std::string path, bool is_directory, Changes& changes) const;
+
+    #if defined(__linux__)
+      int inotify_fd_ = -1;                               ///< inotify instance
+      std::unordered_map<int, std::string> watched_dirs_; ///< Watch descriptor -> directory path
+
+      /**
+      @brief Watch a directory and its subdirectories
+      @param path Directory to watch
+      @param changes If set, files already inside are reported (for directories that just appeared)
+      @return False if the directory itself could not be watched
+      */
+      bool watchTree(const std::string& path, Changes* changes);
+    #elif defined(_WIN32)
+      struct WatchedRoot;                                 ///< Directory handle, overlapped read and buffer
+      std::vector<std::unique_ptr<WatchedRoot>> roots_;   ///< One pending ReadDirectoryChangesW per root
+    #else
+      std::vector<ScanRoot> poll_roots_;                  ///< Roots rescanned on every poll
+      FsSnapshot polled_;                                 ///< State seen by the last poll
+    #endif
+};
@@ -0,0 +1,163 @@
+/**
+@brief One-pass directory scanning with batched stat information
+*/
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <backend/core/glob.h>
+
+/**
+@brief Kind of a scanned directory entry
+*/
+enum class FsEntryType {
+  File,        ///< Regular file (symlinks are followed)
+  Directory,   ///< Directory (symlinked directories are listed but not descended)
+  Other        ///< Anything else (sockets, devices, ...)
+};
+
+/**
+@brief A file or directory found by FsScanner, with the stat data consumers need
+*/
+struct FsEntry {
+  std::string path;                  ///< Path as walked (root joined with the relative path)
+  FsEntryType type = FsEntryType::File;
+  int64_t mtime_ticks = 0;           ///< last_write_time ticks (files only)
+  uint64_t size = 0;                 ///< Size in bytes (files only)
+  uint64_t inode = 0;                ///< Inode/file index (0 if unavailable)
+  uint32_t depth = 1;                ///< 1 for direct children of the root
+};
+
+/**
+@brief A directory (or single file) to scan
+*/
+struct ScanRoot {
+  std::string path;                  ///< Directory or file to scan
+  bool recursive = true;             ///< Descend into subdirectories
+  const GlobMatcher* exclude = nullptr; ///< Excluded paths are neither listed nor descended into
+};
+
+/**
+@brief Result of scanning a set of roots; answers existence and stat queries without touching the disk
+
+Lookups normalize paths lexically, so `src//a.cpp` and `./src/a.cpp` find the
+same entry. A path the snapshot cannot vouch for (outside every root, under an
+excluded directory, or below a root that could not be read) is reported as
+unknown so the caller can fall back to the filesystem. The snapshot describes
+the tree at scan time; rescan a root after writing to it.
+*/
+class FsSnapshot {
+  public:
+    /**
+    @brief How a root fared during the scan
+    */
+    enum class RootStatus {
+      Scanned,   ///< Listed (entries() holds its contents)
+      Missing,   ///< Does not exist (everything below it is known to be absent)
+      Failed     ///< Exists but could not be read
+    };
+
+    size_t rootCount() const { return roots_.size(); }
+    const ScanRoot& root(size_t index) const { return roots_[index].root; }
+    RootStatus rootStatus(size_t index) const { return roots_[index].status; }
+
+    /**
+    @brief Entries below a root in walk order (pre-order, as recursive_directory_iterator)
+    */
+    const std::vector<FsEntry>& entries(size_t index) const { return roots_[index].entries; }
+
+    /**
+    @brief Paths skipped under a root because they matched its exclude patterns
+    */
+    const std::vector<std::string>& excluded(size_t index) const { return roots_[index].excluded; }
+
+    /**
+    @brief Look up a path
+    @return The entry, nullptr if the path is known not to exist, or std::nullopt if the snapshot does not cover it
+    */
+    std::optional<const FsEntry*> lookup(std::string_view path) const;
+
+    /**
+    @brief Entries directly inside a scanned directory
+    @param path Directory that was scanned as a root
+    @return The entries (empty for a missing root), or std::nullopt if the directory was not a readable root
+    */
+    std::optional<std::vector<FsEntry>> listDirectory(std::string_view path) const;
+
+    /**
+    @brief Lexical form paths are compared in (generic separators, no `.` or trailing `/`)
+    */
+    static std::string normalize(std::string_view path);
+
+  private:
+    friend class FsScanner;
+
+    struct RootData {
+      ScanRoot root;
+      std::string key;                         ///< normalize(root.path)
+      RootStatus status = RootStatus::Missing;
+      std::vector<FsEntry> entries;            ///< Walk order
+      std::vector<std::string> keys;           ///< Normalized path of each entry
+      std::vector<std::string> excluded;       ///< Excluded paths as walked
+      std::vector<std::string> opaque_keys;    ///< Normalized paths whose contents were not listed
+    };
+
+    std::vector<RootData> roots_;
+    std::unordered_map<std::string, std::pair<size_t, size_t>> index_;  ///< Normalized path -> (root, entry)
+    std::unordered_set<std::string> opaque_;   ///< Excluded, symlinked or unreadable paths (contents unknown)
+
+    /**
+    @brief Rebuild the lookup tables of one root (after it was scanned)
+    */
+    void indexRoot(size_t root_index);
+
+    /**
+    @brief Drop one root's entries from the lookup tables
+    */
+    void unindexRoot(size_t root_index);
+};
+
+/**
+@brief Walks directory trees once, collecting stat data in the same pass
+
+On POSIX systems directories are read with readdir (getdents), file types come
+from d_type and files are stat-ed relative to the open directory (fstatat), so
+no path is resolved from the root again. On Windows FindFirstFileEx returns
+size and modification time with the listing itself. Roots are scanned in
+parallel.
+*/
+class FsScanner {
+  public:
+    /**
+    @brief Set the number of roots scanned at once
+    @param jobs Worker count (0 = hardware concurrency)
+    */
+    void setParallelism(size_t jobs) { parallelism_ = jobs; }
+
+    /**
+    @brief Scan every root
+    @param roots Directories (or single files) to scan
+    @return Snapshot of all roots, in the order given
+    */
+    FsSnapshot scan(const std::vector<ScanRoot>& roots) const;
+
+    /**
+    @brief Scan one root of a snapshot again (e.g. after files under it were written or removed)
+    @param snapshot Snapshot to update
+    @param root_index Root to rescan
+    */
+    void rescan(FsSnapshot& snapshot, size_t root_index) const;
+
+  private:
+    size_t parallelism_ = 0;  ///< Roots scanned at once (0 = hardware concurrency)
+
+    /**
+    @brief Walk one root and store what was found
+    */
+    static void scanRoot(FsSnapshot::RootData& root);
+};
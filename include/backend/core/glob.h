@@ -0,0 +1,82 @@
+/**
+@brief Compiled glob patterns for excluding paths from directory walks
+*/
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+@brief Matches paths against a set of glob patterns compiled once
+
+Patterns use the familiar .gitignore-style syntax:
+
+- `*` matches any run of characters within one path segment, `?` one
+  character, and `[abc]`, `[a-z]` or `[!abc]` one character from a set
+- `**` as a whole segment matches any number of segments (including none)
+- A pattern without a `/` matches the last segment anywhere in the tree
+  (`third_party`, `*_test.*`)
+- A trailing `/` restricts a pattern to directories (`build/`)
+
+Paths are split on `/` (and `\` on Windows); empty and `.` segments are
+ignored, so `./src//a.cpp` and `src/a.cpp` are the same path.
+*/
+class GlobMatcher {
+  public:
+    /**
+    @brief Compile and add a pattern
+    @param pattern Glob pattern
+    @return False (and nothing added) if the pattern is empty
+    */
+    bool add(std::string_view pattern);
+
+    /**
+    @brief Compile and add every pattern in a list
+    @return Number of patterns added
+    */
+    size_t add(const std::vector<std::string>& patterns);
+
+    /**
+    @brief Check whether a file is excluded
+    @param path Path of the file
+    */
+    bool matchesFile(std::string_view path) const;
+
+    /**
+    @brief Check whether a whole directory subtree is excluded
+    @param path Path of the directory
+    @return True if the directory matches a pattern, or a pattern whose last
+            segment is `**` excludes everything inside it
+    */
+    bool matchesDirectory(std::string_view path) const;
+
+    bool empty() const { return patterns_.empty(); }   ///< True if no patterns were added
+    size_t size() const { return patterns_.size(); }   ///< Number of compiled patterns
+
+  private:
+    /**
+    @brief One path segment of a compiled pattern
+    */
+    struct Segment {
+      enum class Kind {
+        Literal,    ///< Compared as a plain string
+        AnyName,    ///< `*` alone: any single segment
+        AnyDepth,   ///< `**`: any number of segments
+        Wildcard    ///< Contains `*`, `?` or `[...]`
+      };
+      Kind kind = Kind::Literal;
+      std::string text;   ///< Segment text for Literal and Wildcard
+    };
+
+    struct Pattern {
+      std::vector<Segment> segments;
+      bool directory_only = false;  ///< Pattern had a trailing `/`
+    };
+
+    std::vector<Pattern> patterns_;  ///< Compiled patterns
+
+    static bool matchSegments(const Pattern& pattern, size_t pattern_index,
+                              const std::vector<std::string_view>& path, size_t path_index,
+                              bool directory);
+};
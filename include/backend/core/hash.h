@@ -0,0 +1,77 @@
+/**
+@brief Streaming content hashing for cache validation
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace hashing {
+
+/**
+@brief Streaming XXH64 hasher
+
+Implements the reference XXH64 algorithm, so digests are identical across
+builds, compilers and platforms (input words are always read little-endian).
+Data may be fed in arbitrary chunks; the digest only depends on the bytes.
+*/
+class XXH64 {
+  public:
+    /**
+    @brief Start a new hash
+    @param seed Hash seed (0 for the canonical digest)
+    */
+    explicit XXH64(uint64_t seed = 0);
+
+    /**
+    @brief Feed the next chunk of input
+    @param data Pointer to input bytes
+    @param length Number of bytes
+    */
+    void update(const void* data, size_t length);
+
+    /**
+    @brief Feed the next chunk of input
+    @param data Input bytes
+    */
+    void update(std::string_view data) { update(data.data(), data.size()); }
+
+    /**
+    @brief Compute the digest of everything fed so far (the hasher can keep streaming)
+    */
+    uint64_t digest() const;
+
+  private:
+    uint64_t seed_;            ///< Seed the hash was started with
+    uint64_t acc_[4];          ///< Stripe accumulators
+    unsigned char buffer_[32]; ///< Partially filled stripe
+    size_t buffered_ = 0;      ///< Bytes currently held in buffer_
+    uint64_t total_length_ = 0;///< Total bytes hashed
+};
+
+/**
+@brief One-shot XXH64 of a byte range
+*/
+uint64_t xxh64(std::string_view data, uint64_t seed = 0);
+
+/**
+@brief Format a 64-bit digest as 16 lowercase hex digits
+*/
+std::string toHex(uint64_t digest);
+
+/**
+@brief Hash a file's content in fixed-size chunks without loading it whole
+@param file_path Path to file
+@return Digest formatted as "xxh64:<16 hex digits>", or nullopt if the file could not be read
+*/
+std::optional<std::string> hashFile(const std::string& file_path);
+
+/**
+@brief Hash an in-memory string in the same format as hashFile
+*/
+std::string hashString(std::string_view data);
+
+}
@@ -7,10 +7,12 @@ modification, and serialization of JSON data.
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
-#include <functional>
+#include <utility>
 #include "yyjson.h"
 
 // Re-export key yyjson types to suppress unused include warnings
@@ -18,7 +20,6 @@ using ::yyjson_val;
 using ::yyjson_doc;
 using ::yyjson_mut_doc;
 using ::yyjson_mut_val;
-#include <functional>
 #include "yyjson.h"
 
 // Re-export key yyjson types to suppress unused include warnings
@@ -41,7 +42,7 @@ class JsonValue {
     /**
     @brief Construct JsonValue from yyjson value pointer
     */
-    explicit JsonValue(yyjson_val* val);
+    explicit JsonValue(yyjson_val* val) : val_(val) {}
 
     // Type checking methods
     bool isNull() const;    ///< Check if value is null
@@ -62,6 +63,16 @@ class JsonValue {
     */
     int asInt(int default_val = 0) const;
 
+    /**
+    @brief Get value as 64-bit signed integer with default fallback
+    */
+    int64_t asInt64(int64_t default_val = 0) const;
+
+    /**
+    @brief Get value as 64-bit unsigned integer with default fallback
+    */
+    uint64_t asUint64(uint64_t default_val = 0) const;
+
     /**
     @brief Get value as double with default fallback
     */
@@ -88,19 +99,119 @@ class JsonValue {
     JsonValue operator[](const std::string& key) const;
     JsonValue operator[](size_t index) const;
 
-    // Iteration support - overloaded for object vs array callbacks
-    void forEachObject(std::function<void(const std::string&, JsonValue)> callback) const {
-      if (isObject()) {
+    /**
+    @brief Forward iterator over the members of an object as (key, value) pairs
+    */
+    class MemberIterator {
+      public:
+        using value_type = std::pair<std::string_view, JsonValue>;
+        using difference_type = std::ptrdiff_t;
+
+        MemberIterator() = default;  ///< End iterator
+        explicit MemberIterator(yyjson_val* obj) {
+          if (yyjson_obj_iter_init(obj, &iter_)) {
+            key_ = yyjson_obj_iter_next(&iter_);
+          }
+        }
+
+        value_type operator*() const {
+          return {std::string_view(yyjson_get_str(key_), yyjson_get_len(key_)), JsonValue(yyjson_obj_iter_get_val(key_))};
+        }
+        MemberIterator& operator++() {
+          key_ = yyjson_obj_iter_next(&iter_);
+          return *this;
+        }
+        MemberIterator operator++(int) {
+          MemberIterator previous = *this;
+          ++*this;
+          return previous;
+        }
+        bool operator==(const MemberIterator& other) const { return key_ == other.key_; }
+
+      private:
+        yyjson_obj_iter iter_{};     ///< yyjson iteration state
+        yyjson_val* key_ = nullptr;  ///< Current key (null at the end)
+    };
+
+    /**
+    @brief Forward iterator over the elements of an array
+    */
+    class ElementIterator {
+      public:
+        using value_type = JsonValue;
+        using difference_type = std::ptrdiff_t;
+
+        ElementIterator() = default;  ///< End iterator
+        explicit ElementIterator(yyjson_val* arr) {
+          if (yyjson_arr_iter_init(arr, &iter_)) {
+            item_ = yyjson_arr_iter_next(&iter_);
+          }
+        }
+
+        JsonValue operator*() const { return JsonValue(item_); }
+        ElementIterator& operator++() {
+          item_ = yyjson_arr_iter_next(&iter_);
+          return *this;
+        }
+        ElementIterator operator++(int) {
+          ElementIterator previous = *this;
+          ++*this;
+          return previous;
+        }
+        bool operator==(const ElementIterator& other) const { return item_ == other.item_; }
+
+      private:
+        yyjson_arr_iter iter_{};      ///< yyjson iteration state
+        yyjson_val* item_ = nullptr;  ///< Current element (null at the end)
+    };
+
+    /**
+    @brief A begin/end pair so iterators can be used in range-based for loops
+    */
+    template<typename Iterator> struct Range {
+      Iterator first;
+      Iterator begin() const { return first; }
+      Iterator end() const { return Iterator(); }
+    };
+
+    /**
+    @brief Members of an object, for `for (auto [key, value] : json.members())`
+
+    Keys are views into the document and stay valid as long as it does.
+    Empty if this is not an object.
+    */
+    Range<MemberIterator> members() const {
+      return {val_ && yyjson_is_obj(val_) ? MemberIterator(val_) : MemberIterator()};
+    }
+
+    /**
+    @brief Elements of an array (empty if this is not an array)
+    */
+    Range<ElementIterator> elements() const {
+      return {val_ && yyjson_is_arr(val_) ? ElementIterator(val_) : ElementIterator()};
+    }
+
+    /**
+    @brief Call `callback(key, value)` for each object member
+
+    The loop is the plain yyjson one: no std::function and no key copies.
+    The key is a std::string_view into the document.
+    */
+    template<typename Func> void forEachObject(Func&& callback) const {
+      if (val_ && yyjson_is_obj(val_)) {
         size_t idx, max;
         yyjson_val* key, *val;
         yyjson_obj_foreach(val_, idx, max, key, val) {
-          callback(yyjson_get_str(key), JsonValue(val));
+          callback(std::string_view(yyjson_get_str(key), yyjson_get_len(key)), JsonValue(val));
         }
       }
     }
 
-    void forEachArray(std::function<void(size_t, JsonValue)> callback) const {
-      if (isArray()) {
+    /**
+    @brief Call `callback(index, value)` for each array element
+    */
+    template<typename Func> void forEachArray(Func&& callback) const {
+      if (val_ && yyjson_is_arr(val_)) {
         size_t idx, max;
         yyjson_val* item;
         yyjson_arr_foreach(val_, idx, max, item) {
@@ -109,16 +220,14 @@ class JsonValue {
       }
     }
 
-    // Legacy template forEach - automatically detects type and calls appropriate method
-    template<typename Func> void forEach(Func callback) const {
+    /**
+    @brief forEachObject for an object and forEachArray for an array
+    */
+    template<typename Func> void forEach(Func&& callback) const {
       if (isObject()) {
-        forEachObject([callback](const std::string& key, JsonValue value) {
-          callback(key, value);
-        });
+        forEachObject(callback);
       } else if (isArray()) {
-        forEachArray([callback](size_t idx, JsonValue value) {
-          callback(idx, value);
-        });
+        forEachArray(callback);
       }
     }
 
@@ -178,11 +287,32 @@ class JsonProxy {
 };
 
 /**
-@brief Main JSON document class supporting both reading and writing
+@brief Pooled allocator shared by documents parsed one after another
 
-RAII wrapper around yyjson documents that provides safe parsing,
-modification, and serialization of JSON data.
+Wraps yyjson's dynamic allocator. Memory a freed document gave back is
+reused by the next one, so a loop parsing many small documents (e.g. journal
+records) does not return to malloc for each. It must outlive every document
+parsed with it, and like the documents it is not thread-safe.
 */
+class JsonAllocator {
+  public:
+    JsonAllocator() : alc_(yyjson_alc_dyn_new()) {}
+    ~JsonAllocator() {
+      if (alc_) yyjson_alc_dyn_free(alc_);
+    }
+
+    JsonAllocator(const JsonAllocator&) = delete;
+    JsonAllocator& operator=(const JsonAllocator&) = delete;
+
+    /**
+    @brief The yyjson allocator (null if it could not be created, which yyjson treats as malloc)
+    */
+    const yyjson_alc* get() const { return alc_; }
+
+  private:
+    yyjson_alc* alc_;  ///< Dynamic pool allocator
+};
+
 /**
 @brief Main JSON document class supporting both reading and writing
 
@@ -225,6 +355,27 @@ class JsonDoc {
     */
     static std::optional<JsonDoc> fromFile(const std::string& path);
 
+    /**
+    @brief Parse strict JSON text (strings are copied into the document)
+    @param text JSON text
+    @param allocator Allocator for the document (nullptr = malloc)
+    @return Parsed document, or nullopt on parse error (not logged)
+    */
+    static std::optional<JsonDoc> parse(std::string_view text, const JsonAllocator* allocator = nullptr);
+
+    /**
+    @brief Parse strict JSON text in place, without copying strings
+
+    yyjson unescapes strings inside the buffer and the document's strings
+    point into it. Use this for large inputs that are read once. The buffer is
+    padded with YYJSON_PADDING_SIZE zero bytes first.
+
+    @param buffer JSON text; modified, and must outlive the document unchanged
+    @param allocator Allocator for the document (nullptr = malloc)
+    @return Parsed document, or nullopt on parse error (not logged)
+    */
+    static std::optional<JsonDoc> parseInSitu(std::string& buffer, const JsonAllocator* allocator = nullptr);
+
     /**
     @brief Access/modify JSON value by key (mutable)
     */
@@ -235,6 +386,11 @@ class JsonDoc {
     */
     JsonValue operator[](const std::string& key) const;
 
+    /**
+    @brief The root value (read-only)
+    */
+    JsonValue root() const;
+
     /**
     @brief Write JSON document to file
     @param path Output file path
@@ -243,6 +399,24 @@ class JsonDoc {
     */
     bool writeToFile(const std::string& path, bool pretty = true) const;
 
+    /**
+    @brief Serialize the document
+    @param pretty Whether to format with indentation
+    @return JSON text (empty on error)
+    */
+    std::string toString(bool pretty = false) const;
+
+    /**
+    @brief The mutable document (made mutable first if needed)
+
+    For building large documents directly with the yyjson_mut_* API. The
+    root is an object unless the document was parsed from something else.
+    */
+    yyjson_mut_doc* mutableDoc() {
+      ensureMutable();
+      return mut_doc_;
+    }
+
     /**
     @brief Check if document was parsed successfully
     */
@@ -251,3 +425,10 @@ class JsonDoc {
   private:
     void ensureMutable();
 };
+
+/**
+@brief Quote text as a JSON string literal for hand-written JSON (paths may contain backslashes on Windows)
+@param text Raw text
+@return Text wrapped in double quotes with JSON escapes applied
+*/
+std::string quoteJson(std::string_view text);
@@ -3,7 +3,12 @@
 */
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <string_view>
+#include <type_traits>
+
+class JsonDoc;
 
 /**
 @brief ANSI color codes for terminal output formatting
@@ -65,14 +70,18 @@ struct LoggingConfig {
   MessageType console_level = MessageType::Info;        ///< Minimum level for console output
   MessageType file_level = MessageType::Debug;          ///< Minimum level for file output
   std::string log_file = "";                           ///< Log file path (empty = no file logging)
-  size_t max_file_size_mb = 10;                        ///< Maximum log file size in MB
-  int backup_count = 5;                                ///< Number of backup files to keep
+  size_t max_file_size_mb = 10;                        ///< Log file is rotated before exceeding this size in MB (0 = never)
+  int backup_count = 5;                                ///< Number of rotated files (log.1 ... log.N) to keep
   bool enable_colors = true;                           ///< Enable ANSI color codes
   bool enable_timestamps = true;                       ///< Include timestamps in messages
 };
 
 /**
 @brief Colored CLI logging system with timestamp formatting and file output
+
+Console output is written synchronously. Log file lines go through a
+lock-free queue to a writer thread that batches flushes and rotates the file
+by size, so file-only debug logging does not stall extraction workers.
 */
 namespace Logger {
   /**
@@ -93,6 +102,20 @@ namespace Logger {
   */
   void configureFromFile(const std::string& config_file_path);
 
+  /**
+  @brief Configure logging from the "logging" object of an already parsed configuration
+  @param config Parsed configuration document (nothing changes if it has no "logging" key)
+  */
+  void configureFromDoc(const JsonDoc& config);
+
+  /**
+  @brief Block until every message queued for the log file has been written
+
+  File output is written by a background thread; this runs automatically at
+  exit and after error or critical messages.
+  */
+  void flush();
+
   /**
   @brief Get current timestamp string with millisecond precision
   @return Formatted timestamp string
@@ -114,6 +137,44 @@ namespace Logger {
   */
   bool shouldLog(MessageType type, bool for_console = true);
 
+  namespace detail {
+    extern std::atomic<int> enabled_level;  ///< Lowest level written anywhere (console or log file)
+
+    inline void appendPiece(std::string& out, std::string_view piece) { out.append(piece); }
+    inline void appendPiece(std::string& out, char piece) { out.push_back(piece); }
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, char>>>
+    void appendPiece(std::string& out, T piece) {
+      if constexpr (std::is_same_v<T, bool>) {
+        out.append(piece ? "true" : "false");
+      } else {
+        out.append(std::to_string(piece));
+      }
+    }
+  }
+
+  /**
+  @brief Check whether a message of this type would be written to the console or the log file
+  @param type Message type to check
+  @return True if a log() call of this type produces output somewhere
+
+  One relaxed atomic load, so hot paths can call it before building a message.
+  */
+  inline bool isEnabled(MessageType type) {
+    return static_cast<int>(type) >= detail::enabled_level.load(std::memory_order_relaxed);
+  }
+
+  /**
+  @brief Concatenate strings, characters and numbers into one message
+  @param pieces Values appended in order (numbers via std::to_string)
+  @return Concatenated message
+  */
+  template <typename... Pieces>
+  std::string concat(const Pieces&... pieces) {
+    std::string out;
+    (detail::appendPiece(out, pieces), ...);
+    return out;
+  }
+
   /**
   @brief Print a message with appropriate formatting based on message type
   @param type Message type determining color and format
@@ -142,4 +203,38 @@ namespace Logger {
   void debug(const std::string& message);
   void debuglow(const std::string& message);
   void debuglow2(const std::string& message);
-}
\ No newline at end of file
+}
+
+/**
+@brief Levels below this are compiled out of the LOG_* macros
+
+Define CESIUM_LOG_COMPILED_LEVEL (e.g. to LogLevel::stdout_level via the
+CESIUM_STRIP_DEBUG_LOGS build option) to drop debug output from release
+builds entirely; the message arguments are then never evaluated.
+*/
+#ifndef CESIUM_LOG_COMPILED_LEVEL
+  #define CESIUM_LOG_COMPILED_LEVEL 0
+#endif
+
+/**
+@brief Log a message built from pieces only when its level is enabled
+
+The arguments are passed to Logger::concat, and only evaluated if a message of
+this type would be written, so callers can build messages with std::to_string
+and string concatenation without paying for them when the level is filtered:
+
+  LOG_DEBUG("Parsed ", node_count, " nodes in ", filename);
+  LOG_DEBUG("Parsed " + std::to_string(node_count) + " nodes");
+*/
+#define CESIUM_LOG(type, ...)                                                    \
+  do {                                                                           \
+    if constexpr (static_cast<int>(type) >= CESIUM_LOG_COMPILED_LEVEL) {         \
+      if (Logger::isEnabled(type)) {                                             \
+        Logger::log(type, Logger::concat(__VA_ARGS__));                          \
+      }                                                                          \
+    }                                                                            \
+  } while (0)
+
+#define LOG_DEBUG(...) CESIUM_LOG(MessageType::Debug, __VA_ARGS__)
+#define LOG_DEBUGLOW(...) CESIUM_LOG(MessageType::DebugLow, __VA_ARGS__)
+#define LOG_DEBUGLOW2(...) CESIUM_LOG(MessageType::DebugLow2, __VA_ARGS__)
@@ -0,0 +1,55 @@
+/**
+@brief Cross-platform read-only memory-mapped files
+*/
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+@brief RAII read-only mapping of a whole file
+
+Maps the file with mmap (POSIX) or CreateFileMapping (Windows) so callers can
+read it in place without copying it into a buffer. An empty file opens
+successfully with size() == 0 and a null data() pointer.
+*/
+class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+    @brief Map a file, replacing any current mapping
+    @param path Path to file
+    @return True if the file was mapped (or is empty)
+    */
+    bool open(const std::string& path);
+
+    /**
+    @brief Unmap the file (safe to call when nothing is mapped)
+    */
+    void close();
+
+    bool isOpen() const { return open_; }                 ///< True while a file is mapped
+    const unsigned char* data() const { return data_; }   ///< Start of the mapped bytes
+    size_t size() const { return size_; }                 ///< Number of mapped bytes
+
+    /**
+    @brief View of the mapped bytes as characters
+    */
+    std::string_view view() const { return {reinterpret_cast<const char*>(data_), size_}; }
+
+  private:
+    const unsigned char* data_ = nullptr;  ///< Mapped bytes (null for empty files)
+    size_t size_ = 0;                      ///< Mapping length
+    bool open_ = false;                    ///< True while a file is mapped
+    #ifdef _WIN32
+      void* mapping_ = nullptr;            ///< File mapping object handle
+    #endif
+};
@@ -0,0 +1,114 @@
+/**
+@brief Batched writer for producing many small output files
+*/
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+@brief Queues whole-file writes and flushes them in batches
+
+Each queued file is written with a single unbuffered write once the batch
+fills up (or on flush()), optionally spread over several threads so the
+per-file open/write/close latency of slow or networked filesystems overlaps.
+Content buffers are recycled between batches, so steady-state rendering does
+not reallocate.
+*/
+class OutputWriter {
+  public:
+    static constexpr size_t kDefaultBatchBytes = 4 * 1024 * 1024;  ///< Pending bytes that trigger a flush
+
+    /**
+    @brief Constructor
+    @param batch_bytes Pending bytes that trigger an automatic flush
+    */
+    explicit OutputWriter(size_t batch_bytes = kDefaultBatchBytes);
+
+    /**
+    @brief Flushes anything still queued
+    */
+    ~OutputWriter();
+
+    OutputWriter(const OutputWriter&) = delete;
+    OutputWriter& operator=(const OutputWriter&) = delete;
+
+    /**
+    @brief Set the number of threads used to write a batch
+    @param jobs Number of writer threads (0 = hardware concurrency)
+    */
+    void setJobs(size_t jobs) { jobs_ = jobs; }
+
+    /**
+    @brief Get an empty buffer to render into (recycled from earlier writes when possible)
+    */
+    std::string acquireBuffer();
+
+    /**
+    @brief Queue a file to be written, flushing if the batch is full
+    @param path Destination path (replaced by a new file, see replaceWholeFile)
+    @param content File content; the buffer is recycled after the write
+    */
+    void write(const std::string& path, std::string content);
+
+    /**
+    @brief Write every queued file
+    @return True if all queued files were written
+    */
+    bool flush();
+
+    /**
+    @brief Paths that failed to write since the last resetStats()
+    */
+    const std::vector<std::string>& failedPaths() const { return failed_paths_; }
+
+    size_t filesWritten() const { return files_written_; }  ///< Files written since the last resetStats()
+    size_t bytesWritten() const { return bytes_written_; }  ///< Bytes written since the last resetStats()
+
+    /**
+    @brief Reset the written/failed counters
+    */
+    void resetStats();
+
+  private:
+    /**
+    @brief A queued whole-file write
+    */
+    struct PendingFile {
+      std::string path;     ///< Destination path
+      std::string content;  ///< Bytes to write
+    };
+
+    static constexpr size_t kMaxSpareBuffers = 64;  ///< Recycled buffers kept between batches
+
+    std::vector<PendingFile> pending_;       ///< Files queued for the next flush
+    std::vector<std::string> spare_buffers_; ///< Cleared buffers ready for reuse
+    std::vector<std::string> failed_paths_;  ///< Paths whose write failed
+    size_t pending_bytes_ = 0;               ///< Bytes queued for the next flush
+    size_t batch_bytes_;                     ///< Flush threshold in bytes
+    size_t jobs_ = 1;                        ///< Writer threads per batch
+    size_t files_written_ = 0;               ///< Files written
+    size_t bytes_written_ = 0;               ///< Bytes written
+};
+
+/**
+@brief Write a whole file with a single unbuffered write
+@param path Destination path (overwritten)
+@param content Bytes to write
+@return True if the file was written completely
+*/
+bool writeWholeFile(const std::string& path, const std::string& content);
+
+/**
+@brief Replace a file by writing a temporary next to it and renaming it into place
+
+The destination always ends up as a new file, so hard links to the old one
+(such as published pages linked to their snippets) keep the old content, and
+a failed write leaves the old file intact.
+
+@param path Destination path
+@param content Bytes to write
+@return True if the file was written and renamed into place
+*/
+bool replaceWholeFile(const std::string& path, const std::string& content);
@@ -0,0 +1,81 @@
+/**
+@brief Minimal worker pool helpers for fanning independent work items out over threads
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+  /**
+  @brief Resolve a requested job count to the number of workers actually spawned
+  @param requested Requested number of jobs (0 = use hardware concurrency)
+  @param work_items Number of work items to be processed (caps the worker count)
+  @return Number of workers to use, always at least 1
+  */
+  inline size_t resolveJobCount(size_t requested, size_t work_items) {
+    size_t jobs = requested;
+    if (jobs == 0) {
+      jobs = std::thread::hardware_concurrency();
+      if (jobs == 0) jobs = 1;
+    }
+    return std::max<size_t>(1, std::min(jobs, work_items));
+  }
+
+  /**
+  @brief Invoke func(worker_index, item_index) for every item in [0, count) on a pool of workers
+
+  Items are handed out one at a time through a shared atomic counter so a few large
+  items cannot stall a statically partitioned range. The calling thread participates
+  as worker 0, so workers == 1 runs everything inline without spawning threads.
+  The first exception thrown by any worker stops the remaining items from being
+  started and is rethrown on the calling thread once all workers have joined.
+
+  @param count Number of work items
+  @param workers Number of workers (see resolveJobCount)
+  @param func Callable taking (size_t worker_index, size_t item_index)
+  */
+  template<typename Func>
+  void forEachIndex(size_t count, size_t workers, Func&& func) {
+    if (count == 0) return;
+    workers = std::max<size_t>(1, std::min(workers, count));
+
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr first_error;
+    std::mutex error_mutex;
+
+    auto worker_loop = [&](size_t worker_index) {
+      while (!failed.load(std::memory_order_relaxed)) {
+        size_t item = next.fetch_add(1, std::memory_order_relaxed);
+        if (item >= count) break;
+        try {
+          func(worker_index, item);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!first_error) first_error = std::current_exception();
+          failed.store(true, std::memory_order_relaxed);
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w) {
+      threads.emplace_back(worker_loop, w);
+    }
+    worker_loop(0);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    if (first_error) {
+      std::rethrow_exception(first_error);
+    }
+  }
+}
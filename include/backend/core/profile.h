@@ -0,0 +1,161 @@
+/**
+@brief Per-stage timers and counters for profiling a documentation run
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace profile {
+  namespace detail {
+    extern std::atomic<bool> enabled;  ///< Set between start() and stop()
+
+    /**
+    @brief Nanoseconds on the steady clock
+    */
+    inline int64_t now() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void record(const char* stage, std::string&& item, int64_t start_ns, int64_t end_ns);
+    void addCount(const char* counter, uint64_t amount);
+    void addPeakMemory(std::string_view item, uint64_t bytes);
+  }
+
+  /**
+  @brief Check whether profiling is recording
+  @return True between start() and stop()
+  */
+  inline bool enabled() {
+    return detail::enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+  @brief Discard anything recorded so far and start recording
+  */
+  void start();
+
+  /**
+  @brief Stop recording (what was recorded stays available for reports)
+  */
+  void stop();
+
+  /**
+  @brief Add to a named counter (no-op unless profiling)
+  @param counter Counter name (must be a string literal or otherwise outlive the report)
+  @param amount Amount to add
+  */
+  inline void count(const char* counter, uint64_t amount = 1) {
+    if (enabled()) {
+      detail::addCount(counter, amount);
+    }
+  }
+
+  /**
+  @brief Record the most memory a file needed (no-op unless profiling)
+  @param item File path, as passed to the "file" stage timer
+  @param bytes Peak bytes; the largest of several records for the same item is kept
+  */
+  inline void peakMemory(std::string_view item, uint64_t bytes) {
+    if (enabled()) {
+      detail::addPeakMemory(item, bytes);
+    }
+  }
+
+  /**
+  @brief Times the enclosing scope as one occurrence of a stage
+
+  When profiling is off this costs one relaxed atomic load and records
+  nothing; the item is not even copied.
+  */
+  class ScopedTimer {
+    public:
+      /**
+      @param stage Stage name (must be a string literal or otherwise outlive the report)
+      @param item What the stage worked on, e.g. a file path (optional)
+      */
+      explicit ScopedTimer(const char* stage, std::string_view item = {}) : stage_(stage) {
+        if (enabled()) {
+          item_ = item;
+          start_ns_ = detail::now();
+        }
+      }
+
+      ~ScopedTimer() { stop(); }
+
+      ScopedTimer(const ScopedTimer&) = delete;
+      ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+      /**
+      @brief Record the stage now instead of at the end of the scope
+      */
+      void stop() {
+        if (start_ns_ >= 0) {
+          detail::record(stage_, std::move(item_), start_ns_, detail::now());
+          start_ns_ = -1;
+        }
+      }
+
+    private:
+      const char* stage_;        ///< Stage name
+      std::string item_;         ///< Item the stage worked on (empty if none)
+      int64_t start_ns_ = -1;    ///< Start time, or -1 if not recording
+  };
+
+  /**
+  @brief Totals for one stage
+  */
+  struct StageSummary {
+    std::string stage;       ///< Stage name
+    uint64_t calls = 0;      ///< Number of times the stage ran
+    double total_ms = 0;     ///< Summed duration (across threads, so may exceed wall time)
+    double max_ms = 0;       ///< Longest single occurrence
+  };
+
+  /**
+  @brief Time spent on one source file
+  */
+  struct FileTiming {
+    std::string path;        ///< Source file
+    double total_ms = 0;     ///< Whole per-file extraction
+    double parse_ms = 0;     ///< Of which tree-sitter parsing
+    uint64_t peak_bytes = 0; ///< Most tree-sitter memory live while extracting it (0 if not recorded)
+  };
+
+  /**
+  @brief Totals per stage, in order of first occurrence
+  */
+  std::vector<StageSummary> stageSummaries();
+
+  /**
+  @brief The files whose extraction took longest
+  @param limit Number of files to return
+  @return Files from the "file" stage, slowest first
+  */
+  std::vector<FileTiming> slowestFiles(size_t limit);
+
+  /**
+  @brief Write everything recorded as a Chrome trace with the summaries alongside
+
+  The file is Trace Event Format JSON, so it opens directly in chrome://tracing
+  or Perfetto; the "stages", "counters" and "slowest_files" keys carry the
+  same totals printSummary shows, for scripts comparing runs. Slowest files
+  with a recorded peak carry it as "peak_kb".
+
+  @param path Output file
+  @param slowest Number of files listed under "slowest_files"
+  @return False if the file could not be written
+  */
+  bool writeReport(const std::string& path, size_t slowest);
+
+  /**
+  @brief Print stage totals, counters and the slowest files to stdout
+  @param slowest Number of files to list
+  */
+  void printSummary(size_t slowest);
+}
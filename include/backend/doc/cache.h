@@ -4,21 +4,34 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <memory>
 #include <chrono>
+#include <fstream>
+#include <mutex>
 #include <optional>
+#include <cstdint>
 #include <backend/core/json.h>
+#include <backend/core/fs_scan.h>
+#include <backend/doc/snippet_archive.h>
 
 /**
 @brief Metadata about a single extracted file
 */
 struct FileMetadata {
   std::string source_path;                    ///< Path to source file
-  std::string content_hash;                   ///< SHA-256 hash of file content
+  std::string content_hash;                   ///< Streaming XXH64 of file content ("xxh64:<hex>")
   std::string last_modified_str;              ///< Last modification time as string
+  int64_t mtime_ticks = 0;                    ///< Raw last_write_time ticks (exact, unlike last_modified_str)
+  uint64_t file_size = 0;                     ///< File size in bytes when last hashed
+  uint64_t inode = 0;                         ///< File inode/index when last hashed (0 if unavailable)
   std::vector<std::string> generated_files;   ///< List of generated markdown files
-  std::vector<std::string> dependencies;     ///< Files this depends on
+  std::vector<std::string> output_hashes;     ///< Content hash of each generated file (index-aligned, may be empty)
+  std::vector<std::string> dependencies;      ///< Files whose changes invalidate this one (includes, merge partners)
   size_t construct_count;                     ///< Number of constructs extracted
   std::string language;                       ///< Language used for extraction
   
@@ -26,6 +39,25 @@ struct FileMetadata {
   FileMetadata() = default;
 };
 
+/**
+@brief Policy for deciding whether a cached file's content may have changed
+*/
+enum class HashPolicy {
+  Stat,     ///< Trust an unchanged (mtime, size, inode) tuple; hash only when it differs
+  Content   ///< Always hash file content, even when the stat tuple is unchanged
+};
+
+/**
+@brief On-disk format used when saving the cache
+*/
+enum class CacheFormat {
+  Json,     ///< Human-readable .cesium-cache.json, fully parsed on load
+  Binary    ///< Memory-mapped .cesium-cache.bin, queried in place
+};
+
+class BinaryCacheView;
+struct BinaryCacheRecord;
+
 /**
 @brief Cache entry for tracking extraction metadata
 */
@@ -46,43 +78,120 @@ class DocumentationCache {
     @param cache_file_path Path to cache file (JSON format)
     */
     explicit DocumentationCache(const std::string& cache_file_path);
+    ~DocumentationCache();
+
+    /**
+    @brief Apply cache settings from configuration ("hash_policy", "cache_format", "output_mode")
+    @param config Loaded configuration document
+    */
+    void applyConfig(const JsonDoc& config);
 
     /**
     @brief Load cache from disk
+
+    In binary format the .bin file is mapped and only validated; entries are
+    decoded on demand. If no binary cache exists yet, the JSON cache is loaded
+    instead and migrated on the next save.
+
     @return True if cache was loaded successfully, false if not found or corrupted
     */
     bool load();
 
     /**
-    @brief Save cache to disk
+    @brief Write a full snapshot of the cache and truncate the journal (compaction)
     @return True if cache was saved successfully
     */
     bool save();
 
     /**
-    @brief Save cache to disk immediately (for incremental updates)
+    @brief Make all updates so far durable (for incremental updates)
+
+    With the journal enabled this only flushes the journal, compacting into a
+    full snapshot once enough records have accumulated; otherwise it writes a
+    full snapshot like save().
+
     @return True if cache was saved successfully
     */
     bool saveImmediately();
 
+    /**
+    @brief Enable or disable the append-only update journal
+    @param enabled True to journal updateFile/removeFile instead of rewriting the snapshot
+    */
+    void setJournalEnabled(bool enabled) { journal_enabled_ = enabled; }
+
+    /**
+    @brief Path of the journal file that accompanies the JSON cache path
+    */
+    std::string journalPath() const;
+
     /**
     @brief Check if a file needs extraction based on cache
+
+    Dependencies are followed transitively, so a file is also re-extracted when
+    anything it includes (directly or indirectly) or shares merged output with
+    has changed. Between beginChangeScan() and endChangeScan() change results
+    are memoized, so each file is checked at most once per scan no matter how
+    many files depend on it.
+
+    Like updateFile and removeFile, this may be called concurrently from extraction workers.
+
     @param source_path Path to source file
     @return True if file needs extraction (new, modified, or dependencies changed)
     */
     bool needsExtraction(const std::string& source_path);
 
+    /**
+    @brief Start memoizing change results for a pass over the source tree
+
+    Files must not be edited during a scan; results would be stale.
+    */
+    void beginChangeScan();
+
+    /**
+    @brief Stop memoizing change results and drop the memo
+    */
+    void endChangeScan();
+
+    /**
+    @brief Answer existence and stat queries from a filesystem snapshot
+
+    Paths the snapshot covers are not touched on disk; others fall back to the
+    filesystem. The snapshot must stay alive and match the disk while set, so
+    clear it before writing generated files.
+
+    @param snapshot Snapshot of the source and extract directories (nullptr = use the filesystem)
+    */
+    void setSnapshot(const FsSnapshot* snapshot) { snapshot_ = snapshot; }
+
     /**
     @brief Update cache entry for a processed file
     @param source_path Path to source file
     @param generated_files List of generated markdown files
     @param construct_count Number of constructs extracted
     @param language Language used for extraction
+    @param dependencies Files whose changes should invalidate this one
+    @param output_hashes Content hash of each generated file, index-aligned with generated_files
     */
     void updateFile(const std::string& source_path, 
                    const std::vector<std::string>& generated_files,
                    size_t construct_count,
-                   const std::string& language);
+                   const std::string& language,
+                   const std::vector<std::string>& dependencies = {},
+                   const std::vector<std::string>& output_hashes = {});
+
+    /**
+    @brief Content hashes recorded for generated files across all entries
+    @return Output path -> content hash
+    */
+    std::unordered_map<std::string, std::string> recordedOutputHashes() const;
+
+    /**
+    @brief Cached files that depend on any of the given files, directly or transitively
+    @param paths Changed files (compared after lexical normalization)
+    @return Dependent source paths as recorded, excluding the given files themselves
+    */
+    std::vector<std::string> dependentsOf(const std::vector<std::string>& paths) const;
 
     /**
     @brief Remove a file from cache (when source file is deleted)
@@ -105,12 +214,18 @@ class DocumentationCache {
 
     /**
     @brief Remove orphaned files and update cache
+    Files are unlinked in batches on up to setJobs() workers; the log lists them in a fixed order.
     @param extract_dir Directory containing generated files
     @param dry_run If true, only report what would be deleted without actually deleting
     @return Number of files removed/would be removed
     */
     size_t pruneOrphanedFiles(const std::string& extract_dir, bool dry_run = false);
 
+    /**
+    @brief Set how many workers pruneOrphanedFiles may use (0 uses every hardware thread)
+    */
+    void setJobs(size_t jobs) { jobs_ = jobs; }
+
     /**
     @brief Get cache statistics
     @return Pair of (total_files, total_generated_files)
@@ -119,6 +234,7 @@ class DocumentationCache {
 
     /**
     @brief Calculate integrity hash of current directory state
+    The digest sums one hash of name, size and mtime per page, so it does not depend on listing order.
     @param extract_dir Directory containing generated files
     @return Hash representing current state of generated files
     */
@@ -126,37 +242,220 @@ class DocumentationCache {
 
     /**
     @brief Verify cache integrity against directory state
+
+    The directory is listed once and compared with the cached pages in a single
+    sorted merge. While the state saved by recordIntegrity() still matches, the
+    check returns without the comparison. Nothing is written.
+
     @param extract_dir Directory containing generated files
     @return True if cache matches directory state
     */
     bool verifyIntegrity(const std::string& extract_dir) const;
 
+    /**
+    @brief Record the directory hash and a digest of the cached pages as verified
+
+    Call only after verifyIntegrity() passed for the same state; the stamp lets
+    later checks skip the comparison. Archive mode keeps no stamp.
+
+    @param extract_dir Directory containing generated files
+    @return True if the stamp was written (or is not used)
+    */
+    bool recordIntegrity(const std::string& extract_dir);
+
+    /**
+    @brief File in which recordIntegrity saves the last verified state of a directory
+    */
+    static std::string integrityStampPath(const std::string& extract_dir);
+
     /**
     @brief Clear all cache data
     */
     void clear();
 
+    /**
+    @brief Set the change detection policy used by needsExtraction
+    @param policy Stat (default) or Content
+    */
+    void setHashPolicy(HashPolicy policy) { hash_policy_ = policy; }
+
+    /**
+    @brief Parse a hash policy name from configuration ("stat" or "content")
+    @param name Policy name
+    @param policy Receives the parsed policy on success
+    @return True if the name was recognized
+    */
+    static bool parseHashPolicy(const std::string& name, HashPolicy& policy);
+
+    /**
+    @brief Set the format used by save (loading accepts either format)
+    @param format Json (default) or Binary
+    */
+    void setFormat(CacheFormat format) { format_ = format; }
+
+    /**
+    @brief Parse a cache format name from configuration ("json" or "binary")
+    @param name Format name
+    @param format Receives the parsed format on success
+    @return True if the name was recognized
+    */
+    static bool parseFormat(const std::string& name, CacheFormat& format);
+
+    /**
+    @brief Set where generated outputs are looked up (files on disk or the snippet archive)
+    @param mode Files (default) or Archive; the archive sits next to the cache file
+    */
+    void setOutputMode(OutputMode mode) { output_mode_ = mode; }
+
+    /**
+    @brief Write the whole cache as JSON regardless of the save format (export/debugging)
+    @param output_path Destination file
+    @return True if the file was written
+    */
+    bool exportJson(const std::string& output_path) const;
+
+    /**
+    @brief Path of the binary cache file that accompanies the JSON cache path
+    */
+    std::string binaryPath() const;
+
   private:
     std::string cache_file_path_;  ///< Path to cache file
-    CacheEntry cache_;             ///< In-memory cache data
+    CacheEntry cache_;             ///< In-memory cache data (entries changed since the binary cache was mapped)
+    HashPolicy hash_policy_ = HashPolicy::Stat;  ///< Change detection policy
+    CacheFormat format_ = CacheFormat::Json;     ///< Format written by save
+    std::unique_ptr<BinaryCacheView> base_;      ///< Mapped binary cache, shadowed by cache_.files
+    std::unordered_set<std::string> removed_;    ///< Mapped entries removed since load
+    bool journal_enabled_ = true;                ///< Append updates to the journal between snapshots
+    std::ofstream journal_;                      ///< Open journal stream (opened on first append)
+    size_t journal_records_ = 0;                 ///< Records in the journal since the last snapshot
+    mutable std::mutex mutex_;                   ///< Guards entries and the journal across workers
+    bool scanning_ = false;                      ///< Memoize change results (inside a change scan)
+    std::unordered_map<std::string, bool> changed_memo_;     ///< Per-file "own content changed" results
+    std::unordered_map<std::string, bool> dependency_memo_;  ///< Per-file "some dependency changed" results
+    OutputMode output_mode_ = OutputMode::Files; ///< Where generated outputs live
+    SnippetArchive scan_archive_;                ///< Snippet archive kept mapped during a change scan
+    const FsSnapshot* snapshot_ = nullptr;       ///< Filesystem snapshot consulted before the disk
+    size_t jobs_ = 1;                            ///< Workers used by pruneOrphanedFiles
+
+    /**
+    @brief Check whether a generated output exists, on disk or in the snippet archive
+    @param output_file Generated output path
+    */
+    bool outputExists(const std::string& output_file);
+
+    static constexpr size_t kJournalCompactThreshold = 256;  ///< Journal records that trigger compaction
+
+    /**
+    @brief Store an entry in memory (caller holds mutex_)
+    */
+    void applyUpdate(const FileMetadata& metadata);
+
+    /**
+    @brief Drop an entry from memory (caller holds mutex_)
+    */
+    void applyRemove(const std::string& source_path);
+
+    /**
+    @brief Append one record to the journal and flush it (caller holds mutex_)
+    @param line Single-line JSON record
+    */
+    void appendJournal(const std::string& line);
+
+    /**
+    @brief Apply journal records written since the last snapshot
+    A torn final record is cut off, so the next append starts on a line of its own.
+    @return Number of records replayed
+    */
+    size_t replayJournal();
+
+    /**
+    @brief Close and delete the journal after a successful snapshot
+    */
+    void truncateJournal();
+
+    /**
+    @brief Load the last full snapshot (binary when configured, else JSON)
+    @return True if a snapshot was loaded
+    */
+    bool loadSnapshot();
+
+    /**
+    @brief Write the full snapshot in the configured format
+    @return True if the snapshot was written
+    */
+    bool writeSnapshot();
+
+    /**
+    @brief Check whether a cached file's own content changed since it was recorded
+
+    Refreshes the stored stat tuple when a file was touched without changing.
+
+    @param source_path Path to source file
+    @param metadata Cached entry for the file
+    @return True if the file is missing or its content hash differs
+    */
+    bool contentChanged(const std::string& source_path, FileMetadata& metadata);
+
+    /**
+    @brief Memoized depth-first walk over a file's recorded dependencies
+    A "no change" result is only memoized when the walk below a file did not
+    loop back to a file still on the DFS path, since such a result is incomplete.
+
+    @param source_path File whose dependencies are checked
+    @param on_path Files on the current DFS path, mapped to their depth
+    @param lowest Lowest on-path depth reached from this file (updated)
+    @return True if any transitive dependency changed
+    */
+    bool dependencyChanged(const std::string& source_path, std::unordered_map<std::string, size_t>& on_path, size_t& lowest);
+
+    /**
+    @brief Look up a file entry in the in-memory entries, then the mapped cache
+    @param source_path Path to source file
+    @return Copy of the entry, or nullopt if not cached
+    */
+    std::optional<FileMetadata> lookupFile(const std::string& source_path) const;
+
+    /**
+    @brief Visit every live entry (mapped entries not shadowed or removed, then in-memory ones)
+    @param visit Callback receiving each entry; string views are only valid during the call
+    */
+    void forEachRecord(const std::function<void(const BinaryCacheRecord&)>& visit) const;
+
+    /**
+    @brief True if a mapped entry has been replaced or removed in memory
+    */
+    bool isShadowed(std::string_view source_path) const;
+
+    /**
+    @brief Map the binary cache file
+    @return True if a valid binary cache was mapped
+    */
+    bool loadBinary();
+
+    /**
+    @brief Write all live entries to the binary cache file and remap it
+    @return True if the cache was saved
+    */
+    bool saveBinary();
 
     /**
     @brief Calculate content hash for a file
     @param file_path Path to file
-    @return SHA-256 hash string, or empty string on error
+    @return Streaming XXH64 digest ("xxh64:<hex>"), or empty string on error
     */
     std::string calculateFileHash(const std::string& file_path) const;
 
     /**
-    @brief Convert cache entry to JSON
-    @return JSON string representation
+    @brief Build the JSON snapshot of every entry
+    @return Mutable document ready to be written
     */
-    std::string cacheToJson() const;
+    JsonDoc cacheToJson() const;
 
     /**
-    @brief Load cache entry from JSON
-    @param json_str JSON string
+    @brief Replace the cache contents with a JSON snapshot
+    @param json_str JSON text, parsed in place (its contents are consumed)
     @return True if loaded successfully
     */
-    bool cacheFromJson(const std::string& json_str);
+    bool cacheFromJson(std::string& json_str);
 };
\ No newline at end of file
@@ -0,0 +1,137 @@
+/**
+@brief Versioned binary on-disk format for the documentation cache
+
+Layout (all integers little-endian):
+- Header: magic "CSMCACHE", format version, record count, path reference
+  count, section offsets and the cache version string reference.
+- Record table: one fixed-size record per source file, sorted by source path
+  so lookups are a binary search over the mapped file.
+- Path reference table: string references for generated files, their
+  content hashes and dependencies, one contiguous run of each per record.
+- String table: every distinct string stored once; records refer to strings
+  by (offset, length).
+*/
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <backend/core/mmap.h>
+#include <backend/doc/cache.h>
+
+/**
+@brief One file entry in binary cache terms
+
+String fields are views: into the mapping when read from a BinaryCacheView,
+or into a FileMetadata when written.
+*/
+struct BinaryCacheRecord {
+  std::string_view source_path;                  ///< Path to source file (sort key)
+  std::string_view content_hash;                 ///< Content hash
+  std::string_view last_modified;                ///< Last modification time as string
+  std::string_view language;                     ///< Language used for extraction
+  int64_t mtime_ticks = 0;                       ///< Raw last_write_time ticks
+  uint64_t file_size = 0;                        ///< File size in bytes
+  uint64_t inode = 0;                            ///< File inode/index
+  uint64_t construct_count = 0;                  ///< Number of constructs extracted
+  std::vector<std::string_view> generated_files; ///< Generated output files
+  std::vector<std::string_view> output_hashes;   ///< Content hash of each generated file
+  std::vector<std::string_view> dependencies;    ///< Files this entry depends on
+
+  /**
+  @brief View a FileMetadata as a record (metadata must outlive the record)
+  */
+  static BinaryCacheRecord fromMetadata(const FileMetadata& metadata);
+
+  /**
+  @brief Copy the record into an owning FileMetadata
+  */
+  FileMetadata toMetadata() const;
+};
+
+/**
+@brief Read-only view over a memory-mapped binary cache file
+
+Opening validates the header and section bounds only; records are decoded
+on demand, so point lookups never materialize the whole cache.
+*/
+class BinaryCacheView {
+  public:
+    static constexpr uint32_t kFormatVersion = 3;  ///< Current binary format version
+
+    /**
+    @brief Map and validate a binary cache file
+    @param path Path to binary cache file
+    @return True if the file is a valid cache of the current format version
+    */
+    bool open(const std::string& path);
+
+    /**
+    @brief Unmap the file; views returned earlier become invalid
+    */
+    void close();
+
+    bool isOpen() const { return file_.isOpen(); }  ///< True while a cache file is mapped
+    size_t size() const { return record_count_; }    ///< Number of file records
+
+    /**
+    @brief Cache version string stored in the header
+    */
+    std::string_view version() const;
+
+    /**
+    @brief Cache last update time (seconds since epoch)
+    */
+    int64_t lastUpdated() const { return last_updated_; }
+
+    /**
+    @brief Binary search for a source path
+    @param source_path Path to look up
+    @return Record index, or nullopt if not present
+    */
+    std::optional<size_t> indexOf(std::string_view source_path) const;
+
+    /**
+    @brief Source path of a record without decoding the rest of it
+    */
+    std::string_view sourcePathAt(size_t index) const;
+
+    /**
+    @brief Decode a record (string views point into the mapping)
+    */
+    BinaryCacheRecord recordAt(size_t index) const;
+
+  private:
+    MappedFile file_;                  ///< Mapped cache file
+    size_t record_count_ = 0;          ///< Number of file records
+    size_t generated_count_ = 0;       ///< Number of entries in the path reference table
+    size_t records_offset_ = 0;        ///< Offset of the record table
+    size_t generated_offset_ = 0;      ///< Offset of the path reference table
+    size_t strings_offset_ = 0;        ///< Offset of the string table
+    size_t strings_size_ = 0;          ///< Size of the string table in bytes
+    int64_t last_updated_ = 0;         ///< Cache last update time
+    uint64_t version_ref_ = 0;         ///< Packed reference to the version string
+
+    /**
+    @brief Resolve a packed (offset, length) string reference, empty if out of bounds
+    */
+    std::string_view stringAt(uint64_t ref) const;
+
+    /**
+    @brief Decode a run of the path reference table, empty if out of bounds
+    */
+    std::vector<std::string_view> pathsAt(size_t begin, size_t count) const;
+};
+
+/**
+@brief Write records as a binary cache file
+@param path Destination path (overwritten)
+@param version Cache version string
+@param last_updated Cache last update time (seconds since epoch)
+@param records File records in any order; sorted by source path on write
+@return True if the file was written completely
+*/
+bool writeBinaryCache(const std::string& path, const std::string& version, int64_t last_updated,
+                      std::vector<BinaryCacheRecord> records);
@@ -0,0 +1,128 @@
+/**
+@brief C interface of the embeddable documentation extractor (the cesium-doc shared library)
+
+Editors and build systems load cesium-doc once and keep an extractor open,
+so configuration, grammars, the parser pool and the cache stay resident and
+each request costs only the extraction itself instead of process startup.
+Only C types cross the boundary, so the library can be loaded with dlopen or
+LoadLibrary (dynlib::loadDynLib("cesium-doc") finds it by base name) and
+called from any language with a C FFI. The function pointer types below
+match the exported functions for use with dynlib::DynLib::getFunc.
+
+Constructs are returned as a JSON array in the format of "cesium doc export"
+(see constructToJson). An extractor handle must not be used by two threads at
+the same time; separate handles are independent.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+  #ifdef CESIUM_DOC_BUILD
+    #define CESIUM_DOC_API __declspec(dllexport)
+  #else
+    #define CESIUM_DOC_API __declspec(dllimport)
+  #endif
+#else
+  #define CESIUM_DOC_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+@brief Version of this interface; incremented only when a function's signature or meaning changes
+*/
+#define CESIUM_DOC_API_VERSION 1
+
+/**
+@brief Opaque extractor handle
+*/
+typedef struct cesium_doc cesium_doc;
+
+/**
+@brief Result of an extraction call
+*/
+typedef enum cesium_doc_status {
+  CESIUM_DOC_OK = 0,             ///< Extraction succeeded
+  CESIUM_DOC_INVALID_ARGUMENT,   ///< A required argument was null
+  CESIUM_DOC_NO_LANGUAGE,        ///< No configured language handles the path
+  CESIUM_DOC_SKIPPED,            ///< The content is too large, binary, generated or took too long to parse
+  CESIUM_DOC_FAILED              ///< Extraction failed (see cesium_doc_last_error)
+} cesium_doc_status;
+
+/**
+@brief Interface version the library was built with (compare against CESIUM_DOC_API_VERSION)
+*/
+CESIUM_DOC_API uint32_t cesium_doc_api_version(void);
+
+/**
+@brief Load a configuration file and create an extractor for it
+@param config_path Path to the configuration file
+@return New extractor, or null if the configuration cannot be loaded
+*/
+CESIUM_DOC_API cesium_doc* cesium_doc_open(const char* config_path);
+
+/**
+@brief Destroy an extractor (null is ignored)
+*/
+CESIUM_DOC_API void cesium_doc_close(cesium_doc* doc);
+
+/**
+@brief Extract constructs from in-memory content, such as an unsaved editor buffer
+
+The path picks the language and is recorded as the constructs' file; the file
+is not read and nothing is written. A configured shared cache may supply the
+result, but the buffer's own result is never added to it. With "incremental_parsing" enabled, the
+tree from the previous call for the same path is reused.
+
+@param doc Extractor
+@param path Path the content belongs to (UTF-8)
+@param content Source text (need not be NUL-terminated)
+@param length Bytes of content
+@param constructs_json Receives a NUL-terminated JSON array on CESIUM_DOC_OK (free with cesium_doc_free)
+@param json_length Receives the array's length in bytes (may be null)
+@return Status of the extraction
+*/
+CESIUM_DOC_API cesium_doc_status cesium_doc_extract_buffer(cesium_doc* doc, const char* path, const char* content,
+                                                           size_t length, char** constructs_json, size_t* json_length);
+
+/**
+@brief Re-extract changed files on disk and update their snippets and the cache, as "cesium doc watch" does
+@param doc Extractor
+@param paths Files reported as created, modified or removed (UTF-8)
+@param count Number of paths
+@return CESIUM_DOC_OK, or CESIUM_DOC_FAILED if extraction failed
+*/
+CESIUM_DOC_API cesium_doc_status cesium_doc_extract_files(cesium_doc* doc, const char* const* paths, size_t count);
+
+/**
+@brief Drop the tree retained for a path by cesium_doc_extract_buffer (e.g. when its buffer is closed)
+*/
+CESIUM_DOC_API void cesium_doc_forget(cesium_doc* doc, const char* path);
+
+/**
+@brief Free text returned by the library (null is ignored)
+*/
+CESIUM_DOC_API void cesium_doc_free(char* text);
+
+/**
+@brief Message describing the extractor's last failure
+@return NUL-terminated message (empty if the last call succeeded), valid until the next call on doc
+*/
+CESIUM_DOC_API const char* cesium_doc_last_error(const cesium_doc* doc);
+
+typedef uint32_t (*cesium_doc_api_version_fn)(void);
+typedef cesium_doc* (*cesium_doc_open_fn)(const char*);
+typedef void (*cesium_doc_close_fn)(cesium_doc*);
+typedef cesium_doc_status (*cesium_doc_extract_buffer_fn)(cesium_doc*, const char*, const char*, size_t, char**, size_t*);
+typedef cesium_doc_status (*cesium_doc_extract_files_fn)(cesium_doc*, const char* const*, size_t);
+typedef void (*cesium_doc_forget_fn)(cesium_doc*, const char*);
+typedef void (*cesium_doc_free_fn)(char*);
+typedef const char* (*cesium_doc_last_error_fn)(const cesium_doc*);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,7 @@
 #include <string>
 #include <memory>
 #include <optional>
+#include <vector>
 #include <backend/core/json.h>
 
 namespace CesiumDoc {
@@ -32,14 +33,28 @@ If config_path is empty, attempts to find default configuration file.
 */
 std::string validateAndResolveConfig(const std::string& config_path, bool config_specified);
 
+/**
+@brief A configuration file parsed once and shared by every stage of a run
+
+The document stays available for stage-specific keys; the directories every
+stage needs are read out once.
+*/
+struct Config {
+  std::string path;                             ///< File the configuration was loaded from (relative paths resolve against it)
+  JsonDoc json;                                 ///< Parsed document
+  std::string extract_directory;                ///< "extract_directory"
+  std::string output_directory;                 ///< "output_directory"
+  std::vector<std::string> source_directories;  ///< "source_directories"
+};
+
 /**
 @brief Load and validate configuration file
 
 Loads the JSON configuration file and performs basic validation.
 
 @param config_path Path to configuration file
-@return Loaded JsonDoc on success, std::nullopt on error
+@return Loaded configuration on success, std::nullopt on error
 */
-std::optional<JsonDoc> loadConfig(const std::string& config_path);
+std::optional<Config> loadConfig(const std::string& config_path);
 
 } // namespace CesiumDoc
\ No newline at end of file
@@ -0,0 +1,162 @@
+/**
+@brief Streaming JSON and NDJSON export of extracted code constructs, and their on-disk spill
+
+Downstream tools (site generators, search indexers) read constructs from
+this stream instead of re-parsing the generated markdown. Each construct is
+serialized as soon as it is written, so the exporter never holds more than
+the constructs of the files currently being extracted.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <backend/core/arena.h>
+#include <backend/doc/cpp/ast_extractor.h>
+
+/**
+@brief Layout of an exported construct stream
+*/
+enum class ConstructFormat {
+  Json,     ///< One JSON array holding every construct
+  Ndjson    ///< One JSON object per line (newline-delimited JSON)
+};
+
+/**
+@brief Parse a construct format name ("json" or "ndjson")
+@param name Format name
+@param format Receives the parsed format on success
+@return True if the name was recognized
+*/
+bool parseConstructFormat(const std::string& name, ConstructFormat& format);
+
+/**
+@brief Serialize one construct as a single-line JSON object
+
+Fields: type, name, full_name, namespace, access, file, start_line,
+end_line, return_type (null when absent), parameters (objects with type,
+name and default), is_static, is_const, is_virtual, base_classes,
+docstring (null when absent), source_locations, is_merged and
+merged_docstrings.
+
+@param construct Construct to serialize
+@return The JSON object, without a trailing newline
+*/
+std::string constructToJson(const CodeConstruct& construct);
+
+/**
+@brief Rebuild a construct from an object written by constructToJson
+@param text The JSON object
+@param strings Interner that stores the construct's view fields
+@return The construct (without an AST node), or nullopt if the text is not a construct object
+*/
+std::optional<CodeConstruct> constructFromJson(std::string_view text, StringInterner& strings);
+
+/**
+@brief Writes constructs to a stream one at a time
+
+In Json format the opening bracket is written with the first construct (or
+by finish() for an empty stream), so output can be consumed incrementally.
+*/
+class ConstructStreamWriter {
+  public:
+    /**
+    @brief Create a writer on an output stream
+    @param out Stream receiving the constructs (must outlive the writer)
+    @param format Layout of the stream
+    */
+    ConstructStreamWriter(std::ostream& out, ConstructFormat format);
+
+    /**
+    @brief Append one construct to the stream
+    @param construct Construct to write
+    */
+    void write(const CodeConstruct& construct);
+
+    /**
+    @brief Flush what has been written so far to the consumer
+    */
+    void flush();
+
+    /**
+    @brief Terminate the stream (closes the Json array) and flush it
+    @return True if every write succeeded
+    */
+    bool finish();
+
+    /**
+    @brief Number of constructs written so far
+    */
+    size_t count() const { return count_; }
+
+  private:
+    std::ostream& out_;          ///< Destination stream
+    ConstructFormat format_;     ///< Layout of the stream
+    std::string line_;           ///< Reused buffer for the construct being written
+    size_t count_ = 0;           ///< Constructs written so far
+    bool finished_ = false;      ///< True once finish() has run
+};
+
+/**
+@brief Constructs written to disk and looked up again by overload signature
+
+Bounded-memory extraction spills each construct it has written so a later
+file declaring or defining the same construct can be merged with it. Only the
+signatures (see overloadSignature) and file offsets stay in memory; replacing a construct appends a
+new record and the stale one is left in the file. The file is removed when
+the spill is destroyed.
+*/
+class ConstructSpill {
+  public:
+    /**
+    @brief Create an empty spill file (replacing any existing one)
+    @param path Location of the spill file
+    */
+    explicit ConstructSpill(std::string path);
+    ~ConstructSpill();
+
+    ConstructSpill(const ConstructSpill&) = delete;
+    ConstructSpill& operator=(const ConstructSpill&) = delete;
+
+    /**
+    @brief Whether the spill file could be created
+    */
+    bool isOpen() const { return file_.is_open(); }
+
+    /**
+    @brief Whether a construct with this overload signature has been stored
+    */
+    bool contains(const std::string& signature) const { return offsets_.count(signature) > 0; }
+
+    /**
+    @brief Store a construct under its overload signature, replacing any earlier one
+    @param construct Construct to store (constructs without a full name are ignored)
+    @return True if the record was written
+    */
+    bool store(const CodeConstruct& construct);
+
+    /**
+    @brief Read back the construct stored under an overload signature
+    @param signature Signature the construct was stored under
+    @param strings Interner that stores the construct's view fields
+    @return The construct, or nullopt if none is stored or it cannot be read
+    */
+    std::optional<CodeConstruct> load(const std::string& signature, StringInterner& strings);
+
+    /**
+    @brief Number of distinct signatures stored
+    */
+    size_t size() const { return offsets_.size(); }
+
+  private:
+    std::string path_;                                  ///< Location of the spill file
+    std::fstream file_;                                 ///< Spill file, read and appended
+    uint64_t end_ = 0;                                  ///< Offset where the next record is appended
+    std::unordered_map<std::string, uint64_t> offsets_; ///< Signature -> offset of its latest record
+    std::string line_;                                  ///< Reused record buffer
+};
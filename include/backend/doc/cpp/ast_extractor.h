@@ -3,10 +3,14 @@
 */
 #pragma once
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
+#include <backend/core/arena.h>
 #include <backend/doc/treesitter.h>
+#include <backend/doc/cpp/docstrings.h>
 
 /**
 @brief Types of code constructs that can be extracted from source code
@@ -27,22 +31,26 @@ enum class ConstructType {
 @brief Represents a function or method parameter
 */
 struct Parameter {
-  std::string type;                           ///< Parameter type
+  std::string_view type;                      ///< Parameter type (interned)
   std::string name;                           ///< Parameter name
   std::optional<std::string> default_value;  ///< Default value if present
 };
 
 /**
 @brief Complete representation of a code construct extracted from AST
+
+Filenames, namespace paths, return and parameter types repeat across most
+constructs, so they are views into the extractor's string interner rather
+than owned copies. A construct must not outlive that interner.
 */
 struct CodeConstruct {
   ConstructType type;                            ///< Type of construct (function, class, etc.)
   std::string name;                              ///< Simple name of the construct
   std::string full_name;                         ///< Full qualified name including namespace/class path
-  std::string namespace_path;                    ///< Namespace or class containing this construct
+  std::string_view namespace_path;               ///< Namespace or class containing this construct (interned)
 
   // Function/method specific fields
-  std::optional<std::string> return_type;       ///< Return type for functions/methods
+  std::optional<std::string_view> return_type;  ///< Return type for functions/methods (interned)
   std::vector<Parameter> parameters;            ///< Function/method parameters
   bool is_static = false;                       ///< Whether function/method is static
   bool is_const = false;                        ///< Whether method is const
@@ -52,11 +60,11 @@ struct CodeConstruct {
   std::vector<std::string> base_classes;        ///< Base classes for inheritance
 
   // Universal fields for all constructs
-  std::string access_modifier;                  ///< Access level: public, private, protected
+  std::string_view access_modifier;             ///< Access level: public, private, protected
   std::optional<std::string> docstring;         ///< Associated docstring if found nearby
   uint32_t start_line;                          ///< Starting line number in source
   uint32_t end_line;                            ///< Ending line number in source
-  std::string filename;                         ///< Source filename
+  std::string_view filename;                    ///< Source filename (interned)
   
   // Fields for handling declaration/implementation merging
   std::vector<std::string> source_locations;    ///< All locations where this construct appears
@@ -66,6 +74,44 @@ struct CodeConstruct {
   TSNode ast_node;                              ///< Raw Tree-sitter AST node for further processing
 };
 
+/**
+@brief Give undocumented constructs the closest docstring block above them
+
+Constructs and blocks are each ordered by line and merged in one pass, so the
+cost is dominated by the two sorts rather than constructs times blocks. A
+construct takes the nearest block that starts on an earlier line, provided
+that line is at most `window` lines above it; constructs that already have a
+docstring are left alone. A block may document more than one construct.
+
+@param constructs Constructs to update (order is preserved)
+@param blocks Docstring blocks from the same file, in any order
+@param window Maximum distance in lines between a block and its construct
+@return Number of constructs that were given a docstring
+*/
+size_t attachNearestDocstrings(std::vector<CodeConstruct>& constructs, const std::vector<DocstringBlock>& blocks,
+                               uint32_t window);
+
+/**
+@brief Text that tells same-named constructs apart: the full name, parameter types and constness
+
+A declaration and the definition of one function give the same text whatever
+spacing either uses in its types, while overloads give different text. It only
+depends on the construct itself, so it names the same overload in every run.
+
+@param construct Construct to describe
+@return For example "geo::Shape::scale(double,const Units&) const"
+*/
+std::string overloadSignature(const CodeConstruct& construct);
+
+/**
+@brief Whether a construct's page name carries a hash of its overload signature
+
+Functions, methods and constructors that take parameters or are const do,
+since any of them may be one of several overloads. The parameterless
+non-const form can exist only once per name and keeps the plain page name.
+*/
+bool hasOverloadPage(const CodeConstruct& construct);
+
 /**
 @brief Extracts code constructs from Tree-sitter AST nodes
 
@@ -88,18 +134,172 @@ class ASTExtractor {
     */
     std::string extractFunctionNameFromText(const std::string& declarator_text);
 
+    /**
+    @brief Enable or disable fused docstring collection
+
+    In fused mode doc comments are picked up from the Tree-sitter comment nodes
+    visited during the same traversal that extracts constructs, so no separate
+    buffer scan is needed to attach docstrings.
+
+    @param enabled True to collect docstrings during traversal
+    */
+    void setFusedDocstrings(bool enabled) { fused_docstrings_ = enabled; }
+
+    /**
+    @brief Set the docstring style used to recognize documentation comments
+    @param style Docstring style from the language configuration (e.g. "/// ")
+    */
+    void setDocstringStyle(const std::string& style) { docstring_style_ = style; }
+
+    /**
+    @brief Paths named by #include directives seen during the last extractConstructs call
+    @return Include paths as spelled, without the surrounding quotes or angle brackets
+    */
+    const std::vector<std::string>& includes() const { return includes_; }
+
+    /**
+    @brief Intern construct strings into a shared interner
+
+    Without one, the extractor keeps its own and constructs must not outlive
+    the extractor. The interner must outlive every construct extracted.
+
+    @param strings Interner to use (nullptr = extractor-owned)
+    */
+    void setStringInterner(StringInterner* strings) { strings_ = strings; }
+
+    /**
+    @brief Merge duplicate constructs from declaration and implementation
+
+    Constructs sharing an overload signature (see overloadSignature) are
+    folded into the first occurrence, which keeps its position; the rest are
+    removed, while overloads of one name stay separate. Constructs that were
+    already merged contribute all of their recorded locations and
+    docstrings, so the pass can be run per file and again across files.
+
+    @param constructs Vector of constructs to merge (modified in-place)
+    @param strings Interner used for the signature keys
+    @return Number of merge conflicts detected
+    */
+    static int mergeDuplicateConstructs(std::vector<CodeConstruct>& constructs, StringInterner& strings);
+
   private:
     /**
-    @brief Recursively extract constructs from an AST node
-    @param node Current AST node to process
+    @brief Documentation comment seen during traversal (a run of line comments counts as one)
+    */
+    struct PendingDocComment {
+      uint32_t start_byte = 0;   ///< Start of the comment (first line for line-comment runs)
+      uint32_t end_byte = 0;     ///< End of the comment (last line for line-comment runs)
+      uint32_t end_row = 0;      ///< Row the comment ends on (0-based)
+      bool active = false;       ///< Whether a comment is pending
+    };
+
+    static constexpr uint32_t kMaxDocstringGap = 100;  ///< Most bytes between a doc comment and its construct (index mode)
+
+    /**
+    @brief Grammar symbol IDs for the node types the extractor inspects
+
+    Resolved once per language so node types are compared as integers
+    instead of by name.
+    */
+    struct NodeSymbols {
+      const TSLanguage* language = nullptr;  ///< Language the IDs were resolved for
+      TSSymbol comment = 0;
+      TSSymbol preproc_include = 0;
+      TSSymbol function_definition = 0;
+      TSSymbol function_declarator = 0;
+      TSSymbol declaration = 0;
+      TSSymbol class_specifier = 0;
+      TSSymbol struct_specifier = 0;
+      TSSymbol enum_specifier = 0;
+      TSSymbol namespace_definition = 0;
+      TSSymbol qualified_identifier = 0;
+      TSSymbol identifier = 0;
+      TSSymbol type_identifier = 0;
+      TSSymbol primitive_type = 0;
+      TSSymbol template_type = 0;
+      TSSymbol destructor_name = 0;
+      TSSymbol parameter_list = 0;
+      TSSymbol parameter_declaration = 0;
+      TSSymbol optional_parameter_declaration = 0;
+      TSSymbol pointer_declarator = 0;
+      TSSymbol reference_declarator = 0;
+      TSSymbol type_qualifier = 0;
+    };
+
+    bool fused_docstrings_ = false;        ///< Collect docstrings from comment nodes during traversal
+    std::string docstring_style_ = "/** */";  ///< Style used to recognize doc comments
+    PendingDocComment pending_doc_;        ///< Most recent unattached doc comment (fused mode)
+    std::vector<PendingDocComment> doc_comments_;  ///< Doc comments seen so far, in source order (index mode)
+    std::vector<std::string> includes_;    ///< #include paths collected during traversal
+    NodeSymbols symbols_;                  ///< Node type IDs for the language being extracted
+    StringInterner* strings_ = nullptr;    ///< Shared interner for construct strings
+    std::unique_ptr<StringInterner> own_strings_; ///< Fallback interner when none is shared
+
+    /**
+    @brief Resolve node type IDs for a language unless they already are
+    @param language Language of the tree being extracted
+    */
+    void resolveSymbols(const TSLanguage* language);
+
+    /**
+    @brief Interner in use (the shared one, or the extractor's own)
+    */
+    StringInterner& activeStrings();
+
+    /**
+    @brief Store a string in the active interner
+    @return View valid for the interner's lifetime
+    */
+    std::string_view intern(std::string_view text) { return activeStrings().intern(text); }
+
+    /**
+    @brief Record a comment node as the pending docstring if it matches the docstring style
+    @param node Comment node
+    @param content Original source code content
+    */
+    void collectDocComment(TSNode node, const std::string& content);
+
+    /**
+    @brief Attach the pending doc comment to a construct node if nothing separates them
+    @param node Construct AST node
+    @param content Original source code content
+    @return Docstring text if the pending comment documents this node
+    */
+    std::optional<std::string> takePendingDocstring(TSNode node, const std::string& content);
+
+    /**
+    @brief Find the docstring for a construct node using the active strategy
+    @param node Construct AST node
+    @param content Original source code content
+    @return Docstring text if one documents this node
+    */
+    std::optional<std::string> docstringFor(TSNode node, const std::string& content);
+
+    /**
+    @brief Extract constructs from every node of a subtree
+    @param root Subtree root to walk
     @param content Original source code content
     @param filename Name of the source file
-    @param namespace_path Current namespace path
+    @param namespace_path Namespace path of root
     @param constructs Output vector to append constructs to
     */
-    void extractFromNode(TSNode node, const std::string& content, const std::string& filename,
+    void extractFromNode(TSNode root, const std::string& content, const std::string& filename,
                         const std::string& namespace_path, std::vector<CodeConstruct>& constructs);
 
+    /**
+    @brief Extract the construct a single node represents, if any
+    @param node Node being visited
+    @param content Original source code content
+    @param filename Name of the source file
+    @param namespace_path Namespace path of node
+    @param constructs Output vector to append constructs to
+    @param scope_name Set to the name the node adds to its children's namespace path
+    @return True if the walk should descend into the node's children
+    */
+    bool visitNode(TSNode node, const std::string& content, const std::string& filename,
+                   const std::string& namespace_path, std::vector<CodeConstruct>& constructs,
+                   std::string_view& scope_name);
+
     /**
     @brief Extract function construct from AST node
     */
@@ -141,19 +341,28 @@ class ASTExtractor {
     std::string extractReturnType(TSNode function_node, const std::string& content);
 
     /**
-    @brief Extract parameter list from function AST node
+    @brief Find the function_declarator of a function definition, or the node itself for a declaration
+
+    The declarator of a function returning a pointer or reference is found
+    inside the pointer and reference declarators that wrap it.
+    */
+    TSNode functionDeclarator(TSNode function_node);
+
+    /**
+    @brief Extract parameter list from function AST node (a definition or a function_declarator)
     */
     std::vector<Parameter> extractParameters(TSNode function_node, const std::string& content);
 
     /**
-    @brief Extract type name from type AST node
+    @brief Whether a function AST node declares a const member function
     */
-    std::string extractTypeName(TSNode type_node, const std::string& content);
+    bool isConstQualified(TSNode function_node, const std::string& content);
 
     /**
     @brief Get text content of an AST node
+    @return View into content (no copy), valid while content is
     */
-    std::string getNodeText(TSNode node, const std::string& content);
+    std::string_view getNodeText(TSNode node, const std::string& content);
 
     /**
     @brief Recursively search for method name in function declarator
@@ -161,12 +370,12 @@ class ASTExtractor {
     std::string findMethodName(TSNode node, const std::string& content);
     
     /**
-    @brief Escape invalid filename characters with % prefix
-    */
-    std::string escapeSymbolsForFilename(const std::string& name);
+    @brief Find the doc comment just above an AST node
+
+    Binary-searches the comments collected so far (sorted by end byte) for the
+    last one ending before the node. It is used only if it ends within
+    kMaxDocstringGap bytes of the node and no statement boundary lies between.
 
-    /**
-    @brief Find docstring near an AST node (above or below)
     @param node AST node to search near
     @param content Original source code content
     @return Optional docstring if found within proximity threshold
@@ -175,23 +384,18 @@ class ASTExtractor {
 
     /**
     @brief Find first child node with specified type
+    @param symbol Node type ID (from symbols_)
     */
-    TSNode findChildByType(TSNode parent, const std::string& type);
+    TSNode findChildByType(TSNode parent, TSSymbol symbol);
 
     /**
     @brief Find all child nodes with specified type
+    @param symbol Node type ID (from symbols_)
     */
-    std::vector<TSNode> findChildrenByType(TSNode parent, const std::string& type);
+    std::vector<TSNode> findChildrenByType(TSNode parent, TSSymbol symbol);
 
     // Docstring merging functionality
     
-    /**
-    @brief Merge duplicate constructs from declaration and implementation
-    @param constructs Vector of constructs to merge (modified in-place)
-    @return Number of merge conflicts detected
-    */
-    int mergeDuplicateConstructs(std::vector<CodeConstruct>& constructs);
-    
     /**
     @brief Merge two constructs representing the same function/method
     @param declaration_construct Declaration construct (usually from header)
@@ -206,5 +410,5 @@ class ASTExtractor {
     @param construct2 Second construct  
     @return Vector of conflict descriptions
     */
-    std::vector<std::string> detectDocstringConflicts(const CodeConstruct& construct1, const CodeConstruct& construct2);
+    static std::vector<std::string> detectDocstringConflicts(const CodeConstruct& construct1, const CodeConstruct& construct2);
 };
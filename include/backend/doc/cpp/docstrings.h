@@ -6,9 +6,11 @@ Supports multiple documentation formats including Javadoc, Doxygen, and similar
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <backend/doc/treesitter.h>
+#include <backend/doc/line_index.h>
 
 /**
 @brief Parsed documentation string block
@@ -36,6 +38,14 @@ struct DocstringBlock {
   std::string override_enum;                   ///< Override for enum name (from @enum tag)
 };
 
+/**
+@brief Comment scanning strategy used by DocstringParser
+*/
+enum class DocstringScanner {
+  Linear,   ///< Hand-written single-pass scanner (default)
+  Regex     ///< Legacy std::regex implementation, kept as a fallback
+};
+
 /**
 @brief Parser for extracting documentation strings from source code
 
@@ -53,21 +63,43 @@ class DocstringParser {
     */
     std::vector<DocstringBlock> extractDocstrings(const std::string& content, const std::string& style);
 
+    /**
+    @brief Select the comment scanning strategy
+    @param scanner Linear (default) or the legacy Regex fallback
+    */
+    void setScanner(DocstringScanner scanner) { scanner_ = scanner; }
+
+    /**
+    @brief Parse a scanner name from configuration ("linear" or "regex")
+    @param name Scanner name
+    @param scanner Receives the parsed scanner on success
+    @return True if the name was recognized
+    */
+    static bool parseScannerName(const std::string& name, DocstringScanner& scanner);
+
   private:
+    DocstringScanner scanner_ = DocstringScanner::Linear;  ///< Active scanning strategy
+
     /**
     @brief Extract block-style comments
     */
-    std::vector<DocstringBlock> extractBlockComments(const std::string& content);
+    std::vector<DocstringBlock> extractBlockComments(const std::string& content, const LineIndex& lines);
+
+    /**
+    @brief Extract block-style comments with std::regex (fallback scanner)
+    */
+    std::vector<DocstringBlock> extractBlockCommentsRegex(const std::string& content, const LineIndex& lines);
     
     /**
     @brief Extract simple block comments without full docstring parsing
     */
-    std::vector<DocstringBlock> extractBlockCommentsSimple(const std::string& content);
+    std::vector<DocstringBlock> extractBlockCommentsSimple(const std::string& content, const LineIndex& lines);
     
     /**
     @brief Extract line comments with specified prefix (e.g., "///")
     */
-    std::vector<DocstringBlock> extractLineComments(const std::string& content, const std::string& prefix);
+    std::vector<DocstringBlock> extractLineComments(const std::string& content, const std::string& prefix,
+                                                    const LineIndex& lines);
     
     /**
     @brief Parse docstring tags and structure from raw comment content
@@ -75,6 +107,18 @@ class DocstringParser {
     Supports both Javadoc (@param, @return) and Doxygen (\param, \return) syntax.
     */
     DocstringBlock parseDocstringContent(const std::string& raw);
+
+    /**
+    @brief Parse docstring tags with one std::regex per tag kind (fallback scanner)
+    */
+    DocstringBlock parseDocstringContentRegex(const std::string& raw);
+
+    /**
+    @brief Scan comment body lines for description text and @tag / \tag entries in one pass
+    @param body Comment text with the opening and closing markers removed
+    @param block Block receiving the parsed description and tags
+    */
+    void scanDocstringBody(std::string_view body, DocstringBlock& block);
     
     /**
     @brief Clean up comment syntax from raw content
@@ -85,9 +129,5 @@ class DocstringParser {
     @brief Trim whitespace from string
     */
     std::string trim(const std::string& str);
-    
-    /**
-    @brief Convert byte offset to line/column location
-    */
-    SourceLocation getSourceLocation(const std::string& content, size_t byte_offset);
+
 };
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <backend/doc/cpp/docstrings.h>
 
@@ -12,6 +13,9 @@
 
 Analyzes parsed documentation comments (Javadoc/Doxygen) and connects them
 to the appropriate code constructs in the Tree-sitter AST by proximity and context analysis.
+Each comment is paired with the nearest declaration starting after it. The
+declaration query is compiled once per language and kept, so an associator
+should be owned by one thread, like the other per-worker extractors.
 */
 class DocAssociator {
 public:
@@ -25,10 +29,18 @@ public:
                               TSTree* tree, const std::string& content);
 
 private:
+  std::unordered_map<const TSLanguage*, TSQueryPtr> declaration_queries_;  ///< Compiled declaration query per language
+
+  /**
+  @brief Get the declaration query for a language, compiling it on first use
+  @return Query, or nullptr if the language has none of the declaration node types
+  */
+  const TSQuery* declarationQuery(const TSLanguage* language);
+
   /**
-  @brief Find AST declaration node following a documentation comment
+  @brief Collect every declaration node in the tree, ordered by start byte
   */
-  TSNode findFollowingDeclaration(TSTree* tree, TSNode root, SourceLocation docstring_loc);
+  std::vector<TSNode> collectDeclarations(TSTree* tree, TSNode root);
   
   /**
   @brief Extract namespace/class path from AST node
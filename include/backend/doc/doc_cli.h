@@ -49,6 +49,17 @@ class CesiumDocCLI {
     */
     int generateDocs(int argc, char* argv[]);
 
+    /**
+    @brief Keep the extractor resident and re-extract files as they change
+    @return Exit code
+    */
+    int watchDocs(int argc, char* argv[]);
+
+    /**
+    @brief Print help message for watch command
+    */
+    void printWatchUsage();
+
     /**
     @brief List available Tree-sitter parsers
     @return Exit code
@@ -79,4 +90,30 @@ class CesiumDocCLI {
     Displays usage information, options, and examples for the prune command.
     */
     void printPruneUsage();
+
+    /**
+    @brief Export the extraction cache as JSON
+    @param argc Command line argument count
+    @param argv Command line argument vector
+    @return Exit code (0 for success, non-zero for error)
+    */
+    int exportCache(int argc, char* argv[]);
+
+    /**
+    @brief Print help message for export-cache command
+    */
+    void printExportCacheUsage();
+
+    /**
+    @brief Look symbols up in the index saved by the generate command
+    @param argc Command line argument count
+    @param argv Command line argument vector
+    @return Exit code (0 if anything matched, non-zero otherwise)
+    */
+    int lookupSymbols(int argc, char* argv[]);
+
+    /**
+    @brief Print help message for lookup command
+    */
+    void printLookupUsage();
 };
@@ -6,12 +6,54 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 #include <backend/doc/treesitter.h>
 #include <backend/doc/cpp/docstrings.h>
 #include <backend/doc/cpp/ts_ast_parser.h>
 #include <backend/doc/cpp/ast_extractor.h>
+#include <backend/doc/query_extractor.h>
+#include <backend/doc/source_reader.h>
+#include <backend/core/glob.h>
+#include <backend/core/fs_scan.h>
 #include <backend/doc/markdowngen.h>
 #include <backend/doc/cache.h>
+#include <backend/doc/config.h>
+#include <backend/doc/construct_stream.h>
+#include <backend/doc/shared_cache.h>
+
+/**
+@brief Per-worker extraction state
+
+Every extraction worker owns its own docstring parser and construct extractors.
+Tree-sitter parsers are leased per file from the DynamicLanguageLoader pool,
+so a parser is never used by two workers at the same time.
+*/
+struct ExtractionWorker {
+  DocstringParser docstring_parser;      ///< Worker-owned docstring parser
+  ASTExtractor ast_extractor;            ///< Worker-owned AST extractor
+  QueryExtractor query_extractor;        ///< Worker-owned extractor for languages with a construct query
+  SourceReader source_reader;            ///< Worker-owned reusable file buffer
+};
+
+/**
+@brief A source file queued for construct extraction
+*/
+struct ExtractionTask {
+  std::string filepath;                  ///< Path to the source file
+  std::string language;                  ///< Name of the language the file matched
+  const LanguageInfo* lang_info;         ///< Loaded language used to parse the file
+  uint64_t size = 0;                     ///< Size from the directory scan (larger files are started first)
+};
+
+/**
+@brief Constructs and include edges extracted from one source file
+*/
+struct ExtractionResult {
+  std::vector<CodeConstruct> constructs; ///< Constructs found in the file
+  std::vector<std::string> includes;     ///< #include paths as spelled in the file
+  SourceStatus status = SourceStatus::Loaded;  ///< Whether the file was read or skipped
+};
 
 /**
 @brief Main orchestrator for documentation generation from source code
@@ -21,12 +63,30 @@ and markdown generation to produce comprehensive documentation.
 */
 class CesiumDocExtractor {
   private:
+    const CesiumDoc::Config* config_ = nullptr;       ///< Configuration shared by every stage (set by initialize)
+    std::optional<CesiumDoc::Config> owned_config_;   ///< Configuration loaded by initialize(config_path)
     DynamicLanguageLoader loader_;         ///< Handles dynamic loading of Tree-sitter language parsers
     DocstringParser docstring_parser_;     ///< Parses documentation strings (Javadoc/Doxygen)
     DocAssociator doc_associator_;         ///< Associates docstrings with code constructs
-    ASTExtractor ast_extractor_;           ///< Extracts code constructs from AST
     MarkdownGenerator markdown_generator_; ///< Generates markdown documentation
     std::unique_ptr<DocumentationCache> cache_; ///< Metadata cache for tracking file changes
+    size_t parallelism_ = 0;               ///< Number of extraction workers (0 = hardware concurrency)
+    bool parallelism_overridden_ = false;  ///< True when parallelism was set explicitly (e.g. --jobs)
+    bool incremental_parsing_ = false;     ///< Reuse retained trees when reparsing changed files
+    bool fused_extraction_ = true;         ///< Attach docstrings during the AST walk (no separate comment scan)
+    bool query_extraction_ = false;        ///< Extract from each language's construct query when it has one
+    bool streaming_extraction_ = false;    ///< Write snippets a few files at a time instead of after the whole walk
+    uint64_t parse_timeout_ms_ = 0;        ///< Longest a single file may take to parse (0 = no limit)
+    bool search_index_ = false;            ///< Keep search documents while extracting and write shards on generate
+    uint32_t search_shards_ = SearchIndex::kDefaultShards;  ///< Number of search shards written
+    std::unique_ptr<SharedExtractionCache> shared_cache_;  ///< Results shared between machines ("shared_cache")
+    SourceLimits source_limits_;           ///< Size limit and skip rules for reading source files
+    GlobMatcher exclude_patterns_;         ///< Paths skipped while walking source directories
+    DocstringScanner docstring_scanner_ = DocstringScanner::Linear;  ///< Comment scanner used outside fused mode
+    OutputMode output_mode_ = OutputMode::Files;  ///< Snippets as separate files or one archive
+    IncrementalParseCache parse_cache_;    ///< Trees retained for incremental reparsing
+    StringInterner strings_;               ///< Per-run storage for filenames, namespaces and types in constructs
+    ExtractionWorker buffer_worker_;       ///< Worker used by extractBuffer
 
     /**
     @brief Extracts docstring blocks from a source file
@@ -41,11 +101,55 @@ class CesiumDocExtractor {
     @brief Extracts all code constructs from a source file using AST analysis
     @param filepath Path to the source file to parse
     @param lang_info Language information for Tree-sitter parsing
-    @return Vector of all discovered code constructs
+    @param worker Worker state providing the parser and extractors to use
+    @return All discovered code constructs and the file's #include paths
+    */
+    ExtractionResult extractAllConstructs(const std::string& filepath,
+                                          const LanguageInfo& lang_info,
+                                          ExtractionWorker& worker);
+
+    /**
+    @brief Extracts all code constructs from content already in memory
+    @param filepath Path recorded in the constructs (and the key of retained trees)
+    @param content Source text
+    @param lang_info Language information for Tree-sitter parsing
+    @param worker Worker state providing the parser and extractors to use
+    @param store_shared False to only read the shared cache, never add the result to it
+    @return All discovered code constructs and the file's #include paths
+    */
+    ExtractionResult extractContent(const std::string& filepath, const std::string& content,
+                                    const LanguageInfo& lang_info, ExtractionWorker& worker,
+                                    bool store_shared);
+
+    /**
+    @brief Everything besides a file's path and content that its extraction result depends on
+    @param lang_info Language the file is extracted as
+    @return Part of the file's shared cache key
     */
-    std::vector<CodeConstruct> extractAllConstructs(const std::string& filepath,
-                                                   const LanguageInfo& lang_info);
+    std::string extractionSettings(const LanguageInfo& lang_info) const;
+
+    /**
+    @brief Extracts constructs from all queued files using a pool of workers
+
+    Files are started largest first and handed to whichever worker is free, so
+    a huge file does not start last and hold up the run after the rest finished.
+
+    @param tasks Files to extract, in the order their results should be merged
+    @return Per-task results, index-aligned with tasks
+    */
+    std::vector<ExtractionResult> runExtractionTasks(const std::vector<ExtractionTask>& tasks);
     
+    /**
+    @brief Extracts the queued files, writes their snippets and records them in the cache
+    @param tasks Files to extract, in the order their results should be merged
+    @param include_roots Directories #include paths are resolved against
+    @param extract_dir Directory receiving the markdown snippets
+    @return True if extraction succeeded
+    */
+    bool extractTasks(const std::vector<ExtractionTask>& tasks,
+                      const std::vector<std::string>& include_roots,
+                      const std::string& extract_dir);
+
     /**
     @brief Checks if source file is newer than its corresponding markdown snippet
     @param source_path Path to source file
@@ -58,12 +162,39 @@ class CesiumDocExtractor {
     @brief Processes markdown snippets into structured documentation
     @param extract_dir Directory containing markdown snippets
     @param output_dir Directory for structured documentation output
+    @param rendered Snippets rendered earlier in this run, used instead of reading them back (optional)
+    */
+    void processMarkdownSnippets(const std::string& extract_dir, const std::string& output_dir,
+                                 const std::unordered_map<std::string, std::string>* rendered = nullptr);
+
+    /**
+    @brief Writes the search index of every page recorded in the cache to "<output_dir>/search"
+    @param extract_dir Directory holding the search document table
+    @param output_dir Directory for structured documentation output
     */
-    void processMarkdownSnippets(const std::string& extract_dir, const std::string& output_dir);
+    void writeSearchIndex(const std::string& extract_dir, const std::string& output_dir);
 
   public:
+    /**
+    @brief Sets the number of extraction workers, overriding the "parallelism" config key
+    @param jobs Number of workers (0 = hardware concurrency)
+    */
+    void setParallelism(size_t jobs);
+
+    /**
+    @brief Patterns from the "exclude_patterns" config key (valid after initialize)
+    */
+    const GlobMatcher& excludePatterns() const { return exclude_patterns_; }
+
     /**
     @brief Initializes the documentation extractor with configuration
+    @param config Loaded configuration, used by every later call (must outlive the extractor)
+    @return True if initialization succeeded, false otherwise
+    */
+    bool initialize(const CesiumDoc::Config& config);
+
+    /**
+    @brief Loads the configuration file and initializes the extractor with it
     @param config_path Path to the configuration file
     @return True if initialization succeeded, false otherwise
     */
@@ -71,21 +202,80 @@ class CesiumDocExtractor {
     
     /**
     @brief Extracts docstrings and creates markdown snippets
-    @param config_path Path to the configuration file
     @param source_override Optional source directory/file override
     @param extract_dir_override Optional extract directory override
-    @return True if extraction succeeded, false otherwise
+    @return True if extraction succeeded, false otherwise (or if not initialized)
     */
-    bool extract(const std::string& config_path, 
-                 const std::string& source_override = "",
+    bool extract(const std::string& source_override = "",
                  const std::string& extract_dir_override = "");
     
     /**
-    @brief Generates structured documentation from extracted snippets
-    @param config_path Path to the configuration file
+    @brief Re-extracts only the given files and the cached files depending on them
+    Deleted paths prune their outputs; excluded files and files without a parser are ignored.
+    The extractor must have been initialized; keeping it alive between calls keeps the
+    loaded languages, parser pool, retained trees and cache resident.
+
+    @param changed Files reported as created, modified or removed
+    @param extract_dir_override Optional extract directory override
+    @return True if extraction succeeded, false otherwise
+    */
+    bool extractChanged(const std::vector<std::string>& changed,
+                        const std::string& extract_dir_override = "");
+
+    /**
+    @brief Extracts every source file and streams its constructs to a writer
+
+    Files are extracted in batches of a few per worker and written in
+    discovery order as each batch finishes, so only the constructs of the
+    current batch are held in memory. The cache and extract directory are
+    neither read nor written, and declarations are merged with definitions
+    from the same file only (there is no cross-file merge).
+
+    @param source_override Optional source directory/file override
+    @param writer Destination of the constructs (finish() is left to the caller)
+    @return True unless the extractor was not initialized or the source override is unreadable
+    */
+    bool exportConstructs(const std::string& source_override, ConstructStreamWriter& writer);
+
+    /**
+    @brief Extracts constructs from content that need not be saved, such as an editor buffer
+
+    The path picks the language and is recorded as the constructs' file; the
+    file itself is never read, and neither the cache nor the extract directory
+    is touched. A shared cache ("shared_cache") may supply the result, but the
+    buffer's own result is never stored in it. The size and skip rules apply to the content as they would to
+    the file. With incremental parsing enabled, the tree from the previous call
+    for the same path is reused. Calls must not overlap.
+
+    @param path Path the content belongs to
+    @param content Source text
+    @return Constructs and includes, or nullopt if uninitialized or no language handles the path;
+            the constructs' strings stay valid until the next call
+    */
+    std::optional<ExtractionResult> extractBuffer(const std::string& path, const std::string& content);
+
+    /**
+    @brief Drops the tree retained for a path by extractBuffer (e.g. when the editor closes it)
+    @param path Path passed to extractBuffer
+    */
+    void forgetBuffer(const std::string& path) { parse_cache_.forget(path); }
+
+    /**
+    @brief Rebuilds structured documentation from the snippets already in the extract directory
+    @param extract_dir_override Optional extract directory override
+    @return True unless the extractor was not initialized
+    */
+    bool generateFromSnippets(const std::string& extract_dir_override = "");
+
+    /**
+    @brief Extracts changed files, then generates structured documentation from the snippets
+
+    Snippets written by the extract step are handed to the generation stage in
+    memory; only unchanged snippets whose pages need relinking are read from disk.
+
     @return True if generation succeeded, false otherwise
     */
-    bool generate(const std::string& config_path);
+    bool generate();
     
     /**
     @brief Legacy method - extracts and generates documentation (calls extract then generate)
@@ -0,0 +1,27 @@
+/**
+@brief Tree-sitter grammars linked into the binary
+*/
+#pragma once
+
+#include <string_view>
+#include "tree_sitter/api.h"
+
+/**
+@brief A grammar compiled into this binary, found by its entry point name
+*/
+struct BuiltinGrammar {
+  const char* function_name;              ///< Entry point name as used in the "function" config key
+  const TSLanguage* (*language)();        ///< Entry point
+};
+
+/**
+@brief Look up a built-in grammar
+
+Which grammars are built in is decided at build time (CESIUM_BUILTIN_TREE_SITTER_*
+definitions set by the build for the grammars it compiles). A language whose
+"function" matches one of them is used without loading its "library".
+
+@param function_name Tree-sitter entry point name (e.g. "tree_sitter_cpp")
+@return The grammar's language, or nullptr if it is not built in
+*/
+const TSLanguage* findBuiltinGrammar(std::string_view function_name);
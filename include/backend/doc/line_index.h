@@ -0,0 +1,64 @@
+/**
+@brief Byte offset to line/column mapping for source files
+*/
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <backend/doc/treesitter.h>
+
+/**
+@brief Precomputed line-start table for one source file
+
+Built once per file in a single newline scan, after which any byte offset is
+mapped to a SourceLocation with a binary search. This is the one place that
+turns byte offsets into line/column pairs, so comment scanners and
+tree-sitter edits agree on numbering: lines are 1-based and columns are
+0-based byte counts, matching SourceLocation and TSPoint.
+*/
+class LineIndex {
+  public:
+    LineIndex() = default;
+
+    /**
+    @brief Build the index for content
+    @param content Source text; only line offsets are retained, not the text itself
+    */
+    explicit LineIndex(std::string_view content);
+
+    /**
+    @brief Rebuild the index for new content
+    @param content Source text
+    */
+    void build(std::string_view content);
+
+    /**
+    @brief Map a byte offset to its source location
+    @param byte_offset Byte offset from start of file (clamped to the content size for line/column)
+    @return Location with 1-based line and 0-based column
+    */
+    SourceLocation locate(size_t byte_offset) const;
+
+    /**
+    @brief Map a byte offset to a tree-sitter point (0-based row and column)
+    @param byte_offset Byte offset from start of file
+    @return Point suitable for TSInputEdit
+    */
+    TSPoint pointAt(size_t byte_offset) const;
+
+    /**
+    @brief Number of lines in the indexed content (at least 1)
+    */
+    size_t lineCount() const { return line_starts_.empty() ? 1 : line_starts_.size(); }
+
+    /**
+    @brief Byte offset at which a line starts
+    @param line 1-based line number
+    @return Offset of the first byte of the line, or the content size if out of range
+    */
+    size_t lineStart(size_t line) const;
+
+  private:
+    std::vector<size_t> line_starts_;  ///< Byte offset of the first byte of each line
+    size_t content_size_ = 0;          ///< Size of the indexed content in bytes
+};
@@ -3,11 +3,21 @@
 */
 #pragma once
 
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
+#include <backend/core/output_writer.h>
+#include <backend/doc/search_index.h>
+#include <backend/doc/snippet_archive.h>
 #include <backend/doc/cpp/docstrings.h>
 #include <backend/doc/cpp/ast_extractor.h>
 
+/**
+@brief Generated output paths keyed by the source file that contributed to them
+*/
+typedef std::map<std::string, std::vector<std::string>> GeneratedFileMap;
+
 /**
 @brief Generates markdown documentation files from docstring blocks and code constructs
 
@@ -28,12 +38,85 @@ class MarkdownGenerator {
     @brief Generate markdown files from AST-extracted code constructs
     @param constructs Vector of code constructs from AST analysis
     @param output_dir Directory to write markdown files to
-    @return Vector of generated file paths
+    @return Generated file paths for each contributing source file
+
+    A construct merged from several files (see source_locations) attributes its
+    output to every one of them, as does an output written by same-named
+    constructs from different files.
+    */
+    GeneratedFileMap generateMarkdownFromConstructs(const std::vector<CodeConstruct>& constructs,
+                                                    const std::string& output_dir);
+
+    /**
+    @brief Provide the output hashes recorded by a previous run
+
+    Pages are rendered in memory first and only written when their hash differs
+    from the recorded one. Outputs without a recorded hash are compared against
+    the file already on disk instead.
+
+    @param hashes Output path -> content hash ("xxh64:<hex>")
     */
-    std::vector<std::string> generateMarkdownFromConstructs(const std::vector<CodeConstruct>& constructs,
-                                                           const std::string& output_dir);
+    void setRecordedOutputHashes(std::unordered_map<std::string, std::string> hashes) { recorded_hashes_ = std::move(hashes); }
+
+    /**
+    @brief Content hashes of every page produced by the last generateMarkdownFromConstructs call
+    */
+    const std::unordered_map<std::string, std::string>& outputHashes() const { return output_hashes_; }
+
+    /**
+    @brief Keep a copy of every page written, for a generation stage in the same run
+    @param retain True to fill renderedPages() (files mode only; archived pages are read from the archive)
+    */
+    void setRetainPages(bool retain) { retain_pages_ = retain; }
+
+    /**
+    @brief Pages written by the last generateMarkdownFromConstructs call, keyed by file name
+    */
+    const std::unordered_map<std::string, std::string>& renderedPages() const { return rendered_pages_; }
+
+    /**
+    @brief Set the number of threads used to write each batch of pages
+    @param jobs Number of writer threads (0 = hardware concurrency)
+    */
+    void setWriteJobs(size_t jobs) { write_jobs_ = jobs; }
+
+    /**
+    @brief Choose between one file per page and a single snippet archive
+
+    In archive mode pages keep their "<output_dir>/<name>.md" paths in the
+    returned map and hashes, but are stored in snippetArchivePath(output_dir).
+
+    @param mode Files (default) or Archive
+    */
+    void setOutputMode(OutputMode mode) { output_mode_ = mode; }
+
+    /**
+    @brief Add the document of every page rendered from now on to a search index
+    @param index Index to update (null to stop); must outlive the calls it is set for
+    */
+    void setSearchIndex(SearchIndex* index) { search_index_ = index; }
+
+    size_t writtenCount() const { return written_count_; }      ///< Pages written by the last generation
+    size_t unchangedCount() const { return unchanged_count_; }  ///< Pages left untouched by the last generation
+    size_t failedCount() const { return failed_count_; }        ///< Pages that could not be written
+    size_t bytesWritten() const { return bytes_written_; }      ///< Bytes written by the last generation
 
   private:
+    std::unordered_map<std::string, std::string> recorded_hashes_;  ///< Hashes recorded by the previous run
+    std::unordered_map<std::string, std::string> output_hashes_;    ///< Hashes of pages from the last generation
+    size_t written_count_ = 0;                                      ///< Pages written by the last generation
+    size_t unchanged_count_ = 0;                                    ///< Pages skipped as unchanged
+    size_t failed_count_ = 0;                                       ///< Pages whose write failed
+    size_t bytes_written_ = 0;                                      ///< Bytes written by the last generation
+    size_t write_jobs_ = 1;                                         ///< Writer threads per batch
+    OutputWriter writer_;                                           ///< Batched page writer
+    OutputMode output_mode_ = OutputMode::Files;                    ///< Page storage
+    SnippetArchive archive_;                                        ///< Archive being updated (archive mode)
+    std::map<std::string, std::string> archive_pages_;              ///< Changed pages by name (archive mode)
+    bool retain_pages_ = false;                                     ///< Keep written pages in rendered_pages_
+    std::unordered_map<std::string, std::string> rendered_pages_;   ///< Written pages by name (when retained)
+    SearchIndex* search_index_ = nullptr;                           ///< Index receiving rendered pages, if any
+
     // Traditional docstring-based generation methods
     
     /**
@@ -49,15 +132,30 @@ class MarkdownGenerator {
     // Modern AST-based generation methods
     
     /**
-    @brief Generate filename for a code construct
+    @brief Generate the page file name of a code construct (see encodePageName)
+    @param construct Construct the page documents
+    @param out Receives the file name
     */
-    std::string generateConstructFilename(const CodeConstruct& construct);
+    void generateConstructFilename(const CodeConstruct& construct, std::string& out);
     
     /**
-    @brief Generate markdown file for a code construct
+    @brief Render the markdown page for a code construct
+    @param construct Construct to render
+    @param out Buffer the page is appended to
     */
-    void generateConstructMarkdownFile(const CodeConstruct& construct, const std::string& filepath);
+    void renderConstructMarkdown(const CodeConstruct& construct, std::string& out);
+
+    /**
+    @brief Render a construct page and queue it for writing unless the output already holds that content
+    @return Content hash of the page
+    */
+    std::string generateConstructMarkdownFile(const CodeConstruct& construct, const std::string& filepath);
     
+    /**
+    @brief Collect the source files a construct was extracted or merged from
+    */
+    std::vector<std::string> constructSourceFiles(const CodeConstruct& construct);
+
     /**
     @brief Format construct type as human-readable string
     */
@@ -0,0 +1,44 @@
+/**
+@brief Encoding of qualified construct names as page file names
+
+Every rendered construct gets one page named after its qualified name, with
+"::" written as '.'. Characters that are invalid in file names on some
+platform are escaped, and the result is bounded so that long template or
+operator names stay well within Windows' MAX_PATH once the output directory is
+prepended. The encoding is a single table-driven pass and depends only on the
+name, so the same construct always lands on the same page.
+*/
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+@brief Longest page file name produced, in bytes, including the ".md" extension
+*/
+constexpr size_t kMaxPageNameLength = 128;
+
+/**
+@brief Encode a qualified name as a page file name
+
+- "::" and a lone ':' become '.', and ' ' becomes '_'
+- < > " | ? * \ / become %lt %gt %quote %pipe %quest %star %bslash %slash
+- Control characters become %xNN (two lowercase hex digits)
+- A reserved Windows device name (CON, NUL, COM1, ...) before the first '.' gets a '_' appended
+- A long result is cut (never inside a UTF-8 sequence) and ends in '~' and
+  the 16 hex digits of the XXH64 of the whole encoded name, so truncated names
+  stay distinct; room is left for an overload suffix, so even a suffixed name
+  is at most kMaxPageNameLength bytes
+
+@param qualified_name Name to encode (e.g. "geometry::Shape::area")
+@param out Receives the file name including ".md" (cleared first, so a buffer can be reused)
+*/
+void encodePageName(std::string_view qualified_name, std::string& out);
+
+/**
+@brief Give the page of one overload its own name by inserting "~" and 8 hex digits of a hash before ".md"
+@param filename File name from encodePageName, modified in place
+@param signature Text that tells the overloads apart (see overloadSignature)
+*/
+void appendOverloadSuffix(std::string& filename, std::string_view signature);
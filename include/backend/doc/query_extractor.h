@@ -0,0 +1,102 @@
+/**
+@brief Query-driven extraction of code constructs for any Tree-sitter language
+*/
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <backend/core/arena.h>
+#include <backend/doc/treesitter.h>
+#include <backend/doc/cpp/ast_extractor.h>
+
+/**
+@brief Extracts code constructs by running a language's construct query
+
+The query (the language's "query" .scm file) names what to extract through
+its captures, following the Tree-sitter tags conventions:
+
+- `@definition.function`, `@definition.method`, `@definition.class`,
+  `@definition.struct`, `@definition.enum`, `@definition.variable`,
+  `@definition.namespace`, `@definition.constructor` and
+  `@definition.destructor` capture the construct node
+- `@name` captures its name; the qualifier of a qualified name
+  (`Outer::name`) is appended to the enclosing namespace path
+- `@return_type` and `@parameters` capture the return type and parameter
+  list of functions
+- `@include` captures the path of an include directive
+
+Classes, structs and namespaces enclose the constructs inside them, which is
+how namespace paths are built. Matches are walked in document order with a
+scope stack instead of recursion. Text predicates such as `#match?` are not
+evaluated. Docstrings are not attached here; the caller associates them with
+the comment scan.
+*/
+class QueryExtractor {
+  public:
+    /**
+    @brief Extract all constructs matched by a query
+    @param tree Parsed Tree-sitter tree
+    @param content Original source code content
+    @param filename Name of the source file
+    @param query Compiled construct query for the tree's language
+    @return Constructs in document order, duplicates merged
+    */
+    std::vector<CodeConstruct> extractConstructs(TSTree* tree, const std::string& content,
+                                                 const std::string& filename, const TSQuery* query);
+
+    /**
+    @brief Paths captured as @include during the last extractConstructs call
+    */
+    const std::vector<std::string>& includes() const { return includes_; }
+
+    /**
+    @brief Intern construct strings into a shared interner
+    @param strings Interner to use (nullptr = extractor-owned)
+    */
+    void setStringInterner(StringInterner* strings) { strings_ = strings; }
+
+  private:
+    /**
+    @brief What a query capture means to the extractor
+    */
+    enum class CaptureRole {
+      Ignored,      ///< Capture not used by the extractor
+      Definition,   ///< Construct node (type in CaptureInfo::type)
+      Name,         ///< Construct name
+      ReturnType,   ///< Function return type
+      Parameters,   ///< Function parameter list
+      Include       ///< Include directive path
+    };
+
+    struct CaptureInfo {
+      CaptureRole role = CaptureRole::Ignored;
+      ConstructType type = ConstructType::Function;  ///< Construct type for Definition captures
+    };
+
+    struct CursorDeleter {
+      void operator()(TSQueryCursor* cursor) const { ts_query_cursor_delete(cursor); }
+    };
+
+    std::unique_ptr<TSQueryCursor, CursorDeleter> cursor_;  ///< Reused across files
+    const TSQuery* roles_query_ = nullptr;     ///< Query capture_roles_ was built for
+    std::vector<CaptureInfo> capture_roles_;   ///< Role of each capture ID in roles_query_
+    std::vector<std::string> includes_;        ///< @include paths from the last extraction
+    StringInterner* strings_ = nullptr;        ///< Shared interner for construct strings
+    std::unique_ptr<StringInterner> own_strings_; ///< Fallback interner when none is shared
+
+    /**
+    @brief Map capture names to roles unless already done for this query
+    */
+    void resolveCaptures(const TSQuery* query);
+
+    /**
+    @brief Interner in use (the shared one, or the extractor's own)
+    */
+    StringInterner& activeStrings();
+
+    /**
+    @brief Parameters of a captured parameter list
+    */
+    std::vector<Parameter> extractParameters(TSNode parameters, const std::string& content);
+};
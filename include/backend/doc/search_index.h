@@ -0,0 +1,119 @@
+/**
+@brief Full-text search index built from extracted constructs and emitted with the generated docs
+
+The index is kept in two forms:
+- A document table in the extract directory (searchDocumentsPath), holding
+  the terms of every page. Extraction only re-tokenizes the pages it renders,
+  so the table is updated incrementally alongside the cache.
+- The shards written to "<output_dir>/search" for client-side search:
+  - docs.json: {"version": 1, "shards": N, "documents": [[page, title, kind], ...]}
+    where a document's position is its id (removed pages leave a null that a
+    later page reuses, so ids and untouched shards stay stable).
+  - shard-<i>.bin: the terms whose searchShardOf() is i, sorted. Layout:
+    magic "CSRCHSHD", u32 version, u32 term count (little-endian), then per
+    term a varint length, the term bytes, a varint posting count and the
+    ascending document ids as varint deltas from the previous id (the first
+    from 0). Varints are LEB128.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <backend/doc/cpp/ast_extractor.h>
+
+/**
+@brief Split text into lowercase search terms
+
+Terms are runs of letters, digits, '_' and non-ASCII bytes. Identifiers are
+also split at '_' and case changes ("parseHTTPHeader" yields "parsehttpheader",
+"parse", "http" and "header"). Terms shorter than two characters and common
+English and doc-comment words are dropped.
+
+@param text Text to tokenize
+@param terms Receives the terms (appended, may contain duplicates)
+*/
+void tokenizeForSearch(std::string_view text, std::vector<std::string>& terms);
+
+/**
+@brief Shard holding a term: FNV-1a (32-bit) of its bytes modulo the shard count
+@param term Search term as produced by tokenizeForSearch
+@param shard_count Number of shards (at least 1)
+*/
+uint32_t searchShardOf(std::string_view term, uint32_t shard_count);
+
+/**
+@brief Location of the search document table for an extract directory
+*/
+std::string searchDocumentsPath(const std::string& extract_dir);
+
+/**
+@brief One searchable page
+*/
+struct SearchDocument {
+  std::string page;                ///< Page file name ("" for a free id)
+  std::string title;               ///< Fully qualified name shown in results
+  std::string kind;                ///< Construct type name ("class", "method", ...)
+  std::vector<std::string> terms;  ///< Distinct terms, sorted
+};
+
+/**
+@brief Incrementally maintained search documents and the shards built from them
+*/
+class SearchIndex {
+  public:
+    static constexpr uint32_t kFormatVersion = 1;   ///< Version of the table and shard formats
+    static constexpr uint32_t kDefaultShards = 16;  ///< Shards written when none are configured
+
+    /**
+    @brief Load a document table written by save()
+    @param path Table location
+    @return True if the table was read; a missing or unreadable table leaves the index empty
+    */
+    bool load(const std::string& path);
+
+    /**
+    @brief Write the document table (through a temporary file renamed over the target)
+    @param path Table location
+    @return True if the table was written
+    */
+    bool save(const std::string& path) const;
+
+    /**
+    @brief Add or replace the document of a rendered page
+    @param page Page file name
+    @param kind Construct type name
+    @param construct Construct the page was rendered from
+    */
+    void addPage(const std::string& page, const std::string& kind, const CodeConstruct& construct);
+
+    /**
+    @brief Drop the documents of pages that no longer exist
+    @param pages File names of every live page
+    */
+    void retainPages(const std::unordered_set<std::string>& pages);
+
+    /**
+    @brief Write docs.json and the shards, leaving files whose content is unchanged alone
+    @param dir Destination directory (created if missing)
+    @param shard_count Number of shards (at least 1)
+    @return True if every file was written
+    */
+    bool writeShards(const std::string& dir, uint32_t shard_count);
+
+    size_t size() const { return slots_.size(); }              ///< Number of documents
+    bool changed() const { return changed_; }                  ///< True if documents changed since load()
+    size_t filesWritten() const { return files_written_; }     ///< Files rewritten by the last writeShards()
+    const SearchDocument* document(const std::string& page) const;  ///< Document of a page, or null
+
+  private:
+    std::vector<SearchDocument> documents_;             ///< Documents by id (free ids have an empty page)
+    std::unordered_map<std::string, uint32_t> slots_;   ///< Page -> document id
+    std::vector<uint32_t> free_ids_;                    ///< Ids of removed documents, reused first
+    bool changed_ = false;                              ///< Documents changed since load()
+    size_t files_written_ = 0;                          ///< Files rewritten by the last writeShards()
+};
@@ -0,0 +1,93 @@
+/**
+@brief Content-addressed store of extraction results shared between machines
+
+CI runners start without a local cache, yet almost every file matches a
+build that already ran elsewhere. Each extracted file is stored under a key
+derived from its path, its content and everything that shapes extraction
+(grammar, query, docstring settings and tool version). Another run finding the
+same key loads the constructs instead of parsing the file. The store is a
+plain directory, so it can live on a shared mount or be restored and saved
+by the CI cache step like ccache's directory.
+
+Entries live at "<directory>/<first two key characters>/<key>.ndjson". The
+first line is {"version": 1, "includes": [...], "constructs": N}, followed by
+N constructs in the format written by constructToJson. Entries are written
+to a temporary file and renamed into place, so concurrent runners never see
+a partial entry.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <backend/core/arena.h>
+#include <backend/doc/cpp/ast_extractor.h>
+
+/**
+@brief Shared directory of extraction results keyed by content
+*/
+class SharedExtractionCache {
+  public:
+    static constexpr uint32_t kEntryVersion = 1;  ///< Bump whenever extraction output changes for the same input
+
+    /**
+    @brief Use a store directory (created on the first store)
+    @param directory Store location
+    */
+    explicit SharedExtractionCache(std::string directory);
+
+    /**
+    @brief Only read entries, never add them (e.g. for runners that must not publish)
+    */
+    void setReadOnly(bool read_only) { read_only_ = read_only; }
+
+    /**
+    @brief Key of one file's extraction result
+    @param settings Everything besides the file that changes extraction (grammar fingerprint, options)
+    @param source_path Path the constructs record as their file
+    @param content File content
+    @return 32 hex characters
+    */
+    static std::string key(std::string_view settings, std::string_view source_path, std::string_view content);
+
+    /**
+    @brief Load the result stored under a key
+    @param key Key from key()
+    @param strings Interner that stores the constructs' view fields
+    @param constructs Receives the constructs (without AST nodes)
+    @param includes Receives the file's #include paths
+    @return True on a hit; a missing, truncated or outdated entry is a miss
+    */
+    bool load(const std::string& key, StringInterner& strings, std::vector<CodeConstruct>& constructs,
+              std::vector<std::string>& includes);
+
+    /**
+    @brief Store a file's result under a key (does nothing when read-only)
+    @param key Key from key()
+    @param constructs Constructs extracted from the file
+    @param includes The file's #include paths
+    @return True if the entry was written
+    */
+    bool store(const std::string& key, const std::vector<CodeConstruct>& constructs,
+               const std::vector<std::string>& includes);
+
+    const std::string& directory() const { return directory_; }  ///< Store location
+    size_t hits() const { return hits_; }                         ///< Successful loads
+    size_t misses() const { return misses_; }                     ///< Failed loads
+    size_t stored() const { return stored_; }                     ///< Entries written
+
+  private:
+    std::string directory_;                ///< Store location
+    bool read_only_ = false;               ///< Never write entries
+    std::atomic<size_t> hits_{0};          ///< Successful loads (workers load concurrently)
+    std::atomic<size_t> misses_{0};        ///< Failed loads
+    std::atomic<size_t> stored_{0};        ///< Entries written
+    std::atomic<size_t> temp_counter_{0};  ///< Distinguishes temporary files of concurrent stores
+
+    /**
+    @brief Location of the entry for a key
+    */
+    std::string entryPath(const std::string& key) const;
+};
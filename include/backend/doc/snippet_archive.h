@@ -0,0 +1,113 @@
+/**
+@brief Single-file snippet archive used instead of one markdown file per construct
+
+Layout (all integers little-endian):
+- Header: magic "CSNIPPAK", format version, entry count and index offset.
+- Data region: page contents back to back, starting right after the header.
+- Index: one fixed-size entry per page (data offset/size, name offset/size),
+  sorted by page name so lookups are a binary search over the mapped file,
+  followed by the page names.
+
+Pages keep their usual output paths ("<extract_dir>/<name>.md") everywhere
+else; only the file name is stored as the entry name.
+*/
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <backend/core/mmap.h>
+
+/**
+@brief Where generated snippets are stored
+*/
+enum class OutputMode {
+  Files,    ///< One markdown file per page in the extract directory
+  Archive   ///< All pages in a single indexed archive in the extract directory
+};
+
+/**
+@brief Parse an output mode name from configuration ("files" or "archive")
+@param name Mode name
+@param mode Receives the parsed mode on success
+@return True if the name was recognized
+*/
+bool parseOutputMode(const std::string& name, OutputMode& mode);
+
+/**
+@brief Path of the snippet archive inside an extract directory
+*/
+std::string snippetArchivePath(const std::string& extract_dir);
+
+/**
+@brief Read-only view over a memory-mapped snippet archive
+
+Opening validates the header and index bounds only; page contents are
+returned as views into the mapping and never copied.
+*/
+class SnippetArchive {
+  public:
+    static constexpr uint32_t kFormatVersion = 1;  ///< Current archive format version
+
+    /**
+    @brief Map and validate an archive file
+    @param path Path to archive
+    @return True if the file is a valid archive of the current format version
+    */
+    bool open(const std::string& path);
+
+    /**
+    @brief Unmap the file; views returned earlier become invalid
+    */
+    void close();
+
+    bool isOpen() const { return file_.isOpen(); }  ///< True while an archive is mapped
+    size_t size() const { return entry_count_; }     ///< Number of pages
+
+    /**
+    @brief Binary search for a page name
+    @param name Page file name (e.g. "Shape.md")
+    @return Entry index, or nullopt if not present
+    */
+    std::optional<size_t> indexOf(std::string_view name) const;
+
+    /**
+    @brief True if the archive holds a page with this name
+    */
+    bool contains(std::string_view name) const { return indexOf(name).has_value(); }
+
+    std::string_view nameAt(size_t index) const;     ///< Page name of an entry
+    std::string_view contentAt(size_t index) const;  ///< Page content of an entry
+
+  private:
+    MappedFile file_;              ///< Mapped archive
+    size_t entry_count_ = 0;       ///< Number of index entries
+    size_t index_offset_ = 0;      ///< Offset of the index
+    size_t names_offset_ = 0;      ///< Offset of the page names after the index
+};
+
+/**
+@brief Write a complete archive
+@param path Destination path (overwritten)
+@param pages Page name -> content
+@return True if the file was written completely
+*/
+bool writeSnippetArchive(const std::string& path, const std::map<std::string_view, std::string_view>& pages);
+
+/**
+@brief Replace, add and remove pages in an archive, keeping every other page
+
+The new archive is written next to the old one and renamed over it, so a
+failed update leaves the previous archive intact.
+
+@param path Archive path (created if missing)
+@param updated Pages to add or replace, keyed by page name
+@param removed Page names to drop
+@return True if the archive was rewritten
+*/
+bool updateSnippetArchive(const std::string& path,
+                          const std::map<std::string, std::string>& updated,
+                          const std::set<std::string>& removed = {});
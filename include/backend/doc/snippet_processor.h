@@ -0,0 +1,93 @@
+/**
+@brief Generation stage that turns extracted snippets into cross-referenced documentation pages
+*/
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <backend/doc/snippet_archive.h>
+#include <backend/doc/symbol_index.h>
+
+/**
+@brief Builds the output documentation from the snippets in an extract directory
+
+Every snippet is indexed by its frontmatter, inline code references to
+documented symbols are turned into links, and one page per namespace (plus
+namespaces/index.md) lists its members.
+
+A manifest in the output directory records each snippet's input stamp
+(mtime and size, or content hash for archived snippets), its symbol identity
+and the symbol index fingerprint. Unchanged snippets are neither read nor
+rewritten; pages with code references are redone only when the index
+changes. Outputs that come out identical to their snippet are hard linked
+to it instead of copied. The symbol index is also saved in the extract
+directory (see symbolIndexPath) whenever a symbol could have changed.
+*/
+class SnippetProcessor {
+  public:
+    /**
+    @brief Set the number of threads used to process changed pages
+    @param jobs Number of workers (0 = hardware concurrency)
+    */
+    void setJobs(size_t jobs) { jobs_ = jobs; }
+
+    /**
+    @brief Read snippets from individual files (default) or the snippet archive
+    */
+    void setOutputMode(OutputMode mode) { output_mode_ = mode; }
+
+    /**
+    @brief Use pages rendered earlier in this run instead of reading those snippets back from disk
+
+    The pages must be what was written to the extract directory, since outputs
+    identical to their snippet are still hard linked to the file on disk.
+
+    @param pages Snippet file name -> content (must outlive process(); nullptr = read everything from disk)
+    */
+    void setRenderedSnippets(const std::unordered_map<std::string, std::string>* pages) { rendered_ = pages; }
+
+    /**
+    @brief Bring the output directory up to date with the extract directory
+    @param extract_dir Directory containing snippets (or the snippet archive)
+    @param output_dir Directory for the generated documentation
+    @return True if every page was brought up to date
+    */
+    bool process(const std::string& extract_dir, const std::string& output_dir);
+
+    /**
+    @brief Turn inline code spans naming documented symbols into markdown links
+
+    Frontmatter, fenced code blocks, spans that are already link text and
+    references to the page itself are left alone.
+
+    @param content Page content
+    @param index Symbol index to resolve against
+    @param self_page Page the content belongs to
+    @param link_prefix Prefix for link targets (e.g. "../" from a subdirectory)
+    @return Content with links added
+    */
+    static std::string linkReferences(std::string_view content, const SymbolIndex& index,
+                                      std::string_view self_page, std::string_view link_prefix = "");
+
+    /**
+    @brief Path of the manifest kept in an output directory
+    */
+    static std::string manifestPath(const std::string& output_dir);
+
+    size_t writtenCount() const { return written_count_; }      ///< Pages written by the last run
+    size_t linkedCount() const { return linked_count_; }        ///< Pages hard linked to their snippet
+    size_t unchangedCount() const { return unchanged_count_; }  ///< Pages left untouched
+    size_t removedCount() const { return removed_count_; }      ///< Outputs removed with their snippet
+    size_t failedCount() const { return failed_count_; }        ///< Pages that could not be written
+
+  private:
+    size_t jobs_ = 1;                             ///< Worker threads for changed pages
+    OutputMode output_mode_ = OutputMode::Files;  ///< Where snippets are read from
+    const std::unordered_map<std::string, std::string>* rendered_ = nullptr;  ///< Snippets already in memory
+    size_t written_count_ = 0;                    ///< Pages written by the last run
+    size_t linked_count_ = 0;                     ///< Pages linked by the last run
+    size_t unchanged_count_ = 0;                  ///< Pages untouched by the last run
+    size_t removed_count_ = 0;                    ///< Outputs removed by the last run
+    size_t failed_count_ = 0;                     ///< Pages that failed in the last run
+};
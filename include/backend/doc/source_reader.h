@@ -0,0 +1,70 @@
+/**
+@brief Source file loading with size limits and generated/binary file detection
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+@brief Which source files are read for extraction
+*/
+struct SourceLimits {
+  uint64_t max_file_size = 0;   ///< Largest file read in bytes (0 = no limit)
+  bool skip_binary = true;      ///< Skip files containing NUL bytes near the start
+  bool skip_generated = false;  ///< Skip files marked as generated near the start
+};
+
+/**
+@brief Outcome of reading a source file
+*/
+enum class SourceStatus {
+  Loaded,       ///< Content is available
+  Unreadable,   ///< File could not be opened or read
+  TooLarge,     ///< Larger than SourceLimits::max_file_size
+  Binary,       ///< Looks like a binary file
+  Generated,    ///< Carries a generated-code marker
+  TimedOut      ///< Read, but parsing ran past the parse time budget
+};
+
+/**
+@brief Short name of a status for messages (e.g. "too large")
+*/
+const char* sourceStatusName(SourceStatus status);
+
+/**
+@brief Classify the start of a file against the skip rules
+@param head First bytes of the file (at least the first few KiB when available)
+@param limits Skip rules
+@return Binary or Generated if a rule matches, otherwise Loaded
+*/
+SourceStatus sniffSource(std::string_view head, const SourceLimits& limits);
+
+/**
+@brief Reads source files into a reusable buffer
+
+The file size is checked before anything is read, and the whole file is then
+read with one call into a buffer whose capacity carries over to the next file,
+so a worker allocates only when it meets a file larger than any before.
+*/
+class SourceReader {
+  public:
+    void setLimits(const SourceLimits& limits) { limits_ = limits; }
+
+    /**
+    @brief Read a file unless a skip rule applies
+    @param path Path to the file
+    @return Loaded if content() now holds the file, otherwise why it was not read
+    */
+    SourceStatus read(const std::string& path);
+
+    /**
+    @brief Content of the last file read (valid until the next read)
+    */
+    const std::string& content() const { return buffer_; }
+
+  private:
+    SourceLimits limits_;   ///< Skip rules applied to every read
+    std::string buffer_;    ///< Reused file content buffer
+};
@@ -0,0 +1,196 @@
+/**
+@brief Index of documented symbols used to resolve cross-references between generated pages
+
+The generation stage also saves the index next to the cache as a sorted,
+memory-mapped file, so tools can look symbols up without reading a page.
+
+File layout (all integers little-endian):
+- Header: magic "CSYMINDX", format version, counts of symbols, type names
+  and type users, and the string table size.
+- Symbol table: one fixed-size record per page, sorted by full name (overloads
+  sharing one by page), so exact and prefix lookups are binary searches.
+- Name table: symbol numbers sorted by unqualified name.
+- Type table: one entry per type name used in a signature, sorted by name,
+  pointing at a run of the user table (symbol numbers).
+- String table: every distinct string stored once; records refer to strings
+  by (offset, length).
+*/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <backend/core/mmap.h>
+
+/**
+@brief Identity of one generated page, as recorded in its frontmatter
+*/
+struct SymbolInfo {
+  std::string page;            ///< Page file name (e.g. "geometry.Shape.area.md")
+  std::string type;            ///< Construct type name ("class", "method", ...)
+  std::string name;            ///< Unqualified name
+  std::string full_name;       ///< Fully qualified name
+  std::string namespace_path;  ///< Enclosing namespace ("" for the global namespace)
+  std::string file;            ///< Source file the construct was extracted from
+  uint32_t line = 0;           ///< Starting line in the source file
+  std::vector<std::string> uses;  ///< Type names in the return and parameter types
+};
+
+/**
+@brief Type names mentioned in a C++ type as written in a signature
+
+"const std::vector<geo::Shape>&" yields "std::vector" and "geo::Shape";
+qualifiers, built-in types and punctuation are dropped.
+
+@param type Type as written
+@param names Receives the names not already present
+*/
+void collectTypeNames(std::string_view type, std::vector<std::string>& names);
+
+/**
+@brief Read the construct identity from a generated page's YAML frontmatter
+@param page Page file name
+@param content Page content
+@return Symbol information, or nullopt if the page has no frontmatter or no name
+
+The return_type and parameter_types keys fill SymbolInfo::uses.
+*/
+std::optional<SymbolInfo> parseSymbolFrontmatter(std::string_view page, std::string_view content);
+
+/**
+@brief Maps qualified and unqualified symbol names to the pages documenting them
+
+Unqualified names only resolve while they name one symbol; a name defined in
+several places must be written qualified to be linked. Overloads share a full
+name, which links to the first of their pages in name order.
+*/
+class SymbolIndex {
+  public:
+    /**
+    @brief Add a documented symbol
+    */
+    void add(const SymbolInfo& symbol);
+
+    /**
+    @brief Resolve a reference as written in documentation
+    @param reference Symbol name, optionally with a leading "::" or trailing "()"
+    @return Page documenting the symbol, or nullptr if unknown or ambiguous
+    */
+    const std::string* resolve(std::string_view reference) const;
+
+    /**
+    @brief Hash of every (name, page) mapping; changes whenever any resolution could change
+    */
+    std::string fingerprint() const;
+
+    size_t size() const { return by_full_name_.size(); }  ///< Number of qualified names
+
+  private:
+    std::map<std::string, std::string, std::less<>> by_full_name_;  ///< Qualified name -> page
+    std::map<std::string, std::string, std::less<>> by_name_;       ///< Unqualified name -> qualified name ("" if ambiguous)
+};
+
+/**
+@brief Path of the saved symbol index inside an extract directory
+*/
+std::string symbolIndexPath(const std::string& extract_dir);
+
+/**
+@brief Write symbols as a symbol index file
+@param path Destination path (replaced by rename, so open views of the old file stay valid)
+@param symbols Symbols in any order; sorted by full name then page on write (repeats of a page are dropped)
+@return True if the file was written completely
+*/
+bool writeSymbolIndex(const std::string& path, std::vector<SymbolInfo> symbols);
+
+/**
+@brief One symbol of a mapped symbol index (views point into the mapping)
+*/
+struct SymbolRecord {
+  std::string_view page;            ///< Page file name
+  std::string_view type;            ///< Construct type name
+  std::string_view name;            ///< Unqualified name
+  std::string_view full_name;       ///< Fully qualified name
+  std::string_view namespace_path;  ///< Enclosing namespace
+  std::string_view file;            ///< Source file
+  uint32_t line = 0;                ///< Starting line in the source file
+};
+
+/**
+@brief Read-only view over a memory-mapped symbol index
+
+Opening validates the header and section bounds only; every lookup is a
+binary search over the mapping and decodes just the records it returns.
+*/
+class SymbolIndexView {
+  public:
+    static constexpr uint32_t kFormatVersion = 1;  ///< Current index format version
+
+    /**
+    @brief Map and validate an index file
+    @param path Path to the index
+    @return True if the file is a valid index of the current format version
+    */
+    bool open(const std::string& path);
+
+    /**
+    @brief Unmap the file; records returned earlier become invalid
+    */
+    void close();
+
+    bool isOpen() const { return file_.isOpen(); }  ///< True while an index is mapped
+    size_t size() const { return symbol_count_; }    ///< Number of symbols
+
+    /**
+    @brief Decode a symbol by its position in full-name order
+    */
+    SymbolRecord symbolAt(size_t index) const;
+
+    /**
+    @brief Find a symbol by fully qualified name (a leading "::" is ignored)
+    @return Symbol number of the first overload, the rest follow it; nullopt if not present
+    */
+    std::optional<size_t> find(std::string_view full_name) const;
+
+    /**
+    @brief Symbols whose full name starts with a prefix, as a [begin, end) range of symbol numbers
+    */
+    std::pair<size_t, size_t> prefixRange(std::string_view prefix) const;
+
+    /**
+    @brief Symbols with an unqualified name, in full-name order
+    */
+    std::vector<size_t> withName(std::string_view name) const;
+
+    /**
+    @brief Symbols whose return or parameter types mention a type name, in full-name order
+    @param type_name Type name as collectTypeNames produces it (a leading "::" is ignored)
+    */
+    std::vector<size_t> usersOf(std::string_view type_name) const;
+
+  private:
+    MappedFile file_;              ///< Mapped index
+    size_t symbol_count_ = 0;      ///< Number of symbol records
+    size_t type_count_ = 0;        ///< Number of type table entries
+    size_t user_count_ = 0;        ///< Number of user table entries
+    size_t symbols_offset_ = 0;    ///< Offset of the symbol table
+    size_t names_offset_ = 0;      ///< Offset of the name table
+    size_t types_offset_ = 0;      ///< Offset of the type table
+    size_t users_offset_ = 0;      ///< Offset of the user table
+    size_t strings_offset_ = 0;    ///< Offset of the string table
+    size_t strings_size_ = 0;      ///< Size of the string table in bytes
+
+    /**
+    @brief Resolve a packed (offset, length) string reference, empty if out of bounds
+    */
+    std::string_view stringAt(uint64_t ref) const;
+
+    std::string_view fullNameAt(size_t index) const;  ///< Full name of a symbol record
+    std::string_view nameAt(size_t index) const;      ///< Unqualified name of a symbol record
+    std::string_view typeNameAt(size_t index) const;  ///< Name of a type table entry
+};
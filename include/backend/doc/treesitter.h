@@ -3,8 +3,12 @@
 */
 #pragma once
 
+#include <chrono>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "tree_sitter/api.h"
 #include <backend/core/dynlib.h>
@@ -24,30 +28,190 @@ struct SourceLocation {
   size_t byte_offset;  ///< Byte offset from start of file
 };
 
+/**
+@brief Deleter for Tree-sitter queries held in smart pointers
+*/
+struct TSQueryDeleter {
+  void operator()(TSQuery* query) const { ts_query_delete(query); }
+};
+
+typedef std::unique_ptr<TSQuery, TSQueryDeleter> TSQueryPtr;
+
+/**
+@brief Compile a Tree-sitter query, logging the position of any error
+@param language Language the query is written for
+@param source Query source (.scm syntax)
+@param origin Where the source came from, for error messages
+@return Compiled query, or null if it does not compile
+*/
+TSQueryPtr compileQuery(const TSLanguage* language, const std::string& source, const std::string& origin);
+
+/**
+@brief Parse a string, giving up once a deadline passes
+@param parser Parser configured for the content's language
+@param old_tree Edited previous tree whose unchanged subtrees are reused, or null
+@param content Source text
+@param deadline Parsing stops after this point (time_point::max() parses without a limit)
+@return Parsed tree owned by the caller, or null if parsing failed or ran past the deadline
+*/
+TSTree* parseWithDeadline(TSParser* parser, const TSTree* old_tree, const std::string& content,
+                          std::chrono::steady_clock::time_point deadline);
+
+/**
+@brief Accounting of the memory tree-sitter allocates, per thread
+
+Once installed, every tree-sitter allocation goes through malloc as before but
+is counted against the calling thread, so a worker can report how much parser
+and tree memory one file needed. Sizes come from the C library's block size,
+so blocks allocated before installation are freed correctly.
+*/
+namespace parser_memory {
+  /**
+  @brief Route tree-sitter's allocations through the counting allocator (idempotent)
+  */
+  void install();
+
+  /**
+  @brief Check whether the counting allocator is installed
+  */
+  bool installed();
+
+  /**
+  @brief Start a new peak on the calling thread at its current live bytes
+  */
+  void resetPeak();
+
+  /**
+  @brief Most bytes the calling thread had live since resetPeak(), above the level at the reset
+  */
+  uint64_t peak();
+}
+
 /**
 @brief Complete information about a loaded Tree-sitter language parser
 */
 struct LanguageInfo {
-  dynlib::DynLib library;                ///< Dynamic library containing the parser
-  TSLanguage* language;                   ///< Tree-sitter language parser
+  dynlib::DynLib library;                ///< Dynamic library containing the parser (empty for built-in grammars)
+  const TSLanguage* language;             ///< Tree-sitter language parser
   std::vector<std::string> extensions;    ///< File extensions this parser handles
   std::string docstring_style;            ///< Documentation comment style (e.g., "/**", "///")
+  uint32_t docstring_window = 10;         ///< Most lines a docstring may sit above the construct it documents
   std::string function_name;              ///< Tree-sitter function name for this language
+  TSQueryPtr query;                       ///< Compiled construct query from the "query" file (null if none)
+  std::string grammar_fingerprint;        ///< Hash of the grammar's ABI version, sizes and query source
+};
+
+/**
+@brief A configured language, recorded at startup and loaded on first use
+*/
+struct LanguageSpec {
+  std::string library;                    ///< "library" config value
+  std::string function_name;              ///< "function" config value
+  std::vector<std::string> extensions;    ///< File extensions this parser handles
+  std::string docstring_style;            ///< Documentation comment style
+  uint32_t docstring_window = 10;         ///< "docstring_window" config value
+  std::string query_path;                 ///< Resolved "query" file path (empty if none)
+  std::string config_file_path;           ///< Config file the library path is relative to
+  bool allow_builtin = true;              ///< Use a built-in grammar with the same function ("builtin": false disables)
+  bool failed = false;                    ///< Loading was attempted and failed (not retried)
+};
+
+class DynamicLanguageLoader;
+
+/**
+@brief RAII handle for a pooled Tree-sitter parser
+
+The parser is already configured for the language it was acquired for and is
+handed back to the owning DynamicLanguageLoader when the lease is destroyed.
+*/
+class ParserLease {
+  private:
+    DynamicLanguageLoader* owner_ = nullptr;  ///< Pool the parser is returned to
+    const TSLanguage* language_ = nullptr;    ///< Language the parser is configured for
+    TSParser* parser_ = nullptr;              ///< Leased parser (null if acquisition failed)
+
+    void release();
+
+  public:
+    ParserLease() = default;
+    ParserLease(DynamicLanguageLoader* owner, const TSLanguage* language, TSParser* parser);
+    ~ParserLease();
+    ParserLease(ParserLease&& other) noexcept;
+    ParserLease& operator=(ParserLease&& other) noexcept;
+    ParserLease(const ParserLease&) = delete;
+    ParserLease& operator=(const ParserLease&) = delete;
+
+    /**
+    @brief Get the leased parser
+    @return Parser pointer, or nullptr if no parser could be created
+    */
+    TSParser* get() const { return parser_; }
+
+    explicit operator bool() const { return parser_ != nullptr; }
 };
 
 /**
 @brief Manages dynamic loading and caching of Tree-sitter language parsers
 
 Loads Tree-sitter parser libraries from configuration, caches them for reuse,
-and provides file extension to language mapping.
+and provides file extension to language mapping. Also owns a thread-safe pool
+of TSParser instances per language so parsers are not recreated per file.
 */
 class DynamicLanguageLoader {
   private:
+    std::map<std::string, LanguageSpec> registered_languages_;  ///< Configured languages, loaded or not
     std::map<std::string, LanguageInfo> loaded_languages_;  ///< Cache of loaded parsers
+    std::unordered_map<std::string, std::pair<const std::string, LanguageSpec>*> languages_by_extension_;  ///< Extension (".h.in" included) -> configured language
+    std::mutex load_mutex_;                                 ///< Guards loading on first use
+    std::unordered_map<const TSLanguage*, std::vector<TSParser*>> idle_parsers_;  ///< Idle pooled parsers per language
+    std::mutex parser_pool_mutex_;                          ///< Guards idle_parsers_
+
+    friend class ParserLease;
+
+    /**
+    @brief Return a leased parser to the idle pool
+    @param language Language the parser is configured for
+    @param parser Parser to return
+    */
+    void releaseParser(const TSLanguage* language, TSParser* parser);
+
+    /**
+    @brief Rebuild languages_by_extension_ after a language was registered
+    An extension claimed by several languages goes to the first by name, as before.
+    */
+    void rebuildExtensionIndex();
+
+    /**
+    @brief Load a registered language unless it is loaded already (caller holds load_mutex_)
+    @param language Name and configuration of the language
+    @return The loaded language, or nullptr if it failed to load (now or earlier)
+    */
+    const LanguageInfo* ensureLoaded(std::pair<const std::string, LanguageSpec>& language);
 
   public:
+    DynamicLanguageLoader() = default;
+    ~DynamicLanguageLoader();
+    DynamicLanguageLoader(const DynamicLanguageLoader&) = delete;
+    DynamicLanguageLoader& operator=(const DynamicLanguageLoader&) = delete;
+
+    /**
+    @brief Borrow a parser configured for the given language from the pool
+    @param lang_info Language the parser must be configured for
+    @return Lease owning the parser until it goes out of scope (empty on failure)
+    */
+    ParserLease acquireParser(const LanguageInfo& lang_info);
+
     /**
-    @brief Load a Tree-sitter language parser from configuration
+    @brief Record a language from configuration; its grammar is loaded when a file first needs it
+    @param name Language name (e.g., "cpp", "python")
+    @param config JSON configuration for the language parser
+    @param configFilePath Path to config file for relative path resolution (optional)
+    @return False if the configuration lacks the library or function name
+    */
+    bool registerLanguage(const std::string& name, const JsonValue& config, const std::string& configFilePath = "");
+
+    /**
+    @brief Register a language from configuration and load its grammar right away
     @param name Language name (e.g., "cpp", "python")
     @param config JSON configuration for the language parser
     @param configFilePath Path to config file for relative path resolution (optional)
@@ -57,6 +221,12 @@ class DynamicLanguageLoader {
 
     /**
     @brief Find appropriate language parser for a source file
+
+    Every dotted suffix of the file name is tried, longest first, so a configured
+    ".h.in" wins over ".in" for "config.h.in".
+
+    A registered language is loaded the first time one of its files is seen.
+
     @param filename Path to source file
     @return Pair of language name and LanguageInfo pointer, or empty if not found
     */
@@ -68,3 +238,62 @@ class DynamicLanguageLoader {
     */
     const std::map<std::string, LanguageInfo>& getLoadedLanguages() const;
 };
+
+/**
+@brief Retains parse trees so changed files can be reparsed incrementally
+
+Tree-sitter cannot serialize trees, so the previous tree and source text are kept
+in memory for the lifetime of the owning process (e.g. watch mode or an embedded
+extractor). When a file is parsed again, a single TSInputEdit covering the changed
+region is derived from a prefix/suffix diff, applied with ts_tree_edit, and the
+edited tree is passed to the parser so unchanged subtrees are reused.
+*/
+class IncrementalParseCache {
+  private:
+    struct Entry {
+      const TSLanguage* language;  ///< Language the tree was parsed with
+      std::string content;         ///< Source text the tree corresponds to
+      TSTree* tree;                ///< Retained tree (owned)
+    };
+
+    std::unordered_map<std::string, Entry> entries_;  ///< Retained trees by file path
+    std::mutex mutex_;                                ///< Guards entries_
+
+  public:
+    IncrementalParseCache() = default;
+    ~IncrementalParseCache();
+    IncrementalParseCache(const IncrementalParseCache&) = delete;
+    IncrementalParseCache& operator=(const IncrementalParseCache&) = delete;
+
+    /**
+    @brief Parse a file, reusing its previously retained tree when available
+    @param parser Parser already configured for language
+    @param filepath Path identifying the file
+    @param language Language the content is parsed as
+    @param content Current file content
+    @param deadline Parsing stops after this point (see parseWithDeadline)
+    @return Newly parsed tree owned by the caller, or nullptr on failure
+    */
+    TSTree* parse(TSParser* parser, const std::string& filepath,
+                  const TSLanguage* language, const std::string& content,
+                  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+    /**
+    @brief Drop the retained tree for a file (e.g. when it is deleted)
+    @param filepath Path identifying the file
+    */
+    void forget(const std::string& filepath);
+
+    /**
+    @brief Drop all retained trees
+    */
+    void clear();
+
+    /**
+    @brief Compute the single edit that transforms old_content into new_content
+    @param old_content Previous file content
+    @param new_content Current file content
+    @return Edit spanning the region between the common prefix and common suffix
+    */
+    static TSInputEdit computeEdit(const std::string& old_content, const std::string& new_content);
+};
@@ -0,0 +1,54 @@
+; Construct query for C and C++ sources, used when "query_extraction" is enabled.
+; Capture names follow the conventions documented in backend/doc/query_extractor.h.
+
+(preproc_include path: (_) @include)
+
+(namespace_definition
+  name: (_) @name
+  body: (_)) @definition.namespace
+
+(class_specifier
+  name: (_) @name
+  body: (_)) @definition.class
+
+(struct_specifier
+  name: (_) @name
+  body: (_)) @definition.struct
+
+(enum_specifier
+  name: (_) @name
+  body: (_)) @definition.enum
+
+; Function definitions, including out-of-class member definitions (Class::method)
+(function_definition
+  type: (_)? @return_type
+  declarator: (function_declarator
+    declarator: (_) @name
+    parameters: (_) @parameters)) @definition.function
+
+(function_definition
+  type: (_) @return_type
+  declarator: (pointer_declarator
+    declarator: (function_declarator
+      declarator: (_) @name
+      parameters: (_) @parameters))) @definition.function
+
+(function_definition
+  type: (_) @return_type
+  declarator: (reference_declarator
+    (function_declarator
+      declarator: (_) @name
+      parameters: (_) @parameters))) @definition.function
+
+; Function declarations at namespace scope and member function declarations
+(declaration
+  type: (_)? @return_type
+  declarator: (function_declarator
+    declarator: (_) @name
+    parameters: (_) @parameters)) @definition.function
+
+(field_declaration
+  type: (_)? @return_type
+  declarator: (function_declarator
+    declarator: (_) @name
+    parameters: (_) @parameters)) @definition.function
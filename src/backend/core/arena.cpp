@@ -0,0 +1,71 @@
+/**
+@brief Arena and string interner implementation
+*/
+#include <backend/core/arena.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+void* Arena::allocate(size_t size, size_t alignment) {
+  size_t padding = cursor_ ? (alignment - reinterpret_cast<uintptr_t>(cursor_) % alignment) % alignment : 0;
+  if (!cursor_ || padding + size > remaining_) {
+    // Oversized requests get a block of their own; new blocks are max_align_t aligned
+    size_t block = std::max(block_size_, size + alignment);
+    blocks_.push_back(std::make_unique<char[]>(block));
+    cursor_ = blocks_.back().get();
+    remaining_ = block;
+    padding = (alignment - reinterpret_cast<uintptr_t>(cursor_) % alignment) % alignment;
+  }
+
+  char* result = cursor_ + padding;
+  cursor_ = result + size;
+  remaining_ -= padding + size;
+  bytes_used_ += size;
+  return result;
+}
+
+std::string_view Arena::copy(std::string_view text) {
+  if (text.empty()) {
+    return {};
+  }
+  char* data = static_cast<char*>(allocate(text.size(), 1));
+  std::memcpy(data, text.data(), text.size());
+  return std::string_view(data, text.size());
+}
+
+void Arena::reset() {
+  blocks_.clear();
+  cursor_ = nullptr;
+  remaining_ = 0;
+  bytes_used_ = 0;
+}
+
+std::string_view StringInterner::intern(std::string_view text) {
+  if (text.empty()) {
+    return {};
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto existing = strings_.find(text);
+  if (existing != strings_.end()) {
+    return *existing;
+  }
+  std::string_view stored = arena_.copy(text);
+  strings_.insert(stored);
+  return stored;
+}
+
+void StringInterner::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  strings_.clear();
+  arena_.reset();
+}
+
+size_t StringInterner::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return strings_.size();
+}
+
+size_t StringInterner::bytesStored() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return arena_.bytesUsed();
+}
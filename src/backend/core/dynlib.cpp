@@ -47,10 +47,10 @@ const std::string& DynLib::getPath() const {
 }
 
 void* DynLib::getFuncRaw(const std::string& name) const {
-  CLILogger::debug("DynLib::getFuncRaw: Attempting to get function '" + name + "' from library: " + path_);
+  LOG_DEBUG("DynLib::getFuncRaw: Attempting to get function '" + name + "' from library: " + path_);
   
   if (!handle_) {
-    CLILogger::debug("DynLib::getFuncRaw: Library handle is null, cannot get function: " + name);
+    LOG_DEBUG("DynLib::getFuncRaw: Library handle is null, cannot get function: " + name);
     return nullptr;
   }
 
@@ -61,10 +61,10 @@ void* DynLib::getFuncRaw(const std::string& name) const {
   #endif
   
   if (func) {
-    CLILogger::debug("DynLib::getFuncRaw: Successfully found function '" + name + "' in library: " + path_);
+    LOG_DEBUG("DynLib::getFuncRaw: Successfully found function '" + name + "' in library: " + path_);
   } else {
     std::string error = getLastDynLibError();
-    CLILogger::debug("DynLib::getFuncRaw: Failed to find function '" + name + "' in library " + path_ + ": " + error);
+    LOG_DEBUG("DynLib::getFuncRaw: Failed to find function '" + name + "' in library " + path_ + ": " + error);
   }
   
   return func;
@@ -107,10 +107,10 @@ std::string replaceExt(const std::string& path, const std::string& newExt) {
 
 // Free function implementations
 DynLib loadDynLib(const std::string& path) {
-  CLILogger::debug("loadDynLib: Attempting to load library: " + path);
+  LOG_DEBUG("loadDynLib: Attempting to load library: " + path);
   
   // First, try the exact path as given
-  CLILogger::debug("loadDynLib: Trying exact path: " + path);
+  LOG_DEBUG("loadDynLib: Trying exact path: " + path);
   #ifdef _WIN32
     DynLibHandle handle = LoadLibraryW(utf8::widen(path).c_str());
   #else
@@ -118,12 +118,12 @@ DynLib loadDynLib(const std::string& path) {
   #endif
 
   if (handle) {
-    CLILogger::debug("loadDynLib: Successfully loaded library from exact path: " + path);
+    LOG_DEBUG("loadDynLib: Successfully loaded library from exact path: " + path);
     return DynLib(handle, path);
   }
   
   std::string exactPathError = getLastDynLibError();
-  CLILogger::debug("loadDynLib: Exact path failed: " + exactPathError);
+  LOG_DEBUG("loadDynLib: Exact path failed: " + exactPathError);
 
   // If that failed, try with platform-specific extension
   std::string platformExt = getPlatformExt();
@@ -131,7 +131,7 @@ DynLib loadDynLib(const std::string& path) {
 
   // Only try the platform path if it's different from the original
   if (platformPath != path) {
-    CLILogger::debug("loadDynLib: Trying platform-specific path: " + platformPath);
+    LOG_DEBUG("loadDynLib: Trying platform-specific path: " + platformPath);
     #ifdef _WIN32
       handle = LoadLibraryW(utf8::widen(platformPath).c_str());
     #else
@@ -139,29 +139,29 @@ DynLib loadDynLib(const std::string& path) {
     #endif
 
     if (handle) {
-      CLILogger::debug("loadDynLib: Successfully loaded library from platform path: " + platformPath);
+      LOG_DEBUG("loadDynLib: Successfully loaded library from platform path: " + platformPath);
       return DynLib(handle, platformPath);
     }
     
     std::string platformPathError = getLastDynLibError();
-    CLILogger::debug("loadDynLib: Platform path failed: " + platformPathError);
+    LOG_DEBUG("loadDynLib: Platform path failed: " + platformPathError);
   } else {
-    CLILogger::debug("loadDynLib: Skipping platform path (same as original): " + platformPath);
+    LOG_DEBUG("loadDynLib: Skipping platform path (same as original): " + platformPath);
   }
 
   // Return invalid library if both attempts failed
-  CLILogger::debug("loadDynLib: All attempts failed for library: " + path);
+  LOG_DEBUG("loadDynLib: All attempts failed for library: " + path);
   return DynLib(nullptr, path);
 }
 
 DynLib loadDynLibFromPaths(const std::string& baseName, const std::vector<std::string>& searchPaths) {
-  CLILogger::debug("loadDynLibFromPaths: Searching for library '" + baseName + "' in " + std::to_string(searchPaths.size()) + " paths");
+  LOG_DEBUG("loadDynLibFromPaths: Searching for library '" + baseName + "' in " + std::to_string(searchPaths.size()) + " paths");
   
   std::vector<std::string> paths = searchPaths;
 
   // Add default search paths if none provided
   if (paths.empty()) {
-    CLILogger::debug("loadDynLibFromPaths: Using default search paths (no paths provided)");
+    LOG_DEBUG("loadDynLibFromPaths: Using default search paths (no paths provided)");
     paths = {
       ".",
       #ifndef _WIN32
@@ -173,33 +173,33 @@ DynLib loadDynLibFromPaths(const std::string& baseName, const std::vector<std::s
 
   // Try to find the library in each search path
   for (const auto& searchDir : paths) {
-    CLILogger::debug("loadDynLibFromPaths: Searching in directory: " + searchDir);
+    LOG_DEBUG("loadDynLibFromPaths: Searching in directory: " + searchDir);
     std::string resolved_name = findDynLibFile(baseName, searchDir);
     if (resolved_name != baseName) { // Found something different
       std::filesystem::path full_path = std::filesystem::path(searchDir) / resolved_name;
-      CLILogger::debug("loadDynLibFromPaths: Found potential match: " + full_path.string());
+      LOG_DEBUG("loadDynLibFromPaths: Found potential match: " + full_path.string());
       DynLib lib = loadDynLib(full_path.string());
       if (lib.isValid()) {
-        CLILogger::debug("loadDynLibFromPaths: Successfully loaded library from: " + full_path.string());
+        LOG_DEBUG("loadDynLibFromPaths: Successfully loaded library from: " + full_path.string());
         return lib;
       }
-      CLILogger::debug("loadDynLibFromPaths: Failed to load found match: " + full_path.string());
+      LOG_DEBUG("loadDynLibFromPaths: Failed to load found match: " + full_path.string());
     } else {
-      CLILogger::debug("loadDynLibFromPaths: No matches found in directory: " + searchDir);
+      LOG_DEBUG("loadDynLibFromPaths: No matches found in directory: " + searchDir);
     }
   }
 
   // Fallback: try loading with platform-specific name directly
   std::string platform_name = resolvePlatformDynLibName(baseName);
-  CLILogger::debug("loadDynLibFromPaths: Trying fallback platform name: " + platform_name);
+  LOG_DEBUG("loadDynLibFromPaths: Trying fallback platform name: " + platform_name);
   DynLib lib = loadDynLib(platform_name);
   if (lib.isValid()) {
-    CLILogger::debug("loadDynLibFromPaths: Successfully loaded library from fallback: " + platform_name);
+    LOG_DEBUG("loadDynLibFromPaths: Successfully loaded library from fallback: " + platform_name);
     return lib;
   }
-  CLILogger::debug("loadDynLibFromPaths: Fallback failed: " + platform_name);
+  LOG_DEBUG("loadDynLibFromPaths: Fallback failed: " + platform_name);
 
-  CLILogger::debug("loadDynLibFromPaths: All search attempts failed for library: " + baseName);
+  LOG_DEBUG("loadDynLibFromPaths: All search attempts failed for library: " + baseName);
   return DynLib(); // Return invalid library
 }
 
@@ -309,128 +309,128 @@ std::vector<std::string> getSystemSearchPaths() {
 }
 
 DynLib loadDynLibFromConfig(const std::string& libraryPath, const std::string& configFilePath) {
-  CLILogger::debug("loadDynLibFromConfig: Attempting to load library '" + libraryPath + "' with config '" + configFilePath + "'");
+  LOG_DEBUG("loadDynLibFromConfig: Attempting to load library '" + libraryPath + "' with config '" + configFilePath + "'");
   
   std::filesystem::path libPath(libraryPath);
   std::filesystem::path configPath(configFilePath);
   
   // 1. If absolute path, try it directly
   if (libPath.is_absolute()) {
-    CLILogger::debug("loadDynLibFromConfig: Trying absolute path strategy");
+    LOG_DEBUG("loadDynLibFromConfig: Trying absolute path strategy");
     std::string platformPath = resolvePlatformDynLibName(libraryPath);
-    CLILogger::debug("loadDynLibFromConfig: Trying platform-resolved path: " + platformPath);
+    LOG_DEBUG("loadDynLibFromConfig: Trying platform-resolved path: " + platformPath);
     DynLib lib = loadDynLib(platformPath);
     if (lib.isValid()) {
-      CLILogger::debug("loadDynLibFromConfig: Successfully loaded library from platform path: " + platformPath);
+      LOG_DEBUG("loadDynLibFromConfig: Successfully loaded library from platform path: " + platformPath);
       return lib;
     }
-    CLILogger::debug("loadDynLibFromConfig: Platform path failed: " + getLastDynLibError());
+    LOG_DEBUG("loadDynLibFromConfig: Platform path failed: " + getLastDynLibError());
     
     // Also try original path in case it's already platform-specific
-    CLILogger::debug("loadDynLibFromConfig: Trying original absolute path: " + libraryPath);
+    LOG_DEBUG("loadDynLibFromConfig: Trying original absolute path: " + libraryPath);
     lib = loadDynLib(libraryPath);
     if (lib.isValid()) {
-      CLILogger::debug("loadDynLibFromConfig: Successfully loaded library from original path: " + libraryPath);
+      LOG_DEBUG("loadDynLibFromConfig: Successfully loaded library from original path: " + libraryPath);
       return lib;
     }
-    CLILogger::debug("loadDynLibFromConfig: Original absolute path failed: " + getLastDynLibError());
+    LOG_DEBUG("loadDynLibFromConfig: Original absolute path failed: " + getLastDynLibError());
   }
   
   // 2. Try relative to config file directory
   if (!configFilePath.empty() && !configPath.parent_path().empty()) {
-    CLILogger::debug("loadDynLibFromConfig: Trying relative to config file directory strategy");
+    LOG_DEBUG("loadDynLibFromConfig: Trying relative to config file directory strategy");
     std::filesystem::path relativePath = configPath.parent_path() / libPath;
     std::string platformPath = resolvePlatformDynLibName(relativePath.string());
-    CLILogger::debug("loadDynLibFromConfig: Trying config-relative platform path: " + platformPath);
+    LOG_DEBUG("loadDynLibFromConfig: Trying config-relative platform path: " + platformPath);
     DynLib lib = loadDynLib(platformPath);
     if (lib.isValid()) {
-      CLILogger::debug("loadDynLibFromConfig: Successfully loaded library from config-relative platform path: " + platformPath);
+      LOG_DEBUG("loadDynLibFromConfig: Successfully loaded library from config-relative platform path: " + platformPath);
       return lib;
     }
-    CLILogger::debug("loadDynLibFromConfig: Config-relative platform path failed: " + getLastDynLibError());
+    LOG_DEBUG("loadDynLibFromConfig: Config-relative platform path failed: " + getLastDynLibError());
     
     // Also try original path
-    CLILogger::debug("loadDynLibFromConfig: Trying config-relative original path: " + relativePath.string());
+    LOG_DEBUG("loadDynLibFromConfig: Trying config-relative original path: " + relativePath.string());
     lib = loadDynLib(relativePath.string());
     if (lib.isValid()) {
-      CLILogger::debug("loadDynLibFromConfig: Successfully loaded library from config-relative original path: " + relativePath.string());
+      LOG_DEBUG("loadDynLibFromConfig: Successfully loaded library from config-relative original path: " + relativePath.string());
       return lib;
     }
-    CLILogger::debug("loadDynLibFromConfig: Config-relative original path failed: " + getLastDynLibError());
+    LOG_DEBUG("loadDynLibFromConfig: Config-relative original path failed: " + getLastDynLibError());
   } else {
-    CLILogger::debug("loadDynLibFromConfig: Skipping config-relative strategy (empty config path or parent)");
+    LOG_DEBUG("loadDynLibFromConfig: Skipping config-relative strategy (empty config path or parent)");
   }
   
   // 3. Try relative to current working directory
-  CLILogger::debug("loadDynLibFromConfig: Trying current working directory strategy");
+  LOG_DEBUG("loadDynLibFromConfig: Trying current working directory strategy");
   std::string platformPath = resolvePlatformDynLibName(libraryPath);
-  CLILogger::debug("loadDynLibFromConfig: Trying CWD platform path: " + platformPath);
+  LOG_DEBUG("loadDynLibFromConfig: Trying CWD platform path: " + platformPath);
   DynLib lib = loadDynLib(platformPath);
   if (lib.isValid()) {
-    CLILogger::debug("loadDynLibFromConfig: Successfully loaded library from CWD platform path: " + platformPath);
+    LOG_DEBUG("loadDynLibFromConfig: Successfully loaded library from CWD platform path: " + platformPath);
     return lib;
   }
-  CLILogger::debug("loadDynLibFromConfig: CWD platform path failed: " + getLastDynLibError());
+  LOG_DEBUG("loadDynLibFromConfig: CWD platform path failed: " + getLastDynLibError());
   
-  CLILogger::debug("loadDynLibFromConfig: Trying CWD original path: " + libraryPath);
+  LOG_DEBUG("loadDynLibFromConfig: Trying CWD original path: " + libraryPath);
   lib = loadDynLib(libraryPath);
   if (lib.isValid()) {
-    CLILogger::debug("loadDynLibFromConfig: Successfully loaded library from CWD original path: " + libraryPath);
+    LOG_DEBUG("loadDynLibFromConfig: Successfully loaded library from CWD original path: " + libraryPath);
     return lib;
   }
-  CLILogger::debug("loadDynLibFromConfig: CWD original path failed: " + getLastDynLibError());
+  LOG_DEBUG("loadDynLibFromConfig: CWD original path failed: " + getLastDynLibError());
   
   // 4. Search using filename only in prioritized search paths
   std::string filename = libPath.filename().string();
-  CLILogger::debug("loadDynLibFromConfig: Trying filename-only search strategy with filename: " + filename);
+  LOG_DEBUG("loadDynLibFromConfig: Trying filename-only search strategy with filename: " + filename);
   
   // First try config file directory with filename only
   if (!configFilePath.empty() && !configPath.parent_path().empty()) {
-    CLILogger::debug("loadDynLibFromConfig: Searching in config directory: " + configPath.parent_path().string());
+    LOG_DEBUG("loadDynLibFromConfig: Searching in config directory: " + configPath.parent_path().string());
     std::string found = findDynLibFile(filename, configPath.parent_path().string());
     if (found != filename) { // Found something different
       std::filesystem::path fullPath = configPath.parent_path() / found;
-      CLILogger::debug("loadDynLibFromConfig: Found potential match in config dir: " + fullPath.string());
+      LOG_DEBUG("loadDynLibFromConfig: Found potential match in config dir: " + fullPath.string());
       lib = loadDynLib(fullPath.string());
       if (lib.isValid()) {
-        CLILogger::debug("loadDynLibFromConfig: Successfully loaded library from config dir search: " + fullPath.string());
+        LOG_DEBUG("loadDynLibFromConfig: Successfully loaded library from config dir search: " + fullPath.string());
         return lib;
       }
-      CLILogger::debug("loadDynLibFromConfig: Config dir match failed: " + getLastDynLibError());
+      LOG_DEBUG("loadDynLibFromConfig: Config dir match failed: " + getLastDynLibError());
     } else {
-      CLILogger::debug("loadDynLibFromConfig: No matches found in config directory");
+      LOG_DEBUG("loadDynLibFromConfig: No matches found in config directory");
     }
   } else {
-    CLILogger::debug("loadDynLibFromConfig: Skipping config directory search (empty config path)");
+    LOG_DEBUG("loadDynLibFromConfig: Skipping config directory search (empty config path)");
   }
   
   // Then search in system paths
   std::vector<std::string> searchPaths = getSystemSearchPaths();
-  CLILogger::debug("loadDynLibFromConfig: Searching in " + std::to_string(searchPaths.size()) + " system paths");
+  LOG_DEBUG("loadDynLibFromConfig: Searching in " + std::to_string(searchPaths.size()) + " system paths");
   for (const auto& searchDir : searchPaths) {
-    CLILogger::debug("loadDynLibFromConfig: Searching in system directory: " + searchDir);
+    LOG_DEBUG("loadDynLibFromConfig: Searching in system directory: " + searchDir);
     std::string found = findDynLibFile(filename, searchDir);
     if (found != filename) { // Found something different
       std::filesystem::path fullPath = std::filesystem::path(searchDir) / found;
-      CLILogger::debug("loadDynLibFromConfig: Found potential match in system dir: " + fullPath.string());
+      LOG_DEBUG("loadDynLibFromConfig: Found potential match in system dir: " + fullPath.string());
       lib = loadDynLib(fullPath.string());
       if (lib.isValid()) {
-        CLILogger::debug("loadDynLibFromConfig: Successfully loaded library from system dir search: " + fullPath.string());
+        LOG_DEBUG("loadDynLibFromConfig: Successfully loaded library from system dir search: " + fullPath.string());
         return lib;
       }
-      CLILogger::debug("loadDynLibFromConfig: System dir match failed: " + getLastDynLibError());
+      LOG_DEBUG("loadDynLibFromConfig: System dir match failed: " + getLastDynLibError());
     } else {
-      CLILogger::debug("loadDynLibFromConfig: No matches found in system directory: " + searchDir);
+      LOG_DEBUG("loadDynLibFromConfig: No matches found in system directory: " + searchDir);
     }
   }
   
   // 5. Final fallback: try using loadDynLibFromPaths for platform resolution
-  CLILogger::debug("loadDynLibFromConfig: Trying final fallback with loadDynLibFromPaths");
+  LOG_DEBUG("loadDynLibFromConfig: Trying final fallback with loadDynLibFromPaths");
   DynLib result = loadDynLibFromPaths(filename, searchPaths);
   
   if (!result.isValid()) {
     CLILogger::error("loadDynLibFromConfig: Failed to load library '" + libraryPath + "' after trying all strategies");
-    CLILogger::debug("loadDynLibFromConfig: All library loading strategies exhausted for: " + libraryPath);
+    LOG_DEBUG("loadDynLibFromConfig: All library loading strategies exhausted for: " + libraryPath);
   }
   
   return result;
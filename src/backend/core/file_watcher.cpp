@@ -0,0 +1,295 @@
+/**
+@brief Filesystem change notification implementation
+*/
+#include <backend/core/file_watcher.h>
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <unordered_map>
+
+#if defined(__linux__)
+  #include <poll.h>
+  #include <sys/inotify.h>
+  #include <unistd.h>
+#elif defined(_WIN32)
+  #include <backend/core/win32.h>
+#endif
+
+namespace {
+  // A burst of events is cut off after this long even if events keep arriving (e.g. during a checkout)
+  constexpr std::chrono::milliseconds kMaxBurst(1000);
+
+#if defined(__linux__) || defined(_WIN32)
+  std::string joinPath(const std::string& dir, const std::string& name) {
+    if (dir.empty()) return name;
+    char last = dir.back();
+    if (last == '/' || last == '\\') return dir + name;
+    #ifdef _WIN32
+      return dir + "\\" + name;
+    #else
+      return dir + "/" + name;
+    #endif
+  }
+#endif
+
+#if defined(__linux__)
+  constexpr uint32_t kWatchMask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+#elif defined(_WIN32)
+  constexpr DWORD kNotifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+                                  FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+#else
+  constexpr std::chrono::milliseconds kPollInterval(250);
+#endif
+}
+
+#if defined(_WIN32)
+struct FileWatcher::WatchedRoot {
+  std::string path;
+  HANDLE directory = INVALID_HANDLE_VALUE;
+  OVERLAPPED overlapped = {};
+  std::vector<DWORD> buffer = std::vector<DWORD>(16 * 1024);  // 64 KiB; must be DWORD-aligned
+
+  bool issue() {
+    return ReadDirectoryChangesW(directory, buffer.data(), static_cast<DWORD>(buffer.size() * sizeof(DWORD)),
+                                 TRUE, kNotifyFilter, nullptr, &overlapped, nullptr) != 0;
+  }
+
+  ~WatchedRoot() {
+    if (directory != INVALID_HANDLE_VALUE) {
+      // The pending read writes into buffer, so wait for the cancellation before freeing it
+      DWORD bytes = 0;
+      CancelIoEx(directory, &overlapped);
+      GetOverlappedResult(directory, &overlapped, &bytes, TRUE);
+      CloseHandle(directory);
+    }
+    if (overlapped.hEvent) {
+      CloseHandle(overlapped.hEvent);
+    }
+  }
+};
+#endif
+
+FileWatcher::FileWatcher() {
+  #if defined(__linux__)
+    inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  #endif
+}
+
+FileWatcher::~FileWatcher() {
+  #if defined(__linux__)
+    if (inotify_fd_ >= 0) {
+      ::close(inotify_fd_);
+    }
+  #endif
+}
+
+const char* FileWatcher::backendName() {
+  #if defined(__linux__)
+    return "inotify";
+  #elif defined(_WIN32)
+    return "ReadDirectoryChangesW";
+  #else
+    return "polling";
+  #endif
+}
+
+void FileWatcher::report(std::string path, bool is_directory, Changes& changes) const {
+  if (exclude_ && (is_directory ? exclude_->matchesDirectory(path) : exclude_->matchesFile(path))) {
+    return;
+  }
+  changes.paths.push_back(std::move(path));
+}
+
+FileWatcher::Changes FileWatcher::wait(std::chrono::milliseconds timeout, std::chrono::milliseconds settle) {
+  Changes changes;
+  if (collect(timeout, changes)) {
+    auto burst_end = std::chrono::steady_clock::now() + kMaxBurst;
+    while (std::chrono::steady_clock::now() < burst_end && collect(settle, changes)) {
+    }
+  }
+  std::sort(changes.paths.begin(), changes.paths.end());
+  changes.paths.erase(std::unique(changes.paths.begin(), changes.paths.end()), changes.paths.end());
+  return changes;
+}
+
+#if defined(__linux__)
+
+bool FileWatcher::addRoot(const std::string& path) {
+  return inotify_fd_ >= 0 && watchTree(path, nullptr);
+}
+
+bool FileWatcher::watchTree(const std::string& path, Changes* changes) {
+  int wd = ::inotify_add_watch(inotify_fd_, path.c_str(), kWatchMask);
+  if (wd < 0) {
+    return false;
+  }
+  watched_dirs_[wd] = path;
+
+  // Watch is in place before the listing, so nothing created meanwhile is missed
+  FsSnapshot tree = FsScanner().scan({ScanRoot{path, true, exclude_}});
+  for (const auto& entry : tree.entries(0)) {
+    if (entry.type == FsEntryType::Directory) {
+      int child_wd = ::inotify_add_watch(inotify_fd_, entry.path.c_str(), kWatchMask);
+      if (child_wd >= 0) {
+        watched_dirs_[child_wd] = entry.path;
+      }
+    } else if (changes && entry.type == FsEntryType::File) {
+      report(entry.path, false, *changes);
+    }
+  }
+  return true;
+}
+
+bool FileWatcher::collect(std::chrono::milliseconds timeout, Changes& changes) {
+  if (inotify_fd_ < 0) {
+    std::this_thread::sleep_for(timeout);
+    return false;
+  }
+  pollfd descriptor{inotify_fd_, POLLIN, 0};
+  if (::poll(&descriptor, 1, static_cast<int>(timeout.count())) <= 0) {
+    return false;
+  }
+
+  alignas(inotify_event) char buffer[64 * 1024];
+  bool any = false;
+  for (;;) {
+    ssize_t length = ::read(inotify_fd_, buffer, sizeof(buffer));
+    if (length <= 0) break;  // Drained (EAGAIN)
+    any = true;
+    for (char* cursor = buffer; cursor < buffer + length;) {
+      const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+      cursor += sizeof(inotify_event) + event->len;
+      if (event->mask & IN_Q_OVERFLOW) {
+        changes.overflow = true;
+        continue;
+      }
+      auto dir = watched_dirs_.find(event->wd);
+      if (dir == watched_dirs_.end()) continue;
+      if (event->mask & IN_IGNORED) {
+        watched_dirs_.erase(dir);
+        continue;
+      }
+      if (event->len == 0) continue;
+
+      std::string path = joinPath(dir->second, event->name);
+      bool is_directory = (event->mask & IN_ISDIR) != 0;
+      bool excluded = exclude_ && is_directory && exclude_->matchesDirectory(path);
+      if (is_directory && !excluded && (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+        // A new or moved-in directory needs its own watches, and brings its files with it
+        watchTree(path, &changes);
+      }
+      report(std::move(path), is_directory, changes);
+    }
+  }
+  return any;
+}
+
+#elif defined(_WIN32)
+
+bool FileWatcher::addRoot(const std::string& path) {
+  auto root = std::make_unique<WatchedRoot>();
+  root->path = path;
+  root->directory = CreateFileW(std::filesystem::path(path).wstring().c_str(), FILE_LIST_DIRECTORY,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+  if (root->directory == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  root->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+  if (!root->overlapped.hEvent || !root->issue()) {
+    return false;
+  }
+  roots_.push_back(std::move(root));
+  return true;
+}
+
+bool FileWatcher::collect(std::chrono::milliseconds timeout, Changes& changes) {
+  std::vector<HANDLE> events;
+  for (const auto& root : roots_) {
+    events.push_back(root->overlapped.hEvent);
+  }
+  if (events.empty()) {
+    std::this_thread::sleep_for(timeout);
+    return false;
+  }
+  DWORD result = WaitForMultipleObjects(static_cast<DWORD>(events.size()), events.data(), FALSE,
+                                        static_cast<DWORD>(timeout.count()));
+  if (result < WAIT_OBJECT_0 || result >= WAIT_OBJECT_0 + events.size()) {
+    return false;
+  }
+
+  // Drain every root whose read completed, not only the one that woke us
+  bool any = false;
+  for (const auto& root : roots_) {
+    DWORD bytes = 0;
+    if (!GetOverlappedResult(root->directory, &root->overlapped, &bytes, FALSE)) continue;
+    any = true;
+    if (bytes == 0) {
+      // The buffer overflowed and the events were dropped
+      changes.overflow = true;
+    } else {
+      const char* cursor = reinterpret_cast<const char*>(root->buffer.data());
+      for (;;) {
+        const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(cursor);
+        std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+        std::string path = joinPath(root->path, std::filesystem::path(name).string());
+        std::error_code ec;
+        report(path, std::filesystem::is_directory(path, ec), changes);
+        if (info->NextEntryOffset == 0) break;
+        cursor += info->NextEntryOffset;
+      }
+    }
+    ResetEvent(root->overlapped.hEvent);
+    root->issue();
+  }
+  return any;
+}
+
+#else
+
+bool FileWatcher::addRoot(const std::string& path) {
+  std::error_code ec;
+  if (!std::filesystem::is_directory(path, ec)) {
+    return false;
+  }
+  poll_roots_.push_back(ScanRoot{path, true, exclude_});
+  polled_ = FsScanner().scan(poll_roots_);
+  return true;
+}
+
+bool FileWatcher::collect(std::chrono::milliseconds timeout, Changes& changes) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  for (;;) {
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    std::this_thread::sleep_for(std::max(std::chrono::milliseconds(0), std::min(remaining, kPollInterval)));
+
+    FsSnapshot current = FsScanner().scan(poll_roots_);
+    bool any = false;
+    for (size_t root = 0; root < current.rootCount() && root < polled_.rootCount(); ++root) {
+      std::unordered_map<std::string_view, const FsEntry*> previous;
+      for (const auto& entry : polled_.entries(root)) {
+        previous.emplace(entry.path, &entry);
+      }
+      for (const auto& entry : current.entries(root)) {
+        auto seen = previous.find(entry.path);
+        bool changed = seen == previous.end() ||
+                       (entry.type == FsEntryType::File &&
+                        (seen->second->mtime_ticks != entry.mtime_ticks || seen->second->size != entry.size));
+        if (seen != previous.end()) previous.erase(seen);
+        if (changed) {
+          report(entry.path, entry.type == FsEntryType::Directory, changes);
+          any = true;
+        }
+      }
+      for (const auto& [path, entry] : previous) {
+        report(std::string(path), entry->type == FsEntryType::Directory, changes);
+        any = true;
+      }
+    }
+    polled_ = std::move(current);
+    if (any) return true;
+    if (std::chrono::steady_clock::now() >= deadline) return false;
+  }
+}
+
+#endif
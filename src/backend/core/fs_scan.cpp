@@ -0,0 +1,360 @@
+/**
+@brief Directory scanning implementation
+*/
+#include <backend/core/fs_scan.h>
+#include <backend/core/parallel.h>
+#include <chrono>
+#include <filesystem>
+
+#ifdef _WIN32
+  #include <backend/core/win32.h>
+#else
+  #include <dirent.h>
+  #include <fcntl.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+  constexpr char kSeparator = '\\';
+#else
+  constexpr char kSeparator = '/';
+#endif
+
+  // What one root's walk produces, moved into the snapshot afterwards
+  struct WalkResult {
+    std::vector<FsEntry> entries;
+    std::vector<std::string> keys;           // Normalized path of each entry
+    std::vector<std::string> excluded;       // Excluded paths as walked
+    std::vector<std::string> opaque_keys;    // Excluded, symlinked or unreadable: contents unknown
+  };
+
+  std::string joinPath(const std::string& dir, std::string_view name) {
+    std::string path;
+    path.reserve(dir.size() + name.size() + 1);
+    path = dir;
+    if (!path.empty() && path.back() != '/' && path.back() != kSeparator) path += kSeparator;
+    path += name;
+    return path;
+  }
+
+  std::string joinKey(const std::string& dir_key, std::string_view name) {
+    if (dir_key.empty()) return std::string(name);
+    std::string key = dir_key;
+    if (key.back() != '/') key += '/';
+    key += name;
+    return key;
+  }
+
+  std::string_view parentKey(std::string_view key) {
+    size_t slash = key.rfind('/');
+    if (slash == std::string_view::npos) return {};
+    if (slash == 0) return key.substr(0, 1);
+    return key.substr(0, slash);
+  }
+
+  // Convert a time since the Unix epoch to the ticks std::filesystem::last_write_time reports
+  template<typename Duration>
+  int64_t fileTimeTicks(Duration since_epoch) {
+    std::chrono::sys_time<Duration> sys_time{since_epoch};
+    auto file_time = std::chrono::file_clock::from_sys(sys_time);
+    return std::chrono::duration_cast<std::filesystem::file_time_type::duration>(file_time.time_since_epoch()).count();
+  }
+
+  bool isExcluded(const ScanRoot& root, const FsEntry& entry) {
+    if (!root.exclude) return false;
+    return entry.type == FsEntryType::Directory ? root.exclude->matchesDirectory(entry.path)
+                                               : root.exclude->matchesFile(entry.path);
+  }
+
+  // Record an entry; returns false if it was excluded instead
+  bool addEntry(const ScanRoot& root, FsEntry&& entry, std::string&& key, WalkResult& out) {
+    if (isExcluded(root, entry)) {
+      out.excluded.push_back(std::move(entry.path));
+      out.opaque_keys.push_back(std::move(key));
+      return false;
+    }
+    out.entries.push_back(std::move(entry));
+    out.keys.push_back(std::move(key));
+    return true;
+  }
+
+#ifdef _WIN32
+  int64_t fileTimeTicks(const FILETIME& file_time) {
+    // FILETIME counts 100 ns intervals since 1601-01-01
+    typedef std::chrono::duration<int64_t, std::ratio<1, 10000000>> FileTimeDuration;
+    int64_t ticks = (static_cast<int64_t>(file_time.dwHighDateTime) << 32) | file_time.dwLowDateTime;
+    return fileTimeTicks(FileTimeDuration(ticks - 116444736000000000LL));
+  }
+
+  void fillFromFilesystem(FsEntry& entry) {
+    std::error_code ec;
+    auto status = std::filesystem::status(entry.path, ec);
+    entry.type = std::filesystem::is_directory(status) ? FsEntryType::Directory
+               : std::filesystem::is_regular_file(status) ? FsEntryType::File : FsEntryType::Other;
+    if (entry.type == FsEntryType::File) {
+      entry.mtime_ticks = static_cast<int64_t>(std::filesystem::last_write_time(entry.path, ec).time_since_epoch().count());
+      entry.size = static_cast<uint64_t>(std::filesystem::file_size(entry.path, ec));
+    }
+  }
+
+  void walkDirectory(const std::string& dir_path, const std::string& dir_key, uint32_t depth,
+                     const ScanRoot& root, WalkResult& out) {
+    std::wstring pattern = (std::filesystem::path(dir_path) / "*").wstring();
+    WIN32_FIND_DATAW data;
+    HANDLE find = FindFirstFileExW(pattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch,
+                                   nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (find == INVALID_HANDLE_VALUE) {
+      out.opaque_keys.push_back(dir_key);
+      return;
+    }
+    do {
+      const wchar_t* wide_name = data.cFileName;
+      if (wide_name[0] == L'.' && (wide_name[1] == 0 || (wide_name[1] == L'.' && wide_name[2] == 0))) continue;
+      std::string name = std::filesystem::path(wide_name).string();
+
+      FsEntry entry;
+      entry.path = joinPath(dir_path, name);
+      entry.depth = depth;
+      bool is_link = (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+      if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+        entry.type = FsEntryType::Directory;
+      } else if (is_link) {
+        // The listing describes the link, not its target
+        fillFromFilesystem(entry);
+      } else {
+        entry.type = FsEntryType::File;
+        entry.size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+        entry.mtime_ticks = fileTimeTicks(data.ftLastWriteTime);
+      }
+
+      std::string key = joinKey(dir_key, name);
+      bool descend = entry.type == FsEntryType::Directory && root.recursive;
+      std::string child_path = descend ? entry.path : std::string();
+      std::string child_key = descend ? key : std::string();
+      if (!addEntry(root, std::move(entry), std::move(key), out) || !descend) continue;
+      if (is_link) {
+        out.opaque_keys.push_back(std::move(child_key));
+        continue;
+      }
+      walkDirectory(child_path, child_key, depth + 1, root, out);
+    } while (FindNextFileW(find, &data));
+    FindClose(find);
+  }
+#else
+  void fillFromStat(FsEntry& entry, const struct stat& st) {
+    entry.type = S_ISDIR(st.st_mode) ? FsEntryType::Directory
+               : S_ISREG(st.st_mode) ? FsEntryType::File : FsEntryType::Other;
+    if (entry.type == FsEntryType::File) {
+      #ifdef __APPLE__
+        const struct timespec& mtime = st.st_mtimespec;
+      #else
+        const struct timespec& mtime = st.st_mtim;
+      #endif
+      entry.mtime_ticks = fileTimeTicks(std::chrono::seconds(mtime.tv_sec) + std::chrono::nanoseconds(mtime.tv_nsec));
+      entry.size = static_cast<uint64_t>(st.st_size);
+      entry.inode = static_cast<uint64_t>(st.st_ino);
+    }
+  }
+
+  void fillFromFilesystem(FsEntry& entry) {
+    struct stat st;
+    if (::stat(entry.path.c_str(), &st) == 0) {
+      fillFromStat(entry, st);
+    } else {
+      entry.type = FsEntryType::Other;
+    }
+  }
+
+  void walkDirectory(DIR* dir, const std::string& dir_path, const std::string& dir_key, uint32_t depth,
+                     const ScanRoot& root, WalkResult& out) {
+    int dir_fd = ::dirfd(dir);
+    while (dirent* dirent_entry = ::readdir(dir)) {
+      const char* name = dirent_entry->d_name;
+      if (name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0))) continue;
+
+      FsEntry entry;
+      entry.path = joinPath(dir_path, name);
+      entry.depth = depth;
+
+      // Directories are known from d_type alone; files need their stat data anyway
+      struct stat st;
+      bool is_link = dirent_entry->d_type == DT_LNK;
+      bool is_dir = dirent_entry->d_type == DT_DIR;
+      bool have_stat = false;
+      if (dirent_entry->d_type == DT_UNKNOWN) {
+        if (::fstatat(dir_fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) continue;
+        is_link = S_ISLNK(st.st_mode);
+        is_dir = S_ISDIR(st.st_mode);
+        have_stat = !is_link;
+      }
+      if (is_dir) {
+        entry.type = FsEntryType::Directory;
+      } else {
+        // Symlinks are followed, like std::filesystem::is_regular_file; dangling ones are skipped
+        if (!have_stat && ::fstatat(dir_fd, name, &st, 0) != 0) continue;
+        fillFromStat(entry, st);
+      }
+
+      std::string key = joinKey(dir_key, name);
+      bool descend = entry.type == FsEntryType::Directory && root.recursive;
+      std::string child_path = descend ? entry.path : std::string();
+      std::string child_key = descend ? key : std::string();
+      if (!addEntry(root, std::move(entry), std::move(key), out) || !descend) continue;
+
+      // Symlinked directories are not followed (as with recursive_directory_iterator)
+      int child_fd = is_link ? -1 : ::openat(dir_fd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      DIR* child = child_fd >= 0 ? ::fdopendir(child_fd) : nullptr;
+      if (!child) {
+        if (child_fd >= 0) ::close(child_fd);
+        out.opaque_keys.push_back(std::move(child_key));
+        continue;
+      }
+      walkDirectory(child, child_path, child_key, depth + 1, root, out);
+      ::closedir(child);
+    }
+  }
+#endif
+
+  FsSnapshot::RootStatus walkRoot(const ScanRoot& root, const std::string& key, WalkResult& out) {
+    std::error_code ec;
+    auto status = std::filesystem::status(root.path, ec);
+    if (status.type() == std::filesystem::file_type::not_found) {
+      return FsSnapshot::RootStatus::Missing;
+    }
+    if (ec) {
+      return FsSnapshot::RootStatus::Failed;
+    }
+
+    if (!std::filesystem::is_directory(status)) {
+      // A single file lists itself
+      FsEntry entry;
+      entry.path = root.path;
+      entry.depth = 0;
+      fillFromFilesystem(entry);
+      out.entries.push_back(std::move(entry));
+      out.keys.push_back(key);
+      return FsSnapshot::RootStatus::Scanned;
+    }
+
+    #ifdef _WIN32
+      walkDirectory(root.path, key, 1, root, out);
+      if (!out.opaque_keys.empty() && out.opaque_keys.back() == key) {
+        return FsSnapshot::RootStatus::Failed;
+      }
+    #else
+      DIR* dir = ::opendir(root.path.c_str());
+      if (!dir) {
+        return FsSnapshot::RootStatus::Failed;
+      }
+      walkDirectory(dir, root.path, key, 1, root, out);
+      ::closedir(dir);
+    #endif
+    return FsSnapshot::RootStatus::Scanned;
+  }
+}
+
+std::string FsSnapshot::normalize(std::string_view path) {
+  std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+  while (normalized.size() > 1 && normalized.back() == '/') {
+    normalized.pop_back();
+  }
+  if (normalized == ".") {
+    normalized.clear();
+  }
+  return normalized;
+}
+
+std::optional<const FsEntry*> FsSnapshot::lookup(std::string_view path) const {
+  std::string key = normalize(path);
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    return &roots_[found->second.first].entries[found->second.second];
+  }
+
+  // Absent from the index: known missing only if a root that lists this depth encloses it
+  std::string_view current = key;
+  for (uint32_t depth = 0;; ++depth) {
+    if (opaque_.find(std::string(current)) != opaque_.end()) {
+      return std::nullopt;
+    }
+    for (const auto& root : roots_) {
+      if (root.key != current) continue;
+      if (root.status == RootStatus::Missing) return nullptr;
+      if (root.status == RootStatus::Scanned && depth > 0 && (root.root.recursive || depth == 1)) return nullptr;
+    }
+    if (current.empty() || current == "/") {
+      return std::nullopt;
+    }
+    current = parentKey(current);
+  }
+}
+
+std::optional<std::vector<FsEntry>> FsSnapshot::listDirectory(std::string_view path) const {
+  std::string key = normalize(path);
+  for (const auto& root : roots_) {
+    if (root.key != key || root.status == RootStatus::Failed) continue;
+    std::vector<FsEntry> children;
+    for (const auto& entry : root.entries) {
+      if (entry.depth == 1) children.push_back(entry);
+    }
+    return children;
+  }
+  return std::nullopt;
+}
+
+void FsSnapshot::indexRoot(size_t root_index) {
+  const RootData& root = roots_[root_index];
+  for (size_t i = 0; i < root.entries.size(); ++i) {
+    index_[root.keys[i]] = {root_index, i};
+  }
+  opaque_.insert(root.opaque_keys.begin(), root.opaque_keys.end());
+}
+
+void FsSnapshot::unindexRoot(size_t root_index) {
+  const RootData& root = roots_[root_index];
+  for (size_t i = 0; i < root.keys.size(); ++i) {
+    auto found = index_.find(root.keys[i]);
+    if (found != index_.end() && found->second.first == root_index) {
+      index_.erase(found);
+    }
+  }
+  for (const auto& key : root.opaque_keys) {
+    opaque_.erase(key);
+  }
+}
+
+FsSnapshot FsScanner::scan(const std::vector<ScanRoot>& roots) const {
+  FsSnapshot snapshot;
+  snapshot.roots_.resize(roots.size());
+  for (size_t i = 0; i < roots.size(); ++i) {
+    snapshot.roots_[i].root = roots[i];
+    snapshot.roots_[i].key = FsSnapshot::normalize(roots[i].path);
+  }
+
+  size_t workers = parallel::resolveJobCount(parallelism_, roots.size());
+  parallel::forEachIndex(roots.size(), workers, [&](size_t, size_t index) {
+    scanRoot(snapshot.roots_[index]);
+  });
+
+  for (size_t i = 0; i < roots.size(); ++i) {
+    snapshot.indexRoot(i);
+  }
+  return snapshot;
+}
+
+void FsScanner::rescan(FsSnapshot& snapshot, size_t root_index) const {
+  snapshot.unindexRoot(root_index);
+  scanRoot(snapshot.roots_[root_index]);
+  snapshot.indexRoot(root_index);
+}
+
+void FsScanner::scanRoot(FsSnapshot::RootData& root) {
+  WalkResult result;
+  root.status = walkRoot(root.root, root.key, result);
+  root.entries = std::move(result.entries);
+  root.keys = std::move(result.keys);
+  root.excluded = std::move(result.excluded);
+  root.opaque_keys = std::move(result.opaque_keys);
+}
@@ -0,0 +1,177 @@
+/**
+@brief Compiled glob pattern matching implementation
+*/
+#include <backend/core/glob.h>
+
+namespace {
+#ifdef _WIN32
+  constexpr std::string_view kSeparators = "/\\";
+#else
+  constexpr std::string_view kSeparators = "/";
+#endif
+
+  std::vector<std::string_view> splitPath(std::string_view path) {
+    std::vector<std::string_view> segments;
+    size_t start = 0;
+    while (start <= path.size()) {
+      size_t end = path.find_first_of(kSeparators, start);
+      if (end == std::string_view::npos) end = path.size();
+      std::string_view segment = path.substr(start, end - start);
+      if (!segment.empty() && segment != ".") {
+        segments.push_back(segment);
+      }
+      start = end + 1;
+    }
+    return segments;
+  }
+
+  // Match one character against the class opening at pattern[open];
+  // returns the index past the closing ']' or npos if '[' does not open a class
+  size_t matchClass(std::string_view pattern, size_t open, char c, bool& matched) {
+    size_t i = open + 1;
+    bool negate = i < pattern.size() && (pattern[i] == '!' || pattern[i] == '^');
+    if (negate) ++i;
+    size_t first = i;
+    bool found = false;
+    // A ']' right after the opening bracket is a member, not the end
+    while (i < pattern.size() && (pattern[i] != ']' || i == first)) {
+      char low = pattern[i];
+      if (i + 2 < pattern.size() && pattern[i + 1] == '-' && pattern[i + 2] != ']') {
+        found = found || (low <= c && c <= pattern[i + 2]);
+        i += 3;
+      } else {
+        found = found || c == low;
+        ++i;
+      }
+    }
+    if (i >= pattern.size()) return std::string_view::npos;
+    matched = found != negate;
+    return i + 1;
+  }
+
+  // Single-segment wildcard match; backtracks to the last '*' only, so it is linear in practice
+  bool matchWildcard(std::string_view pattern, std::string_view text) {
+    size_t p = 0, t = 0;
+    size_t star = std::string_view::npos, star_text = 0;
+    while (t < text.size()) {
+      if (p < pattern.size()) {
+        char pc = pattern[p];
+        if (pc == '*') {
+          star = p++;
+          star_text = t;
+          continue;
+        }
+        if (pc == '?') {
+          ++p;
+          ++t;
+          continue;
+        }
+        if (pc == '[') {
+          bool matched = false;
+          size_t next = matchClass(pattern, p, text[t], matched);
+          if (next != std::string_view::npos ? matched : text[t] == '[') {
+            p = next != std::string_view::npos ? next : p + 1;
+            ++t;
+            continue;
+          }
+        } else if (pc == text[t]) {
+          ++p;
+          ++t;
+          continue;
+        }
+      }
+      if (star == std::string_view::npos) return false;
+      p = star + 1;
+      t = ++star_text;
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+  }
+}
+
+bool GlobMatcher::add(std::string_view pattern) {
+  Pattern compiled;
+  while (!pattern.empty() && kSeparators.find(pattern.back()) != std::string_view::npos) {
+    compiled.directory_only = true;
+    pattern.remove_suffix(1);
+  }
+  std::vector<std::string_view> parts = splitPath(pattern);
+  if (parts.empty()) return false;
+
+  // Without a separator the pattern matches a name at any depth
+  if (pattern.find_first_of(kSeparators) == std::string_view::npos) {
+    compiled.segments.push_back({Segment::Kind::AnyDepth, {}});
+  }
+  for (std::string_view part : parts) {
+    Segment segment;
+    if (part == "**") {
+      if (!compiled.segments.empty() && compiled.segments.back().kind == Segment::Kind::AnyDepth) continue;
+      segment.kind = Segment::Kind::AnyDepth;
+    } else if (part == "*") {
+      segment.kind = Segment::Kind::AnyName;
+    } else {
+      segment.kind = part.find_first_of("*?[") != std::string_view::npos ? Segment::Kind::Wildcard
+                                                                         : Segment::Kind::Literal;
+      segment.text = std::string(part);
+    }
+    compiled.segments.push_back(std::move(segment));
+  }
+  patterns_.push_back(std::move(compiled));
+  return true;
+}
+
+size_t GlobMatcher::add(const std::vector<std::string>& patterns) {
+  size_t added = 0;
+  for (const auto& pattern : patterns) {
+    if (add(std::string_view(pattern))) ++added;
+  }
+  return added;
+}
+
+bool GlobMatcher::matchesFile(std::string_view path) const {
+  if (patterns_.empty()) return false;
+  std::vector<std::string_view> segments = splitPath(path);
+  for (const auto& pattern : patterns_) {
+    if (!pattern.directory_only && matchSegments(pattern, 0, segments, 0, false)) return true;
+  }
+  return false;
+}
+
+bool GlobMatcher::matchesDirectory(std::string_view path) const {
+  if (patterns_.empty()) return false;
+  std::vector<std::string_view> segments = splitPath(path);
+  for (const auto& pattern : patterns_) {
+    if (matchSegments(pattern, 0, segments, 0, true)) return true;
+  }
+  return false;
+}
+
+bool GlobMatcher::matchSegments(const Pattern& pattern, size_t pattern_index,
+                                const std::vector<std::string_view>& path, size_t path_index,
+                                bool directory) {
+  const auto& segments = pattern.segments;
+  while (pattern_index < segments.size()) {
+    const Segment& segment = segments[pattern_index];
+    if (segment.kind == Segment::Kind::AnyDepth) {
+      // A trailing ** covers everything below the prefix: the whole subtree of a
+      // directory, but a file only if it is at least one level down
+      if (pattern_index + 1 == segments.size()) {
+        return directory || path_index < path.size();
+      }
+      for (size_t next = path_index; next <= path.size(); ++next) {
+        if (matchSegments(pattern, pattern_index + 1, path, next, directory)) return true;
+      }
+      return false;
+    }
+    if (path_index == path.size()) return false;
+
+    std::string_view name = path[path_index];
+    bool matched = segment.kind == Segment::Kind::AnyName ||
+                   (segment.kind == Segment::Kind::Literal && name == segment.text) ||
+                   (segment.kind == Segment::Kind::Wildcard && matchWildcard(segment.text, name));
+    if (!matched) return false;
+    ++pattern_index;
+    ++path_index;
+  }
+  return path_index == path.size();
+}
@@ -0,0 +1,175 @@
+/**
+@brief Streaming content hashing implementation
+*/
+#include <backend/core/hash.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace hashing {
+
+namespace {
+  constexpr uint64_t kPrime1 = 11400714785074694791ULL;
+  constexpr uint64_t kPrime2 = 14029467366897019727ULL;
+  constexpr uint64_t kPrime3 = 1609587929392839161ULL;
+  constexpr uint64_t kPrime4 = 9650029242287828579ULL;
+  constexpr uint64_t kPrime5 = 2870177450012600261ULL;
+
+  constexpr size_t kFileChunkSize = 64 * 1024;  // Read size for hashFile
+  constexpr const char* kDigestPrefix = "xxh64:";
+
+  inline uint64_t rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  // Little-endian loads independent of host byte order
+  inline uint64_t read64(const unsigned char* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) value = (value << 8) | p[i];
+    return value;
+  }
+
+  inline uint32_t read32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  inline uint64_t round(uint64_t acc, uint64_t input) {
+    acc += input * kPrime2;
+    acc = rotl(acc, 31);
+    return acc * kPrime1;
+  }
+
+  inline uint64_t mergeRound(uint64_t acc, uint64_t value) {
+    acc ^= round(0, value);
+    return acc * kPrime1 + kPrime4;
+  }
+}
+
+XXH64::XXH64(uint64_t seed) : seed_(seed) {
+  acc_[0] = seed + kPrime1 + kPrime2;
+  acc_[1] = seed + kPrime2;
+  acc_[2] = seed;
+  acc_[3] = seed - kPrime1;
+}
+
+void XXH64::update(const void* data, size_t length) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  total_length_ += length;
+
+  // Top up a partially filled stripe first
+  if (buffered_ > 0) {
+    size_t take = std::min(length, sizeof(buffer_) - buffered_);
+    std::memcpy(buffer_ + buffered_, p, take);
+    buffered_ += take;
+    p += take;
+    length -= take;
+    if (buffered_ < sizeof(buffer_)) return;
+
+    for (int lane = 0; lane < 4; ++lane) {
+      acc_[lane] = round(acc_[lane], read64(buffer_ + lane * 8));
+    }
+    buffered_ = 0;
+  }
+
+  // Whole stripes straight from the input
+  while (length >= 32) {
+    for (int lane = 0; lane < 4; ++lane) {
+      acc_[lane] = round(acc_[lane], read64(p + lane * 8));
+    }
+    p += 32;
+    length -= 32;
+  }
+
+  if (length > 0) {
+    std::memcpy(buffer_, p, length);
+    buffered_ = length;
+  }
+}
+
+uint64_t XXH64::digest() const {
+  uint64_t h;
+  if (total_length_ >= 32) {
+    h = rotl(acc_[0], 1) + rotl(acc_[1], 7) + rotl(acc_[2], 12) + rotl(acc_[3], 18);
+    for (int lane = 0; lane < 4; ++lane) {
+      h = mergeRound(h, acc_[lane]);
+    }
+  } else {
+    h = seed_ + kPrime5;
+  }
+  h += total_length_;
+
+  const unsigned char* p = buffer_;
+  size_t remaining = buffered_;
+  while (remaining >= 8) {
+    h ^= round(0, read64(p));
+    h = rotl(h, 27) * kPrime1 + kPrime4;
+    p += 8;
+    remaining -= 8;
+  }
+  if (remaining >= 4) {
+    h ^= static_cast<uint64_t>(read32(p)) * kPrime1;
+    h = rotl(h, 23) * kPrime2 + kPrime3;
+    p += 4;
+    remaining -= 4;
+  }
+  while (remaining > 0) {
+    h ^= (*p) * kPrime5;
+    h = rotl(h, 11) * kPrime1;
+    ++p;
+    --remaining;
+  }
+
+  // Final avalanche
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= kPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+uint64_t xxh64(std::string_view data, uint64_t seed) {
+  XXH64 hasher(seed);
+  hasher.update(data);
+  return hasher.digest();
+}
+
+std::string toHex(uint64_t digest) {
+  static const char digits[] = "0123456789abcdef";
+  std::string hex(16, '0');
+  for (int i = 15; i >= 0; --i) {
+    hex[i] = digits[digest & 0xF];
+    digest >>= 4;
+  }
+  return hex;
+}
+
+std::optional<std::string> hashFile(const std::string& file_path) {
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+
+  XXH64 hasher;
+  std::vector<char> chunk(kFileChunkSize);
+  while (file) {
+    file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    std::streamsize got = file.gcount();
+    if (got > 0) {
+      hasher.update(chunk.data(), static_cast<size_t>(got));
+    }
+  }
+  if (file.bad()) {
+    return std::nullopt;
+  }
+
+  return std::string(kDigestPrefix) + toHex(hasher.digest());
+}
+
+std::string hashString(std::string_view data) {
+  return std::string(kDigestPrefix) + toHex(xxh64(data));
+}
+
+}
@@ -3,12 +3,11 @@
 */
 #include <backend/core/json.h>
 #include <backend/core/cli_utils.h>
+#include <cstdlib>
 #include <iostream>
 #include <filesystem>
 
 // JsonValue implementations
-JsonValue::JsonValue(yyjson_val* val) : val_(val) {}
-
 bool JsonValue::isNull() const { return !val_ || yyjson_is_null(val_); }
 bool JsonValue::isString() const { return val_ && yyjson_is_str(val_); }
 bool JsonValue::isInt() const { return val_ && yyjson_is_int(val_); }
@@ -25,6 +24,16 @@ int JsonValue::asInt(int default_val) const {
   return isInt() ? yyjson_get_int(val_) : default_val;
 }
 
+int64_t JsonValue::asInt64(int64_t default_val) const {
+  if (!isInt()) return default_val;
+  return yyjson_is_uint(val_) ? static_cast<int64_t>(yyjson_get_uint(val_)) : yyjson_get_sint(val_);
+}
+
+uint64_t JsonValue::asUint64(uint64_t default_val) const {
+  if (!isInt()) return default_val;
+  return yyjson_is_uint(val_) ? yyjson_get_uint(val_) : static_cast<uint64_t>(yyjson_get_sint(val_));
+}
+
 double JsonValue::asDouble(double default_val) const {
   return isDouble() ? yyjson_get_real(val_) : default_val;
 }
@@ -230,7 +239,7 @@ JsonDoc& JsonDoc::operator=(JsonDoc&& other) noexcept {
 }
 
 std::optional<JsonDoc> JsonDoc::fromFile(const std::string& path) {
-  CLILogger::debug("JsonDoc::fromFile: Attempting to load JSON file: " + path);
+  LOG_DEBUG("JsonDoc::fromFile: Attempting to load JSON file: " + path);
   
   // Check if file exists first
   if (!std::filesystem::exists(path)) {
@@ -245,7 +254,7 @@ std::optional<JsonDoc> JsonDoc::fromFile(const std::string& path) {
   
   yyjson_read_flag flags = YYJSON_READ_ALLOW_COMMENTS | YYJSON_READ_ALLOW_TRAILING_COMMAS | YYJSON_READ_ALLOW_INF_AND_NAN;
   yyjson_read_err err;
-  CLILogger::debug("JsonDoc::fromFile: Reading JSON with flags allowing comments and trailing commas");
+  LOG_DEBUG("JsonDoc::fromFile: Reading JSON with flags allowing comments and trailing commas");
   yyjson_doc* doc = yyjson_read_file(path.c_str(), flags, nullptr, &err);
   if (!doc) {
     std::string error_msg = "JSON parse error at position " + std::to_string(err.pos) + ": " + std::string(err.msg);
@@ -254,7 +263,28 @@ std::optional<JsonDoc> JsonDoc::fromFile(const std::string& path) {
     return std::nullopt;
   }
   
-  CLILogger::debug("JsonDoc::fromFile: Successfully loaded JSON file: " + path);
+  LOG_DEBUG("JsonDoc::fromFile: Successfully loaded JSON file: " + path);
+  return JsonDoc(doc);
+}
+
+std::optional<JsonDoc> JsonDoc::parse(std::string_view text, const JsonAllocator* allocator) {
+  // yyjson_read_opts only reads the buffer without YYJSON_READ_INSITU
+  yyjson_doc* doc = yyjson_read_opts(const_cast<char*>(text.data()), text.size(), YYJSON_READ_NOFLAG,
+                                     allocator ? allocator->get() : nullptr, nullptr);
+  if (!doc) {
+    return std::nullopt;
+  }
+  return JsonDoc(doc);
+}
+
+std::optional<JsonDoc> JsonDoc::parseInSitu(std::string& buffer, const JsonAllocator* allocator) {
+  size_t length = buffer.size();
+  buffer.append(YYJSON_PADDING_SIZE, '\0');
+  yyjson_doc* doc = yyjson_read_opts(buffer.data(), length, YYJSON_READ_INSITU,
+                                     allocator ? allocator->get() : nullptr, nullptr);
+  if (!doc) {
+    return std::nullopt;
+  }
   return JsonDoc(doc);
 }
 
@@ -265,13 +295,16 @@ JsonProxy JsonDoc::operator[](const std::string& key) {
 }
 
 JsonValue JsonDoc::operator[](const std::string& key) const {
-  yyjson_val* root = nullptr;
+  return root()[key];
+}
+
+JsonValue JsonDoc::root() const {
   if (doc_) {
-    root = yyjson_doc_get_root(doc_);
+    return JsonValue(yyjson_doc_get_root(doc_));
   } else if (mut_doc_) {
-    root = (yyjson_val*)yyjson_mut_doc_get_root(mut_doc_);
+    return JsonValue((yyjson_val*)yyjson_mut_doc_get_root(mut_doc_));
   }
-  return yyjson_is_obj(root) ? JsonValue(yyjson_obj_get(root, key.c_str())) : JsonValue(nullptr);
+  return JsonValue(nullptr);
 }
 
 bool JsonDoc::writeToFile(const std::string& path, bool pretty) const {
@@ -289,6 +322,23 @@ bool JsonDoc::writeToFile(const std::string& path, bool pretty) const {
   return success;
 }
 
+std::string JsonDoc::toString(bool pretty) const {
+  yyjson_write_flag flags = pretty ? YYJSON_WRITE_PRETTY : 0;
+  size_t length = 0;
+  char* text = nullptr;
+  if (mut_doc_) {
+    text = yyjson_mut_write(mut_doc_, flags, &length);
+  } else if (doc_) {
+    text = yyjson_write(doc_, flags, &length);
+  }
+  if (!text) {
+    return {};
+  }
+  std::string result(text, length);
+  free(text);
+  return result;
+}
+
 bool JsonDoc::isValid() const {
   return doc_ != nullptr || mut_doc_ != nullptr;
 }
@@ -304,3 +354,27 @@ void JsonDoc::ensureMutable() {
     }
   }
 }
+
+std::string quoteJson(std::string_view text) {
+  std::string quoted = "\"";
+  for (char c : text) {
+    switch (c) {
+      case '"': quoted += "\\\""; break;
+      case '\\': quoted += "\\\\"; break;
+      case '\n': quoted += "\\n"; break;
+      case '\r': quoted += "\\r"; break;
+      case '\t': quoted += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          static const char hex[] = "0123456789abcdef";
+          quoted += "\\u00";
+          quoted += hex[(c >> 4) & 0xF];
+          quoted += hex[c & 0xF];
+        } else {
+          quoted += c;
+        }
+    }
+  }
+  quoted += '"';
+  return quoted;
+}
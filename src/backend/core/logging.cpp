@@ -11,24 +11,262 @@
 #include <chrono>
 #include <algorithm>
 #include <cctype>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+  constexpr size_t kRingCapacity = 8192;                      // Queued file lines before producers wait (power of two)
+  constexpr std::chrono::milliseconds kWriterWakeup(100);     // Writer rechecks the ring at least this often
+
+  /**
+  @brief Bounded lock-free multi-producer, single-consumer queue of log lines
+
+  Each slot carries a sequence number: a producer claims a slot by advancing
+  head_ and publishes it by bumping the slot sequence, and the single consumer
+  takes slots in order once they are published (Vyukov's bounded queue).
+  */
+  class LogRing {
+    public:
+      LogRing() : slots_(std::make_unique<Slot[]>(kRingCapacity)) {
+        for (size_t i = 0; i < kRingCapacity; ++i) {
+          slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+      }
+
+      // Returns false (leaving line untouched) if the ring is full
+      bool tryPush(std::string& line) {
+        size_t position = head_.load(std::memory_order_relaxed);
+        for (;;) {
+          Slot& slot = slots_[position & (kRingCapacity - 1)];
+          size_t sequence = slot.sequence.load(std::memory_order_acquire);
+          auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+          if (diff == 0) {
+            if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+              slot.line = std::move(line);
+              slot.sequence.store(position + 1, std::memory_order_release);
+              return true;
+            }
+          } else if (diff < 0) {
+            return false;
+          } else {
+            position = head_.load(std::memory_order_relaxed);
+          }
+        }
+      }
+
+      // Consumer side only
+      bool tryPop(std::string& line) {
+        Slot& slot = slots_[tail_ & (kRingCapacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1) {
+          return false;  // Empty, or the next line is claimed but not yet published
+        }
+        line = std::move(slot.line);
+        slot.line.clear();
+        slot.sequence.store(tail_ + kRingCapacity, std::memory_order_release);
+        ++tail_;
+        return true;
+      }
+
+    private:
+      struct Slot {
+        std::atomic<size_t> sequence;
+        std::string line;
+      };
+      std::unique_ptr<Slot[]> slots_;
+      alignas(64) std::atomic<size_t> head_{0};  // Next slot a producer claims
+      alignas(64) size_t tail_ = 0;              // Next slot the writer takes
+  };
+
+  /**
+  @brief Log file written by a background thread, with size-based rotation
+
+  Producers only format their line and push it into the ring; the writer
+  thread drains whatever has queued up, writes it in one go and flushes once
+  per batch. When the next line would take the file past max_file_size_mb
+  it is rotated like Python's RotatingFileHandler: log -> log.1 -> ... ->
+  log.<backup_count>, dropping the oldest.
+  */
+  class AsyncFileSink {
+    public:
+      bool isOpen() const { return open_.load(std::memory_order_acquire); }
+
+      bool open(const LoggingConfig& config) {
+        close();
+        std::filesystem::path log_path(config.log_file);
+        std::error_code ec;
+        if (log_path.has_parent_path()) {
+          std::filesystem::create_directories(log_path.parent_path(), ec);
+        }
+        file_.open(config.log_file, std::ios::app | std::ios::binary);
+        if (!file_.is_open()) {
+          return false;
+        }
+        path_ = config.log_file;
+        max_bytes_ = static_cast<uint64_t>(config.max_file_size_mb) * 1024 * 1024;
+        backups_ = std::max(0, config.backup_count);
+        size_ = std::filesystem::file_size(log_path, ec);
+        if (ec) size_ = 0;
+
+        stop_ = false;
+        exited_ = false;
+        thread_ = std::thread(&AsyncFileSink::run, this);
+        open_.store(true, std::memory_order_release);
+        if (!exit_hook_registered_) {
+          exit_hook_registered_ = true;
+          std::atexit([] { Logger::flush(); });
+        }
+        return true;
+      }
+
+      // Flushes queued lines, stops the writer and closes the file
+      void close() {
+        if (!thread_.joinable()) {
+          return;
+        }
+        open_.store(false, std::memory_order_release);
+        {
+          std::lock_guard<std::mutex> lock(wake_mutex_);
+          stop_ = true;
+        }
+        wake_cv_.notify_one();
+        thread_.join();
+        file_.close();
+      }
+
+      void write(std::string line) {
+        while (!ring_.tryPush(line)) {
+          wake();
+          std::this_thread::yield();  // Full: wait for the writer rather than drop lines
+        }
+        pushed_.fetch_add(1);
+        if (idle_.exchange(false)) {
+          wake();
+        }
+      }
+
+      // Blocks until every line queued before the call is on disk
+      void flush() {
+        if (!isOpen()) {
+          return;
+        }
+        uint64_t target = pushed_.load();
+        wake();
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        flushed_cv_.wait(lock, [&] { return written_ >= target || exited_; });
+      }
+
+    private:
+      LogRing ring_;
+      std::ofstream file_;
+      std::string path_;
+      uint64_t max_bytes_ = 0;   // 0 = never rotate
+      int backups_ = 0;
+      uint64_t size_ = 0;        // Bytes in the current file
+
+      std::thread thread_;
+      std::atomic<bool> open_{false};
+      std::atomic<bool> idle_{false};     // Writer is (about to be) waiting for lines
+      std::atomic<uint64_t> pushed_{0};   // Lines queued so far
+      uint64_t written_ = 0;              // Lines written and flushed so far (guarded by wake_mutex_)
+      bool stop_ = false;                 // Guarded by wake_mutex_
+      bool exited_ = false;               // Writer has returned (guarded by wake_mutex_)
+      bool exit_hook_registered_ = false;
+      std::mutex wake_mutex_;
+      std::condition_variable wake_cv_;
+      std::condition_variable flushed_cv_;
+
+      void wake() {
+        // Taking the lock orders this notify after a waiting writer's predicate check
+        { std::lock_guard<std::mutex> lock(wake_mutex_); }
+        wake_cv_.notify_one();
+      }
+
+      void run() {
+        std::string line;
+        for (;;) {
+          uint64_t batch = 0;
+          while (ring_.tryPop(line)) {
+            writeLine(line);
+            batch++;
+          }
+          if (batch > 0) {
+            file_.flush();
+          }
+
+          std::unique_lock<std::mutex> lock(wake_mutex_);
+          written_ += batch;
+          if (batch > 0) {
+            flushed_cv_.notify_all();
+            continue;
+          }
+          if (stop_ && written_ >= pushed_.load()) {
+            exited_ = true;
+            flushed_cv_.notify_all();
+            return;
+          }
+          idle_.store(true);
+          wake_cv_.wait_for(lock, kWriterWakeup, [&] { return stop_ || pushed_.load() > written_; });
+          idle_.store(false);
+        }
+      }
+
+      void writeLine(const std::string& line) {
+        if (max_bytes_ > 0 && size_ > 0 && size_ + line.size() > max_bytes_) {
+          rotate();
+        }
+        file_.write(line.data(), static_cast<std::streamsize>(line.size()));
+        size_ += line.size();
+      }
+
+      void rotate() {
+        file_.close();
+        std::error_code ec;
+        if (backups_ > 0) {
+          std::filesystem::remove(path_ + "." + std::to_string(backups_), ec);
+          for (int i = backups_ - 1; i >= 1; --i) {
+            std::filesystem::rename(path_ + "." + std::to_string(i), path_ + "." + std::to_string(i + 1), ec);
+          }
+          std::filesystem::rename(path_, path_ + ".1", ec);
+          file_.open(path_, std::ios::app | std::ios::binary);  // Appends to the old file if the rename failed
+        } else {
+          file_.open(path_, std::ios::trunc | std::ios::binary);
+        }
+        size_ = std::filesystem::file_size(path_, ec);
+        if (ec) size_ = 0;
+      }
+  };
+
+  // Never destroyed: the atexit hook flushes it, and logging during static destruction must not touch a dead sink
+  AsyncFileSink& fileSink() {
+    static AsyncFileSink* sink = new AsyncFileSink();
+    return *sink;
+  }
+}
 
 // Static configuration instance
 static LoggingConfig g_logging_config;
-static std::ofstream g_log_file;
+static std::mutex g_log_mutex;  // Serializes console output from concurrent extraction workers
+
+std::atomic<int> Logger::detail::enabled_level{static_cast<int>(LoggingConfig{}.console_level)};
 
 std::string Logger::getCurrentTimestamp() {
   auto now = std::chrono::system_clock::now();
   auto time_t = std::chrono::system_clock::to_time_t(now);
   auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
 
+  // Reentrant variants: messages are timestamped on whichever worker logs them
   std::stringstream ss;
+  struct tm local_tm;
   #ifdef _WIN32
-    struct tm local_tm;
     localtime_s(&local_tm, &time_t);
-    ss << std::put_time(&local_tm, "%Y-%m-%d %H:%M:%S");
   #else
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
+    localtime_r(&time_t, &local_tm);
   #endif
+  ss << std::put_time(&local_tm, "%Y-%m-%d %H:%M:%S");
   ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
   return ss.str();
 }
@@ -56,26 +294,24 @@ MessageType Logger::resolveLogLevel(const std::string& level_name) {
 }
 
 void Logger::configure(const LoggingConfig& config) {
+  std::lock_guard<std::mutex> lock(g_log_mutex);
   g_logging_config = config;
 
-  // Close existing log file if open
-  if (g_log_file.is_open()) {
-    g_log_file.close();
+  // Drains and closes any previous log file before opening the new one
+  fileSink().close();
+  if (!config.log_file.empty() && !fileSink().open(config)) {
+    std::cerr << "Warning: Failed to open log file: " << config.log_file << std::endl;
   }
 
-  // Open new log file if specified
-  if (!config.log_file.empty()) {
-    // Create directory if it doesn't exist
-    std::filesystem::path log_path(config.log_file);
-    if (log_path.has_parent_path()) {
-      std::filesystem::create_directories(log_path.parent_path());
-    }
-
-    g_log_file.open(config.log_file, std::ios::app);
-    if (!g_log_file.is_open()) {
-      std::cerr << "Warning: Failed to open log file: " << config.log_file << std::endl;
-    }
+  int enabled = static_cast<int>(config.console_level);
+  if (fileSink().isOpen()) {
+    enabled = std::min(enabled, static_cast<int>(config.file_level));
   }
+  detail::enabled_level.store(enabled, std::memory_order_relaxed);
+}
+
+void Logger::flush() {
+  fileSink().flush();
 }
 
 void Logger::configureFromFile(const std::string& config_file_path) {
@@ -86,7 +322,14 @@ void Logger::configureFromFile(const std::string& config_file_path) {
       return;
     }
 
-    const JsonDoc& config = *config_opt;
+    configureFromDoc(*config_opt);
+  } catch (const std::exception& e) {
+    std::cerr << "Warning: Failed to read configuration file: " << e.what() << std::endl;
+  }
+}
+
+void Logger::configureFromDoc(const JsonDoc& config) {
+  try {
     JsonValue logging = config["logging"];
     if (logging.isNull()) {
       return; // No logging configuration
@@ -123,7 +366,7 @@ void Logger::configureFromFile(const std::string& config_file_path) {
 
     configure(new_config);
   } catch (const std::exception& e) {
-    std::cerr << "Warning: Failed to read configuration file: " << e.what() << std::endl;
+    std::cerr << "Warning: Failed to apply logging configuration: " << e.what() << std::endl;
   }
 }
 
@@ -149,11 +392,15 @@ void Logger::log(const std::string& level_name, const std::string& message) {
 }
 
 void Logger::log(MessageType type, const std::string& message) {
+  if (!isEnabled(type)) {
+    return;  // Filtered everywhere; skip the timestamp formatting too
+  }
   std::string timestamp = g_logging_config.enable_timestamps ? getCurrentTimestamp() : "";
   bool use_colors = g_logging_config.enable_colors;
 
-  // Console output
+  // Console output stays synchronous so it interleaves correctly with direct std::cout/std::cerr output
   if (shouldLog(type, true)) {
+    std::lock_guard<std::mutex> lock(g_log_mutex);
     switch (type) {
       case MessageType::Critical:
         std::cerr << (use_colors ? ConsoleColors::magenta_text : "")
@@ -224,8 +471,8 @@ void Logger::log(MessageType type, const std::string& message) {
     }
   }
 
-  // File output (always without colors)
-  if (g_log_file.is_open() && shouldLog(type, false)) {
+  // File output (always without colors), queued for the writer thread
+  if (fileSink().isOpen() && shouldLog(type, false)) {
     std::string level_str;
     switch (type) {
       case MessageType::Critical: level_str = "CRITICAL"; break;
@@ -242,8 +489,18 @@ void Logger::log(MessageType type, const std::string& message) {
       case MessageType::Default: default: level_str = "LOG"; break;
     }
 
-    g_log_file << (timestamp.empty() ? "" : timestamp + " ") << level_str << ": " << message << std::endl;
-    g_log_file.flush(); // Ensure immediate write
+    std::string line;
+    line.reserve(timestamp.size() + level_str.size() + message.size() + 4);
+    if (!timestamp.empty()) {
+      line.append(timestamp).push_back(' ');
+    }
+    line.append(level_str).append(": ").append(message).push_back('\n');
+    fileSink().write(std::move(line));
+
+    // Errors are on disk before anything that follows them (including a crash)
+    if (static_cast<int>(type) >= LogLevel::error) {
+      fileSink().flush();
+    }
   }
 }
 
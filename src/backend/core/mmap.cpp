@@ -0,0 +1,108 @@
+/**
+@brief Memory-mapped file implementation
+*/
+#include <backend/core/mmap.h>
+#include <utility>
+
+#ifdef _WIN32
+  #include <backend/core/win32.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    open_ = std::exchange(other.open_, false);
+    #ifdef _WIN32
+      mapping_ = std::exchange(other.mapping_, nullptr);
+    #endif
+  }
+  return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+  close();
+
+  #ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+      CloseHandle(file);
+      return false;
+    }
+    if (file_size.QuadPart == 0) {
+      CloseHandle(file);
+      open_ = true;
+      return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);  // The mapping keeps the file open
+    if (mapping == nullptr) return false;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+      CloseHandle(mapping);
+      return false;
+    }
+    mapping_ = mapping;
+    data_ = static_cast<const unsigned char*>(view);
+    size_ = static_cast<size_t>(file_size.QuadPart);
+  #else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      return false;
+    }
+    if (st.st_size == 0) {
+      ::close(fd);
+      open_ = true;
+      return true;
+    }
+
+    void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file referenced
+    if (view == MAP_FAILED) return false;
+
+    data_ = static_cast<const unsigned char*>(view);
+    size_ = static_cast<size_t>(st.st_size);
+  #endif
+
+  open_ = true;
+  return true;
+}
+
+void MappedFile::close() {
+  if (data_ != nullptr) {
+    #ifdef _WIN32
+      UnmapViewOfFile(data_);
+      CloseHandle(mapping_);
+      mapping_ = nullptr;
+    #else
+      ::munmap(const_cast<unsigned char*>(data_), size_);
+    #endif
+  }
+  data_ = nullptr;
+  size_ = 0;
+  open_ = false;
+}
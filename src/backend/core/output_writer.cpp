@@ -0,0 +1,96 @@
+/**
+@brief Batched output writer implementation
+*/
+#include <backend/core/output_writer.h>
+#include <cstdio>
+#include <filesystem>
+#include <utility>
+#include <backend/core/parallel.h>
+
+bool writeWholeFile(const std::string& path, const std::string& content) {
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+
+  // The content is already one contiguous buffer; stdio buffering would only add a copy
+  std::setvbuf(file, nullptr, _IONBF, 0);
+  bool ok = content.empty() || std::fwrite(content.data(), 1, content.size(), file) == content.size();
+  return std::fclose(file) == 0 && ok;
+}
+
+bool replaceWholeFile(const std::string& path, const std::string& content) {
+  std::string temp_path = path + ".tmp";
+  std::error_code ec;
+  if (!writeWholeFile(temp_path, content)) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  return true;
+}
+
+OutputWriter::OutputWriter(size_t batch_bytes) : batch_bytes_(batch_bytes) {}
+
+OutputWriter::~OutputWriter() {
+  flush();
+}
+
+std::string OutputWriter::acquireBuffer() {
+  if (spare_buffers_.empty()) {
+    return {};
+  }
+  std::string buffer = std::move(spare_buffers_.back());
+  spare_buffers_.pop_back();
+  buffer.clear();
+  return buffer;
+}
+
+void OutputWriter::write(const std::string& path, std::string content) {
+  pending_bytes_ += content.size();
+  pending_.push_back({path, std::move(content)});
+  if (pending_bytes_ >= batch_bytes_) {
+    flush();
+  }
+}
+
+bool OutputWriter::flush() {
+  if (pending_.empty()) {
+    return true;
+  }
+
+  std::vector<char> written(pending_.size(), 0);
+  size_t workers = parallel::resolveJobCount(jobs_, pending_.size());
+  parallel::forEachIndex(pending_.size(), workers, [&](size_t, size_t index) {
+    written[index] = replaceWholeFile(pending_[index].path, pending_[index].content) ? 1 : 0;
+  });
+
+  bool all_written = true;
+  for (size_t i = 0; i < pending_.size(); ++i) {
+    if (written[i]) {
+      files_written_++;
+      bytes_written_ += pending_[i].content.size();
+    } else {
+      failed_paths_.push_back(pending_[i].path);
+      all_written = false;
+    }
+
+    if (spare_buffers_.size() < kMaxSpareBuffers) {
+      spare_buffers_.push_back(std::move(pending_[i].content));
+    }
+  }
+
+  pending_.clear();
+  pending_bytes_ = 0;
+  return all_written;
+}
+
+void OutputWriter::resetStats() {
+  failed_paths_.clear();
+  files_written_ = 0;
+  bytes_written_ = 0;
+}
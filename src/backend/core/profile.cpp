@@ -0,0 +1,210 @@
+/**
+@brief Recording and reporting of profiling timers and counters
+*/
+#include <backend/core/profile.h>
+#include <backend/core/json.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+  struct Event {
+    const char* stage;
+    std::string item;
+    uint32_t thread;
+    int64_t start_ns;
+    int64_t duration_ns;
+  };
+
+  std::mutex g_profile_mutex;
+  std::vector<Event> g_events;
+  std::vector<std::pair<const char*, uint64_t>> g_counters;  // In order of first use
+  std::unordered_map<std::string, uint64_t> g_peak_memory;   // File -> peak bytes
+  int64_t g_origin_ns = 0;
+  std::atomic<uint32_t> g_next_thread{0};
+
+  // Small stable per-thread ids, so trace viewers show one row per worker
+  uint32_t threadIndex() {
+    thread_local uint32_t index = g_next_thread.fetch_add(1);
+    return index;
+  }
+
+  double toMs(int64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+  }
+
+  std::string formatMs(double ms) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(ms < 10 ? 2 : 1) << ms;
+    return out.str();
+  }
+}
+
+std::atomic<bool> profile::detail::enabled{false};
+
+void profile::detail::record(const char* stage, std::string&& item, int64_t start_ns, int64_t end_ns) {
+  uint32_t thread = threadIndex();
+  std::lock_guard<std::mutex> lock(g_profile_mutex);
+  g_events.push_back({stage, std::move(item), thread, start_ns - g_origin_ns, end_ns - start_ns});
+}
+
+void profile::detail::addCount(const char* counter, uint64_t amount) {
+  std::lock_guard<std::mutex> lock(g_profile_mutex);
+  for (auto& [name, value] : g_counters) {
+    if (std::string_view(name) == counter) {
+      value += amount;
+      return;
+    }
+  }
+  g_counters.emplace_back(counter, amount);
+}
+
+void profile::detail::addPeakMemory(std::string_view item, uint64_t bytes) {
+  std::lock_guard<std::mutex> lock(g_profile_mutex);
+  uint64_t& peak = g_peak_memory[std::string(item)];
+  peak = std::max(peak, bytes);
+}
+
+void profile::start() {
+  std::lock_guard<std::mutex> lock(g_profile_mutex);
+  g_events.clear();
+  g_counters.clear();
+  g_peak_memory.clear();
+  g_origin_ns = detail::now();
+  detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+void profile::stop() {
+  detail::enabled.store(false, std::memory_order_relaxed);
+}
+
+std::vector<profile::StageSummary> profile::stageSummaries() {
+  std::lock_guard<std::mutex> lock(g_profile_mutex);
+  std::vector<StageSummary> summaries;
+  std::unordered_map<std::string_view, size_t> index;
+  for (const auto& event : g_events) {
+    auto [slot, inserted] = index.emplace(event.stage, summaries.size());
+    if (inserted) {
+      summaries.push_back({event.stage, 0, 0, 0});
+    }
+    StageSummary& summary = summaries[slot->second];
+    double ms = toMs(event.duration_ns);
+    summary.calls++;
+    summary.total_ms += ms;
+    summary.max_ms = std::max(summary.max_ms, ms);
+  }
+  return summaries;
+}
+
+std::vector<profile::FileTiming> profile::slowestFiles(size_t limit) {
+  std::lock_guard<std::mutex> lock(g_profile_mutex);
+  std::vector<FileTiming> files;
+  std::unordered_map<std::string_view, size_t> index;
+  for (const auto& event : g_events) {
+    if (event.item.empty()) continue;
+    std::string_view stage = event.stage;
+    if (stage != "file" && stage != "parse") continue;
+    auto [slot, inserted] = index.emplace(event.item, files.size());
+    if (inserted) {
+      auto peak = g_peak_memory.find(event.item);
+      files.push_back({event.item, 0, 0, peak != g_peak_memory.end() ? peak->second : 0});
+    }
+    (stage == "file" ? files[slot->second].total_ms : files[slot->second].parse_ms) += toMs(event.duration_ns);
+  }
+  std::sort(files.begin(), files.end(), [](const FileTiming& a, const FileTiming& b) {
+    return a.total_ms > b.total_ms;
+  });
+  if (files.size() > limit) {
+    files.resize(limit);
+  }
+  return files;
+}
+
+bool profile::writeReport(const std::string& path, size_t slowest) {
+  auto stages = stageSummaries();
+  auto files = slowestFiles(slowest);
+
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    return false;
+  }
+
+  out << "{\n  \"displayTimeUnit\": \"ms\",\n  \"traceEvents\": [";
+  {
+    std::lock_guard<std::mutex> lock(g_profile_mutex);
+    bool first = true;
+    for (const auto& event : g_events) {
+      out << (first ? "\n    " : ",\n    ");
+      first = false;
+      // Trace Event Format wants microseconds
+      out << "{\"name\": " << quoteJson(event.stage) << ", \"cat\": \"cesium\", \"ph\": \"X\", \"pid\": 1"
+          << ", \"tid\": " << event.thread
+          << ", \"ts\": " << event.start_ns / 1000 << ", \"dur\": " << std::max<int64_t>(1, event.duration_ns / 1000);
+      if (!event.item.empty()) {
+        out << ", \"args\": {\"item\": " << quoteJson(event.item) << "}";
+      }
+      out << "}";
+    }
+    out << "\n  ],\n  \"counters\": {";
+    first = true;
+    for (const auto& [name, value] : g_counters) {
+      out << (first ? "\n    " : ",\n    ") << quoteJson(name) << ": " << value;
+      first = false;
+    }
+  }
+
+  out << "\n  },\n  \"stages\": [";
+  for (size_t i = 0; i < stages.size(); ++i) {
+    out << (i == 0 ? "\n    " : ",\n    ")
+        << "{\"stage\": " << quoteJson(stages[i].stage) << ", \"calls\": " << stages[i].calls
+        << ", \"total_ms\": " << formatMs(stages[i].total_ms) << ", \"max_ms\": " << formatMs(stages[i].max_ms) << "}";
+  }
+  out << "\n  ],\n  \"slowest_files\": [";
+  for (size_t i = 0; i < files.size(); ++i) {
+    out << (i == 0 ? "\n    " : ",\n    ")
+        << "{\"path\": " << quoteJson(files[i].path) << ", \"total_ms\": " << formatMs(files[i].total_ms)
+        << ", \"parse_ms\": " << formatMs(files[i].parse_ms);
+    if (files[i].peak_bytes > 0) {
+      out << ", \"peak_kb\": " << (files[i].peak_bytes + 1023) / 1024;
+    }
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+  return static_cast<bool>(out);
+}
+
+void profile::printSummary(size_t slowest) {
+  auto stages = stageSummaries();
+  std::cout << "Profile (stage totals are summed across workers):" << std::endl;
+  for (const auto& stage : stages) {
+    std::cout << "  " << std::left << std::setw(18) << stage.stage << std::right
+              << std::setw(10) << formatMs(stage.total_ms) << " ms  " << std::setw(7) << stage.calls
+              << " calls  max " << formatMs(stage.max_ms) << " ms" << std::endl;
+  }
+  {
+    std::lock_guard<std::mutex> lock(g_profile_mutex);
+    if (!g_counters.empty()) {
+      std::cout << "Counters:" << std::endl;
+    }
+    for (const auto& [name, value] : g_counters) {
+      std::cout << "  " << std::left << std::setw(18) << name << std::right << std::setw(10) << value << std::endl;
+    }
+  }
+
+  auto files = slowestFiles(slowest);
+  if (!files.empty()) {
+    std::cout << "Slowest files:" << std::endl;
+    for (const auto& file : files) {
+      std::cout << "  " << std::setw(10) << formatMs(file.total_ms) << " ms  (parse "
+                << formatMs(file.parse_ms) << " ms";
+      if (file.peak_bytes > 0) {
+        std::cout << ", peak " << (file.peak_bytes + 1023) / 1024 << " KB";
+      }
+      std::cout << ")  " << file.path << std::endl;
+    }
+  }
+}
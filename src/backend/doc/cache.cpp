@@ -2,8 +2,12 @@
 @brief Implementation of metadata cache system for documentation extraction
 */
 #include <backend/doc/cache.h>
+#include <backend/doc/cache_binary.h>
 #include <backend/core/cli_utils.h>
 #include <backend/core/json.h>
+#include <backend/core/hash.h>
+#include <backend/core/output_writer.h>
+#include <backend/core/parallel.h>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -11,17 +15,211 @@
 #include <set>
 #include <algorithm>
 
-// For SHA-256 hashing - using a simple implementation
-#include <array>
+#ifndef _WIN32
+  #include <sys/stat.h>
+#endif
 
 namespace {
-  // Simple hash function for content - using std::hash for now
-  // In production, would use a proper SHA-256 implementation
-  std::string simpleHash(const std::string& content) {
-    auto hash = std::hash<std::string>{}(content);
-    std::stringstream ss;
-    ss << std::hex << hash;
-    return ss.str();
+  // Cheap identity of a file's current state, compared before any content is read
+  struct FileStat {
+    int64_t mtime_ticks;
+    uint64_t size;
+    uint64_t inode;
+
+    bool matches(const FileMetadata& metadata) const {
+      return metadata.mtime_ticks != 0 && mtime_ticks == metadata.mtime_ticks &&
+             size == metadata.file_size && inode == metadata.inode;
+    }
+  };
+
+  // Name a generated output is stored under in the snippet archive
+  std::string archiveEntryName(std::string_view output_file) {
+    return std::filesystem::path(output_file).filename().string();
+  }
+
+  std::optional<FileStat> statFile(const std::string& path) {
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) return std::nullopt;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return std::nullopt;
+
+    FileStat result{static_cast<int64_t>(mtime.time_since_epoch().count()), static_cast<uint64_t>(size), 0};
+    #ifndef _WIN32
+      struct stat st;
+      if (::stat(path.c_str(), &st) == 0) {
+        result.inode = static_cast<uint64_t>(st.st_ino);
+      }
+    #endif
+    return result;
+  }
+
+  // Stat from the snapshot when it covers the path, otherwise from the disk
+  std::optional<FileStat> currentStat(const FsSnapshot* snapshot, const std::string& path) {
+    if (snapshot) {
+      if (auto entry = snapshot->lookup(path)) {
+        if (!*entry || (*entry)->type != FsEntryType::File) return std::nullopt;
+        return FileStat{(*entry)->mtime_ticks, (*entry)->size, (*entry)->inode};
+      }
+    }
+    return statFile(path);
+  }
+
+  bool pathExists(const FsSnapshot* snapshot, std::string_view path) {
+    if (snapshot) {
+      if (auto entry = snapshot->lookup(path)) return *entry != nullptr;
+    }
+    std::error_code ec;
+    return std::filesystem::exists(path, ec);
+  }
+
+  // Entries directly inside a directory, from the snapshot when it listed the directory
+  std::optional<std::vector<FsEntry>> listDirectory(const FsSnapshot* snapshot, const std::string& dir) {
+    if (snapshot) {
+      if (auto listing = snapshot->listDirectory(dir)) return listing;
+    }
+    return FsScanner().scan({ScanRoot{dir, false, nullptr}}).listDirectory(dir);
+  }
+
+  constexpr const char* kIntegrityStampName = ".cesium-integrity";
+  constexpr size_t kPruneBatchSize = 256;  // Unlinks per work item when pruning in parallel
+
+  bool isPathSeparator(char c) {
+    return c == '/' || c == '\\';
+  }
+
+  // File name of a path directly inside dir (given without a trailing separator), or empty
+  std::string_view nameInDirectory(std::string_view path, std::string_view dir) {
+    if (path.size() <= dir.size() + 1 || path.compare(0, dir.size(), dir) != 0 || !isPathSeparator(path[dir.size()])) {
+      return {};
+    }
+    std::string_view name = path.substr(dir.size() + 1);
+    for (char c : name) {
+      if (isPathSeparator(c)) return {};
+    }
+    return name;
+  }
+
+  std::string_view withoutTrailingSeparator(std::string_view dir) {
+    while (dir.size() > 1 && isPathSeparator(dir.back())) dir.remove_suffix(1);
+    return dir;
+  }
+
+  std::string_view fileName(std::string_view path) {
+    size_t separator = path.find_last_of("/\\");
+    return separator == std::string_view::npos ? path : path.substr(separator + 1);
+  }
+
+  // Sorted names of the pages directly in a listing
+  std::vector<std::string_view> listedPageNames(const std::vector<FsEntry>& listing) {
+    std::vector<std::string_view> names;
+    names.reserve(listing.size());
+    for (const auto& entry : listing) {
+      std::string_view name = fileName(entry.path);
+      if (entry.type == FsEntryType::File && name.ends_with(".md")) {
+        names.push_back(name);
+      }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+  }
+
+  // Order-independent digest of the pages in a listing: the sum of one hash per page, so adding or
+  // removing a page only adds or subtracts its own term
+  std::string directoryDigest(const std::vector<FsEntry>& listing) {
+    uint64_t sum = 0;
+    uint64_t count = 0;
+    for (const auto& entry : listing) {
+      std::string_view name = fileName(entry.path);
+      if (entry.type != FsEntryType::File || !name.ends_with(".md")) continue;
+      hashing::XXH64 hasher;
+      hasher.update(name);
+      hasher.update("\0", 1);
+      hasher.update(&entry.size, sizeof(entry.size));
+      hasher.update(&entry.mtime_ticks, sizeof(entry.mtime_ticks));
+      sum += hasher.digest();
+      count++;
+    }
+    return hashing::toHex(sum) + hashing::toHex(count);
+  }
+
+  // State recorded for a verified directory: its page digest and the sum of the cached page path hashes
+  std::string integrityStamp(const std::vector<FsEntry>& listing, uint64_t index_sum) {
+    return "1 " + directoryDigest(listing) + " " + hashing::toHex(index_sum) + "\n";
+  }
+
+  void storeStat(FileMetadata& metadata, const FileStat& file_stat) {
+    metadata.mtime_ticks = file_stat.mtime_ticks;
+    metadata.file_size = file_stat.size;
+    metadata.inode = file_stat.inode;
+  }
+
+  // Entry fields shared by the snapshot and journal records; strings are copied into the document
+  void addEntryFields(yyjson_mut_doc* doc, yyjson_mut_val* entry, const BinaryCacheRecord& record) {
+    auto addString = [&](const char* key, std::string_view value) {
+      yyjson_mut_obj_add_strncpy(doc, entry, key, value.data(), value.size());
+    };
+    auto addStrings = [&](const char* key, const std::vector<std::string_view>& values) {
+      yyjson_mut_val* array = yyjson_mut_obj_add_arr(doc, entry, key);
+      for (std::string_view value : values) {
+        yyjson_mut_arr_add_strncpy(doc, array, value.data(), value.size());
+      }
+    };
+    addString("content_hash", record.content_hash);
+    addString("last_modified", record.last_modified);
+    yyjson_mut_obj_add_sint(doc, entry, "mtime_ticks", record.mtime_ticks);
+    yyjson_mut_obj_add_uint(doc, entry, "file_size", record.file_size);
+    yyjson_mut_obj_add_uint(doc, entry, "inode", record.inode);
+    yyjson_mut_obj_add_uint(doc, entry, "construct_count", record.construct_count);
+    addString("language", record.language);
+    addStrings("generated_files", record.generated_files);
+    addStrings("output_hashes", record.output_hashes);
+    addStrings("dependencies", record.dependencies);
+  }
+
+  std::string journalUpdateRecord(const FileMetadata& metadata) {
+    JsonDoc record;
+    yyjson_mut_doc* doc = record.mutableDoc();
+    yyjson_mut_val* root = yyjson_mut_doc_get_root(doc);
+    yyjson_mut_obj_add_str(doc, root, "op", "update");
+    yyjson_mut_obj_add_strncpy(doc, root, "path", metadata.source_path.data(), metadata.source_path.size());
+    addEntryFields(doc, root, BinaryCacheRecord::fromMetadata(metadata));
+    return record.toString();
+  }
+
+  std::string journalRemoveRecord(const std::string& source_path) {
+    return "{\"op\": \"remove\", \"path\": " + quoteJson(source_path) + "}";
+  }
+
+  FileMetadata parseEntryFields(const std::string& source_path, JsonValue file_data) {
+    FileMetadata metadata;
+    metadata.source_path = source_path;
+
+    if (!file_data["content_hash"].isNull()) {
+      metadata.content_hash = file_data["content_hash"].asString();
+    }
+    if (!file_data["last_modified"].isNull()) {
+      metadata.last_modified_str = file_data["last_modified"].asString();
+    }
+    metadata.mtime_ticks = file_data["mtime_ticks"].asInt64();
+    metadata.file_size = file_data["file_size"].asUint64();
+    metadata.inode = file_data["inode"].asUint64();
+    if (!file_data["construct_count"].isNull()) {
+      metadata.construct_count = file_data["construct_count"].asInt();
+    }
+    if (!file_data["language"].isNull()) {
+      metadata.language = file_data["language"].asString();
+    }
+
+    // Parse generated_files array
+    JsonValue gen_files = file_data["generated_files"];
+    metadata.generated_files.reserve(gen_files.size());
+    for (JsonValue file_path : gen_files.elements()) {
+      metadata.generated_files.push_back(file_path.asString());
+    }
+    metadata.output_hashes = file_data["output_hashes"].asStringArray();
+    metadata.dependencies = file_data["dependencies"].asStringArray();
+    return metadata;
   }
 
   // Convert file_time_type to string for JSON serialization
@@ -48,16 +246,92 @@ DocumentationCache::DocumentationCache(const std::string& cache_file_path)
   cache_.last_updated = std::chrono::system_clock::now();
 }
 
+DocumentationCache::~DocumentationCache() = default;
+
+void DocumentationCache::applyConfig(const JsonDoc& config) {
+  // "stat" skips hashing files whose mtime/size/inode are unchanged; "content" always hashes
+  JsonValue hash_policy = config["hash_policy"];
+  if (hash_policy.isString()) {
+    std::string policy_name = hash_policy.asString();
+    if (!parseHashPolicy(policy_name, hash_policy_)) {
+      CLILogger::warning("Unknown hash_policy '" + policy_name + "', using stat");
+    }
+  }
+
+  JsonValue cache_format = config["cache_format"];
+  if (cache_format.isString()) {
+    std::string format_name = cache_format.asString();
+    if (!parseFormat(format_name, format_)) {
+      CLILogger::warning("Unknown cache_format '" + format_name + "', using json");
+    }
+  }
+
+  JsonValue output_mode = config["output_mode"];
+  if (output_mode.isString()) {
+    std::string mode_name = output_mode.asString();
+    if (!parseOutputMode(mode_name, output_mode_)) {
+      CLILogger::warning("Unknown output_mode '" + mode_name + "', using files");
+    }
+  }
+
+  JsonValue cache_journal = config["cache_journal"];
+  if (cache_journal.isBool()) {
+    journal_enabled_ = cache_journal.asBool();
+  }
+}
+
+std::string DocumentationCache::binaryPath() const {
+  return std::filesystem::path(cache_file_path_).replace_extension(".bin").string();
+}
+
+bool DocumentationCache::loadBinary() {
+  std::string binary_path = binaryPath();
+  if (!std::filesystem::exists(binary_path)) {
+    return false;
+  }
+
+  auto view = std::make_unique<BinaryCacheView>();
+  if (!view->open(binary_path)) {
+    CLILogger::warning("DocumentationCache::loadBinary: Ignoring invalid or outdated binary cache: " + binary_path);
+    return false;
+  }
+
+  cache_.files.clear();
+  cache_.output_to_source.clear();
+  removed_.clear();
+  cache_.version = std::string(view->version());
+  cache_.last_updated = std::chrono::system_clock::time_point(std::chrono::seconds(view->lastUpdated()));
+  base_ = std::move(view);
+
+  LOG_DEBUG("DocumentationCache::loadBinary: Mapped binary cache with " + std::to_string(base_->size()) + " entries");
+  return true;
+}
+
 bool DocumentationCache::load() {
-  CLILogger::debug("DocumentationCache::load: Attempting to load cache from: " + cache_file_path_);
-  
+  LOG_DEBUG("DocumentationCache::load: Attempting to load cache from: " + cache_file_path_);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  changed_memo_.clear();
+  dependency_memo_.clear();
+  bool loaded = loadSnapshot();
+
+  // Updates journaled after the snapshot was written are applied on top of it
+  size_t replayed = replayJournal();
+  return loaded || replayed > 0;
+}
+
+bool DocumentationCache::loadSnapshot() {
   try {
+    if (format_ == CacheFormat::Binary && loadBinary()) {
+      return true;
+    }
+
     if (!std::filesystem::exists(cache_file_path_)) {
-      CLILogger::debug("DocumentationCache::load: Cache file does not exist: " + cache_file_path_);
+      LOG_DEBUG("DocumentationCache::load: Cache file does not exist: " + cache_file_path_);
       return false;
     }
     
-    CLILogger::debug("DocumentationCache::load: Cache file exists, loading...");
+    LOG_DEBUG("DocumentationCache::load: Cache file exists, loading...");
 
     std::ifstream file(cache_file_path_);
     if (!file.is_open()) {
@@ -65,16 +339,16 @@ bool DocumentationCache::load() {
       return false;
     }
     
-    CLILogger::debug("DocumentationCache::load: Successfully opened cache file for reading");
+    LOG_DEBUG("DocumentationCache::load: Successfully opened cache file for reading");
 
     std::string json_content((std::istreambuf_iterator<char>(file)),
                             std::istreambuf_iterator<char>());
     file.close();
     
-    CLILogger::debug("DocumentationCache::load: Read " + std::to_string(json_content.length()) + " bytes from cache file");
+    LOG_DEBUG("DocumentationCache::load: Read " + std::to_string(json_content.length()) + " bytes from cache file");
 
     if (cacheFromJson(json_content)) {
-      CLILogger::debug("DocumentationCache::load: Successfully loaded cache with " + std::to_string(cache_.files.size()) + " entries");
+      LOG_DEBUG("DocumentationCache::load: Successfully loaded cache with " + std::to_string(cache_.files.size()) + " entries");
       return true;
     } else {
       CLILogger::error("DocumentationCache::load: Failed to parse cache file: " + cache_file_path_);
@@ -87,24 +361,159 @@ bool DocumentationCache::load() {
 }
 
 bool DocumentationCache::save() {
-  return saveImmediately();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!writeSnapshot()) {
+    return false;
+  }
+  truncateJournal();
+  return true;
 }
 
 bool DocumentationCache::saveImmediately() {
-  CLILogger::debug("DocumentationCache::saveImmediately: Saving cache to: " + cache_file_path_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!journal_enabled_) {
+      return writeSnapshot();
+    }
+    if (journal_records_ < kJournalCompactThreshold) {
+      // Records are flushed as they are appended, so the journal is already durable
+      return journal_records_ == 0 || journal_.good();
+    }
+    LOG_DEBUG("DocumentationCache::saveImmediately: Compacting journal (" + std::to_string(journal_records_) + " records)");
+  }
+
+  return save();
+}
+
+std::string DocumentationCache::journalPath() const {
+  return std::filesystem::path(cache_file_path_).replace_extension(".journal").string();
+}
+
+void DocumentationCache::appendJournal(const std::string& line) {
+  if (!journal_enabled_) {
+    return;
+  }
+  if (!journal_.is_open()) {
+    std::filesystem::path journal_path(journalPath());
+    std::error_code ec;
+    if (journal_path.has_parent_path()) {
+      std::filesystem::create_directories(journal_path.parent_path(), ec);
+    }
+    journal_.open(journal_path, std::ios::binary | std::ios::app);
+    if (!journal_.is_open()) {
+      CLILogger::error("DocumentationCache::appendJournal: Failed to open journal: " + journal_path.string());
+      return;
+    }
+  }
+
+  journal_ << line << '\n';
+  journal_.flush();
+  journal_records_++;
+}
+
+size_t DocumentationCache::replayJournal() {
+  std::string journal_path = journalPath();
+  std::string content;
+  {
+    std::ifstream journal(journal_path, std::ios::binary);
+    if (!journal.is_open()) {
+      return 0;
+    }
+    content.assign(std::istreambuf_iterator<char>(journal), std::istreambuf_iterator<char>());
+  }
+
+  // Records are small and parsed one at a time, so they share a pooled allocator
+  JsonAllocator allocator;
+  size_t replayed = 0;
+  size_t good_end = 0;          // Offset just past the last intact record
+  bool unterminated = false;    // The last intact record has no newline yet
+  std::string line;
+  for (size_t begin = 0; begin < content.size();) {
+    size_t newline = content.find('\n', begin);
+    size_t end = newline == std::string::npos ? content.size() : newline;
+    line.assign(content, begin, end - begin);
+    size_t next = newline == std::string::npos ? content.size() : newline + 1;
+    if (line.empty()) {
+      begin = good_end = next;
+      continue;
+    }
+
+    // A crash can leave a torn final record; everything before it is still valid
+    std::optional<JsonDoc> record_doc = JsonDoc::parseInSitu(line, &allocator);
+    if (!record_doc) {
+      CLILogger::warning("DocumentationCache::replayJournal: Ignoring truncated journal record in " + journal_path);
+      break;
+    }
+    const JsonDoc& record = *record_doc;
+    begin = good_end = next;
+    unterminated = newline == std::string::npos;
+
+    std::string op = record["op"].asString();
+    std::string source_path = record["path"].asString();
+    if (source_path.empty()) continue;
+
+    if (op == "update") {
+      applyUpdate(parseEntryFields(source_path, record.root()));
+    } else if (op == "remove") {
+      applyRemove(source_path);
+    } else {
+      continue;
+    }
+    replayed++;
+  }
+
+  // Later appends must start on a line of their own, or they would be joined onto the torn
+  // fragment and lost with it on the next replay
+  if (good_end < content.size() || unterminated) {
+    if (journal_.is_open()) {
+      journal_.close();
+    }
+    journal_.clear();
+    std::error_code ec;
+    std::filesystem::resize_file(journal_path, good_end, ec);
+    if (!ec && unterminated) {
+      std::ofstream journal(journal_path, std::ios::binary | std::ios::app);
+      journal << '\n';
+      if (!journal) ec = std::make_error_code(std::errc::io_error);
+    }
+    if (ec) {
+      CLILogger::warning("DocumentationCache::replayJournal: Failed to repair " + journal_path + ": " + ec.message());
+    }
+  }
+
+  // The replayed records stay in the journal until the next snapshot
+  journal_records_ = replayed;
+  if (replayed > 0) {
+    LOG_DEBUG("DocumentationCache::replayJournal: Replayed " + std::to_string(replayed) + " journal records");
+  }
+  return replayed;
+}
+
+void DocumentationCache::truncateJournal() {
+  if (journal_.is_open()) {
+    journal_.close();
+  }
+  journal_.clear();
+  std::error_code ec;
+  std::filesystem::remove(journalPath(), ec);
+  journal_records_ = 0;
+}
+
+bool DocumentationCache::writeSnapshot() {
+  LOG_DEBUG("DocumentationCache::saveImmediately: Saving cache to: " + (format_ == CacheFormat::Binary ? binaryPath() : cache_file_path_));
   
   try {
     // Create directory if it doesn't exist
     std::filesystem::path cache_path(cache_file_path_);
     if (cache_path.has_parent_path()) {
       std::string parent_dir = cache_path.parent_path().string();
-      CLILogger::debug("DocumentationCache::saveImmediately: Creating parent directories for cache file: " + parent_dir);
+      LOG_DEBUG("DocumentationCache::saveImmediately: Creating parent directories for cache file: " + parent_dir);
       try {
         bool created = std::filesystem::create_directories(cache_path.parent_path());
         if (created) {
-          CLILogger::debug("DocumentationCache::saveImmediately: Successfully created parent directories: " + parent_dir);
+          LOG_DEBUG("DocumentationCache::saveImmediately: Successfully created parent directories: " + parent_dir);
         } else {
-          CLILogger::debug("DocumentationCache::saveImmediately: Parent directories already exist: " + parent_dir);
+          LOG_DEBUG("DocumentationCache::saveImmediately: Parent directories already exist: " + parent_dir);
         }
       } catch (const std::filesystem::filesystem_error& e) {
         CLILogger::error("DocumentationCache::saveImmediately: Failed to create parent directories '" + parent_dir + "': " + e.what());
@@ -112,27 +521,30 @@ bool DocumentationCache::saveImmediately() {
       }
     }
 
-    std::ofstream file(cache_file_path_);
-    if (!file.is_open()) {
-      CLILogger::error("DocumentationCache::saveImmediately: Failed to create cache file: " + cache_file_path_);
-      return false;
+    if (format_ == CacheFormat::Binary) {
+      return saveBinary();
     }
-    
-    CLILogger::debug("DocumentationCache::saveImmediately: Successfully opened cache file for writing");
 
+    // Write next to the cache and rename over it so a crash never leaves a half-written snapshot
+    std::string temp_path = cache_file_path_ + ".tmp";
     cache_.last_updated = std::chrono::system_clock::now();
-    std::string json_content = cacheToJson();
-    CLILogger::debug("DocumentationCache::saveImmediately: Generated JSON content (" + std::to_string(json_content.length()) + " bytes)");
-    
-    file << json_content;
-    if (!file.good()) {
-      CLILogger::error("DocumentationCache::saveImmediately: File write errors occurred");
-      file.close();
+    if (!cacheToJson().writeToFile(temp_path)) {
+      CLILogger::error("DocumentationCache::saveImmediately: Failed to write cache file: " + temp_path);
+      std::error_code remove_ec;
+      std::filesystem::remove(temp_path, remove_ec);
+      return false;
+    }
+    LOG_DEBUG("DocumentationCache::saveImmediately: Wrote JSON snapshot to " + temp_path);
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, cache_file_path_, ec);
+    if (ec) {
+      CLILogger::error("DocumentationCache::saveImmediately: Failed to replace cache file: " + ec.message());
+      std::filesystem::remove(temp_path, ec);
       return false;
     }
-    file.close();
 
-    CLILogger::debug("DocumentationCache::saveImmediately: Successfully saved cache with " + std::to_string(cache_.files.size()) + " entries");
+    LOG_DEBUG("DocumentationCache::saveImmediately: Successfully saved cache with " + std::to_string(cache_.files.size()) + " entries");
     return true;
   } catch (const std::exception& e) {
     CLILogger::error("DocumentationCache::saveImmediately: Exception saving cache: " + std::string(e.what()));
@@ -140,51 +552,126 @@ bool DocumentationCache::saveImmediately() {
   }
 }
 
+bool DocumentationCache::saveBinary() {
+  cache_.last_updated = std::chrono::system_clock::now();
+  int64_t last_updated = std::chrono::duration_cast<std::chrono::seconds>(cache_.last_updated.time_since_epoch()).count();
+
+  // Unchanged entries are copied straight out of the current mapping
+  std::vector<BinaryCacheRecord> records;
+  forEachRecord([&](const BinaryCacheRecord& record) {
+    records.push_back(record);
+  });
+  size_t record_count = records.size();
+
+  std::string binary_path = binaryPath();
+  std::string temp_path = binary_path + ".tmp";
+  bool written = writeBinaryCache(temp_path, cache_.version, last_updated, std::move(records));
+  if (!written) {
+    CLILogger::error("DocumentationCache::saveBinary: Failed to write binary cache: " + temp_path);
+    std::error_code ec;
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+
+  // The old mapping must be released before it can be replaced on Windows
+  if (base_) {
+    base_->close();
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp_path, binary_path, ec);
+  if (ec) {
+    CLILogger::error("DocumentationCache::saveBinary: Failed to replace binary cache '" + binary_path + "': " + ec.message());
+    return false;
+  }
+
+  // Everything in memory is now on disk; serve it from the new mapping
+  if (!loadBinary()) {
+    CLILogger::error("DocumentationCache::saveBinary: Failed to map saved binary cache: " + binary_path);
+    return false;
+  }
+
+  LOG_DEBUG("DocumentationCache::saveBinary: Successfully saved binary cache with " + std::to_string(record_count) + " entries");
+  return true;
+}
+
+std::optional<FileMetadata> DocumentationCache::lookupFile(const std::string& source_path) const {
+  auto it = cache_.files.find(source_path);
+  if (it != cache_.files.end()) {
+    return it->second;
+  }
+  if (base_ && base_->isOpen() && removed_.find(source_path) == removed_.end()) {
+    if (auto index = base_->indexOf(source_path)) {
+      return base_->recordAt(*index).toMetadata();
+    }
+  }
+  return std::nullopt;
+}
+
+bool DocumentationCache::isShadowed(std::string_view source_path) const {
+  std::string key(source_path);
+  return cache_.files.find(key) != cache_.files.end() || removed_.find(key) != removed_.end();
+}
+
+void DocumentationCache::forEachRecord(const std::function<void(const BinaryCacheRecord&)>& visit) const {
+  if (base_ && base_->isOpen()) {
+    for (size_t i = 0; i < base_->size(); ++i) {
+      if (!isShadowed(base_->sourcePathAt(i))) {
+        visit(base_->recordAt(i));
+      }
+    }
+  }
+  for (const auto& [path, metadata] : cache_.files) {
+    visit(BinaryCacheRecord::fromMetadata(metadata));
+  }
+}
+
 bool DocumentationCache::needsExtraction(const std::string& source_path) {
-  CLILogger::debug("DocumentationCache::needsExtraction: Checking if file needs extraction: " + source_path);
+  LOG_DEBUG("DocumentationCache::needsExtraction: Checking if file needs extraction: " + source_path);
   
   try {
     // Check if file exists
-    if (!std::filesystem::exists(source_path)) {
-      CLILogger::debug("DocumentationCache::needsExtraction: Source file does not exist: " + source_path);
+    if (!pathExists(snapshot_, source_path)) {
+      LOG_DEBUG("DocumentationCache::needsExtraction: Source file does not exist: " + source_path);
       return false; // Can't extract non-existent file
     }
 
     // Check if we have cache entry for this file
-    auto it = cache_.files.find(source_path);
-    if (it == cache_.files.end()) {
-      CLILogger::debug("DocumentationCache::needsExtraction: File not in cache, needs extraction: " + source_path);
+    std::optional<FileMetadata> cached;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cached = lookupFile(source_path);
+    }
+    if (!cached) {
+      LOG_DEBUG("DocumentationCache::needsExtraction: File not in cache, needs extraction: " + source_path);
       return true; // New file
     }
 
-    const FileMetadata& metadata = it->second;
-    CLILogger::debug("DocumentationCache::needsExtraction: Found cache entry for file, checking if up to date");
-
-    // Check if file has been modified
-    auto current_time = std::filesystem::last_write_time(source_path);
-    std::string current_time_str = fileTimeToString(current_time);
-    if (current_time_str != metadata.last_modified_str) {
-      CLILogger::debug("DocumentationCache::needsExtraction: File timestamp changed, needs extraction: " + source_path + " (was: " + metadata.last_modified_str + ", now: " + current_time_str + ")");
-      return true;
-    }
+    FileMetadata& metadata = *cached;
+    LOG_DEBUG("DocumentationCache::needsExtraction: Found cache entry for file, checking if up to date");
 
-    // Check content hash
-    std::string current_hash = calculateFileHash(source_path);
-    if (current_hash != metadata.content_hash) {
-      CLILogger::debug("DocumentationCache::needsExtraction: File content changed, needs extraction: " + source_path + " (hash changed from " + metadata.content_hash + " to " + current_hash + ")");
+    if (contentChanged(source_path, metadata)) {
+      LOG_DEBUG("DocumentationCache::needsExtraction: File content changed, needs extraction: " + source_path);
       return true;
     }
 
     // Check if any generated files are missing
     for (const auto& generated_file : metadata.generated_files) {
-      if (!std::filesystem::exists(generated_file)) {
-        CLILogger::debug("DocumentationCache::needsExtraction: Generated file missing, needs extraction: " + generated_file);
+      if (!outputExists(generated_file)) {
+        LOG_DEBUG("DocumentationCache::needsExtraction: Generated file missing, needs extraction: " + generated_file);
         return true;
       }
     }
 
+    // A changed include or merge partner changes this file's documentation too
+    std::unordered_map<std::string, size_t> on_path;
+    size_t lowest = 0;
+    if (dependencyChanged(source_path, on_path, lowest)) {
+      LOG_DEBUG("DocumentationCache::needsExtraction: Dependency changed, needs extraction: " + source_path);
+      return true;
+    }
+
     // File is up to date
-    CLILogger::debug("DocumentationCache::needsExtraction: File is up to date, no extraction needed: " + source_path);
+    LOG_DEBUG("DocumentationCache::needsExtraction: File is up to date, no extraction needed: " + source_path);
     return false;
   } catch (const std::exception& e) {
     CLILogger::error("DocumentationCache::needsExtraction: Exception checking file for extraction: " + std::string(e.what()));
@@ -192,41 +679,213 @@ bool DocumentationCache::needsExtraction(const std::string& source_path) {
   }
 }
 
+bool DocumentationCache::contentChanged(const std::string& source_path, FileMetadata& metadata) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto memo = changed_memo_.find(source_path);
+    if (scanning_ && memo != changed_memo_.end()) {
+      return memo->second;
+    }
+  }
+
+  bool changed = true;
+  std::optional<FileStat> current_stat = currentStat(snapshot_, source_path);
+  if (!current_stat) {
+    LOG_DEBUG("DocumentationCache::contentChanged: Failed to stat file, treating as changed: " + source_path);
+  } else {
+    bool stat_unchanged = current_stat->matches(metadata);
+    if (stat_unchanged && hash_policy_ == HashPolicy::Stat) {
+      LOG_DEBUG("DocumentationCache::contentChanged: mtime/size/inode unchanged, skipping content hash: " + source_path);
+      changed = false;
+    } else {
+      // Stat changed (or policy demands it): only a content change counts
+      std::string current_hash = calculateFileHash(source_path);
+      changed = current_hash.empty() || current_hash != metadata.content_hash;
+      if (changed) {
+        LOG_DEBUG("DocumentationCache::contentChanged: Hash changed from " + metadata.content_hash + " to " + current_hash + ": " + source_path);
+      } else if (!stat_unchanged) {
+        // Touched but identical (e.g. a fresh checkout): remember the new stat so the next run short-circuits
+        LOG_DEBUG("DocumentationCache::contentChanged: File timestamp changed but content is identical: " + source_path);
+        storeStat(metadata, *current_stat);
+        metadata.last_modified_str = fileTimeToString(std::filesystem::file_time_type(
+            std::filesystem::file_time_type::duration(current_stat->mtime_ticks)));
+        std::lock_guard<std::mutex> lock(mutex_);
+        applyUpdate(metadata);
+        appendJournal(journalUpdateRecord(metadata));
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (scanning_) {
+    changed_memo_[source_path] = changed;
+  }
+  return changed;
+}
+
+bool DocumentationCache::dependencyChanged(const std::string& source_path,
+                                           std::unordered_map<std::string, size_t>& on_path,
+                                           size_t& lowest) {
+  auto on_path_it = on_path.find(source_path);
+  if (on_path_it != on_path.end()) {
+    // Loop back to a file still being walked; its own walk covers the rest
+    lowest = std::min(lowest, on_path_it->second);
+    return false;
+  }
+
+  std::optional<FileMetadata> cached;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto memo = dependency_memo_.find(source_path);
+    if (scanning_ && memo != dependency_memo_.end()) {
+      return memo->second;
+    }
+    cached = lookupFile(source_path);
+  }
+  if (!cached || cached->dependencies.empty()) {
+    return false;
+  }
+
+  size_t depth = on_path.size();
+  on_path.emplace(source_path, depth);
+  size_t reached = depth;
+  bool changed = false;
+
+  for (const auto& dependency : cached->dependencies) {
+    std::optional<FileMetadata> dependency_entry;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      dependency_entry = lookupFile(dependency);
+    }
+    if (!dependency_entry) {
+      // Untracked dependency: only its removal can be detected
+      if (!pathExists(snapshot_, dependency)) {
+        LOG_DEBUG("DocumentationCache::dependencyChanged: Dependency removed: " + dependency);
+        changed = true;
+        break;
+      }
+      continue;
+    }
+    if (contentChanged(dependency, *dependency_entry) || dependencyChanged(dependency, on_path, reached)) {
+      LOG_DEBUG("DocumentationCache::dependencyChanged: " + source_path + " depends on changed file " + dependency);
+      changed = true;
+      break;
+    }
+  }
+
+  on_path.erase(source_path);
+  lowest = std::min(lowest, reached);
+
+  // A negative result that relied on a file higher up the path is not final yet
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (scanning_ && (changed || reached >= depth)) {
+    dependency_memo_[source_path] = changed;
+  }
+  return changed;
+}
+
+void DocumentationCache::beginChangeScan() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  scanning_ = true;
+  changed_memo_.clear();
+  dependency_memo_.clear();
+}
+
+void DocumentationCache::endChangeScan() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  scanning_ = false;
+  changed_memo_.clear();
+  dependency_memo_.clear();
+  scan_archive_.close();
+}
+
+bool DocumentationCache::outputExists(const std::string& output_file) {
+  if (output_mode_ == OutputMode::Files) {
+    return pathExists(snapshot_, output_file);
+  }
+
+  // The archive is mapped once per scan; outside a scan it may be rewritten at any time
+  std::lock_guard<std::mutex> lock(mutex_);
+  SnippetArchive single_lookup;
+  SnippetArchive& archive = scanning_ ? scan_archive_ : single_lookup;
+  if (!archive.isOpen()) {
+    archive.open(snippetArchivePath(std::filesystem::path(cache_file_path_).parent_path().string()));
+  }
+  return archive.contains(archiveEntryName(output_file));
+}
+
 void DocumentationCache::updateFile(const std::string& source_path,
                                    const std::vector<std::string>& generated_files,
                                    size_t construct_count,
-                                   const std::string& language) {
-  CLILogger::debug("DocumentationCache::updateFile: Updating cache entry for: " + source_path + " (" + std::to_string(construct_count) + " constructs, " + std::to_string(generated_files.size()) + " files, language: " + language + ")");
+                                   const std::string& language,
+                                   const std::vector<std::string>& dependencies,
+                                   const std::vector<std::string>& output_hashes) {
+  LOG_DEBUG("DocumentationCache::updateFile: Updating cache entry for: " + source_path + " (" + std::to_string(construct_count) + " constructs, " + std::to_string(generated_files.size()) + " files, language: " + language + ")");
   
   try {
     FileMetadata metadata;
     metadata.source_path = source_path;
     
-    CLILogger::debug("DocumentationCache::updateFile: Calculating file hash for: " + source_path);
+    LOG_DEBUG("DocumentationCache::updateFile: Calculating file hash for: " + source_path);
     metadata.content_hash = calculateFileHash(source_path);
-    CLILogger::debug("DocumentationCache::updateFile: File hash: " + metadata.content_hash);
+    LOG_DEBUG("DocumentationCache::updateFile: File hash: " + metadata.content_hash);
     
     metadata.last_modified_str = fileTimeToString(std::filesystem::last_write_time(source_path));
+    if (auto file_stat = statFile(source_path)) {
+      storeStat(metadata, *file_stat);
+    }
     metadata.generated_files = generated_files;
     metadata.construct_count = construct_count;
     metadata.language = language;
-
-    // Update main mapping
-    cache_.files[source_path] = metadata;
-
-    // Update reverse mapping for orphan detection
-    for (const auto& generated_file : generated_files) {
-      cache_.output_to_source[generated_file] = source_path;
+    metadata.dependencies = dependencies;
+    if (output_hashes.size() == generated_files.size()) {
+      metadata.output_hashes = output_hashes;
     }
 
-    CLILogger::debug("DocumentationCache::updateFile: Successfully updated cache entry for: " + source_path +
+    std::lock_guard<std::mutex> lock(mutex_);
+    changed_memo_.clear();
+    dependency_memo_.clear();
+    applyUpdate(metadata);
+    appendJournal(journalUpdateRecord(metadata));
+
+    LOG_DEBUG("DocumentationCache::updateFile: Successfully updated cache entry for: " + source_path +
                     " (" + std::to_string(generated_files.size()) + " files generated)");
   } catch (const std::exception& e) {
     CLILogger::error("DocumentationCache::updateFile: Exception updating cache for file: " + std::string(e.what()));
   }
 }
 
+void DocumentationCache::applyUpdate(const FileMetadata& metadata) {
+  // Outputs this source no longer produces must not keep pointing at it
+  auto previous = cache_.files.find(metadata.source_path);
+  if (previous != cache_.files.end()) {
+    for (const auto& generated_file : previous->second.generated_files) {
+      auto mapping = cache_.output_to_source.find(generated_file);
+      if (mapping != cache_.output_to_source.end() && mapping->second == metadata.source_path) {
+        cache_.output_to_source.erase(mapping);
+      }
+    }
+  }
+
+  // Update main mapping
+  cache_.files[metadata.source_path] = metadata;
+  removed_.erase(metadata.source_path);
+
+  // Update reverse mapping for orphan detection
+  for (const auto& generated_file : metadata.generated_files) {
+    cache_.output_to_source[generated_file] = metadata.source_path;
+  }
+}
+
 void DocumentationCache::removeFile(const std::string& source_path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  changed_memo_.clear();
+  dependency_memo_.clear();
+  applyRemove(source_path);
+  appendJournal(journalRemoveRecord(source_path));
+}
+
+void DocumentationCache::applyRemove(const std::string& source_path) {
   auto it = cache_.files.find(source_path);
   if (it != cache_.files.end()) {
     // Remove reverse mappings
@@ -237,53 +896,146 @@ void DocumentationCache::removeFile(const std::string& source_path) {
     // Remove main entry
     cache_.files.erase(it);
 
-    CLILogger::debug("Removed cache entry for: " + source_path);
+    LOG_DEBUG("Removed cache entry for: " + source_path);
   }
+
+  // Hide the mapped entry as well; it is dropped from disk on the next save
+  if (base_ && base_->isOpen() && base_->indexOf(source_path)) {
+    removed_.insert(source_path);
+  }
+}
+
+std::unordered_map<std::string, std::string> DocumentationCache::recordedOutputHashes() const {
+  std::unordered_map<std::string, std::string> hashes;
+  std::lock_guard<std::mutex> lock(mutex_);
+  forEachRecord([&](const BinaryCacheRecord& record) {
+    size_t count = std::min(record.generated_files.size(), record.output_hashes.size());
+    for (size_t i = 0; i < count; ++i) {
+      hashes[std::string(record.generated_files[i])] = std::string(record.output_hashes[i]);
+    }
+  });
+  return hashes;
+}
+
+std::vector<std::string> DocumentationCache::dependentsOf(const std::vector<std::string>& paths) const {
+  // Reverse the recorded dependency edges: dependency -> files that list it
+  std::unordered_map<std::string, std::vector<std::string>> dependents;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    forEachRecord([&](const BinaryCacheRecord& record) {
+      for (const auto& dependency : record.dependencies) {
+        dependents[FsSnapshot::normalize(dependency)].emplace_back(record.source_path);
+      }
+    });
+  }
+
+  std::unordered_set<std::string> visited;
+  std::vector<std::string> pending;
+  for (const auto& path : paths) {
+    std::string key = FsSnapshot::normalize(path);
+    if (visited.insert(key).second) {
+      pending.push_back(std::move(key));
+    }
+  }
+
+  std::vector<std::string> result;
+  while (!pending.empty()) {
+    std::string key = std::move(pending.back());
+    pending.pop_back();
+    auto found = dependents.find(key);
+    if (found == dependents.end()) continue;
+    for (const auto& dependent : found->second) {
+      std::string dependent_key = FsSnapshot::normalize(dependent);
+      if (visited.insert(dependent_key).second) {
+        result.push_back(dependent);
+        pending.push_back(std::move(dependent_key));
+      }
+    }
+  }
+  return result;
 }
 
 std::vector<std::string> DocumentationCache::getOrphanedFiles() {
   std::vector<std::string> orphaned;
 
+  SnippetArchive archive;
+  if (output_mode_ == OutputMode::Archive) {
+    archive.open(snippetArchivePath(std::filesystem::path(cache_file_path_).parent_path().string()));
+  }
+  auto output_exists = [&](std::string_view output_file) {
+    return output_mode_ == OutputMode::Archive ? archive.contains(archiveEntryName(output_file))
+                                               : pathExists(snapshot_, output_file);
+  };
+
   for (const auto& [output_file, source_file] : cache_.output_to_source) {
     // Check if source file still exists
-    if (!std::filesystem::exists(source_file)) {
+    if (!pathExists(snapshot_, source_file)) {
       // Check if output file exists (might have been manually deleted)
-      if (std::filesystem::exists(output_file)) {
+      if (output_exists(output_file)) {
         orphaned.push_back(output_file);
       }
     }
   }
 
+  // Mapped entries are not mirrored into output_to_source
+  if (base_ && base_->isOpen()) {
+    for (size_t i = 0; i < base_->size(); ++i) {
+      std::string_view source_file = base_->sourcePathAt(i);
+      if (isShadowed(source_file) || pathExists(snapshot_, source_file)) continue;
+      for (const auto& output_file : base_->recordAt(i).generated_files) {
+        if (output_exists(output_file)) {
+          orphaned.emplace_back(output_file);
+        }
+      }
+    }
+  }
+
   return orphaned;
 }
 
 std::vector<std::string> DocumentationCache::getOrphanedFilesInDirectory(const std::string& extract_dir) {
   std::vector<std::string> orphaned;
 
-  if (!std::filesystem::exists(extract_dir)) {
+  if (!pathExists(snapshot_, extract_dir)) {
     return orphaned;
   }
 
-  // Build set of all files that should exist according to cache
-  std::set<std::string> cached_files;
-  for (const auto& [source_path, metadata] : cache_.files) {
-    for (const auto& generated_file : metadata.generated_files) {
-      std::filesystem::path p(generated_file);
-      cached_files.insert(p.filename().string());
+  // Names of all files that should exist according to cache, sorted for a merge with the listing
+  std::vector<std::string> cached_files;
+  forEachRecord([&](const BinaryCacheRecord& record) {
+    for (const auto& generated_file : record.generated_files) {
+      cached_files.emplace_back(fileName(generated_file));
+    }
+  });
+  std::sort(cached_files.begin(), cached_files.end());
+  auto cached = [&](std::string_view name) {
+    return std::binary_search(cached_files.begin(), cached_files.end(), name, std::less<>());
+  };
+
+  // In archive mode the archive index is the directory listing
+  if (output_mode_ == OutputMode::Archive) {
+    SnippetArchive archive;
+    if (archive.open(snippetArchivePath(extract_dir))) {
+      for (size_t i = 0; i < archive.size(); ++i) {
+        std::string_view name = archive.nameAt(i);
+        if (!cached(name)) {
+          orphaned.push_back((std::filesystem::path(extract_dir) / std::string(name)).string());
+        }
+      }
     }
+    return orphaned;
   }
 
-  // Add the cache file itself to the list of expected files
-  cached_files.insert(".cesium-cache.json");
-
-  // Check for files in directory that aren't in cache
-  for (const auto& entry : std::filesystem::directory_iterator(extract_dir)) {
-    if (entry.is_regular_file()) {
-      std::string filename = entry.path().filename().string();
-      // Skip log files and other non-documentation files
-      if (filename.ends_with(".md") && cached_files.find(filename) == cached_files.end()) {
-        orphaned.push_back(entry.path().string());
-      }
+  // Check for pages in directory that aren't in cache (log files and other non-documentation files are skipped)
+  std::optional<std::vector<FsEntry>> listing = listDirectory(snapshot_, extract_dir);
+  if (!listing) {
+    CLILogger::warning("DocumentationCache::getOrphanedFilesInDirectory: Failed to list " + extract_dir);
+    return orphaned;
+  }
+  for (const auto& entry : *listing) {
+    std::string_view name = fileName(entry.path);
+    if (entry.type == FsEntryType::File && name.ends_with(".md") && !cached(name)) {
+      orphaned.push_back(entry.path);
     }
   }
 
@@ -300,55 +1052,109 @@ size_t DocumentationCache::pruneOrphanedFiles(const std::string& extract_dir, bo
   size_t total_orphaned = source_orphaned.size() + directory_orphaned.size();
   size_t files_removed = 0;
 
-  // Remove files from deleted sources
-  for (const auto& file_path : source_orphaned) {
-    if (dry_run) {
-      CLILogger::info("Would remove orphaned file (source deleted): " + file_path);
-      files_removed++;
-    } else {
-      try {
-        if (std::filesystem::remove(file_path)) {
-          CLILogger::info("Removed orphaned file (source deleted): " + file_path);
-          files_removed++;
+  // Archived pages are dropped with a single archive rewrite instead of one unlink each
+  if (output_mode_ == OutputMode::Archive && !dry_run && total_orphaned > 0) {
+    std::set<std::string> removed_names;
+    for (const auto& file_path : source_orphaned) removed_names.insert(archiveEntryName(file_path));
+    for (const auto& file_path : directory_orphaned) removed_names.insert(archiveEntryName(file_path));
+    if (!updateSnippetArchive(snippetArchivePath(extract_dir), {}, removed_names)) {
+      CLILogger::warning("Failed to remove orphaned pages from snippet archive in " + extract_dir);
+      return 0;
+    }
+  }
+  bool archived = output_mode_ == OutputMode::Archive;
+
+  // Pages from deleted sources come first, then pages the cache does not track
+  std::vector<const std::string*> orphans;
+  orphans.reserve(total_orphaned);
+  for (const auto& file_path : source_orphaned) orphans.push_back(&file_path);
+  for (const auto& file_path : directory_orphaned) orphans.push_back(&file_path);
+  auto reason = [&](size_t index) {
+    return index < source_orphaned.size() ? " (source deleted): " : " (not in cache): ";
+  };
+
+  if (dry_run) {
+    for (size_t i = 0; i < orphans.size(); ++i) {
+      CLILogger::info(std::string("Would remove orphaned file") + reason(i) + *orphans[i]);
+    }
+    files_removed = orphans.size();
+  } else {
+    // Unlinking is dominated by per-call latency (especially on Windows), so batches go to parallel workers
+    std::vector<char> removed(orphans.size(), archived ? 1 : 0);
+    std::vector<std::string> errors(orphans.size());
+    if (!archived) {
+      size_t batches = (orphans.size() + kPruneBatchSize - 1) / kPruneBatchSize;
+      parallel::forEachIndex(batches, parallel::resolveJobCount(jobs_, batches), [&](size_t, size_t batch) {
+        size_t end = std::min(orphans.size(), (batch + 1) * kPruneBatchSize);
+        for (size_t i = batch * kPruneBatchSize; i < end; ++i) {
+          std::error_code ec;
+          removed[i] = std::filesystem::remove(*orphans[i], ec);
+          if (ec) {
+            errors[i] = ec.message();
+          }
         }
-      } catch (const std::exception& e) {
-        CLILogger::warning("Failed to remove orphaned file " + file_path + ": " + e.what());
+      });
+    }
+    for (size_t i = 0; i < orphans.size(); ++i) {
+      if (removed[i]) {
+        CLILogger::info(std::string("Removed orphaned file") + reason(i) + *orphans[i]);
+        files_removed++;
+      } else if (!errors[i].empty()) {
+        CLILogger::warning("Failed to remove orphaned file " + *orphans[i] + ": " + errors[i]);
       }
     }
-  }
 
-  // Remove files in directory not tracked by cache
-  for (const auto& file_path : directory_orphaned) {
-    if (dry_run) {
-      CLILogger::info("Would remove orphaned file (not in cache): " + file_path);
-      files_removed++;
-    } else {
-      try {
-        if (std::filesystem::remove(file_path)) {
-          CLILogger::info("Removed orphaned file (not in cache): " + file_path);
-          files_removed++;
-        }
-      } catch (const std::exception& e) {
-        CLILogger::warning("Failed to remove orphaned file " + file_path + ": " + e.what());
+    // Entries of deleted sources go as well, or their pages would read as missing on every later check;
+    // one whose page could not be removed stays so the next prune retries it
+    std::unordered_set<std::string_view> failed_paths;
+    for (size_t i = 0; i < orphans.size(); ++i) {
+      if (!errors[i].empty()) failed_paths.insert(*orphans[i]);
+    }
+    std::vector<std::string> deleted_sources;
+    forEachRecord([&](const BinaryCacheRecord& record) {
+      if (pathExists(snapshot_, record.source_path)) return;
+      bool kept = std::any_of(record.generated_files.begin(), record.generated_files.end(),
+                              [&](std::string_view file) { return failed_paths.count(file) > 0; });
+      if (!kept) deleted_sources.emplace_back(record.source_path);
+    });
+    if (!deleted_sources.empty()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      changed_memo_.clear();
+      dependency_memo_.clear();
+      for (const auto& source_path : deleted_sources) {
+        applyRemove(source_path);
       }
     }
-  }
 
-  if (!dry_run && files_removed > 0) {
-    // Clean up cache entries for removed files
-    auto it = cache_.output_to_source.begin();
-    while (it != cache_.output_to_source.end()) {
-      if (!std::filesystem::exists(it->first)) {
-        it = cache_.output_to_source.erase(it);
-      } else {
-        ++it;
+    if (files_removed > 0) {
+      // Removed pages are known; the rest are checked against the snapshot rather than stat-ed
+      std::unordered_set<std::string_view> removed_paths;
+      for (size_t i = 0; i < orphans.size(); ++i) {
+        if (removed[i]) removed_paths.insert(*orphans[i]);
+      }
+      SnippetArchive archive;
+      if (archived) {
+        archive.open(snippetArchivePath(extract_dir));
+      }
+      auto it = cache_.output_to_source.begin();
+      while (it != cache_.output_to_source.end()) {
+        bool exists = archived ? archive.contains(archiveEntryName(it->first))
+                               : removed_paths.count(it->first) == 0 && pathExists(snapshot_, it->first);
+        if (!exists) {
+          it = cache_.output_to_source.erase(it);
+        } else {
+          ++it;
+        }
       }
+
+      CLILogger::info("Pruned " + std::to_string(files_removed) + " orphaned files");
     }
+    if (files_removed > 0 || !deleted_sources.empty()) {
+      save();
+    }
+  }
 
-    // Save updated cache
-    saveImmediately();
-    CLILogger::info("Pruned " + std::to_string(files_removed) + " orphaned files");
-  } else if (dry_run && total_orphaned > 0) {
+  if (dry_run && total_orphaned > 0) {
     CLILogger::info("Would prune " + std::to_string(total_orphaned) + " orphaned files");
   }
 
@@ -356,143 +1162,199 @@ size_t DocumentationCache::pruneOrphanedFiles(const std::string& extract_dir, bo
 }
 
 std::pair<size_t, size_t> DocumentationCache::getStats() const {
+  size_t total_files = 0;
   size_t total_generated = 0;
-  for (const auto& [path, metadata] : cache_.files) {
-    total_generated += metadata.generated_files.size();
+  forEachRecord([&](const BinaryCacheRecord& record) {
+    total_files++;
+    total_generated += record.generated_files.size();
+  });
+  return {total_files, total_generated};
+}
+
+bool DocumentationCache::parseHashPolicy(const std::string& name, HashPolicy& policy) {
+  if (name == "stat") {
+    policy = HashPolicy::Stat;
+    return true;
   }
-  return {cache_.files.size(), total_generated};
+  if (name == "content") {
+    policy = HashPolicy::Content;
+    return true;
+  }
+  return false;
+}
+
+bool DocumentationCache::parseFormat(const std::string& name, CacheFormat& format) {
+  if (name == "json") {
+    format = CacheFormat::Json;
+    return true;
+  }
+  if (name == "binary") {
+    format = CacheFormat::Binary;
+    return true;
+  }
+  return false;
 }
 
 void DocumentationCache::clear() {
   cache_.files.clear();
   cache_.output_to_source.clear();
+  removed_.clear();
+  base_.reset();
+  changed_memo_.clear();
+  dependency_memo_.clear();
   cache_.last_updated = std::chrono::system_clock::now();
+  truncateJournal();
 }
 
 std::string DocumentationCache::calculateFileHash(const std::string& file_path) const {
-  try {
-    std::ifstream file(file_path, std::ios::binary);
-    if (!file.is_open()) {
-      CLILogger::warning("DocumentationCache::calculateFileHash: Failed to open file for hashing: " + file_path);
-      return "";
-    }
-
-    std::string content((std::istreambuf_iterator<char>(file)),
-                       std::istreambuf_iterator<char>());
-    file.close();
-    
-    std::string hash = simpleHash(content);
-    CLILogger::debug("DocumentationCache::calculateFileHash: Calculated hash for " + file_path + " (" + std::to_string(content.length()) + " bytes): " + hash);
-    return hash;
-  } catch (const std::exception& e) {
-    CLILogger::error("DocumentationCache::calculateFileHash: Exception calculating hash for file: " + file_path + " - " + e.what());
+  std::optional<std::string> hash = hashing::hashFile(file_path);
+  if (!hash) {
+    CLILogger::warning("DocumentationCache::calculateFileHash: Failed to read file for hashing: " + file_path);
     return "";
   }
+  LOG_DEBUG("DocumentationCache::calculateFileHash: Calculated hash for " + file_path + ": " + *hash);
+  return *hash;
 }
 
-std::string DocumentationCache::cacheToJson() const {
-  // For now, return a simple JSON structure
-  // In a full implementation, would use a proper JSON library
-  std::stringstream ss;
-  ss << "{\n";
-  ss << "  \"version\": \"" << cache_.version << "\",\n";
-  ss << "  \"last_updated\": " << std::chrono::duration_cast<std::chrono::seconds>(
-      cache_.last_updated.time_since_epoch()).count() << ",\n";
-  ss << "  \"file_count\": " << cache_.files.size() << ",\n";
-  ss << "  \"files\": {\n";
-
-  bool first = true;
-  for (const auto& [path, metadata] : cache_.files) {
-    if (!first) ss << ",\n";
-    first = false;
-
-    ss << "    \"" << path << "\": {\n";
-    ss << "      \"content_hash\": \"" << metadata.content_hash << "\",\n";
-    ss << "      \"last_modified\": \"" << metadata.last_modified_str << "\",\n";
-    ss << "      \"construct_count\": " << metadata.construct_count << ",\n";
-    ss << "      \"language\": \"" << metadata.language << "\",\n";
-    ss << "      \"generated_files\": [";
+JsonDoc DocumentationCache::cacheToJson() const {
+  JsonDoc json;
+  yyjson_mut_doc* doc = json.mutableDoc();
+  yyjson_mut_val* root = yyjson_mut_doc_get_root(doc);
+  yyjson_mut_obj_add_strncpy(doc, root, "version", cache_.version.data(), cache_.version.size());
+  yyjson_mut_obj_add_sint(doc, root, "last_updated", std::chrono::duration_cast<std::chrono::seconds>(
+      cache_.last_updated.time_since_epoch()).count());
+  yyjson_mut_obj_add_uint(doc, root, "file_count", getStats().first);
+
+  yyjson_mut_val* files = yyjson_mut_obj_add_obj(doc, root, "files");
+  forEachRecord([&](const BinaryCacheRecord& record) {
+    yyjson_mut_val* key = yyjson_mut_strncpy(doc, record.source_path.data(), record.source_path.size());
+    yyjson_mut_val* entry = yyjson_mut_obj(doc);
+    addEntryFields(doc, entry, record);
+    yyjson_mut_obj_add(files, key, entry);
+  });
+  return json;
+}
 
-    bool first_file = true;
-    for (const auto& gen_file : metadata.generated_files) {
-      if (!first_file) ss << ", ";
-      first_file = false;
-      ss << "\"" << gen_file << "\"";
-    }
-    ss << "]\n";
-    ss << "    }";
+std::string DocumentationCache::calculateDirectoryHash(const std::string& extract_dir) const {
+  std::optional<std::vector<FsEntry>> listing = listDirectory(snapshot_, extract_dir);
+  if (!listing) {
+    CLILogger::error("Failed to calculate directory hash: cannot list " + extract_dir);
+    return "";
   }
+  return directoryDigest(*listing);
+}
 
-  ss << "\n  }\n";
-  ss << "}";
+std::string DocumentationCache::integrityStampPath(const std::string& extract_dir) {
+  return (std::filesystem::path(extract_dir) / kIntegrityStampName).string();
+}
 
-  return ss.str();
+bool DocumentationCache::exportJson(const std::string& output_path) const {
+  if (!cacheToJson().writeToFile(output_path)) {
+    CLILogger::error("DocumentationCache::exportJson: Failed to write file: " + output_path);
+    return false;
+  }
+  return true;
 }
 
-std::string DocumentationCache::calculateDirectoryHash(const std::string& extract_dir) const {
+bool DocumentationCache::verifyIntegrity(const std::string& extract_dir) const {
   try {
-    std::vector<std::pair<std::string, std::string>> file_times;
-
-    // Collect all .md files with their timestamps
-    if (std::filesystem::exists(extract_dir)) {
-      for (const auto& entry : std::filesystem::directory_iterator(extract_dir)) {
-        if (entry.is_regular_file() && entry.path().extension() == ".md") {
-          auto timestamp = std::filesystem::last_write_time(entry.path());
-          std::string time_str = fileTimeToString(timestamp);
-          file_times.push_back({entry.path().filename().string(), time_str});
+    // Archive mode checks against the archive index instead of stat-ing every page
+    if (output_mode_ == OutputMode::Archive) {
+      SnippetArchive archive;
+      archive.open(snippetArchivePath(extract_dir));
+      std::vector<std::string> cached_files;
+      bool missing_file = false;
+      forEachRecord([&](const BinaryCacheRecord& record) {
+        for (const auto& generated_file : record.generated_files) {
+          if (missing_file) return;
+          if (!archive.contains(archiveEntryName(generated_file))) {
+            CLILogger::warning("Cache integrity issue: Missing generated file: " + std::string(generated_file));
+            missing_file = true;
+            return;
+          }
+          cached_files.emplace_back(fileName(generated_file));
+        }
+      });
+      if (missing_file) {
+        return false;
+      }
+      std::sort(cached_files.begin(), cached_files.end());
+      for (size_t i = 0; i < archive.size(); ++i) {
+        std::string_view name = archive.nameAt(i);
+        if (!std::binary_search(cached_files.begin(), cached_files.end(), name, std::less<>())) {
+          CLILogger::warning("Cache integrity issue: Orphaned archived page: " + std::string(name));
+          return false;
         }
       }
+      return true;
     }
 
-    // Sort for consistent hashing
-    std::sort(file_times.begin(), file_times.end());
-
-    // Create hash from sorted filenames and timestamps
-    std::string combined;
-    for (const auto& [filename, timestamp] : file_times) {
-      combined += filename + ":" + timestamp + ";";
+    std::optional<std::vector<FsEntry>> listing = listDirectory(snapshot_, extract_dir);
+    if (!listing) {
+      CLILogger::error("Failed to verify cache integrity: cannot list " + extract_dir);
+      return false;
     }
 
-    return calculateFileHash("/tmp/hash_content"); // Placeholder - in real implementation would hash the combined string
-  } catch (const std::exception& e) {
-    CLILogger::error("Failed to calculate directory hash: " + std::string(e.what()));
-    return "";
-  }
-}
-
-bool DocumentationCache::verifyIntegrity(const std::string& extract_dir) const {
-  try {
-    // Check that all cached generated files still exist
-    for (const auto& [source_path, metadata] : cache_.files) {
-      for (const auto& generated_file : metadata.generated_files) {
-        if (!std::filesystem::exists(generated_file)) {
-          CLILogger::warning("Cache integrity issue: Missing generated file: " + generated_file);
-          return false;
+    // Pages directly in the extract directory are checked with one merge against the listing; any
+    // elsewhere are looked up one by one
+    std::string_view dir = withoutTrailingSeparator(extract_dir);
+    std::vector<std::string_view> cached_names;
+    std::vector<std::string_view> names_elsewhere;
+    uint64_t index_sum = 0;
+    bool missing_file = false;
+    forEachRecord([&](const BinaryCacheRecord& record) {
+      for (const auto& generated_file : record.generated_files) {
+        if (missing_file) return;
+        std::string_view path = generated_file;
+        index_sum += hashing::xxh64(path);
+        std::string_view name = nameInDirectory(path, dir);
+        if (!name.empty()) {
+          cached_names.push_back(name);
+        } else if (pathExists(snapshot_, path)) {
+          names_elsewhere.push_back(fileName(path));
+        } else {
+          CLILogger::warning("Cache integrity issue: Missing generated file: " + std::string(path));
+          missing_file = true;
         }
       }
+    });
+    if (missing_file) {
+      return false;
     }
 
-    // Check for orphaned files in extract directory
-    std::set<std::string> cached_files;
-    for (const auto& [source_path, metadata] : cache_.files) {
-      for (const auto& generated_file : metadata.generated_files) {
-        std::filesystem::path p(generated_file);
-        cached_files.insert(p.filename().string());
+    // The directory and the cache index both match the last verified state, so nothing can differ
+    std::string stamp = integrityStamp(*listing, index_sum);
+    {
+      std::ifstream stamp_file(integrityStampPath(extract_dir), std::ios::binary);
+      std::string recorded((std::istreambuf_iterator<char>(stamp_file)), std::istreambuf_iterator<char>());
+      if (recorded == stamp) {
+        LOG_DEBUG("DocumentationCache::verifyIntegrity: Unchanged since the last verification");
+        return true;
       }
     }
 
-    if (std::filesystem::exists(extract_dir)) {
-      for (const auto& entry : std::filesystem::directory_iterator(extract_dir)) {
-        if (entry.is_regular_file() && entry.path().extension() == ".md") {
-          std::string filename = entry.path().filename().string();
-          if (cached_files.find(filename) == cached_files.end()) {
-            CLILogger::warning("Cache integrity issue: Orphaned file: " + filename);
-            return false;
-          }
-        }
+    std::sort(cached_names.begin(), cached_names.end());
+    cached_names.erase(std::unique(cached_names.begin(), cached_names.end()), cached_names.end());
+    std::sort(names_elsewhere.begin(), names_elsewhere.end());
+    std::vector<std::string_view> listed_names = listedPageNames(*listing);
+
+    size_t cached_index = 0;
+    for (std::string_view listed : listed_names) {
+      if (cached_index < cached_names.size() && cached_names[cached_index] < listed) {
+        CLILogger::warning("Cache integrity issue: Missing generated file: " + std::string(cached_names[cached_index]));
+        return false;
+      }
+      if (cached_index < cached_names.size() && cached_names[cached_index] == listed) {
+        cached_index++;
+      } else if (!std::binary_search(names_elsewhere.begin(), names_elsewhere.end(), listed)) {
+        CLILogger::warning("Cache integrity issue: Orphaned file: " + std::string(listed));
+        return false;
       }
     }
-
+    if (cached_index < cached_names.size()) {
+      CLILogger::warning("Cache integrity issue: Missing generated file: " + std::string(cached_names[cached_index]));
+      return false;
+    }
     return true;
   } catch (const std::exception& e) {
     CLILogger::error("Failed to verify cache integrity: " + std::string(e.what()));
@@ -500,32 +1362,62 @@ bool DocumentationCache::verifyIntegrity(const std::string& extract_dir) const {
   }
 }
 
-bool DocumentationCache::cacheFromJson(const std::string& json_str) {
-  CLILogger::debug("DocumentationCache::cacheFromJson: Parsing JSON cache data (" + std::to_string(json_str.length()) + " bytes)");
+bool DocumentationCache::recordIntegrity(const std::string& extract_dir) {
+  // Archive mode compares against the archive index and keeps no stamp
+  if (output_mode_ == OutputMode::Archive) {
+    return true;
+  }
+
+  std::optional<std::vector<FsEntry>> listing = listDirectory(snapshot_, extract_dir);
+  if (!listing) {
+    return false;
+  }
+  uint64_t index_sum = 0;
+  forEachRecord([&](const BinaryCacheRecord& record) {
+    for (const auto& generated_file : record.generated_files) {
+      index_sum += hashing::xxh64(generated_file);
+    }
+  });
+
+  std::string stamp = integrityStamp(*listing, index_sum);
+  std::string stamp_path = integrityStampPath(extract_dir);
+  {
+    std::ifstream stamp_file(stamp_path, std::ios::binary);
+    std::string recorded((std::istreambuf_iterator<char>(stamp_file)), std::istreambuf_iterator<char>());
+    if (recorded == stamp) {
+      return true;
+    }
+  }
+  if (!writeWholeFile(stamp_path, stamp)) {
+    LOG_DEBUG("DocumentationCache::recordIntegrity: Could not record the verified state in " + stamp_path);
+    return false;
+  }
+  return true;
+}
+
+bool DocumentationCache::cacheFromJson(std::string& json_str) {
+  LOG_DEBUG("DocumentationCache::cacheFromJson: Parsing JSON cache data (" + std::to_string(json_str.length()) + " bytes)");
   
   try {
-    // Parse JSON string directly with yyjson
-    yyjson_doc* doc = yyjson_read(json_str.c_str(), json_str.length(), 0);
-    if (!doc) {
+    // Parsed in place: every string is copied into the entries before the buffer goes away
+    std::optional<JsonDoc> json_doc = JsonDoc::parseInSitu(json_str);
+    if (!json_doc) {
       CLILogger::error("DocumentationCache::cacheFromJson: Failed to parse cache JSON");
       return false;
     }
     
-    CLILogger::debug("DocumentationCache::cacheFromJson: Successfully parsed JSON document");
-
-    // Wrap in JsonDoc for easier access
-    JsonDoc json_doc(doc);
-    const JsonDoc& doc_ref = json_doc;
+    LOG_DEBUG("DocumentationCache::cacheFromJson: Successfully parsed JSON document");
+    const JsonDoc& doc_ref = *json_doc;
 
     // Clear existing cache
-    CLILogger::debug("DocumentationCache::cacheFromJson: Clearing existing cache data");
+    LOG_DEBUG("DocumentationCache::cacheFromJson: Clearing existing cache data");
     cache_.files.clear();
     cache_.output_to_source.clear();
 
     // Parse version
     if (!doc_ref["version"].isNull()) {
       cache_.version = doc_ref["version"].asString();
-      CLILogger::debug("DocumentationCache::cacheFromJson: Cache version: " + cache_.version);
+      LOG_DEBUG("DocumentationCache::cacheFromJson: Cache version: " + cache_.version);
     }
 
     // Parse last_updated
@@ -537,43 +1429,23 @@ bool DocumentationCache::cacheFromJson(const std::string& json_str) {
     // Parse files
     JsonValue files_obj = doc_ref["files"];
     if (!files_obj.isNull()) {
-      CLILogger::debug("DocumentationCache::cacheFromJson: Parsing file entries");
-      files_obj.forEachObject([&](const std::string& source_path, JsonValue file_data) {
-        CLILogger::debug("DocumentationCache::cacheFromJson: Processing file: " + source_path);
-        FileMetadata metadata;
-        metadata.source_path = source_path;
-
-        if (!file_data["content_hash"].isNull()) {
-          metadata.content_hash = file_data["content_hash"].asString();
-        }
-        if (!file_data["last_modified"].isNull()) {
-          metadata.last_modified_str = file_data["last_modified"].asString();
-        }
-        if (!file_data["construct_count"].isNull()) {
-          metadata.construct_count = file_data["construct_count"].asInt();
-        }
-        if (!file_data["language"].isNull()) {
-          metadata.language = file_data["language"].asString();
-        }
-
-        // Parse generated_files array
-        JsonValue gen_files = file_data["generated_files"];
-        if (!gen_files.isNull()) {
-          gen_files.forEachArray([&](size_t index, JsonValue file_path) {
-            (void)index; // Unused
-            std::string path = file_path.asString();
-            metadata.generated_files.push_back(path);
-            // Build output_to_source mapping
-            cache_.output_to_source[path] = source_path;
-          });
+      LOG_DEBUG("DocumentationCache::cacheFromJson: Parsing file entries");
+      for (auto [source_key, file_data] : files_obj.members()) {
+        std::string source_path(source_key);
+        LOG_DEBUG("DocumentationCache::cacheFromJson: Processing file: " + source_path);
+        FileMetadata metadata = parseEntryFields(source_path, file_data);
+
+        // Build output_to_source mapping
+        for (const auto& path : metadata.generated_files) {
+          cache_.output_to_source[path] = source_path;
         }
 
-        cache_.files[source_path] = metadata;
-        CLILogger::debug("DocumentationCache::cacheFromJson: Successfully parsed entry for: " + source_path + " (" + std::to_string(metadata.generated_files.size()) + " generated files)");
-      });
+        LOG_DEBUG("DocumentationCache::cacheFromJson: Successfully parsed entry for: " + source_path + " (" + std::to_string(metadata.generated_files.size()) + " generated files)");
+        cache_.files[std::move(source_path)] = std::move(metadata);
+      }
     }
 
-    CLILogger::debug("DocumentationCache::cacheFromJson: Successfully parsed cache with " + std::to_string(cache_.files.size()) + " entries");
+    LOG_DEBUG("DocumentationCache::cacheFromJson: Successfully parsed cache with " + std::to_string(cache_.files.size()) + " entries");
     return true;
   } catch (const std::exception& e) {
     CLILogger::error("DocumentationCache::cacheFromJson: Exception parsing cache JSON: " + std::string(e.what()));
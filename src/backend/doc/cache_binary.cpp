@@ -0,0 +1,306 @@
+/**
+@brief Binary documentation cache format implementation
+*/
+#include <backend/doc/cache_binary.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace {
+  constexpr char kMagic[8] = {'C', 'S', 'M', 'C', 'A', 'C', 'H', 'E'};
+  constexpr size_t kHeaderSize = 64;
+  constexpr size_t kRecordSize = 88;
+  constexpr size_t kRefSize = 8;
+
+  // Header field offsets
+  constexpr size_t kHeaderVersion = 8;
+  constexpr size_t kHeaderLastUpdated = 16;
+  constexpr size_t kHeaderRecordCount = 24;
+  constexpr size_t kHeaderGeneratedCount = 32;
+  constexpr size_t kHeaderStringsSize = 40;
+  constexpr size_t kHeaderVersionRef = 48;
+
+  // Record field offsets
+  constexpr size_t kRecordPath = 0;
+  constexpr size_t kRecordHash = 8;
+  constexpr size_t kRecordModified = 16;
+  constexpr size_t kRecordLanguage = 24;
+  constexpr size_t kRecordMtime = 32;
+  constexpr size_t kRecordSizeField = 40;
+  constexpr size_t kRecordInode = 48;
+  constexpr size_t kRecordConstructs = 56;
+  constexpr size_t kRecordGeneratedBegin = 64;
+  constexpr size_t kRecordGeneratedCount = 68;
+  constexpr size_t kRecordDependencyBegin = 72;
+  constexpr size_t kRecordDependencyCount = 76;
+  constexpr size_t kRecordHashesBegin = 80;
+  constexpr size_t kRecordHashesCount = 84;
+
+  uint64_t load64(const unsigned char* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) value = (value << 8) | p[i];
+    return value;
+  }
+
+  uint32_t load32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  void append64(std::string& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+  }
+
+  void append32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+  }
+
+  uint64_t packRef(uint32_t offset, uint32_t length) {
+    return (static_cast<uint64_t>(offset) << 32) | length;
+  }
+
+  // Deduplicating string table builder
+  class StringTable {
+    public:
+      uint64_t intern(std::string_view text) {
+        auto it = refs_.find(text);
+        if (it != refs_.end()) return it->second;
+        uint64_t ref = packRef(static_cast<uint32_t>(bytes_.size()), static_cast<uint32_t>(text.size()));
+        bytes_.append(text);
+        // Key views point into the callers' records, which outlive the table
+        refs_.emplace(text, ref);
+        return ref;
+      }
+
+      const std::string& bytes() const { return bytes_; }
+
+    private:
+      std::string bytes_;
+      std::unordered_map<std::string_view, uint64_t> refs_;
+  };
+}
+
+BinaryCacheRecord BinaryCacheRecord::fromMetadata(const FileMetadata& metadata) {
+  BinaryCacheRecord record;
+  record.source_path = metadata.source_path;
+  record.content_hash = metadata.content_hash;
+  record.last_modified = metadata.last_modified_str;
+  record.language = metadata.language;
+  record.mtime_ticks = metadata.mtime_ticks;
+  record.file_size = metadata.file_size;
+  record.inode = metadata.inode;
+  record.construct_count = metadata.construct_count;
+  record.generated_files.assign(metadata.generated_files.begin(), metadata.generated_files.end());
+  record.output_hashes.assign(metadata.output_hashes.begin(), metadata.output_hashes.end());
+  record.dependencies.assign(metadata.dependencies.begin(), metadata.dependencies.end());
+  return record;
+}
+
+FileMetadata BinaryCacheRecord::toMetadata() const {
+  FileMetadata metadata;
+  metadata.source_path = std::string(source_path);
+  metadata.content_hash = std::string(content_hash);
+  metadata.last_modified_str = std::string(last_modified);
+  metadata.language = std::string(language);
+  metadata.mtime_ticks = mtime_ticks;
+  metadata.file_size = file_size;
+  metadata.inode = inode;
+  metadata.construct_count = static_cast<size_t>(construct_count);
+  metadata.generated_files.reserve(generated_files.size());
+  for (const auto& generated_file : generated_files) {
+    metadata.generated_files.emplace_back(generated_file);
+  }
+  metadata.output_hashes.reserve(output_hashes.size());
+  for (const auto& output_hash : output_hashes) {
+    metadata.output_hashes.emplace_back(output_hash);
+  }
+  metadata.dependencies.reserve(dependencies.size());
+  for (const auto& dependency : dependencies) {
+    metadata.dependencies.emplace_back(dependency);
+  }
+  return metadata;
+}
+
+bool BinaryCacheView::open(const std::string& path) {
+  close();
+  if (!file_.open(path)) {
+    return false;
+  }
+
+  const unsigned char* data = file_.data();
+  size_t size = file_.size();
+  if (size < kHeaderSize || std::memcmp(data, kMagic, sizeof(kMagic)) != 0 ||
+      load32(data + kHeaderVersion) != kFormatVersion) {
+    close();
+    return false;
+  }
+
+  uint64_t record_count = load64(data + kHeaderRecordCount);
+  uint64_t generated_count = load64(data + kHeaderGeneratedCount);
+  uint64_t strings_size = load64(data + kHeaderStringsSize);
+
+  // Reject counts that cannot fit before doing any offset arithmetic with them
+  if (record_count > size / kRecordSize || generated_count > size / kRefSize || strings_size > size) {
+    close();
+    return false;
+  }
+  size_t generated_offset = kHeaderSize + static_cast<size_t>(record_count) * kRecordSize;
+  size_t strings_offset = generated_offset + static_cast<size_t>(generated_count) * kRefSize;
+  if (strings_offset > size || strings_size > size - strings_offset) {
+    close();
+    return false;
+  }
+
+  record_count_ = static_cast<size_t>(record_count);
+  generated_count_ = static_cast<size_t>(generated_count);
+  records_offset_ = kHeaderSize;
+  generated_offset_ = generated_offset;
+  strings_offset_ = strings_offset;
+  strings_size_ = static_cast<size_t>(strings_size);
+  last_updated_ = static_cast<int64_t>(load64(data + kHeaderLastUpdated));
+  version_ref_ = load64(data + kHeaderVersionRef);
+  return true;
+}
+
+void BinaryCacheView::close() {
+  file_.close();
+  record_count_ = 0;
+  generated_count_ = 0;
+  strings_size_ = 0;
+}
+
+std::string_view BinaryCacheView::version() const {
+  return stringAt(version_ref_);
+}
+
+std::string_view BinaryCacheView::stringAt(uint64_t ref) const {
+  size_t offset = static_cast<size_t>(ref >> 32);
+  size_t length = static_cast<size_t>(ref & 0xFFFFFFFFu);
+  if (offset > strings_size_ || length > strings_size_ - offset) {
+    return {};
+  }
+  return std::string_view(reinterpret_cast<const char*>(file_.data() + strings_offset_ + offset), length);
+}
+
+std::string_view BinaryCacheView::sourcePathAt(size_t index) const {
+  if (index >= record_count_) return {};
+  return stringAt(load64(file_.data() + records_offset_ + index * kRecordSize + kRecordPath));
+}
+
+std::optional<size_t> BinaryCacheView::indexOf(std::string_view source_path) const {
+  size_t low = 0;
+  size_t high = record_count_;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    int order = sourcePathAt(mid).compare(source_path);
+    if (order == 0) return mid;
+    if (order < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return std::nullopt;
+}
+
+BinaryCacheRecord BinaryCacheView::recordAt(size_t index) const {
+  BinaryCacheRecord record;
+  if (index >= record_count_) return record;
+
+  const unsigned char* p = file_.data() + records_offset_ + index * kRecordSize;
+  record.source_path = stringAt(load64(p + kRecordPath));
+  record.content_hash = stringAt(load64(p + kRecordHash));
+  record.last_modified = stringAt(load64(p + kRecordModified));
+  record.language = stringAt(load64(p + kRecordLanguage));
+  record.mtime_ticks = static_cast<int64_t>(load64(p + kRecordMtime));
+  record.file_size = load64(p + kRecordSizeField);
+  record.inode = load64(p + kRecordInode);
+  record.construct_count = load64(p + kRecordConstructs);
+
+  record.generated_files = pathsAt(load32(p + kRecordGeneratedBegin), load32(p + kRecordGeneratedCount));
+  record.dependencies = pathsAt(load32(p + kRecordDependencyBegin), load32(p + kRecordDependencyCount));
+  record.output_hashes = pathsAt(load32(p + kRecordHashesBegin), load32(p + kRecordHashesCount));
+  return record;
+}
+
+std::vector<std::string_view> BinaryCacheView::pathsAt(size_t begin, size_t count) const {
+  std::vector<std::string_view> paths;
+  if (begin <= generated_count_ && count <= generated_count_ - begin) {
+    paths.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      paths.push_back(stringAt(load64(file_.data() + generated_offset_ + (begin + i) * kRefSize)));
+    }
+  }
+  return paths;
+}
+
+bool writeBinaryCache(const std::string& path, const std::string& version, int64_t last_updated,
+                      std::vector<BinaryCacheRecord> records) {
+  std::sort(records.begin(), records.end(), [](const BinaryCacheRecord& a, const BinaryCacheRecord& b) {
+    return a.source_path < b.source_path;
+  });
+
+  StringTable strings;
+  uint64_t version_ref = strings.intern(version);
+
+  std::string record_bytes;
+  std::string generated_bytes;
+  record_bytes.reserve(records.size() * kRecordSize);
+  uint32_t generated_count = 0;
+
+  for (const auto& record : records) {
+    append64(record_bytes, strings.intern(record.source_path));
+    append64(record_bytes, strings.intern(record.content_hash));
+    append64(record_bytes, strings.intern(record.last_modified));
+    append64(record_bytes, strings.intern(record.language));
+    append64(record_bytes, static_cast<uint64_t>(record.mtime_ticks));
+    append64(record_bytes, record.file_size);
+    append64(record_bytes, record.inode);
+    append64(record_bytes, record.construct_count);
+    append32(record_bytes, generated_count);
+    append32(record_bytes, static_cast<uint32_t>(record.generated_files.size()));
+    uint32_t dependency_begin = generated_count + static_cast<uint32_t>(record.generated_files.size());
+    append32(record_bytes, dependency_begin);
+    append32(record_bytes, static_cast<uint32_t>(record.dependencies.size()));
+    append32(record_bytes, dependency_begin + static_cast<uint32_t>(record.dependencies.size()));
+    append32(record_bytes, static_cast<uint32_t>(record.output_hashes.size()));
+
+    for (const auto& generated_file : record.generated_files) {
+      append64(generated_bytes, strings.intern(generated_file));
+    }
+    for (const auto& dependency : record.dependencies) {
+      append64(generated_bytes, strings.intern(dependency));
+    }
+    for (const auto& output_hash : record.output_hashes) {
+      append64(generated_bytes, strings.intern(output_hash));
+    }
+    generated_count += static_cast<uint32_t>(record.generated_files.size() + record.dependencies.size() +
+                                             record.output_hashes.size());
+  }
+
+  std::string header(kMagic, sizeof(kMagic));
+  append32(header, BinaryCacheView::kFormatVersion);
+  append32(header, 0);
+  append64(header, static_cast<uint64_t>(last_updated));
+  append64(header, records.size());
+  append64(header, generated_count);
+  append64(header, strings.bytes().size());
+  append64(header, version_ref);
+  header.resize(kHeaderSize, '\0');
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.write(header.data(), static_cast<std::streamsize>(header.size()));
+  file.write(record_bytes.data(), static_cast<std::streamsize>(record_bytes.size()));
+  file.write(generated_bytes.data(), static_cast<std::streamsize>(generated_bytes.size()));
+  file.write(strings.bytes().data(), static_cast<std::streamsize>(strings.bytes().size()));
+  file.close();
+  return !file.fail();
+}
@@ -9,43 +9,43 @@
 namespace CesiumDoc {
 
 std::string findDefaultConfigFile() {
-  CLILogger::debug("findDefaultConfigFile: Searching for default configuration files in current directory");
+  LOG_DEBUG("findDefaultConfigFile: Searching for default configuration files in current directory");
   
   // Check for both config files
   bool has_jsonc = std::filesystem::exists("cesium-doc-config.jsonc");
   bool has_json = std::filesystem::exists("cesium-doc-config.json");
   
-  CLILogger::debug("findDefaultConfigFile: cesium-doc-config.jsonc exists: " + std::string(has_jsonc ? "true" : "false"));
-  CLILogger::debug("findDefaultConfigFile: cesium-doc-config.json exists: " + std::string(has_json ? "true" : "false"));
+  LOG_DEBUG("findDefaultConfigFile: cesium-doc-config.jsonc exists: " + std::string(has_jsonc ? "true" : "false"));
+  LOG_DEBUG("findDefaultConfigFile: cesium-doc-config.json exists: " + std::string(has_json ? "true" : "false"));
   
   if (has_jsonc && has_json) {
     CLILogger::warning("Both cesium-doc-config.json and cesium-doc-config.jsonc exist. Using cesium-doc-config.jsonc (preferred)");
-    CLILogger::debug("findDefaultConfigFile: Selected cesium-doc-config.jsonc due to preference");
+    LOG_DEBUG("findDefaultConfigFile: Selected cesium-doc-config.jsonc due to preference");
     return "cesium-doc-config.jsonc";
   }
   
   if (has_jsonc) {
-    CLILogger::debug("findDefaultConfigFile: Selected cesium-doc-config.jsonc");
+    LOG_DEBUG("findDefaultConfigFile: Selected cesium-doc-config.jsonc");
     return "cesium-doc-config.jsonc";
   }
   
   if (has_json) {
-    CLILogger::debug("findDefaultConfigFile: Selected cesium-doc-config.json");
+    LOG_DEBUG("findDefaultConfigFile: Selected cesium-doc-config.json");
     return "cesium-doc-config.json";
   }
   
-  CLILogger::debug("findDefaultConfigFile: No default configuration files found");
+  LOG_DEBUG("findDefaultConfigFile: No default configuration files found");
   return "";
 }
 
 std::string validateAndResolveConfig(const std::string& config_path, bool config_specified) {
-  CLILogger::debug("validateAndResolveConfig: Starting config resolution for path: '" + config_path + "', specified: " + std::string(config_specified ? "true" : "false"));
+  LOG_DEBUG("validateAndResolveConfig: Starting config resolution for path: '" + config_path + "', specified: " + std::string(config_specified ? "true" : "false"));
   
   std::string resolved_path = config_path;
 
   // If config was explicitly specified, validate it exists
   if (config_specified) {
-    CLILogger::debug("validateAndResolveConfig: Validating explicitly specified config file: " + resolved_path);
+    LOG_DEBUG("validateAndResolveConfig: Validating explicitly specified config file: " + resolved_path);
     if (!std::filesystem::exists(resolved_path)) {
       CLILogger::error("validateAndResolveConfig: Specified configuration file does not exist: " + resolved_path);
       return "";
@@ -54,17 +54,17 @@ std::string validateAndResolveConfig(const std::string& config_path, bool config
       CLILogger::error("validateAndResolveConfig: Specified configuration path is not a file: " + resolved_path);
       return "";
     }
-    CLILogger::debug("validateAndResolveConfig: Successfully validated specified config file: " + resolved_path);
+    LOG_DEBUG("validateAndResolveConfig: Successfully validated specified config file: " + resolved_path);
     return resolved_path;
   }
 
   // If no config was specified, check for default config file
-  CLILogger::debug("validateAndResolveConfig: No config specified, searching for default config files");
+  LOG_DEBUG("validateAndResolveConfig: No config specified, searching for default config files");
   resolved_path = findDefaultConfigFile();
   if (!resolved_path.empty()) {
     std::string absolute_path = std::filesystem::absolute(resolved_path).string();
     CLILogger::print("Using default configuration file: " + absolute_path);
-    CLILogger::debug("validateAndResolveConfig: Successfully resolved default config to: " + absolute_path);
+    LOG_DEBUG("validateAndResolveConfig: Successfully resolved default config to: " + absolute_path);
     return resolved_path;
   } else {
     CLILogger::error("validateAndResolveConfig: No configuration file specified and no default config found.");
@@ -73,16 +73,24 @@ std::string validateAndResolveConfig(const std::string& config_path, bool config
   }
 }
 
-std::optional<JsonDoc> loadConfig(const std::string& config_path) {
-  CLILogger::debug("loadConfig: Attempting to load configuration from: " + config_path);
+std::optional<Config> loadConfig(const std::string& config_path) {
+  LOG_DEBUG("loadConfig: Attempting to load configuration from: " + config_path);
   
-  auto config = JsonDoc::fromFile(config_path);
-  if (!config) {
+  auto document = JsonDoc::fromFile(config_path);
+  if (!document) {
     CLILogger::error("loadConfig: Failed to load configuration from: " + config_path);
-    return config;
+    return std::nullopt;
   }
+
+  Config config;
+  config.path = config_path;
+  config.json = std::move(*document);
+  const JsonDoc& json = config.json;
+  config.extract_directory = static_cast<std::string>(json["extract_directory"]);
+  config.output_directory = static_cast<std::string>(json["output_directory"]);
+  config.source_directories = json["source_directories"].asStringArray();
   
-  CLILogger::debug("loadConfig: Successfully loaded configuration from: " + config_path);
+  LOG_DEBUG("loadConfig: Successfully loaded configuration from: " + config_path);
   return config;
 }
 
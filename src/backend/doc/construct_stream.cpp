@@ -0,0 +1,217 @@
+/**
+@brief Streaming JSON and NDJSON export of extracted code constructs, and their on-disk spill
+*/
+#include <backend/doc/construct_stream.h>
+#include <filesystem>
+#include <backend/core/json.h>
+
+namespace {
+  const char* constructTypeName(ConstructType type) {
+    switch (type) {
+      case ConstructType::Function: return "function";
+      case ConstructType::Method: return "method";
+      case ConstructType::Class: return "class";
+      case ConstructType::Struct: return "struct";
+      case ConstructType::Enum: return "enum";
+      case ConstructType::Variable: return "variable";
+      case ConstructType::Namespace: return "namespace";
+      case ConstructType::Constructor: return "constructor";
+      case ConstructType::Destructor: return "destructor";
+      default: return "unknown";
+    }
+  }
+
+  void appendBool(std::string& out, const char* key, bool value) {
+    out += ",\"";
+    out += key;
+    out += value ? "\":true" : "\":false";
+  }
+
+  void appendStrings(std::string& out, const char* key, const std::vector<std::string>& values) {
+    out += ",\"";
+    out += key;
+    out += "\":[";
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (i > 0) out += ',';
+      out += quoteJson(values[i]);
+    }
+    out += ']';
+  }
+
+  // Appends rather than returns, so the writer can reuse one buffer for every construct
+  void appendConstruct(std::string& out, const CodeConstruct& construct) {
+    out += "{\"type\":\"";
+    out += constructTypeName(construct.type);
+    out += "\",\"name\":" + quoteJson(construct.name);
+    out += ",\"full_name\":" + quoteJson(construct.full_name);
+    out += ",\"namespace\":" + quoteJson(construct.namespace_path);
+    out += ",\"access\":" + quoteJson(construct.access_modifier);
+    out += ",\"file\":" + quoteJson(construct.filename);
+    out += ",\"start_line\":" + std::to_string(construct.start_line);
+    out += ",\"end_line\":" + std::to_string(construct.end_line);
+    out += ",\"return_type\":";
+    out += construct.return_type ? quoteJson(*construct.return_type) : "null";
+
+    out += ",\"parameters\":[";
+    for (size_t i = 0; i < construct.parameters.size(); ++i) {
+      const Parameter& param = construct.parameters[i];
+      if (i > 0) out += ',';
+      out += "{\"type\":" + quoteJson(param.type);
+      out += ",\"name\":" + quoteJson(param.name);
+      out += ",\"default\":";
+      out += param.default_value ? quoteJson(*param.default_value) : "null";
+      out += '}';
+    }
+    out += ']';
+
+    appendBool(out, "is_static", construct.is_static);
+    appendBool(out, "is_const", construct.is_const);
+    appendBool(out, "is_virtual", construct.is_virtual);
+    appendStrings(out, "base_classes", construct.base_classes);
+    out += ",\"docstring\":";
+    out += construct.docstring ? quoteJson(*construct.docstring) : "null";
+    appendStrings(out, "source_locations", construct.source_locations);
+    appendBool(out, "is_merged", construct.is_merged);
+    appendStrings(out, "merged_docstrings", construct.merged_docstrings);
+    out += '}';
+  }
+
+  bool parseConstructType(std::string_view name, ConstructType& type) {
+    for (ConstructType candidate : {ConstructType::Function, ConstructType::Method, ConstructType::Class,
+                                    ConstructType::Struct, ConstructType::Enum, ConstructType::Variable,
+                                    ConstructType::Namespace, ConstructType::Constructor, ConstructType::Destructor}) {
+      if (name == constructTypeName(candidate)) {
+        type = candidate;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::optional<std::string> optionalString(const JsonValue& value) {
+    if (!value.isString()) return std::nullopt;
+    return value.asString();
+  }
+}
+
+bool parseConstructFormat(const std::string& name, ConstructFormat& format) {
+  if (name == "json") {
+    format = ConstructFormat::Json;
+    return true;
+  }
+  if (name == "ndjson") {
+    format = ConstructFormat::Ndjson;
+    return true;
+  }
+  return false;
+}
+
+std::string constructToJson(const CodeConstruct& construct) {
+  std::string out;
+  appendConstruct(out, construct);
+  return out;
+}
+
+std::optional<CodeConstruct> constructFromJson(std::string_view text, StringInterner& strings) {
+  auto doc = JsonDoc::parse(text);
+  if (!doc) return std::nullopt;
+  JsonValue root = doc->root();
+  CodeConstruct construct{};
+  if (!root.isObject() || !parseConstructType(root["type"].asString(), construct.type)) {
+    return std::nullopt;
+  }
+
+  construct.name = root["name"].asString();
+  construct.full_name = root["full_name"].asString();
+  construct.namespace_path = strings.intern(root["namespace"].asString());
+  construct.access_modifier = strings.intern(root["access"].asString());
+  construct.filename = strings.intern(root["file"].asString());
+  construct.start_line = static_cast<uint32_t>(root["start_line"].asUint64());
+  construct.end_line = static_cast<uint32_t>(root["end_line"].asUint64());
+  if (auto return_type = optionalString(root["return_type"])) {
+    construct.return_type = strings.intern(*return_type);
+  }
+  for (JsonValue param : root["parameters"].elements()) {
+    construct.parameters.push_back({strings.intern(param["type"].asString()), param["name"].asString(),
+                                    optionalString(param["default"])});
+  }
+  construct.is_static = root["is_static"].asBool();
+  construct.is_const = root["is_const"].asBool();
+  construct.is_virtual = root["is_virtual"].asBool();
+  construct.base_classes = root["base_classes"].asStringArray();
+  construct.docstring = optionalString(root["docstring"]);
+  construct.source_locations = root["source_locations"].asStringArray();
+  construct.is_merged = root["is_merged"].asBool();
+  construct.merged_docstrings = root["merged_docstrings"].asStringArray();
+  return construct;
+}
+
+ConstructStreamWriter::ConstructStreamWriter(std::ostream& out, ConstructFormat format)
+  : out_(out), format_(format) {}
+
+void ConstructStreamWriter::write(const CodeConstruct& construct) {
+  line_.clear();
+  if (format_ == ConstructFormat::Json) {
+    line_ += count_ == 0 ? "[\n  " : ",\n  ";
+  }
+  appendConstruct(line_, construct);
+  if (format_ == ConstructFormat::Ndjson) {
+    line_ += '\n';
+  }
+  out_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+  count_++;
+}
+
+void ConstructStreamWriter::flush() {
+  out_.flush();
+}
+
+bool ConstructStreamWriter::finish() {
+  if (!finished_ && format_ == ConstructFormat::Json) {
+    out_ << (count_ == 0 ? "[]\n" : "\n]\n");
+  }
+  finished_ = true;
+  out_.flush();
+  return static_cast<bool>(out_);
+}
+
+ConstructSpill::ConstructSpill(std::string path) : path_(std::move(path)) {
+  file_.open(path_, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+}
+
+ConstructSpill::~ConstructSpill() {
+  file_.close();
+  std::error_code ec;
+  std::filesystem::remove(path_, ec);
+}
+
+bool ConstructSpill::store(const CodeConstruct& construct) {
+  if (construct.full_name.empty() || !file_.is_open()) {
+    return false;
+  }
+  line_.clear();
+  appendConstruct(line_, construct);
+  line_ += '\n';
+  file_.clear();
+  file_.seekp(static_cast<std::streamoff>(end_));
+  file_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+  if (!file_) {
+    return false;
+  }
+  offsets_[overloadSignature(construct)] = end_;
+  end_ += line_.size();
+  return true;
+}
+
+std::optional<CodeConstruct> ConstructSpill::load(const std::string& signature, StringInterner& strings) {
+  auto offset = offsets_.find(signature);
+  if (offset == offsets_.end()) {
+    return std::nullopt;
+  }
+  file_.clear();
+  file_.seekg(static_cast<std::streamoff>(offset->second));
+  if (!std::getline(file_, line_)) {
+    return std::nullopt;
+  }
+  return constructFromJson(line_, strings);
+}
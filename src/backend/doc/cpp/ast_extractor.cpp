@@ -5,152 +5,250 @@
 // #include <cstring>
 // #include <algorithm>
 // #include <iostream>
-#include <set>
-#include <map>
+#include <numeric>
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+#include <unordered_map>
 #include <backend/core/cli_utils.h>
 
 std::vector<CodeConstruct> ASTExtractor::extractConstructs(TSTree* tree, const std::string& content, const std::string& filename) {
-  CLILogger::debug("ASTExtractor::extractConstructs: Starting extraction for " + filename);
+  LOG_DEBUG("ASTExtractor::extractConstructs: Starting extraction for " + filename);
   std::vector<CodeConstruct> constructs;
   TSNode root = ts_tree_root_node(tree);
   
-  CLILogger::debug("ASTExtractor::extractConstructs: Root node type: " + std::string(ts_node_type(root)) + ", child count: " + std::to_string(ts_node_child_count(root)));
+  LOG_DEBUG("ASTExtractor::extractConstructs: Root node type: " + std::string(ts_node_type(root)) + ", child count: " + std::to_string(ts_node_child_count(root)));
+  pending_doc_ = PendingDocComment{};
+  doc_comments_.clear();
+  includes_.clear();
+  resolveSymbols(ts_tree_language(tree));
 
   extractFromNode(root, content, filename, "", constructs);
   
-  CLILogger::debug("ASTExtractor::extractConstructs: Initial extraction found " + std::to_string(constructs.size()) + " constructs");
+  LOG_DEBUG("ASTExtractor::extractConstructs: Initial extraction found " + std::to_string(constructs.size()) + " constructs");
 
   // Merge duplicate constructs from declaration and implementation
-  CLILogger::debug("ASTExtractor::extractConstructs: Starting duplicate construct merging");
-  int conflicts = mergeDuplicateConstructs(constructs);
+  LOG_DEBUG("ASTExtractor::extractConstructs: Starting duplicate construct merging");
+  int conflicts = mergeDuplicateConstructs(constructs, activeStrings());
   if (conflicts > 0) {
     CLILogger::warning("Found " + std::to_string(conflicts) + " docstring conflicts during merging");
   }
-  CLILogger::debug("ASTExtractor::extractConstructs: Merge completed, final count: " + std::to_string(constructs.size()) + " constructs");
+  LOG_DEBUG("ASTExtractor::extractConstructs: Merge completed, final count: " + std::to_string(constructs.size()) + " constructs");
 
   return constructs;
 }
 
-void ASTExtractor::extractFromNode(TSNode node, const std::string& content, const std::string& filename,
-                                  const std::string& namespace_path, std::vector<CodeConstruct>& constructs) {
-  std::string node_type = ts_node_type(node);
+StringInterner& ASTExtractor::activeStrings() {
+  if (strings_) {
+    return *strings_;
+  }
+  if (!own_strings_) {
+    own_strings_ = std::make_unique<StringInterner>();
+  }
+  return *own_strings_;
+}
+
+void ASTExtractor::resolveSymbols(const TSLanguage* language) {
+  if (symbols_.language == language) return;
+  auto lookup = [language](std::string_view name) {
+    return ts_language_symbol_for_name(language, name.data(), static_cast<uint32_t>(name.size()), true);
+  };
+  symbols_.language = language;
+  symbols_.comment = lookup("comment");
+  symbols_.preproc_include = lookup("preproc_include");
+  symbols_.function_definition = lookup("function_definition");
+  symbols_.function_declarator = lookup("function_declarator");
+  symbols_.declaration = lookup("declaration");
+  symbols_.class_specifier = lookup("class_specifier");
+  symbols_.struct_specifier = lookup("struct_specifier");
+  symbols_.enum_specifier = lookup("enum_specifier");
+  symbols_.namespace_definition = lookup("namespace_definition");
+  symbols_.qualified_identifier = lookup("qualified_identifier");
+  symbols_.identifier = lookup("identifier");
+  symbols_.type_identifier = lookup("type_identifier");
+  symbols_.primitive_type = lookup("primitive_type");
+  symbols_.template_type = lookup("template_type");
+  symbols_.destructor_name = lookup("destructor_name");
+  symbols_.parameter_list = lookup("parameter_list");
+  symbols_.parameter_declaration = lookup("parameter_declaration");
+  symbols_.optional_parameter_declaration = lookup("optional_parameter_declaration");
+  symbols_.pointer_declarator = lookup("pointer_declarator");
+  symbols_.reference_declarator = lookup("reference_declarator");
+  symbols_.type_qualifier = lookup("type_qualifier");
+}
+
+void ASTExtractor::extractFromNode(TSNode root, const std::string& content, const std::string& filename,
+                                   const std::string& namespace_path, std::vector<CodeConstruct>& constructs) {
+  // Pre-order walk with a tree cursor: sibling and child moves are O(1) and the
+  // native stack does not grow with nesting depth. Each scope frame remembers
+  // how long the namespace path was before a namespace or class added to it.
+  struct ScopeFrame {
+    uint32_t depth;        // Depth of the scope's children
+    size_t saved_length;   // Path length to restore when leaving them
+  };
+  std::vector<ScopeFrame> scopes;
+  std::string path = namespace_path;
+  uint32_t depth = 0;
+
+  TSTreeCursor cursor = ts_tree_cursor_new(root);
+  while (true) {
+    std::string_view scope_name;
+    bool descend = visitNode(ts_tree_cursor_current_node(&cursor), content, filename, path, constructs, scope_name);
+    if (descend && ts_tree_cursor_goto_first_child(&cursor)) {
+      depth++;
+      if (!scope_name.empty()) {
+        scopes.push_back({depth, path.size()});
+        if (!path.empty()) path += "::";
+        path += scope_name;
+      }
+      continue;
+    }
+
+    // Move on to the next sibling, climbing out of every subtree that is finished
+    bool finished = false;
+    while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+      if (depth == 0 || !ts_tree_cursor_goto_parent(&cursor)) {
+        finished = true;
+        break;
+      }
+      depth--;
+      while (!scopes.empty() && scopes.back().depth > depth) {
+        path.resize(scopes.back().saved_length);
+        scopes.pop_back();
+      }
+    }
+    if (finished) break;
+  }
+  ts_tree_cursor_delete(&cursor);
+}
+
+bool ASTExtractor::visitNode(TSNode node, const std::string& content, const std::string& filename,
+                             const std::string& namespace_path, std::vector<CodeConstruct>& constructs,
+                             std::string_view& scope_name) {
+  TSSymbol symbol = ts_node_symbol(node);
+
+  // Comments are leaves; in fused mode they become the pending docstring for the next construct,
+  // otherwise they are indexed for findNearbyDocstring (traversal order keeps the index sorted)
+  if (symbol == symbols_.comment) {
+    collectDocComment(node, content);
+    return false;
+  }
+
+  // Include edges feed the cache's dependency graph; the directive itself is not a construct
+  if (symbol == symbols_.preproc_include) {
+    TSNode path_node = ts_node_child_by_field_name(node, "path", 4);
+    if (!ts_node_is_null(path_node)) {
+      std::string_view path = getNodeText(path_node, content);
+      if (path.size() >= 2 && (path.front() == '"' || path.front() == '<')) {
+        path = path.substr(1, path.size() - 2);
+      }
+      if (!path.empty()) {
+        includes_.emplace_back(path);
+      }
+    }
+    return false;
+  }
   
   // Log detailed information about nodes we're processing (but only for interesting node types to avoid spam)
-  static const std::set<std::string> interesting_nodes = {
-    "function_definition", "function_declarator", "declaration", "class_specifier", 
-    "struct_specifier", "enum_specifier", "namespace_definition"
-  };
+  bool interesting = symbol == symbols_.function_definition || symbol == symbols_.function_declarator ||
+                     symbol == symbols_.declaration || symbol == symbols_.class_specifier ||
+                     symbol == symbols_.struct_specifier || symbol == symbols_.enum_specifier ||
+                     symbol == symbols_.namespace_definition;
   
-  if (interesting_nodes.count(node_type)) {
+  if (interesting) {
     TSPoint start_point = ts_node_start_point(node);
-    CLILogger::debug("ASTExtractor::extractFromNode: Processing " + node_type + " at line " + std::to_string(start_point.row + 1) + " in namespace '" + namespace_path + "'");
+    LOG_DEBUG("ASTExtractor::extractFromNode: Processing " + std::string(ts_node_type(node)) + " at line " + std::to_string(start_point.row + 1) + " in namespace '" + namespace_path + "'");
   }
 
   // Extract this node if it's a construct we care about
-  if (node_type == "function_definition") {
+  if (symbol == symbols_.function_definition) {
     // Check if this is a deleted function (e.g., "= delete")
-    std::string node_text = getNodeText(node, content);
-    if (node_text.find("= delete") != std::string::npos) {
-      CLILogger::debug("ASTExtractor::extractFromNode: Skipping deleted function at line " + std::to_string(ts_node_start_point(node).row + 1));
-      return;
+    std::string_view node_text = getNodeText(node, content);
+    if (node_text.find("= delete") != std::string_view::npos) {
+      LOG_DEBUG("ASTExtractor::extractFromNode: Skipping deleted function at line " + std::to_string(ts_node_start_point(node).row + 1));
+      return false;
     }
 
-    CLILogger::debug("Processing function_definition in " + filename + ", text preview: '" + node_text.substr(0, 50) + "...'");
+    LOG_DEBUG("Processing function_definition in " + filename + ", text preview: '" + std::string(node_text.substr(0, 50)) + "...'");
     auto function_construct = extractFunction(node, content, filename, namespace_path);
     constructs.push_back(function_construct);
-    CLILogger::debug("ASTExtractor::extractFromNode: Extracted function '" + function_construct.name + "' (" + function_construct.full_name + ")");
-    // Don't recurse into function_definition children to avoid duplicate extraction
-    return;
-  } else if (node_type == "function_declarator") {
+    LOG_DEBUG("ASTExtractor::extractFromNode: Extracted function '" + function_construct.name + "' (" + function_construct.full_name + ")");
+    // Don't descend into function_definition children to avoid duplicate extraction
+    return false;
+  } else if (symbol == symbols_.function_declarator) {
     // Handle method declarations directly
     auto method_construct = extractMethodDeclaration(node, content, filename, namespace_path);
     constructs.push_back(method_construct);
-    CLILogger::debug("ASTExtractor::extractFromNode: Extracted method declaration '" + method_construct.name + "' (" + method_construct.full_name + ")");
-    // Don't recurse into function_declarator children
-    return;
-  } else if (node_type == "declaration") {
+    LOG_DEBUG("ASTExtractor::extractFromNode: Extracted method declaration '" + method_construct.name + "' (" + method_construct.full_name + ")");
+    // Don't descend into function_declarator children
+    return false;
+  } else if (symbol == symbols_.declaration) {
     // Check if this declaration contains a function declarator (method declaration)
-    TSNode declarator = findChildByType(node, "function_declarator");
+    TSNode declarator = findChildByType(node, symbols_.function_declarator);
     if (!ts_node_is_null(declarator)) {
       auto method_construct = extractMethodDeclaration(declarator, content, filename, namespace_path);
       constructs.push_back(method_construct);
-      CLILogger::debug("ASTExtractor::extractFromNode: Extracted method declaration from general declaration '" + method_construct.name + "' (" + method_construct.full_name + ")");
-      // Don't recurse into declaration children if we found a function declarator
-      return;
+      LOG_DEBUG("ASTExtractor::extractFromNode: Extracted method declaration from general declaration '" + method_construct.name + "' (" + method_construct.full_name + ")");
+      // Don't descend into declaration children if we found a function declarator
+      return false;
     }
-  } else if (node_type == "class_specifier") {
+  } else if (symbol == symbols_.class_specifier) {
     auto class_construct = extractClass(node, content, filename, namespace_path);
     constructs.push_back(class_construct);
-    CLILogger::debug("ASTExtractor::extractFromNode: Extracted class '" + class_construct.name + "' (" + class_construct.full_name + ")");
-  } else if (node_type == "struct_specifier") {
+    LOG_DEBUG("ASTExtractor::extractFromNode: Extracted class '" + class_construct.name + "' (" + class_construct.full_name + ")");
+  } else if (symbol == symbols_.struct_specifier) {
     auto struct_construct = extractStruct(node, content, filename, namespace_path);
     constructs.push_back(struct_construct);
-    CLILogger::debug("ASTExtractor::extractFromNode: Extracted struct '" + struct_construct.name + "' (" + struct_construct.full_name + ")");
-  } else if (node_type == "enum_specifier") {
+    LOG_DEBUG("ASTExtractor::extractFromNode: Extracted struct '" + struct_construct.name + "' (" + struct_construct.full_name + ")");
+  } else if (symbol == symbols_.enum_specifier) {
     auto enum_construct = extractEnum(node, content, filename, namespace_path);
     constructs.push_back(enum_construct);
-    CLILogger::debug("ASTExtractor::extractFromNode: Extracted enum '" + enum_construct.name + "' (" + enum_construct.full_name + ")");
-  } else if (node_type == "namespace_definition") {
+    LOG_DEBUG("ASTExtractor::extractFromNode: Extracted enum '" + enum_construct.name + "' (" + enum_construct.full_name + ")");
+  } else if (symbol == symbols_.namespace_definition) {
     auto namespace_construct = extractNamespace(node, content, filename, namespace_path);
     constructs.push_back(namespace_construct);
-    CLILogger::debug("ASTExtractor::extractFromNode: Extracted namespace '" + namespace_construct.name + "' (" + namespace_construct.full_name + ")");
+    LOG_DEBUG("ASTExtractor::extractFromNode: Extracted namespace '" + namespace_construct.name + "' (" + namespace_construct.full_name + ")");
   }
 
-  // Recursively process child nodes
-  uint32_t child_count = ts_node_child_count(node);
-  if (interesting_nodes.count(node_type) && child_count > 0) {
-    CLILogger::debug("ASTExtractor::extractFromNode: Recursively processing " + std::to_string(child_count) + " children of " + node_type);
+  if (interesting && ts_node_child_count(node) > 0) {
+    LOG_DEBUG("ASTExtractor::extractFromNode: Descending into " + std::to_string(ts_node_child_count(node)) + " children of " + std::string(ts_node_type(node)));
   }
-  for (uint32_t i = 0; i < child_count; i++) {
-    TSNode child = ts_node_child(node, i);
-
-    // Update namespace path for namespace and class children
-    std::string child_namespace_path = namespace_path;
-    if (node_type == "namespace_definition") {
-      TSNode name_node = findChildByType(node, "identifier");
-      if (!ts_node_is_null(name_node)) {
-        std::string ns_name = getNodeText(name_node, content);
-        child_namespace_path = namespace_path.empty() ? ns_name : namespace_path + "::" + ns_name;
-      }
-    } else if (node_type == "class_specifier" || node_type == "struct_specifier") {
-      TSNode name_node = findChildByType(node, "type_identifier");
-      if (!ts_node_is_null(name_node)) {
-        std::string class_name = getNodeText(name_node, content);
-        child_namespace_path = namespace_path.empty() ? class_name : namespace_path + "::" + class_name;
-      }
-    }
 
-    extractFromNode(child, content, filename, child_namespace_path, constructs);
+  // Namespace and class children are nested one level deeper
+  TSNode name_node = {};
+  if (symbol == symbols_.namespace_definition) {
+    name_node = ts_node_child_by_field_name(node, "name", 4);
+  } else if (symbol == symbols_.class_specifier || symbol == symbols_.struct_specifier) {
+    name_node = findChildByType(node, symbols_.type_identifier);
   }
-  
-  // Log completion for interesting nodes
-  if (interesting_nodes.count(node_type)) {
-    CLILogger::debug("ASTExtractor::extractFromNode: Completed processing " + node_type + ", total constructs so far: " + std::to_string(constructs.size()));
+  if (!ts_node_is_null(name_node)) {
+    scope_name = getNodeText(name_node, content);
   }
+  return true;
 }
 
 CodeConstruct ASTExtractor::extractFunction(TSNode node, const std::string& content, const std::string& filename, const std::string& namespace_path) {
   CodeConstruct construct;
   construct.type = ConstructType::Function;
   construct.ast_node = node;
-  construct.filename = filename;
-  construct.namespace_path = namespace_path;
+  construct.filename = intern(filename);
+  construct.namespace_path = intern(namespace_path);
 
 
   // Get function name and handle qualified identifiers (e.g., Class::method, Class::operator=)
-  TSNode declarator = findChildByType(node, "function_declarator");
+  TSNode declarator = functionDeclarator(node);
   if (!ts_node_is_null(declarator)) {
-    CLILogger::debug("extractFunction: Found function_declarator");
-    TSNode name_node = findChildByType(declarator, "qualified_identifier");
+    LOG_DEBUG("extractFunction: Found function_declarator");
+    TSNode name_node = findChildByType(declarator, symbols_.qualified_identifier);
     if (!ts_node_is_null(name_node)) {
       // Handle qualified identifier like "JsonValue::asDouble" or "JsonDoc::operator="
-      std::string full_qualified_name = getNodeText(name_node, content);
-      CLILogger::debug("Found qualified_identifier: '" + full_qualified_name + "' in " + filename);
+      std::string full_qualified_name(getNodeText(name_node, content));
+      LOG_DEBUG("Found qualified_identifier: '" + full_qualified_name + "' in " + filename);
 
 
       size_t scope_pos = full_qualified_name.rfind("::");
       if (scope_pos != std::string::npos) {
-        construct.namespace_path = full_qualified_name.substr(0, scope_pos);
+        construct.namespace_path = intern(std::string_view(full_qualified_name).substr(0, scope_pos));
         construct.name = full_qualified_name.substr(scope_pos + 2);
         construct.full_name = full_qualified_name;
 
@@ -159,48 +257,48 @@ CodeConstruct ASTExtractor::extractFunction(TSNode node, const std::string& cont
         construct.full_name = namespace_path.empty() ? construct.name : namespace_path + "::" + construct.name;
       }
     } else {
-      CLILogger::debug("extractFunction: No qualified_identifier found, using fallback");
+      LOG_DEBUG("extractFunction: No qualified_identifier found, using fallback");
       // Try to extract name from the full declarator text as fallback
-      std::string declarator_text = getNodeText(declarator, content);
+      std::string declarator_text(getNodeText(declarator, content));
 
-      CLILogger::debug("Fallback: extracting from declarator_text: '" + declarator_text + "' for node in " + filename);
+      LOG_DEBUG("Fallback: extracting from declarator_text: '" + declarator_text + "' for node in " + filename);
 
       // Special handling for operator functions that might not have text
       if (declarator_text.empty() || declarator_text == "()") {
         // Try to get the text of the whole function_definition node
-        std::string full_text = getNodeText(node, content);
-        CLILogger::debug("Fallback: empty declarator, trying full node text: '" + full_text.substr(0, 100) + "...'");
+        std::string_view full_text = getNodeText(node, content);
+        LOG_DEBUG("Fallback: empty declarator, trying full node text: '" + std::string(full_text.substr(0, 100)) + "...'");
 
         // Look for operator keyword in the full text
         size_t op_pos = full_text.find("operator");
-        if (op_pos != std::string::npos) {
+        if (op_pos != std::string_view::npos) {
           // Extract the operator declaration up to the opening parenthesis
           size_t paren_pos = full_text.find('(', op_pos);
-          if (paren_pos != std::string::npos) {
-            std::string op_decl = full_text.substr(op_pos, paren_pos - op_pos);
+          if (paren_pos != std::string_view::npos) {
+            std::string op_decl(full_text.substr(op_pos, paren_pos - op_pos));
             // Trim whitespace
             while (!op_decl.empty() && std::isspace(op_decl.back())) {
               op_decl.pop_back();
             }
             construct.name = op_decl;
-            CLILogger::debug("Fallback: extracted operator from full text: '" + construct.name + "'");
+            LOG_DEBUG("Fallback: extracted operator from full text: '" + construct.name + "'");
 
             // If we're inside a class, try to infer the class name from the AST context
             if (!namespace_path.empty() && construct.name.find("::") == std::string::npos) {
               // The namespace_path might already contain the class name for methods
               construct.full_name = namespace_path + "::" + construct.name;
-              CLILogger::debug("Fallback: inferred qualified name from context: '" + construct.full_name + "'");
+              LOG_DEBUG("Fallback: inferred qualified name from context: '" + construct.full_name + "'");
             }
           }
         }
       } else {
         construct.name = extractFunctionNameFromText(declarator_text);
-        CLILogger::debug("Fallback: extracted name: '" + construct.name + "'");
+        LOG_DEBUG("Fallback: extracted name: '" + construct.name + "'");
       }
 
       if (construct.name.empty()) {
         // Last resort: try simple identifier
-        TSNode simple_name_node = findChildByType(declarator, "identifier");
+        TSNode simple_name_node = findChildByType(declarator, symbols_.identifier);
         if (!ts_node_is_null(simple_name_node)) {
           construct.name = getNodeText(simple_name_node, content);
         }
@@ -209,41 +307,41 @@ CodeConstruct ASTExtractor::extractFunction(TSNode node, const std::string& cont
       // Handle qualified names in the extracted name
       if (construct.name.find("::") != std::string::npos) {
         size_t scope_pos = construct.name.rfind("::");
-        construct.namespace_path = construct.name.substr(0, scope_pos);
+        construct.namespace_path = intern(std::string_view(construct.name).substr(0, scope_pos));
         std::string method_name = construct.name.substr(scope_pos + 2);
         construct.name = method_name;
-        construct.full_name = construct.namespace_path + "::" + construct.name;
+        construct.full_name = std::string(construct.namespace_path) + "::" + construct.name;
       } else {
         construct.full_name = namespace_path.empty() ? construct.name : namespace_path + "::" + construct.name;
       }
     }
   } else {
-    CLILogger::debug("extractFunction: No function_declarator found in function_definition");
+    LOG_DEBUG("extractFunction: No function_declarator found in function_definition");
 
     // Fallback for inline class methods where Tree-sitter doesn't generate function_declarator nodes
     // This commonly happens with operator overloads and inline method definitions within class bodies
     // Extract method/operator name directly from the full function text as last resort
-    std::string func_text = getNodeText(node, content);
+    std::string_view func_text = getNodeText(node, content);
 
     // First check for operators
     size_t op_pos = func_text.find("operator");
-    if (op_pos != std::string::npos) {
+    if (op_pos != std::string_view::npos) {
       // Extract operator declaration up to the opening parenthesis
       size_t paren_pos = func_text.find('(', op_pos);
-      if (paren_pos != std::string::npos) {
-        std::string op_name = func_text.substr(op_pos, paren_pos - op_pos);
+      if (paren_pos != std::string_view::npos) {
+        std::string op_name(func_text.substr(op_pos, paren_pos - op_pos));
         // Trim whitespace
         while (!op_name.empty() && std::isspace(op_name.back())) {
           op_name.pop_back();
         }
         construct.name = op_name;
         construct.full_name = namespace_path.empty() ? construct.name : namespace_path + "::" + construct.name;
-        CLILogger::debug("extractFunction: Extracted operator from inline method: '" + construct.name + "'");
+        LOG_DEBUG("extractFunction: Extracted operator from inline method: '" + construct.name + "'");
       }
     } else {
       // Try to extract regular method name (e.g., "ClassName::methodName()" or just "methodName()")
       size_t paren_pos = func_text.find('(');
-      if (paren_pos != std::string::npos) {
+      if (paren_pos != std::string_view::npos) {
         // Look backwards from the parenthesis to find the method name
         size_t name_end = paren_pos;
         // Skip whitespace before parenthesis
@@ -261,7 +359,7 @@ CodeConstruct ASTExtractor::extractFunction(TSNode node, const std::string& cont
         }
 
         if (name_start < name_end) {
-          std::string method_name = func_text.substr(name_start, name_end - name_start);
+          std::string method_name(func_text.substr(name_start, name_end - name_start));
 
           // Check if we have a qualified name (Class::method)
           size_t full_start = name_start;
@@ -272,19 +370,19 @@ CodeConstruct ASTExtractor::extractFunction(TSNode node, const std::string& cont
                    (std::isalnum(func_text[class_start - 1]) || func_text[class_start - 1] == '_')) {
               class_start--;
             }
-            std::string full_name = func_text.substr(class_start, name_end - class_start);
+            std::string full_name(func_text.substr(class_start, name_end - class_start));
 
             size_t scope_pos = full_name.rfind("::");
             if (scope_pos != std::string::npos) {
-              construct.namespace_path = full_name.substr(0, scope_pos);
+              construct.namespace_path = intern(std::string_view(full_name).substr(0, scope_pos));
               construct.name = full_name.substr(scope_pos + 2);
               construct.full_name = full_name;
-              CLILogger::debug("extractFunction: Extracted qualified method: '" + construct.full_name + "'");
+              LOG_DEBUG("extractFunction: Extracted qualified method: '" + construct.full_name + "'");
             }
           } else {
             construct.name = method_name;
             construct.full_name = namespace_path.empty() ? construct.name : namespace_path + "::" + construct.name;
-            CLILogger::debug("extractFunction: Extracted inline method: '" + construct.name + "'");
+            LOG_DEBUG("extractFunction: Extracted inline method: '" + construct.name + "'");
           }
         }
       }
@@ -292,10 +390,11 @@ CodeConstruct ASTExtractor::extractFunction(TSNode node, const std::string& cont
   }
 
   // Extract return type
-  construct.return_type = extractReturnType(node, content);
+  construct.return_type = intern(extractReturnType(node, content));
 
   // Extract parameters
   construct.parameters = extractParameters(node, content);
+  construct.is_const = isConstQualified(node, content);
 
 
   // Get line numbers
@@ -305,7 +404,7 @@ CodeConstruct ASTExtractor::extractFunction(TSNode node, const std::string& cont
   construct.end_line = end_point.row + 1;
 
   // Look for nearby docstring
-  construct.docstring = findNearbyDocstring(node, content);
+  construct.docstring = docstringFor(node, content);
 
   return construct;
 }
@@ -314,26 +413,26 @@ CodeConstruct ASTExtractor::extractMethodDeclaration(TSNode node, const std::str
   CodeConstruct construct;
   construct.type = ConstructType::Function;  // Method declarations are functions
   construct.ast_node = node;
-  construct.filename = filename;
-  construct.namespace_path = namespace_path;
+  construct.filename = intern(filename);
+  construct.namespace_path = intern(namespace_path);
 
-  CLILogger::debug("extractMethodDeclaration called for node in " + filename + ", namespace: " + namespace_path);
+  LOG_DEBUG("extractMethodDeclaration called for node in " + filename + ", namespace: " + namespace_path);
 
   // Get method name - search for identifier in various possible locations
-  TSNode name_node = findChildByType(node, "identifier");
+  TSNode name_node = findChildByType(node, symbols_.identifier);
   if (!ts_node_is_null(name_node)) {
     construct.name = getNodeText(name_node, content);
-    CLILogger::debug("Method: Found identifier: '" + construct.name + "'");
+    LOG_DEBUG("Method: Found identifier: '" + construct.name + "'");
   } else {
     // Handle destructors (~ClassName) and operators
-    TSNode destructor_node = findChildByType(node, "destructor_name");
+    TSNode destructor_node = findChildByType(node, symbols_.destructor_name);
     if (!ts_node_is_null(destructor_node)) {
       construct.name = getNodeText(destructor_node, content);
-      CLILogger::debug("Method: Found destructor: '" + construct.name + "'");
+      LOG_DEBUG("Method: Found destructor: '" + construct.name + "'");
     } else {
       // Fallback: search recursively through all children for identifiers
       construct.name = findMethodName(node, content);
-      CLILogger::debug("Method: Using findMethodName, got: '" + construct.name + "'");
+      LOG_DEBUG("Method: Using findMethodName, got: '" + construct.name + "'");
     }
   }
 
@@ -342,11 +441,12 @@ CodeConstruct ASTExtractor::extractMethodDeclaration(TSNode node, const std::str
   // Extract return type from parent declaration
   TSNode parent = ts_node_parent(node);
   if (!ts_node_is_null(parent)) {
-    construct.return_type = extractReturnType(parent, content);
+    construct.return_type = intern(extractReturnType(parent, content));
   }
 
   // Extract parameters
   construct.parameters = extractParameters(node, content);
+  construct.is_const = isConstQualified(node, content);
 
   // Get line numbers
   TSPoint start_point = ts_node_start_point(node);
@@ -355,7 +455,7 @@ CodeConstruct ASTExtractor::extractMethodDeclaration(TSNode node, const std::str
   construct.end_line = end_point.row + 1;
 
   // Look for nearby docstring
-  construct.docstring = findNearbyDocstring(node, content);
+  construct.docstring = docstringFor(node, content);
 
   return construct;
 }
@@ -364,11 +464,11 @@ CodeConstruct ASTExtractor::extractClass(TSNode node, const std::string& content
   CodeConstruct construct;
   construct.type = ConstructType::Class;
   construct.ast_node = node;
-  construct.filename = filename;
-  construct.namespace_path = namespace_path;
+  construct.filename = intern(filename);
+  construct.namespace_path = intern(namespace_path);
 
   // Get class name
-  TSNode name_node = findChildByType(node, "type_identifier");
+  TSNode name_node = findChildByType(node, symbols_.type_identifier);
   if (!ts_node_is_null(name_node)) {
     construct.name = getNodeText(name_node, content);
     construct.full_name = namespace_path.empty() ? construct.name : namespace_path + "::" + construct.name;
@@ -381,7 +481,7 @@ CodeConstruct ASTExtractor::extractClass(TSNode node, const std::string& content
   construct.end_line = end_point.row + 1;
 
   // Look for nearby docstring
-  construct.docstring = findNearbyDocstring(node, content);
+  construct.docstring = docstringFor(node, content);
 
   return construct;
 }
@@ -390,11 +490,11 @@ CodeConstruct ASTExtractor::extractStruct(TSNode node, const std::string& conten
   CodeConstruct construct;
   construct.type = ConstructType::Struct;
   construct.ast_node = node;
-  construct.filename = filename;
-  construct.namespace_path = namespace_path;
+  construct.filename = intern(filename);
+  construct.namespace_path = intern(namespace_path);
 
   // Get struct name
-  TSNode name_node = findChildByType(node, "type_identifier");
+  TSNode name_node = findChildByType(node, symbols_.type_identifier);
   if (!ts_node_is_null(name_node)) {
     construct.name = getNodeText(name_node, content);
     construct.full_name = namespace_path.empty() ? construct.name : namespace_path + "::" + construct.name;
@@ -407,7 +507,7 @@ CodeConstruct ASTExtractor::extractStruct(TSNode node, const std::string& conten
   construct.end_line = end_point.row + 1;
 
   // Look for nearby docstring
-  construct.docstring = findNearbyDocstring(node, content);
+  construct.docstring = docstringFor(node, content);
 
   return construct;
 }
@@ -416,11 +516,11 @@ CodeConstruct ASTExtractor::extractEnum(TSNode node, const std::string& content,
   CodeConstruct construct;
   construct.type = ConstructType::Enum;
   construct.ast_node = node;
-  construct.filename = filename;
-  construct.namespace_path = namespace_path;
+  construct.filename = intern(filename);
+  construct.namespace_path = intern(namespace_path);
 
   // Get enum name
-  TSNode name_node = findChildByType(node, "type_identifier");
+  TSNode name_node = findChildByType(node, symbols_.type_identifier);
   if (!ts_node_is_null(name_node)) {
     construct.name = getNodeText(name_node, content);
     construct.full_name = namespace_path.empty() ? construct.name : namespace_path + "::" + construct.name;
@@ -433,7 +533,7 @@ CodeConstruct ASTExtractor::extractEnum(TSNode node, const std::string& content,
   construct.end_line = end_point.row + 1;
 
   // Look for nearby docstring
-  construct.docstring = findNearbyDocstring(node, content);
+  construct.docstring = docstringFor(node, content);
 
   return construct;
 }
@@ -442,11 +542,11 @@ CodeConstruct ASTExtractor::extractNamespace(TSNode node, const std::string& con
   CodeConstruct construct;
   construct.type = ConstructType::Namespace;
   construct.ast_node = node;
-  construct.filename = filename;
-  construct.namespace_path = namespace_path;
+  construct.filename = intern(filename);
+  construct.namespace_path = intern(namespace_path);
 
-  // Get namespace name
-  TSNode name_node = findChildByType(node, "identifier");
+  // Get namespace name (a namespace_identifier or nested "a::b" specifier in current grammars)
+  TSNode name_node = ts_node_child_by_field_name(node, "name", 4);
   if (!ts_node_is_null(name_node)) {
     construct.name = getNodeText(name_node, content);
     construct.full_name = namespace_path.empty() ? construct.name : namespace_path + "::" + construct.name;
@@ -459,7 +559,7 @@ CodeConstruct ASTExtractor::extractNamespace(TSNode node, const std::string& con
   construct.end_line = end_point.row + 1;
 
   // Look for nearby docstring
-  construct.docstring = findNearbyDocstring(node, content);
+  construct.docstring = docstringFor(node, content);
 
   return construct;
 }
@@ -469,15 +569,15 @@ std::string ASTExtractor::extractReturnType(TSNode function_node, const std::str
   uint32_t child_count = ts_node_child_count(function_node);
   for (uint32_t i = 0; i < child_count; i++) {
     TSNode child = ts_node_child(function_node, i);
-    std::string child_type = ts_node_type(child);
+    TSSymbol child_symbol = ts_node_symbol(child);
 
-    if (child_type == "primitive_type" || child_type == "type_identifier" ||
-        child_type == "qualified_identifier" || child_type == "template_type") {
-      return getNodeText(child, content);
+    if (child_symbol == symbols_.primitive_type || child_symbol == symbols_.type_identifier ||
+        child_symbol == symbols_.qualified_identifier || child_symbol == symbols_.template_type) {
+      return std::string(getNodeText(child, content));
     }
 
     // Stop when we hit the function_declarator
-    if (child_type == "function_declarator") {
+    if (child_symbol == symbols_.function_declarator) {
       break;
     }
   }
@@ -485,98 +585,126 @@ std::string ASTExtractor::extractReturnType(TSNode function_node, const std::str
   return "void";  // Default if no return type found
 }
 
+TSNode ASTExtractor::functionDeclarator(TSNode function_node) {
+  // Declarations hand over the function_declarator itself, definitions the node that holds it
+  if (ts_node_symbol(function_node) == symbols_.function_declarator) return function_node;
+
+  // Functions returning a pointer or reference nest it inside those declarators ("const T& name() const")
+  TSNode declarator = ts_node_child_by_field_name(function_node, "declarator", 10);
+  for (int depth = 0; !ts_node_is_null(declarator) && depth < 8; ++depth) {
+    TSSymbol symbol = ts_node_symbol(declarator);
+    if (symbol == symbols_.function_declarator) return declarator;
+    if (symbol != symbols_.pointer_declarator && symbol != symbols_.reference_declarator) break;
+    TSNode inner = ts_node_child_by_field_name(declarator, "declarator", 10);
+    uint32_t named = ts_node_named_child_count(declarator);
+    declarator = !ts_node_is_null(inner) ? inner : named > 0 ? ts_node_named_child(declarator, named - 1) : TSNode{};
+  }
+  return findChildByType(function_node, symbols_.function_declarator);
+}
+
 std::vector<Parameter> ASTExtractor::extractParameters(TSNode function_node, const std::string& content) {
   std::vector<Parameter> parameters;
 
-  TSNode declarator = findChildByType(function_node, "function_declarator");
+  TSNode declarator = functionDeclarator(function_node);
   if (ts_node_is_null(declarator)) return parameters;
 
-  TSNode param_list = findChildByType(declarator, "parameter_list");
+  TSNode param_list = findChildByType(declarator, symbols_.parameter_list);
   if (ts_node_is_null(param_list)) return parameters;
 
   uint32_t child_count = ts_node_child_count(param_list);
   for (uint32_t i = 0; i < child_count; i++) {
     TSNode child = ts_node_child(param_list, i);
-    if (std::string(ts_node_type(child)) == "parameter_declaration") {
+    TSSymbol child_symbol = ts_node_symbol(child);
+    if (child_symbol == symbols_.parameter_declaration || child_symbol == symbols_.optional_parameter_declaration) {
       Parameter param;
 
-      // Extract type (first non-comma child)
-      TSNode type_node = ts_node_child(child, 0);
-      if (!ts_node_is_null(type_node)) {
-        param.type = extractTypeName(type_node, content);
+      // The name sits inside any pointer or reference declarators ("const Shape& shape", "int* out")
+      TSNode declarator_node = ts_node_child_by_field_name(child, "declarator", 10);
+      TSNode name_node = declarator_node;
+      for (int depth = 0; !ts_node_is_null(name_node) && ts_node_symbol(name_node) != symbols_.identifier && depth < 8; ++depth) {
+        TSNode inner = ts_node_child_by_field_name(name_node, "declarator", 10);
+        uint32_t named = ts_node_named_child_count(name_node);
+        name_node = !ts_node_is_null(inner) ? inner : named > 0 ? ts_node_named_child(name_node, named - 1) : TSNode{};
       }
 
-      // Extract name (look for identifier)
-      TSNode name_node = findChildByType(child, "identifier");
-      if (!ts_node_is_null(name_node)) {
+      // The type is the declaration without its name (or default), so qualifiers, '*' and '&' are kept.
+      // Defaults usually appear only on the declaration, so they must not change the type
+      std::string_view text = getNodeText(child, content);
+      TSNode default_node = ts_node_child_by_field_name(child, "default_value", 13);
+      if (!ts_node_is_null(default_node) && !ts_node_is_null(declarator_node)) {
+        param.default_value = std::string(getNodeText(default_node, content));
+        text = text.substr(0, ts_node_end_byte(declarator_node) - ts_node_start_byte(child));
+      }
+      std::string type(text);
+      if (!ts_node_is_null(name_node) && ts_node_symbol(name_node) == symbols_.identifier) {
         param.name = getNodeText(name_node, content);
+        size_t offset = ts_node_start_byte(name_node) - ts_node_start_byte(child);
+        if (offset <= type.size()) type.erase(offset, param.name.size());
       }
+      size_t first = type.find_first_not_of(" \t\r\n");
+      size_t last = type.find_last_not_of(" \t\r\n");
+      param.type = intern(first == std::string::npos ? std::string() : type.substr(first, last - first + 1));
 
-      // TODO: Extract default value if present
-
-      parameters.push_back(param);
+      parameters.push_back(std::move(param));
     }
   }
 
   return parameters;
 }
 
-std::string ASTExtractor::extractTypeName(TSNode type_node, const std::string& content) {
-  std::string node_type = ts_node_type(type_node);
+bool ASTExtractor::isConstQualified(TSNode function_node, const std::string& content) {
+  TSNode declarator = functionDeclarator(function_node);
+  if (ts_node_is_null(declarator)) return false;
 
-  if (node_type == "primitive_type" || node_type == "type_identifier") {
-    return getNodeText(type_node, content);
-  } else if (node_type == "pointer_declarator") {
-    // Handle pointer types like "int*"
-    TSNode base_type = ts_node_child(type_node, 0);
-    if (!ts_node_is_null(base_type)) {
-      return extractTypeName(base_type, content) + "*";
-    }
-  } else if (node_type == "reference_declarator") {
-    // Handle reference types like "int&"
-    TSNode base_type = ts_node_child(type_node, 0);
-    if (!ts_node_is_null(base_type)) {
-      return extractTypeName(base_type, content) + "&";
+  // Qualifiers of the function itself follow its parameter list ("area() const")
+  bool after_parameters = false;
+  uint32_t child_count = ts_node_child_count(declarator);
+  for (uint32_t i = 0; i < child_count; i++) {
+    TSNode child = ts_node_child(declarator, i);
+    if (ts_node_symbol(child) == symbols_.parameter_list) {
+      after_parameters = true;
+    } else if (after_parameters && ts_node_symbol(child) == symbols_.type_qualifier &&
+               getNodeText(child, content) == "const") {
+      return true;
     }
   }
-
-  // Fallback: return the raw text
-  return getNodeText(type_node, content);
+  return false;
 }
 
-std::string ASTExtractor::getNodeText(TSNode node, const std::string& content) {
-  uint32_t start = ts_node_start_byte(node);
-  uint32_t end = ts_node_end_byte(node);
+std::string_view ASTExtractor::getNodeText(TSNode node, const std::string& content) {
+  size_t start = ts_node_start_byte(node);
+  size_t end = ts_node_end_byte(node);
   if (end > content.length()) end = content.length();
-  return content.substr(start, end - start);
+  if (start > end) start = end;
+  return std::string_view(content).substr(start, end - start);
 }
 
 std::string ASTExtractor::findMethodName(TSNode node, const std::string& content) {
   // Extract the full text of the function declarator and parse it manually
-  std::string full_text = getNodeText(node, content);
+  std::string_view full_text = getNodeText(node, content);
 
   // Look for pattern: methodName(parameters) or ~methodName() or operator...()
   size_t paren_pos = full_text.find('(');
-  if (paren_pos == std::string::npos) return "";
+  if (paren_pos == std::string_view::npos) return "";
 
-  std::string before_paren = full_text.substr(0, paren_pos);
+  std::string_view before_paren = full_text.substr(0, paren_pos);
 
   // Handle destructor
-  if (before_paren.find('~') != std::string::npos) {
+  if (before_paren.find('~') != std::string_view::npos) {
     size_t tilde_pos = before_paren.find('~');
-    return before_paren.substr(tilde_pos);
+    return std::string(before_paren.substr(tilde_pos));
   }
 
   // Handle operators
-  if (before_paren.find("operator") != std::string::npos) {
+  if (before_paren.find("operator") != std::string_view::npos) {
     size_t op_pos = before_paren.find("operator");
-    return before_paren.substr(op_pos);
+    return std::string(before_paren.substr(op_pos));
   }
 
   // Regular method - find the last identifier before (
   // First, trim any whitespace
-  while (!before_paren.empty() && std::isspace(before_paren.back())) {
-    before_paren.pop_back();
+  while (!before_paren.empty() && std::isspace(static_cast<unsigned char>(before_paren.back()))) {
+    before_paren.remove_suffix(1);
   }
 
   if (before_paren.empty()) return "";
@@ -591,7 +719,7 @@ std::string ASTExtractor::findMethodName(TSNode node, const std::string& content
   }
 
   if (start_pos < end_pos) {
-    return before_paren.substr(start_pos, end_pos - start_pos);
+    return std::string(before_paren.substr(start_pos, end_pos - start_pos));
   }
 
   return "";
@@ -656,160 +784,237 @@ std::string ASTExtractor::extractFunctionNameFromText(const std::string& declara
   return "";
 }
 
-std::string ASTExtractor::escapeSymbolsForFilename(const std::string& name) {
-  std::string result = name;
-
-  // Character-level escaping for invalid filename characters
-  // Windows forbidden: < > : " | ? * \ /
-  // Unix forbidden: / \0
-  std::map<char, std::string> escapes = {
-    {'<', "%lt"},
-    {'>', "%gt"},
-    {':', "%colon"},
-    {'"', "%quote"},
-    {'|', "%pipe"},
-    {'?', "%quest"},
-    {'*', "%star"},
-    {'\\', "%bslash"},
-    {'/', "%slash"}
-  };
+std::optional<std::string> ASTExtractor::findNearbyDocstring(TSNode node, const std::string& content) {
+  uint32_t node_start = ts_node_start_byte(node);
 
-  for (const auto& [ch, replacement] : escapes) {
-    size_t pos = 0;
-    while ((pos = result.find(ch, pos)) != std::string::npos) {
-      result.replace(pos, 1, replacement);
-      pos += replacement.length();
-    }
+  // Last indexed comment that ends at or before the node
+  auto after = std::upper_bound(doc_comments_.begin(), doc_comments_.end(), node_start,
+                                [](uint32_t offset, const PendingDocComment& comment) {
+                                  return offset < comment.end_byte;
+                                });
+  if (after == doc_comments_.begin()) {
+    return std::nullopt;
+  }
+  const PendingDocComment& comment = *std::prev(after);
+  if (node_start - comment.end_byte > kMaxDocstringGap) {
+    return std::nullopt;
   }
 
-  return result;
+  // As in fused mode, a statement boundary in between means the comment documented something else
+  for (uint32_t i = comment.end_byte; i < node_start && i < content.length(); i++) {
+    char c = content[i];
+    if (c == ';' || c == '{' || c == '}') {
+      return std::nullopt;
+    }
+  }
+  return content.substr(comment.start_byte, comment.end_byte - comment.start_byte);
 }
 
-std::optional<std::string> ASTExtractor::findNearbyDocstring(TSNode node, const std::string& content) {
-  // Look for comment nodes before this node
-  // This is a simplified implementation - could be enhanced
-
-  uint32_t node_start = ts_node_start_byte(node);
+void ASTExtractor::collectDocComment(TSNode node, const std::string& content) {
+  uint32_t start = ts_node_start_byte(node);
+  uint32_t end = ts_node_end_byte(node);
+  if (end > content.length() || start >= end) return;
+
+  std::string_view text(content.data() + start, end - start);
+  bool is_line_style = docstring_style_.starts_with("///") || docstring_style_.starts_with("//!");
+  bool is_doc_comment = false;
+  if (docstring_style_.starts_with("/**")) {
+    is_doc_comment = text.starts_with("/**") && !text.starts_with("/**/");
+  } else if (docstring_style_.starts_with("///")) {
+    is_doc_comment = text.starts_with("///") && !text.starts_with("////");
+  } else if (docstring_style_.starts_with("//!")) {
+    is_doc_comment = text.starts_with("//!");
+  }
+  if (!is_doc_comment) return;
 
-  // Look backwards in content for /** or /// style comments
-  if (node_start > 100) {  // Don't go too far back
-    std::string before = content.substr(node_start - 100, 100);
+  TSPoint start_point = ts_node_start_point(node);
+  TSPoint end_point = ts_node_end_point(node);
 
-    // Simple pattern matching for javadoc-style comments
-    size_t javadoc_pos = before.rfind("/**");
-    if (javadoc_pos != std::string::npos) {
-      size_t end_pos = content.find("*/", node_start - 100 + javadoc_pos);
-      if (end_pos != std::string::npos && end_pos < node_start) {
-        return content.substr(node_start - 100 + javadoc_pos, end_pos - (node_start - 100 + javadoc_pos) + 2);
+  // Consecutive line comments form a single docstring
+  PendingDocComment* previous = nullptr;
+  if (fused_docstrings_) {
+    previous = pending_doc_.active ? &pending_doc_ : nullptr;
+  } else {
+    previous = doc_comments_.empty() ? nullptr : &doc_comments_.back();
+  }
+  if (is_line_style && previous && start_point.row == previous->end_row + 1) {
+    bool only_whitespace = true;
+    for (uint32_t i = previous->end_byte; i < start; i++) {
+      if (!std::isspace(static_cast<unsigned char>(content[i]))) {
+        only_whitespace = false;
+        break;
       }
     }
+    if (only_whitespace) {
+      previous->end_byte = end;
+      previous->end_row = end_point.row;
+      return;
+    }
   }
 
-  return std::nullopt;  // No docstring found
+  if (fused_docstrings_) {
+    pending_doc_ = PendingDocComment{start, end, end_point.row, true};
+  } else {
+    doc_comments_.push_back(PendingDocComment{start, end, end_point.row, true});
+  }
 }
 
-TSNode ASTExtractor::findChildByType(TSNode parent, const std::string& type) {
-  uint32_t child_count = ts_node_child_count(parent);
-  for (uint32_t i = 0; i < child_count; i++) {
-    TSNode child = ts_node_child(parent, i);
-    if (std::string(ts_node_type(child)) == type) {
-      return child;
+std::optional<std::string> ASTExtractor::takePendingDocstring(TSNode node, const std::string& content) {
+  if (!pending_doc_.active) return std::nullopt;
+
+  uint32_t node_start = ts_node_start_byte(node);
+  if (pending_doc_.end_byte > node_start) return std::nullopt;
+
+  // Anything that ends or opens a statement between the comment and the node
+  // means the comment documented something else (e.g. an undocumented variable)
+  for (uint32_t i = pending_doc_.end_byte; i < node_start && i < content.length(); i++) {
+    char c = content[i];
+    if (c == ';' || c == '{' || c == '}') {
+      pending_doc_.active = false;
+      return std::nullopt;
     }
   }
-  return {};  // null node
+
+  pending_doc_.active = false;
+  return content.substr(pending_doc_.start_byte, pending_doc_.end_byte - pending_doc_.start_byte);
+}
+
+std::optional<std::string> ASTExtractor::docstringFor(TSNode node, const std::string& content) {
+  return fused_docstrings_ ? takePendingDocstring(node, content) : findNearbyDocstring(node, content);
+}
+
+TSNode ASTExtractor::findChildByType(TSNode parent, TSSymbol symbol) {
+  TSNode found = {};  // null node
+  TSTreeCursor cursor = ts_tree_cursor_new(parent);
+  if (ts_tree_cursor_goto_first_child(&cursor)) {
+    do {
+      TSNode child = ts_tree_cursor_current_node(&cursor);
+      if (ts_node_symbol(child) == symbol) {
+        found = child;
+        break;
+      }
+    } while (ts_tree_cursor_goto_next_sibling(&cursor));
+  }
+  ts_tree_cursor_delete(&cursor);
+  return found;
 }
 
-std::vector<TSNode> ASTExtractor::findChildrenByType(TSNode parent, const std::string& type) {
+std::vector<TSNode> ASTExtractor::findChildrenByType(TSNode parent, TSSymbol symbol) {
   std::vector<TSNode> children;
-  uint32_t child_count = ts_node_child_count(parent);
-  for (uint32_t i = 0; i < child_count; i++) {
-    TSNode child = ts_node_child(parent, i);
-    if (std::string(ts_node_type(child)) == type) {
-      children.push_back(child);
-    }
+  TSTreeCursor cursor = ts_tree_cursor_new(parent);
+  if (ts_tree_cursor_goto_first_child(&cursor)) {
+    do {
+      TSNode child = ts_tree_cursor_current_node(&cursor);
+      if (ts_node_symbol(child) == symbol) {
+        children.push_back(child);
+      }
+    } while (ts_tree_cursor_goto_next_sibling(&cursor));
   }
+  ts_tree_cursor_delete(&cursor);
   return children;
 }
 
 // Docstring merging implementation
 
-int ASTExtractor::mergeDuplicateConstructs(std::vector<CodeConstruct>& constructs) {
-  if (constructs.empty()) return 0;
+namespace {
+  std::string sourceLocation(const CodeConstruct& construct) {
+    return std::string(construct.filename) + ":" + std::to_string(construct.start_line);
+  }
 
-  std::map<std::string, std::vector<size_t>> duplicates;
+  // Turn a construct into a merge target that lists its own location and docstring
+  void beginMerge(CodeConstruct& construct) {
+    if (construct.is_merged) return;
+    construct.is_merged = true;
+    construct.source_locations = {sourceLocation(construct)};
+    construct.merged_docstrings.clear();
+    if (construct.docstring.has_value() && !construct.docstring->empty()) {
+      construct.merged_docstrings.push_back(*construct.docstring);
+    }
+  }
 
-  // Group constructs by full_name to find duplicates
-  for (size_t i = 0; i < constructs.size(); i++) {
-    const auto& construct = constructs[i];
-    if (!construct.full_name.empty()) {
-      duplicates[construct.full_name].push_back(i);
+  // Fold another occurrence's locations and docstrings into the merge target
+  void absorbConstruct(CodeConstruct& target, CodeConstruct&& other) {
+    std::vector<std::string> locations;
+    if (other.is_merged) {
+      locations = std::move(other.source_locations);
+    } else {
+      locations.push_back(sourceLocation(other));
+    }
+    for (auto& location : locations) {
+      if (std::find(target.source_locations.begin(), target.source_locations.end(), location) == target.source_locations.end()) {
+        target.source_locations.push_back(std::move(location));
+      }
+    }
+
+    if (other.is_merged) {
+      for (auto& docstring : other.merged_docstrings) {
+        target.merged_docstrings.push_back(std::move(docstring));
+      }
+    } else if (other.docstring.has_value() && !other.docstring->empty()) {
+      target.merged_docstrings.push_back(std::move(*other.docstring));
     }
   }
+}
 
-  int conflict_count = 0;
-  std::vector<CodeConstruct> merged_constructs;
-  std::set<size_t> processed_indices;
-
-  for (const auto& [full_name, indices] : duplicates) {
-    if (indices.size() > 1) {
-      // Found duplicates - merge them
-      CodeConstruct merged = constructs[indices[0]]; // Start with first occurrence
-      merged.is_merged = true;
-      merged.source_locations.clear();
-      merged.merged_docstrings.clear();
-
-      for (size_t idx : indices) {
-        processed_indices.insert(idx);
-        const auto& construct = constructs[idx];
-
-        // Add location info
-        std::string location = construct.filename + ":" + std::to_string(construct.start_line);
-        merged.source_locations.push_back(location);
-
-        // Collect docstrings
-        if (construct.docstring.has_value() && !construct.docstring->empty()) {
-          merged.merged_docstrings.push_back(construct.docstring.value());
-        }
+int ASTExtractor::mergeDuplicateConstructs(std::vector<CodeConstruct>& constructs, StringInterner& strings) {
+  if (constructs.empty()) return 0;
 
-        // Detect conflicts between constructs
-        if (idx != indices[0]) {
-          auto conflicts = detectDocstringConflicts(merged, construct);
-          conflict_count += conflicts.size();
+  // Signatures are interned so the keys stay valid while constructs move within the vector
+  struct MergeTarget {
+    size_t index;           // Position of the first occurrence after compaction
+    bool absorbed = false;  // Whether a later occurrence has been folded in by this call
+  };
+  std::unordered_map<std::string_view, MergeTarget> first_by_signature;
+  first_by_signature.reserve(constructs.size());
+  std::vector<size_t> merged_targets;
+  int conflict_count = 0;
 
-          for (const auto& conflict : conflicts) {
-            CLILogger::warning("Docstring conflict in " + full_name + ": " + conflict);
-          }
+  // Compact in place: first occurrences slide down, later ones are folded into them
+  size_t kept = 0;
+  for (size_t i = 0; i < constructs.size(); i++) {
+    CodeConstruct& construct = constructs[i];
+    if (!construct.full_name.empty()) {
+      auto [first, inserted] = first_by_signature.try_emplace(strings.intern(overloadSignature(construct)), MergeTarget{kept});
+      if (!inserted) {
+        CodeConstruct& target = constructs[first->second.index];
+        // Targets merged by an earlier call still need their docstrings recombined
+        if (!first->second.absorbed) {
+          first->second.absorbed = true;
+          merged_targets.push_back(first->second.index);
         }
-      }
+        beginMerge(target);
 
-      // Merge the docstrings intelligently
-      if (!merged.merged_docstrings.empty()) {
-        // For now, concatenate all docstrings with separators
-        // TODO: Implement smarter merging logic
-        std::string combined_docstring;
-        for (size_t i = 0; i < merged.merged_docstrings.size(); i++) {
-          if (i > 0) combined_docstring += "\n\n";
-          combined_docstring += merged.merged_docstrings[i];
+        auto conflicts = detectDocstringConflicts(target, construct);
+        conflict_count += conflicts.size();
+        for (const auto& conflict : conflicts) {
+          CLILogger::warning("Docstring conflict in " + target.full_name + ": " + conflict);
         }
-        merged.docstring = combined_docstring;
+
+        absorbConstruct(target, std::move(construct));
+        continue;
       }
+    }
 
-      merged_constructs.push_back(merged);
-    } else {
-      // Single occurrence - add to processed list
-      processed_indices.insert(indices[0]);
-      merged_constructs.push_back(constructs[indices[0]]);
+    if (kept != i) {
+      constructs[kept] = std::move(construct);
     }
+    kept++;
   }
+  constructs.erase(constructs.begin() + kept, constructs.end());
 
-  // Add any constructs without full_name (shouldn't happen but safe fallback)
-  for (size_t i = 0; i < constructs.size(); i++) {
-    if (processed_indices.find(i) == processed_indices.end()) {
-      merged_constructs.push_back(constructs[i]);
+  // Combine docstrings once every occurrence has been folded in
+  // TODO: Implement smarter merging logic
+  for (size_t index : merged_targets) {
+    CodeConstruct& merged = constructs[index];
+    if (merged.merged_docstrings.empty()) continue;
+    std::string combined_docstring;
+    for (size_t i = 0; i < merged.merged_docstrings.size(); i++) {
+      if (i > 0) combined_docstring += "\n\n";
+      combined_docstring += merged.merged_docstrings[i];
     }
+    merged.docstring = std::move(combined_docstring);
   }
 
-  constructs = std::move(merged_constructs);
   return conflict_count;
 }
 
@@ -819,8 +1024,8 @@ CodeConstruct ASTExtractor::mergeConstructs(const CodeConstruct& declaration_con
 
   // Merge location information
   merged.source_locations = {
-    declaration_construct.filename + ":" + std::to_string(declaration_construct.start_line),
-    implementation_construct.filename + ":" + std::to_string(implementation_construct.start_line)
+    std::string(declaration_construct.filename) + ":" + std::to_string(declaration_construct.start_line),
+    std::string(implementation_construct.filename) + ":" + std::to_string(implementation_construct.start_line)
   };
 
   // Collect docstrings
@@ -856,7 +1061,7 @@ std::vector<std::string> ASTExtractor::detectDocstringConflicts(const CodeConstr
       !construct1.docstring->empty() && !construct2.docstring->empty()) {
 
     if (construct1.docstring.value() != construct2.docstring.value()) {
-      conflicts.push_back("Different docstring content in " + construct1.filename + " vs " + construct2.filename);
+      conflicts.push_back("Different docstring content in " + std::string(construct1.filename) + " vs " + std::string(construct2.filename));
     }
   }
 
@@ -868,3 +1073,75 @@ std::vector<std::string> ASTExtractor::detectDocstringConflicts(const CodeConstr
 
   return conflicts;
 }
+
+size_t attachNearestDocstrings(std::vector<CodeConstruct>& constructs, const std::vector<DocstringBlock>& blocks,
+                               uint32_t window) {
+  std::vector<size_t> block_order(blocks.size());
+  std::iota(block_order.begin(), block_order.end(), 0);
+  std::stable_sort(block_order.begin(), block_order.end(), [&](size_t a, size_t b) {
+    return blocks[a].location.line < blocks[b].location.line;
+  });
+
+  std::vector<size_t> construct_order;
+  for (size_t i = 0; i < constructs.size(); ++i) {
+    if (!constructs[i].docstring.has_value()) {
+      construct_order.push_back(i);
+    }
+  }
+  std::stable_sort(construct_order.begin(), construct_order.end(), [&](size_t a, size_t b) {
+    return constructs[a].start_line < constructs[b].start_line;
+  });
+
+  // next is the first block at or below the current construct; the one before it is the closest above
+  size_t next = 0;
+  size_t attached = 0;
+  for (size_t index : construct_order) {
+    CodeConstruct& construct = constructs[index];
+    while (next < block_order.size() && blocks[block_order[next]].location.line < construct.start_line) {
+      ++next;
+    }
+    if (next == 0) {
+      continue;
+    }
+    const DocstringBlock& block = blocks[block_order[next - 1]];
+    if (construct.start_line - block.location.line <= window) {
+      construct.docstring = block.description.empty() ? block.raw_content : block.description;
+      attached++;
+      LOG_DEBUG("attachNearestDocstrings: Associated docstring with construct '" + construct.name + "' (line " + std::to_string(construct.start_line) + ")");
+    }
+  }
+  return attached;
+}
+
+std::string overloadSignature(const CodeConstruct& construct) {
+  auto isWordChar = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+  std::string signature = construct.full_name.empty() ? construct.name : construct.full_name;
+  signature += '(';
+  for (size_t i = 0; i < construct.parameters.size(); ++i) {
+    if (i > 0) signature += ',';
+    // Spaces only matter between two words ("unsigned int"), so "const T &" and "const T&" are one type
+    bool space = false;
+    for (char c : construct.parameters[i].type) {
+      if (std::isspace(static_cast<unsigned char>(c))) {
+        space = true;
+        continue;
+      }
+      if (space && isWordChar(signature.back()) && isWordChar(c)) {
+        signature += ' ';
+      }
+      space = false;
+      signature += c;
+    }
+  }
+  signature += ')';
+  if (construct.is_const) {
+    signature += " const";
+  }
+  return signature;
+}
+
+bool hasOverloadPage(const CodeConstruct& construct) {
+  bool callable = construct.type == ConstructType::Function || construct.type == ConstructType::Method ||
+                  construct.type == ConstructType::Constructor;
+  return callable && (!construct.parameters.empty() || construct.is_const);
+}
@@ -5,19 +5,118 @@
 #include <sstream>
 #include <regex>
 #include <iostream>
+#include <cstring>
+
+namespace {
+  /**
+  @brief Find the next occurrence of a comment marker at or after pos
+
+  memchr on the marker's first byte lets libc's vectorized search skip over
+  plain code; candidates are then confirmed with a short compare.
+  */
+  size_t findMarker(std::string_view text, size_t pos, std::string_view marker) {
+    while (pos + marker.size() <= text.size()) {
+      const void* hit = std::memchr(text.data() + pos, marker.front(), text.size() - marker.size() + 1 - pos);
+      if (hit == nullptr) {
+        return std::string_view::npos;
+      }
+      size_t candidate = static_cast<size_t>(static_cast<const char*>(hit) - text.data());
+      if (text.compare(candidate, marker.size(), marker) == 0) {
+        return candidate;
+      }
+      pos = candidate + 1;
+    }
+    return std::string_view::npos;
+  }
+
+  bool isWordChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+  }
+
+  bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  // Length of the identifier at the start of text (equivalent to \w+)
+  size_t wordLength(std::string_view text) {
+    size_t len = 0;
+    while (len < text.size() && isWordChar(text[len])) len++;
+    return len;
+  }
+
+  std::string_view skipSpace(std::string_view text) {
+    size_t start = 0;
+    while (start < text.size() && isSpace(text[start])) start++;
+    return text.substr(start);
+  }
+
+  std::string_view trimView(std::string_view text) {
+    text = skipSpace(text);
+    while (!text.empty() && (isSpace(text.back()) || text.back() == '\n')) text.remove_suffix(1);
+    return text;
+  }
+}
+
+bool DocstringParser::parseScannerName(const std::string& name, DocstringScanner& scanner) {
+  if (name == "linear") {
+    scanner = DocstringScanner::Linear;
+    return true;
+  }
+  if (name == "regex") {
+    scanner = DocstringScanner::Regex;
+    return true;
+  }
+  return false;
+}
 
 std::vector<DocstringBlock> DocstringParser::extractDocstrings(const std::string& content, const std::string& style) {
+  // One newline scan per file; every block location is then a binary search
+  LineIndex lines(content);
+
   if (style == "/** */") {
-    return extractBlockComments(content);
+    return extractBlockComments(content, lines);
   } else if (style == "/// ") {
-    return extractLineComments(content, "///");
+    return extractLineComments(content, "///", lines);
   } else if (style == "//! ") {
-    return extractLineComments(content, "//!");
+    return extractLineComments(content, "//!", lines);
   }
   return {};
 }
 
-std::vector<DocstringBlock> DocstringParser::extractBlockComments(const std::string& content) {
+std::vector<DocstringBlock> DocstringParser::extractBlockComments(const std::string& content, const LineIndex& lines) {
+  if (scanner_ == DocstringScanner::Regex) {
+    return extractBlockCommentsRegex(content, lines);
+  }
+
+  std::vector<DocstringBlock> blocks;
+  std::string_view text(content);
+  size_t pos = 0;
+
+  while (true) {
+    size_t start = findMarker(text, pos, "/**");
+    if (start == std::string_view::npos) break;
+
+    // "/**/" is an empty plain comment, not the opening of a docstring
+    if (start + 3 < text.size() && text[start + 3] == '/') {
+      pos = start + 4;
+      continue;
+    }
+
+    size_t end = findMarker(text, start + 3, "*/");
+    if (end == std::string_view::npos) break;
+    end += 2; // Include the */
+
+    DocstringBlock block = parseDocstringContent(content.substr(start, end - start));
+    block.location = lines.locate(start);
+    blocks.push_back(std::move(block));
+
+    pos = end;
+  }
+
+  return blocks;
+}
+
+std::vector<DocstringBlock> DocstringParser::extractBlockCommentsRegex(const std::string& content, const LineIndex& lines) {
   std::vector<DocstringBlock> blocks;
   
   try {
@@ -28,19 +127,19 @@ std::vector<DocstringBlock> DocstringParser::extractBlockComments(const std::str
     for (auto it = begin; it != end; ++it) {
       const std::smatch& match = *it;
       DocstringBlock block = parseDocstringContent(match.str());
-      block.location = getSourceLocation(content, match.position());
+      block.location = lines.locate(match.position());
       blocks.push_back(block);
     }
   } catch (const std::regex_error& e) {
     std::cerr << "Regex error in extractBlockComments: " << e.what() << std::endl;
     // Fall back to simpler string-based parsing if regex fails
-    return extractBlockCommentsSimple(content);
+    return extractBlockCommentsSimple(content, lines);
   }
   
   return blocks;
 }
 
-std::vector<DocstringBlock> DocstringParser::extractBlockCommentsSimple(const std::string& content) {
+std::vector<DocstringBlock> DocstringParser::extractBlockCommentsSimple(const std::string& content, const LineIndex& lines) {
   std::vector<DocstringBlock> blocks;
   size_t pos = 0;
   
@@ -55,7 +154,7 @@ std::vector<DocstringBlock> DocstringParser::extractBlockCommentsSimple(const st
     
     std::string comment = content.substr(start, end - start);
     DocstringBlock block = parseDocstringContent(comment);
-    block.location = getSourceLocation(content, start);
+    block.location = lines.locate(start);
     blocks.push_back(block);
     
     pos = end;
@@ -64,49 +163,162 @@ std::vector<DocstringBlock> DocstringParser::extractBlockCommentsSimple(const st
   return blocks;
 }
 
-std::vector<DocstringBlock> DocstringParser::extractLineComments(const std::string& content, const std::string& prefix) {
+std::vector<DocstringBlock> DocstringParser::extractLineComments(const std::string& content, const std::string& prefix,
+                                                                 const LineIndex& lines) {
   std::vector<DocstringBlock> blocks;
-  std::istringstream stream(content);
-  std::string line;
-  size_t line_num = 0;
+  std::string_view text(content);
   size_t byte_offset = 0;
 
   std::string current_comment;
   SourceLocation comment_start = {0, 0, 0};
   bool in_comment = false;
 
-  while (std::getline(stream, line)) {
-    line_num++;
+  auto flush_comment = [&]() {
+    DocstringBlock block = parseDocstringContent("/**" + current_comment + "*/");
+    block.location = comment_start;
+    blocks.push_back(std::move(block));
+    in_comment = false;
+  };
+
+  while (byte_offset < text.size()) {
+    const void* newline = std::memchr(text.data() + byte_offset, '\n', text.size() - byte_offset);
+    size_t line_end = newline ? static_cast<size_t>(static_cast<const char*>(newline) - text.data()) : text.size();
+    std::string_view line = text.substr(byte_offset, line_end - byte_offset);
 
-    if (line.find(prefix) == 0) {
+    if (line.compare(0, prefix.length(), prefix) == 0) {
       if (!in_comment) {
-        comment_start = {line_num, 0, byte_offset};
+        comment_start = lines.locate(byte_offset);
         in_comment = true;
         current_comment.clear();
       }
-      current_comment += line.substr(prefix.length()) + "\n";
+      current_comment.append(line.substr(prefix.length()));
+      current_comment += '\n';
     } else if (in_comment) {
       // End of comment block
-      DocstringBlock block = parseDocstringContent("/**" + current_comment + "*/");
-      block.location = comment_start;
-      blocks.push_back(block);
-      in_comment = false;
+      flush_comment();
     }
 
-    byte_offset += line.length() + 1; // +1 for newline
+    byte_offset = line_end + 1; // +1 for newline
   }
 
   // Handle comment at end of file
   if (in_comment) {
-    DocstringBlock block = parseDocstringContent("/**" + current_comment + "*/");
-    block.location = comment_start;
-    blocks.push_back(block);
+    flush_comment();
   }
 
   return blocks;
 }
 
 DocstringBlock DocstringParser::parseDocstringContent(const std::string& raw) {
+  if (scanner_ == DocstringScanner::Regex) {
+    return parseDocstringContentRegex(raw);
+  }
+
+  DocstringBlock block;
+  block.raw_content = raw;
+
+  // Strip the comment markers without copying the body
+  std::string_view body(raw);
+  if (body.compare(0, 3, "/**") == 0) {
+    body.remove_prefix(3);
+  }
+  if (body.size() >= 2 && body.compare(body.size() - 2, 2, "*/") == 0) {
+    body.remove_suffix(2);
+  }
+
+  scanDocstringBody(body, block);
+  return block;
+}
+
+void DocstringParser::scanDocstringBody(std::string_view body, DocstringBlock& block) {
+  std::string description;
+  bool in_description = true;
+  size_t pos = 0;
+
+  while (pos < body.size()) {
+    size_t eol = body.find('\n', pos);
+    if (eol == std::string_view::npos) eol = body.size();
+    std::string_view line = body.substr(pos, eol - pos);
+    pos = eol + 1;
+
+    // Remove leading whitespace and an optional leading '*' decoration
+    size_t start = line.find_first_not_of(" \t");
+    if (start == std::string_view::npos) continue;
+    line.remove_prefix(start);
+    if (line.front() == '*') {
+      line.remove_prefix(1);
+      if (!line.empty() && line.front() == ' ') {
+        line.remove_prefix(1);
+      }
+    }
+
+    // Tags are recognized at the start of a line in both Javadoc (@tag) and Doxygen (\tag) form
+    std::string_view tagged = skipSpace(line);
+    size_t name_len = tagged.size() > 1 && (tagged[0] == '@' || tagged[0] == '\\') ? wordLength(tagged.substr(1)) : 0;
+    if (name_len == 0) {
+      if (in_description && !line.empty()) {
+        description.append(line);
+        description += '\n';
+      }
+      continue;
+    }
+
+    in_description = false;
+    std::string_view name = tagged.substr(1, name_len);
+    std::string_view rest = tagged.substr(1 + name_len);
+
+    // Argument text must be separated from the tag name by whitespace
+    std::string_view args;
+    if (!rest.empty() && isSpace(rest.front())) {
+      args = skipSpace(rest);
+    }
+
+    if (name == "param") {
+      size_t param_len = wordLength(args);
+      if (param_len > 0 && param_len < args.size() && isSpace(args[param_len])) {
+        std::string_view param_desc = trimView(args.substr(param_len));
+        if (!param_desc.empty()) {
+          block.params[std::string(args.substr(0, param_len))] = std::string(param_desc);
+          continue;
+        }
+      }
+    } else if (name == "return" || name == "returns") {
+      if (!args.empty()) {
+        block.return_desc = std::string(trimView(args));
+        continue;
+      }
+    } else if (name == "brief") {
+      // @brief only closes the free-form description, as in the regex scanner
+      if (!args.empty()) continue;
+    } else if (name == "file") {
+      // Optional override for filename
+      if (!args.empty()) block.override_file = std::string(trimView(args));
+      continue;
+    } else if (name == "class" || name == "struct" || name == "enum") {
+      // Optional override for class/struct/enum name
+      size_t symbol_len = wordLength(args);
+      if (symbol_len > 0) {
+        std::string symbol(args.substr(0, symbol_len));
+        if (name == "class") block.override_class = symbol;
+        else if (name == "struct") block.override_struct = symbol;
+        else block.override_enum = symbol;
+      }
+      continue;
+    }
+
+    // Store other tags (and malformed known tags) for completeness
+    std::string tag(name);
+    if (!args.empty()) {
+      tag += ": ";
+      tag.append(args);
+    }
+    block.tags.push_back(std::move(tag));
+  }
+
+  block.description = trim(description);
+}
+
+DocstringBlock DocstringParser::parseDocstringContentRegex(const std::string& raw) {
   DocstringBlock block;
   block.raw_content = raw;
 
@@ -216,19 +428,3 @@ std::string DocstringParser::trim(const std::string& str) {
   size_t end = str.find_last_not_of(" \t\n\r");
   return str.substr(start, end - start + 1);
 }
-
-SourceLocation DocstringParser::getSourceLocation(const std::string& content, size_t byte_offset) {
-  size_t line = 1;
-  size_t column = 1;
-
-  for (size_t i = 0; i < byte_offset && i < content.length(); i++) {
-    if (content[i] == '\n') {
-      line++;
-      column = 1;
-    } else {
-      column++;
-    }
-  }
-
-  return {line, column, byte_offset};
-}
\ No newline at end of file
@@ -2,25 +2,46 @@
 @brief Tree-sitter AST parsing utilities implementation
 */
 #include <backend/doc/cpp/ts_ast_parser.h>
-// #include <cstring>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
 
 void DocAssociator::associateDocsWithNodes(std::vector<DocstringBlock>& docstring_blocks,
                                            TSTree* tree, const std::string& content) {
   TSNode root = ts_tree_root_node(tree);
-
-  for (auto& block : docstring_blocks) {
-    TSNode following_node = findFollowingDeclaration(tree, root, block.location);
-    if (!ts_node_is_null(following_node)) {
-      block.associated_node = following_node;
-      block.namespace_path = extractNamespacePath(following_node, content);
-      block.symbol_name = extractSymbolName(following_node, content);
-      block.symbol_type = std::string(ts_node_type(following_node));
+  std::vector<TSNode> declarations = collectDeclarations(tree, root);
+
+  // Visit comments in offset order and advance through the declarations alongside,
+  // so each comment meets the first declaration starting after it in one merge pass
+  std::vector<size_t> order(docstring_blocks.size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return docstring_blocks[a].location.byte_offset < docstring_blocks[b].location.byte_offset;
+  });
+
+  size_t next = 0;
+  for (size_t index : order) {
+    auto& block = docstring_blocks[index];
+    while (next < declarations.size() && ts_node_start_byte(declarations[next]) <= block.location.byte_offset) {
+      ++next;
+    }
+    if (next == declarations.size()) {
+      break;  // Later comments have no following declaration either
     }
+    TSNode following_node = declarations[next];
+    block.associated_node = following_node;
+    block.namespace_path = extractNamespacePath(following_node, content);
+    block.symbol_name = extractSymbolName(following_node, content);
+    block.symbol_type = std::string(ts_node_type(following_node));
   }
 }
 
-TSNode DocAssociator::findFollowingDeclaration(TSTree* tree, TSNode root, SourceLocation docstring_loc) {
-                                               //const std::string& content) {
+const TSQuery* DocAssociator::declarationQuery(const TSLanguage* language) {
+  auto cached = declaration_queries_.find(language);
+  if (cached != declaration_queries_.end()) {
+    return cached->second.get();
+  }
+
   const char* query_string = R"(
     [
       (function_definition) @decl
@@ -30,38 +51,32 @@ TSNode DocAssociator::findFollowingDeclaration(TSTree* tree, TSNode root, Source
       (enum_specifier) @decl
     ]
   )";
-
-  const TSLanguage* language = ts_tree_language(tree);
   uint32_t error_offset;
   TSQueryError error_type;
-  TSQuery* query = ts_query_new(language, query_string, strlen(query_string),
-                               &error_offset, &error_type);
+  TSQueryPtr query(ts_query_new(language, query_string, static_cast<uint32_t>(strlen(query_string)),
+                                &error_offset, &error_type));
+  // A failed compile is cached too, so it is not retried for every file
+  return declaration_queries_.emplace(language, std::move(query)).first->second.get();
+}
 
-  if (!query) return {};
+std::vector<TSNode> DocAssociator::collectDeclarations(TSTree* tree, TSNode root) {
+  std::vector<TSNode> declarations;
+  const TSQuery* query = declarationQuery(ts_tree_language(tree));
+  if (!query) return declarations;
 
   TSQueryCursor* cursor = ts_query_cursor_new();
   ts_query_cursor_exec(cursor, query, root);
-
   TSQueryMatch match;
-  TSNode best_match = {};
-  uint32_t best_distance = UINT32_MAX;
-
   while (ts_query_cursor_next_match(cursor, &match)) {
-    TSNode node = match.captures[0].node;
-    uint32_t start_byte = ts_node_start_byte(node);
-
-    if (start_byte > docstring_loc.byte_offset) {
-      uint32_t distance = start_byte - docstring_loc.byte_offset;
-      if (distance < best_distance) {
-        best_distance = distance;
-        best_match = node;
-      }
-    }
+    declarations.push_back(match.captures[0].node);
   }
-
   ts_query_cursor_delete(cursor);
-  ts_query_delete(query);
-  return best_match;
+
+  // Stable, so of two declarations starting at the same byte the first match wins as before
+  std::stable_sort(declarations.begin(), declarations.end(), [](TSNode a, TSNode b) {
+    return ts_node_start_byte(a) < ts_node_start_byte(b);
+  });
+  return declarations;
 }
 
 std::string DocAssociator::extractNamespacePath(TSNode node, const std::string& content) {
@@ -9,15 +9,75 @@
 #include <fstream>
 #include <filesystem>
 #include <set>
+#include <atomic>
+#include <chrono>
+#include <csignal>
 // #include <cstring>
 #include <backend/doc/docgen.h>
 #include <backend/doc/cache.h>
+#include <backend/doc/symbol_index.h>
+#include <backend/doc/treesitter.h>
 #include <backend/core/dynlib.h>
 #include <backend/core/cli_utils.h>
+#include <backend/core/file_watcher.h>
+#include <backend/core/profile.h>
 #ifdef _WIN32
   #include <backend/core/win32.h>
 #endif
 
+// Parse a non-negative integer option value (--jobs, where 0 = hardware concurrency, or --profile-top)
+static bool parseCount(const std::string& value, size_t& jobs) {
+  try {
+    size_t consumed = 0;
+    unsigned long parsed = std::stoul(value, &consumed);
+    if (consumed != value.size()) {
+      return false;
+    }
+    jobs = static_cast<size_t>(parsed);
+    return true;
+  } catch (const std::exception&) {
+    return false;
+  }
+}
+
+// Start recording if --profile was given; false if --profile-top is malformed
+static bool beginProfile(const CommandArgParser& parser, std::string& profile_path, size_t& slowest) {
+  profile_path = parser.getOption("--profile");
+  std::string top_option = parser.getOption("--profile-top");
+  slowest = 10;
+  if (!top_option.empty() && !parseCount(top_option, slowest)) {
+    CLILogger::error("Invalid value for --profile-top: " + top_option);
+    return false;
+  }
+  if (!profile_path.empty()) {
+    // Before any parser exists, so every tree-sitter allocation is counted for the per-file peaks
+    parser_memory::install();
+    profile::start();
+  }
+  return true;
+}
+
+// Write the --profile report and print its summary (also after a failed run)
+static void finishProfile(const std::string& profile_path, size_t slowest) {
+  if (profile_path.empty()) {
+    return;
+  }
+  profile::stop();
+  profile::printSummary(slowest);
+  if (profile::writeReport(profile_path, slowest)) {
+    std::cout << "Profile written to " << profile_path << std::endl;
+  } else {
+    CLILogger::error("Failed to write profile: " + profile_path);
+  }
+}
+
+// Set by Ctrl+C so the watch loop can save the cache and exit cleanly
+static std::atomic<bool> watch_interrupted{false};
+
+static void onWatchInterrupt(int) {
+  watch_interrupted = true;
+}
+
 int CesiumDocCLI::run(int argc, char* argv[]) {
   if (argc < 1) {
     printUsage();
@@ -48,8 +108,14 @@ int CesiumDocCLI::run(int argc, char* argv[]) {
     return extractDocs(argc, argv);
   } else if (command == "generate" || command == "gen") {
     return generateDocs(argc, argv);
+  } else if (command == "watch") {
+    return watchDocs(argc, argv);
   } else if (command == "prune") {
     return pruneDocs(argc, argv);
+  } else if (command == "export-cache") {
+    return exportCache(argc, argv);
+  } else if (command == "lookup") {
+    return lookupSymbols(argc, argv);
   } else if (command == "list-parsers") {
     return listParsers(argc, argv);
   } else if (command == "init-config") {
@@ -66,7 +132,10 @@ void CesiumDocCLI::printUsage() {
   std::cout << "Commands:\n";
   std::cout << "  extract, ext [source]     Extract docstrings to markdown snippets\n";
   std::cout << "  generate, gen             Generate structured documentation\n";
+  std::cout << "  watch                     Re-extract files as they change\n";
   std::cout << "  prune                     Remove orphaned documentation files\n";
+  std::cout << "  export-cache              Write the extraction cache as JSON\n";
+  std::cout << "  lookup <symbol>           Find documented symbols in the saved index\n";
   std::cout << "  list-parsers              List available language parsers\n";
   std::cout << "  init-config [filename]    Create default configuration file\n";
   std::cout << "\nGlobal Options:\n";
@@ -75,6 +144,8 @@ void CesiumDocCLI::printUsage() {
   std::cout << "\nExtract/Generate Options:\n";
   std::cout << "  --source <path>           Source file or directory to process\n";
   std::cout << "  --extract-dir <dir>       Extract directory override\n";
+  std::cout << "  --jobs <n>                Number of parallel extraction workers (0 = all cores)\n";
+  std::cout << "  --profile <file>          Write per-stage timings as a Chrome trace\n";
   std::cout << "\nUse 'cesium doc <command> -h' for command-specific help.\n";
 }
 
@@ -86,9 +157,20 @@ void CesiumDocCLI::printExtractUsage() {
   std::cout << "  --source <path>           Source file or directory to process\n";
   std::cout << "  --extract-dir <dir>       Extract directory override (default: .cesium-doc/)\n";
   std::cout << "  --config <file>           Configuration file (default: cesium-doc-config.json[c])\n";
+  std::cout << "  --jobs <n>                Number of parallel extraction workers (default: config\n";
+  std::cout << "                            \"parallelism\", 0 = all cores)\n";
+  std::cout << "  --profile <file>          Write per-stage timings and per-file parse times as a\n";
+  std::cout << "                            Chrome trace (chrome://tracing, Perfetto)\n";
+  std::cout << "  --profile-top <n>         Slowest files listed in the profile (default: 10)\n";
+  std::cout << "  --format <json|ndjson>    Stream constructs as JSON instead of writing snippets\n";
+  std::cout << "                            (no cache, no cross-file merge)\n";
+  std::cout << "  --output <file>           Destination of --format output (default: -, stdout)\n";
   std::cout << "  --help, -h               Show this help message\n\n";
   std::cout << "Examples:\n";
   std::cout << "  cesium doc extract                          # Extract all configured sources\n";
+  std::cout << "  cesium doc extract --format ndjson | jq .   # Pipe constructs into another tool\n";
+  std::cout << "  cesium doc extract --jobs 8                 # Extract with 8 workers\n";
+  std::cout << "  cesium doc extract --profile trace.json     # Find where extraction time goes\n";
   std::cout << "  cesium doc extract --source src/main.cpp    # Extract specific file\n";
   std::cout << "  cesium doc extract --source include/        # Extract specific directory\n";
 }
@@ -99,11 +181,46 @@ void CesiumDocCLI::printGenerateUsage() {
   std::cout << "This runs extract first to ensure all changed files are processed.\n\n";
   std::cout << "Options:\n";
   std::cout << "  --config <file>           Configuration file (default: cesium-doc-config.json[c])\n";
+  std::cout << "  --jobs <n>                Number of parallel extraction workers (0 = all cores)\n";
+  std::cout << "  --profile <file>          Write per-stage timings as a Chrome trace\n";
+  std::cout << "  --profile-top <n>         Slowest files listed in the profile (default: 10)\n";
   std::cout << "  --help, -h               Show this help message\n\n";
   std::cout << "Examples:\n";
   std::cout << "  cesium doc generate                         # Generate docs from all sources\n";
 }
 
+// Stream every construct to --output (stdout for "-") instead of writing snippets
+static int exportConstructs(CesiumDocExtractor& extractor, const std::string& source_override,
+                            ConstructFormat format, const std::string& output_path,
+                            const std::string& profile_path, size_t profile_top) {
+  std::ofstream file;
+  std::ostream stdout_stream(std::cout.rdbuf());
+  bool to_stdout = output_path.empty() || output_path == "-";
+  if (!to_stdout) {
+    file.open(output_path, std::ios::binary);
+    if (!file) {
+      CLILogger::error("Cannot open output file: " + output_path);
+      return 1;
+    }
+  }
+
+  // Progress and log messages go to stderr while constructs are streamed to stdout
+  std::streambuf* saved_cout = to_stdout ? std::cout.rdbuf(std::cerr.rdbuf()) : nullptr;
+  ConstructStreamWriter writer(to_stdout ? stdout_stream : file, format);
+  bool exported = extractor.exportConstructs(source_override, writer);
+  bool written = writer.finish();
+  finishProfile(profile_path, profile_top);
+  if (saved_cout) {
+    std::cout.rdbuf(saved_cout);
+  }
+
+  if (!exported || !written) {
+    std::cerr << "Construct export failed!" << std::endl;
+    return 1;
+  }
+  std::cerr << "Exported " << writer.count() << " constructs" << std::endl;
+  return 0;
+}
 
 int CesiumDocCLI::extractDocs(int argc, char* argv[]) {
   CommandArgParser parser(argc, argv, "extract");
@@ -118,6 +235,19 @@ int CesiumDocCLI::extractDocs(int argc, char* argv[]) {
   std::string config_path = parser.getOption("--config");
   std::string source_override = parser.getOption("--source");
   std::string extract_dir_override = parser.getOption("--extract-dir");
+  std::string jobs_option = parser.getOption("--jobs");
+  std::string format_option = parser.getOption("--format");
+  std::string output_path = parser.getOption("--output");
+
+  ConstructFormat format = ConstructFormat::Ndjson;
+  if (!format_option.empty() && !parseConstructFormat(format_option, format)) {
+    CLILogger::error("Invalid value for --format: " + format_option + " (expected json or ndjson)");
+    return 1;
+  }
+  if (!output_path.empty() && format_option.empty()) {
+    CLILogger::error("--output requires --format");
+    return 1;
+  }
 
   // Handle positional arguments (treat first one as source if --source not specified)
   auto positional = parser.getPositionalArgs();
@@ -134,11 +264,33 @@ int CesiumDocCLI::extractDocs(int argc, char* argv[]) {
   }
 
   CesiumDocExtractor extractor;
-  if (!extractor.initialize(config_path)) {
+  if (!jobs_option.empty()) {
+    size_t jobs = 0;
+    if (!parseCount(jobs_option, jobs)) {
+      CLILogger::error("Invalid value for --jobs: " + jobs_option);
+      return 1;
+    }
+    extractor.setParallelism(jobs);
+  }
+
+  std::string profile_path;
+  size_t profile_top = 0;
+  if (!beginProfile(parser, profile_path, profile_top)) {
     return 1;
   }
 
-  if (!extractor.extract(config_path, source_override, extract_dir_override)) {
+  auto config = CesiumDoc::loadConfig(config_path);
+  if (!config || !extractor.initialize(*config)) {
+    return 1;
+  }
+
+  if (!format_option.empty()) {
+    return exportConstructs(extractor, source_override, format, output_path, profile_path, profile_top);
+  }
+
+  bool extracted = extractor.extract(source_override, extract_dir_override);
+  finishProfile(profile_path, profile_top);
+  if (!extracted) {
     std::cerr << "Documentation extraction failed!" << std::endl;
     return 1;
   }
@@ -158,6 +310,7 @@ int CesiumDocCLI::generateDocs(int argc, char* argv[]) {
 
   // Get options
   std::string config_path = parser.getOption("--config");
+  std::string jobs_option = parser.getOption("--jobs");
   bool config_specified = !config_path.empty();
 
   // Validate and resolve configuration file
@@ -167,11 +320,29 @@ int CesiumDocCLI::generateDocs(int argc, char* argv[]) {
   }
 
   CesiumDocExtractor extractor;
-  if (!extractor.initialize(config_path)) {
+  if (!jobs_option.empty()) {
+    size_t jobs = 0;
+    if (!parseCount(jobs_option, jobs)) {
+      CLILogger::error("Invalid value for --jobs: " + jobs_option);
+      return 1;
+    }
+    extractor.setParallelism(jobs);
+  }
+
+  std::string profile_path;
+  size_t profile_top = 0;
+  if (!beginProfile(parser, profile_path, profile_top)) {
+    return 1;
+  }
+
+  auto config = CesiumDoc::loadConfig(config_path);
+  if (!config || !extractor.initialize(*config)) {
     return 1;
   }
 
-  if (!extractor.generate(config_path)) {
+  bool generated = extractor.generate();
+  finishProfile(profile_path, profile_top);
+  if (!generated) {
     std::cerr << "Documentation generation failed!" << std::endl;
     return 1;
   }
@@ -181,6 +352,135 @@ int CesiumDocCLI::generateDocs(int argc, char* argv[]) {
 }
 
 
+void CesiumDocCLI::printWatchUsage() {
+  std::cout << "Usage: cesium doc watch [options]\n\n";
+  std::cout << "Extract once, then keep parsers and cache loaded and re-extract files as they\n";
+  std::cout << "are saved, renamed or deleted. Press Ctrl+C to stop.\n\n";
+  std::cout << "Options:\n";
+  std::cout << "  --config <file>           Configuration file (default: cesium-doc-config.json[c])\n";
+  std::cout << "  --extract-dir <dir>       Extract directory override (default: .cesium-doc/)\n";
+  std::cout << "  --jobs <n>                Number of parallel extraction workers (0 = all cores)\n";
+  std::cout << "  --generate                Also regenerate structured documentation after each change\n";
+  std::cout << "  --help, -h               Show this help message\n\n";
+  std::cout << "Examples:\n";
+  std::cout << "  cesium doc watch                            # Keep snippets up to date\n";
+  std::cout << "  cesium doc watch --generate                 # Keep generated docs up to date\n";
+}
+
+int CesiumDocCLI::watchDocs(int argc, char* argv[]) {
+  CommandArgParser parser(argc, argv, "watch");
+
+  // Check for help first
+  if (parser.hasFlag("--help") || parser.hasFlag("-h")) {
+    printWatchUsage();
+    return 0;
+  }
+
+  // Get options
+  std::string config_path = parser.getOption("--config");
+  std::string extract_dir_override = parser.getOption("--extract-dir");
+  std::string jobs_option = parser.getOption("--jobs");
+  bool regenerate = parser.hasFlag("--generate");
+  bool config_specified = !config_path.empty();
+
+  // Validate and resolve configuration file
+  config_path = CesiumDoc::validateAndResolveConfig(config_path, config_specified);
+  if (config_path.empty()) {
+    return 1;
+  }
+
+  CesiumDocExtractor extractor;
+  if (!jobs_option.empty()) {
+    size_t jobs = 0;
+    if (!parseCount(jobs_option, jobs)) {
+      CLILogger::error("Invalid value for --jobs: " + jobs_option);
+      return 1;
+    }
+    extractor.setParallelism(jobs);
+  }
+
+  auto config = CesiumDoc::loadConfig(config_path);
+  if (!config || !extractor.initialize(*config)) {
+    return 1;
+  }
+  std::string extract_dir = extract_dir_override.empty() ? config->extract_directory : extract_dir_override;
+  std::string extract_key = FsSnapshot::normalize(extract_dir);
+
+  // Catch up with changes made while nothing was watching
+  if (!extractor.extract("", extract_dir_override) ||
+      (regenerate && !extractor.generateFromSnippets(extract_dir_override))) {
+    std::cerr << "Documentation extraction failed!" << std::endl;
+    return 1;
+  }
+
+  FileWatcher watcher;
+  watcher.setExcludes(&extractor.excludePatterns());
+  size_t watched_roots = 0;
+  for (const auto& dir : config->source_directories) {
+    if (watcher.addRoot(dir)) {
+      watched_roots++;
+    } else {
+      CLILogger::warning("Cannot watch source directory: " + dir);
+    }
+  }
+  if (watched_roots == 0) {
+    CLILogger::error("No source directories could be watched");
+    return 1;
+  }
+
+  watch_interrupted = false;
+  auto previous_handler = std::signal(SIGINT, onWatchInterrupt);
+  std::cout << "Watching " << watched_roots << " source directories (" << FileWatcher::backendName()
+            << "). Press Ctrl+C to stop." << std::endl;
+
+  int exit_code = 0;
+  while (!watch_interrupted) {
+    // Short timeout so Ctrl+C is noticed promptly
+    FileWatcher::Changes changes = watcher.wait(std::chrono::milliseconds(250));
+    if (changes.paths.empty() && !changes.overflow) {
+      continue;
+    }
+
+    // Snippets written into a watched tree must not trigger another round
+    std::vector<std::string> changed;
+    for (auto& path : changes.paths) {
+      std::string key = FsSnapshot::normalize(path);
+      if (key != extract_key && !key.starts_with(extract_key + "/")) {
+        changed.push_back(std::move(path));
+      }
+    }
+    if (changed.empty() && !changes.overflow) {
+      continue;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = changes.overflow
+      ? extractor.extract("", extract_dir_override)
+      : extractor.extractChanged(changed, extract_dir_override);
+    if (ok && regenerate) {
+      ok = extractor.generateFromSnippets(extract_dir_override);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    if (!ok) {
+      std::cerr << "Documentation extraction failed!" << std::endl;
+      exit_code = 1;
+      break;
+    }
+    if (changes.overflow) {
+      std::cout << "Change events were lost; re-scanned all sources in " << elapsed.count() << " ms" << std::endl;
+    } else {
+      std::cout << "Refreshed " << changed.size() << " changed paths in " << elapsed.count() << " ms" << std::endl;
+    }
+  }
+
+  std::signal(SIGINT, previous_handler);
+  if (exit_code == 0) {
+    CLILogger::success("Stopped watching.");
+  }
+  return exit_code;
+}
+
 // Helper function to extract language from parser filename (fallback)
 std::string extractLanguageFromFilename(const std::string& filename) {
   // Remove common prefixes and suffixes
@@ -312,9 +612,9 @@ int CesiumDocCLI::listParsers(int argc, char* argv[]) {
       has_config = true;
     }
   } else {
-    CLILogger::debuglow("listAvailableLanguages: Checking if config file exists: " + config_path);
+    LOG_DEBUGLOW("listAvailableLanguages: Checking if config file exists: " + config_path);
     has_config = std::filesystem::exists(config_path);
-    CLILogger::debuglow("listAvailableLanguages: Config file " + config_path + (has_config ? " exists" : " does not exist"));
+    LOG_DEBUGLOW("listAvailableLanguages: Config file " + config_path + (has_config ? " exists" : " does not exist"));
   }
 
   // 1. Show parsers from config file (highest priority)
@@ -380,7 +680,7 @@ int CesiumDocCLI::listParsers(int argc, char* argv[]) {
   bool match = false;
   try {
     bool found_any = false;
-    CLILogger::debug("listAvailableLanguages: Scanning current directory for tree-sitter parsers");
+    LOG_DEBUG("listAvailableLanguages: Scanning current directory for tree-sitter parsers");
     for (const auto& entry : std::filesystem::directory_iterator(".")) {
       std::string filename = entry.path().filename().string();
       #ifdef _WIN32
@@ -390,7 +690,7 @@ int CesiumDocCLI::listParsers(int argc, char* argv[]) {
       #endif
       if (match) {
         std::filesystem::path full_path = std::filesystem::path(".") / filename;
-        CLILogger::debuglow("listAvailableLanguages: Found tree-sitter parser: " + filename);
+        LOG_DEBUGLOW("listAvailableLanguages: Found tree-sitter parser: " + filename);
         std::string language = getLanguageFromParser(full_path.string());
         if (found_languages.find(language) != found_languages.end()) {
           std::cout << "  " << language << ": " << filename << " (superseded by config)" << std::endl;
@@ -405,7 +705,7 @@ int CesiumDocCLI::listParsers(int argc, char* argv[]) {
       std::cout << "  (none found)" << std::endl;
     }
   } catch (const std::filesystem::filesystem_error& e) {
-    CLILogger::debuglow("listAvailableLanguages: Error scanning current directory: " + std::string(e.what()));
+    LOG_DEBUGLOW("listAvailableLanguages: Error scanning current directory: " + std::string(e.what()));
     std::cout << "  (directory not accessible)" << std::endl;
   }
   std::cout << std::endl;
@@ -432,26 +732,26 @@ int CesiumDocCLI::listParsers(int argc, char* argv[]) {
     std::filesystem::path exe_path;
     #ifdef _WIN32
       // On Windows, get the executable path
-      CLILogger::debuglow("listAvailableLanguages: Getting Windows executable path");
+      LOG_DEBUGLOW("listAvailableLanguages: Getting Windows executable path");
       try {
         exe_path = std::filesystem::canonical(utf8::GetModuleFileName());
-        CLILogger::debuglow("listAvailableLanguages: Windows exe path: " + exe_path.string());
+        LOG_DEBUGLOW("listAvailableLanguages: Windows exe path: " + exe_path.string());
       } catch (const std::filesystem::filesystem_error& e) {
-        CLILogger::debuglow("listAvailableLanguages: Failed to get Windows exe path: " + std::string(e.what()));
+        LOG_DEBUGLOW("listAvailableLanguages: Failed to get Windows exe path: " + std::string(e.what()));
       }
     #else
       // On POSIX systems, try /proc/self/exe (Linux) or other methods
-      CLILogger::debuglow("listAvailableLanguages: Checking for /proc/self/exe on POSIX system");
+      LOG_DEBUGLOW("listAvailableLanguages: Checking for /proc/self/exe on POSIX system");
       if (std::filesystem::exists("/proc/self/exe")) {
-        CLILogger::debuglow("listAvailableLanguages: /proc/self/exe exists, getting canonical path");
+        LOG_DEBUGLOW("listAvailableLanguages: /proc/self/exe exists, getting canonical path");
         try {
           exe_path = std::filesystem::canonical("/proc/self/exe");
-          CLILogger::debuglow("listAvailableLanguages: POSIX exe path: " + exe_path.string());
+          LOG_DEBUGLOW("listAvailableLanguages: POSIX exe path: " + exe_path.string());
         } catch (const std::filesystem::filesystem_error& e) {
-          CLILogger::debuglow("listAvailableLanguages: Failed to get POSIX exe path: " + std::string(e.what()));
+          LOG_DEBUGLOW("listAvailableLanguages: Failed to get POSIX exe path: " + std::string(e.what()));
         }
       } else {
-        CLILogger::debuglow("listAvailableLanguages: /proc/self/exe does not exist");
+        LOG_DEBUGLOW("listAvailableLanguages: /proc/self/exe does not exist");
       }
     #endif
     if (!exe_path.empty()) {
@@ -474,7 +774,7 @@ int CesiumDocCLI::listParsers(int argc, char* argv[]) {
     std::cout << "  In " << path << ":\n";
     try {
       bool found_any = false;
-      CLILogger::debug("listAvailableLanguages: Scanning system path for parsers: " + path);
+      LOG_DEBUG("listAvailableLanguages: Scanning system path for parsers: " + path);
       for (const auto& entry : std::filesystem::directory_iterator(path)) {
         std::string filename = entry.path().filename().string();
         #ifdef _WIN32
@@ -484,7 +784,7 @@ int CesiumDocCLI::listParsers(int argc, char* argv[]) {
         #endif
         if (match) {
           std::filesystem::path full_path = std::filesystem::path(path) / filename;
-          CLILogger::debuglow("listAvailableLanguages: Found parser in system path " + path + ": " + filename);
+          LOG_DEBUGLOW("listAvailableLanguages: Found parser in system path " + path + ": " + filename);
           std::string language = getLanguageFromParser(full_path.string());
           if (found_languages.find(language) != found_languages.end()) {
             std::cout << "    " << language << ": " << filename << " (superseded)" << std::endl;
@@ -499,7 +799,7 @@ int CesiumDocCLI::listParsers(int argc, char* argv[]) {
         std::cout << "    (none found)" << std::endl;
       }
     } catch (const std::filesystem::filesystem_error& e) {
-      CLILogger::debuglow("listAvailableLanguages: Cannot scan system path '" + path + "': " + e.what());
+      LOG_DEBUGLOW("listAvailableLanguages: Cannot scan system path '" + path + "': " + e.what());
       std::cout << "    (directory not accessible)" << std::endl;
     }
   }
@@ -543,7 +843,8 @@ int CesiumDocCLI::initConfig(int argc, char* argv[]) {
   "source_directories": ["cesium/src/", "cesium/include/"],
   "extract_directory": ".cesium-doc/",
   "output_directory": "docs/extracted/",
-  "exclude_patterns": ["**/test/**", "**/*_test.*"]
+  "exclude_patterns": ["**/test/**", "**/*_test.*"],
+  "parallelism": 0
 })";
 
   file.close();
@@ -610,6 +911,7 @@ int CesiumDocCLI::pruneDocs(int argc, char* argv[]) {
   std::string cache_file = cache_path.string();
 
   DocumentationCache cache(cache_file);
+  cache.applyConfig(config_ref);
   if (!cache.load()) {
     CLILogger::warning("No cache file found or cache is corrupted. Nothing to prune.");
     return 0;
@@ -635,3 +937,150 @@ int CesiumDocCLI::pruneDocs(int argc, char* argv[]) {
 
   return 0;
 }
+
+void CesiumDocCLI::printExportCacheUsage() {
+  std::cout << "Usage: cesium doc export-cache [options]\n\n";
+  std::cout << "Write the extraction cache as JSON, whichever format it is stored in.\n\n";
+  std::cout << "Options:\n";
+  std::cout << "  --output <file>           Output file (default: cesium-cache-export.json)\n";
+  std::cout << "  --config <file>           Configuration file (default: cesium-doc-config.json[c])\n";
+  std::cout << "  --extract-dir <dir>       Extract directory override (default: .cesium-doc/)\n";
+  std::cout << "  --help, -h               Show this help message\n";
+}
+
+int CesiumDocCLI::exportCache(int argc, char* argv[]) {
+  CommandArgParser parser(argc, argv, "export-cache");
+
+  if (parser.hasFlag("--help") || parser.hasFlag("-h")) {
+    printExportCacheUsage();
+    return 0;
+  }
+
+  std::string config_path = parser.getOption("--config");
+  std::string extract_dir_override = parser.getOption("--extract-dir");
+  std::string output_path = parser.getOption("--output");
+  if (output_path.empty()) {
+    output_path = "cesium-cache-export.json";
+  }
+
+  if (config_path.empty()) {
+    config_path = CesiumDoc::findDefaultConfigFile();
+    if (config_path.empty()) {
+      CLILogger::error("No configuration file specified and no default config found.");
+      CLILogger::stderr_msg("Use --config <file> or create cesium-doc-config.json or cesium-doc-config.jsonc in current directory.");
+      return 1;
+    }
+  }
+
+  auto config = JsonDoc::fromFile(config_path);
+  if (!config) {
+    CLILogger::error("Failed to load configuration from: " + config_path);
+    return 1;
+  }
+
+  const JsonDoc& config_ref = *config;
+  std::string extract_dir = extract_dir_override.empty() ?
+    static_cast<std::string>(config_ref["extract_directory"]) : extract_dir_override;
+
+  std::filesystem::path cache_path = std::filesystem::path(extract_dir) / ".cesium-cache.json";
+  DocumentationCache cache(cache_path.string());
+  cache.applyConfig(config_ref);
+  if (!cache.load()) {
+    CLILogger::error("No cache file found or cache is corrupted in: " + extract_dir);
+    return 1;
+  }
+
+  if (!cache.exportJson(output_path)) {
+    return 1;
+  }
+
+  auto [file_count, generated_count] = cache.getStats();
+  CLILogger::success("Exported " + std::to_string(file_count) + " cache entries (" +
+                     std::to_string(generated_count) + " outputs) to " + output_path);
+  return 0;
+}
+
+void CesiumDocCLI::printLookupUsage() {
+  std::cout << "Usage: cesium doc lookup [options] <symbol>\n\n";
+  std::cout << "Find documented symbols in the index saved by 'cesium doc generate'.\n";
+  std::cout << "A qualified name matches that symbol; an unqualified one matches every symbol\n";
+  std::cout << "with that name. Each match is printed as one tab-separated line:\n";
+  std::cout << "full name, type, file:line and page.\n\n";
+  std::cout << "Options:\n";
+  std::cout << "  --prefix <text>           Symbols whose qualified name starts with text\n";
+  std::cout << "  --uses <type>             Symbols whose return or parameter types mention a type\n";
+  std::cout << "  --config <file>           Configuration file (default: cesium-doc-config.json[c])\n";
+  std::cout << "  --extract-dir <dir>       Extract directory override (default: .cesium-doc/)\n";
+  std::cout << "  --help, -h               Show this help message\n\n";
+  std::cout << "Examples:\n";
+  std::cout << "  cesium doc lookup geo::Shape::area          # Where is this method documented?\n";
+  std::cout << "  cesium doc lookup --prefix geo::Shape::     # Members of a class\n";
+  std::cout << "  cesium doc lookup --uses geo::Shape         # Functions taking or returning Shape\n";
+}
+
+int CesiumDocCLI::lookupSymbols(int argc, char* argv[]) {
+  CommandArgParser parser(argc, argv, "lookup");
+
+  if (parser.hasFlag("--help") || parser.hasFlag("-h")) {
+    printLookupUsage();
+    return 0;
+  }
+
+  std::string config_path = parser.getOption("--config");
+  std::string extract_dir_override = parser.getOption("--extract-dir");
+  std::string prefix = parser.getOption("--prefix");
+  std::string type_name = parser.getOption("--uses");
+  auto positional = parser.getPositionalArgs();
+  if (prefix.empty() && type_name.empty() && positional.empty()) {
+    printLookupUsage();
+    return 1;
+  }
+
+  if (config_path.empty()) {
+    config_path = CesiumDoc::findDefaultConfigFile();
+    if (config_path.empty()) {
+      CLILogger::error("No configuration file specified and no default config found.");
+      CLILogger::stderr_msg("Use --config <file> or create cesium-doc-config.json or cesium-doc-config.jsonc in current directory.");
+      return 1;
+    }
+  }
+
+  auto config = JsonDoc::fromFile(config_path);
+  if (!config) {
+    CLILogger::error("Failed to load configuration from: " + config_path);
+    return 1;
+  }
+
+  const JsonDoc& config_ref = *config;
+  std::string extract_dir = extract_dir_override.empty() ?
+    static_cast<std::string>(config_ref["extract_directory"]) : extract_dir_override;
+  std::string output_dir = config_ref["output_directory"].asString();
+
+  SymbolIndexView index;
+  std::string index_path = symbolIndexPath(extract_dir);
+  if (!index.open(index_path)) {
+    CLILogger::error("No symbol index found in: " + extract_dir);
+    CLILogger::stderr_msg("Run 'cesium doc generate' to create it.");
+    return 1;
+  }
+
+  std::vector<size_t> matches;
+  if (!prefix.empty()) {
+    auto [begin, end] = index.prefixRange(prefix);
+    for (size_t i = begin; i < end; ++i) matches.push_back(i);
+  } else if (!type_name.empty()) {
+    matches = index.usersOf(type_name);
+  } else if (auto exact = index.find(positional[0])) {
+    matches.push_back(*exact);
+  } else {
+    matches = index.withName(positional[0]);
+  }
+
+  for (size_t match : matches) {
+    SymbolRecord symbol = index.symbolAt(match);
+    std::cout << symbol.full_name << '\t' << symbol.type << '\t' << symbol.file << ':' << symbol.line << '\t'
+              << (std::filesystem::path(output_dir) / symbol.page).string() << '\n';
+  }
+  std::cout.flush();
+  return matches.empty() ? 1 : 0;
+}
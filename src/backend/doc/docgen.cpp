@@ -2,226 +2,680 @@
 @brief Core documentation extraction and generation implementation
 */
 #include <backend/doc/docgen.h>
+#include <backend/doc/snippet_processor.h>
 #include <iostream>
-#include <fstream>
 #include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <numeric>
+#include <unordered_set>
 #include <backend/core/json.h>
 #include <backend/core/cli_utils.h>
+#include <backend/core/parallel.h>
+#include <backend/core/profile.h>
+
+// Set by the build from the project version; part of every shared cache key
+#ifndef CESIUM_VERSION
+  #define CESIUM_VERSION "dev"
+#endif
+
+namespace {
+  // Map #include spellings to files on disk: relative to the including file first,
+  // then against each configured source directory. Unresolved (system) includes are dropped.
+  std::vector<std::string> resolveIncludes(const std::string& filepath,
+                                           const std::vector<std::string>& includes,
+                                           const std::vector<std::string>& include_roots) {
+    std::vector<std::string> resolved;
+    std::filesystem::path including_dir = std::filesystem::path(filepath).parent_path();
+
+    for (const auto& include : includes) {
+      std::vector<std::filesystem::path> candidates;
+      candidates.push_back(including_dir / include);
+      for (const auto& root : include_roots) {
+        candidates.push_back(std::filesystem::path(root) / include);
+      }
+
+      for (auto& candidate : candidates) {
+        // Keep the joined spelling so paths match the ones directory iteration produces
+        if (include.find("..") != std::string::npos) {
+          candidate = candidate.lexically_normal();
+        }
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(candidate, ec)) {
+          std::string dependency = candidate.string();
+          if (dependency != filepath && std::find(resolved.begin(), resolved.end(), dependency) == resolved.end()) {
+            resolved.push_back(dependency);
+          }
+          break;
+        }
+      }
+    }
+    return resolved;
+  }
+}
+
+void CesiumDocExtractor::setParallelism(size_t jobs) {
+  parallelism_ = jobs;
+  parallelism_overridden_ = true;
+}
 
 bool CesiumDocExtractor::initialize(const std::string& config_path) {
-  auto config = JsonDoc::fromFile(config_path);
-  if (!config) {
+  owned_config_ = CesiumDoc::loadConfig(config_path);
+  if (!owned_config_) {
     std::cerr << "Failed to load configuration from: " << config_path << std::endl;
     return false;
   }
+  return initialize(*owned_config_);
+}
+
+bool CesiumDocExtractor::initialize(const CesiumDoc::Config& config) {
+  config_ = &config;
 
   // Initialize cache
-  const JsonDoc& config_ref = *config;
+  const JsonDoc& config_ref = config.json;
   
   // Configure logging if specified in config
-  JsonValue logging_config = config_ref["logging"];
-  if (!logging_config.isNull()) {
-    CLILogger::configureFromFile(config_path);
-  }
+  CLILogger::configureFromDoc(config_ref);
   
-  std::string extract_dir = static_cast<std::string>(config_ref["extract_directory"]);
+  const std::string& extract_dir = config.extract_directory;
   
   // Normalize path to avoid double slashes
   std::filesystem::path cache_path = std::filesystem::path(extract_dir) / ".cesium-cache.json";
   std::string cache_file = cache_path.string();
   
   cache_ = std::make_unique<DocumentationCache>(cache_file);
+  cache_->applyConfig(config_ref);
   cache_->load();
 
-  // Load language parsers
+  // Worker count for extraction (--jobs on the command line takes precedence)
+  JsonValue parallelism = config_ref["parallelism"];
+  if (!parallelism_overridden_ && parallelism.isInt() && parallelism.asInt() >= 0) {
+    parallelism_ = static_cast<size_t>(parallelism.asInt());
+  }
+
+  // Keep parse trees between runs of this extractor so changed files reparse incrementally
+  JsonValue incremental = config_ref["incremental_parsing"];
+  incremental_parsing_ = incremental.isBool() && incremental.asBool();
+
+  // Fused extraction attaches docstrings from comment nodes during the AST walk
+  JsonValue fused = config_ref["fused_extraction"];
+  if (fused.isBool()) {
+    fused_extraction_ = fused.asBool();
+  }
+
+  // Languages with a "query" file can be extracted from it instead of the built-in C++ walk
+  JsonValue query_extraction = config_ref["query_extraction"];
+  if (query_extraction.isBool()) {
+    query_extraction_ = query_extraction.asBool();
+  }
+
+  // Streaming extraction bounds memory by writing snippets batch by batch (see extractTasks)
+  JsonValue streaming = config_ref["streaming_extraction"];
+  if (streaming.isBool()) {
+    streaming_extraction_ = streaming.asBool();
+  }
+
+  // "search_index" builds a full-text index from the extracted constructs (see writeSearchIndex)
+  JsonValue search_index = config_ref["search_index"];
+  if (search_index.isBool()) {
+    search_index_ = search_index.asBool();
+  }
+  JsonValue search_shards = config_ref["search_index_shards"];
+  if (search_shards.isInt() && search_shards.asInt() > 0) {
+    search_shards_ = static_cast<uint32_t>(search_shards.asInt());
+  }
+
+  // "parse_timeout_ms" (0 = no limit) skips files whose parse runs longer, e.g. huge generated sources
+  JsonValue parse_timeout = config_ref["parse_timeout_ms"];
+  if (parse_timeout.isInt() && parse_timeout.asInt() >= 0) {
+    parse_timeout_ms_ = static_cast<uint64_t>(parse_timeout.asInt());
+  }
+
+  // "shared_cache" names a directory of extraction results keyed by content, shared between machines
+  JsonValue shared_cache = config_ref["shared_cache"];
+  if (shared_cache.isString() && !shared_cache.asString().empty()) {
+    shared_cache_ = std::make_unique<SharedExtractionCache>(shared_cache.asString());
+    JsonValue read_only = config_ref["shared_cache_read_only"];
+    shared_cache_->setReadOnly(read_only.isBool() && read_only.asBool());
+  } else {
+    shared_cache_.reset();
+  }
+
+  // Sources over "max_file_size_kb" (0 = no limit) are skipped, as are binary and, optionally, generated files
+  JsonValue max_file_size = config_ref["max_file_size_kb"];
+  if (max_file_size.isInt() && max_file_size.asInt() >= 0) {
+    source_limits_.max_file_size = static_cast<uint64_t>(max_file_size.asInt()) * 1024;
+  }
+  JsonValue skip_binary = config_ref["skip_binary"];
+  if (skip_binary.isBool()) {
+    source_limits_.skip_binary = skip_binary.asBool();
+  }
+  JsonValue skip_generated = config_ref["skip_generated"];
+  if (skip_generated.isBool()) {
+    source_limits_.skip_generated = skip_generated.asBool();
+  }
+
+  // "exclude_patterns" prune matching directories from the walk and skip matching files
+  JsonValue exclude_patterns = config_ref["exclude_patterns"];
+  if (exclude_patterns.isArray()) {
+    exclude_patterns_ = GlobMatcher();
+    size_t compiled = exclude_patterns_.add(exclude_patterns.asStringArray());
+    LOG_DEBUG("CesiumDocExtractor::initialize: Compiled " + std::to_string(compiled) + " exclude patterns");
+  }
+
+  // Standalone comment scanner: "linear" (default) or the legacy "regex" fallback
+  JsonValue scanner = config_ref["docstring_scanner"];
+  if (scanner.isString()) {
+    std::string scanner_name = scanner.asString();
+    if (!DocstringParser::parseScannerName(scanner_name, docstring_scanner_)) {
+      CLILogger::warning("Unknown docstring_scanner '" + scanner_name + "', using linear scanner");
+    }
+  }
+  docstring_parser_.setScanner(docstring_scanner_);
+
+  // "files" (default) writes one page per construct; "archive" packs them into one indexed file
+  // (an unknown name was already reported by the cache)
+  JsonValue output_mode = config_ref["output_mode"];
+  if (output_mode.isString()) {
+    parseOutputMode(output_mode.asString(), output_mode_);
+  }
+  markdown_generator_.setOutputMode(output_mode_);
+
+  // Register language parsers; each grammar is loaded when the first file needing it is seen
   JsonValue languages = config_ref["languages"];
   
-  languages.forEachObject([&](const std::string& lang_name, JsonValue lang_config) {
-    if (loader_.loadLanguage(lang_name, lang_config, config_path)) {
-      std::cout << "Loaded " << lang_name << " parser" << std::endl;
+  for (auto [lang_key, lang_config] : languages.members()) {
+    std::string lang_name(lang_key);
+    if (loader_.registerLanguage(lang_name, lang_config, config.path)) {
+      LOG_DEBUG("CesiumDocExtractor::initialize: Registered " + lang_name + " parser");
     } else {
-      std::cerr << "Warning: Failed to load " << lang_name << " parser" << std::endl;
+      std::cerr << "Warning: Invalid configuration for " << lang_name << " parser" << std::endl;
     }
-  });
+  }
 
   return true;
 }
 
-bool CesiumDocExtractor::extract(const std::string& config_path,
-                                  const std::string& source_override,
+bool CesiumDocExtractor::extract(const std::string& source_override,
                                   const std::string& extract_dir_override) {
-  auto config = JsonDoc::fromFile(config_path);
-  if (!config) return false;
+  if (!config_) return false;
 
-  const JsonDoc& config_ref = *config;
-  std::vector<CodeConstruct> all_constructs;
+  // Constructs from the previous run are gone, so their interned strings can go too
+  strings_.clear();
+  std::vector<ExtractionTask> tasks;   // Files to extract, in discovery order
 
   // Determine extract directory
-  std::string extract_dir = extract_dir_override.empty() ? 
-    static_cast<std::string>(config_ref["extract_directory"]) : extract_dir_override;
+  std::string extract_dir = extract_dir_override.empty() ? config_->extract_directory : extract_dir_override;
   
   // Create extract directory if it doesn't exist
-  CLILogger::debug("CesiumDocExtractor::extract: Creating extract directory: " + extract_dir);
+  LOG_DEBUG("CesiumDocExtractor::extract: Creating extract directory: " + extract_dir);
   try {
     bool created = std::filesystem::create_directories(extract_dir);
     if (created) {
-      CLILogger::debug("CesiumDocExtractor::extract: Successfully created extract directory: " + extract_dir);
+      LOG_DEBUG("CesiumDocExtractor::extract: Successfully created extract directory: " + extract_dir);
     } else {
-      CLILogger::debug("CesiumDocExtractor::extract: Extract directory already exists: " + extract_dir);
+      LOG_DEBUG("CesiumDocExtractor::extract: Extract directory already exists: " + extract_dir);
     }
   } catch (const std::filesystem::filesystem_error& e) {
     CLILogger::error("CesiumDocExtractor::extract: Failed to create extract directory '" + extract_dir + "': " + e.what());
     return false;
   }
 
+  // Walk the source trees and the extract directory once; until outputs are
+  // written, the cache answers existence and stat queries from this snapshot
+  std::vector<ScanRoot> scan_roots;
+  std::vector<std::string> source_roots = source_override.empty() ? config_->source_directories
+                                                                  : std::vector<std::string>{source_override};
+  for (const auto& root : source_roots) {
+    scan_roots.push_back({root, true, &exclude_patterns_});
+  }
+  scan_roots.push_back({extract_dir, false, nullptr});
+  size_t extract_root = scan_roots.size() - 1;
+
+  FsScanner scanner;
+  scanner.setParallelism(parallelism_);
+  profile::ScopedTimer scan_timer("scan");
+  FsSnapshot snapshot = scanner.scan(scan_roots);
+  scan_timer.stop();
+  size_t excluded_paths = 0;
+  for (size_t i = 0; i < extract_root; ++i) {
+    for (const auto& path : snapshot.excluded(i)) {
+      LOG_DEBUGLOW("CesiumDocExtractor::extract: Skipping " + path + " (matches exclude_patterns)");
+    }
+    excluded_paths += snapshot.excluded(i).size();
+  }
+  LOG_DEBUG("CesiumDocExtractor::extract: Scanned " + std::to_string(scan_roots.size()) + " roots, " +
+                   std::to_string(excluded_paths) + " paths excluded");
+  cache_->setSnapshot(&snapshot);
+  cache_->setJobs(parallelism_);
+
   // Verify cache integrity at start and prune orphaned files
+  profile::ScopedTimer integrity_timer("verify_cache");
   if (cache_ && !cache_->verifyIntegrity(extract_dir)) {
     std::cout << "Cache integrity issues detected - pruning orphaned files" << std::endl;
     size_t pruned = cache_->pruneOrphanedFiles(extract_dir, false);
     if (pruned > 0) {
       std::cout << "Removed " << pruned << " orphaned files" << std::endl;
+      scanner.rescan(snapshot, extract_root);
     }
+  } else if (cache_) {
+    cache_->recordIntegrity(extract_dir);
   }
 
+  integrity_timer.stop();
+
+  // Search documents are only added for pages rendered in a run, so a missing table needs every
+  // file extracted once; the cache itself stays, so outputs of deleted sources are still pruned
+  bool extract_all = search_index_ && !std::filesystem::exists(searchDocumentsPath(extract_dir));
+  if (extract_all) {
+    LOG_DEBUG("CesiumDocExtractor::extract: No search documents in " + extract_dir + ", extracting every file");
+  }
+
+  // Check each file (and each shared dependency) at most once while discovering work
+  profile::ScopedTimer discover_timer("discover");
+  cache_->beginChangeScan();
+
   // Determine source directories/files to process
   if (!source_override.empty()) {
     // Process specific source override
     std::cout << "Processing source override: " << source_override << std::endl;
     
     // Check if the source override path exists
-    CLILogger::debug("CesiumDocExtractor::extract: Checking if source override exists: " + source_override);
+    LOG_DEBUG("CesiumDocExtractor::extract: Checking if source override exists: " + source_override);
     if (!std::filesystem::exists(source_override)) {
       CLILogger::error("CesiumDocExtractor::extract: Source override path does not exist: " + source_override);
       CLILogger::stderr_msg("Please check the path and try again.");
+      cache_->endChangeScan();
+      cache_->setSnapshot(nullptr);
       return false;
     }
-    CLILogger::debug("CesiumDocExtractor::extract: Source override path exists: " + source_override);
+    LOG_DEBUG("CesiumDocExtractor::extract: Source override path exists: " + source_override);
     
     if (std::filesystem::is_directory(source_override)) {
-      CLILogger::debug("CesiumDocExtractor::extract: Source override is directory, starting recursive iteration: " + source_override);
-      try {
-        for (const auto& entry : std::filesystem::recursive_directory_iterator(source_override)) {
-        if (entry.is_regular_file()) {
-            std::string filepath = entry.path().string();
-            CLILogger::debuglow("CesiumDocExtractor::extract: Found file in source override: " + filepath);
-            if (needsExtraction(filepath, extract_dir)) {
-              auto [lang_name, lang_info] = loader_.getLanguageForFile(filepath);
-              if (lang_info) {
-                std::cout << "Extracting " << filepath << " as " << lang_name << std::endl;
-                CLILogger::debug("CesiumDocExtractor::extract: Extracting constructs from file: " + filepath);
-                auto constructs = extractAllConstructs(filepath, *lang_info);
-                all_constructs.insert(all_constructs.end(), constructs.begin(), constructs.end());
-                CLILogger::debuglow("CesiumDocExtractor::extract: Added " + std::to_string(constructs.size()) + " constructs from " + filepath);
-              } else {
-                CLILogger::debuglow("CesiumDocExtractor::extract: No language parser found for file: " + filepath);
-              }
+      LOG_DEBUG("CesiumDocExtractor::extract: Source override is directory, listing scanned entries: " + source_override);
+      if (snapshot.rootStatus(0) != FsSnapshot::RootStatus::Scanned) {
+        CLILogger::error("CesiumDocExtractor::extract: Error iterating source override directory '" + source_override + "'");
+        cache_->endChangeScan();
+        cache_->setSnapshot(nullptr);
+        return false;
+      }
+      for (const auto& entry : snapshot.entries(0)) {
+        if (entry.type == FsEntryType::File) {
+          const std::string& filepath = entry.path;
+          LOG_DEBUGLOW("CesiumDocExtractor::extract: Found file in source override: " + filepath);
+          if (extract_all || needsExtraction(filepath, extract_dir)) {
+            auto [lang_name, lang_info] = loader_.getLanguageForFile(filepath);
+            if (lang_info) {
+              std::cout << "Extracting " << filepath << " as " << lang_name << std::endl;
+              tasks.push_back({filepath, lang_name, lang_info, entry.size});
             } else {
-              CLILogger::debuglow("CesiumDocExtractor::extract: File does not need extraction (up to date): " + filepath);
+              LOG_DEBUGLOW("CesiumDocExtractor::extract: No language parser found for file: " + filepath);
             }
+          } else {
+            LOG_DEBUGLOW("CesiumDocExtractor::extract: File does not need extraction (up to date): " + filepath);
           }
         }
-      } catch (const std::filesystem::filesystem_error& e) {
-        CLILogger::error("CesiumDocExtractor::extract: Error iterating source override directory '" + source_override + "': " + e.what());
-        return false;
       }
-      CLILogger::debug("CesiumDocExtractor::extract: Completed recursive iteration of source override directory");
+      LOG_DEBUG("CesiumDocExtractor::extract: Completed listing of source override directory");
     } else if (std::filesystem::is_regular_file(source_override)) {
-      CLILogger::debug("CesiumDocExtractor::extract: Source override is regular file: " + source_override);
-      if (cache_->needsExtraction(source_override)) {
+      LOG_DEBUG("CesiumDocExtractor::extract: Source override is regular file: " + source_override);
+      if (extract_all || cache_->needsExtraction(source_override)) {
         auto [lang_name, lang_info] = loader_.getLanguageForFile(source_override);
         if (lang_info) {
           std::cout << "Extracting " << source_override << " as " << lang_name << std::endl;
-          auto constructs = extractAllConstructs(source_override, *lang_info);
-          all_constructs.insert(all_constructs.end(), constructs.begin(), constructs.end());
-          
-          // Update cache with extracted files (placeholder - will be enhanced)
-          std::vector<std::string> generated_files; // TODO: Get actual generated files
-          cache_->updateFile(source_override, generated_files, constructs.size(), lang_name);
-          
-          // Save cache immediately for crash resilience
-          cache_->saveImmediately();
+          std::error_code ec;
+          uint64_t size = std::filesystem::file_size(source_override, ec);
+          tasks.push_back({source_override, lang_name, lang_info, ec ? 0 : size});
         }
       }
     } else {
       CLILogger::error("Source override path is neither a file nor directory: " + source_override);
       CLILogger::stderr_msg("Please specify a valid file or directory path.");
+      cache_->endChangeScan();
+      cache_->setSnapshot(nullptr);
       return false;
     }
   } else {
-    // Process configured source directories
-    JsonValue source_dirs_value = config_ref["source_directories"];
-    
-    source_dirs_value.forEachArray([&](size_t idx, JsonValue dir_value) {
-      std::string dir_str = static_cast<std::string>(dir_value);
+    // Process configured source directories (scan root idx is source_roots[idx])
+    for (size_t idx = 0; idx < source_roots.size(); ++idx) {
+      const std::string& dir_str = source_roots[idx];
       std::cout << "Processing directory: " << dir_str << std::endl;
 
       // Check if directory exists before trying to iterate
-      if (!std::filesystem::exists(dir_str)) {
+      if (snapshot.rootStatus(idx) == FsSnapshot::RootStatus::Missing) {
         CLILogger::error("Source directory does not exist: " + dir_str);
         CLILogger::stderr_msg("Please check your configuration file and update source_directories to point to valid paths.");
-        CLILogger::debug("Skipping non-existent directory: " + dir_str);
-        return; // Skip this directory and continue with others
+        LOG_DEBUG("Skipping non-existent directory: " + dir_str);
+        continue; // Skip this directory and continue with others
       }
       
-      if (!std::filesystem::is_directory(dir_str)) {
+      const auto& entries = snapshot.entries(idx);
+      if (entries.size() == 1 && entries.front().depth == 0) {
         CLILogger::error("Source path is not a directory: " + dir_str);
         CLILogger::stderr_msg("Please check your configuration file - source_directories should contain directory paths only.");
-        CLILogger::debug("Skipping non-directory path: " + dir_str);
-        return; // Skip this entry and continue with others
+        LOG_DEBUG("Skipping non-directory path: " + dir_str);
+        continue; // Skip this entry and continue with others
       }
 
-      CLILogger::debug("CesiumDocExtractor::extract: Starting recursive iteration of configured directory: " + dir_str);
-      try {
-        for (const auto& entry : std::filesystem::recursive_directory_iterator(dir_str)) {
-        if (entry.is_regular_file()) {
-            std::string filepath = entry.path().string();
-            CLILogger::debuglow("CesiumDocExtractor::extract: Found file in configured directory: " + filepath);
-            if (cache_->needsExtraction(filepath)) {
-              auto [lang_name, lang_info] = loader_.getLanguageForFile(filepath);
-              if (lang_info) {
-                std::cout << "Extracting " << filepath << " as " << lang_name << std::endl;
-                CLILogger::debug("CesiumDocExtractor::extract: Extracting constructs from file: " + filepath);
-                auto constructs = extractAllConstructs(filepath, *lang_info);
-                all_constructs.insert(all_constructs.end(), constructs.begin(), constructs.end());
-                CLILogger::debuglow("CesiumDocExtractor::extract: Added " + std::to_string(constructs.size()) + " constructs from " + filepath);
-              } else {
-                CLILogger::debuglow("CesiumDocExtractor::extract: No language parser found for file: " + filepath);
-              }
+      LOG_DEBUG("CesiumDocExtractor::extract: Listing scanned entries of configured directory: " + dir_str);
+      if (snapshot.rootStatus(idx) != FsSnapshot::RootStatus::Scanned) {
+        CLILogger::error("CesiumDocExtractor::extract: Error iterating configured directory '" + dir_str + "'");
+        CLILogger::stderr_msg("Failed to process directory. Please check permissions and path validity.");
+        continue; // Skip this directory and continue with others
+      }
+      for (const auto& entry : entries) {
+        if (entry.type == FsEntryType::File) {
+          const std::string& filepath = entry.path;
+          LOG_DEBUGLOW("CesiumDocExtractor::extract: Found file in configured directory: " + filepath);
+          if (extract_all || cache_->needsExtraction(filepath)) {
+            auto [lang_name, lang_info] = loader_.getLanguageForFile(filepath);
+            if (lang_info) {
+              std::cout << "Extracting " << filepath << " as " << lang_name << std::endl;
+              tasks.push_back({filepath, lang_name, lang_info, entry.size});
             } else {
-              CLILogger::debuglow("CesiumDocExtractor::extract: File does not need extraction (cached): " + filepath);
+              LOG_DEBUGLOW("CesiumDocExtractor::extract: No language parser found for file: " + filepath);
             }
+          } else {
+            LOG_DEBUGLOW("CesiumDocExtractor::extract: File does not need extraction (cached): " + filepath);
           }
         }
-      } catch (const std::filesystem::filesystem_error& e) {
-        CLILogger::error("CesiumDocExtractor::extract: Error iterating configured directory '" + dir_str + "': " + e.what());
-        CLILogger::stderr_msg("Failed to process directory. Please check permissions and path validity.");
-        return; // Skip this directory and continue with others
       }
-      CLILogger::debug("CesiumDocExtractor::extract: Completed recursive iteration of directory: " + dir_str);
-    });
+      LOG_DEBUG("CesiumDocExtractor::extract: Completed listing of directory: " + dir_str);
+    }
   }
 
-  // Generate markdown snippets to extract directory
-  std::cout << "Creating " << all_constructs.size() << " markdown snippets in " << extract_dir << std::endl;
-  auto generated_files = markdown_generator_.generateMarkdownFromConstructs(all_constructs, extract_dir);
-  
-  // Now update cache with the actual generated files
-  // Group generated files by source file (for now, assume all come from the last processed file)
-  // TODO: This is a simplification - we need better tracking of which constructs came from which files
-  if (cache_ && !all_constructs.empty()) {
-    // For now, associate all generated files with the source file of the first construct
-    std::string source_file = all_constructs[0].filename;
-    auto [lang_name, lang_info] = loader_.getLanguageForFile(source_file);
-    if (lang_info) {
-      cache_->updateFile(source_file, generated_files, all_constructs.size(), lang_name);
-      
-      // Save cache immediately for crash resilience
-      cache_->saveImmediately();
+  // Extract queued files in parallel, then merge per-file results in discovery
+  // order so the generated output does not depend on worker scheduling
+  cache_->endChangeScan();
+  cache_->setSnapshot(nullptr);
+  discover_timer.stop();
+  return extractTasks(tasks, config_->source_directories, extract_dir);
+}
+
+bool CesiumDocExtractor::exportConstructs(const std::string& source_override, ConstructStreamWriter& writer) {
+  if (!config_) return false;
+
+  strings_.clear();
+  std::vector<std::string> source_roots = source_override.empty() ? config_->source_directories
+                                                                  : std::vector<std::string>{source_override};
+  std::vector<ScanRoot> scan_roots;
+  for (const auto& root : source_roots) {
+    scan_roots.push_back({root, true, &exclude_patterns_});
+  }
+
+  FsScanner scanner;
+  scanner.setParallelism(parallelism_);
+  profile::ScopedTimer scan_timer("scan");
+  FsSnapshot snapshot = scanner.scan(scan_roots);
+  scan_timer.stop();
+
+  std::vector<ExtractionTask> tasks;
+  for (size_t idx = 0; idx < source_roots.size(); ++idx) {
+    if (snapshot.rootStatus(idx) != FsSnapshot::RootStatus::Scanned) {
+      CLILogger::error("Cannot read source path: " + source_roots[idx]);
+      if (!source_override.empty()) {
+        return false;
+      }
+      continue;
+    }
+    for (const auto& entry : snapshot.entries(idx)) {
+      if (entry.type != FsEntryType::File) continue;
+      auto [lang_name, lang_info] = loader_.getLanguageForFile(entry.path);
+      if (lang_info) {
+        tasks.push_back({entry.path, lang_name, lang_info, entry.size});
+      } else {
+        LOG_DEBUGLOW("CesiumDocExtractor::exportConstructs: No language parser found for file: " + entry.path);
+      }
+    }
+  }
+
+  // Batches of a few files per worker keep every worker busy while bounding the constructs held at once
+  size_t batch_size = parallel::resolveJobCount(parallelism_, tasks.size()) * 4;
+  LOG_DEBUG("CesiumDocExtractor::exportConstructs: Exporting " + std::to_string(tasks.size()) + " files in batches of " + std::to_string(batch_size));
+  profile::ScopedTimer export_timer("export_constructs");
+  for (size_t begin = 0; begin < tasks.size(); begin += batch_size) {
+    std::vector<ExtractionTask> batch(tasks.begin() + begin,
+                                      tasks.begin() + std::min(tasks.size(), begin + batch_size));
+    auto results = runExtractionTasks(batch);
+    for (const auto& result : results) {
+      for (const auto& construct : result.constructs) {
+        writer.write(construct);
+      }
+    }
+    writer.flush();
+    // The batch's constructs are gone, so their interned strings can go too
+    results.clear();
+    strings_.clear();
+  }
+  export_timer.stop();
+  profile::count("files_extracted", tasks.size());
+  profile::count("constructs", writer.count());
+  return true;
+}
+
+bool CesiumDocExtractor::extractTasks(const std::vector<ExtractionTask>& tasks,
+                                      const std::vector<std::string>& include_roots,
+                                      const std::string& extract_dir) {
+  std::vector<std::vector<std::string>> dependencies(tasks.size());
+  std::vector<size_t> construct_counts(tasks.size());
+  GeneratedFileMap generated_files;
+  std::unordered_map<std::string, std::string> output_hashes;
+  size_t skipped_files = 0;
+  size_t total_constructs = 0;
+  size_t merge_conflicts = 0;
+  size_t pages_written = 0, pages_unchanged = 0, pages_failed = 0, bytes_written = 0;
+
+  // Normally every file is one batch, so the cross-file merge sees all constructs at once. Streaming
+  // extraction writes a few files per worker at a time and spills what it wrote, so a later file
+  // declaring or defining the same construct is merged with the spilled construct instead
+  size_t batch_size = tasks.size();
+  std::optional<ConstructSpill> spill;
+  if (streaming_extraction_ && !tasks.empty()) {
+    batch_size = parallel::resolveJobCount(parallelism_, tasks.size()) * 4;
+    spill.emplace((std::filesystem::path(extract_dir) / ".cesium-spill.ndjson").string());
+    if (!spill->isOpen()) {
+      CLILogger::error("Cannot create spill file in " + extract_dir);
+      return false;
+    }
+    std::cout << "Streaming " << tasks.size() << " files in batches of " << batch_size << std::endl;
+  }
+
+  size_t shared_hits = shared_cache_ ? shared_cache_->hits() : 0;
+  size_t shared_misses = shared_cache_ ? shared_cache_->misses() : 0;
+  if (cache_) {
+    markdown_generator_.setRecordedOutputHashes(cache_->recordedOutputHashes());
+  }
+  markdown_generator_.setWriteJobs(parallelism_);
+
+  // Pages rendered below replace their search documents; the others keep the ones loaded here
+  std::optional<SearchIndex> search;
+  if (search_index_) {
+    search.emplace();
+    search->load(searchDocumentsPath(extract_dir));
+    markdown_generator_.setSearchIndex(&*search);
+  }
+
+  size_t begin = 0;
+  do {
+    size_t end = std::min(tasks.size(), begin + batch_size);
+    std::vector<ExtractionTask> batch_tasks;
+    const std::vector<ExtractionTask>* batch = &tasks;
+    if (spill) {
+      batch_tasks.assign(tasks.begin() + begin, tasks.begin() + end);
+      batch = &batch_tasks;
+    }
+
+    profile::ScopedTimer extract_timer("extract_files");
+    auto results = runExtractionTasks(*batch);
+    extract_timer.stop();
+
+    // Constructs already written by an earlier batch come first, as they would in one merge
+    std::vector<CodeConstruct> constructs;
+    if (spill) {
+      std::unordered_set<std::string> reloaded;
+      for (const auto& result : results) {
+        for (const auto& construct : result.constructs) {
+          std::string signature = overloadSignature(construct);
+          if (spill->contains(signature) && reloaded.insert(signature).second) {
+            if (auto earlier = spill->load(signature, strings_)) {
+              constructs.push_back(std::move(*earlier));
+            }
+          }
+        }
+      }
+    }
+
+    for (size_t i = 0; i < results.size(); ++i) {
+      size_t task = begin + i;
+      if (results[i].status != SourceStatus::Loaded) {
+        skipped_files++;
+      }
+      auto& file_constructs = results[i].constructs;
+      construct_counts[task] = file_constructs.size();
+      total_constructs += file_constructs.size();
+      dependencies[task] = resolveIncludes(tasks[task].filepath, results[i].includes, include_roots);
+      LOG_DEBUGLOW("CesiumDocExtractor::extractTasks: Added " + std::to_string(file_constructs.size()) + " constructs from " + tasks[task].filepath);
+      constructs.insert(constructs.end(),
+                        std::make_move_iterator(file_constructs.begin()),
+                        std::make_move_iterator(file_constructs.end()));
+    }
+    results.clear();
+
+    // Declarations and definitions usually live in different files, so merge once more across all of them
+    size_t constructs_before_merge = constructs.size();
+    profile::ScopedTimer merge_timer("merge");
+    merge_conflicts += ASTExtractor::mergeDuplicateConstructs(constructs, strings_);
+    merge_timer.stop();
+    LOG_DEBUG("CesiumDocExtractor::extractTasks: Cross-file merge folded " + std::to_string(constructs_before_merge - constructs.size()) + " constructs");
+
+    LOG_DEBUG("CesiumDocExtractor::extractTasks: Interned " + std::to_string(strings_.size()) + " distinct strings (" + std::to_string(strings_.bytesStored()) + " bytes) for " + std::to_string(constructs.size()) + " constructs");
+
+    // Generate markdown snippets to extract directory
+    if (!spill) {
+      std::cout << "Creating " << constructs.size() << " markdown snippets in " << extract_dir << std::endl;
+    }
+    profile::ScopedTimer write_timer("write_snippets");
+    GeneratedFileMap batch_files = markdown_generator_.generateMarkdownFromConstructs(constructs, extract_dir);
+    write_timer.stop();
+    pages_written += markdown_generator_.writtenCount();
+    pages_unchanged += markdown_generator_.unchangedCount();
+    pages_failed += markdown_generator_.failedCount();
+    bytes_written += markdown_generator_.bytesWritten();
+    for (const auto& [output, hash] : markdown_generator_.outputHashes()) {
+      output_hashes[output] = hash;
+    }
+
+    if (!spill) {
+      generated_files = std::move(batch_files);
+      break;
+    }
+    for (auto& [source_file, outputs] : batch_files) {
+      auto& recorded = generated_files[source_file];
+      for (auto& output : outputs) {
+        if (std::find(recorded.begin(), recorded.end(), output) == recorded.end()) {
+          recorded.push_back(std::move(output));
+        }
+      }
+    }
+    for (const auto& construct : constructs) {
+      spill->store(construct);
+    }
+    // Only the spill refers to this batch now, so its interned strings can go
+    constructs.clear();
+    strings_.clear();
+  } while ((begin += batch_size) < tasks.size());
+  markdown_generator_.setSearchIndex(nullptr);
+
+  profile::count("files_extracted", tasks.size());
+  if (shared_cache_ && !tasks.empty()) {
+    shared_hits = shared_cache_->hits() - shared_hits;
+    shared_misses = shared_cache_->misses() - shared_misses;
+    profile::count("shared_cache_hits", shared_hits);
+    std::cout << "Shared cache " << shared_cache_->directory() << ": " << shared_hits << " hits, "
+              << shared_misses << " misses" << std::endl;
+  }
+  profile::count("files_skipped", skipped_files);
+  profile::count("constructs", total_constructs);
+  if (skipped_files > 0) {
+    std::cout << "Skipped " << skipped_files << " files (over max_file_size_kb or parse_timeout_ms, binary or generated)" << std::endl;
+  }
+  if (merge_conflicts > 0) {
+    CLILogger::warning("Found " + std::to_string(merge_conflicts) + " docstring conflicts while merging across files");
+  }
+
+  profile::count("snippets_written", pages_written);
+  profile::count("snippets_unchanged", pages_unchanged);
+  std::cout << "Wrote " << pages_written << " snippets (" << (bytes_written + 1023) / 1024 << " KiB), "
+            << pages_unchanged << " unchanged";
+  if (pages_failed > 0) {
+    std::cout << ", " << pages_failed << " failed";
+  }
+  std::cout << std::endl;
+
+  // Record each extracted file with exactly the outputs its constructs produced;
+  // files without constructs are recorded too so they are not re-extracted next run
+  if (cache_) {
+    profile::ScopedTimer cache_timer("cache_update");
+    // Sources writing the same output were merged into it, so each depends on the others
+    std::map<std::string, std::vector<std::string>> output_sources;
+    for (const auto& [source_file, outputs] : generated_files) {
+      for (const auto& output : outputs) {
+        output_sources[output].push_back(source_file);
+      }
+    }
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      auto outputs = generated_files.find(tasks[i].filepath);
+      std::vector<std::string> source_outputs;
+      if (outputs != generated_files.end()) {
+        source_outputs = outputs->second;
+      }
+
+      auto& source_dependencies = dependencies[i];
+      for (const auto& output : source_outputs) {
+        for (const auto& partner : output_sources[output]) {
+          if (partner != tasks[i].filepath &&
+              std::find(source_dependencies.begin(), source_dependencies.end(), partner) == source_dependencies.end()) {
+            source_dependencies.push_back(partner);
+          }
+        }
+      }
+
+      std::vector<std::string> source_hashes;
+      source_hashes.reserve(source_outputs.size());
+      for (const auto& output : source_outputs) {
+        auto output_hash = output_hashes.find(output);
+        source_hashes.push_back(output_hash != output_hashes.end() ? output_hash->second : "");
+      }
+
+      cache_->updateFile(tasks[i].filepath, source_outputs, construct_counts[i], tasks[i].language,
+                         source_dependencies, source_hashes);
+    }
+
+    cache_timer.stop();
+
+    // Save cache immediately for crash resilience
+    profile::ScopedTimer save_timer("cache_save");
+    cache_->saveImmediately();
+  }
+
+  // Documents of pages no longer recorded (removed or merged away) are dropped
+  if (search) {
+    std::unordered_set<std::string> pages;
+    for (const auto& [output, hash] : cache_->recordedOutputHashes()) {
+      pages.insert(std::filesystem::path(output).filename().string());
+    }
+    search->retainPages(pages);
+    std::string search_path = searchDocumentsPath(extract_dir);
+    if (search->changed() && !search->save(search_path)) {
+      CLILogger::warning("Failed to write search documents to " + search_path);
     }
   }
   
   // Save cache after successful extraction
   if (cache_) {
+    profile::ScopedTimer save_timer("cache_save");
     cache_->save();
     auto [file_count, generated_count] = cache_->getStats();
     std::cout << "Cache updated: " << file_count << " files tracked, " 
@@ -231,158 +685,359 @@ bool CesiumDocExtractor::extract(const std::string& config_path,
   return true;
 }
 
-bool CesiumDocExtractor::generate(const std::string& config_path) {
-  auto config = JsonDoc::fromFile(config_path);
-  if (!config) return false;
-
-  const JsonDoc& config_ref = *config;
-  std::string extract_dir = static_cast<std::string>(config_ref["extract_directory"]);
-  std::string output_dir = static_cast<std::string>(config_ref["output_directory"]);
+bool CesiumDocExtractor::generate() {
+  if (!config_) return false;
 
-  // First, run extract to ensure all changed files are processed
-  if (!extract(config_path)) {
+  // First, run extract to ensure all changed files are processed; the pages it
+  // writes are kept so the generation stage does not read them back from disk
+  // (except when streaming, where holding every page would defeat the point)
+  markdown_generator_.setRetainPages(!streaming_extraction_);
+  bool extracted = extract();
+  markdown_generator_.setRetainPages(false);
+  if (!extracted) {
     std::cerr << "Failed to extract documentation snippets" << std::endl;
     return false;
   }
 
   // Then process the markdown snippets into structured documentation
-  std::cout << "Generating structured documentation from snippets in " << extract_dir << std::endl;
-  processMarkdownSnippets(extract_dir, output_dir);
-  
+  std::cout << "Generating structured documentation from snippets in " << config_->extract_directory << std::endl;
+  processMarkdownSnippets(config_->extract_directory, config_->output_directory, &markdown_generator_.renderedPages());
+  if (search_index_) {
+    writeSearchIndex(config_->extract_directory, config_->output_directory);
+  }
+
   return true;
 }
 
+bool CesiumDocExtractor::generateFromSnippets(const std::string& extract_dir_override) {
+  if (!config_) return false;
+
+  std::string extract_dir = extract_dir_override.empty() ? config_->extract_directory : extract_dir_override;
+  processMarkdownSnippets(extract_dir, config_->output_directory);
+  if (search_index_) {
+    writeSearchIndex(extract_dir, config_->output_directory);
+  }
+  return true;
+}
+
+bool CesiumDocExtractor::extractChanged(const std::vector<std::string>& changed,
+                                        const std::string& extract_dir_override) {
+  if (!config_ || !cache_) return false;
+
+  strings_.clear();
+  std::string extract_dir = extract_dir_override.empty() ? config_->extract_directory : extract_dir_override;
+
+  // Without search documents every file has to be extracted once, which is a full run
+  if (search_index_ && !std::filesystem::exists(searchDocumentsPath(extract_dir))) {
+    return extract("", extract_dir_override);
+  }
+
+  // Files that include a changed file, or share an output with it, are redone with it
+  std::vector<std::string> candidates = changed;
+  std::vector<std::string> dependents = cache_->dependentsOf(changed);
+  candidates.insert(candidates.end(), dependents.begin(), dependents.end());
+  LOG_DEBUG("CesiumDocExtractor::extractChanged: " + std::to_string(changed.size()) + " changed paths, " +
+                   std::to_string(dependents.size()) + " dependents");
+
+  // Outputs of deleted sources go first, so a merge partner rewritten below is not pruned with them
+  bool removed_any = std::any_of(changed.begin(), changed.end(), [](const std::string& path) {
+    std::error_code ec;
+    return !std::filesystem::exists(path, ec);
+  });
+  if (removed_any) {
+    size_t pruned = cache_->pruneOrphanedFiles(extract_dir, false);
+    if (pruned > 0) {
+      std::cout << "Removed " << pruned << " orphaned files" << std::endl;
+    }
+  }
+
+  std::vector<ExtractionTask> tasks;
+  cache_->beginChangeScan();
+  for (const auto& filepath : candidates) {
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(filepath, ec) || exclude_patterns_.matchesFile(filepath)) {
+      continue;
+    }
+    auto [lang_name, lang_info] = loader_.getLanguageForFile(filepath);
+    if (!lang_info) {
+      LOG_DEBUGLOW("CesiumDocExtractor::extractChanged: No language parser found for file: " + filepath);
+      continue;
+    }
+    if (cache_->needsExtraction(filepath)) {
+      std::cout << "Extracting " << filepath << " as " << lang_name << std::endl;
+      uint64_t size = std::filesystem::file_size(filepath, ec);
+      tasks.push_back({filepath, lang_name, lang_info, ec ? 0 : size});
+    } else {
+      LOG_DEBUGLOW("CesiumDocExtractor::extractChanged: File does not need extraction (unchanged): " + filepath);
+    }
+  }
+  cache_->endChangeScan();
+
+  if (tasks.empty()) {
+    if (removed_any) {
+      cache_->save();
+    }
+    return true;
+  }
+  return extractTasks(tasks, config_->source_directories, extract_dir);
+}
+
 void CesiumDocExtractor::extractDocs(const std::string& config_path) {
   // Legacy method - just call generate which does extract + generate
-  generate(config_path);
+  if (config_ || initialize(config_path)) {
+    generate();
+  }
 }
 
 std::vector<DocstringBlock> CesiumDocExtractor::extractFromFile(const std::string& filepath,
                                                                 const LanguageInfo& lang_info) {
-  std::ifstream file(filepath);
-  if (!file.is_open()) {
-    std::cerr << "Failed to open file: " << filepath << std::endl;
+  SourceReader reader;
+  reader.setLimits(source_limits_);
+  SourceStatus status = reader.read(filepath);
+  if (status != SourceStatus::Loaded) {
+    if (status == SourceStatus::Unreadable) {
+      std::cerr << "Failed to open file: " << filepath << std::endl;
+    }
     return {};
   }
-
-  std::string content((std::istreambuf_iterator<char>(file)),
-                     std::istreambuf_iterator<char>());
-  file.close();
+  const std::string& content = reader.content();
 
   // Extract docstring comments
   auto docstring_blocks = docstring_parser_.extractDocstrings(content, lang_info.docstring_style);
 
-  // Parse with tree-sitter
-  TSParser* parser = ts_parser_new();
-  ts_parser_set_language(parser, lang_info.language);
-  TSTree* tree = ts_parser_parse_string(parser, nullptr, content.c_str(), content.length());
+  // Parse with a pooled tree-sitter parser
+  ParserLease parser = loader_.acquireParser(lang_info);
+  if (!parser) {
+    return docstring_blocks;
+  }
+  TSTree* tree = ts_parser_parse_string(parser.get(), nullptr, content.c_str(), content.length());
+  if (!tree) {
+    return docstring_blocks;
+  }
 
   // Associate comments with AST nodes
   doc_associator_.associateDocsWithNodes(docstring_blocks, tree, content);
 
   // Cleanup
   ts_tree_delete(tree);
-  ts_parser_delete(parser);
 
   return docstring_blocks;
 }
 
-std::vector<CodeConstruct> CesiumDocExtractor::extractAllConstructs(const std::string& filepath,
-                                                                   const LanguageInfo& lang_info) {
-  CLILogger::debug("extractAllConstructs: Starting extraction for file: " + filepath);
+std::vector<ExtractionResult> CesiumDocExtractor::runExtractionTasks(const std::vector<ExtractionTask>& tasks) {
+  std::vector<ExtractionResult> results(tasks.size());
+  if (tasks.empty()) {
+    return results;
+  }
+
+  size_t jobs = parallel::resolveJobCount(parallelism_, tasks.size());
+  LOG_DEBUG("CesiumDocExtractor::runExtractionTasks: Extracting " + std::to_string(tasks.size()) + " files with " + std::to_string(jobs) + " worker(s)");
+
+  // Largest first: items go to whichever worker is free, so only a large file started last can hold up the run
+  std::vector<size_t> order(tasks.size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return tasks[a].size > tasks[b].size; });
+
+  std::vector<ExtractionWorker> workers(jobs);
+  parallel::forEachIndex(tasks.size(), jobs, [&](size_t worker_index, size_t position) {
+    size_t task_index = order[position];
+    const ExtractionTask& task = tasks[task_index];
+    LOG_DEBUG("CesiumDocExtractor::runExtractionTasks: Extracting constructs from file: " + task.filepath);
+    results[task_index] = extractAllConstructs(task.filepath, *task.lang_info, workers[worker_index]);
+  });
+
+  return results;
+}
+
+ExtractionResult CesiumDocExtractor::extractAllConstructs(const std::string& filepath,
+                                                         const LanguageInfo& lang_info,
+                                                         ExtractionWorker& worker) {
+  LOG_DEBUG("extractAllConstructs: Starting extraction for file: " + filepath);
+  profile::ScopedTimer file_timer("file", filepath);
   
-  std::ifstream file(filepath);
-  if (!file.is_open()) {
+  worker.source_reader.setLimits(source_limits_);
+  profile::ScopedTimer read_timer("read");
+  SourceStatus status = worker.source_reader.read(filepath);
+  read_timer.stop();
+  if (status == SourceStatus::Unreadable) {
     CLILogger::error("extractAllConstructs: Failed to open file: " + filepath);
     std::cerr << "Failed to open file: " << filepath << std::endl;
     return {};
   }
+  if (status != SourceStatus::Loaded) {
+    CLILogger::info("Skipping " + std::string(sourceStatusName(status)) + " file: " + filepath);
+    ExtractionResult skipped;
+    skipped.status = status;
+    return skipped;
+  }
+  const std::string& content = worker.source_reader.content();
+  profile::count("bytes_read", content.size());
+  return extractContent(filepath, content, lang_info, worker, true);
+}
+
+std::optional<ExtractionResult> CesiumDocExtractor::extractBuffer(const std::string& path, const std::string& content) {
+  if (!config_) return std::nullopt;
+
+  auto [lang_name, lang_info] = loader_.getLanguageForFile(path);
+  if (!lang_info) {
+    LOG_DEBUGLOW("CesiumDocExtractor::extractBuffer: No language parser found for file: " + path);
+    return std::nullopt;
+  }
+
+  // The previous buffer's constructs are no longer referenced
+  strings_.clear();
+  SourceStatus status = source_limits_.max_file_size > 0 && content.size() > source_limits_.max_file_size
+    ? SourceStatus::TooLarge
+    : sniffSource(content, source_limits_);
+  if (status != SourceStatus::Loaded) {
+    LOG_DEBUG("CesiumDocExtractor::extractBuffer: Skipping " + std::string(sourceStatusName(status)) + " buffer: " + path);
+    ExtractionResult skipped;
+    skipped.status = status;
+    return skipped;
+  }
+  // Unsaved buffers are transient, so they may reuse shared results but never add to them
+  return extractContent(path, content, *lang_info, buffer_worker_, false);
+}
 
-  std::string content((std::istreambuf_iterator<char>(file)),
-                     std::istreambuf_iterator<char>());
-  file.close();
+ExtractionResult CesiumDocExtractor::extractContent(const std::string& filepath, const std::string& content,
+                                                    const LanguageInfo& lang_info, ExtractionWorker& worker,
+                                                    bool store_shared) {
+  // A file extracted elsewhere with the same content and settings is loaded instead of parsed
+  std::string shared_key;
+  if (shared_cache_) {
+    shared_key = SharedExtractionCache::key(extractionSettings(lang_info), filepath, content);
+    ExtractionResult shared;
+    if (shared_cache_->load(shared_key, strings_, shared.constructs, shared.includes)) {
+      LOG_DEBUG("extractAllConstructs: Loaded " + std::to_string(shared.constructs.size()) + " constructs for " + filepath + " from the shared cache");
+      return shared;
+    }
+  }
   
-  CLILogger::debug("extractAllConstructs: Successfully read file content, size: " + std::to_string(content.length()) + " bytes");
+  LOG_DEBUG("extractAllConstructs: Successfully read file content, size: " + std::to_string(content.length()) + " bytes");
 
-  // Parse with tree-sitter
-  CLILogger::debug("extractAllConstructs: Creating tree-sitter parser for language: " + lang_info.function_name);
-  TSParser* parser = ts_parser_new();
+  // Parse with a pooled tree-sitter parser already configured for this language
+  parser_memory::resetPeak();
+  LOG_DEBUG("extractAllConstructs: Acquiring tree-sitter parser for language: " + lang_info.function_name);
+  ParserLease parser = loader_.acquireParser(lang_info);
   if (!parser) {
     CLILogger::error("extractAllConstructs: Failed to create tree-sitter parser");
     return {};
   }
   
-  CLILogger::debug("extractAllConstructs: Setting tree-sitter language");
-  if (!ts_parser_set_language(parser, lang_info.language)) {
-    CLILogger::error("extractAllConstructs: Failed to set tree-sitter language");
-    ts_parser_delete(parser);
-    return {};
+  LOG_DEBUG("extractAllConstructs: Parsing content with tree-sitter (" + std::to_string(content.length()) + " bytes)");
+  profile::ScopedTimer parse_timer("parse", filepath);
+  auto deadline = parse_timeout_ms_ > 0
+    ? std::chrono::steady_clock::now() + std::chrono::milliseconds(parse_timeout_ms_)
+    : std::chrono::steady_clock::time_point::max();
+  TSTree* tree = incremental_parsing_
+    ? parse_cache_.parse(parser.get(), filepath, lang_info.language, content, deadline)
+    : parseWithDeadline(parser.get(), nullptr, content, deadline);
+  parse_timer.stop();
+  if (!tree && std::chrono::steady_clock::now() >= deadline) {
+    CLILogger::warning("Skipping " + filepath + ": parsing took longer than parse_timeout_ms (" +
+                       std::to_string(parse_timeout_ms_) + " ms)");
+    ExtractionResult timed_out;
+    timed_out.status = SourceStatus::TimedOut;
+    return timed_out;
   }
-  
-  CLILogger::debug("extractAllConstructs: Parsing content with tree-sitter (" + std::to_string(content.length()) + " bytes)");
-  TSTree* tree = ts_parser_parse_string(parser, nullptr, content.c_str(), content.length());
   if (!tree) {
     CLILogger::error("extractAllConstructs: Tree-sitter parsing failed, returned null tree");
-    ts_parser_delete(parser);
     return {};
   }
   
   TSNode root = ts_tree_root_node(tree);
-  CLILogger::debug("extractAllConstructs: Tree-sitter parsing successful, root node type: " + std::string(ts_node_type(root)));
+  LOG_DEBUG("extractAllConstructs: Tree-sitter parsing successful, root node type: " + std::string(ts_node_type(root)));
 
-  // Extract all code constructs from AST
-  CLILogger::debug("extractAllConstructs: Starting AST construct extraction");
-  std::vector<CodeConstruct> constructs = ast_extractor_.extractConstructs(tree, content, filepath);
-  CLILogger::debug("extractAllConstructs: AST extraction completed, found " + std::to_string(constructs.size()) + " constructs");
+  // Extract all code constructs, from the language's query when configured or the built-in AST walk
+  std::vector<CodeConstruct> constructs;
+  std::vector<std::string> includes;
+  bool use_query = query_extraction_ && lang_info.query;
+  profile::ScopedTimer constructs_timer("constructs");
+  if (use_query) {
+    LOG_DEBUG("extractAllConstructs: Starting query-based construct extraction");
+    worker.query_extractor.setStringInterner(&strings_);
+    constructs = worker.query_extractor.extractConstructs(tree, content, filepath, lang_info.query.get());
+    includes = worker.query_extractor.includes();
+  } else {
+    LOG_DEBUG("extractAllConstructs: Starting AST construct extraction");
+    worker.ast_extractor.setDocstringStyle(lang_info.docstring_style);
+    worker.ast_extractor.setFusedDocstrings(fused_extraction_);
+    worker.ast_extractor.setStringInterner(&strings_);
+    constructs = worker.ast_extractor.extractConstructs(tree, content, filepath);
+    includes = worker.ast_extractor.includes();
+  }
+  constructs_timer.stop();
+  LOG_DEBUG("extractAllConstructs: Construct extraction completed, found " + std::to_string(constructs.size()) + " constructs");
 
-  // Optional: Extract docstring comments and associate them with constructs
-  CLILogger::debug("extractAllConstructs: Extracting docstring comments with style: '" + lang_info.docstring_style + "'");
-  auto docstring_blocks = docstring_parser_.extractDocstrings(content, lang_info.docstring_style);
-  CLILogger::debug("extractAllConstructs: Found " + std::to_string(docstring_blocks.size()) + " docstring blocks");
-  
-  // Associate existing docstrings with constructs (enhance what we found in AST)
-  CLILogger::debug("extractAllConstructs: Associating docstrings with constructs");
-  int associations_made = 0;
-  for (auto& construct : constructs) {
-    if (!construct.docstring.has_value()) {
-      // Look for docstring comments near this construct
-      for (const auto& docstring : docstring_blocks) {
-        // Simple proximity check - could be made more sophisticated
-        if (docstring.location.line < construct.start_line && 
-            construct.start_line - docstring.location.line <= 10) {
-          construct.docstring = docstring.description.empty() ? docstring.raw_content : docstring.description;
-          associations_made++;
-          CLILogger::debug("extractAllConstructs: Associated docstring with construct '" + construct.name + "' (line " + std::to_string(construct.start_line) + ")");
-          break;
-        }
-      }
-    }
+  // In fused mode the AST walk already attached docstrings from comment nodes; queries never do
+  if (!fused_extraction_ || use_query) {
+    // Extract docstring comments and associate them with constructs
+    LOG_DEBUG("extractAllConstructs: Extracting docstring comments with style: '" + lang_info.docstring_style + "'");
+    worker.docstring_parser.setScanner(docstring_scanner_);
+    profile::ScopedTimer docstrings_timer("docstrings");
+    auto docstring_blocks = worker.docstring_parser.extractDocstrings(content, lang_info.docstring_style);
+    docstrings_timer.stop();
+    LOG_DEBUG("extractAllConstructs: Found " + std::to_string(docstring_blocks.size()) + " docstring blocks");
+
+    // Associate existing docstrings with constructs (enhance what we found in AST)
+    LOG_DEBUG("extractAllConstructs: Associating docstrings with constructs");
+    profile::ScopedTimer associate_timer("associate");
+    size_t associations_made = attachNearestDocstrings(constructs, docstring_blocks, lang_info.docstring_window);
+    LOG_DEBUG("extractAllConstructs: Made " + std::to_string(associations_made) + " docstring associations");
   }
-  CLILogger::debug("extractAllConstructs: Made " + std::to_string(associations_made) + " docstring associations");
 
   // Cleanup
-  CLILogger::debug("extractAllConstructs: Cleaning up tree-sitter resources");
+  LOG_DEBUG("extractAllConstructs: Cleaning up tree-sitter resources");
   ts_tree_delete(tree);
-  ts_parser_delete(parser);
+  if (parser_memory::installed()) {
+    profile::peakMemory(filepath, parser_memory::peak());
+  }
   
-  CLILogger::debug("extractAllConstructs: Completed extraction for " + filepath + ", returning " + std::to_string(constructs.size()) + " constructs");
-  return constructs;
+  if (shared_cache_ && store_shared) {
+    shared_cache_->store(shared_key, constructs, includes);
+  }
+
+  LOG_DEBUG("extractAllConstructs: Completed extraction for " + filepath + ", returning " + std::to_string(constructs.size()) + " constructs");
+  return {std::move(constructs), std::move(includes)};
+}
+
+std::string CesiumDocExtractor::extractionSettings(const LanguageInfo& lang_info) const {
+  bool use_query = query_extraction_ && lang_info.query;
+  return std::string(CESIUM_VERSION) + "\n" + std::to_string(SharedExtractionCache::kEntryVersion) + "\n" +
+         lang_info.grammar_fingerprint + "\n" + lang_info.docstring_style + "\n" +
+         std::to_string(lang_info.docstring_window) + "\n" + (use_query ? "query" : fused_extraction_ ? "fused" : "walk") +
+         "\n" + std::to_string(static_cast<int>(docstring_scanner_));
 }
 
 bool CesiumDocExtractor::needsExtraction(const std::string& source_path, const std::string& extract_dir) {
-  CLILogger::debuglow2("CesiumDocExtractor::needsExtraction: Checking if extraction needed for: " + source_path);
+  LOG_DEBUGLOW2("CesiumDocExtractor::needsExtraction: Checking if extraction needed for: " + source_path);
   
   // Convert source file path to expected markdown snippet path
   std::filesystem::path source_file(source_path);
   std::string base_name = source_file.stem().string();
   std::string snippet_path = extract_dir + "/" + base_name + ".md";
+
+  // Archived snippets have no timestamps of their own; compare against the archive file
+  if (output_mode_ == OutputMode::Archive) {
+    std::string archive_path = snippetArchivePath(extract_dir);
+    SnippetArchive archive;
+    if (!archive.open(archive_path) || !archive.contains(base_name + ".md")) {
+      LOG_DEBUGLOW2("CesiumDocExtractor::needsExtraction: Snippet not archived, extraction needed");
+      return true;
+    }
+    archive.close();
+    std::error_code ec;
+    auto source_time = std::filesystem::last_write_time(source_path, ec);
+    auto archive_time = std::filesystem::last_write_time(archive_path, ec);
+    return ec || source_time > archive_time;
+  }
   
-  CLILogger::debuglow2("CesiumDocExtractor::needsExtraction: Expected snippet path: " + snippet_path);
+  LOG_DEBUGLOW2("CesiumDocExtractor::needsExtraction: Expected snippet path: " + snippet_path);
   
   // If snippet doesn't exist, need extraction
   try {
     if (!std::filesystem::exists(snippet_path)) {
-      CLILogger::debuglow2("CesiumDocExtractor::needsExtraction: Snippet does not exist, extraction needed");
+      LOG_DEBUGLOW2("CesiumDocExtractor::needsExtraction: Snippet does not exist, extraction needed");
       return true;
     }
   } catch (const std::filesystem::filesystem_error& e) {
@@ -396,7 +1051,7 @@ bool CesiumDocExtractor::needsExtraction(const std::string& source_path, const s
     auto snippet_time = std::filesystem::last_write_time(snippet_path);
     
     bool needs_extraction = source_time > snippet_time;
-    CLILogger::debuglow2("CesiumDocExtractor::needsExtraction: Source newer than snippet: " + std::string(needs_extraction ? "true" : "false"));
+    LOG_DEBUGLOW2("CesiumDocExtractor::needsExtraction: Source newer than snippet: " + std::string(needs_extraction ? "true" : "false"));
     return needs_extraction;
   } catch (const std::filesystem::filesystem_error& e) {
     CLILogger::error("CesiumDocExtractor::needsExtraction: Error comparing file times for '" + source_path + "' and '" + snippet_path + "': " + e.what());
@@ -404,55 +1059,47 @@ bool CesiumDocExtractor::needsExtraction(const std::string& source_path, const s
   }
 }
 
-void CesiumDocExtractor::processMarkdownSnippets(const std::string& extract_dir, const std::string& output_dir) {
-  CLILogger::debug("CesiumDocExtractor::processMarkdownSnippets: Processing snippets from '" + extract_dir + "' to '" + output_dir + "'");
-  
-  // Placeholder function for processing markdown snippets into structured documentation
-  // This will be implemented later to handle organization, cross-references, etc.
-  
+void CesiumDocExtractor::processMarkdownSnippets(const std::string& extract_dir, const std::string& output_dir,
+                                                 const std::unordered_map<std::string, std::string>* rendered) {
+  LOG_DEBUG("CesiumDocExtractor::processMarkdownSnippets: Processing snippets from '" + extract_dir + "' to '" + output_dir + "'");
   std::cout << "Processing markdown snippets from " << extract_dir << " to " << output_dir << std::endl;
-  
-  // Create output directory
-  CLILogger::debug("CesiumDocExtractor::processMarkdownSnippets: Creating output directory: " + output_dir);
-  try {
-    bool created = std::filesystem::create_directories(output_dir);
-    if (created) {
-      CLILogger::debug("CesiumDocExtractor::processMarkdownSnippets: Successfully created output directory: " + output_dir);
-    } else {
-      CLILogger::debug("CesiumDocExtractor::processMarkdownSnippets: Output directory already exists: " + output_dir);
-    }
-  } catch (const std::filesystem::filesystem_error& e) {
-    CLILogger::error("CesiumDocExtractor::processMarkdownSnippets: Failed to create output directory '" + output_dir + "': " + e.what());
-    return;
+
+  // Cross-references and namespace pages; only snippets that changed since the last run are redone
+  profile::ScopedTimer pages_timer("generate_pages");
+  SnippetProcessor processor;
+  processor.setJobs(parallelism_);
+  processor.setOutputMode(output_mode_);
+  processor.setRenderedSnippets(rendered);
+  bool complete = processor.process(extract_dir, output_dir);
+  pages_timer.stop();
+  profile::count("pages_written", processor.writtenCount());
+
+  std::cout << "Pages: " << processor.writtenCount() << " written, " << processor.linkedCount() << " linked, "
+            << processor.unchangedCount() << " unchanged, " << processor.removedCount() << " removed";
+  if (processor.failedCount() > 0) {
+    std::cout << ", " << processor.failedCount() << " failed";
   }
-  
-  // For now, just copy snippets to output directory
-  // TODO: Implement proper snippet processing, organization, cross-referencing
-  CLILogger::debug("CesiumDocExtractor::processMarkdownSnippets: Iterating snippets in extract directory");
-  try {
-    int processed_count = 0;
-    for (const auto& entry : std::filesystem::directory_iterator(extract_dir)) {
-      if (entry.is_regular_file() && entry.path().extension() == ".md") {
-        std::string source_path = entry.path().string();
-        std::filesystem::path dest = std::filesystem::path(output_dir) / entry.path().filename();
-        std::string dest_path = dest.string();
-        
-        CLILogger::debuglow("CesiumDocExtractor::processMarkdownSnippets: Copying snippet '" + source_path + "' to '" + dest_path + "'");
-        try {
-          std::filesystem::copy_file(entry.path(), dest, std::filesystem::copy_options::overwrite_existing);
-          std::cout << "Processed snippet: " << entry.path().filename() << std::endl;
-          processed_count++;
-        } catch (const std::filesystem::filesystem_error& e) {
-          CLILogger::error("CesiumDocExtractor::processMarkdownSnippets: Failed to copy snippet '" + source_path + "' to '" + dest_path + "': " + e.what());
-        }
-      }
-    }
-    CLILogger::debug("CesiumDocExtractor::processMarkdownSnippets: Successfully processed " + std::to_string(processed_count) + " markdown snippets");
-  } catch (const std::filesystem::filesystem_error& e) {
-    CLILogger::error("CesiumDocExtractor::processMarkdownSnippets: Error iterating extract directory '" + extract_dir + "': " + e.what());
+  std::cout << std::endl;
+
+  if (!complete) {
+    CLILogger::error("CesiumDocExtractor::processMarkdownSnippets: Snippet processing did not complete for '" + output_dir + "'");
     return;
   }
-  
   std::cout << "Snippet processing complete" << std::endl;
-  CLILogger::debug("CesiumDocExtractor::processMarkdownSnippets: Completed snippet processing");
+  LOG_DEBUG("CesiumDocExtractor::processMarkdownSnippets: Completed snippet processing");
+}
+
+void CesiumDocExtractor::writeSearchIndex(const std::string& extract_dir, const std::string& output_dir) {
+  // Built from the documents extraction kept, so no page is read back
+  profile::ScopedTimer search_timer("search_index");
+  SearchIndex search;
+  search.load(searchDocumentsPath(extract_dir));
+  std::string search_dir = (std::filesystem::path(output_dir) / "search").string();
+  if (!search.writeShards(search_dir, search_shards_)) {
+    CLILogger::error("CesiumDocExtractor::writeSearchIndex: Failed to write the search index to '" + search_dir + "'");
+    return;
+  }
+  profile::count("search_files_written", search.filesWritten());
+  std::cout << "Search index: " << search.size() << " documents, " << search.filesWritten() << " of "
+            << search_shards_ + 1 << " files written" << std::endl;
 }
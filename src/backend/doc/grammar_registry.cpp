@@ -0,0 +1,26 @@
+/**
+@brief Built-in Tree-sitter grammar table
+*/
+#include <backend/doc/grammar_registry.h>
+
+#ifdef CESIUM_BUILTIN_TREE_SITTER_CPP
+extern "C" const TSLanguage* tree_sitter_cpp(void);
+#endif
+
+namespace {
+  const BuiltinGrammar kBuiltinGrammars[] = {
+    #ifdef CESIUM_BUILTIN_TREE_SITTER_CPP
+      {"tree_sitter_cpp", tree_sitter_cpp},
+    #endif
+    {nullptr, nullptr}  // Keeps the table non-empty when nothing is built in
+  };
+}
+
+const TSLanguage* findBuiltinGrammar(std::string_view function_name) {
+  for (const auto& grammar : kBuiltinGrammars) {
+    if (grammar.function_name && function_name == grammar.function_name) {
+      return grammar.language();
+    }
+  }
+  return nullptr;
+}
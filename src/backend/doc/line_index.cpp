@@ -0,0 +1,50 @@
+/**
+@brief Line index implementation
+*/
+#include <backend/doc/line_index.h>
+#include <algorithm>
+#include <cstring>
+
+LineIndex::LineIndex(std::string_view content) {
+  build(content);
+}
+
+void LineIndex::build(std::string_view content) {
+  line_starts_.clear();
+  content_size_ = content.size();
+  line_starts_.push_back(0);
+
+  // memchr hands the newline search to libc's vectorized implementation
+  const char* data = content.data();
+  size_t pos = 0;
+  while (pos < content.size()) {
+    const void* newline = std::memchr(data + pos, '\n', content.size() - pos);
+    if (newline == nullptr) break;
+    pos = static_cast<size_t>(static_cast<const char*>(newline) - data) + 1;
+    line_starts_.push_back(pos);
+  }
+}
+
+SourceLocation LineIndex::locate(size_t byte_offset) const {
+  if (line_starts_.empty()) {
+    return {1, 0, byte_offset};
+  }
+
+  size_t clamped = std::min(byte_offset, content_size_);
+  // First line start greater than the offset; the line before it contains the offset
+  auto it = std::upper_bound(line_starts_.begin(), line_starts_.end(), clamped);
+  size_t line_index = static_cast<size_t>(it - line_starts_.begin()) - 1;
+  return {line_index + 1, clamped - line_starts_[line_index], byte_offset};
+}
+
+TSPoint LineIndex::pointAt(size_t byte_offset) const {
+  SourceLocation location = locate(byte_offset);
+  return {static_cast<uint32_t>(location.line - 1), static_cast<uint32_t>(location.column)};
+}
+
+size_t LineIndex::lineStart(size_t line) const {
+  if (line == 0 || line > line_starts_.size()) {
+    return content_size_;
+  }
+  return line_starts_[line - 1];
+}
@@ -7,43 +7,18 @@
 #include <filesystem>
 #include <algorithm>
 #include <map>
+#include <unordered_map>
 #include <backend/core/cli_utils.h>
-
-// Local utility function for escaping symbols in filenames
-std::string escapeSymbolsForFilename(const std::string& name) {
-  std::string result = name;
-  
-  // Character-level escaping for invalid filename characters
-  // Note: : is not escaped here since :: is handled separately by converting to .
-  std::map<char, std::string> escapes = {
-    {'<', "%lt"},
-    {'>', "%gt"},
-    {'"', "%quote"},
-    {'|', "%pipe"},
-    {'?', "%quest"},
-    {'*', "%star"},
-    {'\\', "%bslash"},
-    {'/', "%slash"}
-  };
-  
-  for (const auto& [ch, replacement] : escapes) {
-    size_t pos = 0;
-    while ((pos = result.find(ch, pos)) != std::string::npos) {
-      result.replace(pos, 1, replacement);
-      pos += replacement.length();
-    }
-  }
-  
-  return result;
-}
+#include <backend/core/hash.h>
+#include <backend/doc/page_name.h>
 
 void MarkdownGenerator::generateMarkdownFiles(const std::vector<DocstringBlock>& blocks,
                                               const std::string& output_dir) {
-  CLILogger::debug("MarkdownGenerator::generateMarkdownFiles: Starting generation for " + std::to_string(blocks.size()) + " blocks to directory: " + output_dir);
+  LOG_DEBUG("MarkdownGenerator::generateMarkdownFiles: Starting generation for " + std::to_string(blocks.size()) + " blocks to directory: " + output_dir);
   
   try {
     std::filesystem::create_directories(output_dir);
-    CLILogger::debug("MarkdownGenerator::generateMarkdownFiles: Successfully created output directory: " + output_dir);
+    LOG_DEBUG("MarkdownGenerator::generateMarkdownFiles: Successfully created output directory: " + output_dir);
   } catch (const std::exception& e) {
     CLILogger::error("MarkdownGenerator::generateMarkdownFiles: Failed to create output directory " + output_dir + ": " + e.what());
     return;
@@ -56,20 +31,20 @@ void MarkdownGenerator::generateMarkdownFiles(const std::vector<DocstringBlock>&
     if (!block.symbol_name.empty()) {
       std::string filename = generateFilename(block);
       std::string filepath = output_dir + "/" + filename;
-      CLILogger::debug("MarkdownGenerator::generateMarkdownFiles: Generating file for symbol '" + block.symbol_name + "' -> " + filename);
+      LOG_DEBUG("MarkdownGenerator::generateMarkdownFiles: Generating file for symbol '" + block.symbol_name + "' -> " + filename);
       generateMarkdownFile(block, filepath);
       files_generated++;
     } else {
       blocks_skipped++;
-      CLILogger::debug("MarkdownGenerator::generateMarkdownFiles: Skipping block with empty symbol_name (line " + std::to_string(block.location.line) + ")");
+      LOG_DEBUG("MarkdownGenerator::generateMarkdownFiles: Skipping block with empty symbol_name (line " + std::to_string(block.location.line) + ")");
     }
   }
   
-  CLILogger::debug("MarkdownGenerator::generateMarkdownFiles: Completed generation - " + std::to_string(files_generated) + " files generated, " + std::to_string(blocks_skipped) + " blocks skipped");
+  LOG_DEBUG("MarkdownGenerator::generateMarkdownFiles: Completed generation - " + std::to_string(files_generated) + " files generated, " + std::to_string(blocks_skipped) + " blocks skipped");
 }
 
 std::string MarkdownGenerator::generateFilename(const DocstringBlock& block) {
-  CLILogger::debug("MarkdownGenerator::generateFilename: Generating filename for symbol '" + block.symbol_name + "' in namespace '" + block.namespace_path + "'");
+  LOG_DEBUG("MarkdownGenerator::generateFilename: Generating filename for symbol '" + block.symbol_name + "' in namespace '" + block.namespace_path + "'");
   
   // Create filename based on namespace and symbol name
   std::string name = block.namespace_path;
@@ -82,19 +57,19 @@ std::string MarkdownGenerator::generateFilename(const DocstringBlock& block) {
     CLILogger::warning("MarkdownGenerator::generateFilename: Block has empty symbol_name, using 'unnamed'");
   }
   
-  CLILogger::debug("MarkdownGenerator::generateFilename: Raw name before sanitization: '" + name + "'");
+  LOG_DEBUG("MarkdownGenerator::generateFilename: Raw name before sanitization: '" + name + "'");
 
   // Replace :: with - and make filesystem safe
   std::replace(name.begin(), name.end(), ':', '-');
   std::replace(name.begin(), name.end(), ' ', '_');
   
   std::string filename = name + ".md";
-  CLILogger::debug("MarkdownGenerator::generateFilename: Final filename: '" + filename + "'");
+  LOG_DEBUG("MarkdownGenerator::generateFilename: Final filename: '" + filename + "'");
   return filename;
 }
 
 void MarkdownGenerator::generateMarkdownFile(const DocstringBlock& block, const std::string& filepath) {
-  CLILogger::debug("MarkdownGenerator::generateMarkdownFile: Creating markdown file: " + filepath);
+  LOG_DEBUG("MarkdownGenerator::generateMarkdownFile: Creating markdown file: " + filepath);
   
   std::ofstream file(filepath);
   if (!file.is_open()) {
@@ -102,7 +77,7 @@ void MarkdownGenerator::generateMarkdownFile(const DocstringBlock& block, const
     return;
   }
   
-  CLILogger::debug("MarkdownGenerator::generateMarkdownFile: Successfully opened file for writing: " + filepath);
+  LOG_DEBUG("MarkdownGenerator::generateMarkdownFile: Successfully opened file for writing: " + filepath);
 
   // YAML frontmatter
   file << "---\n";
@@ -157,183 +132,302 @@ void MarkdownGenerator::generateMarkdownFile(const DocstringBlock& block, const
   if (!file.good()) {
     CLILogger::error("MarkdownGenerator::generateMarkdownFile: File write errors occurred while generating " + filepath);
   } else {
-    CLILogger::debug("MarkdownGenerator::generateMarkdownFile: Successfully completed file: " + filepath);
+    LOG_DEBUG("MarkdownGenerator::generateMarkdownFile: Successfully completed file: " + filepath);
   }
 
   file.close();
 }
 
-std::vector<std::string> MarkdownGenerator::generateMarkdownFromConstructs(const std::vector<CodeConstruct>& constructs,
-                                                                          const std::string& output_dir) {
-  CLILogger::debug("MarkdownGenerator::generateMarkdownFromConstructs: Starting generation for " + std::to_string(constructs.size()) + " constructs to directory: " + output_dir);
+GeneratedFileMap MarkdownGenerator::generateMarkdownFromConstructs(const std::vector<CodeConstruct>& constructs,
+                                                                  const std::string& output_dir) {
+  LOG_DEBUG("MarkdownGenerator::generateMarkdownFromConstructs: Starting generation for " + std::to_string(constructs.size()) + " constructs to directory: " + output_dir);
   
   try {
     std::filesystem::create_directories(output_dir);
-    CLILogger::debug("MarkdownGenerator::generateMarkdownFromConstructs: Successfully created output directory: " + output_dir);
+    LOG_DEBUG("MarkdownGenerator::generateMarkdownFromConstructs: Successfully created output directory: " + output_dir);
   } catch (const std::exception& e) {
     CLILogger::error("MarkdownGenerator::generateMarkdownFromConstructs: Failed to create output directory " + output_dir + ": " + e.what());
     return {};
   }
-  std::vector<std::string> generated_files;
+  GeneratedFileMap generated_files;
   int successful_generations = 0;
   int failed_generations = 0;
+  output_hashes_.clear();
+  written_count_ = 0;
+  unchanged_count_ = 0;
+  failed_count_ = 0;
+  bytes_written_ = 0;
+  writer_.resetStats();
+  writer_.setJobs(write_jobs_);
+  archive_pages_.clear();
+  rendered_pages_.clear();
+  if (output_mode_ == OutputMode::Archive) {
+    // Existing pages are compared against the archive rather than individual files
+    archive_.open(snippetArchivePath(output_dir));
+  }
+
+  // Repeats of one construct share a page and the last one wins, so only that one is rendered.
+  // Overloads are told apart by their own signature, so their pages never depend on which others
+  // this call happens to see
+  std::vector<std::string> filenames(constructs.size());
+  std::unordered_map<std::string, size_t> last_writer;
+  for (size_t i = 0; i < constructs.size(); ++i) {
+    std::string& filename = filenames[i];
+    generateConstructFilename(constructs[i], filename);
+    if (hasOverloadPage(constructs[i])) {
+      appendOverloadSuffix(filename, overloadSignature(constructs[i]));
+    }
+    last_writer[filename] = i;
+  }
 
-  for (const auto& construct : constructs) {
-    std::string filename = generateConstructFilename(construct);
+  for (size_t i = 0; i < constructs.size(); ++i) {
+    const CodeConstruct& construct = constructs[i];
+    const std::string& filename = filenames[i];
     std::string filepath = output_dir + "/" + filename;
-    CLILogger::debug("MarkdownGenerator::generateMarkdownFromConstructs: Processing construct '" + construct.full_name + "' -> " + filename);
+    LOG_DEBUG("MarkdownGenerator::generateMarkdownFromConstructs: Processing construct '" + construct.full_name + "' -> " + filename);
     
     try {
-      generateConstructMarkdownFile(construct, filepath);
-      generated_files.push_back(filepath);
+      if (last_writer[filename] == i) {
+        output_hashes_[filepath] = generateConstructMarkdownFile(construct, filepath);
+        if (search_index_) {
+          search_index_->addPage(filename, formatConstructType(construct.type), construct);
+        }
+      }
+      for (const auto& source_file : constructSourceFiles(construct)) {
+        auto& outputs = generated_files[source_file];
+        if (std::find(outputs.begin(), outputs.end(), filepath) == outputs.end()) {
+          outputs.push_back(filepath);
+        }
+      }
       successful_generations++;
-      std::cout << "Generated: " << filename << std::endl;
     } catch (const std::exception& e) {
       CLILogger::error("MarkdownGenerator::generateMarkdownFromConstructs: Failed to generate file for construct '" + construct.full_name + "': " + e.what());
       failed_generations++;
     }
   }
   
-  CLILogger::debug("MarkdownGenerator::generateMarkdownFromConstructs: Completed generation - " + std::to_string(successful_generations) + " successful, " + std::to_string(failed_generations) + " failed");
-  return generated_files;
-}
+  std::vector<std::string> failed_paths;
+  if (output_mode_ == OutputMode::Archive) {
+    archive_.close();
+    if (!archive_pages_.empty()) {
+      if (updateSnippetArchive(snippetArchivePath(output_dir), archive_pages_)) {
+        written_count_ = archive_pages_.size();
+        for (const auto& [name, content] : archive_pages_) {
+          bytes_written_ += content.size();
+        }
+      } else {
+        for (const auto& [name, content] : archive_pages_) {
+          failed_paths.push_back(output_dir + "/" + name);
+        }
+      }
+      archive_pages_.clear();
+    }
+  } else {
+    writer_.flush();
+    written_count_ = writer_.filesWritten();
+    bytes_written_ = writer_.bytesWritten();
+    failed_paths = writer_.failedPaths();
+  }
+
+  // A page that never reached disk has no valid hash and must not be recorded as generated
+  for (const auto& failed_path : failed_paths) {
+    CLILogger::error("MarkdownGenerator::generateMarkdownFromConstructs: Failed to write file: " + failed_path);
+    output_hashes_.erase(failed_path);
+    rendered_pages_.erase(std::filesystem::path(failed_path).filename().string());
+    for (auto& [source_file, outputs] : generated_files) {
+      outputs.erase(std::remove(outputs.begin(), outputs.end(), failed_path), outputs.end());
+    }
+    failed_count_++;
+  }
 
-std::string MarkdownGenerator::generateConstructFilename(const CodeConstruct& construct) {
-  CLILogger::debug("MarkdownGenerator::generateConstructFilename: Generating filename for construct '" + construct.full_name + "' (name: '" + construct.name + "', type: " + formatConstructType(construct.type) + ")");
-  
-  std::string name = construct.full_name;
-  if (name.empty()) {
-    name = construct.name;
-    CLILogger::debug("MarkdownGenerator::generateConstructFilename: full_name empty, using name: '" + name + "'");
+  // A later call in the same run (the next streamed batch) compares against what is now on disk
+  for (const auto& [path, hash] : output_hashes_) {
+    recorded_hashes_[path] = hash;
   }
-  if (name.empty()) {
-    name = "unnamed_" + formatConstructType(construct.type);
-    CLILogger::warning("MarkdownGenerator::generateConstructFilename: Both full_name and name empty, using fallback: '" + name + "'");
+  for (const auto& failed_path : failed_paths) {
+    recorded_hashes_.erase(failed_path);
   }
 
-  // First replace :: with . for dot-delimited fully-qualified names
-  std::replace(name.begin(), name.end(), ':', '.');
-  // Remove extra dots from double-colon conversion
-  size_t pos = 0;
-  while ((pos = name.find("..", pos)) != std::string::npos) {
-    name.replace(pos, 2, ".");
-    pos += 1;
+  LOG_DEBUG("MarkdownGenerator::generateMarkdownFromConstructs: Completed generation - " + std::to_string(successful_generations) + " successful, " + std::to_string(failed_generations + failed_count_) + " failed, " + std::to_string(written_count_) + " pages written, " + std::to_string(unchanged_count_) + " unchanged");
+  return generated_files;
+}
+
+std::vector<std::string> MarkdownGenerator::constructSourceFiles(const CodeConstruct& construct) {
+  std::vector<std::string> sources;
+  if (!construct.filename.empty()) {
+    sources.emplace_back(construct.filename);
   }
-  
-  // Then escape problematic characters (but not : since we already handled ::)
-  name = escapeSymbolsForFilename(name);
-  
-  // Make other characters filesystem safe
-  std::replace(name.begin(), name.end(), ' ', '_');
 
-  std::string filename = name + ".md";
-  CLILogger::debug("MarkdownGenerator::generateConstructFilename: Final filename: '" + filename + "'");
-  return filename;
+  // Merged constructs record every "file:line" they were assembled from
+  for (const auto& location : construct.source_locations) {
+    size_t colon = location.find_last_of(':');
+    std::string source_file = colon == std::string::npos ? location : location.substr(0, colon);
+    if (!source_file.empty() && std::find(sources.begin(), sources.end(), source_file) == sources.end()) {
+      sources.push_back(source_file);
+    }
+  }
+  return sources;
 }
 
-void MarkdownGenerator::generateConstructMarkdownFile(const CodeConstruct& construct, const std::string& filepath) {
-  CLILogger::debug("MarkdownGenerator::generateConstructMarkdownFile: Creating markdown file for construct '" + construct.full_name + "' at: " + filepath);
-  
-  std::ofstream file(filepath);
-  if (!file.is_open()) {
-    CLILogger::error("MarkdownGenerator::generateConstructMarkdownFile: Failed to create file: " + filepath);
-    return;
+void MarkdownGenerator::generateConstructFilename(const CodeConstruct& construct, std::string& out) {
+  if (!construct.full_name.empty()) {
+    encodePageName(construct.full_name, out);
+  } else if (!construct.name.empty()) {
+    encodePageName(construct.name, out);
+  } else {
+    std::string fallback = "unnamed_" + formatConstructType(construct.type);
+    CLILogger::warning("MarkdownGenerator::generateConstructFilename: Both full_name and name empty, using fallback: '" + fallback + "'");
+    encodePageName(fallback, out);
   }
-  
-  CLILogger::debug("MarkdownGenerator::generateConstructMarkdownFile: Successfully opened file for writing: " + filepath);
+  LOG_DEBUGLOW2("MarkdownGenerator::generateConstructFilename: '" + construct.full_name + "' -> '" + out + "'");
+}
+
+void MarkdownGenerator::renderConstructMarkdown(const CodeConstruct& construct, std::string& out) {
+  std::string type_name = formatConstructType(construct.type);
+  std::string start_line = std::to_string(construct.start_line);
+  std::string end_line = std::to_string(construct.end_line);
 
   // YAML frontmatter
-  file << "---\n";
-  file << "type: " << formatConstructType(construct.type) << "\n";
+  out += "---\n";
+  out.append("type: ").append(type_name).append("\n");
   if (!construct.namespace_path.empty()) {
-    file << "namespace: " << construct.namespace_path << "\n";
+    out.append("namespace: ").append(construct.namespace_path).append("\n");
   }
-  file << "name: " << construct.name << "\n";
-  file << "full_name: " << construct.full_name << "\n";
-  file << "start_line: " << construct.start_line << "\n";
-  file << "end_line: " << construct.end_line << "\n";
-  file << "file: " << construct.filename << "\n";
+  out.append("name: ").append(construct.name).append("\n");
+  out.append("full_name: ").append(construct.full_name).append("\n");
+  out.append("start_line: ").append(start_line).append("\n");
+  out.append("end_line: ").append(end_line).append("\n");
+  out.append("file: ").append(construct.filename).append("\n");
   if (construct.return_type.has_value()) {
-    file << "return_type: " << construct.return_type.value() << "\n";
+    out.append("return_type: ").append(construct.return_type.value()).append("\n");
+  }
+  if (!construct.parameters.empty()) {
+    out += "parameter_types:\n";
+    for (const auto& param : construct.parameters) {
+      out.append("  - ").append(param.type).append("\n");
+    }
   }
   
   // Include merged docstring information
   if (construct.is_merged) {
-    file << "is_merged: true\n";
+    out += "is_merged: true\n";
     if (!construct.source_locations.empty()) {
-      file << "source_locations:\n";
+      out += "source_locations:\n";
       for (const auto& location : construct.source_locations) {
-        file << "  - " << location << "\n";
+        out.append("  - ").append(location).append("\n");
       }
     }
   }
   
-  file << "---\n\n";
+  out += "---\n\n";
 
   // Title
-  file << "# " << construct.name << "\n\n";
+  out.append("# ").append(construct.name).append("\n\n");
 
   // Type and signature
-  file << "*" << formatConstructType(construct.type);
+  out.append("*").append(type_name);
   if (!construct.namespace_path.empty()) {
-    file << " in " << construct.namespace_path;
+    out.append(" in ").append(construct.namespace_path);
   }
-  file << "*\n\n";
+  out += "*\n\n";
 
   // Function signature
   if (construct.type == ConstructType::Function || construct.type == ConstructType::Method) {
-    file << "## Signature\n\n";
-    file << "```cpp\n";
-    file << formatFunctionSignature(construct);
-    file << "\n```\n\n";
+    out += "## Signature\n\n";
+    out += "```cpp\n";
+    out += formatFunctionSignature(construct);
+    out += "\n```\n\n";
   }
 
   // Parameters
   if (!construct.parameters.empty()) {
-    file << "## Parameters\n\n";
-    file << "| Name | Type | Description |\n";
-    file << "|------|------|-------------|\n";
+    out += "## Parameters\n\n";
+    out += "| Name | Type | Description |\n";
+    out += "|------|------|-------------|\n";
     for (const auto& param : construct.parameters) {
-      file << "| `" << param.name << "` | `" << param.type << "` | ";
+      out.append("| `").append(param.name).append("` | `").append(param.type).append("` | ");
       if (param.default_value.has_value()) {
-        file << "*Default: `" << param.default_value.value() << "`*";
+        out.append("*Default: `").append(param.default_value.value()).append("`*");
       } else {
-        file << "*(No description available)*";
+        out += "*(No description available)*";
       }
-      file << " |\n";
+      out += " |\n";
     }
-    file << "\n";
+    out += "\n";
   }
 
   // Return type
   if (construct.return_type.has_value() && construct.return_type.value() != "void") {
-    file << "## Returns\n\n";
-    file << "`" << construct.return_type.value() << "`\n\n";
-    file << "*(No description available)*\n\n";
+    out += "## Returns\n\n";
+    out.append("`").append(construct.return_type.value()).append("`\n\n");
+    out += "*(No description available)*\n\n";
   }
 
   // Documentation from docstring
   if (construct.docstring.has_value()) {
-    file << "## Documentation\n\n";
-    file << construct.docstring.value() << "\n\n";
+    out += "## Documentation\n\n";
+    out.append(construct.docstring.value()).append("\n\n");
   } else {
-    file << "## Documentation\n\n";
-    file << "*No documentation available. This " << formatConstructType(construct.type) 
-         << " was automatically discovered from the source code.*\n\n";
+    out += "## Documentation\n\n";
+    out.append("*No documentation available. This ").append(type_name)
+       .append(" was automatically discovered from the source code.*\n\n");
   }
 
   // File location
-  file << "## Source\n\n";
-  file << "**File:** `" << construct.filename << "`\n\n";
-  file << "**Lines:** " << construct.start_line << "-" << construct.end_line << "\n";
+  out += "## Source\n\n";
+  out.append("**File:** `").append(construct.filename).append("`\n\n");
+  out.append("**Lines:** ").append(start_line).append("-").append(end_line).append("\n");
+}
 
-  if (!file.good()) {
-    CLILogger::error("MarkdownGenerator::generateConstructMarkdownFile: File write errors occurred while generating " + filepath);
-  } else {
-    CLILogger::debug("MarkdownGenerator::generateConstructMarkdownFile: Successfully completed file: " + filepath);
+std::string MarkdownGenerator::generateConstructMarkdownFile(const CodeConstruct& construct, const std::string& filepath) {
+  LOG_DEBUG("MarkdownGenerator::generateConstructMarkdownFile: Rendering markdown for construct '" + construct.full_name + "' at: " + filepath);
+
+  std::string content = writer_.acquireBuffer();
+  renderConstructMarkdown(construct, content);
+  std::string content_hash = hashing::hashString(content);
+
+  if (output_mode_ == OutputMode::Archive) {
+    std::string name = std::filesystem::path(filepath).filename().string();
+    std::optional<size_t> existing = archive_.indexOf(name);
+    bool unchanged = false;
+    if (existing) {
+      auto recorded = recorded_hashes_.find(filepath);
+      unchanged = recorded != recorded_hashes_.end() ? recorded->second == content_hash
+                                                     : archive_.contentAt(*existing) == content;
+    }
+    if (unchanged) {
+      LOG_DEBUG("MarkdownGenerator::generateConstructMarkdownFile: Archived page unchanged: " + name);
+      unchanged_count_++;
+      return content_hash;
+    }
+
+    // Collected and written as one archive update once all pages are rendered
+    archive_pages_[name] = std::move(content);
+    return content_hash;
   }
 
-  file.close();
+  // Leave an identical page alone so its mtime (and everything keyed on it) is unchanged
+  std::error_code ec;
+  auto recorded = recorded_hashes_.find(filepath);
+  bool unchanged = false;
+  if (recorded != recorded_hashes_.end()) {
+    unchanged = recorded->second == content_hash && std::filesystem::exists(filepath, ec);
+  } else if (std::filesystem::file_size(filepath, ec) == content.size() && !ec) {
+    // Nothing recorded (first run or lost cache): compare against the page on disk
+    unchanged = hashing::hashFile(filepath) == content_hash;
+  }
+  if (unchanged) {
+    LOG_DEBUG("MarkdownGenerator::generateConstructMarkdownFile: Output unchanged, skipping write: " + filepath);
+    unchanged_count_++;
+    return content_hash;
+  }
+
+  // Queued; the batch is written on flush (failures are reported from there)
+  if (retain_pages_) {
+    rendered_pages_[std::filesystem::path(filepath).filename().string()] = content;
+  }
+  writer_.write(filepath, std::move(content));
+  return content_hash;
 }
 
 std::string MarkdownGenerator::formatConstructType(ConstructType type) {
@@ -356,7 +450,7 @@ std::string MarkdownGenerator::formatFunctionSignature(const CodeConstruct& cons
   
   // Return type
   if (construct.return_type.has_value()) {
-    signature += construct.return_type.value() + " ";
+    signature.append(construct.return_type.value()).append(" ");
   }
   
   // Function name
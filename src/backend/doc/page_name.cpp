@@ -0,0 +1,101 @@
+/**
+@brief Page file name encoding implementation
+*/
+#include <backend/doc/page_name.h>
+#include <array>
+#include <backend/core/hash.h>
+
+namespace {
+  constexpr std::string_view kExtension = ".md";
+  constexpr size_t kOverloadSuffixLength = 9;  // '~' and 8 hex digits
+  constexpr size_t kStemLimit = kMaxPageNameLength - kExtension.size() - kOverloadSuffixLength;
+  constexpr size_t kHashSuffixLength = 17;     // '~' and 16 hex digits
+
+  // Replacement per byte; empty means the byte is copied as is (':' and control characters are handled by the encoder)
+  constexpr std::array<std::string_view, 256> kEscapes = [] {
+    std::array<std::string_view, 256> escapes{};
+    escapes['<'] = "%lt";
+    escapes['>'] = "%gt";
+    escapes['"'] = "%quote";
+    escapes['|'] = "%pipe";
+    escapes['?'] = "%quest";
+    escapes['*'] = "%star";
+    escapes['\\'] = "%bslash";
+    escapes['/'] = "%slash";
+    escapes[' '] = "_";
+    return escapes;
+  }();
+
+  char upper(char c) {
+    return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+  }
+
+  // Windows opens the device instead of the file for these, whatever the extension
+  bool isReservedDeviceName(std::string_view stem) {
+    if (stem.size() == 3) {
+      for (std::string_view device : {"CON", "PRN", "AUX", "NUL"}) {
+        if (upper(stem[0]) == device[0] && upper(stem[1]) == device[1] && upper(stem[2]) == device[2]) {
+          return true;
+        }
+      }
+      return false;
+    }
+    if (stem.size() == 4 && stem[3] >= '1' && stem[3] <= '9') {
+      std::string prefix{upper(stem[0]), upper(stem[1]), upper(stem[2])};
+      return prefix == "COM" || prefix == "LPT";
+    }
+    return false;
+  }
+}
+
+void encodePageName(std::string_view qualified_name, std::string& out) {
+  out.clear();
+  out.reserve(qualified_name.size() + kExtension.size());
+  for (size_t i = 0; i < qualified_name.size(); ++i) {
+    char c = qualified_name[i];
+    if (c == ':') {
+      out += '.';
+      if (i + 1 < qualified_name.size() && qualified_name[i + 1] == ':') {
+        ++i;
+      }
+      continue;
+    }
+    unsigned char byte = static_cast<unsigned char>(c);
+    if (byte < 0x20 || byte == 0x7F) {
+      out += "%x";
+      out += "0123456789abcdef"[byte >> 4];
+      out += "0123456789abcdef"[byte & 0xF];
+    } else if (!kEscapes[byte].empty()) {
+      out += kEscapes[byte];
+    } else {
+      out += c;
+    }
+  }
+
+  size_t first_dot = out.find('.');
+  if (isReservedDeviceName(std::string_view(out).substr(0, first_dot))) {
+    out.insert(first_dot == std::string::npos ? out.size() : first_dot, "_");
+  }
+
+  if (out.size() > kStemLimit) {
+    std::string digest = hashing::toHex(hashing::xxh64(out));
+    size_t keep = kStemLimit - kHashSuffixLength;
+    while (keep > 0 && (static_cast<unsigned char>(out[keep]) & 0xC0) == 0x80) {
+      --keep;
+    }
+    out.resize(keep);
+    out += '~';
+    out += digest;
+  }
+  out += kExtension;
+}
+
+void appendOverloadSuffix(std::string& filename, std::string_view signature) {
+  size_t stem_end = filename.size();
+  if (filename.size() >= kExtension.size() &&
+      std::string_view(filename).substr(filename.size() - kExtension.size()) == kExtension) {
+    stem_end -= kExtension.size();
+  }
+  std::string suffix = "~" + hashing::toHex(hashing::xxh64(signature)).substr(0, kOverloadSuffixLength - 1);
+  filename.insert(stem_end, suffix);
+}
@@ -0,0 +1,256 @@
+/**
+@brief Query-driven construct extraction implementation
+*/
+#include <backend/doc/query_extractor.h>
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+#include <backend/core/cli_utils.h>
+
+namespace {
+  std::string_view nodeText(TSNode node, const std::string& content) {
+    size_t start = ts_node_start_byte(node);
+    size_t end = std::min<size_t>(ts_node_end_byte(node), content.size());
+    if (start > end) start = end;
+    return std::string_view(content).substr(start, end - start);
+  }
+
+  bool isIdentifierChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+  }
+
+  // A definition collected from one match, before namespace paths are known
+  struct Definition {
+    TSNode node;
+    ConstructType type;
+    TSNode name = {};
+    TSNode return_type = {};
+    TSNode parameters = {};
+  };
+
+  bool opensScope(ConstructType type) {
+    return type == ConstructType::Namespace || type == ConstructType::Class || type == ConstructType::Struct;
+  }
+}
+
+StringInterner& QueryExtractor::activeStrings() {
+  if (strings_) {
+    return *strings_;
+  }
+  if (!own_strings_) {
+    own_strings_ = std::make_unique<StringInterner>();
+  }
+  return *own_strings_;
+}
+
+void QueryExtractor::resolveCaptures(const TSQuery* query) {
+  if (roles_query_ == query) return;
+
+  static const std::pair<std::string_view, ConstructType> definition_types[] = {
+    {"function", ConstructType::Function},
+    {"method", ConstructType::Method},
+    {"class", ConstructType::Class},
+    {"struct", ConstructType::Struct},
+    {"enum", ConstructType::Enum},
+    {"variable", ConstructType::Variable},
+    {"namespace", ConstructType::Namespace},
+    {"constructor", ConstructType::Constructor},
+    {"destructor", ConstructType::Destructor},
+  };
+  constexpr std::string_view definition_prefix = "definition.";
+
+  roles_query_ = query;
+  capture_roles_.assign(ts_query_capture_count(query), CaptureInfo{});
+  for (uint32_t id = 0; id < capture_roles_.size(); ++id) {
+    uint32_t length = 0;
+    const char* raw_name = ts_query_capture_name_for_id(query, id, &length);
+    std::string_view name(raw_name, length);
+    CaptureInfo& info = capture_roles_[id];
+
+    if (name == "name") {
+      info.role = CaptureRole::Name;
+    } else if (name == "return_type") {
+      info.role = CaptureRole::ReturnType;
+    } else if (name == "parameters") {
+      info.role = CaptureRole::Parameters;
+    } else if (name == "include") {
+      info.role = CaptureRole::Include;
+    } else if (name.substr(0, definition_prefix.size()) == definition_prefix) {
+      std::string_view kind = name.substr(definition_prefix.size());
+      for (const auto& [type_name, type] : definition_types) {
+        if (kind == type_name) {
+          info.role = CaptureRole::Definition;
+          info.type = type;
+        }
+      }
+      if (info.role == CaptureRole::Ignored) {
+        CLILogger::warning("QueryExtractor: Unknown definition capture @" + std::string(name) + " ignored");
+      }
+    }
+  }
+}
+
+std::vector<CodeConstruct> QueryExtractor::extractConstructs(TSTree* tree, const std::string& content,
+                                                             const std::string& filename, const TSQuery* query) {
+  includes_.clear();
+  std::vector<CodeConstruct> constructs;
+  if (!tree || !query) return constructs;
+
+  resolveCaptures(query);
+  if (!cursor_) {
+    cursor_.reset(ts_query_cursor_new());
+  }
+
+  // Collect one definition per match; a match without a definition capture may still carry an include
+  std::vector<Definition> definitions;
+  ts_query_cursor_exec(cursor_.get(), query, ts_tree_root_node(tree));
+  TSQueryMatch match;
+  while (ts_query_cursor_next_match(cursor_.get(), &match)) {
+    Definition definition{};
+    bool has_definition = false;
+    for (uint16_t i = 0; i < match.capture_count; ++i) {
+      const TSQueryCapture& capture = match.captures[i];
+      const CaptureInfo& info = capture_roles_[capture.index];
+      switch (info.role) {
+        case CaptureRole::Definition:
+          definition.node = capture.node;
+          definition.type = info.type;
+          has_definition = true;
+          break;
+        case CaptureRole::Name:
+          definition.name = capture.node;
+          break;
+        case CaptureRole::ReturnType:
+          definition.return_type = capture.node;
+          break;
+        case CaptureRole::Parameters:
+          definition.parameters = capture.node;
+          break;
+        case CaptureRole::Include: {
+          std::string_view path = nodeText(capture.node, content);
+          if (path.size() >= 2 && (path.front() == '"' || path.front() == '<')) {
+            path = path.substr(1, path.size() - 2);
+          }
+          if (!path.empty()) {
+            includes_.emplace_back(path);
+          }
+          break;
+        }
+        case CaptureRole::Ignored:
+          break;
+      }
+    }
+    if (has_definition && !ts_node_is_null(definition.name)) {
+      definitions.push_back(definition);
+    }
+  }
+
+  // Outer constructs first so enclosing scopes are on the stack before their members
+  std::stable_sort(definitions.begin(), definitions.end(), [](const Definition& a, const Definition& b) {
+    uint32_t a_start = ts_node_start_byte(a.node), b_start = ts_node_start_byte(b.node);
+    if (a_start != b_start) return a_start < b_start;
+    return ts_node_end_byte(a.node) > ts_node_end_byte(b.node);
+  });
+
+  struct Scope {
+    uint32_t end_byte;
+    std::string path;
+  };
+  std::vector<Scope> scopes;
+  StringInterner& strings = activeStrings();
+  std::string_view interned_filename = strings.intern(filename);
+  TSNode previous = {};
+
+  for (const auto& definition : definitions) {
+    // Several patterns may match the same node; the first one wins
+    if (!ts_node_is_null(previous) && ts_node_eq(previous, definition.node)) continue;
+    previous = definition.node;
+
+    uint32_t start_byte = ts_node_start_byte(definition.node);
+    while (!scopes.empty() && scopes.back().end_byte <= start_byte) {
+      scopes.pop_back();
+    }
+    std::string_view enclosing = scopes.empty() ? std::string_view() : std::string_view(scopes.back().path);
+
+    CodeConstruct construct{};
+    construct.type = definition.type;
+    construct.ast_node = definition.node;
+    construct.filename = interned_filename;
+
+    // Qualified names (Outer::name, as in out-of-class definitions) add their qualifier to the enclosing scope
+    std::string_view name_text = nodeText(definition.name, content);
+    std::string namespace_path(enclosing);
+    size_t scope_pos = name_text.rfind("::");
+    if (scope_pos != std::string_view::npos) {
+      std::string_view qualifier = name_text.substr(0, scope_pos);
+      if (qualifier.substr(0, 2) == "::") {
+        namespace_path.clear();
+        qualifier.remove_prefix(2);
+      }
+      if (!namespace_path.empty() && !qualifier.empty()) namespace_path += "::";
+      namespace_path += qualifier;
+      name_text = name_text.substr(scope_pos + 2);
+    }
+    construct.name = std::string(name_text);
+    construct.namespace_path = strings.intern(namespace_path);
+    construct.full_name = namespace_path.empty() ? construct.name : namespace_path + "::" + construct.name;
+
+    if (!ts_node_is_null(definition.return_type)) {
+      construct.return_type = strings.intern(nodeText(definition.return_type, content));
+    }
+    if (!ts_node_is_null(definition.parameters)) {
+      construct.parameters = extractParameters(definition.parameters, content);
+    }
+
+    TSPoint start_point = ts_node_start_point(definition.node);
+    TSPoint end_point = ts_node_end_point(definition.node);
+    construct.start_line = start_point.row + 1;
+    construct.end_line = end_point.row + 1;
+
+    if (opensScope(definition.type)) {
+      scopes.push_back({ts_node_end_byte(definition.node), construct.full_name});
+    }
+    constructs.push_back(std::move(construct));
+  }
+
+  LOG_DEBUG("QueryExtractor::extractConstructs: " + std::to_string(constructs.size()) + " constructs matched in " + filename);
+  int conflicts = ASTExtractor::mergeDuplicateConstructs(constructs, strings);
+  if (conflicts > 0) {
+    CLILogger::warning("Found " + std::to_string(conflicts) + " docstring conflicts during merging");
+  }
+  return constructs;
+}
+
+std::vector<Parameter> QueryExtractor::extractParameters(TSNode parameters, const std::string& content) {
+  std::vector<Parameter> result;
+  StringInterner& strings = activeStrings();
+  uint32_t count = ts_node_named_child_count(parameters);
+  for (uint32_t i = 0; i < count; ++i) {
+    TSNode child = ts_node_named_child(parameters, i);
+    if (std::string_view(ts_node_type(child)) == "comment") continue;
+
+    Parameter param;
+    TSNode type_node = ts_node_child_by_field_name(child, "type", 4);
+    TSNode declarator = ts_node_child_by_field_name(child, "declarator", 10);
+    if (ts_node_is_null(declarator)) {
+      declarator = ts_node_child_by_field_name(child, "name", 4);
+    }
+
+    if (!ts_node_is_null(type_node)) {
+      param.type = strings.intern(nodeText(type_node, content));
+    }
+    if (!ts_node_is_null(declarator)) {
+      // Declarators such as "&key" or "*out" wrap the name; keep only the identifier
+      std::string_view name = nodeText(declarator, content);
+      while (!name.empty() && !isIdentifierChar(name.front())) name.remove_prefix(1);
+      size_t end = 0;
+      while (end < name.size() && isIdentifierChar(name[end])) ++end;
+      param.name = std::string(name.substr(0, end));
+    } else if (ts_node_is_null(type_node)) {
+      // Untyped parameters (e.g. Python) are the name itself
+      param.name = std::string(nodeText(child, content));
+    }
+    result.push_back(std::move(param));
+  }
+  return result;
+}
@@ -0,0 +1,339 @@
+/**
+@brief Search index implementation
+*/
+#include <backend/doc/search_index.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <backend/core/json.h>
+#include <backend/core/mmap.h>
+#include <backend/core/output_writer.h>
+
+namespace {
+  constexpr char kTableMagic[8] = {'C', 'S', 'R', 'C', 'H', 'D', 'O', 'C'};
+  constexpr char kShardMagic[8] = {'C', 'S', 'R', 'C', 'H', 'S', 'H', 'D'};
+
+  uint32_t load32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  void append32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+  }
+
+  void appendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+      out += static_cast<char>((value & 0x7F) | 0x80);
+      value >>= 7;
+    }
+    out += static_cast<char>(value);
+  }
+
+  void appendString(std::string& out, std::string_view text) {
+    appendVarint(out, text.size());
+    out.append(text);
+  }
+
+  // Sequential reader over a document table; every read fails once the data runs out
+  class TableReader {
+    public:
+      explicit TableReader(std::string_view data) : data_(data) {}
+
+      bool varint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && pos_ < data_.size(); shift += 7) {
+          unsigned char byte = static_cast<unsigned char>(data_[pos_++]);
+          value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+          if ((byte & 0x80) == 0) return true;
+        }
+        return false;
+      }
+
+      bool string(std::string& text) {
+        uint64_t length = 0;
+        if (!varint(length) || length > data_.size() - pos_) return false;
+        text.assign(data_.substr(pos_, length));
+        pos_ += length;
+        return true;
+      }
+
+    private:
+      std::string_view data_;
+      size_t pos_ = 0;
+  };
+
+  bool isLower(char c) { return c >= 'a' && c <= 'z'; }
+  bool isUpper(char c) { return c >= 'A' && c <= 'Z'; }
+
+  bool isWordByte(char c) {
+    return isLower(c) || isUpper(c) || (c >= '0' && c <= '9') || c == '_' || static_cast<unsigned char>(c) >= 0x80;
+  }
+
+  bool isStopWord(std::string_view term) {
+    static const std::unordered_set<std::string_view> kStopWords = {
+      "an", "and", "are", "as", "at", "be", "by", "for", "from", "if", "in", "is", "it", "of", "on", "or",
+      "the", "this", "that", "to", "with", "brief", "param", "tparam", "return", "returns", "see", "note"};
+    return kStopWords.count(term) > 0;
+  }
+
+  void addTerm(std::string_view word, std::vector<std::string>& terms) {
+    if (word.size() < 2) return;
+    std::string term(word);
+    for (char& c : term) {
+      if (isUpper(c)) c = static_cast<char>(c - 'A' + 'a');
+    }
+    if (!isStopWord(term)) {
+      terms.push_back(std::move(term));
+    }
+  }
+}
+
+void tokenizeForSearch(std::string_view text, std::vector<std::string>& terms) {
+  size_t i = 0;
+  while (i < text.size()) {
+    if (!isWordByte(text[i])) {
+      ++i;
+      continue;
+    }
+    size_t start = i;
+    while (i < text.size() && isWordByte(text[i])) ++i;
+    std::string_view run = text.substr(start, i - start);
+    while (!run.empty() && run.front() == '_') run.remove_prefix(1);
+    while (!run.empty() && run.back() == '_') run.remove_suffix(1);
+    addTerm(run, terms);
+
+    // Identifier parts: "snake_case", "camelCase" and "HTTPHeader" (an acronym ends before its last capital)
+    size_t part = 0;
+    for (size_t k = 1; k < run.size(); ++k) {
+      if (run[k] == '_') {
+        addTerm(run.substr(part, k - part), terms);
+        part = k + 1;
+      } else if ((isLower(run[k - 1]) && isUpper(run[k])) ||
+                 (isUpper(run[k - 1]) && isUpper(run[k]) && k + 1 < run.size() && isLower(run[k + 1]))) {
+        addTerm(run.substr(part, k - part), terms);
+        part = k;
+      }
+    }
+    if (part > 0) {
+      addTerm(run.substr(part), terms);
+    }
+  }
+}
+
+uint32_t searchShardOf(std::string_view term, uint32_t shard_count) {
+  uint32_t hash = 2166136261u;
+  for (char c : term) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619u;
+  }
+  return hash % std::max<uint32_t>(shard_count, 1);
+}
+
+std::string searchDocumentsPath(const std::string& extract_dir) {
+  return (std::filesystem::path(extract_dir) / ".cesium-search.docs").string();
+}
+
+bool SearchIndex::load(const std::string& path) {
+  documents_.clear();
+  slots_.clear();
+  free_ids_.clear();
+  changed_ = false;
+
+  MappedFile file;
+  if (!file.open(path) || file.size() < 16 || std::memcmp(file.data(), kTableMagic, sizeof(kTableMagic)) != 0 ||
+      load32(file.data() + 8) != kFormatVersion) {
+    return false;
+  }
+
+  // Every document takes at least four bytes (three string lengths and a term count), so a count the rest
+  // of the file cannot hold is corrupt and must not size the allocation
+  uint32_t count = load32(file.data() + 12);
+  if (count > (file.size() - 16) / 4) {
+    return false;
+  }
+  TableReader reader(file.view().substr(16));
+  std::vector<SearchDocument> documents(count);
+  for (auto& document : documents) {
+    uint64_t term_count = 0;
+    if (!reader.string(document.page) || !reader.string(document.title) || !reader.string(document.kind) ||
+        !reader.varint(term_count) || term_count > file.size()) {
+      return false;
+    }
+    document.terms.resize(term_count);
+    for (auto& term : document.terms) {
+      if (!reader.string(term)) return false;
+    }
+  }
+
+  documents_ = std::move(documents);
+  for (uint32_t id = 0; id < documents_.size(); ++id) {
+    if (documents_[id].page.empty()) {
+      free_ids_.push_back(id);
+    } else {
+      slots_.emplace(documents_[id].page, id);
+    }
+  }
+  std::sort(free_ids_.begin(), free_ids_.end(), std::greater<>());
+  return true;
+}
+
+bool SearchIndex::save(const std::string& path) const {
+  std::string bytes(kTableMagic, sizeof(kTableMagic));
+  append32(bytes, kFormatVersion);
+  append32(bytes, static_cast<uint32_t>(documents_.size()));
+  for (const auto& document : documents_) {
+    appendString(bytes, document.page);
+    appendString(bytes, document.title);
+    appendString(bytes, document.kind);
+    appendVarint(bytes, document.terms.size());
+    for (const auto& term : document.terms) {
+      appendString(bytes, term);
+    }
+  }
+
+  std::string temp_path = path + ".tmp";
+  if (!writeWholeFile(temp_path, bytes)) {
+    return false;
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  return true;
+}
+
+void SearchIndex::addPage(const std::string& page, const std::string& kind, const CodeConstruct& construct) {
+  SearchDocument document{page, construct.full_name.empty() ? construct.name : construct.full_name, kind, {}};
+  tokenizeForSearch(document.title, document.terms);
+  if (construct.docstring) {
+    tokenizeForSearch(*construct.docstring, document.terms);
+  }
+  for (const auto& docstring : construct.merged_docstrings) {
+    tokenizeForSearch(docstring, document.terms);
+  }
+  std::sort(document.terms.begin(), document.terms.end());
+  document.terms.erase(std::unique(document.terms.begin(), document.terms.end()), document.terms.end());
+
+  auto slot = slots_.find(page);
+  if (slot != slots_.end()) {
+    SearchDocument& existing = documents_[slot->second];
+    if (existing.title != document.title || existing.kind != document.kind || existing.terms != document.terms) {
+      existing = std::move(document);
+      changed_ = true;
+    }
+    return;
+  }
+
+  // Reusing a removed page's id keeps every other id, and so most shards, unchanged
+  uint32_t id = static_cast<uint32_t>(documents_.size());
+  if (!free_ids_.empty()) {
+    id = free_ids_.back();
+    free_ids_.pop_back();
+    documents_[id] = std::move(document);
+  } else {
+    documents_.push_back(std::move(document));
+  }
+  slots_.emplace(page, id);
+  changed_ = true;
+}
+
+void SearchIndex::retainPages(const std::unordered_set<std::string>& pages) {
+  for (auto slot = slots_.begin(); slot != slots_.end();) {
+    if (pages.count(slot->first) > 0) {
+      ++slot;
+      continue;
+    }
+    documents_[slot->second] = SearchDocument{};
+    free_ids_.push_back(slot->second);
+    slot = slots_.erase(slot);
+    changed_ = true;
+  }
+  std::sort(free_ids_.begin(), free_ids_.end(), std::greater<>());
+}
+
+const SearchDocument* SearchIndex::document(const std::string& page) const {
+  auto slot = slots_.find(page);
+  return slot != slots_.end() ? &documents_[slot->second] : nullptr;
+}
+
+bool SearchIndex::writeShards(const std::string& dir, uint32_t shard_count) {
+  files_written_ = 0;
+  shard_count = std::max<uint32_t>(shard_count, 1);
+  std::error_code ec;
+  std::filesystem::create_directories(dir, ec);
+  if (ec) {
+    return false;
+  }
+
+  bool complete = true;
+  auto put = [&](const std::string& path, const std::string& content) {
+    {
+      MappedFile existing;
+      if (existing.open(path) && existing.view() == content) return;
+    }
+    if (writeWholeFile(path, content)) {
+      files_written_++;
+    } else {
+      complete = false;
+    }
+  };
+
+  std::string docs = "{\"version\":" + std::to_string(kFormatVersion) + ",\"shards\":" + std::to_string(shard_count) +
+                     ",\"documents\":[";
+  for (size_t id = 0; id < documents_.size(); ++id) {
+    const SearchDocument& document = documents_[id];
+    docs += id > 0 ? ",\n" : "\n";
+    if (document.page.empty()) {
+      docs += "null";
+    } else {
+      docs += "[" + quoteJson(document.page) + "," + quoteJson(document.title) + "," + quoteJson(document.kind) + "]";
+    }
+  }
+  docs += "\n]}\n";
+  put((std::filesystem::path(dir) / "docs.json").string(), docs);
+
+  // Documents are visited in id order, so every posting list comes out sorted
+  std::vector<std::unordered_map<std::string_view, std::vector<uint32_t>>> postings(shard_count);
+  for (uint32_t id = 0; id < documents_.size(); ++id) {
+    for (const auto& term : documents_[id].terms) {
+      postings[searchShardOf(term, shard_count)][term].push_back(id);
+    }
+  }
+
+  for (uint32_t shard = 0; shard < shard_count; ++shard) {
+    std::vector<std::string_view> terms;
+    terms.reserve(postings[shard].size());
+    for (const auto& [term, ids] : postings[shard]) {
+      terms.push_back(term);
+    }
+    std::sort(terms.begin(), terms.end());
+
+    std::string bytes(kShardMagic, sizeof(kShardMagic));
+    append32(bytes, kFormatVersion);
+    append32(bytes, static_cast<uint32_t>(terms.size()));
+    for (std::string_view term : terms) {
+      const auto& ids = postings[shard][term];
+      appendString(bytes, term);
+      appendVarint(bytes, ids.size());
+      uint32_t previous = 0;
+      for (uint32_t id : ids) {
+        appendVarint(bytes, id - previous);
+        previous = id;
+      }
+    }
+    put((std::filesystem::path(dir) / ("shard-" + std::to_string(shard) + ".bin")).string(), bytes);
+  }
+
+  // Shards beyond a lowered shard count would otherwise be loaded with stale terms
+  for (uint32_t shard = shard_count;; ++shard) {
+    std::filesystem::path stale = std::filesystem::path(dir) / ("shard-" + std::to_string(shard) + ".bin");
+    if (!std::filesystem::remove(stale, ec)) break;
+  }
+  return complete;
+}
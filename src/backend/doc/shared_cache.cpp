@@ -0,0 +1,108 @@
+/**
+@brief Shared extraction cache implementation
+*/
+#include <backend/doc/shared_cache.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <backend/core/hash.h>
+#include <backend/core/json.h>
+#include <backend/core/output_writer.h>
+#include <backend/doc/construct_stream.h>
+
+SharedExtractionCache::SharedExtractionCache(std::string directory) : directory_(std::move(directory)) {}
+
+std::string SharedExtractionCache::key(std::string_view settings, std::string_view source_path,
+                                       std::string_view content) {
+  // Two differently seeded digests, since a collision would silently document the wrong file
+  std::string key;
+  for (uint64_t seed : {0x63657369756dULL, 0x736861726564ULL}) {
+    hashing::XXH64 hasher(seed);
+    hasher.update(settings);
+    hasher.update("\0", 1);
+    hasher.update(source_path);
+    hasher.update("\0", 1);
+    hasher.update(content);
+    key += hashing::toHex(hasher.digest());
+  }
+  return key;
+}
+
+std::string SharedExtractionCache::entryPath(const std::string& key) const {
+  return (std::filesystem::path(directory_) / key.substr(0, 2) / (key + ".ndjson")).string();
+}
+
+bool SharedExtractionCache::load(const std::string& key, StringInterner& strings,
+                                 std::vector<CodeConstruct>& constructs, std::vector<std::string>& includes) {
+  std::ifstream file(entryPath(key), std::ios::binary);
+  std::string line;
+  if (!file || !std::getline(file, line)) {
+    misses_++;
+    return false;
+  }
+
+  auto header = JsonDoc::parse(line);
+  if (!header || !header->root().isObject() || header->root()["version"].asUint64() != kEntryVersion) {
+    misses_++;
+    return false;
+  }
+  uint64_t count = header->root()["constructs"].asUint64();
+  std::vector<std::string> entry_includes = header->root()["includes"].asStringArray();
+
+  std::vector<CodeConstruct> entry_constructs;
+  entry_constructs.reserve(count);
+  while (entry_constructs.size() < count && std::getline(file, line)) {
+    auto construct = constructFromJson(line, strings);
+    if (!construct) break;
+    entry_constructs.push_back(std::move(*construct));
+  }
+  if (entry_constructs.size() != count) {
+    misses_++;
+    return false;
+  }
+
+  constructs = std::move(entry_constructs);
+  includes = std::move(entry_includes);
+  hits_++;
+  return true;
+}
+
+bool SharedExtractionCache::store(const std::string& key, const std::vector<CodeConstruct>& constructs,
+                                  const std::vector<std::string>& includes) {
+  if (read_only_) {
+    return false;
+  }
+
+  std::string content = "{\"version\":" + std::to_string(kEntryVersion) + ",\"includes\":[";
+  for (size_t i = 0; i < includes.size(); ++i) {
+    if (i > 0) content += ',';
+    content += quoteJson(includes[i]);
+  }
+  content += "],\"constructs\":" + std::to_string(constructs.size()) + "}\n";
+  for (const auto& construct : constructs) {
+    content += constructToJson(construct);
+    content += '\n';
+  }
+
+  std::string path = entryPath(key);
+  std::error_code ec;
+  std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+  if (ec) {
+    return false;
+  }
+
+  // Other runners may store the same key at the same time; each writes its own temporary file
+  std::string temp_path = path + ".tmp" + std::to_string(std::random_device{}()) + "-" +
+                          std::to_string(temp_counter_++);
+  if (!writeWholeFile(temp_path, content)) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  stored_++;
+  return true;
+}
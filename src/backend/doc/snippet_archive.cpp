@@ -0,0 +1,217 @@
+/**
+@brief Snippet archive format implementation
+*/
+#include <backend/doc/snippet_archive.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <backend/core/cli_utils.h>
+
+namespace {
+  constexpr char kMagic[8] = {'C', 'S', 'N', 'I', 'P', 'P', 'A', 'K'};
+  constexpr size_t kHeaderSize = 32;
+  constexpr size_t kEntrySize = 24;
+
+  // Header field offsets
+  constexpr size_t kHeaderVersion = 8;
+  constexpr size_t kHeaderEntryCount = 16;
+  constexpr size_t kHeaderIndexOffset = 24;
+
+  // Index entry field offsets
+  constexpr size_t kEntryDataOffset = 0;
+  constexpr size_t kEntryDataSize = 8;
+  constexpr size_t kEntryNameOffset = 16;
+  constexpr size_t kEntryNameSize = 20;
+
+  uint64_t load64(const unsigned char* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) value = (value << 8) | p[i];
+    return value;
+  }
+
+  uint32_t load32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  void append64(std::string& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+  }
+
+  void append32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+  }
+}
+
+bool parseOutputMode(const std::string& name, OutputMode& mode) {
+  if (name == "files") {
+    mode = OutputMode::Files;
+    return true;
+  }
+  if (name == "archive") {
+    mode = OutputMode::Archive;
+    return true;
+  }
+  return false;
+}
+
+std::string snippetArchivePath(const std::string& extract_dir) {
+  return (std::filesystem::path(extract_dir) / "snippets.pack").string();
+}
+
+bool SnippetArchive::open(const std::string& path) {
+  close();
+  if (!file_.open(path)) {
+    return false;
+  }
+
+  const unsigned char* data = file_.data();
+  size_t size = file_.size();
+  if (size < kHeaderSize || std::memcmp(data, kMagic, sizeof(kMagic)) != 0 ||
+      load32(data + kHeaderVersion) != kFormatVersion) {
+    close();
+    return false;
+  }
+
+  uint64_t entry_count = load64(data + kHeaderEntryCount);
+  uint64_t index_offset = load64(data + kHeaderIndexOffset);
+  if (index_offset < kHeaderSize || index_offset > size || entry_count > (size - index_offset) / kEntrySize) {
+    close();
+    return false;
+  }
+
+  entry_count_ = static_cast<size_t>(entry_count);
+  index_offset_ = static_cast<size_t>(index_offset);
+  names_offset_ = index_offset_ + entry_count_ * kEntrySize;
+  return true;
+}
+
+void SnippetArchive::close() {
+  file_.close();
+  entry_count_ = 0;
+  index_offset_ = 0;
+  names_offset_ = 0;
+}
+
+std::string_view SnippetArchive::nameAt(size_t index) const {
+  if (index >= entry_count_) return {};
+  const unsigned char* entry = file_.data() + index_offset_ + index * kEntrySize;
+  size_t offset = load32(entry + kEntryNameOffset);
+  size_t length = load32(entry + kEntryNameSize);
+  size_t names_size = file_.size() - names_offset_;
+  if (offset > names_size || length > names_size - offset) {
+    return {};
+  }
+  return std::string_view(reinterpret_cast<const char*>(file_.data() + names_offset_ + offset), length);
+}
+
+std::string_view SnippetArchive::contentAt(size_t index) const {
+  if (index >= entry_count_) return {};
+  const unsigned char* entry = file_.data() + index_offset_ + index * kEntrySize;
+  uint64_t offset = load64(entry + kEntryDataOffset);
+  uint64_t length = load64(entry + kEntryDataSize);
+  // Page data lives between the header and the index
+  if (offset < kHeaderSize || offset > index_offset_ || length > index_offset_ - offset) {
+    return {};
+  }
+  return std::string_view(reinterpret_cast<const char*>(file_.data() + offset), static_cast<size_t>(length));
+}
+
+std::optional<size_t> SnippetArchive::indexOf(std::string_view name) const {
+  size_t low = 0;
+  size_t high = entry_count_;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    int order = nameAt(mid).compare(name);
+    if (order == 0) return mid;
+    if (order < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return std::nullopt;
+}
+
+bool writeSnippetArchive(const std::string& path, const std::map<std::string_view, std::string_view>& pages) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  // Pages are streamed straight from the callers' buffers; only the index is built in memory
+  uint64_t data_size = 0;
+  for (const auto& [name, content] : pages) {
+    data_size += content.size();
+  }
+
+  std::string header(kMagic, sizeof(kMagic));
+  append32(header, SnippetArchive::kFormatVersion);
+  append32(header, 0);
+  append64(header, pages.size());
+  append64(header, kHeaderSize + data_size);
+  file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+  std::string index;
+  std::string names;
+  index.reserve(pages.size() * kEntrySize);
+  uint64_t data_offset = kHeaderSize;
+  for (const auto& [name, content] : pages) {
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    append64(index, data_offset);
+    append64(index, content.size());
+    append32(index, static_cast<uint32_t>(names.size()));
+    append32(index, static_cast<uint32_t>(name.size()));
+    names.append(name);
+    data_offset += content.size();
+  }
+
+  file.write(index.data(), static_cast<std::streamsize>(index.size()));
+  file.write(names.data(), static_cast<std::streamsize>(names.size()));
+  file.close();
+  return !file.fail();
+}
+
+bool updateSnippetArchive(const std::string& path,
+                          const std::map<std::string, std::string>& updated,
+                          const std::set<std::string>& removed) {
+  SnippetArchive previous;
+  bool had_previous = std::filesystem::exists(path) && previous.open(path);
+  if (std::filesystem::exists(path) && !had_previous) {
+    CLILogger::warning("updateSnippetArchive: Replacing unreadable snippet archive: " + path);
+  }
+
+  // Views into the old mapping stay valid until it is closed below
+  std::map<std::string_view, std::string_view> pages;
+  for (size_t i = 0; i < previous.size(); ++i) {
+    std::string_view name = previous.nameAt(i);
+    if (removed.find(std::string(name)) == removed.end()) {
+      pages[name] = previous.contentAt(i);
+    }
+  }
+  for (const auto& [name, content] : updated) {
+    pages[name] = content;
+  }
+
+  std::string temp_path = path + ".tmp";
+  if (!writeSnippetArchive(temp_path, pages)) {
+    CLILogger::error("updateSnippetArchive: Failed to write snippet archive: " + temp_path);
+    std::error_code ec;
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+
+  // The old mapping must be released before it can be replaced on Windows
+  previous.close();
+  std::error_code ec;
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    CLILogger::error("updateSnippetArchive: Failed to replace snippet archive '" + path + "': " + ec.message());
+    return false;
+  }
+  return true;
+}
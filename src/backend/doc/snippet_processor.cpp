@@ -0,0 +1,474 @@
+/**
+@brief Snippet processing stage implementation
+*/
+#include <backend/doc/snippet_processor.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <backend/core/cli_utils.h>
+#include <backend/core/fs_scan.h>
+#include <backend/core/hash.h>
+#include <backend/core/json.h>
+#include <backend/core/output_writer.h>
+#include <backend/core/parallel.h>
+
+namespace {
+  constexpr int kManifestVersion = 2;
+  constexpr const char* kNamespaceDir = "namespaces";
+
+  typedef std::map<std::string, std::string> ReferenceMap;  // Code span -> resolved page ("" if unresolved)
+
+  // One snippet as seen by this run
+  struct PageInput {
+    std::string page;            // Page file name
+    std::string stamp;           // "mtime:size" for files, content hash for archived snippets
+    std::string_view archived;   // Archived content, or the page rendered earlier in this run (in_memory)
+    std::string content;         // Snippet content, loaded only when needed (files mode)
+    bool loaded = false;         // content holds the snippet
+    bool in_memory = false;      // archived views a page rendered in this run (files mode)
+    bool changed = true;         // Stamp differs from the manifest
+    SymbolInfo symbol;           // Frontmatter identity (empty name if none)
+    ReferenceMap references;     // Code spans seen when the page was last processed
+  };
+
+  enum PageResult : char { kSkipped, kWritten, kLinked, kFailed };
+
+  std::string fileStamp(const FsEntry& entry) {
+    return std::to_string(entry.mtime_ticks) + ":" + std::to_string(entry.size);
+  }
+
+  bool readWholeFile(const std::string& path, std::string& content) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+      return false;
+    }
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+  }
+
+  // Replace an output; outputs may be hard links to snippets, so never write through one
+  bool replaceFile(const std::string& path, const std::string& content) {
+    return replaceWholeFile(path, content);
+  }
+
+  // Write a generated page only if its content differs from what is on disk
+  PageResult writeIfChanged(const std::string& path, const std::string& content) {
+    std::string existing;
+    if (readWholeFile(path, existing) && existing == content) {
+      return kSkipped;
+    }
+    return replaceFile(path, content) ? kWritten : kFailed;
+  }
+
+  // Hard link an output to its identical snippet, falling back to a copy (e.g. across filesystems)
+  PageResult linkOrCopy(const std::string& source, const std::string& dest) {
+    std::error_code ec;
+    std::filesystem::remove(dest, ec);
+    std::filesystem::create_hard_link(source, dest, ec);
+    if (!ec) {
+      return kLinked;
+    }
+    LOG_DEBUGLOW("SnippetProcessor: Hard link failed (" + ec.message() + "), copying: " + dest);
+    std::filesystem::copy_file(source, dest, std::filesystem::copy_options::overwrite_existing, ec);
+    return ec ? kFailed : kWritten;
+  }
+
+  std::string linkSpans(std::string_view content, const SymbolIndex& index, std::string_view self_page,
+                        std::string_view link_prefix, ReferenceMap* references) {
+    std::string out;
+    out.reserve(content.size() + content.size() / 8);
+    size_t pos = 0;
+
+    // Frontmatter is copied verbatim
+    if (content.substr(0, 4) == "---\n") {
+      size_t end = content.find("\n---\n", 3);
+      if (end != std::string_view::npos) {
+        pos = end + 5;
+        out.append(content.substr(0, pos));
+      }
+    }
+
+    bool in_fence = false;
+    while (pos < content.size()) {
+      size_t eol = content.find('\n', pos);
+      if (eol == std::string_view::npos) eol = content.size();
+      std::string_view line = content.substr(pos, eol - pos);
+      size_t next = eol < content.size() ? eol + 1 : eol;
+
+      if (line.substr(0, 3) == "```") {
+        in_fence = !in_fence;
+      }
+      if (in_fence || line.substr(0, 3) == "```") {
+        out.append(content.substr(pos, next - pos));
+        pos = next;
+        continue;
+      }
+
+      size_t i = 0;
+      while (i < line.size()) {
+        size_t open = line.find('`', i);
+        size_t close = open == std::string_view::npos ? open : line.find('`', open + 1);
+        if (close == std::string_view::npos) {
+          out.append(line.substr(i));
+          break;
+        }
+        out.append(line.substr(i, open - i));
+        std::string_view span = line.substr(open, close - open + 1);
+        std::string_view symbol = span.substr(1, span.size() - 2);
+
+        // A span that is already link text ("[`x`](...)") keeps its link
+        bool link_text = open > 0 && line[open - 1] == '[';
+        const std::string* page = link_text ? nullptr : index.resolve(symbol);
+        if (references && !link_text) {
+          (*references)[std::string(symbol)] = page ? *page : "";
+        }
+        if (page && *page != self_page) {
+          out.append("[").append(span).append("](").append(link_prefix).append(*page).append(")");
+        } else {
+          out.append(span);
+        }
+        i = close + 1;
+      }
+      if (next > eol) out += '\n';
+      pos = next;
+    }
+    return out;
+  }
+
+  // True if any code span recorded for a page would now resolve differently
+  bool referencesMoved(const ReferenceMap& references, const SymbolIndex& index) {
+    for (const auto& [symbol, recorded] : references) {
+      const std::string* page = index.resolve(symbol);
+      if ((page ? *page : std::string()) != recorded) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::string namespacePageName(const std::string& namespace_path) {
+    std::string dotted;
+    for (size_t i = 0; i < namespace_path.size(); ++i) {
+      if (namespace_path.compare(i, 2, "::") == 0) {
+        dotted += '.';
+        ++i;
+      } else {
+        dotted += namespace_path[i];
+      }
+    }
+    return "ns." + dotted + ".md";
+  }
+
+  void appendSymbolTable(std::string& out, const std::vector<const SymbolInfo*>& symbols) {
+    out += "| Symbol | Type |\n";
+    out += "|--------|------|\n";
+    for (const SymbolInfo* symbol : symbols) {
+      out.append("| [`").append(symbol->full_name).append("`](../").append(symbol->page).append(") | ")
+         .append(symbol->type).append(" |\n");
+    }
+  }
+
+  struct ManifestEntry {
+    std::string stamp;
+    SymbolInfo symbol;
+    ReferenceMap references;
+  };
+
+  std::unordered_map<std::string, ManifestEntry> loadManifest(const std::string& path, std::string& fingerprint) {
+    std::unordered_map<std::string, ManifestEntry> entries;
+    if (!std::filesystem::exists(path)) {
+      return entries;
+    }
+    auto manifest_doc = JsonDoc::fromFile(path);
+    if (!manifest_doc || static_cast<const JsonDoc&>(*manifest_doc)["version"].asInt() != kManifestVersion) {
+      CLILogger::warning("SnippetProcessor: Ignoring unreadable manifest, regenerating all pages: " + path);
+      return entries;
+    }
+    const JsonDoc& manifest = *manifest_doc;
+
+    fingerprint = manifest["index_fingerprint"].asString();
+    for (auto [page_key, value] : manifest["pages"].members()) {
+      std::string page(page_key);
+      ManifestEntry& entry = entries[page];
+      entry.stamp = value["stamp"].asString();
+      entry.symbol.page = page;
+      entry.symbol.type = value["type"].asString();
+      entry.symbol.name = value["name"].asString();
+      entry.symbol.full_name = value["full_name"].asString();
+      entry.symbol.namespace_path = value["namespace"].asString();
+      entry.symbol.file = value["file"].asString();
+      entry.symbol.line = static_cast<uint32_t>(value["line"].asUint64());
+      entry.symbol.uses = value["uses"].asStringArray();
+      for (auto [symbol, target] : value["references"].members()) {
+        entry.references[std::string(symbol)] = target.asString();
+      }
+    }
+    return entries;
+  }
+
+  bool writeManifest(const std::string& path, const std::string& fingerprint,
+                     const std::vector<PageInput>& inputs, const std::vector<char>& results) {
+    std::string out = "{\n";
+    out.append("  \"version\": ").append(std::to_string(kManifestVersion)).append(",\n");
+    out.append("  \"index_fingerprint\": ").append(quoteJson(fingerprint)).append(",\n");
+    out += "  \"pages\": {";
+    bool first = true;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      // Failed pages are left out so the next run retries them
+      if (results[i] == kFailed) continue;
+      const PageInput& input = inputs[i];
+      out += first ? "\n" : ",\n";
+      first = false;
+      out.append("    ").append(quoteJson(input.page)).append(": {");
+      out.append("\"stamp\": ").append(quoteJson(input.stamp));
+      out.append(", \"type\": ").append(quoteJson(input.symbol.type));
+      out.append(", \"name\": ").append(quoteJson(input.symbol.name));
+      out.append(", \"full_name\": ").append(quoteJson(input.symbol.full_name));
+      out.append(", \"namespace\": ").append(quoteJson(input.symbol.namespace_path));
+      out.append(", \"file\": ").append(quoteJson(input.symbol.file));
+      out.append(", \"line\": ").append(std::to_string(input.symbol.line));
+      out += ", \"uses\": [";
+      for (size_t u = 0; u < input.symbol.uses.size(); ++u) {
+        out.append(u ? ", " : "").append(quoteJson(input.symbol.uses[u]));
+      }
+      out += "]";
+      out += ", \"references\": {";
+      bool first_reference = true;
+      for (const auto& [symbol, page] : input.references) {
+        out.append(first_reference ? "" : ", ").append(quoteJson(symbol)).append(": ").append(quoteJson(page));
+        first_reference = false;
+      }
+      out += "}}";
+    }
+    out += "\n  }\n}\n";
+
+    std::string temp_path = path + ".tmp";
+    if (!writeWholeFile(temp_path, out)) {
+      return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    return !ec;
+  }
+}
+
+std::string SnippetProcessor::linkReferences(std::string_view content, const SymbolIndex& index,
+                                             std::string_view self_page, std::string_view link_prefix) {
+  return linkSpans(content, index, self_page, link_prefix, nullptr);
+}
+
+std::string SnippetProcessor::manifestPath(const std::string& output_dir) {
+  return (std::filesystem::path(output_dir) / ".cesium-generate.json").string();
+}
+
+bool SnippetProcessor::process(const std::string& extract_dir, const std::string& output_dir) {
+  written_count_ = 0;
+  linked_count_ = 0;
+  unchanged_count_ = 0;
+  removed_count_ = 0;
+  failed_count_ = 0;
+
+  std::error_code ec;
+  std::filesystem::create_directories(std::filesystem::path(output_dir) / kNamespaceDir, ec);
+  if (ec) {
+    CLILogger::error("SnippetProcessor::process: Failed to create output directory '" + output_dir + "': " + ec.message());
+    return false;
+  }
+
+  std::string manifest_path = manifestPath(output_dir);
+  std::string previous_fingerprint;
+  auto previous = loadManifest(manifest_path, previous_fingerprint);
+
+  // Enumerate snippets with a cheap stamp; nothing is read yet in files mode
+  std::vector<PageInput> inputs;
+  SnippetArchive archive;
+  if (output_mode_ == OutputMode::Archive) {
+    if (!archive.open(snippetArchivePath(extract_dir))) {
+      CLILogger::error("SnippetProcessor::process: No readable snippet archive in '" + extract_dir + "'");
+      return false;
+    }
+    inputs.resize(archive.size());
+    for (size_t i = 0; i < archive.size(); ++i) {
+      inputs[i].page = std::string(archive.nameAt(i));
+      inputs[i].archived = archive.contentAt(i);
+      inputs[i].stamp = hashing::hashString(inputs[i].archived);
+    }
+  } else {
+    // Snippets were just written, so list the directory afresh (sizes and times come with the listing)
+    FsSnapshot listing = FsScanner().scan({ScanRoot{extract_dir, false, nullptr}});
+    if (listing.rootStatus(0) != FsSnapshot::RootStatus::Scanned) {
+      CLILogger::error("SnippetProcessor::process: Error iterating extract directory '" + extract_dir + "'");
+      return false;
+    }
+    for (const auto& entry : listing.entries(0)) {
+      std::filesystem::path path(entry.path);
+      if (entry.type == FsEntryType::File && path.extension() == ".md") {
+        PageInput input;
+        input.page = path.filename().string();
+        input.stamp = fileStamp(entry);
+        if (rendered_) {
+          auto rendered = rendered_->find(input.page);
+          if (rendered != rendered_->end()) {
+            input.archived = rendered->second;
+            input.loaded = input.in_memory = true;
+          }
+        }
+        inputs.push_back(std::move(input));
+      }
+    }
+    std::sort(inputs.begin(), inputs.end(), [](const PageInput& a, const PageInput& b) { return a.page < b.page; });
+  }
+
+  // Reuse the recorded identity of unchanged snippets; read and parse only the changed ones
+  auto loadContent = [&](PageInput& input) -> std::string_view {
+    if (output_mode_ == OutputMode::Archive || input.in_memory) return input.archived;
+    if (!input.loaded) {
+      input.loaded = readWholeFile((std::filesystem::path(extract_dir) / input.page).string(), input.content);
+    }
+    return input.content;
+  };
+  size_t workers = parallel::resolveJobCount(jobs_, inputs.size());
+  parallel::forEachIndex(inputs.size(), workers, [&](size_t, size_t i) {
+    PageInput& input = inputs[i];
+    auto recorded = previous.find(input.page);
+    if (recorded != previous.end() && recorded->second.stamp == input.stamp) {
+      input.changed = false;
+      input.symbol = recorded->second.symbol;
+      input.references = recorded->second.references;
+      return;
+    }
+    auto symbol = parseSymbolFrontmatter(input.page, loadContent(input));
+    input.symbol = symbol ? *symbol : SymbolInfo{input.page, "", "", "", "", "", 0, {}};
+  });
+
+  SymbolIndex index;
+  for (const auto& input : inputs) {
+    if (!input.symbol.name.empty()) {
+      index.add(input.symbol);
+    }
+  }
+  std::string fingerprint = index.fingerprint();
+  bool index_changed = fingerprint != previous_fingerprint;
+
+  // Save the symbols next to the cache for lookups by other tools, unless nothing they describe changed
+  std::string index_path = symbolIndexPath(extract_dir);
+  bool symbols_changed = index_changed || inputs.size() != previous.size() ||
+                         !std::filesystem::exists(index_path, ec) ||
+                         std::any_of(inputs.begin(), inputs.end(), [](const PageInput& input) { return input.changed; });
+  if (symbols_changed) {
+    std::vector<SymbolInfo> symbols;
+    symbols.reserve(inputs.size());
+    for (const auto& input : inputs) {
+      if (!input.symbol.name.empty()) symbols.push_back(input.symbol);
+    }
+    if (!writeSymbolIndex(index_path, std::move(symbols))) {
+      CLILogger::warning("SnippetProcessor::process: Failed to write symbol index: " + index_path);
+    }
+  }
+
+  // Redo changed pages, missing outputs, and pages whose references now resolve elsewhere
+  std::vector<char> results(inputs.size(), kSkipped);
+  parallel::forEachIndex(inputs.size(), workers, [&](size_t, size_t i) {
+    PageInput& input = inputs[i];
+    std::string dest = (std::filesystem::path(output_dir) / input.page).string();
+    std::error_code exists_ec;
+    bool redo = input.changed || !std::filesystem::exists(dest, exists_ec) ||
+                (index_changed && referencesMoved(input.references, index));
+    if (!redo) return;
+
+    std::string_view content = loadContent(input);
+    if (output_mode_ == OutputMode::Files && !input.loaded) {
+      CLILogger::error("SnippetProcessor::process: Failed to read snippet: " + input.page);
+      results[i] = kFailed;
+      return;
+    }
+    input.references.clear();
+    std::string page = linkSpans(content, index, input.page, "", &input.references);
+    if (output_mode_ == OutputMode::Files && page == content) {
+      results[i] = linkOrCopy((std::filesystem::path(extract_dir) / input.page).string(), dest);
+    } else {
+      results[i] = replaceFile(dest, page) ? kWritten : kFailed;
+    }
+    if (results[i] == kFailed) {
+      CLILogger::error("SnippetProcessor::process: Failed to write page: " + dest);
+    }
+
+    // The content is not needed past this point
+    std::string().swap(input.content);
+  });
+
+  for (char result : results) {
+    switch (result) {
+      case kSkipped: unchanged_count_++; break;
+      case kWritten: written_count_++; break;
+      case kLinked: linked_count_++; break;
+      default: failed_count_++; break;
+    }
+  }
+
+  // Outputs of snippets that disappeared go with them
+  std::unordered_map<std::string_view, bool> current;
+  for (const auto& input : inputs) current[input.page] = true;
+  for (const auto& [page, entry] : previous) {
+    if (current.find(page) == current.end() &&
+        std::filesystem::remove(std::filesystem::path(output_dir) / page, ec)) {
+      removed_count_++;
+    }
+  }
+
+  // Namespace listings are cheap to render, so they are rebuilt every run and written only on change
+  std::map<std::string, std::vector<const SymbolInfo*>> by_namespace;
+  for (const auto& input : inputs) {
+    if (!input.symbol.name.empty()) {
+      by_namespace[input.symbol.namespace_path].push_back(&input.symbol);
+    }
+  }
+  std::filesystem::path namespace_dir = std::filesystem::path(output_dir) / kNamespaceDir;
+  std::unordered_map<std::string, bool> namespace_pages;
+  std::string listing = "# Namespaces\n\n";
+  for (auto& [namespace_path, symbols] : by_namespace) {
+    std::sort(symbols.begin(), symbols.end(), [](const SymbolInfo* a, const SymbolInfo* b) {
+      return a->full_name < b->full_name;
+    });
+    if (namespace_path.empty()) continue;
+
+    std::string page_name = namespacePageName(namespace_path);
+    std::string page = "---\ntype: namespace\nname: " + namespace_path + "\n---\n\n# " + namespace_path + "\n\n";
+    appendSymbolTable(page, symbols);
+    listing.append("- [`").append(namespace_path).append("`](").append(page_name).append(") (")
+           .append(std::to_string(symbols.size())).append(" symbols)\n");
+    namespace_pages[page_name] = true;
+    if (writeIfChanged((namespace_dir / page_name).string(), page) == kFailed) {
+      CLILogger::error("SnippetProcessor::process: Failed to write namespace page: " + page_name);
+      failed_count_++;
+    }
+  }
+  auto global = by_namespace.find("");
+  if (global != by_namespace.end()) {
+    listing += "\n## Global namespace\n\n";
+    appendSymbolTable(listing, global->second);
+  }
+  if (writeIfChanged((namespace_dir / "index.md").string(), listing) == kFailed) {
+    CLILogger::error("SnippetProcessor::process: Failed to write namespace index");
+    failed_count_++;
+  }
+  for (const auto& entry : std::filesystem::directory_iterator(namespace_dir, ec)) {
+    std::string name = entry.path().filename().string();
+    if (name.rfind("ns.", 0) == 0 && namespace_pages.find(name) == namespace_pages.end()) {
+      std::filesystem::remove(entry.path(), ec);
+    }
+  }
+
+  if (!writeManifest(manifest_path, fingerprint, inputs, results)) {
+    CLILogger::error("SnippetProcessor::process: Failed to write manifest: " + manifest_path);
+    return false;
+  }
+
+  LOG_DEBUG("SnippetProcessor::process: " + std::to_string(written_count_) + " written, " +
+                   std::to_string(linked_count_) + " linked, " + std::to_string(unchanged_count_) + " unchanged, " +
+                   std::to_string(removed_count_) + " removed, " + std::to_string(failed_count_) + " failed");
+  return failed_count_ == 0;
+}
@@ -0,0 +1,82 @@
+/**
+@brief Source file loading implementation
+*/
+#include <backend/doc/source_reader.h>
+#include <cstdio>
+#include <filesystem>
+
+namespace {
+  constexpr size_t kSniffLength = 8192;  // Bytes inspected for NUL bytes
+  constexpr size_t kMarkerLength = 1024; // Bytes searched for generated-code markers
+
+  // Markers code generators put in a file's leading comment
+  constexpr std::string_view kGeneratedMarkers[] = {
+    "@generated",
+    "DO NOT EDIT",
+    "Code generated by",
+    "auto-generated",
+    "autogenerated",
+    "This file is an amalgamation",
+  };
+}
+
+const char* sourceStatusName(SourceStatus status) {
+  switch (status) {
+    case SourceStatus::Loaded: return "loaded";
+    case SourceStatus::Unreadable: return "unreadable";
+    case SourceStatus::TooLarge: return "too large";
+    case SourceStatus::Binary: return "binary";
+    case SourceStatus::Generated: return "generated";
+    case SourceStatus::TimedOut: return "timed out";
+  }
+  return "unknown";
+}
+
+SourceStatus sniffSource(std::string_view head, const SourceLimits& limits) {
+  if (limits.skip_binary && head.substr(0, kSniffLength).find('\0') != std::string_view::npos) {
+    return SourceStatus::Binary;
+  }
+  if (limits.skip_generated) {
+    std::string_view start = head.substr(0, kMarkerLength);
+    for (std::string_view marker : kGeneratedMarkers) {
+      if (start.find(marker) != std::string_view::npos) {
+        return SourceStatus::Generated;
+      }
+    }
+  }
+  return SourceStatus::Loaded;
+}
+
+SourceStatus SourceReader::read(const std::string& path) {
+  buffer_.clear();
+
+  std::error_code ec;
+  uint64_t size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return SourceStatus::Unreadable;
+  }
+  if (limits_.max_file_size > 0 && size > limits_.max_file_size) {
+    return SourceStatus::TooLarge;
+  }
+
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  if (!file) {
+    return SourceStatus::Unreadable;
+  }
+  buffer_.resize(static_cast<size_t>(size));
+  size_t read = size > 0 ? std::fread(buffer_.data(), 1, buffer_.size(), file) : 0;
+  bool failed = std::ferror(file) != 0;
+  std::fclose(file);
+  if (failed) {
+    buffer_.clear();
+    return SourceStatus::Unreadable;
+  }
+  // The file may have shrunk since it was sized
+  buffer_.resize(read);
+
+  SourceStatus status = sniffSource(buffer_, limits_);
+  if (status != SourceStatus::Loaded) {
+    buffer_.clear();
+  }
+  return status;
+}
@@ -0,0 +1,491 @@
+/**
+@brief Symbol index implementation
+*/
+#include <backend/doc/symbol_index.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#include <backend/core/hash.h>
+
+namespace {
+  constexpr char kMagic[8] = {'C', 'S', 'Y', 'M', 'I', 'N', 'D', 'X'};
+  constexpr size_t kHeaderSize = 48;
+  constexpr size_t kSymbolSize = 56;
+  constexpr size_t kNameSize = 4;
+  constexpr size_t kTypeSize = 16;
+  constexpr size_t kUserSize = 4;
+
+  // Header field offsets
+  constexpr size_t kHeaderVersion = 8;
+  constexpr size_t kHeaderSymbolCount = 16;
+  constexpr size_t kHeaderTypeCount = 24;
+  constexpr size_t kHeaderUserCount = 32;
+  constexpr size_t kHeaderStringsSize = 40;
+
+  // Symbol record field offsets
+  constexpr size_t kSymbolPage = 0;
+  constexpr size_t kSymbolType = 8;
+  constexpr size_t kSymbolName = 16;
+  constexpr size_t kSymbolFullName = 24;
+  constexpr size_t kSymbolNamespace = 32;
+  constexpr size_t kSymbolFile = 40;
+  constexpr size_t kSymbolLine = 48;
+
+  // Type table field offsets
+  constexpr size_t kTypeName = 0;
+  constexpr size_t kTypeUsersBegin = 8;
+  constexpr size_t kTypeUsersCount = 12;
+
+  uint64_t load64(const unsigned char* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) value = (value << 8) | p[i];
+    return value;
+  }
+
+  uint32_t load32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  void append64(std::string& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+  }
+
+  void append32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+  }
+
+  // Deduplicating string table builder
+  class StringTable {
+    public:
+      uint64_t intern(std::string_view text) {
+        auto it = refs_.find(text);
+        if (it != refs_.end()) return it->second;
+        uint64_t ref = (static_cast<uint64_t>(bytes_.size()) << 32) | static_cast<uint32_t>(text.size());
+        bytes_.append(text);
+        // Key views point into the symbols being written, which outlive the table
+        refs_.emplace(text, ref);
+        return ref;
+      }
+
+      const std::string& bytes() const { return bytes_; }
+
+    private:
+      std::string bytes_;
+      std::unordered_map<std::string_view, uint64_t> refs_;
+  };
+
+  bool isIdentifierChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+  }
+
+  // Words that can appear in a written type without naming one
+  bool isTypeKeyword(std::string_view word) {
+    static const std::string_view kKeywords[] = {
+      "const", "volatile", "struct", "class", "enum", "union", "typename", "unsigned", "signed",
+      "short", "long", "int", "char", "char8_t", "char16_t", "char32_t", "wchar_t", "bool", "float",
+      "double", "void", "auto", "decltype", "mutable", "constexpr", "static", "inline", "noexcept"};
+    return std::find(std::begin(kKeywords), std::end(kKeywords), word) != std::end(kKeywords);
+  }
+
+  std::string_view stripGlobalScope(std::string_view name) {
+    return name.substr(0, 2) == "::" ? name.substr(2) : name;
+  }
+}
+
+std::optional<SymbolInfo> parseSymbolFrontmatter(std::string_view page, std::string_view content) {
+  if (content.substr(0, 4) != "---\n") {
+    return std::nullopt;
+  }
+
+  SymbolInfo symbol;
+  symbol.page = std::string(page);
+  bool in_parameter_types = false;
+  size_t pos = 4;
+  while (pos < content.size()) {
+    size_t end = content.find('\n', pos);
+    if (end == std::string_view::npos) end = content.size();
+    std::string_view line = content.substr(pos, end - pos);
+    pos = end + 1;
+    if (line == "---") {
+      if (symbol.full_name.empty()) symbol.full_name = symbol.name;
+      if (symbol.name.empty()) return std::nullopt;
+      return symbol;
+    }
+
+    // parameter_types is a YAML list, one "  - <type>" line per parameter
+    if (in_parameter_types && line.substr(0, 4) == "  - ") {
+      collectTypeNames(line.substr(4), symbol.uses);
+      continue;
+    }
+    in_parameter_types = line == "parameter_types:";
+
+    size_t colon = line.find(": ");
+    if (colon == std::string_view::npos) continue;
+    std::string_view key = line.substr(0, colon);
+    std::string value(line.substr(colon + 2));
+    if (key == "type") {
+      symbol.type = std::move(value);
+    } else if (key == "name") {
+      symbol.name = std::move(value);
+    } else if (key == "full_name") {
+      symbol.full_name = std::move(value);
+    } else if (key == "namespace") {
+      symbol.namespace_path = std::move(value);
+    } else if (key == "file") {
+      symbol.file = std::move(value);
+    } else if (key == "start_line") {
+      symbol.line = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+    } else if (key == "return_type") {
+      collectTypeNames(value, symbol.uses);
+    }
+  }
+  return std::nullopt;
+}
+
+void collectTypeNames(std::string_view type, std::vector<std::string>& names) {
+  size_t pos = 0;
+  while (pos < type.size()) {
+    // A name is identifiers joined by "::", optionally starting with "::"
+    size_t start = pos;
+    size_t end = pos;
+    while (end < type.size()) {
+      if (isIdentifierChar(type[end])) {
+        end++;
+      } else if (type.compare(end, 2, "::") == 0) {
+        end += 2;
+      } else {
+        break;
+      }
+    }
+    if (end == start) {
+      pos++;
+      continue;
+    }
+    pos = end;
+
+    std::string_view name = stripGlobalScope(type.substr(start, end - start));
+    while (name.size() >= 2 && name.substr(name.size() - 2) == "::") name.remove_suffix(2);
+    if (name.empty() || (name[0] >= '0' && name[0] <= '9') || isTypeKeyword(name)) {
+      continue;
+    }
+    if (std::find(names.begin(), names.end(), name) == names.end()) {
+      names.emplace_back(name);
+    }
+  }
+}
+
+void SymbolIndex::add(const SymbolInfo& symbol) {
+  // Overloads share a full name; the first page in name order is linked whatever order pages come in
+  auto [page, added] = by_full_name_.emplace(symbol.full_name, symbol.page);
+  if (!added && symbol.page < page->second) {
+    page->second = symbol.page;
+  }
+
+  auto [entry, inserted] = by_name_.emplace(symbol.name, symbol.full_name);
+  if (!inserted && entry->second != symbol.full_name) {
+    entry->second.clear();
+  }
+}
+
+const std::string* SymbolIndex::resolve(std::string_view reference) const {
+  if (reference.substr(0, 2) == "::") reference.remove_prefix(2);
+  if (reference.size() > 2 && reference.substr(reference.size() - 2) == "()") reference.remove_suffix(2);
+  if (reference.empty()) return nullptr;
+
+  auto qualified = by_full_name_.find(reference);
+  if (qualified != by_full_name_.end()) {
+    return &qualified->second;
+  }
+  auto unqualified = by_name_.find(reference);
+  if (unqualified != by_name_.end() && !unqualified->second.empty()) {
+    return &by_full_name_.find(unqualified->second)->second;
+  }
+  return nullptr;
+}
+
+std::string SymbolIndex::fingerprint() const {
+  hashing::XXH64 hasher;
+  for (const auto* names : {&by_full_name_, &by_name_}) {
+    for (const auto& [name, page] : *names) {
+      hasher.update(name.data(), name.size());
+      hasher.update("\0", 1);
+      hasher.update(page.data(), page.size());
+      hasher.update("\n", 1);
+    }
+    hasher.update("\x1e", 1);
+  }
+  return "xxh64:" + hashing::toHex(hasher.digest());
+}
+
+std::string symbolIndexPath(const std::string& extract_dir) {
+  return (std::filesystem::path(extract_dir) / ".cesium-symbols.idx").string();
+}
+
+bool writeSymbolIndex(const std::string& path, std::vector<SymbolInfo> symbols) {
+  // Overloads keep their own records, so ties on the full name are ordered by page
+  std::stable_sort(symbols.begin(), symbols.end(), [](const SymbolInfo& a, const SymbolInfo& b) {
+    return a.full_name != b.full_name ? a.full_name < b.full_name : a.page < b.page;
+  });
+  symbols.erase(std::unique(symbols.begin(), symbols.end(), [](const SymbolInfo& a, const SymbolInfo& b) {
+    return a.full_name == b.full_name && a.page == b.page;
+  }), symbols.end());
+
+  StringTable strings;
+  std::string symbol_bytes;
+  symbol_bytes.reserve(symbols.size() * kSymbolSize);
+  std::map<std::string_view, std::vector<uint32_t>> users;
+  for (size_t i = 0; i < symbols.size(); ++i) {
+    const SymbolInfo& symbol = symbols[i];
+    append64(symbol_bytes, strings.intern(symbol.page));
+    append64(symbol_bytes, strings.intern(symbol.type));
+    append64(symbol_bytes, strings.intern(symbol.name));
+    append64(symbol_bytes, strings.intern(symbol.full_name));
+    append64(symbol_bytes, strings.intern(symbol.namespace_path));
+    append64(symbol_bytes, strings.intern(symbol.file));
+    append32(symbol_bytes, symbol.line);
+    append32(symbol_bytes, 0);
+    for (const auto& type_name : symbol.uses) {
+      users[type_name].push_back(static_cast<uint32_t>(i));
+    }
+  }
+
+  // Ties keep full-name order, so every run of one name is already sorted
+  std::vector<uint32_t> by_name(symbols.size());
+  for (size_t i = 0; i < by_name.size(); ++i) by_name[i] = static_cast<uint32_t>(i);
+  std::stable_sort(by_name.begin(), by_name.end(), [&](uint32_t a, uint32_t b) {
+    return symbols[a].name < symbols[b].name;
+  });
+  std::string name_bytes;
+  name_bytes.reserve(by_name.size() * kNameSize);
+  for (uint32_t index : by_name) {
+    append32(name_bytes, index);
+  }
+
+  std::string type_bytes;
+  std::string user_bytes;
+  uint32_t user_count = 0;
+  for (const auto& [type_name, symbol_numbers] : users) {
+    append64(type_bytes, strings.intern(type_name));
+    append32(type_bytes, user_count);
+    append32(type_bytes, static_cast<uint32_t>(symbol_numbers.size()));
+    for (uint32_t index : symbol_numbers) {
+      append32(user_bytes, index);
+    }
+    user_count += static_cast<uint32_t>(symbol_numbers.size());
+  }
+
+  std::string header(kMagic, sizeof(kMagic));
+  append32(header, SymbolIndexView::kFormatVersion);
+  append32(header, 0);
+  append64(header, symbols.size());
+  append64(header, users.size());
+  append64(header, user_count);
+  append64(header, strings.bytes().size());
+
+  // Readers may have the current index mapped, so write a new file and rename it over the old one
+  std::string temp_path = path + ".tmp";
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return false;
+    }
+    const std::string* sections[] = {&header, &symbol_bytes, &name_bytes, &type_bytes, &user_bytes, &strings.bytes()};
+    for (const std::string* section : sections) {
+      file.write(section->data(), static_cast<std::streamsize>(section->size()));
+    }
+    if (!file) {
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  return true;
+}
+
+bool SymbolIndexView::open(const std::string& path) {
+  close();
+  if (!file_.open(path)) {
+    return false;
+  }
+
+  const unsigned char* data = file_.data();
+  size_t size = file_.size();
+  if (size < kHeaderSize || std::memcmp(data, kMagic, sizeof(kMagic)) != 0 ||
+      load32(data + kHeaderVersion) != kFormatVersion) {
+    close();
+    return false;
+  }
+
+  uint64_t symbol_count = load64(data + kHeaderSymbolCount);
+  uint64_t type_count = load64(data + kHeaderTypeCount);
+  uint64_t user_count = load64(data + kHeaderUserCount);
+  uint64_t strings_size = load64(data + kHeaderStringsSize);
+
+  // Reject counts that cannot fit before doing any offset arithmetic with them
+  if (symbol_count > size / kSymbolSize || type_count > size / kTypeSize || user_count > size / kUserSize ||
+      strings_size > size) {
+    close();
+    return false;
+  }
+  size_t names_offset = kHeaderSize + static_cast<size_t>(symbol_count) * kSymbolSize;
+  size_t types_offset = names_offset + static_cast<size_t>(symbol_count) * kNameSize;
+  size_t users_offset = types_offset + static_cast<size_t>(type_count) * kTypeSize;
+  size_t strings_offset = users_offset + static_cast<size_t>(user_count) * kUserSize;
+  if (strings_offset > size || strings_size > size - strings_offset) {
+    close();
+    return false;
+  }
+
+  symbol_count_ = static_cast<size_t>(symbol_count);
+  type_count_ = static_cast<size_t>(type_count);
+  user_count_ = static_cast<size_t>(user_count);
+  symbols_offset_ = kHeaderSize;
+  names_offset_ = names_offset;
+  types_offset_ = types_offset;
+  users_offset_ = users_offset;
+  strings_offset_ = strings_offset;
+  strings_size_ = static_cast<size_t>(strings_size);
+  return true;
+}
+
+void SymbolIndexView::close() {
+  file_.close();
+  symbol_count_ = 0;
+  type_count_ = 0;
+  user_count_ = 0;
+  strings_size_ = 0;
+}
+
+std::string_view SymbolIndexView::stringAt(uint64_t ref) const {
+  size_t offset = static_cast<size_t>(ref >> 32);
+  size_t length = static_cast<size_t>(ref & 0xFFFFFFFFu);
+  if (offset > strings_size_ || length > strings_size_ - offset) {
+    return {};
+  }
+  return std::string_view(reinterpret_cast<const char*>(file_.data() + strings_offset_ + offset), length);
+}
+
+std::string_view SymbolIndexView::fullNameAt(size_t index) const {
+  return stringAt(load64(file_.data() + symbols_offset_ + index * kSymbolSize + kSymbolFullName));
+}
+
+std::string_view SymbolIndexView::nameAt(size_t index) const {
+  return stringAt(load64(file_.data() + symbols_offset_ + index * kSymbolSize + kSymbolName));
+}
+
+std::string_view SymbolIndexView::typeNameAt(size_t index) const {
+  return stringAt(load64(file_.data() + types_offset_ + index * kTypeSize + kTypeName));
+}
+
+SymbolRecord SymbolIndexView::symbolAt(size_t index) const {
+  SymbolRecord record;
+  if (index >= symbol_count_) return record;
+
+  const unsigned char* p = file_.data() + symbols_offset_ + index * kSymbolSize;
+  record.page = stringAt(load64(p + kSymbolPage));
+  record.type = stringAt(load64(p + kSymbolType));
+  record.name = stringAt(load64(p + kSymbolName));
+  record.full_name = stringAt(load64(p + kSymbolFullName));
+  record.namespace_path = stringAt(load64(p + kSymbolNamespace));
+  record.file = stringAt(load64(p + kSymbolFile));
+  record.line = load32(p + kSymbolLine);
+  return record;
+}
+
+std::optional<size_t> SymbolIndexView::find(std::string_view full_name) const {
+  full_name = stripGlobalScope(full_name);
+  auto [begin, end] = prefixRange(full_name);
+  if (begin < end && fullNameAt(begin) == full_name) {
+    return begin;
+  }
+  return std::nullopt;
+}
+
+std::pair<size_t, size_t> SymbolIndexView::prefixRange(std::string_view prefix) const {
+  // First name not less than the prefix, then the first that no longer starts with it
+  size_t low = 0;
+  size_t high = symbol_count_;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (fullNameAt(mid) < prefix) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  size_t begin = low;
+  high = symbol_count_;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (fullNameAt(mid).substr(0, prefix.size()) == prefix) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return {begin, low};
+}
+
+std::vector<size_t> SymbolIndexView::withName(std::string_view name) const {
+  // Slots hold symbol indices read from the file, so a corrupt one must not index past the symbols
+  auto nameOf = [&](size_t slot) {
+    size_t index = load32(file_.data() + names_offset_ + slot * kNameSize);
+    return index < symbol_count_ ? nameAt(index) : std::string_view();
+  };
+  size_t low = 0;
+  size_t high = symbol_count_;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (nameOf(mid) < name) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  std::vector<size_t> matches;
+  for (size_t slot = low; slot < symbol_count_ && nameOf(slot) == name; ++slot) {
+    size_t index = load32(file_.data() + names_offset_ + slot * kNameSize);
+    if (index < symbol_count_) matches.push_back(index);
+  }
+  return matches;
+}
+
+std::vector<size_t> SymbolIndexView::usersOf(std::string_view type_name) const {
+  type_name = stripGlobalScope(type_name);
+  size_t low = 0;
+  size_t high = type_count_;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (typeNameAt(mid) < type_name) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  std::vector<size_t> users;
+  if (low == type_count_ || typeNameAt(low) != type_name) {
+    return users;
+  }
+  const unsigned char* entry = file_.data() + types_offset_ + low * kTypeSize;
+  size_t begin = load32(entry + kTypeUsersBegin);
+  size_t count = load32(entry + kTypeUsersCount);
+  if (begin <= user_count_ && count <= user_count_ - begin) {
+    users.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      size_t index = load32(file_.data() + users_offset_ + (begin + i) * kUserSize);
+      if (index < symbol_count_) users.push_back(index);
+    }
+  }
+  return users;
+}
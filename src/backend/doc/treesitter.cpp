@@ -2,109 +2,479 @@
 @brief Dynamic Tree-sitter language parser loading implementation
 */
 #include <backend/doc/treesitter.h>
+#include <backend/doc/line_index.h>
+#include <backend/doc/grammar_registry.h>
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
 // #include <iostream>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <backend/core/cli_utils.h>
+#include <backend/core/hash.h>
 
-bool DynamicLanguageLoader::loadLanguage(const std::string& name, const JsonValue& config, const std::string& configFilePath) {
-  CLILogger::debug("DynamicLanguageLoader::loadLanguage: Loading language '" + name + "' from config");
-  
-  std::string lib_path = config["library"].asString();
-  std::string func_name = config["function"].asString();
-  
-  CLILogger::debug("DynamicLanguageLoader::loadLanguage: Library path: '" + lib_path + "', function: '" + func_name + "'");
+#if defined(_WIN32)
+  #include <malloc.h>
+  #define CESIUM_BLOCK_SIZE(block) _msize(block)
+#elif defined(__APPLE__)
+  #include <malloc/malloc.h>
+  #define CESIUM_BLOCK_SIZE(block) malloc_size(block)
+#else
+  #include <malloc.h>
+  #define CESIUM_BLOCK_SIZE(block) malloc_usable_size(block)
+#endif
+
+TSQueryPtr compileQuery(const TSLanguage* language, const std::string& source, const std::string& origin) {
+  uint32_t error_offset = 0;
+  TSQueryError error_type = TSQueryErrorNone;
+  TSQuery* query = ts_query_new(language, source.data(), static_cast<uint32_t>(source.size()), &error_offset, &error_type);
+  if (!query) {
+    static const char* error_names[] = {"none", "syntax", "node type", "field", "capture", "structure", "language"};
+    const char* error_name = static_cast<size_t>(error_type) < std::size(error_names) ? error_names[error_type] : "unknown";
+    CLILogger::error("Invalid query in " + origin + ": " + error_name + " error at offset " + std::to_string(error_offset));
+  }
+  return TSQueryPtr(query);
+}
+
+ParserLease::ParserLease(DynamicLanguageLoader* owner, const TSLanguage* language, TSParser* parser)
+  : owner_(owner), language_(language), parser_(parser) {}
+
+ParserLease::~ParserLease() {
+  release();
+}
+
+ParserLease::ParserLease(ParserLease&& other) noexcept
+  : owner_(other.owner_), language_(other.language_), parser_(other.parser_) {
+  other.owner_ = nullptr;
+  other.parser_ = nullptr;
+}
+
+ParserLease& ParserLease::operator=(ParserLease&& other) noexcept {
+  if (this != &other) {
+    release();
+    owner_ = other.owner_;
+    language_ = other.language_;
+    parser_ = other.parser_;
+    other.owner_ = nullptr;
+    other.parser_ = nullptr;
+  }
+  return *this;
+}
+
+void ParserLease::release() {
+  if (parser_) {
+    if (owner_) {
+      owner_->releaseParser(language_, parser_);
+    } else {
+      ts_parser_delete(parser_);
+    }
+    parser_ = nullptr;
+  }
+}
+
+DynamicLanguageLoader::~DynamicLanguageLoader() {
+  // Parsers reference their language, so they must go before the libraries unload
+  for (auto& [language, parsers] : idle_parsers_) {
+    for (TSParser* parser : parsers) {
+      ts_parser_delete(parser);
+    }
+  }
+}
+
+ParserLease DynamicLanguageLoader::acquireParser(const LanguageInfo& lang_info) {
+  {
+    std::lock_guard<std::mutex> lock(parser_pool_mutex_);
+    auto it = idle_parsers_.find(lang_info.language);
+    if (it != idle_parsers_.end() && !it->second.empty()) {
+      TSParser* parser = it->second.back();
+      it->second.pop_back();
+      return ParserLease(this, lang_info.language, parser);
+    }
+  }
+
+  LOG_DEBUG("DynamicLanguageLoader::acquireParser: Creating new parser for language: " + lang_info.function_name);
+  TSParser* parser = ts_parser_new();
+  if (!parser) {
+    CLILogger::error("DynamicLanguageLoader::acquireParser: Failed to create tree-sitter parser");
+    return {};
+  }
+  if (!ts_parser_set_language(parser, lang_info.language)) {
+    CLILogger::error("DynamicLanguageLoader::acquireParser: Failed to set tree-sitter language: " + lang_info.function_name);
+    ts_parser_delete(parser);
+    return {};
+  }
+  return ParserLease(this, lang_info.language, parser);
+}
+
+void DynamicLanguageLoader::releaseParser(const TSLanguage* language, TSParser* parser) {
+  // Clear any state left behind by an interrupted parse before reuse
+  ts_parser_reset(parser);
+  std::lock_guard<std::mutex> lock(parser_pool_mutex_);
+  idle_parsers_[language].push_back(parser);
+}
+
+bool DynamicLanguageLoader::registerLanguage(const std::string& name, const JsonValue& config, const std::string& configFilePath) {
+  LOG_DEBUG("DynamicLanguageLoader::registerLanguage: Registering language '" + name + "' from config");
+
+  LanguageSpec spec;
+  spec.library = config["library"].asString();
+  spec.function_name = config["function"].asString();
+  spec.config_file_path = configFilePath;
 
   // Validate config has required fields
-  if (lib_path.empty()) {
-    CLILogger::error("DynamicLanguageLoader::loadLanguage: Empty library path for language: " + name);
+  if (spec.library.empty()) {
+    CLILogger::error("DynamicLanguageLoader::registerLanguage: Empty library path for language: " + name);
     return false;
   }
   
-  if (func_name.empty()) {
-    CLILogger::error("DynamicLanguageLoader::loadLanguage: Empty function name for language: " + name);
+  if (spec.function_name.empty()) {
+    CLILogger::error("DynamicLanguageLoader::registerLanguage: Empty function name for language: " + name);
     return false;
   }
 
-  // Try to load the library using config-based search strategy
-  CLILogger::debug("DynamicLanguageLoader::loadLanguage: Attempting to load library for language: " + name);
-  dynlib::DynLib lib = dynlib::loadDynLibFromConfig(lib_path, configFilePath);
-  if (!lib.isValid()) {
-    CLILogger::error("Failed to load " + lib_path + ": " + dynlib::getLastDynLibError());
-    CLILogger::debug("DynamicLanguageLoader::loadLanguage: Library loading failed for language: " + name);
-    return false;
+  // Extract and validate extensions array
+  spec.extensions = config["extensions"].asStringArray();
+  if (spec.extensions.empty()) {
+    CLILogger::warning("DynamicLanguageLoader::registerLanguage: No extensions specified for language: " + name);
+  } else {
+    LOG_DEBUG("DynamicLanguageLoader::registerLanguage: Extensions for " + name + ": " + std::to_string(spec.extensions.size()) + " extensions");
   }
   
-  CLILogger::debug("DynamicLanguageLoader::loadLanguage: Successfully loaded library: " + lib.getPath());
-
-  // Get the language function
-  CLILogger::debug("DynamicLanguageLoader::loadLanguage: Looking up tree-sitter function: " + func_name);
-  auto lang_func = lib.getFunc<TSLanguage*(*)()>(func_name);
-  if (!lang_func) {
-    CLILogger::error("Failed to find function " + func_name + " in " + lib.getPath());
-    CLILogger::debug("DynamicLanguageLoader::loadLanguage: Function lookup failed for language: " + name);
-    return false;
+  spec.docstring_style = config["docstring_style"].asString();
+  JsonValue window = config["docstring_window"];
+  if (window.isInt() && window.asInt() >= 0) {
+    spec.docstring_window = static_cast<uint32_t>(window.asInt());
+  }
+
+  std::string query_path = config["query"].asString();
+  if (!query_path.empty()) {
+    std::filesystem::path resolved = query_path;
+    if (resolved.is_relative() && !configFilePath.empty()) {
+      resolved = std::filesystem::path(configFilePath).parent_path() / resolved;
+    }
+    spec.query_path = resolved.string();
+  }
+
+  JsonValue builtin = config["builtin"];
+  if (builtin.isBool()) {
+    spec.allow_builtin = builtin.asBool();
   }
-  
-  CLILogger::debug("DynamicLanguageLoader::loadLanguage: Successfully found function: " + func_name);
 
-  // Call the language function to get the TSLanguage*
-  CLILogger::debug("DynamicLanguageLoader::loadLanguage: Calling tree-sitter language function: " + func_name);
-  TSLanguage* ts_language = lang_func();
-  if (!ts_language) {
-    CLILogger::error("DynamicLanguageLoader::loadLanguage: Language function '" + func_name + "' returned null");
+  std::lock_guard<std::mutex> lock(load_mutex_);
+  registered_languages_[name] = std::move(spec);
+  rebuildExtensionIndex();
+  return true;
+}
+
+bool DynamicLanguageLoader::loadLanguage(const std::string& name, const JsonValue& config, const std::string& configFilePath) {
+  if (!registerLanguage(name, config, configFilePath)) {
     return false;
   }
-  
-  CLILogger::debug("DynamicLanguageLoader::loadLanguage: Successfully created tree-sitter language object");
+  std::lock_guard<std::mutex> lock(load_mutex_);
+  return ensureLoaded(*registered_languages_.find(name)) != nullptr;
+}
 
-  // Extract and validate extensions array
-  std::vector<std::string> extensions = config["extensions"].asStringArray();
-  if (extensions.empty()) {
-    CLILogger::warning("DynamicLanguageLoader::loadLanguage: No extensions specified for language: " + name);
+const LanguageInfo* DynamicLanguageLoader::ensureLoaded(std::pair<const std::string, LanguageSpec>& language) {
+  const std::string& name = language.first;
+  LanguageSpec& spec = language.second;
+  auto loaded = loaded_languages_.find(name);
+  if (loaded != loaded_languages_.end()) {
+    return &loaded->second;
+  }
+  if (spec.failed) {
+    return nullptr;
+  }
+  spec.failed = true;  // Until it succeeds, so a broken grammar is reported once
+
+  // A grammar linked into the binary needs no library search
+  dynlib::DynLib lib;
+  const TSLanguage* ts_language = spec.allow_builtin ? findBuiltinGrammar(spec.function_name) : nullptr;
+  if (ts_language) {
+    LOG_DEBUG("DynamicLanguageLoader::ensureLoaded: Using built-in grammar " + spec.function_name + " for language: " + name);
   } else {
-    CLILogger::debug("DynamicLanguageLoader::loadLanguage: Extensions for " + name + ": " + std::to_string(extensions.size()) + " extensions");
+    // Try to load the library using config-based search strategy
+    LOG_DEBUG("DynamicLanguageLoader::ensureLoaded: Attempting to load library '" + spec.library + "' for language: " + name);
+    lib = dynlib::loadDynLibFromConfig(spec.library, spec.config_file_path);
+    if (!lib.isValid()) {
+      CLILogger::error("Failed to load " + spec.library + ": " + dynlib::getLastDynLibError());
+      return nullptr;
+    }
+    
+    LOG_DEBUG("DynamicLanguageLoader::ensureLoaded: Successfully loaded library: " + lib.getPath());
+
+    // Get the language function
+    auto lang_func = lib.getFunc<const TSLanguage*(*)()>(spec.function_name);
+    if (!lang_func) {
+      CLILogger::error("Failed to find function " + spec.function_name + " in " + lib.getPath());
+      return nullptr;
+    }
+
+    // Call the language function to get the TSLanguage*
+    ts_language = lang_func();
+    if (!ts_language) {
+      CLILogger::error("DynamicLanguageLoader::ensureLoaded: Language function '" + spec.function_name + "' returned null");
+      return nullptr;
+    }
+  }
+
+  // Compile the optional construct query once; files of this language share it
+  TSQueryPtr query;
+  std::string query_text;
+  if (!spec.query_path.empty()) {
+    std::ifstream query_file(spec.query_path, std::ios::binary);
+    if (!query_file) {
+      CLILogger::error("Failed to read query file " + spec.query_path + " for language: " + name);
+    } else {
+      std::ostringstream query_source;
+      query_source << query_file.rdbuf();
+      query_text = query_source.str();
+      query = compileQuery(ts_language, query_text, spec.query_path);
+      if (query) {
+        LOG_DEBUG("DynamicLanguageLoader::ensureLoaded: Compiled query " + spec.query_path + " (" + std::to_string(ts_query_pattern_count(query.get())) + " patterns)");
+      }
+    }
   }
-  
-  std::string docstring_style = config["docstring_style"].asString();
-  CLILogger::debug("DynamicLanguageLoader::loadLanguage: Docstring style: '" + docstring_style + "'");
+
+  // Anything that changes the trees or the query changes the fingerprint; shared caches key on it
+  std::string grammar_identity = spec.function_name + "\n" + std::to_string(ts_language_abi_version(ts_language)) + "\n" +
+                                 std::to_string(ts_language_symbol_count(ts_language)) + "\n" +
+                                 std::to_string(ts_language_state_count(ts_language)) + "\n" + query_text;
 
   // Create language info and move the library into it
   LanguageInfo info{
     .library = std::move(lib),
     .language = ts_language,
-    .extensions = extensions,
-    .docstring_style = docstring_style,
-    .function_name = func_name
+    .extensions = spec.extensions,
+    .docstring_style = spec.docstring_style,
+    .docstring_window = spec.docstring_window,
+    .function_name = spec.function_name,
+    .query = std::move(query),
+    .grammar_fingerprint = hashing::hashString(grammar_identity)
   };
 
-  loaded_languages_[name] = std::move(info);
-  CLILogger::debug("DynamicLanguageLoader::loadLanguage: Successfully loaded and registered language: " + name);
-  return true;
+  spec.failed = false;
+  auto inserted = loaded_languages_.emplace(name, std::move(info)).first;
+  LOG_DEBUG("DynamicLanguageLoader::ensureLoaded: Loaded language on first use: " + name);
+  return &inserted->second;
 }
 
-std::pair<std::string, const LanguageInfo*> DynamicLanguageLoader::getLanguageForFile(const std::string& filename) {
-  std::string ext = std::filesystem::path(filename).extension().string();
-  CLILogger::debug("DynamicLanguageLoader::getLanguageForFile: Looking for language for file: " + filename + " (extension: '" + ext + "')");
-
-  if (ext.empty()) {
-    CLILogger::debug("DynamicLanguageLoader::getLanguageForFile: File has no extension, cannot match language");
-    return {"", nullptr};
+void DynamicLanguageLoader::rebuildExtensionIndex() {
+  languages_by_extension_.clear();
+  for (auto& language : registered_languages_) {
+    for (const auto& ext : language.second.extensions) {
+      languages_by_extension_.emplace(ext, &language);
+    }
   }
+}
 
-  for (const auto& [name, info] : loaded_languages_) {
-    CLILogger::debug("DynamicLanguageLoader::getLanguageForFile: Checking language '" + name + "' with " + std::to_string(info.extensions.size()) + " extensions");
-    
-    if (std::find(info.extensions.begin(), info.extensions.end(), ext) != info.extensions.end()) {
-      CLILogger::debug("DynamicLanguageLoader::getLanguageForFile: Found matching language '" + name + "' for extension '" + ext + "'");
-      return {name, &info};
+std::pair<std::string, const LanguageInfo*> DynamicLanguageLoader::getLanguageForFile(const std::string& filename) {
+  size_t name_start = filename.find_last_of("/\\");
+  name_start = name_start == std::string::npos ? 0 : name_start + 1;
+
+  // Leftmost dot first so the longest suffix wins; a leading dot (".clang-format") is part of the name
+  std::lock_guard<std::mutex> lock(load_mutex_);
+  for (size_t dot = filename.find('.', name_start + 1); dot != std::string::npos; dot = filename.find('.', dot + 1)) {
+    auto found = languages_by_extension_.find(filename.substr(dot));
+    if (found == languages_by_extension_.end()) continue;
+    if (const LanguageInfo* info = ensureLoaded(*found->second)) {
+      return {found->second->first, info};
     }
   }
-  
-  CLILogger::debug("DynamicLanguageLoader::getLanguageForFile: No language found for extension '" + ext + "' (checked " + std::to_string(loaded_languages_.size()) + " languages)");
+
+  LOG_DEBUGLOW("DynamicLanguageLoader::getLanguageForFile: No language for file: " + filename);
   return {"", nullptr};
 }
 
 const std::map<std::string, LanguageInfo>& DynamicLanguageLoader::getLoadedLanguages() const {
   return loaded_languages_;
 }
+
+IncrementalParseCache::~IncrementalParseCache() {
+  clear();
+}
+
+TSInputEdit IncrementalParseCache::computeEdit(const std::string& old_content, const std::string& new_content) {
+  size_t max_common = std::min(old_content.size(), new_content.size());
+
+  size_t prefix = 0;
+  while (prefix < max_common && old_content[prefix] == new_content[prefix]) {
+    prefix++;
+  }
+
+  size_t suffix = 0;
+  while (suffix < max_common - prefix &&
+         old_content[old_content.size() - 1 - suffix] == new_content[new_content.size() - 1 - suffix]) {
+    suffix++;
+  }
+
+  TSInputEdit edit;
+  edit.start_byte = static_cast<uint32_t>(prefix);
+  edit.old_end_byte = static_cast<uint32_t>(old_content.size() - suffix);
+  edit.new_end_byte = static_cast<uint32_t>(new_content.size() - suffix);
+
+  LineIndex old_lines(old_content);
+  LineIndex new_lines(new_content);
+  edit.start_point = old_lines.pointAt(edit.start_byte);
+  edit.old_end_point = old_lines.pointAt(edit.old_end_byte);
+  edit.new_end_point = new_lines.pointAt(edit.new_end_byte);
+  return edit;
+}
+
+TSTree* parseWithDeadline(TSParser* parser, const TSTree* old_tree, const std::string& content,
+                          std::chrono::steady_clock::time_point deadline) {
+  if (deadline == std::chrono::steady_clock::time_point::max()) {
+    return ts_parser_parse_string(parser, old_tree, content.c_str(), static_cast<uint32_t>(content.length()));
+  }
+
+  // The whole remaining text is handed over at once, as ts_parser_parse_string does
+  TSInput input{
+    const_cast<std::string*>(&content),
+    [](void* payload, uint32_t byte_index, TSPoint, uint32_t* bytes_read) -> const char* {
+      const std::string& text = *static_cast<const std::string*>(payload);
+      if (byte_index >= text.size()) {
+        *bytes_read = 0;
+        return "";
+      }
+      *bytes_read = static_cast<uint32_t>(text.size() - byte_index);
+      return text.data() + byte_index;
+    },
+    TSInputEncodingUTF8,
+    nullptr
+  };
+  TSParseOptions options{
+    &deadline,
+    [](TSParseState* state) {
+      return std::chrono::steady_clock::now() >= *static_cast<std::chrono::steady_clock::time_point*>(state->payload);
+    }
+  };
+  TSTree* tree = ts_parser_parse_with_options(parser, old_tree, input, options);
+  if (!tree) {
+    // A stopped parse would otherwise be resumed by the next file this pooled parser sees
+    ts_parser_reset(parser);
+  }
+  return tree;
+}
+
+namespace {
+  // Signed, since a block may be freed by a different worker than the one that allocated it
+  thread_local int64_t t_live_bytes = 0;
+  thread_local int64_t t_peak_bytes = 0;
+  thread_local int64_t t_baseline_bytes = 0;
+  std::atomic<bool> g_counting_installed{false};
+
+  void* counted(void* block) {
+    if (block) {
+      t_live_bytes += static_cast<int64_t>(CESIUM_BLOCK_SIZE(block));
+      t_peak_bytes = std::max(t_peak_bytes, t_live_bytes);
+    }
+    return block;
+  }
+
+  void* countingMalloc(size_t size) {
+    return counted(std::malloc(size));
+  }
+
+  void* countingCalloc(size_t count, size_t size) {
+    return counted(std::calloc(count, size));
+  }
+
+  void* countingRealloc(void* block, size_t size) {
+    int64_t old_size = block ? static_cast<int64_t>(CESIUM_BLOCK_SIZE(block)) : 0;
+    void* resized = std::realloc(block, size);
+    if (!resized) {
+      return nullptr;
+    }
+    t_live_bytes -= old_size;
+    return counted(resized);
+  }
+
+  void countingFree(void* block) {
+    if (block) {
+      t_live_bytes -= static_cast<int64_t>(CESIUM_BLOCK_SIZE(block));
+      std::free(block);
+    }
+  }
+}
+
+void parser_memory::install() {
+  if (!g_counting_installed.exchange(true)) {
+    ts_set_allocator(countingMalloc, countingCalloc, countingRealloc, countingFree);
+  }
+}
+
+bool parser_memory::installed() {
+  return g_counting_installed.load();
+}
+
+void parser_memory::resetPeak() {
+  t_baseline_bytes = t_live_bytes;
+  t_peak_bytes = t_live_bytes;
+}
+
+uint64_t parser_memory::peak() {
+  return static_cast<uint64_t>(std::max<int64_t>(0, t_peak_bytes - t_baseline_bytes));
+}
+
+TSTree* IncrementalParseCache::parse(TSParser* parser, const std::string& filepath,
+                                     const TSLanguage* language, const std::string& content,
+                                     std::chrono::steady_clock::time_point deadline) {
+  // Take the previous entry out of the map; a file is only parsed by one worker at a time
+  TSTree* old_tree = nullptr;
+  std::string old_content;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(filepath);
+    if (it != entries_.end()) {
+      if (it->second.language == language) {
+        old_tree = it->second.tree;
+        old_content = std::move(it->second.content);
+      } else {
+        ts_tree_delete(it->second.tree);
+      }
+      entries_.erase(it);
+    }
+  }
+
+  TSTree* tree = nullptr;
+  if (old_tree && old_content == content) {
+    LOG_DEBUGLOW("IncrementalParseCache::parse: Content unchanged, reusing tree for " + filepath);
+    tree = ts_tree_copy(old_tree);
+  } else if (old_tree) {
+    TSInputEdit edit = computeEdit(old_content, content);
+    LOG_DEBUGLOW("IncrementalParseCache::parse: Reparsing " + filepath + " incrementally (edit at byte " +
+                        std::to_string(edit.start_byte) + ", " + std::to_string(edit.old_end_byte - edit.start_byte) +
+                        " -> " + std::to_string(edit.new_end_byte - edit.start_byte) + " bytes)");
+    ts_tree_edit(old_tree, &edit);
+    tree = parseWithDeadline(parser, old_tree, content, deadline);
+  } else {
+    tree = parseWithDeadline(parser, nullptr, content, deadline);
+  }
+
+  if (old_tree) {
+    ts_tree_delete(old_tree);
+  }
+
+  if (tree) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[filepath] = Entry{language, content, ts_tree_copy(tree)};
+  }
+  return tree;
+}
+
+void IncrementalParseCache::forget(const std::string& filepath) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(filepath);
+  if (it != entries_.end()) {
+    ts_tree_delete(it->second.tree);
+    entries_.erase(it);
+  }
+}
+
+void IncrementalParseCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [path, entry] : entries_) {
+    ts_tree_delete(entry.tree);
+  }
+  entries_.clear();
+}
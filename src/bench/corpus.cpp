@@ -0,0 +1,195 @@
+/**
+@brief Synthetic corpus generation and loading of on-disk corpora
+*/
+#include "corpus.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace {
+  const char* const kNouns[] = {"buffer", "index", "graph", "token", "stream", "cache", "node", "frame",
+                                "packet", "record", "matrix", "vector", "queue", "table", "shape", "parser"};
+  const char* const kTypes[] = {"int", "size_t", "double", "bool", "std::string", "uint32_t",
+                                "std::vector<int>", "const std::string&", "float", "int64_t"};
+
+  class SourceWriter {
+    public:
+      explicit SourceWriter(uint32_t seed) : random_(seed) {}
+
+      std::string file(size_t index) {
+        out_.str("");
+        out_ << "/**\n@brief Generated benchmark header " << index << "\n*/\n#pragma once\n\n";
+        out_ << "#include <string>\n#include <vector>\n#include <cstdint>\n\n";
+        size_t namespaces = 1 + pick(2);
+        for (size_t n = 0; n < namespaces; ++n) {
+          out_ << "namespace " << noun() << "_" << index << "_" << n << " {\n\n";
+          size_t items = 4 + pick(8);
+          for (size_t i = 0; i < items; ++i) {
+            switch (pick(10)) {
+              case 0: case 1: case 2: case 3: writeClass(i); break;
+              case 4: case 5: writeFunction(i, true); break;
+              case 6: writeFunction(i, false); break;
+              case 7: writeTemplate(i); break;
+              case 8: writeEnum(i); break;
+              default: writeStruct(i); break;
+            }
+          }
+          out_ << "}  // namespace\n\n";
+        }
+        return out_.str();
+      }
+
+    private:
+      std::mt19937 random_;
+      std::ostringstream out_;
+
+      size_t pick(size_t n) { return std::uniform_int_distribution<size_t>(0, n - 1)(random_); }
+      const char* noun() { return kNouns[pick(std::size(kNouns))]; }
+      const char* type() { return kTypes[pick(std::size(kTypes))]; }
+
+      void docComment(const std::string& indent, size_t params, bool returns = true) {
+        out_ << indent << "/**\n" << indent << "@brief Does something useful with the " << noun()
+             << " and the " << noun() << "\n";
+        if (pick(2)) {
+          out_ << indent << "\n" << indent << "Longer description explaining how the " << noun()
+               << " interacts with each " << noun() << " and why it matters.\n";
+        }
+        for (size_t p = 0; p < params; ++p) {
+          out_ << indent << "@param arg" << p << " The " << noun() << " to use\n";
+        }
+        if (returns) {
+          out_ << indent << "@return Resulting " << noun() << "\n";
+        }
+        out_ << indent << "*/\n";
+      }
+
+      void parameters(size_t params) {
+        out_ << "(";
+        for (size_t p = 0; p < params; ++p) {
+          out_ << (p ? ", " : "") << type() << " arg" << p;
+        }
+        out_ << ")";
+      }
+
+      void writeFunction(size_t i, bool documented) {
+        size_t params = pick(4);
+        if (documented) docComment("", params);
+        out_ << type() << " " << noun() << "Function" << i;
+        parameters(params);
+        out_ << (pick(2) ? ";\n\n" : " {\n  return {};\n}\n\n");
+      }
+
+      void writeClass(size_t i) {
+        docComment("", 0, false);
+        std::string name = std::string(noun()) + "Class" + std::to_string(i);
+        name[0] = static_cast<char>(name[0] - 'a' + 'A');
+        out_ << "class " << name << " {\n  public:\n";
+        size_t methods = 2 + pick(8);
+        for (size_t m = 0; m < methods; ++m) {
+          size_t params = pick(3);
+          if (pick(4)) docComment("    ", params);
+          out_ << "    " << (pick(5) == 0 ? "virtual " : "") << type() << " " << noun() << m;
+          parameters(params);
+          out_ << (pick(3) ? " const;\n" : ";\n");
+        }
+        out_ << "\n  private:\n";
+        size_t fields = 1 + pick(4);
+        for (size_t f = 0; f < fields; ++f) {
+          out_ << "    " << type() << " " << noun() << f << "_;  ///< Field " << f << "\n";
+        }
+        out_ << "};\n\n";
+      }
+
+      void writeStruct(size_t i) {
+        docComment("", 0, false);
+        out_ << "struct " << noun() << "Struct" << i << " {\n";
+        size_t fields = 2 + pick(5);
+        for (size_t f = 0; f < fields; ++f) {
+          out_ << "  " << type() << " " << noun() << f << ";\n";
+        }
+        out_ << "};\n\n";
+      }
+
+      void writeTemplate(size_t i) {
+        docComment("", 1);
+        out_ << "template <typename T>\nT " << noun() << "Template" << i << "(const T& arg0) {\n  return arg0;\n}\n\n";
+      }
+
+      void writeEnum(size_t i) {
+        docComment("", 0, false);
+        out_ << "enum class " << noun() << "Kind" << i << " {\n";
+        size_t values = 2 + pick(6);
+        for (size_t v = 0; v < values; ++v) {
+          out_ << "  Value" << v << (v + 1 < values ? ",\n" : "\n");
+        }
+        out_ << "};\n\n";
+      }
+  };
+
+  bool isSourceFile(const std::filesystem::path& path) {
+    std::string extension = path.extension().string();
+    return extension == ".h" || extension == ".hpp" || extension == ".hh" || extension == ".hxx" ||
+           extension == ".cpp" || extension == ".cc" || extension == ".cxx" || extension == ".ipp";
+  }
+
+  bool readFile(const std::string& path, std::string& content) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    content = buffer.str();
+    return true;
+  }
+}
+
+size_t Corpus::bytes() const {
+  size_t total = 0;
+  for (const auto& file : files) {
+    total += file.content.size();
+  }
+  return total;
+}
+
+Corpus generateSyntheticCorpus(const std::string& root, size_t file_count, uint32_t seed) {
+  Corpus corpus;
+  corpus.name = "synthetic";
+  std::error_code ec;
+  std::filesystem::remove_all(root, ec);
+  std::filesystem::create_directories(root, ec);
+
+  SourceWriter writer(seed);
+  for (size_t i = 0; i < file_count; ++i) {
+    CorpusFile file;
+    file.path = (std::filesystem::path(root) / ("bench_" + std::to_string(i) + ".h")).string();
+    file.content = writer.file(i);
+    std::ofstream out(file.path, std::ios::binary);
+    out << file.content;
+    corpus.files.push_back(std::move(file));
+  }
+  return corpus;
+}
+
+Corpus loadCorpus(const std::string& name, const std::vector<std::string>& roots) {
+  Corpus corpus;
+  corpus.name = name;
+  for (const auto& root : roots) {
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(root, ec)) {
+      CorpusFile file{root, {}};
+      if (readFile(root, file.content)) corpus.files.push_back(std::move(file));
+      continue;
+    }
+    for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+      if (it->is_regular_file(ec) && isSourceFile(it->path())) {
+        CorpusFile file{it->path().string(), {}};
+        if (readFile(file.path, file.content)) corpus.files.push_back(std::move(file));
+      }
+    }
+  }
+  std::sort(corpus.files.begin(), corpus.files.end(),
+            [](const CorpusFile& a, const CorpusFile& b) { return a.path < b.path; });
+  return corpus;
+}
@@ -0,0 +1,52 @@
+/**
+@brief Source corpora for the extraction benchmarks
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+@brief A source file held in memory (and present on disk at path)
+*/
+struct CorpusFile {
+  std::string path;      ///< Path on disk
+  std::string content;   ///< File contents
+};
+
+/**
+@brief A set of source files benchmarked together
+*/
+struct Corpus {
+  std::string name;               ///< Label used in reports
+  std::vector<CorpusFile> files;  ///< Files in a stable (sorted) order
+
+  /**
+  @brief Total bytes across all files
+  */
+  size_t bytes() const;
+};
+
+/**
+@brief Generate a deterministic C++ corpus and write it below a directory
+
+Files mix namespaces, documented classes with methods and fields, free
+functions, templates, enums and undocumented code in roughly the proportions
+of a typical library header. The same seed always produces the same bytes,
+so numbers from different builds are comparable.
+
+@param root Directory the files are written to (recreated)
+@param file_count Number of files to generate
+@param seed Generator seed
+@return The generated corpus
+*/
+Corpus generateSyntheticCorpus(const std::string& root, size_t file_count, uint32_t seed = 1);
+
+/**
+@brief Load every C/C++ source below the given directories
+@param name Label used in reports
+@param roots Directories (or files) to load
+@return The loaded corpus (empty if nothing matched)
+*/
+Corpus loadCorpus(const std::string& name, const std::vector<std::string>& roots);
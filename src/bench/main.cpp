@@ -0,0 +1,254 @@
+/**
+@brief Throughput benchmarks for the documentation extraction pipeline
+
+Runs each stage over a generated corpus and one or more real source trees
+and reports the median of several timed repetitions (after one warm-up run)
+in MB/s and files/s.
+*/
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <backend/core/arena.h>
+#include <backend/core/json.h>
+#include <backend/doc/cache.h>
+#include <backend/doc/cpp/ast_extractor.h>
+#include <backend/doc/cpp/docstrings.h>
+#include <backend/doc/markdowngen.h>
+#include "corpus.h"
+
+extern "C" const TSLanguage* tree_sitter_cpp(void);
+
+namespace {
+  struct BenchOptions {
+    size_t synthetic_files = 300;        // Files in the generated corpus
+    size_t repeat = 5;                   // Timed repetitions per benchmark
+    std::vector<std::string> corpora;    // Real-world corpus directories
+    std::string json_path;               // Optional machine-readable results
+    std::string work_dir;                // Scratch space for generated files and outputs
+  };
+
+  struct BenchResult {
+    std::string corpus;
+    std::string bench;
+    double median_ms = 0;
+    double min_ms = 0;
+    double max_ms = 0;
+    size_t bytes = 0;
+    size_t files = 0;
+
+    double megabytesPerSecond() const { return median_ms > 0 ? (bytes / 1e6) / (median_ms / 1e3) : 0; }
+    double filesPerSecond() const { return median_ms > 0 ? files / (median_ms / 1e3) : 0; }
+  };
+
+  // One untimed warm-up run, then `repeat` timed runs; setup runs before each and is not timed
+  BenchResult measure(const std::string& corpus, const std::string& bench, const BenchOptions& options,
+                      size_t bytes, size_t files, const std::function<void()>& run,
+                      const std::function<void()>& setup = nullptr) {
+    std::vector<double> samples;
+    for (size_t i = 0; i <= options.repeat; ++i) {
+      if (setup) setup();
+      auto start = std::chrono::steady_clock::now();
+      run();
+      auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      if (i > 0) samples.push_back(elapsed);
+    }
+    std::sort(samples.begin(), samples.end());
+    BenchResult result{corpus, bench, samples[samples.size() / 2], samples.front(), samples.back(), bytes, files};
+    std::cout << std::left << std::setw(12) << corpus << std::setw(14) << bench << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << result.median_ms << " ms"
+              << "  (min " << result.min_ms << ", max " << result.max_ms << ")"
+              << std::setprecision(1) << std::setw(10) << result.megabytesPerSecond() << " MB/s"
+              << std::setprecision(0) << std::setw(10) << result.filesPerSecond() << " files/s" << std::endl;
+    return result;
+  }
+
+  void runCorpus(const Corpus& corpus, const BenchOptions& options, std::vector<BenchResult>& results) {
+    if (corpus.files.empty()) {
+      std::cerr << "Skipping empty corpus: " << corpus.name << std::endl;
+      return;
+    }
+    const size_t bytes = corpus.bytes();
+    const size_t files = corpus.files.size();
+    std::cout << corpus.name << ": " << files << " files, " << (bytes + 1023) / 1024 << " KiB" << std::endl;
+
+    TSParser* parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_cpp());
+    auto parseAll = [&](std::vector<TSTree*>& trees) {
+      for (const auto& file : corpus.files) {
+        trees.push_back(ts_parser_parse_string(parser, nullptr, file.content.c_str(),
+                                               static_cast<uint32_t>(file.content.size())));
+      }
+    };
+    auto deleteAll = [](std::vector<TSTree*>& trees) {
+      for (TSTree* tree : trees) ts_tree_delete(tree);
+      trees.clear();
+    };
+
+    std::vector<TSTree*> trees;
+    results.push_back(measure(corpus.name, "parse", options, bytes, files,
+                              [&] { parseAll(trees); }, [&] { deleteAll(trees); }));
+
+    // Trees from the last parse run are reused: extraction is timed on its own
+    StringInterner strings;
+    std::vector<CodeConstruct> constructs;
+    ASTExtractor extractor;
+    extractor.setDocstringStyle("/** */");
+    extractor.setFusedDocstrings(true);
+    extractor.setStringInterner(&strings);
+    results.push_back(measure(corpus.name, "ast_extract", options, bytes, files, [&] {
+      for (size_t i = 0; i < files; ++i) {
+        auto extracted = extractor.extractConstructs(trees[i], corpus.files[i].content, corpus.files[i].path);
+        constructs.insert(constructs.end(), std::make_move_iterator(extracted.begin()),
+                          std::make_move_iterator(extracted.end()));
+      }
+    }, [&] { constructs.clear(); strings.clear(); }));
+    deleteAll(trees);
+    ts_parser_delete(parser);
+
+    DocstringParser docstring_parser;
+    size_t docstring_count = 0;
+    results.push_back(measure(corpus.name, "docstrings", options, bytes, files, [&] {
+      for (const auto& file : corpus.files) {
+        docstring_count += docstring_parser.extractDocstrings(file.content, "/** */").size();
+      }
+    }));
+
+    // Snippets are written into an emptied directory each time, so every page is rendered and written
+    std::string snippet_dir = (std::filesystem::path(options.work_dir) / (corpus.name + "-snippets")).string();
+    GeneratedFileMap generated;
+    results.push_back(measure(corpus.name, "markdown", options, bytes, files, [&] {
+      MarkdownGenerator generator;
+      generated = generator.generateMarkdownFromConstructs(constructs, snippet_dir);
+    }, [&] {
+      std::error_code ec;
+      std::filesystem::remove_all(snippet_dir, ec);
+    }));
+
+    // One cache record per file with the outputs it produced; timed separately per format
+    for (CacheFormat format : {CacheFormat::Json, CacheFormat::Binary}) {
+      std::string label = format == CacheFormat::Json ? "json" : "binary";
+      std::string cache_path = (std::filesystem::path(options.work_dir) / (corpus.name + "-" + label) /
+                                ".cesium-cache.json").string();
+      std::error_code ec;
+      std::filesystem::remove_all(std::filesystem::path(cache_path).parent_path(), ec);
+      std::filesystem::create_directories(std::filesystem::path(cache_path).parent_path(), ec);
+
+      DocumentationCache cache(cache_path);
+      cache.setFormat(format);
+      cache.setJournalEnabled(false);
+      for (const auto& file : corpus.files) {
+        auto outputs = generated.find(file.path);
+        cache.updateFile(file.path, outputs != generated.end() ? outputs->second : std::vector<std::string>{},
+                         1, "cpp");
+      }
+      results.push_back(measure(corpus.name, "cache_save_" + label, options, bytes, files, [&] { cache.save(); }));
+      results.push_back(measure(corpus.name, "cache_load_" + label, options, bytes, files, [&] {
+        DocumentationCache loaded(cache_path);
+        loaded.setFormat(format);
+        loaded.load();
+      }));
+    }
+
+    std::cout << "  (" << constructs.size() << " constructs, "
+              << docstring_count / (options.repeat + 1) << " docstring blocks)" << std::endl;
+  }
+
+  bool writeJson(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path, std::ios::binary);
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+      const auto& r = results[i];
+      out << "  {\"corpus\": " << quoteJson(r.corpus) << ", \"bench\": " << quoteJson(r.bench)
+          << ", \"median_ms\": " << r.median_ms << ", \"min_ms\": " << r.min_ms << ", \"max_ms\": " << r.max_ms
+          << ", \"bytes\": " << r.bytes << ", \"files\": " << r.files
+          << ", \"mb_per_s\": " << r.megabytesPerSecond() << ", \"files_per_s\": " << r.filesPerSecond() << "}"
+          << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+    return static_cast<bool>(out);
+  }
+
+  void printUsage() {
+    std::cout << "Usage: cesium-bench [options] [corpus-dir...]\n\n";
+    std::cout << "Benchmarks parsing, AST extraction, docstring scanning, markdown generation\n";
+    std::cout << "and cache save/load over a generated corpus and each given source tree.\n";
+    #ifdef CESIUM_BENCH_DEFAULT_CORPUS
+      std::cout << "Without corpus directories, " << CESIUM_BENCH_DEFAULT_CORPUS << " is used.\n";
+    #endif
+    std::cout << "\nOptions:\n";
+    std::cout << "  --files <n>               Files in the generated corpus (default: 300, 0 = none)\n";
+    std::cout << "  --repeat <n>              Timed repetitions per benchmark (default: 5)\n";
+    std::cout << "  --json <file>             Also write results as JSON\n";
+    std::cout << "  --work-dir <dir>          Scratch directory (default: system temp)\n";
+    std::cout << "  --help, -h               Show this help message\n";
+  }
+
+  bool parseSize(const std::string& value, size_t& out) {
+    try {
+      size_t consumed = 0;
+      out = static_cast<size_t>(std::stoul(value, &consumed));
+      return consumed == value.size();
+    } catch (const std::exception&) {
+      return false;
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  BenchOptions options;
+  options.work_dir = (std::filesystem::temp_directory_path() / "cesium-bench").string();
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--help" || arg == "-h") {
+      printUsage();
+      return 0;
+    } else if (arg == "--files" && has_value) {
+      if (!parseSize(argv[++i], options.synthetic_files)) { printUsage(); return 1; }
+    } else if (arg == "--repeat" && has_value) {
+      if (!parseSize(argv[++i], options.repeat) || options.repeat == 0) { printUsage(); return 1; }
+    } else if (arg == "--json" && has_value) {
+      options.json_path = argv[++i];
+    } else if (arg == "--work-dir" && has_value) {
+      options.work_dir = argv[++i];
+    } else if (!arg.empty() && arg[0] == '-') {
+      std::cerr << "Unknown option: " << arg << std::endl;
+      printUsage();
+      return 1;
+    } else {
+      options.corpora.push_back(arg);
+    }
+  }
+  #ifdef CESIUM_BENCH_DEFAULT_CORPUS
+    if (options.corpora.empty()) {
+      options.corpora.push_back(CESIUM_BENCH_DEFAULT_CORPUS);
+    }
+  #endif
+
+  std::vector<BenchResult> results;
+  if (options.synthetic_files > 0) {
+    Corpus synthetic = generateSyntheticCorpus((std::filesystem::path(options.work_dir) / "synthetic-src").string(),
+                                               options.synthetic_files);
+    runCorpus(synthetic, options, results);
+  }
+  for (const auto& root : options.corpora) {
+    std::string name = std::filesystem::path(root).filename().string();
+    if (name.empty()) name = std::filesystem::path(root).parent_path().filename().string();
+    runCorpus(loadCorpus(name, {root}), options, results);
+  }
+
+  if (!options.json_path.empty() && !writeJson(options.json_path, results)) {
+    std::cerr << "Failed to write " << options.json_path << std::endl;
+    return 1;
+  }
+  std::error_code ec;
+  std::filesystem::remove_all(options.work_dir, ec);
+  return 0;
+}
@@ -0,0 +1,140 @@
+/**
+@brief C interface of the embeddable documentation extractor
+*/
+#include <backend/doc/cesium_doc.h>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <backend/core/cli_utils.h>
+#include <backend/doc/docgen.h>
+
+struct cesium_doc {
+  CesiumDocExtractor extractor;  ///< Extractor kept resident between calls
+  std::string last_error;        ///< Message of the last failed call
+};
+
+namespace {
+  // Copy text into a malloc'd buffer the caller releases with cesium_doc_free
+  char* copyOut(const std::string& text) {
+    char* copy = static_cast<char*>(std::malloc(text.size() + 1));
+    if (copy) {
+      std::memcpy(copy, text.data(), text.size() + 1);
+    }
+    return copy;
+  }
+
+  cesium_doc_status fail(cesium_doc* doc, const std::string& message) {
+    doc->last_error = message;
+    return CESIUM_DOC_FAILED;
+  }
+}
+
+extern "C" {
+
+uint32_t cesium_doc_api_version(void) {
+  return CESIUM_DOC_API_VERSION;
+}
+
+cesium_doc* cesium_doc_open(const char* config_path) {
+  if (!config_path) return nullptr;
+  try {
+    auto doc = std::make_unique<cesium_doc>();
+    if (!doc->extractor.initialize(std::string(config_path))) {
+      return nullptr;
+    }
+    return doc.release();
+  } catch (const std::exception& e) {
+    CLILogger::error("cesium_doc_open: " + std::string(e.what()));
+    return nullptr;
+  }
+}
+
+void cesium_doc_close(cesium_doc* doc) {
+  delete doc;
+}
+
+cesium_doc_status cesium_doc_extract_buffer(cesium_doc* doc, const char* path, const char* content,
+                                            size_t length, char** constructs_json, size_t* json_length) {
+  if (!doc) return CESIUM_DOC_INVALID_ARGUMENT;
+  doc->last_error.clear();
+  if (!path || (!content && length > 0) || !constructs_json) {
+    doc->last_error = "path, content and constructs_json are required";
+    return CESIUM_DOC_INVALID_ARGUMENT;
+  }
+  *constructs_json = nullptr;
+  if (json_length) *json_length = 0;
+
+  try {
+    std::optional<ExtractionResult> result =
+      doc->extractor.extractBuffer(path, content ? std::string(content, length) : std::string());
+    if (!result) {
+      doc->last_error = std::string("No language handles ") + path;
+      return CESIUM_DOC_NO_LANGUAGE;
+    }
+    if (result->status != SourceStatus::Loaded) {
+      doc->last_error = std::string("Skipped ") + sourceStatusName(result->status) + " content: " + path;
+      return CESIUM_DOC_SKIPPED;
+    }
+
+    std::ostringstream out;
+    ConstructStreamWriter writer(out, ConstructFormat::Json);
+    for (const auto& construct : result->constructs) {
+      writer.write(construct);
+    }
+    if (!writer.finish()) {
+      return fail(doc, "Failed to serialize constructs");
+    }
+    std::string json = std::move(out).str();
+    *constructs_json = copyOut(json);
+    if (!*constructs_json) {
+      return fail(doc, "Out of memory");
+    }
+    if (json_length) *json_length = json.size();
+    return CESIUM_DOC_OK;
+  } catch (const std::exception& e) {
+    return fail(doc, e.what());
+  }
+}
+
+cesium_doc_status cesium_doc_extract_files(cesium_doc* doc, const char* const* paths, size_t count) {
+  if (!doc) return CESIUM_DOC_INVALID_ARGUMENT;
+  doc->last_error.clear();
+  if (!paths && count > 0) {
+    doc->last_error = "paths is required";
+    return CESIUM_DOC_INVALID_ARGUMENT;
+  }
+
+  try {
+    std::vector<std::string> changed;
+    changed.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      if (paths[i]) changed.emplace_back(paths[i]);
+    }
+    if (!doc->extractor.extractChanged(changed)) {
+      return fail(doc, "Extraction failed (see the log for details)");
+    }
+    return CESIUM_DOC_OK;
+  } catch (const std::exception& e) {
+    return fail(doc, e.what());
+  }
+}
+
+void cesium_doc_forget(cesium_doc* doc, const char* path) {
+  if (doc && path) {
+    doc->extractor.forgetBuffer(path);
+  }
+}
+
+void cesium_doc_free(char* text) {
+  std::free(text);
+}
+
+const char* cesium_doc_last_error(const cesium_doc* doc) {
+  return doc ? doc->last_error.c_str() : "no extractor";
+}
+
+}
@@ -44,22 +44,22 @@ int main(int argc, char *argv[])
     #endif
     ConsoleUTF8 set_console_to_utf8;
 
-    CLILogger::debug("main: Starting Cesium CLI with " + std::to_string(argc) + " arguments");
+    LOG_DEBUG("main: Starting Cesium CLI with " + std::to_string(argc) + " arguments");
     for (int i = 0; i < argc; i++) {
-      CLILogger::debuglow("main: argv[" + std::to_string(i) + "] = '" + std::string(argv[i]) + "'");
+      LOG_DEBUGLOW("main: argv[" + std::to_string(i) + "] = '" + std::string(argv[i]) + "'");
     }
 
     if (argc > 1) {
       std::string arg = argv[1];
-      CLILogger::debug("main: Processing command: " + arg);
+      LOG_DEBUG("main: Processing command: " + arg);
 
       // Documentation tools subcommand
       if (arg == "doc") {
-        CLILogger::debug("main: Invoking documentation CLI");
+        LOG_DEBUG("main: Invoking documentation CLI");
         try {
           CesiumDocCLI cli;
           int result = cli.run(argc - 1, argv + 1); // Skip "cesium" from args
-          CLILogger::debug("main: Documentation CLI completed with exit code: " + std::to_string(result));
+          LOG_DEBUG("main: Documentation CLI completed with exit code: " + std::to_string(result));
           return result;
         } catch (const std::exception& e) {
           CLILogger::error("main: Documentation CLI failed with exception: " + std::string(e.what()));
@@ -74,7 +74,7 @@ int main(int argc, char *argv[])
 
       // Help command
       if (arg == "--help" || arg == "-h") {
-        CLILogger::debug("main: Showing help information");
+        LOG_DEBUG("main: Showing help information");
         try {
           printHelp();
           return 0;
@@ -87,11 +87,11 @@ int main(int argc, char *argv[])
 
       // Version information
       if (arg == "--version" || arg == "-v") {
-        CLILogger::debug("main: Showing version information");
+        LOG_DEBUG("main: Showing version information");
         try {
           std::string version_info = cesium::version::getFullVersionInfo();
           std::cout << version_info << std::endl;
-          CLILogger::debug("main: Successfully displayed version information");
+          LOG_DEBUG("main: Successfully displayed version information");
           return 0;
         } catch (const std::exception& e) {
           CLILogger::error("main: Failed to get version information: " + std::string(e.what()));
@@ -108,9 +108,9 @@ int main(int argc, char *argv[])
     }
 
     // No arguments provided - show friendly greeting
-    CLILogger::debug("main: No arguments provided, showing greeting");
+    LOG_DEBUG("main: No arguments provided, showing greeting");
     std::cout << "Hello from Cesium!" << std::endl;
-    CLILogger::debug("main: Cesium CLI completed successfully");
+    LOG_DEBUG("main: Cesium CLI completed successfully");
     return 0;
 
   } catch (const std::exception& e) {
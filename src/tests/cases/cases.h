@@ -5,3 +5,13 @@ void run_markdown_generator_tests();
 void run_cli_integration_tests();
 void run_operator_extraction_tests();
 void run_dynlib_platform_tests();
+void run_ast_extraction_tests();
+void run_documentation_cache_tests();
+void run_snippet_processor_tests();
+void run_query_extraction_tests();
+void run_source_reader_tests();
+void run_glob_matcher_tests();
+void run_fs_scanner_tests();
+void run_file_watcher_tests();
+void run_logging_tests();
+void run_profile_tests();
@@ -0,0 +1,730 @@
+/**
+@brief Tests for AST construct extraction and docstring attachment on parsed C++ sources
+*/
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <backend/core/cli_utils.h>
+#include <backend/core/json.h>
+#include <backend/doc/cpp/ast_extractor.h>
+#include <backend/doc/cpp/ts_ast_parser.h>
+#include <backend/doc/grammar_registry.h>
+#include <backend/doc/markdowngen.h>
+#include <backend/doc/treesitter.h>
+#include "../testfrmwk/simple_test.h"
+
+extern "C" const TSLanguage* tree_sitter_cpp(void);
+
+// Parse source with the statically linked C++ grammar and extract constructs
+static std::vector<CodeConstruct> extractFromSource(ASTExtractor& extractor, const std::string& source,
+                                                   const std::string& filename = "test.cpp") {
+  TSParser* parser = ts_parser_new();
+  ts_parser_set_language(parser, tree_sitter_cpp());
+  TSTree* tree = ts_parser_parse_string(parser, nullptr, source.c_str(), static_cast<uint32_t>(source.length()));
+  std::vector<CodeConstruct> constructs = extractor.extractConstructs(tree, source, filename);
+  ts_tree_delete(tree);
+  ts_parser_delete(parser);
+  return constructs;
+}
+
+// Register a language from an inline JSON config
+static bool registerTestLanguage(DynamicLanguageLoader& loader, const std::string& name, const std::string& config) {
+  std::optional<JsonDoc> doc = JsonDoc::parse(config);
+  return doc && loader.registerLanguage(name, doc->root());
+}
+
+static const CodeConstruct* findConstruct(const std::vector<CodeConstruct>& constructs, const std::string& full_name) {
+  for (const auto& construct : constructs) {
+    if (construct.full_name == full_name) return &construct;
+  }
+  return nullptr;
+}
+
+/**
+@brief Tests that fused mode attaches doc comments collected during the AST walk
+
+Requirements tested:
+- Block doc comments are attached to the construct that immediately follows them
+- Doc comments are attached to methods declared inside a class body
+- A doc comment separated from a construct by another statement is not attached
+
+Testing rationale: Fused mode replaces the separate regex scan, so it must attach
+the same docstrings without leaking a comment onto an unrelated construct.
+*/
+void test_fused_block_docstrings() {
+  ASTExtractor extractor;
+  extractor.setFusedDocstrings(true);
+  extractor.setDocstringStyle("/** */");
+
+  std::string source = R"(
+/**
+Add two numbers together
+*/
+int add(int a, int b) { return a + b; }
+
+/** Documents the variable, not the function */
+int counter = 0;
+int undocumented(int x) { return x; }
+
+class Shape {
+  public:
+    /** Compute the area */
+    double area() const;
+};
+)";
+
+  auto constructs = extractFromSource(extractor, source);
+
+  const CodeConstruct* add = findConstruct(constructs, "add");
+  TEST_ASSERT_TRUE(add && add->docstring && add->docstring->find("Add two numbers together") != std::string::npos,
+                   "fused_function_docstring_attached");
+
+  const CodeConstruct* undocumented = findConstruct(constructs, "undocumented");
+  TEST_ASSERT_TRUE(undocumented && !undocumented->docstring.has_value(), "fused_stale_docstring_not_attached");
+
+  const CodeConstruct* area = findConstruct(constructs, "Shape::area");
+  TEST_ASSERT_TRUE(area && area->docstring && area->docstring->find("Compute the area") != std::string::npos,
+                   "fused_method_docstring_attached");
+}
+
+/**
+@brief Tests that consecutive line doc comments are merged into one docstring
+
+Requirements tested:
+- Adjacent /// lines form a single docstring
+- The merged docstring is attached to the following construct
+
+Testing rationale: Tree-sitter emits one comment node per line, so fused mode
+must stitch runs of line comments back together.
+*/
+void test_fused_line_docstrings() {
+  ASTExtractor extractor;
+  extractor.setFusedDocstrings(true);
+  extractor.setDocstringStyle("/// ");
+
+  std::string source = "/// First line\n/// Second line\nvoid documented();\n";
+  auto constructs = extractFromSource(extractor, source);
+
+  const CodeConstruct* documented = findConstruct(constructs, "documented");
+  TEST_ASSERT_TRUE(documented && documented->docstring &&
+                   documented->docstring->find("First line") != std::string::npos &&
+                   documented->docstring->find("Second line") != std::string::npos,
+                   "fused_line_comments_merged");
+}
+
+/**
+@brief Tests that #include directives are collected during extraction
+
+Requirements tested:
+- Quoted and angle-bracket includes are both recorded without their delimiters
+- Includes nested in preprocessor conditionals are found
+- Each extraction starts with a fresh include list
+
+Testing rationale: Include paths become the cache's dependency edges, so a missed
+include means a header edit silently leaves its dependents stale.
+*/
+void test_include_collection() {
+  ASTExtractor extractor;
+
+  std::string source = "#include \"shape.h\"\n#include <vector>\n#ifdef USE_EXTRA\n#include \"extra/detail.h\"\n#endif\nvoid draw();\n";
+  extractFromSource(extractor, source);
+  const auto& includes = extractor.includes();
+  TEST_ASSERT_EQ(includes.size(), size_t(3), "includes_collected");
+  TEST_ASSERT_TRUE(includes.size() == 3 && includes[0] == "shape.h" && includes[1] == "vector" && includes[2] == "extra/detail.h",
+                   "includes_spelled_without_delimiters");
+
+  extractFromSource(extractor, "void plain();\n");
+  TEST_ASSERT_TRUE(extractor.includes().empty(), "includes_reset_between_files");
+}
+
+/**
+@brief Tests that construct strings are interned into a shared interner
+
+Requirements tested:
+- Constructs from one file share a single copy of the filename and namespace path
+- Parameter and return types resolve to the same stored strings
+- Interned views stay valid after the extractor that produced them is gone
+
+Testing rationale: Constructs hold views instead of owned strings, so a view
+into the wrong storage would dangle once extraction is over.
+*/
+void test_interned_construct_strings() {
+  StringInterner strings;
+  std::vector<CodeConstruct> constructs;
+  {
+    ASTExtractor extractor;
+    extractor.setStringInterner(&strings);
+    constructs = extractFromSource(extractor, "namespace geo {\nint area(int w, int h);\nint perimeter(int w, int h);\n}\n");
+  }
+
+  const CodeConstruct* area = findConstruct(constructs, "geo::area");
+  const CodeConstruct* perimeter = findConstruct(constructs, "geo::perimeter");
+  TEST_ASSERT_TRUE(area && perimeter, "interned_constructs_found");
+  if (!area || !perimeter) return;
+
+  TEST_ASSERT_TRUE(area->filename == "test.cpp" && area->filename.data() == perimeter->filename.data(),
+                   "interned_filename_shared");
+  TEST_ASSERT_TRUE(area->namespace_path == "geo" && area->namespace_path.data() == perimeter->namespace_path.data(),
+                   "interned_namespace_shared");
+  TEST_ASSERT_TRUE(area->parameters.size() == 2 && perimeter->parameters.size() == 2 &&
+                   area->parameters[0].type == "int" && area->parameters[0].type.data() == perimeter->parameters[1].type.data(),
+                   "interned_parameter_type_shared");
+  TEST_ASSERT_TRUE(area->return_type && area->return_type->data() == area->parameters[0].type.data(),
+                   "interned_return_type_shared");
+  TEST_ASSERT_EQ(strings.intern("geo").data(), area->namespace_path.data(), "interner_returns_stored_copy");
+}
+
+/**
+@brief Tests merging a declaration and a definition extracted from different files
+
+Requirements tested:
+- Constructs with the same full name and signature from different files become one construct
+- Overloads (same full name, different parameter types) stay separate
+- The merged construct keeps the first occurrence's position and lists every location
+- Docstrings from constructs that were already merged are carried over
+- A target that was already merged gets its docstring recombined when absorbing more
+- Unrelated constructs keep their relative order
+
+Testing rationale: Headers and sources are extracted by separate workers, so the
+cross-file pass is the only place a declaration meets its definition.
+*/
+void test_cross_file_merge() {
+  StringInterner strings;
+  auto makeConstruct = [&](const std::string& full_name, std::string_view filename, uint32_t line,
+                           const std::string& docstring) {
+    CodeConstruct construct{};
+    construct.type = ConstructType::Function;
+    construct.name = full_name;
+    construct.full_name = full_name;
+    construct.filename = strings.intern(filename);
+    construct.start_line = line;
+    construct.end_line = line;
+    if (!docstring.empty()) construct.docstring = docstring;
+    return construct;
+  };
+
+  std::vector<CodeConstruct> constructs;
+  constructs.push_back(makeConstruct("area", "shape.h", 3, "Compute the area"));
+  constructs.push_back(makeConstruct("perimeter", "shape.h", 5, ""));
+  constructs.push_back(makeConstruct("area", "shape.cpp", 10, "Multiplies width by height"));
+  constructs.push_back(makeConstruct("draw", "draw.cpp", 1, ""));
+
+  // The definition was already merged with a second declaration inside shape.cpp
+  constructs[2].is_merged = true;
+  constructs[2].source_locations = {"shape.cpp:10", "shape.cpp:2"};
+  constructs[2].merged_docstrings = {"Multiplies width by height", "Local declaration"};
+
+  int conflicts = ASTExtractor::mergeDuplicateConstructs(constructs, strings);
+  TEST_ASSERT_EQ(constructs.size(), size_t(3), "cross_file_duplicates_folded");
+  TEST_ASSERT_TRUE(constructs.size() == 3 && constructs[0].full_name == "area" &&
+                   constructs[1].full_name == "perimeter" && constructs[2].full_name == "draw",
+                   "cross_file_merge_keeps_order");
+  TEST_ASSERT_EQ(conflicts, 1, "cross_file_docstring_conflict_counted");
+  if (constructs.empty()) return;
+
+  const CodeConstruct& area = constructs[0];
+  TEST_ASSERT_TRUE(area.is_merged && area.filename == "shape.h" && area.start_line == 3, "cross_file_merge_keeps_first");
+  TEST_ASSERT_TRUE(area.source_locations == std::vector<std::string>({"shape.h:3", "shape.cpp:10", "shape.cpp:2"}),
+                   "cross_file_merge_lists_locations");
+  TEST_ASSERT_TRUE(area.docstring && area.docstring->find("Compute the area") == 0 &&
+                   area.docstring->find("Local declaration") != std::string::npos,
+                   "cross_file_merge_combines_docstrings");
+
+  // A target merged by an earlier pass (the per-file pass, or a spilled batch when streaming) still
+  // recombines its docstrings
+  std::vector<CodeConstruct> later;
+  later.push_back(std::move(constructs[0]));
+  later.push_back(makeConstruct("area", "shape_impl.cpp", 7, "Cached per shape"));
+  ASTExtractor::mergeDuplicateConstructs(later, strings);
+  TEST_ASSERT_TRUE(later.size() == 1 && later[0].docstring &&
+                   later[0].docstring->find("Cached per shape") != std::string::npos &&
+                   later[0].docstring->find("Compute the area") == 0,
+                   "merged_target_recombines_docstrings");
+
+  // Overloads share a full name but not a signature, so each only absorbs its own declaration
+  auto makeOverload = [&](std::string_view filename, uint32_t line, std::string_view type, const std::string& docstring) {
+    CodeConstruct construct = makeConstruct("geo::scale", filename, line, docstring);
+    construct.parameters.push_back({strings.intern(type), "factor", std::nullopt});
+    return construct;
+  };
+  std::vector<CodeConstruct> overloads;
+  overloads.push_back(makeOverload("shape.h", 3, "int", "Scale by a whole factor"));
+  overloads.push_back(makeOverload("shape.h", 4, "const Ratio&", "Scale by a ratio"));
+  overloads.push_back(makeOverload("shape.cpp", 9, "const Ratio &", "Rounds down"));
+  conflicts = ASTExtractor::mergeDuplicateConstructs(overloads, strings);
+  TEST_ASSERT_EQ(size_t(2), overloads.size(), "overloads_not_folded");
+  TEST_ASSERT_EQ(1, conflicts, "overload_conflicts_only_within_signature");
+  TEST_ASSERT_TRUE(overloads.size() == 2 && !overloads[0].is_merged &&
+                   overloads[0].docstring == std::optional<std::string>("Scale by a whole factor"),
+                   "overload_keeps_own_docstring");
+  TEST_ASSERT_TRUE(overloads.size() == 2 && overloads[1].is_merged && overloads[1].docstring &&
+                   overloads[1].docstring->find("Rounds down") != std::string::npos,
+                   "overload_merges_with_its_definition");
+  TEST_ASSERT_EQ(std::string("geo::scale(const Ratio&)"), overloadSignature(overloads[1]), "signature_ignores_spacing");
+}
+
+/**
+@brief Tests that extracted header declarations merge with their definitions, overload by overload
+
+Requirements tested:
+- Declarations get their parameters (names, types without names or defaults) and constness
+- A declaration and its definition have the same overload signature and share one page
+- Overloads declared side by side keep a page each
+
+Testing rationale: The merge keys on the signature, so any difference between
+what a prototype and a definition yield splits one function across two pages.
+*/
+void test_declaration_definition_merge() {
+  StringInterner strings;
+  ASTExtractor extractor;
+  extractor.setStringInterner(&strings);
+  extractor.setFusedDocstrings(true);
+  extractor.setDocstringStyle("/** */");
+
+  std::vector<CodeConstruct> constructs = extractFromSource(extractor, R"(namespace geo {
+/** Scales by a whole factor */
+int scale(int factor);
+/** Scales by a ratio */
+int scale(const Ratio& ratio, int steps = 1);
+/** Shared helper */
+int helper(int x);
+struct Shape {
+  /** Area of the shape */
+  double area() const;
+};
+}
+)", "shape.h");
+  const CodeConstruct* declared = findConstruct(constructs, "geo::helper");
+  TEST_ASSERT_TRUE(declared && declared->parameters.size() == 1 && declared->parameters[0].type == "int" &&
+                   declared->parameters[0].name == "x", "declaration_parameters_extracted");
+  const CodeConstruct* area = findConstruct(constructs, "geo::Shape::area");
+  TEST_ASSERT_TRUE(area && area->is_const, "const_declaration_detected");
+
+  std::vector<CodeConstruct> definitions = extractFromSource(extractor, R"(namespace geo {
+/** Doubles x */
+int helper(int x) { return 2 * x; }
+/** Rounds down */
+int scale(const Ratio &ratio, int steps) { return steps; }
+}
+/** Cached per shape */
+double geo::Shape::area() const { return 0; }
+)", "shape.cpp");
+  constructs.insert(constructs.end(), std::make_move_iterator(definitions.begin()),
+                    std::make_move_iterator(definitions.end()));
+  ASTExtractor::mergeDuplicateConstructs(constructs, strings);
+
+  std::vector<const CodeConstruct*> scales;
+  for (const auto& construct : constructs) {
+    if (construct.full_name == "geo::scale") scales.push_back(&construct);
+  }
+  TEST_ASSERT_EQ(size_t(2), scales.size(), "declared_overloads_kept_apart");
+  TEST_ASSERT_TRUE(scales.size() == 2 && !scales[0]->is_merged && scales[1]->is_merged &&
+                   overloadSignature(*scales[1]) == "geo::scale(const Ratio&,int)", "overload_merged_with_its_definition");
+  const CodeConstruct* helper = findConstruct(constructs, "geo::helper");
+  TEST_ASSERT_TRUE(helper && helper->is_merged && helper->docstring &&
+                   helper->docstring->find("Shared helper") != std::string::npos &&
+                   helper->docstring->find("Doubles x") != std::string::npos, "declaration_merged_with_definition");
+  area = findConstruct(constructs, "geo::Shape::area");
+  TEST_ASSERT_TRUE(area && area->is_merged, "const_method_merged_with_definition");
+
+  std::string output_dir = "test_declaration_merge_output";
+  MarkdownGenerator generator;
+  GeneratedFileMap outputs = generator.generateMarkdownFromConstructs(constructs, output_dir);
+  auto pageOf = [&](const std::string& source, const std::string& prefix) {
+    for (const auto& page : outputs[source]) {
+      if (std::filesystem::path(page).filename().string().starts_with(prefix)) return page;
+    }
+    return std::string();
+  };
+  TEST_ASSERT_TRUE(!pageOf("shape.h", "geo.helper").empty() && pageOf("shape.h", "geo.helper") == pageOf("shape.cpp", "geo.helper"),
+                   "declaration_and_definition_share_page");
+  TEST_ASSERT_TRUE(!pageOf("shape.cpp", "geo.Shape.area").empty() &&
+                   pageOf("shape.h", "geo.Shape.area") == pageOf("shape.cpp", "geo.Shape.area"),
+                   "const_method_pages_shared");
+  std::filesystem::remove_all(output_dir);
+}
+
+/**
+@brief Benchmarks extraction on pathologically nested input
+
+Requirements tested:
+- Deeply nested namespaces produce correctly qualified names
+- A deeply nested initializer table (as in generated code) is walked without
+  exhausting the native stack
+- Constructs after the deep subtree are still found with the outer namespace path
+
+Testing rationale: The walk uses a tree cursor and an explicit scope stack, so its
+cost must stay linear and its stack use flat however deep the tree gets.
+*/
+void test_deeply_nested_extraction() {
+  const int namespace_depth = 200;
+  const int table_depth = 20000;
+
+  std::string source;
+  for (int i = 0; i < namespace_depth; ++i) source += "namespace n" + std::to_string(i) + " {\n";
+  source += "int innermost();\n";
+  for (int i = 0; i < namespace_depth; ++i) source += "}\n";
+  source += "namespace tables {\nint table[] = ";
+  source += std::string(table_depth, '{') + "1" + std::string(table_depth, '}') + ";\nint after();\n}\n";
+
+  ASTExtractor extractor;
+  auto start = std::chrono::steady_clock::now();
+  auto constructs = extractFromSource(extractor, source);
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  std::cout << "  Nested extraction: " << source.size() << " bytes, " << constructs.size()
+            << " constructs in " << elapsed.count() << " ms" << std::endl;
+
+  std::string innermost_name;
+  for (int i = 0; i < namespace_depth; ++i) innermost_name += "n" + std::to_string(i) + "::";
+  innermost_name += "innermost";
+  TEST_ASSERT_TRUE(findConstruct(constructs, innermost_name) != nullptr, "nested_namespace_path");
+  TEST_ASSERT_TRUE(findConstruct(constructs, "tables::after") != nullptr, "nested_table_walked");
+}
+
+/**
+@brief Tests pairing standalone docstring blocks with the declarations after them
+
+Requirements tested:
+- Each block is paired with the nearest declaration starting after it, whatever order the blocks are passed in
+- Two blocks before the same declaration both pair with it
+- A block after the last declaration stays unassociated
+- Blocks in a second file reuse the associator's compiled query
+
+Testing rationale: The association is a single merge of sorted comment and
+declaration offsets, so an off-by-one in the sweep would shift every
+docstring onto its neighbour's declaration.
+*/
+void test_doc_association_sweep() {
+  const std::string source =
+    "/** A */\n"
+    "namespace outer {\n"
+    "/** B */\n"
+    "/** B2 */\n"
+    "class Widget {};\n"
+    "/** C */\n"
+    "int run() { return 0; }\n"
+    "}\n"
+    "/** trailing */\n";
+
+  auto blockAt = [&](const std::string& marker) {
+    DocstringBlock block;
+    block.raw_content = marker;
+    block.location.byte_offset = source.find(marker);
+    return block;
+  };
+  std::vector<DocstringBlock> blocks = {blockAt("/** C */"), blockAt("/** A */"), blockAt("/** trailing */"),
+                                        blockAt("/** B2 */"), blockAt("/** B */")};
+
+  TSParser* parser = ts_parser_new();
+  ts_parser_set_language(parser, tree_sitter_cpp());
+  TSTree* tree = ts_parser_parse_string(parser, nullptr, source.c_str(), static_cast<uint32_t>(source.length()));
+  DocAssociator associator;
+  associator.associateDocsWithNodes(blocks, tree, source);
+
+  TEST_ASSERT_EQ(std::string("function_definition"), blocks[0].symbol_type, "association_block_to_following_function");
+  TEST_ASSERT_EQ(std::string("run"), blocks[0].symbol_name, "association_function_name");
+  TEST_ASSERT_EQ(std::string("outer"), blocks[0].namespace_path, "association_function_in_namespace");
+  TEST_ASSERT_EQ(std::string("namespace_definition"), blocks[1].symbol_type, "association_first_block_to_namespace");
+  TEST_ASSERT_TRUE(blocks[2].symbol_type.empty(), "association_trailing_block_unassociated");
+  TEST_ASSERT_TRUE(blocks[3].symbol_name == "Widget" && blocks[4].symbol_name == "Widget", "association_adjacent_blocks_share_class");
+
+  std::vector<DocstringBlock> second = {blockAt("/** B */")};
+  associator.associateDocsWithNodes(second, tree, source);
+  TEST_ASSERT_EQ(std::string("Widget"), second[0].symbol_name, "association_query_reused");
+
+  ts_tree_delete(tree);
+  ts_parser_delete(parser);
+}
+
+/**
+@brief Tests line-based matching of docstring blocks to undocumented constructs
+
+Requirements tested:
+- The closest block above a construct wins when several precede it
+- Blocks further away than the window, or below the construct, are ignored
+- Constructs with a docstring keep it, and input order does not matter
+
+Testing rationale: The query path relies on this merge for every docstring,
+and the old first-match scan attached the file header to the first few
+constructs in small files.
+*/
+void test_nearest_docstring_matching() {
+  auto block = [](size_t line, const std::string& description) {
+    DocstringBlock result;
+    result.location.line = line;
+    result.description = description;
+    return result;
+  };
+  auto construct = [](uint32_t line) {
+    CodeConstruct result{};
+    result.name = "line" + std::to_string(line);
+    result.start_line = line;
+    return result;
+  };
+
+  std::vector<DocstringBlock> blocks = {block(40, "far below"), block(8, "near"), block(1, "header"),
+                                        block(20, "gap")};
+  std::vector<CodeConstruct> constructs = {construct(28), construct(10), construct(4), construct(12), construct(60)};
+  constructs[3].docstring = "own";
+
+  size_t attached = attachNearestDocstrings(constructs, blocks, 10);
+  TEST_ASSERT_EQ(size_t{3}, attached, "nearest_docstring_count");
+  TEST_ASSERT_EQ(std::string("near"), constructs[1].docstring.value_or(""), "nearest_docstring_closest_wins");
+  TEST_ASSERT_EQ(std::string("header"), constructs[2].docstring.value_or(""), "nearest_docstring_only_candidate");
+  TEST_ASSERT_EQ(std::string("own"), constructs[3].docstring.value_or(""), "nearest_docstring_keeps_existing");
+  TEST_ASSERT_EQ(std::string("gap"), constructs[0].docstring.value_or(""), "nearest_docstring_within_window");
+  TEST_ASSERT_FALSE(constructs[4].docstring.has_value(), "nearest_docstring_outside_window");
+
+  std::vector<CodeConstruct> narrow = {construct(10)};
+  TEST_ASSERT_EQ(size_t{0}, attachNearestDocstrings(narrow, blocks, 1), "nearest_docstring_narrow_window");
+}
+
+/**
+@brief Tests docstring lookup from the comment index when fused mode is off
+
+Requirements tested:
+- A doc comment at the very start of the file is attached
+- A doc comment longer than the proximity window is attached whole
+- A doc comment separated from a construct by another statement is not attached
+
+Testing rationale: The lookup used to copy a fixed window before each node,
+which missed constructs near the top of a file and any comment starting
+further back than the window.
+*/
+void test_indexed_docstring_lookup() {
+  ASTExtractor extractor;
+  extractor.setFusedDocstrings(false);
+  extractor.setDocstringStyle("/** */");
+
+  std::string long_comment = "/**\n" + std::string(200, 'x') + "\nclose to its function\n*/\n";
+  std::string source = "/** First */\nint first();\n" + long_comment +
+                       "int second();\n/** Documents the variable */\nint counter = 0;\nint third();\n";
+
+  auto constructs = extractFromSource(extractor, source);
+
+  const CodeConstruct* first = findConstruct(constructs, "first");
+  TEST_ASSERT_TRUE(first && first->docstring && first->docstring->find("First") != std::string::npos,
+                   "indexed_docstring_at_file_start");
+
+  const CodeConstruct* second = findConstruct(constructs, "second");
+  TEST_ASSERT_TRUE(second && second->docstring && second->docstring->starts_with("/**") &&
+                   second->docstring->find("close to its function") != std::string::npos,
+                   "indexed_long_docstring_attached");
+
+  const CodeConstruct* third = findConstruct(constructs, "third");
+  TEST_ASSERT_TRUE(third && !third->docstring.has_value(), "indexed_stale_docstring_not_attached");
+}
+
+/**
+@brief Tests that a parse stops at its deadline and leaves the parser reusable
+
+Requirements tested:
+- A deadline that has already passed stops the parse with no tree
+- The same parser then parses the next file from scratch
+- A generous deadline parses exactly like an unlimited parse
+
+Testing rationale: Extraction skips files that exceed parse_timeout_ms; a
+pooled parser left mid-parse would resume the abandoned file on the next one.
+*/
+void test_parse_deadline() {
+  std::string huge = "namespace tables {\nint table[] = ";
+  huge += std::string(5000, '{') + "1" + std::string(5000, '}') + ";\n}\n";
+  const std::string small = "int area();\n";
+
+  TSParser* parser = ts_parser_new();
+  ts_parser_set_language(parser, tree_sitter_cpp());
+  TSTree* stopped = parseWithDeadline(parser, nullptr, huge, std::chrono::steady_clock::now() - std::chrono::seconds(1));
+  TEST_ASSERT_TRUE(stopped == nullptr, "expired_deadline_stops_parse");
+  if (stopped) ts_tree_delete(stopped);
+
+  TSTree* next = parseWithDeadline(parser, nullptr, small, std::chrono::steady_clock::time_point::max());
+  TEST_ASSERT_TRUE(next != nullptr, "parser_reusable_after_stop");
+  if (next) {
+    TSNode root = ts_tree_root_node(next);
+    TEST_ASSERT_TRUE(!ts_node_has_error(root) && ts_node_named_child_count(root) == 1, "next_file_parsed_from_scratch");
+    ts_tree_delete(next);
+  }
+
+  TSTree* limited = parseWithDeadline(parser, nullptr, small, std::chrono::steady_clock::now() + std::chrono::minutes(1));
+  TEST_ASSERT_TRUE(limited != nullptr && !ts_node_has_error(ts_tree_root_node(limited)), "generous_deadline_parses");
+  if (limited) ts_tree_delete(limited);
+  ts_parser_delete(parser);
+}
+
+/**
+@brief Tests the per-thread accounting of tree-sitter memory
+
+Requirements tested:
+- Parsing after resetPeak() reports a non-zero peak
+- A larger file reports a larger peak than a small one
+- resetPeak() starts a new peak at the current level
+
+Testing rationale: The profile ranks files by peak parser memory; if frees
+were not matched to their allocations every later file would look larger.
+*/
+void test_parser_memory_peak() {
+  parser_memory::install();
+  TEST_ASSERT_TRUE(parser_memory::installed(), "parser_memory_installed");
+
+  std::string large;
+  for (int i = 0; i < 2000; ++i) {
+    large += "int function" + std::to_string(i) + "(int a, int b) { return a + b; }\n";
+  }
+  const std::string small = "int area();\n";
+
+  TSParser* parser = ts_parser_new();
+  ts_parser_set_language(parser, tree_sitter_cpp());
+
+  parser_memory::resetPeak();
+  TSTree* small_tree = ts_parser_parse_string(parser, nullptr, small.c_str(), static_cast<uint32_t>(small.size()));
+  ts_tree_delete(small_tree);
+  uint64_t small_peak = parser_memory::peak();
+  TEST_ASSERT_TRUE(small_peak > 0, "parser_memory_small_file_peak");
+
+  parser_memory::resetPeak();
+  TSTree* large_tree = ts_parser_parse_string(parser, nullptr, large.c_str(), static_cast<uint32_t>(large.size()));
+  ts_tree_delete(large_tree);
+  uint64_t large_peak = parser_memory::peak();
+  TEST_ASSERT_TRUE(large_peak > small_peak, "parser_memory_large_file_peak_larger");
+
+  parser_memory::resetPeak();
+  TEST_ASSERT_EQ(uint64_t(0), parser_memory::peak(), "parser_memory_reset_clears_peak");
+  ts_parser_delete(parser);
+}
+
+/**
+@brief Tests that extracting a large file stays within its time budget
+
+Requirements tested:
+- Parsing and extracting 2000 documented classes with methods finishes within budget
+- Every class and method is extracted with its docstring
+
+Testing rationale: The AST walk runs once per node; an accidental rescan of
+siblings or parents per node only shows on large files, so the suite fails
+when it happens.
+*/
+void test_extraction_budget() {
+  std::string source = "namespace bench {\n";
+  for (int i = 0; i < 2000; ++i) {
+    std::string name = "Widget" + std::to_string(i);
+    source += "/** " + name + " documentation */\nclass " + name + " {\n  public:\n"
+              "    /** Resize the widget */\n    void resize(int width, int height);\n};\n";
+  }
+  source += "}\n";
+
+  ASTExtractor extractor;
+  extractor.setFusedDocstrings(true);
+  extractor.setDocstringStyle("/** */");
+  std::vector<CodeConstruct> constructs;
+  TEST_ASSERT_WITHIN_MS(2000, "extraction_within_budget", constructs = extractFromSource(extractor, source));
+  const CodeConstruct* last = findConstruct(constructs, "bench::Widget1999::resize");
+  TEST_ASSERT_TRUE(last && last->docstring && last->docstring->find("Resize") != std::string::npos,
+                   "extraction_budget_constructs_complete");
+}
+
+/**
+@brief Tests how file names are matched to configured extensions
+
+Requirements tested:
+- The longest configured dotted suffix wins (".h.in" over ".in"), and unknown
+  longer suffixes fall back to shorter ones ("archive.tar.cpp" is C++)
+- A leading dot is part of the name: ".cpp" has no extension, ".hidden.cpp" is C++
+- Names without an extension, and dots in directory names (either separator), match nothing
+
+Testing rationale: Every discovered file goes through this lookup, which
+replaced a scan over all languages with one hash probe per dotted suffix,
+so the suffix walk must pick the same language the scan would have.
+*/
+void test_language_for_file_suffixes() {
+  DynamicLanguageLoader loader;
+  const std::string grammar = R"("library": "cesium-test-missing-grammar", "function": "tree_sitter_cpp")";
+  TEST_ASSERT_TRUE(registerTestLanguage(loader, "cpp", "{" + grammar + R"(, "extensions": [".cpp", ".h"]})") &&
+                   registerTestLanguage(loader, "configured_header", "{" + grammar + R"(, "extensions": [".h.in"]})") &&
+                   registerTestLanguage(loader, "template", "{" + grammar + R"(, "extensions": [".in"]})"),
+                   "suffix_languages_registered");
+
+  auto languageOf = [&](const std::string& path) { return loader.getLanguageForFile(path).first; };
+  TEST_ASSERT_EQ(std::string("cpp"), languageOf("src/shape.cpp"), "suffix_plain_extension");
+  TEST_ASSERT_EQ(std::string("configured_header"), languageOf("include/config.h.in"), "suffix_compound_wins");
+  TEST_ASSERT_EQ(std::string("template"), languageOf("Doxyfile.in"), "suffix_shorter_match");
+  TEST_ASSERT_EQ(std::string("cpp"), languageOf("archive.tar.cpp"), "suffix_unknown_prefix_falls_back");
+  TEST_ASSERT_EQ(std::string(""), languageOf("src/.cpp"), "suffix_leading_dot_is_name");
+  TEST_ASSERT_EQ(std::string("cpp"), languageOf(".hidden.cpp"), "suffix_hidden_file_with_extension");
+  TEST_ASSERT_EQ(std::string(""), languageOf("Makefile"), "suffix_no_extension");
+  TEST_ASSERT_EQ(std::string(""), languageOf("build.cpp/Makefile"), "suffix_dot_in_directory_ignored");
+  TEST_ASSERT_EQ(std::string(""), languageOf("build.cpp\\Makefile"), "suffix_dot_in_windows_directory_ignored");
+  TEST_ASSERT_EQ(std::string(""), languageOf("notes.txt"), "suffix_unknown_extension");
+  TEST_ASSERT_TRUE(loader.getLanguageForFile("a/b.h").second != nullptr, "suffix_match_returns_language");
+}
+
+/**
+@brief Tests that configured languages are loaded on first use
+
+Requirements tested:
+- Registering a language loads nothing; the first file of the language loads it
+- A language whose "function" is a built-in grammar uses it without loading its library
+- "builtin": false skips the built-in grammar, so a missing library fails the load
+- A failed load is reported once and not retried for later files
+
+Testing rationale: Startup only records languages, so a grammar nobody's files
+use is never opened, and a broken one must not cost a library search (and an
+error) per file.
+*/
+void test_lazy_language_loading() {
+  const std::string log_dir = "test_lazy_languages";
+  const std::string log_path = log_dir + "/cesium.log";
+  std::filesystem::remove_all(log_dir);
+  LoggingConfig log_config;
+  log_config.console_level = MessageType::Error;
+  log_config.file_level = MessageType::Error;
+  log_config.log_file = log_path;
+  log_config.max_file_size_mb = 0;
+  CLILogger::configure(log_config);
+
+  DynamicLanguageLoader loader;
+  TEST_ASSERT_TRUE(registerTestLanguage(loader, "cpp", R"({"library": "cesium-test-missing-grammar",
+                     "function": "tree_sitter_cpp", "extensions": [".cpp"]})") &&
+                   registerTestLanguage(loader, "strict", R"({"library": "cesium-test-missing-grammar",
+                     "function": "tree_sitter_cpp", "extensions": [".strict"], "builtin": false})"),
+                   "lazy_languages_registered");
+  TEST_ASSERT_TRUE(loader.getLoadedLanguages().empty(), "lazy_nothing_loaded_at_registration");
+
+  auto [name, info] = loader.getLanguageForFile("src/shape.cpp");
+  TEST_ASSERT_TRUE(name == "cpp" && info && loader.getLoadedLanguages().size() == 1, "lazy_loaded_on_first_use");
+  TEST_ASSERT_TRUE(info && info->language == findBuiltinGrammar("tree_sitter_cpp") && !info->library.isValid(),
+                   "lazy_builtin_grammar_used");
+  TEST_ASSERT_TRUE(loader.getLanguageForFile("src/other.cpp").second == info, "lazy_loaded_language_reused");
+
+  TEST_ASSERT_TRUE(loader.getLanguageForFile("a.strict").second == nullptr, "lazy_builtin_disabled_fails");
+  TEST_ASSERT_TRUE(loader.getLanguageForFile("b.strict").second == nullptr, "lazy_failed_load_stays_failed");
+  TEST_ASSERT_EQ(size_t(1), loader.getLoadedLanguages().size(), "lazy_failed_language_not_loaded");
+
+  CLILogger::flush();
+  size_t load_errors = 0;
+  std::ifstream log(log_path);
+  for (std::string line; std::getline(log, line);) {
+    if (line.find("Failed to load cesium-test-missing-grammar") != std::string::npos) load_errors++;
+  }
+  TEST_ASSERT_EQ(size_t(1), load_errors, "lazy_failed_load_not_retried");
+
+  CLILogger::configure(LoggingConfig{});
+  std::filesystem::remove_all(log_dir);
+}
+
+void run_ast_extraction_tests() {
+  RUN_TEST(test_fused_block_docstrings);
+  RUN_TEST(test_fused_line_docstrings);
+  RUN_TEST(test_include_collection);
+  RUN_TEST(test_interned_construct_strings);
+  RUN_TEST(test_cross_file_merge);
+  RUN_TEST(test_declaration_definition_merge);
+  RUN_TEST(test_deeply_nested_extraction);
+  RUN_TEST(test_doc_association_sweep);
+  RUN_TEST(test_nearest_docstring_matching);
+  RUN_TEST(test_indexed_docstring_lookup);
+  RUN_TEST(test_parse_deadline);
+  RUN_TEST(test_parser_memory_peak);
+  RUN_TEST(test_extraction_budget);
+  RUN_TEST(test_language_for_file_suffixes);
+  RUN_TEST(test_lazy_language_loading);
+}
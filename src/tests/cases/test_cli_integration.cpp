@@ -3,6 +3,9 @@
 */
 #include <filesystem>
 #include <fstream>
+#include <map>
+#include <backend/core/dynlib.h>
+#include <backend/doc/cesium_doc.h>
 #include <backend/doc/doc_cli.h>
 #include "../testfrmwk/simple_test.h"
 
@@ -235,6 +238,18 @@ void test_cli_no_arguments() {
   TEST_ASSERT_TRUE(result >= 0, "cli_no_args_handled_gracefully");
 }
 
+void test_cli_extract_with_jobs() {
+  CesiumDocCLI cli;
+
+  const char* argv[] = {"doc", "extract", "--config", integration_config_file.c_str(), "--jobs", "4"};
+  int result = cli.run(6, const_cast<char**>(argv));
+  TEST_ASSERT_EQ(result, 0, "cli_extract_parallel_jobs_success");
+
+  const char* bad_argv[] = {"doc", "extract", "--config", integration_config_file.c_str(), "--jobs", "many"};
+  int bad_result = cli.run(6, const_cast<char**>(bad_argv));
+  TEST_ASSERT_EQ(bad_result, 1, "cli_extract_rejects_invalid_jobs");
+}
+
 void test_end_to_end_documentation_generation() {
   CesiumDocCLI cli;
 
@@ -272,17 +287,231 @@ void test_end_to_end_documentation_generation() {
   TEST_ASSERT_TRUE(found_math_utils_class, "e2e_found_class_doc");
 }
 
+/**
+@brief Tests the cesium-doc shared library loaded through dynlib
+
+Requirements tested:
+- The library loads by path and exports every function of the C interface
+- Its interface version matches the header
+- An unsaved buffer is extracted without the file existing, and its constructs come back as JSON
+- Paths without a language and null arguments are reported by status
+- A buffer's result is never stored in a configured shared cache
+
+Testing rationale: Editors call the library through their FFI with nothing
+but the header, so the exported names, statuses and JSON format are the
+contract and must work from a freshly loaded library.
+*/
+void test_embedded_extract_buffer() {
+#ifdef CESIUM_DOC_LIBRARY
+  dynlib::DynLib library = dynlib::loadDynLib(CESIUM_DOC_LIBRARY);
+  TEST_ASSERT_TRUE(library.isValid(), "embed_library_loaded");
+  if (!library) return;
+
+  auto api_version = library.getFunc<cesium_doc_api_version_fn>("cesium_doc_api_version");
+  auto open = library.getFunc<cesium_doc_open_fn>("cesium_doc_open");
+  auto close = library.getFunc<cesium_doc_close_fn>("cesium_doc_close");
+  auto extract_buffer = library.getFunc<cesium_doc_extract_buffer_fn>("cesium_doc_extract_buffer");
+  auto forget = library.getFunc<cesium_doc_forget_fn>("cesium_doc_forget");
+  auto free_text = library.getFunc<cesium_doc_free_fn>("cesium_doc_free");
+  auto last_error = library.getFunc<cesium_doc_last_error_fn>("cesium_doc_last_error");
+  TEST_ASSERT_TRUE(api_version && open && close && extract_buffer && forget && free_text && last_error &&
+                   library.getFunc<cesium_doc_extract_files_fn>("cesium_doc_extract_files"),
+                   "embed_functions_exported");
+  if (!api_version || !open || !close || !extract_buffer || !forget || !free_text || !last_error) return;
+  TEST_ASSERT_EQ(uint32_t(CESIUM_DOC_API_VERSION), api_version(), "embed_api_version");
+
+  cesium_doc* doc = open(integration_config_file.c_str());
+  TEST_ASSERT_TRUE(doc != nullptr, "embed_extractor_opened");
+  if (!doc) return;
+
+  std::string buffer = "/**\nDivide two numbers\n@param a Dividend\n*/\nint divide(int a, int b);\n";
+  std::string path = integration_test_dir + "/src/unsaved.cpp";
+  char* json = nullptr;
+  size_t json_length = 0;
+  cesium_doc_status status = extract_buffer(doc, path.c_str(), buffer.data(), buffer.size(), &json, &json_length);
+  TEST_ASSERT_EQ(int(CESIUM_DOC_OK), int(status), "embed_buffer_extracted");
+  std::string constructs = json ? std::string(json, json_length) : std::string();
+  free_text(json);
+  TEST_ASSERT_TRUE(constructs.starts_with("[") && constructs.find("\"full_name\":\"divide\"") != std::string::npos &&
+                   constructs.find("Divide two numbers") != std::string::npos, "embed_buffer_constructs_returned");
+  TEST_ASSERT_FALSE(std::filesystem::exists(path), "embed_buffer_not_written");
+
+  // A second call for the same path (an edit) reuses nothing stale
+  buffer.replace(buffer.find("divide"), 6, "quotient");
+  status = extract_buffer(doc, path.c_str(), buffer.data(), buffer.size(), &json, &json_length);
+  constructs = json ? std::string(json, json_length) : std::string();
+  free_text(json);
+  TEST_ASSERT_TRUE(status == CESIUM_DOC_OK && constructs.find("\"full_name\":\"quotient\"") != std::string::npos &&
+                   constructs.find("\"full_name\":\"divide\"") == std::string::npos, "embed_edited_buffer_extracted");
+  forget(doc, path.c_str());
+
+  TEST_ASSERT_EQ(int(CESIUM_DOC_NO_LANGUAGE), int(extract_buffer(doc, "notes.txt", "text", 4, &json, nullptr)),
+                 "embed_unknown_language_reported");
+  TEST_ASSERT_TRUE(std::string(last_error(doc)).find("notes.txt") != std::string::npos, "embed_last_error_set");
+  TEST_ASSERT_EQ(int(CESIUM_DOC_INVALID_ARGUMENT), int(extract_buffer(doc, nullptr, "", 0, &json, nullptr)),
+                 "embed_null_path_rejected");
+  close(doc);
+
+  // Unsaved buffers are never stored in a shared cache
+  std::string shared_dir = integration_test_dir + "/shared";
+  std::string shared_config = integration_test_dir + "/shared_config.json";
+  {
+    std::ifstream base(integration_config_file);
+    std::string config((std::istreambuf_iterator<char>(base)), std::istreambuf_iterator<char>());
+    config.insert(config.rfind('}'), ",\n    \"shared_cache\": \"" + shared_dir + "/\"\n");
+    std::ofstream(shared_config) << config;
+  }
+  doc = open(shared_config.c_str());
+  TEST_ASSERT_TRUE(doc != nullptr, "embed_shared_cache_extractor_opened");
+  if (!doc) return;
+  status = extract_buffer(doc, path.c_str(), buffer.data(), buffer.size(), &json, &json_length);
+  free_text(status == CESIUM_DOC_OK ? json : nullptr);
+  TEST_ASSERT_EQ(int(CESIUM_DOC_OK), int(status), "embed_shared_cache_buffer_extracted");
+  TEST_ASSERT_FALSE(std::filesystem::exists(shared_dir), "embed_buffer_not_shared");
+  close(doc);
+#endif
+}
+
+/**
+@brief Tests that streaming extraction writes the same pages as extracting everything at once
+
+Requirements tested:
+- With one worker, streaming splits the files into several batches (four files each)
+- Declarations in early batches merge with definitions in later ones, including a
+  construct the per-file pass already merged
+- Overloads declared in one batch and defined in another keep a page each
+- Every page, and its content, matches the non-streaming run
+
+Testing rationale: Streaming replaces the single cross-file merge with spilled
+constructs merged batch by batch, which is only correct if no reader can tell
+which mode produced the pages.
+*/
+void test_streaming_extraction_matches_full() {
+  const std::string root = "streaming_test";
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root + "/src");
+
+  // Headers sort before sources, so each definition lands in a later batch than its declaration
+  for (int i = 0; i < 6; ++i) {
+    std::string n = std::to_string(i);
+    std::ofstream header(root + "/src/a_shape" + n + ".h");
+    header << "/** Area of shape " << n << " */\nint area" << n << "();\n"
+           << "/** Shared helper, declared in " << n << " */\nint helper" << n << "(int x);\n"
+           << "/** Scales by a whole factor */\nint scale" << n << "(int factor);\n"
+           << "/** Scales by a ratio */\nint scale" << n << "(double factor);\n";
+    std::ofstream source(root + "/src/b_shape" + n + ".cpp");
+    source << "/** Local declaration " << n << " */\nint helper" << n << "(int x);\n"
+           << "/** Computes area " << n << " */\nint area" << n << "() { return " << n << "; }\n"
+           << "/** Doubles x */\nint helper" << n << "(int x) { return 2 * x; }\n"
+           << "/** Rounds down */\nint scale" << n << "(double factor) { return int(factor); }\n";
+  }
+
+  std::map<std::string, std::map<std::string, std::string>> pages;
+  for (bool streaming : {false, true}) {
+    std::string mode = streaming ? "streamed" : "full";
+    std::string config_path = root + "/" + mode + ".json";
+    std::ofstream config(config_path);
+    config << R"({
+      "languages": {"cpp": {"library": "../build/bin/tree-sitter-cpp.so", "function": "tree_sitter_cpp",
+                            "extensions": [".cpp", ".h"], "docstring_style": "/** */"}},
+      "source_directories": [")" << root << R"(/src/"],
+      "output_directory": ")" << root << "/" << mode << R"(_out/",
+      "extract_directory": ")" << root << "/" << mode << R"(/",
+      "streaming_extraction": )" << (streaming ? "true" : "false") << "}";
+    config.close();
+
+    CesiumDocCLI cli;
+    const char* argv[] = {"doc", "extract", "--config", config_path.c_str(), "--jobs", "1"};
+    TEST_ASSERT_EQ(0, cli.run(6, const_cast<char**>(argv)), "streaming_extract_succeeds_" + mode);
+
+    for (const auto& entry : std::filesystem::directory_iterator(root + "/" + mode)) {
+      if (entry.path().extension() != ".md") continue;
+      std::ifstream page(entry.path(), std::ios::binary);
+      pages[mode][entry.path().filename().string()].assign(std::istreambuf_iterator<char>(page),
+                                                           std::istreambuf_iterator<char>());
+    }
+  }
+
+  TEST_ASSERT_TRUE(pages["full"].size() >= 24, "streaming_full_run_writes_pages");
+  TEST_ASSERT_TRUE(pages["full"] == pages["streamed"], "streaming_pages_identical");
+  std::string helper;
+  std::vector<std::string> scales;
+  for (const auto& [name, content] : pages["streamed"]) {
+    if (name.starts_with("helper5~")) helper = content;
+    if (name.starts_with("scale5~")) scales.push_back(content);
+  }
+  TEST_ASSERT_TRUE(helper.find("declared in 5") != std::string::npos && helper.find("Doubles x") != std::string::npos &&
+                   helper.find("Local declaration 5") != std::string::npos, "streaming_merges_across_batches");
+  // Each overload merges only with its own definition, on a page of its own
+  TEST_ASSERT_EQ(size_t(2), scales.size(), "streaming_overloads_get_own_pages");
+  TEST_ASSERT_TRUE(scales.size() == 2 &&
+                   (scales[0].find("Rounds down") != std::string::npos) != (scales[1].find("Rounds down") != std::string::npos),
+                   "streaming_overloads_not_merged");
+  TEST_ASSERT_FALSE(std::filesystem::exists(root + "/streamed/.cesium-spill.ndjson"), "streaming_spill_removed");
+
+  std::filesystem::remove_all(root);
+}
+
+/**
+@brief Tests that a missing search document table reprocesses every source without forgetting the cache
+
+Requirements tested:
+- Without .cesium-search.docs, extract processes every source and writes the table again
+- The cache still knows the outputs of a source deleted meanwhile, so its page is pruned
+
+Testing rationale: Every entry point loads the configuration, but only extract
+rebuilds anything, so clearing the cache on load forgot the pages of deleted
+sources for good.
+*/
+void test_missing_search_documents_reextract() {
+  const std::string root = "search_reextract_test";
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root + "/src");
+  std::ofstream(root + "/src/alpha.cpp") << "/** First function */\nint alpha() { return 1; }\n";
+  std::ofstream(root + "/src/beta.cpp") << "/** Second function */\nint beta() { return 2; }\n";
+  std::string config_path = root + "/config.json";
+  std::ofstream(config_path) << R"({
+    "languages": {"cpp": {"library": "../build/bin/tree-sitter-cpp.so", "function": "tree_sitter_cpp",
+                          "extensions": [".cpp"], "docstring_style": "/** */"}},
+    "source_directories": [")" << root << R"(/src/"],
+    "output_directory": ")" << root << R"(/out/",
+    "extract_directory": ")" << root << R"(/extract/",
+    "search_index": true
+  })";
+
+  const char* argv[] = {"doc", "extract", "--config", config_path.c_str()};
+  CesiumDocCLI first;
+  TEST_ASSERT_EQ(0, first.run(4, const_cast<char**>(argv)), "search_first_extract_succeeds");
+  std::string table = root + "/extract/.cesium-search.docs";
+  TEST_ASSERT_TRUE(std::filesystem::exists(table) && std::filesystem::exists(root + "/extract/beta.md"),
+                   "search_first_extract_writes_table");
+
+  std::filesystem::remove(table);
+  std::filesystem::remove(root + "/src/beta.cpp");
+  CesiumDocCLI second;
+  TEST_ASSERT_EQ(0, second.run(4, const_cast<char**>(argv)), "search_reextract_succeeds");
+  TEST_ASSERT_TRUE(std::filesystem::exists(table), "search_table_rewritten");
+  TEST_ASSERT_TRUE(std::filesystem::exists(root + "/extract/alpha.md"), "search_reextract_keeps_pages");
+  TEST_ASSERT_FALSE(std::filesystem::exists(root + "/extract/beta.md"), "deleted_source_page_pruned");
+
+  std::filesystem::remove_all(root);
+}
+
 void run_cli_integration_tests() {
   setupIntegrationTest();
 
-  test_cli_generate_command();
-  test_cli_list_parsers_command();
-  test_cli_init_config_command();
-  test_cli_invalid_command();
-  test_cli_generate_with_missing_config();
-  test_cli_generate_with_malformed_config();
-  test_cli_no_arguments();
-  test_end_to_end_documentation_generation();
+  RUN_TEST(test_cli_generate_command);
+  RUN_TEST(test_cli_list_parsers_command);
+  RUN_TEST(test_cli_init_config_command);
+  RUN_TEST(test_cli_invalid_command);
+  RUN_TEST(test_cli_generate_with_missing_config);
+  RUN_TEST(test_cli_generate_with_malformed_config);
+  RUN_TEST(test_cli_no_arguments);
+  RUN_TEST(test_cli_extract_with_jobs);
+  RUN_TEST(test_end_to_end_documentation_generation);
+  RUN_TEST(test_streaming_extraction_matches_full);
+  RUN_TEST(test_missing_search_documents_reextract);
+  RUN_TEST(test_embedded_extract_buffer);
 
   teardownIntegrationTest();
 }
@@ -276,14 +276,187 @@ std::vector<T> processData(const std::vector<T>& data,
   std::cout << "Tags check completed" << std::endl;
 }
 
+/**
+@brief Tests Doxygen backslash tags and decorated block comments
+
+Requirements tested:
+- \param, \return and \brief are recognized like their @ counterparts
+- Leading '*' decoration on each line is stripped before tag matching
+- An '@' in the middle of a description line is not treated as a tag
+
+Testing rationale: The linear scanner only recognizes tags at the start of a line,
+so both tag prefixes and the common star-decorated layout must keep working.
+*/
+void test_parse_doxygen_backslash_tags() {
+  std::string content = R"(
+/**
+ * Send a report to maintainer@example.com
+ * \param recipient Address to deliver to
+ * \returns True when the report was queued
+ * \since 1.2
+ */
+bool sendReport(const std::string& recipient);
+)";
+
+  auto blocks = parser.extractDocstrings(content, "/** */");
+  TEST_ASSERT_EQ(blocks.size(), 1, "doxygen_block_size");
+  if (blocks.empty()) return;
+
+  TEST_ASSERT_EQ(blocks[0].description, "Send a report to maintainer@example.com", "doxygen_desc_keeps_inline_at");
+  TEST_ASSERT_EQ(blocks[0].params.at("recipient"), "Address to deliver to", "doxygen_param");
+  TEST_ASSERT_EQ(blocks[0].return_desc, "True when the report was queued", "doxygen_returns");
+  TEST_ASSERT_EQ(blocks[0].tags.size(), 1, "doxygen_tags_size");
+  TEST_ASSERT_EQ(blocks[0].tags[0], "since: 1.2", "doxygen_generic_tag");
+}
+
+/**
+@brief Tests that very long comments and empty comments are scanned safely
+
+Requirements tested:
+- A license-sized block comment is parsed without recursion issues
+- An empty plain comment (slash, two stars, slash) does not open a docstring
+- An unterminated docstring at end of file is ignored
+
+Testing rationale: Recursive regex matching overflowed the stack on long license
+headers, and the replacement scanner must handle the same inputs in linear time.
+*/
+void test_parse_long_and_degenerate_comments() {
+  std::string license = "/**\n";
+  for (int i = 0; i < 20000; i++) {
+    license += " * Permission is hereby granted, free of charge, to any person obtaining a copy\n";
+  }
+  license += " * @file license.h\n */\nint licensed;\n";
+
+  auto blocks = parser.extractDocstrings(license, "/** */");
+  TEST_ASSERT_EQ(blocks.size(), 1, "long_comment_size");
+  if (!blocks.empty()) {
+    TEST_ASSERT_EQ(blocks[0].override_file, "license.h", "long_comment_file_tag");
+  }
+
+  std::string degenerate = "/**/ int a;\n/** Real docstring */ int b;\n/** unterminated";
+  blocks = parser.extractDocstrings(degenerate, "/** */");
+  TEST_ASSERT_EQ(blocks.size(), 1, "degenerate_comments_size");
+  if (!blocks.empty()) {
+    TEST_ASSERT_EQ(blocks[0].description, "Real docstring", "degenerate_real_docstring");
+  }
+}
+
+/**
+@brief Tests that the regex fallback scanner produces the same blocks as the linear scanner
+
+Requirements tested:
+- Both scanners find the same number of blocks
+- Descriptions, parameters and return values agree
+
+Testing rationale: The regex path is kept as a fallback, so switching scanners via
+configuration must not change the generated documentation.
+*/
+void test_regex_fallback_matches_linear_scanner() {
+  std::string content = R"(
+/**
+Scale a vector in place
+@param v Vector to scale
+@param factor Scale factor
+@return Reference to v
+@see normalize
+*/
+Vec& scale(Vec& v, float factor);
+
+/// Line documented helper
+/// @param x Input
+void helper(int x);
+)";
+
+  DocstringParser regex_parser;
+  regex_parser.setScanner(DocstringScanner::Regex);
+
+  for (const std::string style : {"/** */", "/// "}) {
+    auto linear_blocks = parser.extractDocstrings(content, style);
+    auto regex_blocks = regex_parser.extractDocstrings(content, style);
+    TEST_ASSERT_EQ(linear_blocks.size(), regex_blocks.size(), "fallback_block_count");
+    for (size_t i = 0; i < linear_blocks.size() && i < regex_blocks.size(); i++) {
+      TEST_ASSERT_EQ(linear_blocks[i].description, regex_blocks[i].description, "fallback_description");
+      TEST_ASSERT_TRUE(linear_blocks[i].params == regex_blocks[i].params, "fallback_params");
+      TEST_ASSERT_EQ(linear_blocks[i].return_desc, regex_blocks[i].return_desc, "fallback_return");
+      TEST_ASSERT_TRUE(linear_blocks[i].tags == regex_blocks[i].tags, "fallback_tags");
+    }
+  }
+}
+
+/**
+@brief Tests that docstring locations come from the shared line index
+
+Requirements tested:
+- Block comment locations report a 1-based line and 0-based column
+- Line comment runs report the location of their first line
+- LineIndex maps offsets on line boundaries and past the end consistently
+
+Testing rationale: Comment scanners and tree-sitter edits share LineIndex, so its
+numbering must match the SourceLocation contract exactly.
+*/
+void test_docstring_locations() {
+  std::string content = "int a;\n  /** Indented doc */\nint b;\n/// Line doc\n/// continued\nint c;\n";
+
+  auto blocks = parser.extractDocstrings(content, "/** */");
+  TEST_ASSERT_EQ(blocks.size(), 1, "location_block_size");
+  if (!blocks.empty()) {
+    TEST_ASSERT_EQ(blocks[0].location.line, 2, "location_block_line");
+    TEST_ASSERT_EQ(blocks[0].location.column, 2, "location_block_column");
+    TEST_ASSERT_EQ(blocks[0].location.byte_offset, 9, "location_block_offset");
+  }
+
+  blocks = parser.extractDocstrings(content, "/// ");
+  TEST_ASSERT_EQ(blocks.size(), 1, "location_line_comment_size");
+  if (!blocks.empty()) {
+    TEST_ASSERT_EQ(blocks[0].location.line, 4, "location_line_comment_line");
+    TEST_ASSERT_EQ(blocks[0].location.column, 0, "location_line_comment_column");
+  }
+
+  LineIndex lines(content);
+  TEST_ASSERT_EQ(lines.lineCount(), 7, "line_index_count");
+  TEST_ASSERT_EQ(lines.locate(6).line, 1, "line_index_newline_on_own_line");
+  TEST_ASSERT_EQ(lines.locate(7).line, 2, "line_index_next_line_start");
+  TEST_ASSERT_EQ(lines.locate(content.size() + 10).line, 7, "line_index_clamped_line");
+  TEST_ASSERT_EQ(lines.lineStart(3), 29, "line_index_line_start");
+}
+
+/**
+@brief Tests that scanning a large file for docstrings stays within its time budget
+
+Requirements tested:
+- 5000 documented functions with parameter and return tags are scanned within budget
+- Every block is found
+
+Testing rationale: Docstring scanning runs on every extracted file; a
+regression to quadratic scanning only shows on large files, so the suite
+fails when it happens rather than when someone notices slow CI.
+*/
+void test_docstring_scan_budget() {
+  std::string content;
+  for (int i = 0; i < 5000; ++i) {
+    std::string name = "function" + std::to_string(i);
+    content += "/**\nCompute " + name + "\n@param a First value\n@param b Second value\n@return The result\n*/\n";
+    content += "int " + name + "(int a, int b) { return a + b; }\n\n";
+  }
+
+  std::vector<DocstringBlock> blocks;
+  TEST_ASSERT_WITHIN_MS(500, "docstring_scan_within_budget", blocks = parser.extractDocstrings(content, "/** */"));
+  TEST_ASSERT_EQ(blocks.size(), 5000, "docstring_scan_finds_every_block");
+}
+
 void run_docstring_parser_tests() {
-  test_parse_block_comment();
-  test_parse_multiple_block_comments();
-  test_parse_simple_block_comment();
-  test_parse_class_documentation();
-  test_parse_line_comments();
-  test_parse_python_docstrings();
-  test_parse_empty_content();
-  test_parse_content_without_javadoc();
-  test_parse_complex_javadoc();
+  RUN_TEST(test_parse_block_comment);
+  RUN_TEST(test_parse_multiple_block_comments);
+  RUN_TEST(test_parse_simple_block_comment);
+  RUN_TEST(test_parse_class_documentation);
+  RUN_TEST(test_parse_line_comments);
+  RUN_TEST(test_parse_python_docstrings);
+  RUN_TEST(test_parse_empty_content);
+  RUN_TEST(test_parse_content_without_javadoc);
+  RUN_TEST(test_parse_complex_javadoc);
+  RUN_TEST(test_parse_doxygen_backslash_tags);
+  RUN_TEST(test_parse_long_and_degenerate_comments);
+  RUN_TEST(test_regex_fallback_matches_linear_scanner);
+  RUN_TEST(test_docstring_locations);
+  RUN_TEST(test_docstring_scan_budget);
 }
@@ -0,0 +1,583 @@
+/**
+@brief Tests for documentation cache change detection and content hashing
+*/
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <backend/core/hash.h>
+#include <backend/doc/cache.h>
+#include <backend/doc/shared_cache.h>
+#include "../testfrmwk/simple_test.h"
+
+static const std::string cache_test_dir = "test_cache_output";
+
+static void writeCacheTestFile(const std::string& path, const std::string& content) {
+  std::ofstream file(path, std::ios::binary);
+  file << content;
+}
+
+/**
+@brief Tests the streaming XXH64 implementation against reference digests
+
+Requirements tested:
+- Digests match the published XXH64 reference values (seed 0)
+- Feeding input in small chunks yields the same digest as a one-shot hash
+- File digests carry the "xxh64:" prefix
+
+Testing rationale: Cache hashes are persisted, so they must be stable across
+builds and platforms and independent of how the file was read.
+*/
+void test_xxh64_reference_vectors() {
+  TEST_ASSERT_EQ(hashing::toHex(hashing::xxh64("")), "ef46db3751d8e999", "xxh64_empty");
+  TEST_ASSERT_EQ(hashing::toHex(hashing::xxh64("abc")), "44bc2cf5ad770999", "xxh64_abc");
+  TEST_ASSERT_EQ(hashing::toHex(hashing::xxh64("Nobody inspects the spammish repetition")), "fbcea83c8a378bf1",
+                 "xxh64_multi_stripe");
+
+  std::string data(100000, '\0');
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<char>(i * 31 + 7);
+  }
+  hashing::XXH64 streaming;
+  for (size_t i = 0; i < data.size(); i += 7) {
+    streaming.update(data.data() + i, std::min<size_t>(7, data.size() - i));
+  }
+  TEST_ASSERT_TRUE(streaming.digest() == hashing::xxh64(data), "xxh64_chunked_matches_oneshot");
+
+  std::filesystem::create_directories(cache_test_dir);
+  std::string path = cache_test_dir + "/hashed.bin";
+  writeCacheTestFile(path, data);
+  auto file_hash = hashing::hashFile(path);
+  TEST_ASSERT_TRUE(file_hash.has_value() && *file_hash == hashing::hashString(data), "xxh64_file_matches_string");
+  TEST_ASSERT_TRUE(!hashing::hashFile(cache_test_dir + "/missing.bin").has_value(), "xxh64_missing_file");
+  std::filesystem::remove_all(cache_test_dir);
+}
+
+/**
+@brief Tests needsExtraction under the stat and content hash policies
+
+Requirements tested:
+- A freshly recorded file does not need extraction
+- Touching a file without changing its content does not trigger extraction
+- Changing content triggers extraction
+- The content policy detects edits that keep mtime and size unchanged
+
+Testing rationale: The stat short-circuit avoids redundant hashing, while the
+content policy remains available when timestamps cannot be trusted.
+*/
+void test_cache_hash_policies() {
+  std::filesystem::create_directories(cache_test_dir);
+  std::string source = cache_test_dir + "/source.cpp";
+  writeCacheTestFile(source, "int a;\n");
+
+  DocumentationCache cache(cache_test_dir + "/.cesium-cache.json");
+  cache.updateFile(source, {}, 1, "cpp");
+  TEST_ASSERT_FALSE(cache.needsExtraction(source), "cache_fresh_file_up_to_date");
+
+  // Touch only: the hash still matches
+  auto original_time = std::filesystem::last_write_time(source);
+  std::filesystem::last_write_time(source, original_time + std::chrono::seconds(10));
+  TEST_ASSERT_FALSE(cache.needsExtraction(source), "cache_touched_file_up_to_date");
+
+  // Same-size edit with the timestamp restored is invisible to the stat check
+  auto touched_time = std::filesystem::last_write_time(source);
+  writeCacheTestFile(source, "int b;\n");
+  std::filesystem::last_write_time(source, touched_time);
+  TEST_ASSERT_FALSE(cache.needsExtraction(source), "cache_stat_policy_trusts_stat");
+
+  cache.setHashPolicy(HashPolicy::Content);
+  TEST_ASSERT_TRUE(cache.needsExtraction(source), "cache_content_policy_detects_edit");
+
+  cache.setHashPolicy(HashPolicy::Stat);
+  writeCacheTestFile(source, "int changed;\n");
+  TEST_ASSERT_TRUE(cache.needsExtraction(source), "cache_edit_needs_extraction");
+
+  HashPolicy parsed = HashPolicy::Stat;
+  TEST_ASSERT_TRUE(DocumentationCache::parseHashPolicy("content", parsed) && parsed == HashPolicy::Content,
+                   "cache_parse_content_policy");
+  TEST_ASSERT_FALSE(DocumentationCache::parseHashPolicy("sha256", parsed), "cache_parse_unknown_policy");
+
+  std::filesystem::remove_all(cache_test_dir);
+}
+
+/**
+@brief Tests saving, mapping and updating the binary cache format
+
+Requirements tested:
+- Entries saved in binary format are found again after reloading
+- Updates and removals made after loading are persisted by the next save
+- A corrupted binary cache is rejected and the JSON cache is used instead
+- JSON export includes entries served from the mapped file
+
+Testing rationale: The binary cache replaces JSON parsing on startup, so it must
+round-trip every field the change detection and pruning logic depend on.
+*/
+void test_binary_cache_round_trip() {
+  std::filesystem::create_directories(cache_test_dir);
+  std::string cache_file = cache_test_dir + "/.cesium-cache.json";
+  std::string first = cache_test_dir + "/first.cpp";
+  std::string second = cache_test_dir + "/second.cpp";
+  std::string output = cache_test_dir + "/first_output.md";
+  writeCacheTestFile(first, "void first();\n");
+  writeCacheTestFile(second, "void second();\n");
+  writeCacheTestFile(output, "# first\n");
+
+  {
+    DocumentationCache cache(cache_file);
+    cache.setFormat(CacheFormat::Binary);
+    cache.updateFile(first, {output}, 3, "cpp", {}, {"xxh64:0123456789abcdef"});
+    cache.updateFile(second, {}, 1, "cpp");
+    TEST_ASSERT_TRUE(cache.save(), "binary_cache_saved");
+  }
+  TEST_ASSERT_TRUE(std::filesystem::exists(cache_test_dir + "/.cesium-cache.bin"), "binary_cache_file_written");
+  TEST_ASSERT_FALSE(std::filesystem::exists(cache_file), "binary_cache_no_json_written");
+
+  {
+    DocumentationCache cache(cache_file);
+    cache.setFormat(CacheFormat::Binary);
+    TEST_ASSERT_TRUE(cache.load(), "binary_cache_loaded");
+    TEST_ASSERT_FALSE(cache.needsExtraction(first), "binary_cache_entry_up_to_date");
+    auto [file_count, generated_count] = cache.getStats();
+    TEST_ASSERT_TRUE(file_count == 2 && generated_count == 1, "binary_cache_stats");
+    TEST_ASSERT_TRUE(cache.verifyIntegrity(cache_test_dir), "binary_cache_integrity");
+    TEST_ASSERT_EQ(cache.recordedOutputHashes()[output], "xxh64:0123456789abcdef", "binary_cache_output_hash_round_trip");
+
+    cache.removeFile(second);
+    TEST_ASSERT_TRUE(cache.needsExtraction(second), "binary_cache_removed_entry_needs_extraction");
+    TEST_ASSERT_TRUE(cache.save(), "binary_cache_resaved");
+
+    std::string export_path = cache_test_dir + "/export.json";
+    TEST_ASSERT_TRUE(cache.exportJson(export_path), "binary_cache_exported");
+    std::ifstream exported(export_path);
+    std::string json((std::istreambuf_iterator<char>(exported)), std::istreambuf_iterator<char>());
+    TEST_ASSERT_TRUE(json.find("first.cpp") != std::string::npos && json.find("second.cpp") == std::string::npos,
+                     "binary_cache_export_contents");
+  }
+
+  {
+    DocumentationCache cache(cache_file);
+    cache.setFormat(CacheFormat::Binary);
+    TEST_ASSERT_TRUE(cache.load(), "binary_cache_reloaded");
+    TEST_ASSERT_TRUE(cache.getStats().first == 1, "binary_cache_removal_persisted");
+  }
+
+  // A truncated binary cache must not be trusted
+  std::filesystem::resize_file(cache_test_dir + "/.cesium-cache.bin", 40);
+  {
+    DocumentationCache cache(cache_file);
+    cache.setFormat(CacheFormat::Binary);
+    TEST_ASSERT_FALSE(cache.load(), "binary_cache_corrupt_rejected");
+    TEST_ASSERT_TRUE(cache.needsExtraction(first), "binary_cache_corrupt_forces_extraction");
+  }
+
+  std::filesystem::remove_all(cache_test_dir);
+}
+
+/**
+@brief Tests the append-only update journal and its compaction into the snapshot
+
+Requirements tested:
+- Updates and removals recorded only in the journal are replayed by load()
+- save() writes a full snapshot and deletes the journal
+- A torn trailing journal record is ignored while earlier records are kept
+- Records appended after a torn record are replayed on the next load
+
+Testing rationale: The journal is what makes an interrupted run resumable, so it
+must be replayable on its own and tolerate a record cut off by a crash.
+*/
+void test_cache_journal_replay() {
+  std::filesystem::create_directories(cache_test_dir);
+  std::string cache_file = cache_test_dir + "/.cesium-cache.json";
+  std::string first = cache_test_dir + "/first.cpp";
+  std::string second = cache_test_dir + "/second.cpp";
+  writeCacheTestFile(first, "void first();\n");
+  writeCacheTestFile(second, "void second();\n");
+
+  std::string journal_path;
+  {
+    DocumentationCache cache(cache_file);
+    journal_path = cache.journalPath();
+    cache.updateFile(first, {}, 2, "cpp");
+    cache.updateFile(second, {}, 1, "cpp");
+    cache.removeFile(second);
+    TEST_ASSERT_TRUE(cache.saveImmediately(), "journal_flushed");
+  }
+  TEST_ASSERT_FALSE(std::filesystem::exists(cache_file), "journal_no_snapshot_written");
+  TEST_ASSERT_TRUE(std::filesystem::exists(journal_path), "journal_file_written");
+
+  {
+    DocumentationCache cache(cache_file);
+    TEST_ASSERT_TRUE(cache.load(), "journal_replayed_without_snapshot");
+    TEST_ASSERT_FALSE(cache.needsExtraction(first), "journal_update_replayed");
+    TEST_ASSERT_TRUE(cache.needsExtraction(second), "journal_remove_replayed");
+    TEST_ASSERT_TRUE(cache.save(), "journal_compacted");
+  }
+  TEST_ASSERT_TRUE(std::filesystem::exists(cache_file), "journal_snapshot_written");
+  TEST_ASSERT_FALSE(std::filesystem::exists(journal_path), "journal_truncated_after_snapshot");
+
+  {
+    DocumentationCache cache(cache_file);
+    cache.load();
+    cache.updateFile(second, {}, 1, "cpp");
+  }
+  {
+    std::ofstream journal(journal_path, std::ios::app);
+    journal << "{\"op\": \"remove\", \"path\": \"" << first;
+  }
+  {
+    DocumentationCache cache(cache_file);
+    TEST_ASSERT_TRUE(cache.load(), "journal_torn_load");
+    TEST_ASSERT_FALSE(cache.needsExtraction(second), "journal_records_before_torn_line_kept");
+    TEST_ASSERT_FALSE(cache.needsExtraction(first), "journal_torn_record_ignored");
+
+    // Appended after the torn record, which must not swallow it
+    cache.removeFile(second);
+    TEST_ASSERT_TRUE(cache.saveImmediately(), "journal_append_after_torn_record");
+  }
+  {
+    DocumentationCache cache(cache_file);
+    TEST_ASSERT_TRUE(cache.load(), "journal_reload_after_torn_record");
+    TEST_ASSERT_TRUE(cache.needsExtraction(second), "journal_append_after_torn_record_replayed");
+    TEST_ASSERT_FALSE(cache.needsExtraction(first), "journal_torn_record_stays_dropped");
+  }
+
+  std::filesystem::remove_all(cache_test_dir);
+}
+
+/**
+@brief Tests that changes propagate through recorded file dependencies
+
+Requirements tested:
+- A file is re-extracted when a direct or transitive dependency changes
+- Files outside the changed file's dependents stay up to date
+- Dependency cycles (e.g. merge partners) terminate and still propagate changes
+- Dependencies survive a binary cache round trip
+- dependentsOf returns direct and transitive dependents, but not the changed file or unrelated files
+
+Testing rationale: Dependency edges are what make incremental runs trustworthy;
+a missed edge leaves stale docs, an overly eager walk rebuilds everything.
+*/
+void test_cache_dependency_invalidation() {
+  std::filesystem::create_directories(cache_test_dir);
+  std::string cache_file = cache_test_dir + "/.cesium-cache.json";
+  std::string header = cache_test_dir + "/shape.h";
+  std::string source = cache_test_dir + "/shape.cpp";
+  std::string user = cache_test_dir + "/user.cpp";
+  std::string unrelated = cache_test_dir + "/unrelated.cpp";
+  writeCacheTestFile(header, "struct Shape;\n");
+  writeCacheTestFile(source, "#include \"shape.h\"\n");
+  writeCacheTestFile(user, "#include \"shape.cpp\"\n");
+  writeCacheTestFile(unrelated, "int unrelated;\n");
+
+  {
+    DocumentationCache cache(cache_file);
+    cache.setFormat(CacheFormat::Binary);
+    // shape.h and shape.cpp share merged output, so they depend on each other
+    cache.updateFile(header, {}, 1, "cpp", {source});
+    cache.updateFile(source, {}, 1, "cpp", {header});
+    cache.updateFile(user, {}, 1, "cpp", {source});
+    cache.updateFile(unrelated, {}, 1, "cpp");
+    TEST_ASSERT_TRUE(cache.save(), "dependency_cache_saved");
+  }
+
+  {
+    DocumentationCache cache(cache_file);
+    cache.setFormat(CacheFormat::Binary);
+    TEST_ASSERT_TRUE(cache.load(), "dependency_cache_loaded");
+    TEST_ASSERT_FALSE(cache.needsExtraction(source), "dependency_cycle_unchanged_up_to_date");
+    TEST_ASSERT_FALSE(cache.needsExtraction(user), "dependency_unchanged_up_to_date");
+
+    auto dependents = cache.dependentsOf({"./" + header});
+    std::sort(dependents.begin(), dependents.end());
+    std::vector<std::string> expected = {source, user};
+    std::sort(expected.begin(), expected.end());
+    TEST_ASSERT_TRUE(dependents == expected, "dependents_of_includes_transitive");
+
+    writeCacheTestFile(header, "struct Shape { double area() const; };\n");
+    cache.beginChangeScan();
+    TEST_ASSERT_TRUE(cache.needsExtraction(header), "dependency_changed_file_needs_extraction");
+    TEST_ASSERT_TRUE(cache.needsExtraction(source), "dependency_direct_dependent_invalidated");
+    TEST_ASSERT_TRUE(cache.needsExtraction(user), "dependency_transitive_dependent_invalidated");
+    TEST_ASSERT_FALSE(cache.needsExtraction(unrelated), "dependency_unrelated_file_untouched");
+    cache.endChangeScan();
+  }
+
+  std::filesystem::remove_all(cache_test_dir);
+}
+
+/**
+@brief Tests integrity checks and pruning against the snippet archive
+
+Requirements tested:
+- In archive mode an output counts as present when the archive holds its page
+- Pages in the archive that no entry generated are reported as orphaned
+- Pruning removes orphaned pages from the archive and keeps tracked ones
+
+Testing rationale: Archive mode replaces directory scans with index lookups,
+so integrity and pruning must agree with the archive, not the directory.
+*/
+void test_cache_archive_integrity() {
+  std::filesystem::create_directories(cache_test_dir);
+  std::string cache_file = cache_test_dir + "/.cesium-cache.json";
+  std::string source = cache_test_dir + "/kept.cpp";
+  std::string archive_path = snippetArchivePath(cache_test_dir);
+  writeCacheTestFile(source, "int kept;\n");
+  TEST_ASSERT_TRUE(updateSnippetArchive(archive_path, {{"kept.md", "# kept\n"}, {"stale.md", "# stale\n"}}),
+                   "archive_written");
+
+  DocumentationCache cache(cache_file);
+  cache.setOutputMode(OutputMode::Archive);
+  cache.updateFile(source, {cache_test_dir + "/kept.md"}, 1, "cpp");
+  TEST_ASSERT_FALSE(cache.needsExtraction(source), "archived_output_counts_as_present");
+  TEST_ASSERT_FALSE(cache.verifyIntegrity(cache_test_dir), "archived_orphan_fails_integrity");
+
+  auto orphaned = cache.getOrphanedFilesInDirectory(cache_test_dir);
+  TEST_ASSERT_TRUE(orphaned.size() == 1 && orphaned[0].ends_with("stale.md"), "archived_orphan_reported");
+  TEST_ASSERT_EQ(cache.pruneOrphanedFiles(cache_test_dir), size_t(1), "archived_orphan_pruned");
+
+  SnippetArchive archive;
+  TEST_ASSERT_TRUE(archive.open(archive_path) && archive.size() == 1 && archive.contains("kept.md"),
+                   "prune_keeps_tracked_pages");
+  archive.close();
+  TEST_ASSERT_TRUE(cache.verifyIntegrity(cache_test_dir), "pruned_archive_passes_integrity");
+
+  std::filesystem::remove_all(cache_test_dir);
+}
+
+/**
+@brief Tests that the JSON snapshot and journal survive paths that need escaping
+
+Requirements tested:
+- Source and output paths containing quotes and backslashes round-trip through a JSON snapshot
+- The same paths round-trip through journal records
+- The exported snapshot is valid JSON
+
+Testing rationale: Windows paths are full of backslashes, and a hand-built
+snapshot that does not escape them cannot be loaded again.
+*/
+void test_json_cache_escaping() {
+  std::filesystem::create_directories(cache_test_dir);
+  std::string cache_file = cache_test_dir + "/.cesium-cache.json";
+  std::string source = cache_test_dir + "/we\"ird\\name.cpp";
+  std::string output = cache_test_dir + "/out\\dir/\"quoted\".md";
+  writeCacheTestFile(source, "void weird();\n");
+  std::filesystem::create_directories(std::filesystem::path(output).parent_path());
+  writeCacheTestFile(output, "# weird\n");
+
+  {
+    DocumentationCache cache(cache_file);
+    cache.updateFile(source, {output}, 1, "cpp", {}, {"xxh64:0123"});
+    TEST_ASSERT_TRUE(cache.save(), "json_escaping_snapshot_saved");
+    TEST_ASSERT_TRUE(JsonDoc::fromFile(cache_file).has_value(), "json_escaping_snapshot_is_valid_json");
+  }
+  {
+    DocumentationCache cache(cache_file);
+    TEST_ASSERT_TRUE(cache.load(), "json_escaping_snapshot_loaded");
+    TEST_ASSERT_FALSE(cache.needsExtraction(source), "json_escaping_source_path_round_trip");
+    auto hashes = cache.recordedOutputHashes();
+    TEST_ASSERT_TRUE(hashes.size() == 1 && hashes.count(output) == 1, "json_escaping_output_path_round_trip");
+
+    // Only journaled from here on; the snapshot still has the old entry
+    cache.updateFile(source, {output, output + ".2"}, 2, "cpp", {}, {"xxh64:0123", "xxh64:4567"});
+    TEST_ASSERT_TRUE(cache.saveImmediately(), "json_escaping_journal_flushed");
+  }
+  {
+    DocumentationCache cache(cache_file);
+    TEST_ASSERT_TRUE(cache.load(), "json_escaping_journal_loaded");
+    TEST_ASSERT_EQ(size_t{2}, cache.recordedOutputHashes().size(), "json_escaping_journal_round_trip");
+  }
+
+  std::filesystem::remove_all(cache_test_dir);
+}
+
+/**
+@brief Tests storing and loading extraction results through a shared cache directory
+
+Requirements tested:
+- Keys change with the settings, the path and the content
+- A stored result loads back with its constructs and includes
+- Read-only stores never write; unknown and truncated entries are misses
+
+Testing rationale: A CI runner trusts whatever a key loads in place of parsing
+the file, so a key must never match a different input and a damaged entry
+must fall back to extraction.
+*/
+void test_shared_extraction_cache() {
+  std::string dir = cache_test_dir + "/shared";
+  std::filesystem::remove_all(dir);
+
+  std::string key = SharedExtractionCache::key("grammar-a", "src/geo.h", "int area();");
+  TEST_ASSERT_EQ(size_t(32), key.size(), "key_is_128_bits");
+  TEST_ASSERT_TRUE(key != SharedExtractionCache::key("grammar-b", "src/geo.h", "int area();"), "key_depends_on_settings");
+  TEST_ASSERT_TRUE(key != SharedExtractionCache::key("grammar-a", "src/other.h", "int area();"), "key_depends_on_path");
+  TEST_ASSERT_TRUE(key != SharedExtractionCache::key("grammar-a", "src/geo.h", "int area(); "), "key_depends_on_content");
+
+  CodeConstruct area{};
+  area.type = ConstructType::Function;
+  area.name = "area";
+  area.full_name = "area";
+  area.return_type = "int";
+  area.docstring = "Compute the area";
+  area.filename = "src/geo.h";
+  area.start_line = 1;
+  area.end_line = 1;
+
+  SharedExtractionCache read_only(dir);
+  read_only.setReadOnly(true);
+  TEST_ASSERT_FALSE(read_only.store(key, {area}, {"shape.h"}), "read_only_store_skipped");
+
+  SharedExtractionCache writer(dir);
+  TEST_ASSERT_TRUE(writer.store(key, {area}, {"shape.h"}), "result_stored");
+
+  SharedExtractionCache reader(dir);
+  StringInterner strings;
+  std::vector<CodeConstruct> constructs;
+  std::vector<std::string> includes;
+  TEST_ASSERT_TRUE(reader.load(key, strings, constructs, includes), "stored_result_loaded");
+  TEST_ASSERT_TRUE(constructs.size() == 1 && constructs[0].full_name == "area" && constructs[0].filename == "src/geo.h" &&
+                   constructs[0].docstring == std::string("Compute the area"), "constructs_loaded");
+  TEST_ASSERT_TRUE(includes == std::vector<std::string>({"shape.h"}), "includes_loaded");
+
+  std::string other = SharedExtractionCache::key("grammar-b", "src/geo.h", "int area();");
+  TEST_ASSERT_FALSE(reader.load(other, strings, constructs, includes), "unknown_key_missed");
+
+  // An entry cut short (say, by a full disk on the shared mount) announces more constructs than it holds
+  writer.store(other, {area, area}, {});
+  std::string entry = dir + "/" + other.substr(0, 2) + "/" + other + ".ndjson";
+  std::string content;
+  {
+    std::ifstream file(entry, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  writeCacheTestFile(entry, content.substr(0, content.rfind('{')));
+  TEST_ASSERT_FALSE(reader.load(other, strings, constructs, includes), "truncated_entry_missed");
+  TEST_ASSERT_EQ(size_t(1), reader.hits(), "hits_counted");
+  TEST_ASSERT_EQ(size_t(2), reader.misses(), "misses_counted");
+
+  std::filesystem::remove_all(dir);
+}
+
+/**
+@brief Tests the integrity stamp and parallel pruning in a directory of pages
+
+Requirements tested:
+- Untracked pages fail integrity and are all removed when pruned on several workers
+- Checking writes nothing; a recorded stamp still lets a later check notice a deleted or added page
+- The directory hash changes when a page is added
+
+Testing rationale: The stamp lets an unchanged directory skip the comparison,
+so it must never hide a change, and batched unlinking must remove exactly
+the orphaned pages.
+*/
+void test_cache_integrity_stamp_and_prune() {
+  std::filesystem::remove_all(cache_test_dir);
+  std::filesystem::create_directories(cache_test_dir);
+  std::string cache_file = cache_test_dir + "/.cesium-cache.json";
+  std::string source = cache_test_dir + "/pages.cpp";
+  writeCacheTestFile(source, "int pages;\n");
+
+  std::vector<std::string> outputs;
+  for (int i = 0; i < 300; ++i) {
+    outputs.push_back(cache_test_dir + "/page" + std::to_string(i) + ".md");
+    writeCacheTestFile(outputs.back(), "# page\n");
+  }
+  for (int i = 0; i < 600; ++i) {
+    writeCacheTestFile(cache_test_dir + "/orphan" + std::to_string(i) + ".md", "# orphan\n");
+  }
+
+  DocumentationCache cache(cache_file);
+  cache.setJobs(4);
+  cache.updateFile(source, outputs, 1, "cpp");
+  TEST_ASSERT_FALSE(cache.verifyIntegrity(cache_test_dir), "untracked_pages_fail_integrity");
+  TEST_ASSERT_EQ(size_t(600), cache.pruneOrphanedFiles(cache_test_dir), "parallel_prune_count");
+  TEST_ASSERT_FALSE(std::filesystem::exists(cache_test_dir + "/orphan599.md"), "parallel_prune_removed_orphans");
+  TEST_ASSERT_TRUE(std::filesystem::exists(cache_test_dir + "/page299.md"), "parallel_prune_kept_pages");
+
+  TEST_ASSERT_TRUE(cache.verifyIntegrity(cache_test_dir), "pruned_directory_passes_integrity");
+  TEST_ASSERT_FALSE(std::filesystem::exists(DocumentationCache::integrityStampPath(cache_test_dir)),
+                    "verification_writes_no_stamp");
+  TEST_ASSERT_TRUE(cache.recordIntegrity(cache_test_dir), "stamp_recorded");
+  TEST_ASSERT_TRUE(std::filesystem::exists(DocumentationCache::integrityStampPath(cache_test_dir)), "stamp_written");
+  TEST_ASSERT_TRUE(cache.verifyIntegrity(cache_test_dir), "stamped_directory_passes_integrity");
+
+  std::string before = cache.calculateDirectoryHash(cache_test_dir);
+  writeCacheTestFile(cache_test_dir + "/stray.md", "# stray\n");
+  TEST_ASSERT_TRUE(before != cache.calculateDirectoryHash(cache_test_dir), "directory_hash_sees_added_page");
+  TEST_ASSERT_FALSE(cache.verifyIntegrity(cache_test_dir), "stamp_does_not_hide_added_page");
+  std::filesystem::remove(cache_test_dir + "/stray.md");
+  TEST_ASSERT_TRUE(cache.verifyIntegrity(cache_test_dir), "restored_directory_passes_integrity");
+
+  std::filesystem::remove(outputs[150]);
+  TEST_ASSERT_FALSE(cache.verifyIntegrity(cache_test_dir), "stamp_does_not_hide_missing_page");
+
+  std::filesystem::remove_all(cache_test_dir);
+}
+
+/**
+@brief Tests that pruning a deleted source drops its entry from a mapped binary cache
+
+Requirements tested:
+- Pages of a deleted source are removed and its entry no longer lists them
+- The directory passes integrity afterwards, before and after reloading the saved cache
+- Entries of sources that still exist are kept
+
+Testing rationale: Mapped entries are not mirrored into the output map, so a
+prune that only edits that map leaves the deleted pages listed and every
+later run reports them missing and prunes again.
+*/
+void test_binary_cache_prune_deleted_source() {
+  std::filesystem::remove_all(cache_test_dir);
+  std::filesystem::create_directories(cache_test_dir);
+  std::string cache_file = cache_test_dir + "/.cesium-cache.json";
+  std::string kept = cache_test_dir + "/kept.cpp";
+  std::string deleted = cache_test_dir + "/deleted.cpp";
+  std::string kept_page = cache_test_dir + "/kept.md";
+  std::string deleted_page = cache_test_dir + "/deleted.md";
+  writeCacheTestFile(kept, "void kept();\n");
+  writeCacheTestFile(deleted, "void deleted();\n");
+  writeCacheTestFile(kept_page, "# kept\n");
+  writeCacheTestFile(deleted_page, "# deleted\n");
+
+  {
+    DocumentationCache cache(cache_file);
+    cache.setFormat(CacheFormat::Binary);
+    cache.updateFile(kept, {kept_page}, 1, "cpp");
+    cache.updateFile(deleted, {deleted_page}, 1, "cpp");
+    TEST_ASSERT_TRUE(cache.save(), "prune_binary_cache_saved");
+  }
+  std::filesystem::remove(deleted);
+
+  {
+    DocumentationCache cache(cache_file);
+    cache.setFormat(CacheFormat::Binary);
+    TEST_ASSERT_TRUE(cache.load(), "prune_binary_cache_loaded");
+    TEST_ASSERT_EQ(size_t(1), cache.pruneOrphanedFiles(cache_test_dir), "deleted_source_page_pruned");
+    TEST_ASSERT_FALSE(std::filesystem::exists(deleted_page), "deleted_source_page_removed");
+    auto [file_count, generated_count] = cache.getStats();
+    TEST_ASSERT_TRUE(file_count == 1 && generated_count == 1, "deleted_source_entry_dropped");
+    TEST_ASSERT_TRUE(cache.verifyIntegrity(cache_test_dir), "pruned_binary_cache_passes_integrity");
+  }
+
+  {
+    DocumentationCache cache(cache_file);
+    cache.setFormat(CacheFormat::Binary);
+    TEST_ASSERT_TRUE(cache.load(), "pruned_binary_cache_reloaded");
+    TEST_ASSERT_TRUE(cache.verifyIntegrity(cache_test_dir), "reloaded_binary_cache_passes_integrity");
+    TEST_ASSERT_FALSE(cache.needsExtraction(kept), "kept_source_entry_intact");
+    TEST_ASSERT_EQ(size_t(0), cache.pruneOrphanedFiles(cache_test_dir), "nothing_left_to_prune");
+  }
+
+  std::filesystem::remove_all(cache_test_dir);
+}
+
+void run_documentation_cache_tests() {
+  RUN_TEST(test_xxh64_reference_vectors);
+  RUN_TEST(test_cache_hash_policies);
+  RUN_TEST(test_binary_cache_round_trip);
+  RUN_TEST(test_cache_journal_replay);
+  RUN_TEST(test_cache_dependency_invalidation);
+  RUN_TEST(test_cache_archive_integrity);
+  RUN_TEST(test_json_cache_escaping);
+  RUN_TEST(test_shared_extraction_cache);
+  RUN_TEST(test_cache_integrity_stamp_and_prune);
+  RUN_TEST(test_binary_cache_prune_deleted_source);
+}
@@ -161,8 +161,8 @@ void test_platform_extension_getter() {
 }
 
 void run_dynlib_platform_tests() {
-  test_resolve_platform_name_windows();
-  test_resolve_platform_name_paths();
-  test_resolve_platform_name_edge_cases();
-  test_platform_extension_getter();
+  RUN_TEST(test_resolve_platform_name_windows);
+  RUN_TEST(test_resolve_platform_name_paths);
+  RUN_TEST(test_resolve_platform_name_edge_cases);
+  RUN_TEST(test_platform_extension_getter);
 }
\ No newline at end of file
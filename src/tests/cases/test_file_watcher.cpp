@@ -0,0 +1,76 @@
+/**
+@brief Tests for recursive filesystem change notifications
+*/
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <backend/core/file_watcher.h>
+#include "../testfrmwk/simple_test.h"
+
+static const std::string watcher_test_dir = "test_file_watcher";
+
+static void writeWatchedFile(const std::string& path, const std::string& content) {
+  std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+  std::ofstream file(path, std::ios::binary);
+  file << content;
+}
+
+// Wait until the watcher reports a path ending in suffix (or give up after a few seconds)
+static bool waitForPath(FileWatcher& watcher, const std::string& suffix) {
+  for (int attempt = 0; attempt < 10; ++attempt) {
+    auto changes = watcher.wait(std::chrono::milliseconds(500));
+    if (std::any_of(changes.paths.begin(), changes.paths.end(),
+                    [&](const std::string& path) { return path.ends_with(suffix); })) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+@brief Tests that writes, new directories and deletions are reported
+
+Requirements tested:
+- Modifying a file below a watched root reports its path
+- Files written into a directory created after watching started are reported
+- Deleting a file reports its path
+- Files under excluded directories are not reported
+- A quiet tree times out with no changes
+
+Testing rationale: The watch command re-extracts exactly the reported paths,
+so a missed event leaves stale docs until the next full extract.
+*/
+void test_file_watcher_events() {
+  std::filesystem::remove_all(watcher_test_dir);
+  writeWatchedFile(watcher_test_dir + "/src/a.cpp", "int a;\n");
+  writeWatchedFile(watcher_test_dir + "/src/build/gen.cpp", "int gen;\n");
+
+  GlobMatcher exclude;
+  exclude.add("build/");
+  FileWatcher watcher;
+  watcher.setExcludes(&exclude);
+  TEST_ASSERT_TRUE(watcher.addRoot(watcher_test_dir + "/src"), "watcher_adds_root");
+  TEST_ASSERT_FALSE(watcher.addRoot(watcher_test_dir + "/missing"), "watcher_rejects_missing_root");
+
+  auto quiet = watcher.wait(std::chrono::milliseconds(50));
+  TEST_ASSERT_TRUE(quiet.paths.empty() && !quiet.overflow, "watcher_quiet_tree_times_out");
+
+  writeWatchedFile(watcher_test_dir + "/src/a.cpp", "int a = 1;\n");
+  TEST_ASSERT_TRUE(waitForPath(watcher, "a.cpp"), "watcher_reports_modified_file");
+
+  writeWatchedFile(watcher_test_dir + "/src/core/b.h", "int b;\n");
+  TEST_ASSERT_TRUE(waitForPath(watcher, "b.h"), "watcher_reports_file_in_new_directory");
+
+  std::filesystem::remove(watcher_test_dir + "/src/a.cpp");
+  TEST_ASSERT_TRUE(waitForPath(watcher, "a.cpp"), "watcher_reports_deleted_file");
+
+  writeWatchedFile(watcher_test_dir + "/src/build/gen.cpp", "int gen = 1;\n");
+  auto excluded = watcher.wait(std::chrono::milliseconds(300));
+  TEST_ASSERT_TRUE(excluded.paths.empty(), "watcher_skips_excluded_directory");
+
+  std::filesystem::remove_all(watcher_test_dir);
+}
+
+void run_file_watcher_tests() {
+  RUN_TEST(test_file_watcher_events);
+}
@@ -0,0 +1,109 @@
+/**
+@brief Tests for the shared filesystem scanner and its snapshot
+*/
+#include <filesystem>
+#include <fstream>
+#include <backend/core/fs_scan.h>
+#include "../testfrmwk/simple_test.h"
+
+static const std::string fs_scan_test_dir = "test_fs_scan";
+
+static void writeScanFile(const std::string& path, const std::string& content) {
+  std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+  std::ofstream file(path, std::ios::binary);
+  file << content;
+}
+
+/**
+@brief Tests walking, stat data and exclusion
+
+Requirements tested:
+- Files below a recursive root are listed with the same mtime ticks and size std::filesystem reports
+- Excluded directories are neither listed nor descended into
+- A missing root is reported as missing rather than failed
+
+Testing rationale: The cache compares recorded last_write_time ticks against
+the snapshot, so any difference in the stat data would force every file to be
+re-hashed on every run.
+*/
+void test_fs_scanner_walk() {
+  std::filesystem::remove_all(fs_scan_test_dir);
+  writeScanFile(fs_scan_test_dir + "/src/a.cpp", "int a;\n");
+  writeScanFile(fs_scan_test_dir + "/src/core/b.h", "int b;\n");
+  writeScanFile(fs_scan_test_dir + "/src/third_party/lib/c.h", "int c;\n");
+
+  GlobMatcher exclude;
+  exclude.add("third_party");
+  FsScanner scanner;
+  FsSnapshot snapshot = scanner.scan({ScanRoot{fs_scan_test_dir + "/src", true, &exclude},
+                                      ScanRoot{fs_scan_test_dir + "/missing", true, nullptr}});
+
+  size_t files = 0;
+  bool stats_match = true;
+  for (const auto& entry : snapshot.entries(0)) {
+    if (entry.type != FsEntryType::File) continue;
+    files++;
+    auto ticks = std::filesystem::last_write_time(entry.path).time_since_epoch().count();
+    stats_match = stats_match && entry.mtime_ticks == static_cast<int64_t>(ticks) &&
+                  entry.size == std::filesystem::file_size(entry.path);
+  }
+  TEST_ASSERT_EQ(size_t(2), files, "fs_scan_lists_files");
+  TEST_ASSERT_TRUE(stats_match, "fs_scan_stat_matches_filesystem");
+  TEST_ASSERT_EQ(size_t(1), snapshot.excluded(0).size(), "fs_scan_records_excluded_dir");
+  TEST_ASSERT_TRUE(snapshot.rootStatus(1) == FsSnapshot::RootStatus::Missing, "fs_scan_missing_root");
+
+  std::filesystem::remove_all(fs_scan_test_dir);
+}
+
+/**
+@brief Tests snapshot lookups and directory listings
+
+Requirements tested:
+- Lookups normalize paths and find scanned entries
+- Absent paths under a scanned root are known to be missing
+- Paths outside the roots or under an excluded directory are unknown
+- Non-recursive roots list only their direct children
+- Rescanning a root picks up files written after the scan
+
+Testing rationale: Reporting an excluded or unscanned file as missing would
+make the cache treat an existing dependency as deleted.
+*/
+void test_fs_snapshot_lookup() {
+  std::filesystem::remove_all(fs_scan_test_dir);
+  writeScanFile(fs_scan_test_dir + "/src/a.cpp", "int a;\n");
+  writeScanFile(fs_scan_test_dir + "/src/vendor/v.h", "int v;\n");
+  writeScanFile(fs_scan_test_dir + "/out/a.md", "# a\n");
+  writeScanFile(fs_scan_test_dir + "/out/nested/skip.md", "# skip\n");
+
+  GlobMatcher exclude;
+  exclude.add("vendor");
+  FsScanner scanner;
+  FsSnapshot snapshot = scanner.scan({ScanRoot{fs_scan_test_dir + "/src/", true, &exclude},
+                                      ScanRoot{fs_scan_test_dir + "/out", false, nullptr}});
+
+  auto found = snapshot.lookup("./" + fs_scan_test_dir + "//src/../src/a.cpp");
+  TEST_ASSERT_TRUE(found && *found && (*found)->type == FsEntryType::File, "fs_snapshot_normalized_lookup");
+  auto missing = snapshot.lookup(fs_scan_test_dir + "/src/gone.cpp");
+  TEST_ASSERT_TRUE(missing && *missing == nullptr, "fs_snapshot_known_missing");
+  TEST_ASSERT_FALSE(snapshot.lookup(fs_scan_test_dir + "/src/vendor/v.h").has_value(), "fs_snapshot_excluded_unknown");
+  TEST_ASSERT_FALSE(snapshot.lookup(fs_scan_test_dir + "/other/x.h").has_value(), "fs_snapshot_outside_unknown");
+  TEST_ASSERT_FALSE(snapshot.lookup(fs_scan_test_dir + "/out/nested/skip.md").has_value(), "fs_snapshot_below_shallow_root_unknown");
+
+  auto listing = snapshot.listDirectory(fs_scan_test_dir + "/out/");
+  TEST_ASSERT_TRUE(listing && listing->size() == 2, "fs_snapshot_lists_direct_children");
+  TEST_ASSERT_FALSE(snapshot.listDirectory(fs_scan_test_dir + "/src/vendor").has_value(), "fs_snapshot_lists_roots_only");
+
+  writeScanFile(fs_scan_test_dir + "/out/b.md", "# b\n");
+  auto stale = snapshot.lookup(fs_scan_test_dir + "/out/b.md");
+  TEST_ASSERT_TRUE(stale && *stale == nullptr, "fs_snapshot_is_point_in_time");
+  scanner.rescan(snapshot, 1);
+  auto fresh = snapshot.lookup(fs_scan_test_dir + "/out/b.md");
+  TEST_ASSERT_TRUE(fresh && *fresh != nullptr, "fs_snapshot_rescan_sees_new_file");
+
+  std::filesystem::remove_all(fs_scan_test_dir);
+}
+
+void run_fs_scanner_tests() {
+  RUN_TEST(test_fs_scanner_walk);
+  RUN_TEST(test_fs_snapshot_lookup);
+}
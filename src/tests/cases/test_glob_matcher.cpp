@@ -0,0 +1,73 @@
+/**
+@brief Tests for compiled exclude pattern matching
+*/
+#include <backend/core/glob.h>
+#include "../testfrmwk/simple_test.h"
+
+/**
+@brief Tests file matching against the default exclude patterns
+
+Requirements tested:
+- `**` matches any number of leading segments, including none
+- A pattern without `/` matches the file name at any depth
+- `*`, `?` and character classes match within one segment only
+
+Testing rationale: These are the patterns written by `cesium doc init`, so
+they must exclude test sources without catching ordinary files.
+*/
+void test_glob_file_matching() {
+  GlobMatcher matcher;
+  TEST_ASSERT_EQ(size_t(2), matcher.add(std::vector<std::string>{"**/test/**", "*_test.*"}), "glob_patterns_compiled");
+
+  TEST_ASSERT_TRUE(matcher.matchesFile("src/test/helpers.cpp"), "glob_nested_test_dir_file");
+  TEST_ASSERT_TRUE(matcher.matchesFile("test/main.cpp"), "glob_double_star_matches_zero_segments");
+  TEST_ASSERT_TRUE(matcher.matchesFile("./src//core/json_test.cpp"), "glob_basename_pattern_any_depth");
+  TEST_ASSERT_FALSE(matcher.matchesFile("src/testing/json.cpp"), "glob_literal_segment_exact");
+  TEST_ASSERT_FALSE(matcher.matchesFile("src/test"), "glob_trailing_double_star_needs_child");
+  TEST_ASSERT_FALSE(matcher.matchesFile("src/core/json.cpp"), "glob_ordinary_file_kept");
+
+  GlobMatcher wildcards;
+  wildcards.add("src/*/gen_?.[ch]");
+  wildcards.add("[!a-m]*.inl");
+  TEST_ASSERT_TRUE(wildcards.matchesFile("src/core/gen_a.h"), "glob_class_and_question_mark");
+  TEST_ASSERT_FALSE(wildcards.matchesFile("src/core/sub/gen_a.h"), "glob_star_single_segment");
+  TEST_ASSERT_FALSE(wildcards.matchesFile("src/core/gen_ab.c"), "glob_question_mark_one_char");
+  TEST_ASSERT_TRUE(wildcards.matchesFile("include/x/zeta.inl"), "glob_negated_class");
+  TEST_ASSERT_FALSE(wildcards.matchesFile("include/x/alpha.inl"), "glob_negated_class_rejects");
+}
+
+/**
+@brief Tests directory pruning decisions
+
+Requirements tested:
+- A directory is pruned when a trailing `**` segment covers its contents
+- A bare name prunes that directory anywhere in the tree
+- Directory-only patterns (trailing `/`) never exclude files
+- Directories that only contain excluded files are still walked
+
+Testing rationale: Pruning skips whole subtrees, so a false match loses every
+file below the directory while a missed match only costs walk time.
+*/
+void test_glob_directory_pruning() {
+  GlobMatcher matcher;
+  matcher.add("**/test/**");
+  matcher.add("third_party");
+  matcher.add("build/");
+  matcher.add("*_test.*");
+
+  TEST_ASSERT_TRUE(matcher.matchesDirectory("src/test"), "glob_prunes_test_dir");
+  TEST_ASSERT_TRUE(matcher.matchesDirectory("src/core/third_party"), "glob_prunes_bare_name");
+  TEST_ASSERT_TRUE(matcher.matchesDirectory("build"), "glob_prunes_directory_only_pattern");
+  TEST_ASSERT_FALSE(matcher.matchesFile("tools/build"), "glob_directory_only_skips_files");
+  TEST_ASSERT_FALSE(matcher.matchesDirectory("src"), "glob_keeps_parent_of_excluded");
+  TEST_ASSERT_FALSE(matcher.matchesDirectory("src/core"), "glob_keeps_dir_with_excluded_files");
+
+  GlobMatcher empty;
+  TEST_ASSERT_FALSE(empty.add(""), "glob_empty_pattern_rejected");
+  TEST_ASSERT_FALSE(empty.matchesDirectory("src") || empty.matchesFile("src/a.cpp"), "glob_empty_matches_nothing");
+}
+
+void run_glob_matcher_tests() {
+  RUN_TEST(test_glob_file_matching);
+  RUN_TEST(test_glob_directory_pruning);
+}
@@ -3,6 +3,8 @@
 */
 #include <filesystem>
 #include <fstream>
+#include <string_view>
+#include <vector>
 #include <backend/core/json.h>
 #include "../testfrmwk/simple_test.h"
 
@@ -184,15 +186,69 @@ void test_multiple_languages() {
   TEST_ASSERT_EQ(python_docstring_val.asString(), "\"\"\" \"\"\"", "python_docstring_style");
 }
 
+/**
+@brief Tests range and visitor iteration over objects and arrays
+
+Requirements tested:
+- members() and forEachObject visit each object entry in document order with string_view keys
+- elements() and forEachArray visit each array element, with indices for the visitor
+- Iterating a value of the wrong type visits nothing
+
+Testing rationale: Config and cache loading iterate through these without
+copying keys, so both forms must agree with each other and with the document.
+*/
+void test_iteration() {
+  auto doc_opt = JsonDoc::fromFile(test_config_path);
+  if (!doc_opt.has_value()) {
+    TEST_ASSERT_TRUE(false, "load_config_for_iteration_test");
+    return;
+  }
+  const JsonDoc& doc = *doc_opt;
+  JsonValue languages = doc["languages"];
+
+  std::vector<std::string> range_keys;
+  for (auto [key, value] : languages.members()) {
+    range_keys.emplace_back(key);
+    TEST_ASSERT_TRUE(value.isObject(), "iteration_member_value_is_object");
+  }
+  std::vector<std::string> visitor_keys;
+  languages.forEachObject([&](std::string_view key, JsonValue value) {
+    visitor_keys.emplace_back(key);
+    TEST_ASSERT_EQ(value["function"].asString(), "tree_sitter_" + std::string(key), "iteration_visitor_value");
+  });
+  TEST_ASSERT_TRUE(range_keys == std::vector<std::string>({"cpp", "python"}), "iteration_member_keys_in_order");
+  TEST_ASSERT_TRUE(visitor_keys == range_keys, "iteration_visitor_matches_range");
+
+  JsonValue extensions = languages["cpp"]["extensions"];
+  std::vector<std::string> items;
+  for (JsonValue item : extensions.elements()) {
+    items.push_back(item.asString());
+  }
+  size_t last_index = 0;
+  extensions.forEachArray([&](size_t index, JsonValue item) {
+    last_index = index;
+    TEST_ASSERT_EQ(item.asString(), items[index], "iteration_array_visitor_value");
+  });
+  TEST_ASSERT_TRUE(items == extensions.asStringArray(), "iteration_elements");
+  TEST_ASSERT_EQ(last_index, size_t{4}, "iteration_array_visitor_indices");
+
+  size_t visited = 0;
+  for (auto member : extensions.members()) { (void)member; visited++; }
+  for (JsonValue item : languages.elements()) { (void)item; visited++; }
+  doc["missing"].forEachObject([&](std::string_view, JsonValue) { visited++; });
+  TEST_ASSERT_EQ(visited, size_t{0}, "iteration_wrong_type_is_empty");
+}
+
 void run_json_config_tests() {
   setupTestConfig();
   
-  test_load_valid_config();
-  test_load_invalid_file();
-  test_load_malformed_json();
-  test_access_arrays();
-  test_access_missing_keys();
-  test_multiple_languages();
+  RUN_TEST(test_load_valid_config);
+  RUN_TEST(test_load_invalid_file);
+  RUN_TEST(test_load_malformed_json);
+  RUN_TEST(test_access_arrays);
+  RUN_TEST(test_access_missing_keys);
+  RUN_TEST(test_multiple_languages);
+  RUN_TEST(test_iteration);
   
   teardownTestConfig();
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+/**
+@brief Tests for level filtering and lazy message construction in the logger
+*/
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <backend/core/cli_utils.h>
+#include "../testfrmwk/simple_test.h"
+
+static const std::string logging_test_dir = "test_logging";
+
+static size_t countLines(const std::string& path) {
+  std::ifstream file(path);
+  size_t lines = 0;
+  for (std::string line; std::getline(file, line);) {
+    lines++;
+  }
+  return lines;
+}
+
+static std::string countedPiece(int& evaluations) {
+  evaluations++;
+  return "piece";
+}
+
+/**
+@brief Tests that filtered LOG_* calls never build their message
+
+Requirements tested:
+- isEnabled follows the console level
+- A log file with a lower level enables levels the console filters
+- Arguments of a filtered LOG_DEBUG call are not evaluated
+- Enabled calls evaluate their arguments exactly once
+- concat joins strings, characters and numbers
+
+Testing rationale: Debug messages are built on every extracted node, so any
+evaluation of a filtered message costs extract time for no output.
+*/
+void test_logging_lazy_messages() {
+  TEST_ASSERT_EQ(std::string("a=1, b=2.5, c"), Logger::concat("a=", 1, ", b=", std::to_string(2.5).substr(0, 3), ',', " c"),
+                 "logging_concat_mixed_pieces");
+
+  LoggingConfig quiet;
+  quiet.console_level = MessageType::Warning;
+  CLILogger::configure(quiet);
+  TEST_ASSERT_FALSE(Logger::isEnabled(MessageType::Info), "logging_info_filtered_at_warning");
+  TEST_ASSERT_TRUE(Logger::isEnabled(MessageType::Error), "logging_error_enabled_at_warning");
+
+  int evaluations = 0;
+  LOG_DEBUG("value: ", countedPiece(evaluations));
+  LOG_DEBUGLOW("value: " + countedPiece(evaluations));
+  TEST_ASSERT_EQ(0, evaluations, "logging_filtered_arguments_not_evaluated");
+
+  LoggingConfig verbose;
+  verbose.console_level = MessageType::DebugLow2;
+  verbose.enable_timestamps = false;
+  CLILogger::configure(verbose);
+  LOG_DEBUG("value: ", countedPiece(evaluations));
+  TEST_ASSERT_EQ(CESIUM_LOG_COMPILED_LEVEL > LogLevel::debug ? 0 : 1, evaluations, "logging_enabled_arguments_evaluated_once");
+
+  CLILogger::configure(LoggingConfig{});
+  TEST_ASSERT_FALSE(Logger::isEnabled(MessageType::Debug), "logging_default_filters_debug");
+}
+
+/**
+@brief Tests the background log file writer and size-based rotation
+
+Requirements tested:
+- Lines logged from several threads all reach the file after flush
+- The file is rotated once it would exceed max_file_size_mb
+- No more than backup_count rotated files are kept
+- Messages below the console level still reach a log file with a lower level
+
+Testing rationale: File output is queued and written by another thread, so
+lost or duplicated lines would only show up as missing context in a bug
+report, long after the run that dropped them.
+*/
+void test_logging_file_writer() {
+  std::filesystem::remove_all(logging_test_dir);
+  const std::string log_path = logging_test_dir + "/cesium.log";
+
+  LoggingConfig file_config;
+  file_config.console_level = MessageType::Error;
+  file_config.file_level = MessageType::Print;
+  file_config.log_file = log_path;
+  file_config.max_file_size_mb = 0;
+  CLILogger::configure(file_config);
+  TEST_ASSERT_TRUE(Logger::isEnabled(MessageType::Info), "logging_file_level_enables_info");
+
+  constexpr int kThreads = 4;
+  constexpr int kMessages = 2000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([t] {
+      for (int i = 0; i < kMessages; ++i) {
+        CLILogger::info(Logger::concat("thread ", t, " message ", i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CLILogger::flush();
+  TEST_ASSERT_EQ(size_t(kThreads * kMessages), countLines(log_path), "logging_concurrent_lines_all_written");
+
+  std::filesystem::remove_all(logging_test_dir);
+  file_config.max_file_size_mb = 1;
+  file_config.backup_count = 2;
+  file_config.enable_timestamps = false;
+  CLILogger::configure(file_config);
+  const std::string payload(1000, 'x');
+  for (int i = 0; i < 3500; ++i) {  // About 3.4 MiB: rotates three times
+    CLILogger::info(payload);
+  }
+  CLILogger::flush();
+  std::error_code ec;
+  TEST_ASSERT_TRUE(std::filesystem::file_size(log_path, ec) <= 1024 * 1024, "logging_rotated_file_within_limit");
+  TEST_ASSERT_TRUE(std::filesystem::exists(log_path + ".1") && std::filesystem::exists(log_path + ".2"),
+                   "logging_rotation_keeps_backups");
+  TEST_ASSERT_FALSE(std::filesystem::exists(log_path + ".3"), "logging_rotation_drops_oldest");
+
+  CLILogger::configure(LoggingConfig{});
+  std::filesystem::remove_all(logging_test_dir);
+}
+
+void run_logging_tests() {
+  RUN_TEST(test_logging_lazy_messages);
+  RUN_TEST(test_logging_file_writer);
+}
@@ -1,9 +1,15 @@
 /**
 @brief Tests for markdown documentation file generation functionality
 */
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <sstream>
+#include <backend/core/json.h>
+#include <backend/doc/construct_stream.h>
 #include <backend/doc/markdowngen.h>
+#include <backend/doc/page_name.h>
+#include <backend/doc/search_index.h>
 #include "../testfrmwk/simple_test.h"
 
 std::string markdown_test_output_dir = "test_markdown_output";
@@ -256,34 +262,579 @@ void test_invalid_output_directory() {
   }
 }
 
+/**
+@brief Tests that generated construct files are attributed to the sources they came from
+
+Requirements tested:
+- Each source file maps to the outputs of its own constructs only
+- A construct merged from several files is attributed to every contributing file
+- Same-named constructs from different files share one output attributed to both
+
+Testing rationale: The cache records these outputs per source to decide what to
+re-extract and prune, so misattributing an output breaks incremental builds.
+*/
+void test_construct_outputs_by_source() {
+  MarkdownGenerator generator;
+
+  auto makeConstruct = [](const std::string& full_name, std::string_view filename) {
+    CodeConstruct construct{};
+    construct.type = ConstructType::Function;
+    construct.name = full_name;
+    construct.full_name = full_name;
+    construct.filename = filename;
+    construct.start_line = 1;
+    construct.end_line = 1;
+    return construct;
+  };
+
+  std::vector<CodeConstruct> constructs;
+  constructs.push_back(makeConstruct("alpha", "src/a.cpp"));
+  constructs.push_back(makeConstruct("beta", "src/b.cpp"));
+
+  CodeConstruct merged = makeConstruct("gamma", "include/c.h");
+  merged.is_merged = true;
+  merged.source_locations = {"include/c.h:3", "src/c.cpp:10"};
+  constructs.push_back(merged);
+
+  constructs.push_back(makeConstruct("shared", "src/a.cpp"));
+  constructs.push_back(makeConstruct("shared", "src/b.cpp"));
+
+  GeneratedFileMap outputs = generator.generateMarkdownFromConstructs(constructs, markdown_test_output_dir);
+
+  std::string alpha = markdown_test_output_dir + "/alpha.md";
+  std::string shared = markdown_test_output_dir + "/shared.md";
+  std::string gamma = markdown_test_output_dir + "/gamma.md";
+  TEST_ASSERT_EQ(outputs.size(), size_t(4), "outputs_grouped_by_source");
+  TEST_ASSERT_TRUE(outputs["src/a.cpp"] == std::vector<std::string>({alpha, shared}), "outputs_for_single_source");
+  TEST_ASSERT_TRUE(outputs["include/c.h"] == std::vector<std::string>({gamma}), "merged_output_for_declaring_file");
+  TEST_ASSERT_TRUE(outputs["src/c.cpp"] == std::vector<std::string>({gamma}), "merged_output_for_defining_file");
+  TEST_ASSERT_EQ(outputs["src/b.cpp"].size(), size_t(2), "shared_output_attributed_to_both_sources");
+}
+
+/**
+@brief Tests that unchanged construct pages are not rewritten
+
+Requirements tested:
+- A page whose rendered hash matches the recorded hash is left untouched
+- Without recorded hashes, a page identical to the file on disk is left untouched
+- A page whose content changed is written and reports a new hash
+
+Testing rationale: Rewriting identical pages bumps their mtimes, which makes every
+downstream consumer rebuild the whole site after a one-line change.
+*/
+void test_unchanged_pages_not_rewritten() {
+  CodeConstruct construct{};
+  construct.type = ConstructType::Function;
+  construct.name = "stable";
+  construct.full_name = "stable";
+  construct.filename = "src/stable.cpp";
+  construct.start_line = 1;
+  construct.end_line = 2;
+  std::vector<CodeConstruct> constructs = {construct};
+  std::string page = markdown_test_output_dir + "/stable.md";
+
+  MarkdownGenerator first;
+  first.generateMarkdownFromConstructs(constructs, markdown_test_output_dir);
+  TEST_ASSERT_EQ(first.writtenCount(), size_t(1), "first_generation_writes_page");
+  auto recorded = first.outputHashes();
+  TEST_ASSERT_TRUE(recorded.count(page) == 1 && recorded[page].rfind("xxh64:", 0) == 0, "page_hash_reported");
+
+  // Backdate the page so any rewrite would be visible in its mtime
+  auto backdated = std::filesystem::last_write_time(page) - std::chrono::hours(1);
+  std::filesystem::last_write_time(page, backdated);
+
+  MarkdownGenerator second;
+  second.setRecordedOutputHashes(recorded);
+  second.generateMarkdownFromConstructs(constructs, markdown_test_output_dir);
+  TEST_ASSERT_EQ(second.unchangedCount(), size_t(1), "recorded_hash_match_skips_write");
+  TEST_ASSERT_TRUE(std::filesystem::last_write_time(page) == backdated, "skipped_page_mtime_preserved");
+
+  MarkdownGenerator without_record;
+  without_record.generateMarkdownFromConstructs(constructs, markdown_test_output_dir);
+  TEST_ASSERT_EQ(without_record.unchangedCount(), size_t(1), "disk_content_match_skips_write");
+
+  constructs[0].docstring = "Now documented";
+  MarkdownGenerator changed;
+  changed.setRecordedOutputHashes(recorded);
+  changed.generateMarkdownFromConstructs(constructs, markdown_test_output_dir);
+  TEST_ASSERT_EQ(changed.writtenCount(), size_t(1), "changed_page_written");
+  TEST_ASSERT_TRUE(changed.outputHashes().at(page) != recorded[page], "changed_page_new_hash");
+}
+
+/**
+@brief Tests that the batched output writer flushes pages and reports failed writes
+
+Requirements tested:
+- Queued pages reach disk once the batch size is exceeded, without an explicit flush
+- flush() writes the remaining pages and counts files and bytes written
+- A page that cannot be opened is reported through failedPaths() instead of aborting the batch
+- Rewriting a page replaces the file, so a hard link to the old one keeps the old content
+
+Testing rationale: Pages are no longer written as they are rendered, so a dropped
+batch or a silently swallowed failure would leave the extract directory stale.
+*/
+void test_output_writer_batches() {
+  std::string first_page = markdown_test_output_dir + "/batched_a.md";
+  std::string second_page = markdown_test_output_dir + "/batched_b.md";
+  std::string missing_page = markdown_test_output_dir + "/missing_dir/page.md";
+
+  OutputWriter writer(8);
+  writer.setJobs(2);
+  writer.write(first_page, "0123456789");
+  TEST_ASSERT_TRUE(std::filesystem::exists(first_page), "batch_flushed_at_threshold");
+
+  writer.write(second_page, "abc");
+  writer.write(missing_page, "lost");
+  TEST_ASSERT_FALSE(std::filesystem::exists(second_page), "small_write_stays_queued");
+  TEST_ASSERT_FALSE(writer.flush(), "flush_reports_failure");
+  TEST_ASSERT_TRUE(std::filesystem::exists(second_page), "flush_writes_remaining_pages");
+  TEST_ASSERT_EQ(writer.filesWritten(), size_t(2), "files_written_counted");
+  TEST_ASSERT_EQ(writer.bytesWritten(), size_t(13), "bytes_written_counted");
+  TEST_ASSERT_TRUE(writer.failedPaths().size() == 1 && writer.failedPaths()[0] == missing_page, "failed_path_reported");
+
+  std::ifstream written(second_page);
+  std::string content((std::istreambuf_iterator<char>(written)), std::istreambuf_iterator<char>());
+  TEST_ASSERT_EQ(content, std::string("abc"), "written_content_intact");
+
+  // A page published as a hard link to this one keeps its content when the page is rewritten
+  std::string published = markdown_test_output_dir + "/published.md";
+  std::error_code ec;
+  std::filesystem::create_hard_link(second_page, published, ec);
+  if (!ec) {
+    writer.write(second_page, "rewritten");
+    TEST_ASSERT_TRUE(writer.flush(), "linked_page_rewritten");
+    std::ifstream kept(published);
+    std::string kept_content((std::istreambuf_iterator<char>(kept)), std::istreambuf_iterator<char>());
+    TEST_ASSERT_EQ(std::string("abc"), kept_content, "rewrite_does_not_write_through_links");
+    TEST_ASSERT_FALSE(std::filesystem::exists(second_page + ".tmp"), "temporary_file_renamed");
+  }
+}
+
+/**
+@brief Tests that archive mode stores pages in one indexed archive
+
+Requirements tested:
+- No per-construct files are written; every page is readable from the archive by name
+- Pages keep their usual output paths in the returned map and hashes
+- A later run replaces changed pages and keeps pages it did not regenerate
+
+Testing rationale: Archive mode exists to avoid one file per construct, and
+incremental runs only regenerate some pages, so updates must merge.
+*/
+void test_archive_output_mode() {
+  CodeConstruct first{};
+  first.type = ConstructType::Function;
+  first.name = "first";
+  first.full_name = "first";
+  first.filename = "src/first.cpp";
+  CodeConstruct second = first;
+  second.name = "second";
+  second.full_name = "second";
+  second.filename = "src/second.cpp";
+
+  MarkdownGenerator generator;
+  generator.setOutputMode(OutputMode::Archive);
+  GeneratedFileMap outputs = generator.generateMarkdownFromConstructs({first, second}, markdown_test_output_dir);
+  TEST_ASSERT_FALSE(std::filesystem::exists(markdown_test_output_dir + "/first.md"), "archive_mode_writes_no_page_files");
+  TEST_ASSERT_TRUE(outputs["src/first.cpp"].size() == 1 && outputs["src/first.cpp"][0] == markdown_test_output_dir + "/first.md",
+                   "archive_mode_keeps_output_paths");
+  TEST_ASSERT_EQ(generator.writtenCount(), size_t(2), "archive_mode_counts_pages");
+
+  SnippetArchive archive;
+  TEST_ASSERT_TRUE(archive.open(snippetArchivePath(markdown_test_output_dir)), "archive_created");
+  auto index = archive.indexOf("second.md");
+  TEST_ASSERT_TRUE(index && archive.contentAt(*index).find("# second") != std::string_view::npos, "archived_page_readable");
+  archive.close();
+
+  first.docstring = "Now documented";
+  MarkdownGenerator update;
+  update.setOutputMode(OutputMode::Archive);
+  update.generateMarkdownFromConstructs({first}, markdown_test_output_dir);
+  TEST_ASSERT_EQ(update.writtenCount(), size_t(1), "archive_update_writes_changed_page");
+  TEST_ASSERT_TRUE(archive.open(snippetArchivePath(markdown_test_output_dir)) && archive.size() == 2, "archive_update_keeps_other_pages");
+  index = archive.indexOf("first.md");
+  TEST_ASSERT_TRUE(index && archive.contentAt(*index).find("Now documented") != std::string_view::npos, "archive_page_replaced");
+
+  // Windows cannot delete a mapped file, and teardown removes the output directory
+  archive.close();
+}
+
+/**
+@brief Tests streaming of constructs as JSON and NDJSON
+
+Requirements tested:
+- NDJSON output holds one parseable object per construct, one per line
+- Json output is a single array of the same objects (and [] when empty)
+- Names, parameters, base classes, docstrings and source locations round-trip,
+  including characters that need escaping
+- Absent return types and docstrings are written as null
+
+Testing rationale: Site generators and search indexers consume this stream in
+place of the markdown, so every field they read must survive serialization.
+*/
+void test_construct_stream_formats() {
+  CodeConstruct method{};
+  method.type = ConstructType::Method;
+  method.name = "resize";
+  method.full_name = "gfx::Buffer::resize";
+  method.namespace_path = "gfx::Buffer";
+  method.return_type = "bool";
+  method.parameters.push_back({"size_t", "bytes", std::nullopt});
+  method.parameters.push_back({"const std::string&", "label", std::string("\"none\"")});
+  method.is_const = true;
+  method.access_modifier = "public";
+  method.docstring = "Resize the buffer\nKeeps contents";
+  method.start_line = 12;
+  method.end_line = 14;
+  method.filename = "include/gfx/buffer.h";
+  method.source_locations = {"include/gfx/buffer.h:12", "src/gfx/buffer.cpp:40"};
+
+  CodeConstruct type{};
+  type.type = ConstructType::Class;
+  type.name = "Buffer";
+  type.full_name = "gfx::Buffer";
+  type.namespace_path = "gfx";
+  type.base_classes = {"Resource"};
+  type.start_line = 5;
+  type.end_line = 30;
+  type.filename = "include/gfx/buffer.h";
+
+  std::ostringstream ndjson;
+  ConstructStreamWriter lines(ndjson, ConstructFormat::Ndjson);
+  lines.write(method);
+  lines.write(type);
+  TEST_ASSERT_TRUE(lines.finish(), "ndjson_finish_succeeds");
+  TEST_ASSERT_EQ(size_t(2), lines.count(), "ndjson_count");
+
+  std::istringstream input(ndjson.str());
+  std::vector<std::string> records;
+  for (std::string line; std::getline(input, line);) {
+    records.push_back(line);
+  }
+  TEST_ASSERT_EQ(size_t(2), records.size(), "ndjson_one_line_per_construct");
+
+  auto first = JsonDoc::parse(records.empty() ? "" : records[0]);
+  TEST_ASSERT_TRUE(first.has_value(), "ndjson_line_parses");
+  if (first) {
+    JsonValue root = first->root();
+    TEST_ASSERT_EQ(std::string("method"), root["type"].asString(), "type_written");
+    TEST_ASSERT_EQ(std::string("gfx::Buffer::resize"), root["full_name"].asString(), "full_name_written");
+    TEST_ASSERT_EQ(std::string("bool"), root["return_type"].asString(), "return_type_written");
+    TEST_ASSERT_EQ(std::string("label"), root["parameters"][1]["name"].asString(), "parameter_name_written");
+    TEST_ASSERT_EQ(std::string("\"none\""), root["parameters"][1]["default"].asString(), "default_escaped");
+    TEST_ASSERT_TRUE(root["parameters"][0]["default"].isNull(), "missing_default_is_null");
+    TEST_ASSERT_EQ(std::string("Resize the buffer\nKeeps contents"), root["docstring"].asString(), "docstring_escaped");
+    TEST_ASSERT_TRUE(root["is_const"].asBool() && !root["is_static"].asBool(), "flags_written");
+    TEST_ASSERT_TRUE(root["source_locations"].asStringArray() == method.source_locations, "source_locations_written");
+  }
+
+  auto second = JsonDoc::parse(records.size() < 2 ? "" : records[1]);
+  TEST_ASSERT_TRUE(second.has_value(), "second_ndjson_line_parses");
+  if (second) {
+    JsonValue root = second->root();
+    TEST_ASSERT_TRUE(root["base_classes"].asStringArray() == type.base_classes, "base_classes_written");
+    TEST_ASSERT_TRUE(root["return_type"].isNull(), "missing_return_type_is_null");
+    TEST_ASSERT_TRUE(root["docstring"].isNull(), "missing_docstring_is_null");
+  }
+
+  std::ostringstream json;
+  ConstructStreamWriter array(json, ConstructFormat::Json);
+  array.write(method);
+  array.write(type);
+  TEST_ASSERT_TRUE(array.finish(), "json_finish_succeeds");
+  auto doc = JsonDoc::parse(json.str());
+  TEST_ASSERT_TRUE(doc.has_value() && doc->root().isArray(), "json_output_is_array");
+  if (doc) {
+    TEST_ASSERT_EQ(std::string("gfx::Buffer"), doc->root()[1]["full_name"].asString(), "json_array_in_write_order");
+  }
+
+  std::ostringstream empty;
+  ConstructStreamWriter none(empty, ConstructFormat::Json);
+  TEST_ASSERT_TRUE(none.finish(), "empty_json_finish_succeeds");
+  TEST_ASSERT_EQ(std::string("[]\n"), empty.str(), "empty_json_is_empty_array");
+
+  ConstructFormat format = ConstructFormat::Json;
+  TEST_ASSERT_TRUE(parseConstructFormat("ndjson", format) && format == ConstructFormat::Ndjson, "ndjson_format_parsed");
+  TEST_ASSERT_FALSE(parseConstructFormat("xml", format), "unknown_format_rejected");
+}
+
+/**
+@brief Tests storing and reloading constructs through a spill file
+
+Requirements tested:
+- A stored construct reloads with the fields the merge and markdown pages use
+- Storing a construct again under the same signature replaces the earlier record; overloads are kept apart
+- Unknown names and constructs without a full name are not found or stored
+- The spill file is removed when the spill is destroyed
+
+Testing rationale: Streaming extraction merges later files with constructs read
+back from the spill, so anything lost in the round trip is lost from the docs.
+*/
+void test_construct_spill_round_trip() {
+  std::string spill_path = markdown_test_output_dir + "/spill.ndjson";
+  StringInterner strings;
+  {
+    ConstructSpill spill(spill_path);
+    TEST_ASSERT_TRUE(spill.isOpen(), "spill_file_created");
+
+    CodeConstruct area{};
+    area.type = ConstructType::Function;
+    area.name = "area";
+    area.full_name = "geo::area";
+    area.namespace_path = "geo";
+    area.return_type = "double";
+    area.parameters.push_back({"const Shape&", "shape", std::nullopt});
+    area.docstring = "Compute the area";
+    area.start_line = 3;
+    area.end_line = 3;
+    area.filename = "geo.h";
+    TEST_ASSERT_TRUE(spill.store(area), "construct_stored");
+
+    CodeConstruct unnamed{};
+    unnamed.type = ConstructType::Variable;
+    TEST_ASSERT_FALSE(spill.store(unnamed), "unnamed_construct_not_stored");
+
+    area.is_merged = true;
+    area.source_locations = {"geo.h:3", "geo.cpp:12"};
+    area.merged_docstrings = {"Compute the area", "Uses the shoelace formula"};
+    TEST_ASSERT_TRUE(spill.store(area), "construct_replaced");
+    TEST_ASSERT_EQ(size_t(1), spill.size(), "replacement_keeps_one_key");
+
+    CodeConstruct by_count = area;
+    by_count.parameters[0].type = "int";
+    TEST_ASSERT_TRUE(spill.store(by_count), "overload_stored");
+    TEST_ASSERT_EQ(size_t(2), spill.size(), "overloads_stored_apart");
+    TEST_ASSERT_TRUE(spill.contains("geo::area(int)") && !spill.contains("geo::area"), "spill_keyed_by_signature");
+
+    auto loaded = spill.load(overloadSignature(area), strings);
+    TEST_ASSERT_TRUE(loaded.has_value(), "construct_reloaded");
+    if (loaded) {
+      TEST_ASSERT_TRUE(loaded->type == ConstructType::Function && loaded->namespace_path == "geo" &&
+                       loaded->filename == "geo.h" && loaded->return_type == std::string_view("double"),
+                       "reloaded_fields_match");
+      TEST_ASSERT_TRUE(loaded->parameters.size() == 1 && loaded->parameters[0].type == "const Shape&",
+                       "reloaded_parameters_match");
+      TEST_ASSERT_TRUE(loaded->is_merged && loaded->merged_docstrings == area.merged_docstrings &&
+                       loaded->source_locations == area.source_locations, "reloaded_latest_record");
+    }
+    TEST_ASSERT_FALSE(spill.load("geo::volume(const Shape&)", strings).has_value(), "unknown_name_not_found");
+  }
+  TEST_ASSERT_FALSE(std::filesystem::exists(spill_path), "spill_file_removed");
+}
+
+/**
+@brief Tests building the search index from rendered constructs and writing its shards
+
+Requirements tested:
+- Names are split into whole identifiers and their snake/camel-case parts, lowercased, without stop words
+- Every page the generator renders gets a document with its title, kind and terms
+- The document table survives a save/load round trip; dropped pages free their id for the next page
+- A table whose document count the file cannot hold is rejected as corrupt
+- Shards hold each term in the shard searchShardOf names, with delta-encoded postings
+- Rewriting unchanged documents leaves every file alone
+
+Testing rationale: The index is only updated for pages a run renders, so the
+stored documents, ids and shard files have to stay exactly in step across runs.
+*/
+void test_search_index_shards() {
+  std::vector<std::string> terms;
+  tokenizeForSearch("parseHTTPHeader(max_size_) is the API", terms);
+  TEST_ASSERT_TRUE(terms == std::vector<std::string>({"parsehttpheader", "parse", "http", "header",
+                                                      "max_size", "max", "size", "api"}), "terms_tokenized");
+
+  CodeConstruct area{};
+  area.type = ConstructType::Function;
+  area.name = "area";
+  area.full_name = "geo::area";
+  area.docstring = "Compute the polygon area";
+  CodeConstruct shape{};
+  shape.type = ConstructType::Class;
+  shape.name = "Shape";
+  shape.full_name = "geo::Shape";
+  shape.docstring = "Base polygon type";
+
+  SearchIndex index;
+  MarkdownGenerator generator;
+  generator.setSearchIndex(&index);
+  generator.generateMarkdownFromConstructs({area, shape}, markdown_test_output_dir + "/pages");
+  generator.setSearchIndex(nullptr);
+  const SearchDocument* document = index.document("geo.area.md");
+  TEST_ASSERT_EQ(size_t(2), index.size(), "rendered_pages_indexed");
+  TEST_ASSERT_TRUE(document && document->title == "geo::area" && document->kind == "function", "document_describes_page");
+  TEST_ASSERT_TRUE(document && document->terms == std::vector<std::string>({"area", "compute", "geo", "polygon"}),
+                   "document_terms_sorted_and_distinct");
+
+  std::string table = markdown_test_output_dir + "/search.docs";
+  TEST_ASSERT_TRUE(index.save(table), "documents_saved");
+  SearchIndex loaded;
+  TEST_ASSERT_TRUE(loaded.load(table) && loaded.size() == 2 && !loaded.changed(), "documents_loaded");
+
+  std::string corrupt_table = markdown_test_output_dir + "/corrupt.docs";
+  {
+    std::ifstream saved(table, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(saved)), std::istreambuf_iterator<char>());
+    bytes.replace(12, 4, "\xff\xff\xff\xff");
+    std::ofstream corrupt(corrupt_table, std::ios::binary);
+    corrupt << bytes;
+  }
+  SearchIndex corrupted;
+  TEST_ASSERT_FALSE(corrupted.load(corrupt_table), "oversized_document_count_rejected");
+  TEST_ASSERT_EQ(size_t(0), corrupted.size(), "corrupt_table_leaves_index_empty");
+
+  std::string dir = markdown_test_output_dir + "/search";
+  TEST_ASSERT_TRUE(loaded.writeShards(dir, 4), "shards_written");
+  TEST_ASSERT_EQ(size_t(5), loaded.filesWritten(), "docs_and_every_shard_written");
+
+  // "polygon" is in both documents (ids 0 and 1), so its postings are the deltas 0 and 1
+  std::ifstream shard_file(dir + "/shard-" + std::to_string(searchShardOf("polygon", 4)) + ".bin", std::ios::binary);
+  std::string shard((std::istreambuf_iterator<char>(shard_file)), std::istreambuf_iterator<char>());
+  TEST_ASSERT_TRUE(shard.starts_with("CSRCHSHD"), "shard_magic_written");
+  TEST_ASSERT_TRUE(shard.find(std::string("\x07polygon\x02\x00\x01", 11)) != std::string::npos, "postings_delta_encoded");
+
+  loaded.addPage("geo.Shape.md", "class", shape);
+  TEST_ASSERT_FALSE(loaded.changed(), "identical_document_unchanged");
+  TEST_ASSERT_TRUE(loaded.writeShards(dir, 4), "shards_rewritten");
+  TEST_ASSERT_EQ(size_t(0), loaded.filesWritten(), "unchanged_shards_left_alone");
+
+  loaded.retainPages({"geo.Shape.md"});
+  CodeConstruct circle = shape;
+  circle.name = "Circle";
+  circle.full_name = "geo::Circle";
+  loaded.addPage("geo.Circle.md", "class", circle);
+  TEST_ASSERT_TRUE(loaded.changed() && loaded.size() == 2 && !loaded.document("geo.area.md"), "removed_page_dropped");
+  TEST_ASSERT_TRUE(loaded.writeShards(dir, 4), "shards_updated");
+  std::ifstream docs_file(dir + "/docs.json", std::ios::binary);
+  std::string docs((std::istreambuf_iterator<char>(docs_file)), std::istreambuf_iterator<char>());
+  TEST_ASSERT_TRUE(docs.find("[\"geo.Circle.md\",\"geo::Circle\",\"class\"],\n[\"geo.Shape.md\"") != std::string::npos,
+                   "freed_id_reused");
+}
+
+/**
+@brief Tests page file names: escaping, length bound and overload pages
+
+Requirements tested:
+- "::" becomes '.', invalid characters are escaped and spaces become '_'
+- Reserved Windows device names are altered
+- Long names are cut to the bound with a hash suffix that keeps them distinct
+- Overloads get a page each, named from their own signature, while repeats of one construct still share a page
+
+Testing rationale: Page names are links and cache keys, so they must be the
+same on every run, valid on every platform, and never shared by two overloads.
+*/
+void test_page_names() {
+  std::string name = "stale content";
+  encodePageName("geo::Shape::operator<", name);
+  TEST_ASSERT_EQ(std::string("geo.Shape.operator%lt.md"), name, "page_name_dotted_and_escaped");
+  encodePageName("std::map<K, V*>::find", name);
+  TEST_ASSERT_EQ(std::string("std.map%ltK,_V%star%gt.find.md"), name, "page_name_characters_escaped");
+  encodePageName("con::Device", name);
+  TEST_ASSERT_EQ(std::string("con_.Device.md"), name, "page_name_device_name_altered");
+
+  std::string long_name = "ns::" + std::string(300, 'a');
+  std::string other_name = "ns::" + std::string(299, 'a') + "b";
+  std::string truncated;
+  std::string other;
+  encodePageName(long_name, truncated);
+  encodePageName(other_name, other);
+  TEST_ASSERT_TRUE(truncated.size() <= kMaxPageNameLength && truncated.ends_with(".md"), "page_name_bounded");
+  TEST_ASSERT_TRUE(truncated != other && truncated.substr(0, 100) == other.substr(0, 100), "page_name_truncation_distinct");
+  encodePageName(long_name, name);
+  TEST_ASSERT_EQ(truncated, name, "page_name_truncation_stable");
+  appendOverloadSuffix(name, "(int)");
+  TEST_ASSERT_TRUE(name.size() <= kMaxPageNameLength, "page_name_bounded_with_overload_suffix");
+
+  CodeConstruct by_int{};
+  by_int.type = ConstructType::Function;
+  by_int.name = "scale";
+  by_int.full_name = "geo::scale";
+  by_int.filename = "src/geo.cpp";
+  by_int.parameters.push_back({"int", "factor", std::nullopt});
+  CodeConstruct by_double = by_int;
+  by_double.parameters[0].type = "double";
+
+  CodeConstruct by_nothing = by_int;
+  by_nothing.parameters.clear();
+  CodeConstruct spaced = by_int;
+  spaced.parameters[0].type = " int ";
+
+  MarkdownGenerator generator;
+  GeneratedFileMap outputs =
+    generator.generateMarkdownFromConstructs({by_int, by_double, by_nothing, spaced}, markdown_test_output_dir);
+  const auto& pages = outputs["src/geo.cpp"];
+  TEST_ASSERT_EQ(size_t(3), pages.size(), "overloads_get_own_pages");
+  TEST_ASSERT_TRUE(pages.size() == 3 && pages[0].starts_with(markdown_test_output_dir + "/geo.scale~") &&
+                   pages[1].starts_with(markdown_test_output_dir + "/geo.scale~"), "overloads_with_parameters_suffixed");
+  TEST_ASSERT_TRUE(pages.size() == 3 && pages[2] == markdown_test_output_dir + "/geo.scale.md",
+                   "parameterless_overload_keeps_plain_name");
+  TEST_ASSERT_EQ(size_t(3), generator.writtenCount(), "repeated_construct_shares_page");
+
+  // A run that sees one overload alone (an incremental or streamed batch) names it the same way
+  MarkdownGenerator alone;
+  GeneratedFileMap alone_outputs = alone.generateMarkdownFromConstructs({by_double}, markdown_test_output_dir);
+  TEST_ASSERT_TRUE(pages.size() == 3 && alone_outputs["src/geo.cpp"] == std::vector<std::string>({pages[1]}),
+                   "overload_page_independent_of_other_overloads");
+}
+
 void run_markdown_generator_tests() {
   setupMarkdownTest();
   
-  test_generate_simple_markdown();
+  RUN_TEST(test_generate_simple_markdown);
   teardownMarkdownTest();
   setupMarkdownTest();
   
-  test_generate_class_markdown();
+  RUN_TEST(test_generate_class_markdown);
   teardownMarkdownTest();
   setupMarkdownTest();
   
-  test_generate_multiple_markdown_files();
+  RUN_TEST(test_generate_multiple_markdown_files);
   teardownMarkdownTest();
   setupMarkdownTest();
   
-  test_generate_function_with_parameters();
+  RUN_TEST(test_generate_function_with_parameters);
   teardownMarkdownTest();
   setupMarkdownTest();
   
-  test_generate_empty_blocks();
+  RUN_TEST(test_generate_empty_blocks);
   teardownMarkdownTest();
   setupMarkdownTest();
   
-  test_markdown_frontmatter();
+  RUN_TEST(test_markdown_frontmatter);
   teardownMarkdownTest();
   setupMarkdownTest();
   
-  test_invalid_output_directory();
-  
+  RUN_TEST(test_invalid_output_directory);
+  teardownMarkdownTest();
+  setupMarkdownTest();
+
+  RUN_TEST(test_construct_outputs_by_source);
+  teardownMarkdownTest();
+  setupMarkdownTest();
+
+  RUN_TEST(test_unchanged_pages_not_rewritten);
+  teardownMarkdownTest();
+  setupMarkdownTest();
+
+  RUN_TEST(test_output_writer_batches);
+  teardownMarkdownTest();
+  setupMarkdownTest();
+
+  RUN_TEST(test_archive_output_mode);
+  teardownMarkdownTest();
+  setupMarkdownTest();
+
+  RUN_TEST(test_construct_stream_formats);
+  teardownMarkdownTest();
+  setupMarkdownTest();
+
+  RUN_TEST(test_construct_spill_round_trip);
+  teardownMarkdownTest();
+  setupMarkdownTest();
+
+  RUN_TEST(test_search_index_shards);
+  teardownMarkdownTest();
+  setupMarkdownTest();
+
+  RUN_TEST(test_page_names);
+
   teardownMarkdownTest();
 }
\ No newline at end of file
@@ -105,10 +105,10 @@ void test_destructor_extraction() {
 }
 
 void run_operator_extraction_tests() {
-  test_qualified_operator_extraction();
-  test_unqualified_operator_extraction();
-  test_subscript_operator_extraction();
-  test_unqualified_subscript_operator();
-  test_simple_function_extraction();
-  test_destructor_extraction();
+  RUN_TEST(test_qualified_operator_extraction);
+  RUN_TEST(test_unqualified_operator_extraction);
+  RUN_TEST(test_subscript_operator_extraction);
+  RUN_TEST(test_unqualified_subscript_operator);
+  RUN_TEST(test_simple_function_extraction);
+  RUN_TEST(test_destructor_extraction);
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+/**
+@brief Tests for profiling timers, counters and the trace report
+*/
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <backend/core/profile.h>
+#include "../testfrmwk/simple_test.h"
+
+/**
+@brief Tests stage totals, per-file timings and the written report
+
+Requirements tested:
+- Nothing is recorded while profiling is off
+- Each stage is summed over its occurrences
+- Files are ranked by their "file" stage time with their parse time attached
+- Counters accumulate
+- A file's peak memory keeps the largest record and is reported in KB
+- The report contains trace events and the summaries
+
+Testing rationale: The profile is used to decide which headers to exclude, so
+a file credited with another file's time would point at the wrong header.
+*/
+void test_profile_report() {
+  profile::stop();
+  {
+    profile::ScopedTimer ignored("file", "ignored.cpp");
+    profile::count("ignored");
+  }
+
+  profile::start();
+  TEST_ASSERT_TRUE(profile::enabled(), "profile_enabled_after_start");
+  {
+    profile::ScopedTimer file("file", "slow.cpp");
+    profile::ScopedTimer parse("parse", "slow.cpp");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  profile::peakMemory("slow.cpp", 4096);
+  profile::peakMemory("slow.cpp", 2048);
+  {
+    profile::ScopedTimer file("file", "fast.cpp");
+    profile::ScopedTimer parse("parse", "fast.cpp");
+    parse.stop();
+  }
+  profile::count("files_extracted", 2);
+  profile::count("files_extracted");
+  profile::stop();
+
+  auto stages = profile::stageSummaries();
+  TEST_ASSERT_EQ(size_t(2), stages.size(), "profile_one_summary_per_stage");
+  TEST_ASSERT_TRUE(stages[0].stage == "parse" && stages[0].calls == 2, "profile_stage_counts_calls");
+  TEST_ASSERT_TRUE(stages[1].total_ms >= 20 && stages[1].max_ms >= 20, "profile_stage_sums_durations");
+
+  auto files = profile::slowestFiles(1);
+  TEST_ASSERT_EQ(size_t(1), files.size(), "profile_slowest_files_limited");
+  TEST_ASSERT_TRUE(!files.empty() && files[0].path == "slow.cpp" && files[0].parse_ms >= 20,
+                   "profile_slowest_file_first_with_parse_time");
+  TEST_ASSERT_TRUE(!files.empty() && files[0].peak_bytes == 4096, "profile_file_keeps_largest_peak");
+
+  const std::string report_path = "test_profile_report.json";
+  TEST_ASSERT_TRUE(profile::writeReport(report_path, 5), "profile_report_written");
+  std::ifstream report(report_path);
+  std::stringstream content;
+  content << report.rdbuf();
+  std::string text = content.str();
+  TEST_ASSERT_TRUE(text.find("\"traceEvents\"") != std::string::npos &&
+                   text.find("\"ph\": \"X\"") != std::string::npos, "profile_report_has_trace_events");
+  TEST_ASSERT_TRUE(text.find("\"files_extracted\": 3") != std::string::npos, "profile_report_counters_accumulate");
+  TEST_ASSERT_TRUE(text.find("\"peak_kb\": 4") != std::string::npos, "profile_report_has_peak_memory");
+  TEST_ASSERT_TRUE(text.find("ignored") == std::string::npos, "profile_nothing_recorded_when_off");
+  report.close();
+  std::filesystem::remove(report_path);
+}
+
+void run_profile_tests() {
+  RUN_TEST(test_profile_report);
+}
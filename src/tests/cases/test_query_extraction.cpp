@@ -0,0 +1,107 @@
+/**
+@brief Tests for query-driven construct extraction
+*/
+#include <backend/doc/query_extractor.h>
+#include "../testfrmwk/simple_test.h"
+
+extern "C" const TSLanguage* tree_sitter_cpp(void);
+
+static const std::string construct_query = R"(
+(preproc_include path: (_) @include)
+(namespace_definition name: (_) @name body: (_)) @definition.namespace
+(class_specifier name: (_) @name body: (_)) @definition.class
+(function_definition
+  type: (_)? @return_type
+  declarator: (function_declarator declarator: (_) @name parameters: (_) @parameters)) @definition.function
+(field_declaration
+  type: (_)? @return_type
+  declarator: (function_declarator declarator: (_) @name parameters: (_) @parameters)) @definition.function
+)";
+
+// Parse source with the statically linked C++ grammar and run the query over it
+static std::vector<CodeConstruct> extractWithQuery(QueryExtractor& extractor, const TSQuery* query, const std::string& source) {
+  TSParser* parser = ts_parser_new();
+  ts_parser_set_language(parser, tree_sitter_cpp());
+  TSTree* tree = ts_parser_parse_string(parser, nullptr, source.c_str(), static_cast<uint32_t>(source.length()));
+  std::vector<CodeConstruct> constructs = extractor.extractConstructs(tree, source, "shapes.cpp", query);
+  ts_tree_delete(tree);
+  ts_parser_delete(parser);
+  return constructs;
+}
+
+static const CodeConstruct* findQueryConstruct(const std::vector<CodeConstruct>& constructs, const std::string& full_name) {
+  for (const auto& construct : constructs) {
+    if (construct.full_name == full_name) return &construct;
+  }
+  return nullptr;
+}
+
+/**
+@brief Tests that a construct query produces namespaced constructs
+
+Requirements tested:
+- Definition captures become constructs of the matching type
+- Enclosing namespaces and classes give members their namespace path
+- Qualified out-of-class definitions merge with their in-class declaration
+- Return types, parameters and include paths are captured
+
+Testing rationale: The query engine replaces recursion with a scope stack over
+matches, so nesting and merging must come out the same as the AST walk.
+*/
+void test_query_constructs() {
+  TSQueryPtr query = compileQuery(tree_sitter_cpp(), construct_query, "test query");
+  TEST_ASSERT_TRUE(query != nullptr, "query_compiles");
+  if (!query) return;
+
+  QueryExtractor extractor;
+  std::string source = R"(#include "shape.h"
+namespace geo {
+class Circle {
+  public:
+    double area(double scale) const;
+};
+double Circle::area(double scale) const { return scale; }
+}
+int main() { return 0; }
+)";
+  auto constructs = extractWithQuery(extractor, query.get(), source);
+
+  const CodeConstruct* ns = findQueryConstruct(constructs, "geo");
+  TEST_ASSERT_TRUE(ns && ns->type == ConstructType::Namespace, "query_namespace_extracted");
+
+  const CodeConstruct* circle = findQueryConstruct(constructs, "geo::Circle");
+  TEST_ASSERT_TRUE(circle && circle->type == ConstructType::Class && circle->namespace_path == "geo",
+                   "query_class_namespaced");
+
+  const CodeConstruct* area = findQueryConstruct(constructs, "geo::Circle::area");
+  TEST_ASSERT_TRUE(area && area->type == ConstructType::Function && area->namespace_path == "geo::Circle",
+                   "query_method_namespaced");
+  TEST_ASSERT_TRUE(area && area->is_merged && area->source_locations.size() == 2, "query_definition_merged");
+  TEST_ASSERT_TRUE(area && area->return_type && *area->return_type == "double", "query_return_type");
+  TEST_ASSERT_TRUE(area && area->parameters.size() == 1 && area->parameters[0].name == "scale" &&
+                   area->parameters[0].type == "double", "query_parameters");
+
+  const CodeConstruct* entry = findQueryConstruct(constructs, "main");
+  TEST_ASSERT_TRUE(entry && entry->namespace_path.empty() && entry->filename == "shapes.cpp", "query_global_function");
+
+  TEST_ASSERT_TRUE(extractor.includes().size() == 1 && extractor.includes()[0] == "shape.h", "query_include_captured");
+}
+
+/**
+@brief Tests that an invalid query is rejected
+
+Requirements tested:
+- compileQuery returns null for a query naming an unknown node type
+
+Testing rationale: A broken query file must disable query extraction for its
+language instead of crashing the run.
+*/
+void test_invalid_query() {
+  TSQueryPtr query = compileQuery(tree_sitter_cpp(), "(no_such_node) @definition.function", "test query");
+  TEST_ASSERT_TRUE(query == nullptr, "invalid_query_rejected");
+}
+
+void run_query_extraction_tests() {
+  RUN_TEST(test_query_constructs);
+  RUN_TEST(test_invalid_query);
+}
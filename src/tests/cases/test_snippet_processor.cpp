@@ -0,0 +1,270 @@
+/**
+@brief Tests for the snippet processing stage: cross-references, namespace pages and incremental output
+*/
+#include <filesystem>
+#include <fstream>
+#include <backend/doc/snippet_processor.h>
+#include "../testfrmwk/simple_test.h"
+
+static const std::string processor_extract_dir = "test_processor_extract";
+static const std::string processor_output_dir = "test_processor_output";
+
+static void writeSnippet(const std::string& page, const std::string& content) {
+  std::ofstream file(processor_extract_dir + "/" + page, std::ios::binary);
+  file << content;
+}
+
+static std::string readOutput(const std::string& page) {
+  std::ifstream file(processor_output_dir + "/" + page, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+static std::string snippet(const std::string& name, const std::string& full_name, const std::string& namespace_path,
+                           const std::string& body) {
+  std::string content = "---\ntype: class\n";
+  if (!namespace_path.empty()) content += "namespace: " + namespace_path + "\n";
+  content += "name: " + name + "\nfull_name: " + full_name + "\n---\n\n# " + name + "\n\n" + body;
+  return content;
+}
+
+/**
+@brief Tests that inline code references to documented symbols become links
+
+Requirements tested:
+- Qualified and unique unqualified names resolve, with or without a trailing "()"
+- Fenced code blocks, frontmatter, existing link text and self references are left alone
+- Unknown names stay plain code spans
+
+Testing rationale: Links are rewritten into every page, so a false positive
+corrupts code samples and a missed one leaves the docs unconnected.
+*/
+void test_cross_references_linked() {
+  SymbolIndex index;
+  index.add({"geo.Shape.md", "class", "Shape", "geo::Shape", "geo", "", 0, {}});
+  index.add({"geo.Shape.area.md", "method", "area", "geo::Shape::area", "geo", "", 0, {}});
+
+  std::string content = "---\nname: `Shape`\n---\n\n```cpp\nShape s;\n```\n"
+                        "Uses `geo::Shape` and `area()`, see [`Shape`](elsewhere.md), not `int`.\n"
+                        "Self: `geo::Shape::area`";
+  std::string linked = SnippetProcessor::linkReferences(content, index, "geo.Shape.area.md");
+
+  TEST_ASSERT_TRUE(linked.find("[`geo::Shape`](geo.Shape.md)") != std::string::npos, "qualified_reference_linked");
+  TEST_ASSERT_TRUE(linked.find("`area()`,") != std::string::npos, "self_reference_not_linked");
+  TEST_ASSERT_TRUE(linked.find("name: `Shape`\n") != std::string::npos, "frontmatter_untouched");
+  TEST_ASSERT_TRUE(linked.find("```cpp\nShape s;\n```") != std::string::npos, "fenced_code_untouched");
+  TEST_ASSERT_TRUE(linked.find("[`Shape`](elsewhere.md)") != std::string::npos, "existing_link_kept");
+  TEST_ASSERT_TRUE(linked.find("not `int`.") != std::string::npos, "unknown_reference_plain");
+  TEST_ASSERT_TRUE(linked.ends_with("Self: `geo::Shape::area`"), "trailing_line_without_newline_kept");
+
+  std::string other = SnippetProcessor::linkReferences("Uses `area()`\n", index, "geo.Shape.md", "../");
+  TEST_ASSERT_EQ(other, std::string("Uses [`area()`](../geo.Shape.area.md)\n"), "unqualified_reference_linked_with_prefix");
+
+  index.add({"other.area.md", "function", "area", "other::area", "other", "", 0, {}});
+  TEST_ASSERT_TRUE(index.resolve("area") == nullptr, "ambiguous_unqualified_name_not_resolved");
+}
+
+/**
+@brief Tests that processing only redoes pages whose inputs changed
+
+Requirements tested:
+- A first run produces every page and the namespace pages
+- An identical rerun reads and writes nothing
+- Editing one snippet rewrites only that page; adding a symbol relinks only pages referring to it
+- Pages identical to their snippet are hard linked rather than copied
+- Snippets handed over in memory are used instead of the files on disk
+- Outputs of deleted snippets are removed
+
+Testing rationale: generate used to copy every snippet on every run; the
+manifest has to make unchanged runs free without ever leaving a stale page.
+*/
+void test_incremental_processing() {
+  std::filesystem::remove_all(processor_extract_dir);
+  std::filesystem::remove_all(processor_output_dir);
+  std::filesystem::create_directories(processor_extract_dir);
+
+  writeSnippet("geo.Shape.md", snippet("Shape", "geo::Shape", "geo", "Base of `Circle`.\n"));
+  writeSnippet("plain.md", snippet("plain", "plain", "", "No references.\n"));
+
+  SnippetProcessor first;
+  TEST_ASSERT_TRUE(first.process(processor_extract_dir, processor_output_dir), "first_run_succeeds");
+  TEST_ASSERT_EQ(first.writtenCount() + first.linkedCount(), size_t(2), "first_run_produces_all_pages");
+  TEST_ASSERT_TRUE(std::filesystem::exists(processor_output_dir + "/namespaces/ns.geo.md"), "namespace_page_written");
+  TEST_ASSERT_TRUE(readOutput("namespaces/index.md").find("[`geo`](ns.geo.md)") != std::string::npos, "namespace_index_lists_namespace");
+
+  SnippetProcessor rerun;
+  rerun.process(processor_extract_dir, processor_output_dir);
+  TEST_ASSERT_EQ(rerun.unchangedCount(), size_t(2), "identical_rerun_touches_nothing");
+
+  // A new symbol is what "Circle" was waiting for; plain.md does not refer to it
+  writeSnippet("geo.Circle.md", snippet("Circle", "geo::Circle", "geo", "Derives from `geo::Shape`.\n"));
+  SnippetProcessor added;
+  added.process(processor_extract_dir, processor_output_dir);
+  TEST_ASSERT_EQ(added.unchangedCount(), size_t(1), "unaffected_page_untouched");
+  TEST_ASSERT_TRUE(readOutput("geo.Shape.md").find("[`Circle`](geo.Circle.md)") != std::string::npos, "new_symbol_relinks_referrer");
+  TEST_ASSERT_TRUE(readOutput("namespaces/ns.geo.md").find("geo::Circle") != std::string::npos, "namespace_page_updated");
+
+  #ifndef _WIN32
+    TEST_ASSERT_TRUE(std::filesystem::equivalent(processor_extract_dir + "/plain.md", processor_output_dir + "/plain.md"),
+                     "identical_page_hard_linked");
+  #endif
+
+  // Pages rendered earlier in the same run are used as given, without reading the snippet back
+  std::string rendered_shape = snippet("Shape", "geo::Shape", "geo", "Rendered in memory, like `Circle`.\n");
+  writeSnippet("geo.Shape.md", snippet("Shape", "geo::Shape", "geo", "Changed on disk.\n"));
+  std::unordered_map<std::string, std::string> rendered = {{"geo.Shape.md", rendered_shape}};
+  SnippetProcessor in_memory;
+  in_memory.setRenderedSnippets(&rendered);
+  in_memory.process(processor_extract_dir, processor_output_dir);
+  TEST_ASSERT_TRUE(readOutput("geo.Shape.md").find("Rendered in memory") != std::string::npos, "rendered_snippet_used_from_memory");
+
+  std::filesystem::remove(processor_extract_dir + "/plain.md");
+  SnippetProcessor removed;
+  removed.process(processor_extract_dir, processor_output_dir);
+  TEST_ASSERT_EQ(removed.removedCount(), size_t(1), "deleted_snippet_output_removed");
+  TEST_ASSERT_FALSE(std::filesystem::exists(processor_output_dir + "/plain.md"), "deleted_snippet_output_gone");
+
+  std::filesystem::remove_all(processor_extract_dir);
+  std::filesystem::remove_all(processor_output_dir);
+}
+
+/**
+@brief Tests the saved symbol index: writing, mapping and every lookup it offers
+
+Requirements tested:
+- Frontmatter file, start_line, return_type and parameter_types fill the symbol's location and used types
+- Type names are collected from signatures without keywords, template punctuation or a leading "::"
+- A written index maps back with exact, prefix, unqualified-name and used-type lookups
+- Processing snippets saves the index next to them
+
+Testing rationale: The index is read by tools that never see the markdown, so
+every lookup has to agree with the frontmatter it was built from.
+*/
+void test_symbol_index_file() {
+  std::string page = "---\ntype: method\nnamespace: geo\nname: area\nfull_name: geo::Shape::area\n"
+                     "file: include/geo/shape.h\nstart_line: 42\nreturn_type: double\n"
+                     "parameter_types:\n  - const geo::Units&\n---\n\n# area\n";
+  auto parsed = parseSymbolFrontmatter("geo.Shape.area.md", page);
+  TEST_ASSERT_TRUE(parsed.has_value(), "frontmatter_parsed");
+  TEST_ASSERT_EQ(std::string("include/geo/shape.h"), parsed->file, "frontmatter_file_read");
+  TEST_ASSERT_EQ(uint32_t(42), parsed->line, "frontmatter_line_read");
+  TEST_ASSERT_TRUE(parsed->uses == std::vector<std::string>({"geo::Units"}), "frontmatter_used_types_read");
+
+  std::vector<std::string> names;
+  collectTypeNames("const std::vector<::geo::Shape>&", names);
+  TEST_ASSERT_TRUE(names == std::vector<std::string>({"std::vector", "geo::Shape"}), "type_names_collected");
+
+  std::filesystem::remove_all(processor_extract_dir);
+  std::filesystem::create_directories(processor_extract_dir);
+  std::string path = symbolIndexPath(processor_extract_dir);
+  std::vector<SymbolInfo> symbols = {
+    *parsed,
+    {"geo.Shape.md", "class", "Shape", "geo::Shape", "geo", "include/geo/shape.h", 10, {}},
+    {"geo.Shape.scale.md", "method", "scale", "geo::Shape::scale", "geo", "include/geo/shape.h", 50, {"geo::Shape"}},
+    {"geo.area.md", "function", "area", "geo::area", "geo", "include/geo/area.h", 5, {"geo::Shape", "geo::Units"}},
+  };
+  TEST_ASSERT_TRUE(writeSymbolIndex(path, symbols), "index_written");
+
+  SymbolIndexView view;
+  TEST_ASSERT_TRUE(view.open(path), "index_opened");
+  TEST_ASSERT_EQ(size_t(4), view.size(), "index_holds_every_symbol");
+  auto shape = view.find("::geo::Shape");
+  TEST_ASSERT_TRUE(shape.has_value(), "exact_lookup_found");
+  TEST_ASSERT_EQ(std::string("geo.Shape.md"), std::string(view.symbolAt(*shape).page), "exact_lookup_page");
+  TEST_ASSERT_EQ(uint32_t(10), view.symbolAt(*shape).line, "exact_lookup_line");
+  TEST_ASSERT_FALSE(view.find("geo::Circle").has_value(), "missing_symbol_not_found");
+
+  auto [begin, end] = view.prefixRange("geo::Shape::");
+  TEST_ASSERT_EQ(size_t(2), end - begin, "prefix_lookup_finds_members");
+  TEST_ASSERT_EQ(std::string("geo::Shape::area"), std::string(view.symbolAt(begin).full_name), "prefix_lookup_sorted");
+  TEST_ASSERT_EQ(size_t(2), view.withName("area").size(), "unqualified_lookup_finds_overloads");
+
+  std::vector<size_t> users = view.usersOf("geo::Units");
+  TEST_ASSERT_EQ(size_t(2), users.size(), "type_users_found");
+  TEST_ASSERT_EQ(size_t(2), view.usersOf("::geo::Shape").size(), "type_users_found_with_root_prefix");
+  TEST_ASSERT_TRUE(view.usersOf("geo::Circle").empty(), "unused_type_has_no_users");
+  view.close();
+
+  {
+    // The name table follows the 48-byte header and four 56-byte symbol records; point every slot past the end
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(48 + 4 * 56);
+    std::string corrupt(4 * 4, '\xff');
+    file.write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+  }
+  SymbolIndexView corrupted;
+  TEST_ASSERT_TRUE(corrupted.open(path), "corrupt_index_opened");
+  TEST_ASSERT_TRUE(corrupted.withName("area").empty(), "corrupt_name_slots_skipped");
+  TEST_ASSERT_TRUE(corrupted.withName("").empty(), "corrupt_name_slots_never_returned");
+  corrupted.close();
+
+  std::filesystem::remove(path);
+  writeSnippet("geo.Shape.md", snippet("Shape", "geo::Shape", "geo", "A shape.\n"));
+  SnippetProcessor processor;
+  TEST_ASSERT_TRUE(processor.process(processor_extract_dir, processor_output_dir), "processing_succeeds");
+  SymbolIndexView saved;
+  TEST_ASSERT_TRUE(saved.open(path) && saved.find("geo::Shape").has_value(), "processing_saves_index");
+  saved.close();
+
+  std::filesystem::remove_all(processor_extract_dir);
+  std::filesystem::remove_all(processor_output_dir);
+}
+
+/**
+@brief Tests that overloads sharing a full name each keep their page in the index
+
+Requirements tested:
+- The saved index holds one record per overload page, found by exact, prefix and name lookups
+- Each overload is listed as a user of the types in its own signature
+- Repeats of one page are stored once
+- References to the shared name link to the same overload whatever order pages were added in
+
+Testing rationale: Overload pages are named from their signatures, so
+keying the index by full name alone silently drops every overload but one.
+*/
+void test_symbol_index_overloads() {
+  SymbolInfo by_factor{"geo.scale~1a2b.md", "function", "scale", "geo::scale", "geo", "include/geo/scale.h", 5, {}};
+  SymbolInfo by_ratio{"geo.scale~3c4d.md", "function", "scale", "geo::scale", "geo", "include/geo/scale.h", 9,
+                      {"geo::Ratio"}};
+
+  std::filesystem::remove_all(processor_extract_dir);
+  std::filesystem::create_directories(processor_extract_dir);
+  std::string path = symbolIndexPath(processor_extract_dir);
+  TEST_ASSERT_TRUE(writeSymbolIndex(path, {by_ratio, by_factor, by_ratio}), "overload_index_written");
+
+  SymbolIndexView view;
+  TEST_ASSERT_TRUE(view.open(path), "overload_index_opened");
+  TEST_ASSERT_EQ(size_t(2), view.size(), "every_overload_indexed_once");
+  auto first = view.find("geo::scale");
+  TEST_ASSERT_TRUE(first.has_value(), "overload_found");
+  TEST_ASSERT_EQ(by_factor.page, std::string(view.symbolAt(*first).page), "first_overload_page");
+  auto [begin, end] = view.prefixRange("geo::scale");
+  TEST_ASSERT_EQ(size_t(2), end - begin, "prefix_lookup_finds_both_overloads");
+  TEST_ASSERT_EQ(by_ratio.page, std::string(view.symbolAt(begin + 1).page), "second_overload_page");
+  TEST_ASSERT_EQ(size_t(2), view.withName("scale").size(), "name_lookup_finds_both_overloads");
+  std::vector<size_t> users = view.usersOf("geo::Ratio");
+  TEST_ASSERT_EQ(size_t(1), users.size(), "overload_uses_kept_apart");
+  TEST_ASSERT_EQ(by_ratio.page, std::string(view.symbolAt(users[0]).page), "overload_user_page");
+  view.close();
+
+  SymbolIndex forward;
+  forward.add(by_factor);
+  forward.add(by_ratio);
+  SymbolIndex reverse;
+  reverse.add(by_ratio);
+  reverse.add(by_factor);
+  const std::string* linked = forward.resolve("scale");
+  TEST_ASSERT_TRUE(linked != nullptr, "overloaded_unqualified_name_resolved");
+  TEST_ASSERT_EQ(by_factor.page, *linked, "overloaded_name_links_first_page");
+  TEST_ASSERT_TRUE(reverse.resolve("geo::scale()") != nullptr && *reverse.resolve("geo::scale()") == by_factor.page,
+                   "overload_resolution_independent_of_order");
+  TEST_ASSERT_EQ(forward.fingerprint(), reverse.fingerprint(), "overload_fingerprint_independent_of_order");
+
+  std::filesystem::remove_all(processor_extract_dir);
+}
+
+void run_snippet_processor_tests() {
+  RUN_TEST(test_cross_references_linked);
+  RUN_TEST(test_incremental_processing);
+  RUN_TEST(test_symbol_index_file);
+  RUN_TEST(test_symbol_index_overloads);
+}
@@ -0,0 +1,83 @@
+/**
+@brief Tests for source file loading, size limits and skip rules
+*/
+#include <filesystem>
+#include <fstream>
+#include <backend/doc/source_reader.h>
+#include "../testfrmwk/simple_test.h"
+
+static const std::string source_reader_test_dir = "test_source_reader";
+
+static std::string writeSourceFile(const std::string& name, const std::string& content) {
+  std::string path = source_reader_test_dir + "/" + name;
+  std::ofstream file(path, std::ios::binary);
+  file << content;
+  return path;
+}
+
+/**
+@brief Tests reading files into the reusable buffer
+
+Requirements tested:
+- A file is read completely, byte for byte
+- A later, smaller file replaces the previous content entirely
+- A missing file is reported as unreadable with empty content
+
+Testing rationale: The buffer is reused across files, so stale bytes from a
+larger previous file would end up in the next parse.
+*/
+void test_source_reader_reads_files() {
+  std::filesystem::create_directories(source_reader_test_dir);
+  std::string large = writeSourceFile("large.cpp", "int a;\r\nint b;\nint c;\n");
+  std::string small = writeSourceFile("small.cpp", "int z;\n");
+
+  SourceReader reader;
+  TEST_ASSERT_TRUE(reader.read(large) == SourceStatus::Loaded, "source_read_loaded");
+  TEST_ASSERT_EQ(reader.content(), std::string("int a;\r\nint b;\nint c;\n"), "source_read_exact");
+  TEST_ASSERT_TRUE(reader.read(small) == SourceStatus::Loaded && reader.content() == "int z;\n",
+                   "source_buffer_reused_cleanly");
+  TEST_ASSERT_TRUE(reader.read(source_reader_test_dir + "/missing.cpp") == SourceStatus::Unreadable &&
+                   reader.content().empty(), "source_missing_unreadable");
+
+  std::filesystem::remove_all(source_reader_test_dir);
+}
+
+/**
+@brief Tests the size limit and binary/generated sniffing
+
+Requirements tested:
+- Files over the size limit are skipped without being read
+- Files with NUL bytes are skipped as binary
+- Generated-code markers skip a file only when skip_generated is on
+- Ordinary sources pass every rule
+
+Testing rationale: Skip rules decide what gets documented, so a false positive
+silently drops a real source file from the output.
+*/
+void test_source_reader_skip_rules() {
+  std::filesystem::create_directories(source_reader_test_dir);
+  std::string big = writeSourceFile("big.cpp", std::string(4096, ' ') + "int x;\n");
+  std::string binary = writeSourceFile("blob.h", std::string("\x7f" "ELF\0\0\0", 7));
+  std::string generated = writeSourceFile("proto.pb.h", "// Generated by the protocol buffer compiler.  DO NOT EDIT!\nint y;\n");
+  std::string plain = writeSourceFile("plain.cpp", "// Ordinary file\nint w;\n");
+
+  SourceReader reader;
+  SourceLimits limits;
+  limits.max_file_size = 1024;
+  reader.setLimits(limits);
+  TEST_ASSERT_TRUE(reader.read(big) == SourceStatus::TooLarge, "source_over_limit_skipped");
+  TEST_ASSERT_TRUE(reader.read(binary) == SourceStatus::Binary, "source_binary_skipped");
+  TEST_ASSERT_TRUE(reader.read(generated) == SourceStatus::Loaded, "source_generated_kept_by_default");
+
+  limits.skip_generated = true;
+  reader.setLimits(limits);
+  TEST_ASSERT_TRUE(reader.read(generated) == SourceStatus::Generated, "source_generated_skipped");
+  TEST_ASSERT_TRUE(reader.read(plain) == SourceStatus::Loaded, "source_plain_passes_rules");
+
+  std::filesystem::remove_all(source_reader_test_dir);
+}
+
+void run_source_reader_tests() {
+  RUN_TEST(test_source_reader_reads_files);
+  RUN_TEST(test_source_reader_skip_rules);
+}
@@ -1,35 +1,49 @@
 /**
 @brief Main entry point for running all Cesium unit tests
+
+Usage: cesium-tests [--jobs N]   (N suites at once; 0 = hardware concurrency, 1 = serial)
 */
 #include "testfrmwk/simple_test.h"
+#include <cstring>
 #include <backend/core/debug.h>
 #include "cases.h"
 
-int main() {
+int main(int argc, char* argv[]) {
   debug::suppressErrorDialogs();
 
+  size_t jobs = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+      jobs = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      std::cerr << "Unknown argument: " << argv[i] << std::endl;
+      return 2;
+    }
+  }
+
   std::cout << "Starting Cesium Documentation Generation Tests" << std::endl;
 
   SimpleTest::reset();
 
-  // Run all test suites
-  RUN_TEST_SUITE("JSON Configuration Tests", run_json_config_tests);
-  std::cout << "*** JSON tests completed successfully ***" << std::endl;
-
-  RUN_TEST_SUITE("Docstring Parser Tests", run_docstring_parser_tests);
-  std::cout << "*** Docstring parser tests completed successfully ***" << std::endl;
-
-  RUN_TEST_SUITE("Markdown Generator Tests", run_markdown_generator_tests);
-  std::cout << "*** Markdown generator tests completed successfully ***" << std::endl;
-
-  RUN_TEST_SUITE("CLI Integration Tests", run_cli_integration_tests);
-  std::cout << "*** CLI integration tests completed successfully ***" << std::endl;
-
-  RUN_TEST_SUITE("Operator Extraction Tests", run_operator_extraction_tests);
-  std::cout << "*** Operator extraction tests completed successfully ***" << std::endl;
-
-  RUN_TEST_SUITE("Dynamic Library Platform Tests", run_dynlib_platform_tests);
-  std::cout << "*** Dynamic library platform tests completed successfully ***" << std::endl;
+  // Serial suites change process-wide state (logging, profiler, tree-sitter allocator),
+  // wait on timers or assert timing budgets, so they run alone before the parallel ones
+  REGISTER_TEST_SUITE("JSON Configuration Tests", run_json_config_tests, SuiteMode::Parallel);
+  REGISTER_TEST_SUITE("Docstring Parser Tests", run_docstring_parser_tests, SuiteMode::Serial);
+  REGISTER_TEST_SUITE("Markdown Generator Tests", run_markdown_generator_tests, SuiteMode::Parallel);
+  REGISTER_TEST_SUITE("CLI Integration Tests", run_cli_integration_tests, SuiteMode::Parallel);
+  REGISTER_TEST_SUITE("Operator Extraction Tests", run_operator_extraction_tests, SuiteMode::Parallel);
+  REGISTER_TEST_SUITE("Dynamic Library Platform Tests", run_dynlib_platform_tests, SuiteMode::Parallel);
+  REGISTER_TEST_SUITE("AST Extraction Tests", run_ast_extraction_tests, SuiteMode::Serial);
+  REGISTER_TEST_SUITE("Documentation Cache Tests", run_documentation_cache_tests, SuiteMode::Parallel);
+  REGISTER_TEST_SUITE("Snippet Processor Tests", run_snippet_processor_tests, SuiteMode::Parallel);
+  REGISTER_TEST_SUITE("Query Extraction Tests", run_query_extraction_tests, SuiteMode::Parallel);
+  REGISTER_TEST_SUITE("Source Reader Tests", run_source_reader_tests, SuiteMode::Parallel);
+  REGISTER_TEST_SUITE("Glob Matcher Tests", run_glob_matcher_tests, SuiteMode::Parallel);
+  REGISTER_TEST_SUITE("Filesystem Scanner Tests", run_fs_scanner_tests, SuiteMode::Parallel);
+  REGISTER_TEST_SUITE("File Watcher Tests", run_file_watcher_tests, SuiteMode::Serial);
+  REGISTER_TEST_SUITE("Logging Tests", run_logging_tests, SuiteMode::Serial);
+  REGISTER_TEST_SUITE("Profile Tests", run_profile_tests, SuiteMode::Serial);
+  SimpleTest::run_registered_suites(jobs);
 
   // Print final summary and return appropriate exit code
   return SimpleTest::print_summary();
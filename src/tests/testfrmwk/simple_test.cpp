@@ -4,6 +4,13 @@
 #include "simple_test.h"
 
 // Static member definitions
-int SimpleTest::tests_run_ = 0;
-int SimpleTest::tests_failed_ = 0;
-std::vector<std::string> SimpleTest::failed_tests_;
\ No newline at end of file
+std::atomic<int> SimpleTest::tests_run_{0};
+std::atomic<int> SimpleTest::tests_failed_{0};
+std::vector<std::string> SimpleTest::failed_tests_;
+std::vector<SimpleTest::Timing> SimpleTest::test_timings_;
+std::vector<SimpleTest::Timing> SimpleTest::suite_timings_;
+std::vector<SimpleTest::Suite> SimpleTest::suites_;
+std::mutex SimpleTest::results_mutex_;
+thread_local std::ostringstream* SimpleTest::capture_ = nullptr;
+thread_local int SimpleTest::suite_run_ = 0;
+thread_local int SimpleTest::suite_failed_ = 0;
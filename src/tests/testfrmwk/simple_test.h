@@ -1,34 +1,120 @@
 /**
 @brief Simple lightweight testing framework for Cesium
+
+Suites are registered with REGISTER_TEST_SUITE and started with
+run_registered_suites, which runs the parallel suites concurrently on worker
+threads. Each suite's output is buffered and printed as one block when it
+finishes, so PASS/FAIL lines of different suites never interleave. Suites
+touching process-wide state (logging configuration, the profiler, the
+tree-sitter allocator) or asserting timing budgets are registered as serial
+and run alone.
+
+Test cases run through RUN_TEST are timed; print_summary lists the slowest.
+TEST_ASSERT_WITHIN_MS fails when a block exceeds its budget. Budgets are
+multiplied by the CESIUM_TEST_BUDGET_SCALE environment variable (e.g. 4 for
+sanitizer builds; 0 reports the time without enforcing it).
 */
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <functional>
+#include <thread>
 #include <vector>
 #include <sstream>
 
+/**
+@brief How a registered suite may be scheduled
+*/
+enum class SuiteMode {
+  Parallel,  ///< May run alongside other parallel suites
+  Serial     ///< Runs alone (process-wide state or timing budgets)
+};
+
 class SimpleTest {
   private:
-    static int tests_run_;
-    static int tests_failed_;
+    struct Suite {
+      std::string name;
+      std::function<void()> function;
+      SuiteMode mode;
+    };
+
+    struct Timing {
+      std::string name;
+      double ms;
+    };
+
+    static std::atomic<int> tests_run_;
+    static std::atomic<int> tests_failed_;
     static std::vector<std::string> failed_tests_;
-    
+    static std::vector<Timing> test_timings_;
+    static std::vector<Timing> suite_timings_;
+    static std::vector<Suite> suites_;
+    static std::mutex results_mutex_;
+    static thread_local std::ostringstream* capture_;  // Output of the suite this thread runs (null: direct)
+    static thread_local int suite_run_;                // Assertions of the suite this thread runs
+    static thread_local int suite_failed_;             // Failures of the suite this thread runs
+
+    static std::ostream& out() {
+      return capture_ ? static_cast<std::ostream&>(*capture_) : std::cout;
+    }
+
+    static std::ostream& err() {
+      return capture_ ? static_cast<std::ostream&>(*capture_) : std::cerr;
+    }
+
+    static void count_run() {
+      tests_run_++;
+      suite_run_++;
+    }
+
+    static void record_failure(const std::string& failure) {
+      tests_failed_++;
+      suite_failed_++;
+      {
+        std::lock_guard<std::mutex> lock(results_mutex_);
+        failed_tests_.push_back(failure);
+      }
+      err() << failure << std::endl;
+    }
+
+    static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static double budget_scale() {
+      const char* scale = std::getenv("CESIUM_TEST_BUDGET_SCALE");
+      return scale && *scale ? std::atof(scale) : 1.0;
+    }
+
+    // Runs one suite with its output buffered, then prints the block
+    static void run_captured(const Suite& suite) {
+      std::ostringstream buffer;
+      capture_ = &buffer;
+      run_test_suite(suite.name, suite.function);
+      capture_ = nullptr;
+      std::lock_guard<std::mutex> lock(results_mutex_);
+      std::cout << buffer.str() << std::flush;
+    }
+
   public:
     static void assert_true(bool condition, const std::string& test_name, const std::string& message = "") {
-      tests_run_++;
+      count_run();
       if (!condition) {
-        tests_failed_++;
         std::stringstream ss;
         ss << "FAIL: " << test_name;
         if (!message.empty()) {
           ss << " - " << message;
         }
-        failed_tests_.push_back(ss.str());
-        std::cerr << ss.str() << std::endl;
+        record_failure(ss.str());
       } else {
-        std::cout << "PASS: " << test_name << std::endl;
+        out() << "PASS: " << test_name << std::endl;
       }
     }
     
@@ -38,75 +124,171 @@ class SimpleTest {
     
     static void assert_equals(const std::string& expected, const std::string& actual, 
                              const std::string& test_name, const std::string& message = "") {
-      tests_run_++;
+      count_run();
       if (expected != actual) {
-        tests_failed_++;
         std::stringstream ss;
         ss << "FAIL: " << test_name << " - Expected: '" << expected << "', Got: '" << actual << "'";
         if (!message.empty()) {
           ss << " (" << message << ")";
         }
-        failed_tests_.push_back(ss.str());
-        std::cerr << ss.str() << std::endl;
+        record_failure(ss.str());
       } else {
-        std::cout << "PASS: " << test_name << std::endl;
+        out() << "PASS: " << test_name << std::endl;
       }
     }
     
     static void assert_equals(int expected, int actual, const std::string& test_name, const std::string& message = "") {
-      tests_run_++;
+      count_run();
       if (expected != actual) {
-        tests_failed_++;
         std::stringstream ss;
         ss << "FAIL: " << test_name << " - Expected: " << expected << ", Got: " << actual;
         if (!message.empty()) {
           ss << " (" << message << ")";
         }
-        failed_tests_.push_back(ss.str());
-        std::cerr << ss.str() << std::endl;
+        record_failure(ss.str());
       } else {
-        std::cout << "PASS: " << test_name << std::endl;
+        out() << "PASS: " << test_name << std::endl;
       }
     }
     
     template<typename T>
     static void assert_equals(T expected, T actual, const std::string& test_name, const std::string& message = "") {
-      tests_run_++;
+      count_run();
       if (expected != actual) {
-        tests_failed_++;
         std::stringstream ss;
         ss << "FAIL: " << test_name << " - Expected: " << expected << ", Got: " << actual;
         if (!message.empty()) {
           ss << " (" << message << ")";
         }
-        failed_tests_.push_back(ss.str());
-        std::cerr << ss.str() << std::endl;
+        record_failure(ss.str());
       } else {
-        std::cout << "PASS: " << test_name << std::endl;
+        out() << "PASS: " << test_name << std::endl;
       }
     }
     
+    /**
+    @brief Fail unless a block of code finishes within a time budget
+    @param budget_ms Budget in milliseconds (scaled by CESIUM_TEST_BUDGET_SCALE)
+    @param test_name Assertion name
+    @param block Code to time
+    */
+    static void assert_within_ms(double budget_ms, const std::string& test_name, const std::function<void()>& block) {
+      double scaled = budget_ms * budget_scale();
+      auto start = std::chrono::steady_clock::now();
+      block();
+      double ms = elapsed_ms(start);
+      std::stringstream timing;
+      timing << std::fixed << std::setprecision(1) << ms << " ms of " << scaled << " ms budget";
+      if (scaled > 0 && ms > scaled) {
+        assert_true(false, test_name, "took " + timing.str());
+      } else {
+        assert_true(true, test_name + " (" + timing.str() + ")");
+      }
+    }
+
+    /**
+    @brief Run and time one test case (an exception fails it)
+    */
+    static void run_test(const std::string& test_name, const std::function<void()>& test_function) {
+      auto start = std::chrono::steady_clock::now();
+      try {
+        test_function();
+      } catch (const std::exception& e) {
+        record_failure("FAIL: " + test_name + " - Exception: " + e.what());
+      }
+      double ms = elapsed_ms(start);
+      std::lock_guard<std::mutex> lock(results_mutex_);
+      test_timings_.push_back({test_name, ms});
+    }
+
     static void run_test_suite(const std::string& suite_name, std::function<void()> test_function) {
-      std::cout << "\n=== Running " << suite_name << " ===" << std::endl;
-      int initial_tests = tests_run_;
-      int initial_failures = tests_failed_;
+      out() << "\n=== Running " << suite_name << " ===" << std::endl;
+      int initial_tests = suite_run_;
+      int initial_failures = suite_failed_;
+      auto start = std::chrono::steady_clock::now();
       
       try {
         test_function();
       } catch (const std::exception& e) {
-        tests_failed_++;
-        std::cerr << "FAIL: " << suite_name << " - Exception: " << e.what() << std::endl;
+        record_failure("FAIL: " + suite_name + " - Exception: " + e.what());
       }
+      double ms = elapsed_ms(start);
       
-      int suite_tests = tests_run_ - initial_tests;
-      int suite_failures = tests_failed_ - initial_failures;
-      
-      std::cout << "=== " << suite_name << " Summary: " 
-                << (suite_tests - suite_failures) << "/" << suite_tests 
-                << " tests passed ===" << std::endl;
+      int suite_tests = suite_run_ - initial_tests;
+      int suite_failures = suite_failed_ - initial_failures;
+      std::stringstream timing;
+      timing << std::fixed << std::setprecision(1) << ms;
+      out() << "=== " << suite_name << " Summary: "
+            << (suite_tests - suite_failures) << "/" << suite_tests
+            << " tests passed (" << timing.str() << " ms) ===" << std::endl;
+
+      std::lock_guard<std::mutex> lock(results_mutex_);
+      suite_timings_.push_back({suite_name, ms});
+    }
+
+    /**
+    @brief Register a suite for run_registered_suites
+    @param suite_name Name printed with its results
+    @param test_function Function running the suite's test cases
+    @param mode Whether the suite may run alongside others
+    */
+    static void register_suite(const std::string& suite_name, std::function<void()> test_function,
+                               SuiteMode mode = SuiteMode::Parallel) {
+      suites_.push_back({suite_name, std::move(test_function), mode});
+    }
+
+    /**
+    @brief Run every registered suite: serial ones alone in order, then the parallel ones concurrently
+    @param jobs Suites run at once (0 = hardware concurrency, 1 = everything in order)
+    */
+    static void run_registered_suites(size_t jobs) {
+      if (jobs == 0) {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+      }
+      std::vector<const Suite*> parallel;
+      for (const auto& suite : suites_) {
+        if (suite.mode == SuiteMode::Serial || jobs == 1) {
+          run_test_suite(suite.name, suite.function);
+        } else {
+          parallel.push_back(&suite);
+        }
+      }
+
+      std::atomic<size_t> next{0};
+      std::vector<std::thread> workers;
+      for (size_t i = 0; i < std::min(jobs, parallel.size()); ++i) {
+        workers.emplace_back([&] {
+          for (size_t index = next++; index < parallel.size(); index = next++) {
+            run_captured(*parallel[index]);
+          }
+        });
+      }
+      for (auto& worker : workers) {
+        worker.join();
+      }
     }
     
-    static int print_summary() {
+    /**
+    @brief Print totals, failures and the slowest test cases and suites
+    @param slowest Number of test cases and suites listed by time
+    @return Process exit code (1 if anything failed)
+    */
+    static int print_summary(size_t slowest = 10) {
+      std::lock_guard<std::mutex> lock(results_mutex_);
+      auto by_time = [](const Timing& a, const Timing& b) { return a.ms > b.ms; };
+      auto print_slowest = [&](const char* title, std::vector<Timing> timings) {
+        if (timings.empty()) return;
+        std::sort(timings.begin(), timings.end(), by_time);
+        std::cout << "\n" << title << std::endl;
+        for (size_t i = 0; i < std::min(slowest, timings.size()); ++i) {
+          std::stringstream line;
+          line << "  " << std::fixed << std::setprecision(1) << std::setw(9) << timings[i].ms << " ms  " << timings[i].name;
+          std::cout << line.str() << std::endl;
+        }
+      };
+      print_slowest("Slowest suites:", suite_timings_);
+      print_slowest("Slowest tests:", test_timings_);
+
       std::cout << "\n=== Final Test Summary ===" << std::endl;
       std::cout << "Total tests run: " << tests_run_ << std::endl;
       std::cout << "Tests passed: " << (tests_run_ - tests_failed_) << std::endl;
@@ -123,9 +305,12 @@ class SimpleTest {
     }
     
     static void reset() {
+      std::lock_guard<std::mutex> lock(results_mutex_);
       tests_run_ = 0;
       tests_failed_ = 0;
       failed_tests_.clear();
+      test_timings_.clear();
+      suite_timings_.clear();
     }
 };
 
@@ -134,4 +319,7 @@ class SimpleTest {
 #define TEST_ASSERT_TRUE(condition, name) SimpleTest::assert_true(condition, name)
 #define TEST_ASSERT_FALSE(condition, name) SimpleTest::assert_false(condition, name)
 #define TEST_ASSERT_EQ(expected, actual, name) SimpleTest::assert_equals(expected, actual, name)
-#define RUN_TEST_SUITE(name, func) SimpleTest::run_test_suite(name, func)
\ No newline at end of file
+#define TEST_ASSERT_WITHIN_MS(budget_ms, name, ...) SimpleTest::assert_within_ms(budget_ms, name, [&] { __VA_ARGS__; })
+#define RUN_TEST_SUITE(name, func) SimpleTest::run_test_suite(name, func)
+#define REGISTER_TEST_SUITE(name, func, mode) SimpleTest::register_suite(name, func, mode)
+#define RUN_TEST(func) SimpleTest::run_test(#func, func)